@@ -0,0 +1,117 @@
+// GLReplay/src/GLReplayApp.cpp
+
+// Plays a trace recorded with `Sandbox --gl-capture <file>` headlessly and
+// reports CPU submission and GPU time per frame.
+//
+//   GLReplay <trace> [--loops <n>] [--no-present] [--csv <file>]
+
+#include <VizEngine/Log.h>
+#include <VizEngine/OpenGL/GLReplay.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Summary
+	{
+		double Mean = 0.0, Median = 0.0, P95 = 0.0, Max = 0.0;
+	};
+
+	Summary Summarize(std::vector<double> values)
+	{
+		Summary summary;
+		if (values.empty()) return summary;
+
+		std::sort(values.begin(), values.end());
+		for (double value : values) summary.Mean += value;
+		summary.Mean /= values.size();
+		summary.Median = values[values.size() / 2];
+		summary.P95 = values[std::min(values.size() - 1, values.size() * 95 / 100)];
+		summary.Max = values.back();
+		return summary;
+	}
+
+	void PrintUsage()
+	{
+		VP_INFO("Usage: GLReplay <trace> [--loops <n>] [--no-present] [--csv <file>]");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	VizEngine::Log::Init();
+
+	std::string tracePath;
+	std::string csvPath;
+	VizEngine::GLReplayOptions options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--loops" && i + 1 < argc) options.Loops = static_cast<uint32_t>(std::atoi(argv[++i]));
+		else if (arg == "--csv" && i + 1 < argc) csvPath = argv[++i];
+		else if (arg == "--no-present") options.Present = false;
+		else if (tracePath.empty() && arg.rfind("--", 0) != 0) tracePath = arg;
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+	if (tracePath.empty())
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	VizEngine::GLReplayer replayer;
+	if (!replayer.Load(tracePath) || !replayer.CreateContext())
+	{
+		return 1;
+	}
+
+	VizEngine::GLReplayResult result;
+	bool ok = replayer.Replay(options, result);
+	if (result.Frames.empty())
+	{
+		VP_ERROR("No frames replayed");
+		return 1;
+	}
+
+	std::vector<double> cpu, gpu;
+	uint64_t calls = 0;
+	for (const VizEngine::GLReplayFrame& frame : result.Frames)
+	{
+		cpu.push_back(frame.CpuMs);
+		gpu.push_back(frame.GpuMs);
+		calls += frame.Calls;
+	}
+	Summary cpuSummary = Summarize(cpu);
+	Summary gpuSummary = Summarize(gpu);
+	double callsPerFrame = static_cast<double>(calls) / result.Frames.size();
+
+	VP_INFO("Setup: {:.1f} ms", result.SetupMs);
+	VP_INFO("Frames: {} ({} x {} loops), {:.0f} GL calls per frame", result.Frames.size(),
+		replayer.GetFrameCount(), std::max(options.Loops, 1u), callsPerFrame);
+	VP_INFO("CPU submit ms  mean {:.3f}  median {:.3f}  p95 {:.3f}  max {:.3f}  ({:.2f} us/call)",
+		cpuSummary.Mean, cpuSummary.Median, cpuSummary.P95, cpuSummary.Max,
+		callsPerFrame > 0.0 ? cpuSummary.Mean * 1000.0 / callsPerFrame : 0.0);
+	VP_INFO("GPU ms         mean {:.3f}  median {:.3f}  p95 {:.3f}  max {:.3f}",
+		gpuSummary.Mean, gpuSummary.Median, gpuSummary.P95, gpuSummary.Max);
+
+	if (!csvPath.empty())
+	{
+		std::ofstream csv(csvPath);
+		csv << "frame,cpu_ms,gpu_ms,calls\n";
+		for (size_t i = 0; i < result.Frames.size(); i++)
+		{
+			const VizEngine::GLReplayFrame& frame = result.Frames[i];
+			csv << i << ',' << frame.CpuMs << ',' << frame.GpuMs << ',' << frame.Calls << '\n';
+		}
+		VP_INFO("Per-frame timings written to {}", csvPath);
+	}
+
+	return ok ? 0 : 1;
+}
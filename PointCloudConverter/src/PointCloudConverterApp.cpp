@@ -0,0 +1,66 @@
+// PointCloudConverter/src/PointCloudConverterApp.cpp
+
+// Builds a .vpc octree from a PLY, LAS or XYZ point file for streaming with
+// VizEngine::PointCloud (`Sandbox --point-cloud <file.vpc>`).
+//
+//   PointCloudConverter <input> <output.vpc> [--threads <n>] [--max-node-points <n>]
+//                       [--chunk-points <n>] [--grid <n>] [--temp <dir>]
+
+#include <VizEngine/Log.h>
+#include <VizEngine/Core/PointCloudFile.h>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+	void PrintUsage()
+	{
+		VP_INFO("Usage: PointCloudConverter <input.ply|.las|.xyz> <output.vpc> [--threads <n>] "
+			"[--max-node-points <n>] [--chunk-points <n>] [--grid <n>] [--temp <dir>]");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	VizEngine::Log::Init();
+
+	std::string inputPath;
+	std::string outputPath;
+	VizEngine::PointCloudBuildSettings settings;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--threads" && i + 1 < argc) settings.Threads = static_cast<unsigned>(std::atoi(argv[++i]));
+		else if (arg == "--max-node-points" && i + 1 < argc) settings.MaxNodePoints = static_cast<uint32_t>(std::atoi(argv[++i]));
+		else if (arg == "--chunk-points" && i + 1 < argc) settings.MaxChunkPoints = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--grid" && i + 1 < argc) settings.GridResolution = static_cast<uint32_t>(std::atoi(argv[++i]));
+		else if (arg == "--temp" && i + 1 < argc) settings.TempDirectory = argv[++i];
+		else if (inputPath.empty() && arg.rfind("--", 0) != 0) inputPath = arg;
+		else if (outputPath.empty() && arg.rfind("--", 0) != 0) outputPath = arg;
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+	if (inputPath.empty() || outputPath.empty())
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	VizEngine::PointCloudConverter converter(settings);
+	if (!converter.Convert(inputPath, outputPath))
+	{
+		return 1;
+	}
+
+	const VizEngine::PointCloudBuildStats& stats = converter.GetStats();
+	VP_INFO("Points: {} of {} input, {} nodes, depth {}, {} chunks", stats.Points, stats.InputPoints,
+		stats.Nodes, stats.Depth, stats.Chunks);
+	VP_INFO("Seconds  bounds {:.2f}  count {:.2f}  distribute {:.2f}  index {:.2f}  total {:.2f}",
+		stats.BoundsSeconds, stats.CountSeconds, stats.DistributeSeconds, stats.IndexSeconds, stats.TotalSeconds);
+	VP_INFO("Throughput: {:.2f} M points/s",
+		stats.TotalSeconds > 0.0 ? static_cast<double>(stats.InputPoints) / stats.TotalSeconds * 1e-6 : 0.0);
+	return 0;
+}
@@ -1,18 +1,89 @@
 #include <VizEngine.h>
 #include <VizEngine/Events/ApplicationEvent.h>
 #include <VizEngine/Events/KeyEvent.h>
+#include <VizEngine/Events/MouseEvent.h>
 #include <VizEngine/Renderer/Bloom.h>
 #include <VizEngine/Renderer/PBRMaterial.h>
 #include <VizEngine/OpenGL/Commons.h>
 #include <VizEngine/OpenGL/Texture3D.h>
+#include <VizEngine/Renderer/RegressionHarness.h>
+#include <VizEngine/Renderer/Scalability.h>
+#include <VizEngine/Renderer/RenderService.h>
+#include <VizEngine/Renderer/Downsampler.h>
+#include <VizEngine/Core/Profiler.h>
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 
 class Sandbox : public VizEngine::Application
 {
 public:
+	Sandbox() = default;
+
+	/**
+	 * @param regression Run the canonical regression cases, then quit
+	 * @param updateGoldens Record new golden images instead of comparing
+	 */
+	Sandbox(bool regression, bool updateGoldens)
+		: m_RunRegression(regression), m_UpdateGoldens(updateGoldens)
+	{
+	}
+
+	/**
+	 * Run as a headless thumbnail/turntable render service instead of the demo scene.
+	 */
+	void EnableRenderService(const VizEngine::RenderServiceConfig& config)
+	{
+		m_RunRenderService = true;
+		m_RenderServiceConfig = config;
+	}
+
+	/**
+	 * Compare regression captures against (or record them into) this directory.
+	 */
+	void SetGoldenDir(const std::string& path)
+	{
+		m_GoldenDir = path;
+	}
+
+	/**
+	 * Stream a point cloud octree (PointCloudConverter output) into the scene.
+	 */
+	void SetPointCloud(const std::string& path)
+	{
+		m_PointCloudPath = path;
+	}
+
+	/**
+	 * Ray-march a headerless scalar volume instead of the built-in phantom.
+	 */
+	void SetVolumeFile(const std::string& path, const glm::ivec3& size, VizEngine::VolumeFormat format)
+	{
+		m_VolumePath = path;
+		m_VolumeFileSize = size;
+		m_VolumeFileFormat = format;
+		m_ShowVolume = true;
+	}
+
 	void OnCreate() override
 	{
+		// =========================================================================
+		// Render service mode (--render-service / --render-service-port)
+		// =========================================================================
+		if (m_RunRenderService)
+		{
+			m_RenderService = std::make_unique<VizEngine::RenderService>(m_RenderServiceConfig);
+			if (!m_RenderService->Init())
+			{
+				auto& engine = VizEngine::Engine::Get();
+				engine.SetExitCode(1);
+				engine.Quit();
+			}
+			return;
+		}
+
 		// =========================================================================
 		// Create Shared Meshes
 		// =========================================================================
@@ -20,6 +91,11 @@ public:
 		m_CubeMesh = std::shared_ptr<VizEngine::Mesh>(VizEngine::Mesh::CreateCube().release());
 		m_PlaneMesh = std::shared_ptr<VizEngine::Mesh>(VizEngine::Mesh::CreatePlane(20.0f).release());
 
+		// Names for saving/loading scene files
+		m_SceneAssets.Register("builtin/pyramid", m_PyramidMesh);
+		m_SceneAssets.Register("builtin/cube", m_CubeMesh);
+		m_SceneAssets.Register("builtin/plane20", m_PlaneMesh);
+
 		// =========================================================================
 		// Build Scene
 		// =========================================================================
@@ -48,34 +124,25 @@ public:
 		{
 			VP_INFO("Duck model loaded: {} meshes", duckModel->GetMeshCount());
 
-			// Store mesh and material properties for reuse (Add Duck button)
+			// Prefab shares the model's meshes, textures and node hierarchy
+			// with every duck (Add Duck button)
+			m_DuckPrefab = VizEngine::Prefab::FromModel(*duckModel);
 			if (duckModel->GetMeshCount() > 0)
 			{
-				m_DuckMesh = duckModel->GetMeshes()[0];
-				const auto& material = duckModel->GetMaterialForMesh(0);
-				m_DuckColor = material.BaseColor;
-				m_DuckRoughness = material.Roughness;
-				if (material.BaseColorTexture)
-				{
-					m_DuckTexture = material.BaseColorTexture;
-				}
+				m_DuckTexture = duckModel->GetMaterialForMesh(0).BaseColorTexture;
 			}
 
-			// Add initial duck to scene
 			for (size_t i = 0; i < duckModel->GetMeshCount(); i++)
 			{
-				auto& duckObj = m_Scene.Add(duckModel->GetMeshes()[i], "Duck");
-				duckObj.ObjectTransform.Position = glm::vec3(0.0f, 0.0f, 3.0f);
-				duckObj.ObjectTransform.Scale = glm::vec3(0.02f);
+				const std::string assetName = "Duck.glb/" + std::to_string(i);
+				m_SceneAssets.Register(assetName, duckModel->GetMeshes()[i]);
+				m_SceneAssets.Register(assetName, duckModel->GetMaterialForMesh(i).BaseColorTexture);
+			}
 
-				// Copy material properties from glTF
-				const auto& material = duckModel->GetMaterialForMesh(i);
-				duckObj.Color = material.BaseColor;
-				duckObj.Roughness = material.Roughness;
-				if (material.BaseColorTexture)
-				{
-					duckObj.TexturePtr = material.BaseColorTexture;
-				}
+			// Add initial duck to scene
+			if (m_DuckPrefab)
+			{
+				m_Scene.Instantiate(m_DuckPrefab, DuckTransform(glm::vec3(0.0f, 0.0f, 3.0f)), "Duck");
 			}
 		}
 		else
@@ -104,6 +171,7 @@ public:
 		m_OutlineShader = std::make_shared<VizEngine::Shader>("resources/shaders/outline.shader");
 		m_InstancedShader = std::make_shared<VizEngine::Shader>("resources/shaders/instanced.shader");
 		m_DefaultTexture = std::make_shared<VizEngine::Texture>("resources/textures/uvchecker.png");
+		m_SceneAssets.Register("resources/textures/uvchecker.png", m_DefaultTexture);
 
 		// Assign default texture to basic objects (created before this point)
 		for (size_t i = 0; i < m_Scene.Size(); i++)
@@ -111,14 +179,32 @@ public:
 			if (!m_Scene[i].TexturePtr)
 			{
 				m_Scene[i].TexturePtr = m_DefaultTexture;
+				m_Scene.MarkChanged(i, VizEngine::SceneChange::Material);
 			}
 		}
 
+		// =========================================================================
+		// Render views: main camera + F2 preview (half resolution, every other frame)
+		// =========================================================================
+		VizEngine::RenderViewDesc mainViewDesc;
+		mainViewDesc.Name = "Main";
+		mainViewDesc.Width = m_WindowWidth;
+		mainViewDesc.Height = m_WindowHeight;
+		m_MainView = m_Views.AddView(mainViewDesc);
+
+		VizEngine::RenderViewDesc previewViewDesc;
+		previewViewDesc.Name = "Preview";
+		previewViewDesc.Width = 800;
+		previewViewDesc.Height = 800;
+		previewViewDesc.ResolutionScale = 0.5f;
+		previewViewDesc.UpdateInterval = 2;
+		m_PreviewView = m_Views.AddView(previewViewDesc);
+
 		// =========================================================================
 		// Create Framebuffer for offscreen rendering
 		// =========================================================================
-		int fbWidth = 800;
-		int fbHeight = 800;
+		int fbWidth = m_Views.GetView(m_PreviewView).GetRenderWidth();
+		int fbHeight = m_Views.GetView(m_PreviewView).GetRenderHeight();
 
 		// Create color attachment (RGBA8)
 		m_FramebufferColor = std::make_shared<VizEngine::Texture>(
@@ -151,45 +237,15 @@ public:
 		else
 		{
 			VP_INFO("Framebuffer created successfully: {}x{}", fbWidth, fbHeight);
+			m_Views.GetView(m_PreviewView).Desc.Target = m_Framebuffer.get();
 		}
 
 		// =========================================================================
 		// Create Shadow Map Framebuffer (depth-only, for shadow rendering)
 		// =========================================================================
-		int shadowMapResolution = 2048;  // Higher = crisper shadows (1024, 2048, 4096)
-
-		// Create depth texture for shadow map
-		m_ShadowMapDepth = std::make_shared<VizEngine::Texture>(
-			shadowMapResolution, shadowMapResolution,
-			GL_DEPTH_COMPONENT24,   // Internal format (24-bit depth)
-			GL_DEPTH_COMPONENT,     // Format
-			GL_FLOAT                // Data type
-		);
-		
-		// Configure shadow map texture for correct sampling
-		m_ShadowMapDepth->SetWrap(GL_CLAMP_TO_BORDER, GL_CLAMP_TO_BORDER);
-		float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-		m_ShadowMapDepth->SetBorderColor(borderColor);
-
-		// Create framebuffer and attach depth texture only (no color)
-		m_ShadowMapFramebuffer = std::make_shared<VizEngine::Framebuffer>(
-			shadowMapResolution, shadowMapResolution
-		);
-		m_ShadowMapFramebuffer->AttachDepthTexture(m_ShadowMapDepth);
-
-		// Verify shadow map framebuffer is complete
-		if (!m_ShadowMapFramebuffer->IsComplete())
-		{
-			VP_ERROR("Shadow map framebuffer is not complete! Disabling shadows.");
-			m_ShadowMapFramebuffer.reset();
-			// Also reset depth texture to avoid binding invalid texture
-			m_ShadowMapDepth.reset();
-			m_ShowShadowMap = false;
-		}
-		else
-		{
-			VP_INFO("Shadow map framebuffer created: {}x{}", shadowMapResolution, shadowMapResolution);
-		}
+		// Quality settings come from the scalability tier (High until calibrated)
+		const VizEngine::ScalabilitySettings& quality = m_Scalability.GetSettings();
+		CreateShadowMap(quality.ShadowMapResolution);
 
 		// =========================================================================
 		// Create Skybox from HDRI
@@ -212,6 +268,7 @@ public:
 		// Release original HDRI to free memory (~6MB for 2K texture)
 		// The cubemap now contains all the data we need
 		m_EnvironmentHDRI.reset();
+		m_CubemapSources[0] = m_SkyboxCubemap;
 
 		// Create skybox
 		m_Skybox = std::make_unique<VizEngine::Skybox>(m_SkyboxCubemap);
@@ -221,35 +278,7 @@ public:
 		// =========================================================================
 		// Generate IBL Maps (Chapter 38)
 		// =========================================================================
-		auto iblStart = std::chrono::high_resolution_clock::now();
-
-		m_IrradianceMap = VizEngine::CubemapUtils::GenerateIrradianceMap(m_SkyboxCubemap, 32);
-		m_PrefilteredMap = VizEngine::CubemapUtils::GeneratePrefilteredMap(m_SkyboxCubemap, 512);
-		m_BRDFLut = VizEngine::CubemapUtils::GenerateBRDFLUT(512);
-
-		// Validate IBL maps and disable IBL if any failed
-		if (!m_IrradianceMap)
-		{
-			VP_ERROR("Failed to generate irradiance map - IBL disabled");
-			m_UseIBL = false;
-		}
-		if (!m_PrefilteredMap)
-		{
-			VP_ERROR("Failed to generate prefiltered environment map - IBL disabled");
-			m_UseIBL = false;
-		}
-		if (!m_BRDFLut)
-		{
-			VP_ERROR("Failed to generate BRDF LUT - IBL disabled");
-			m_UseIBL = false;
-		}
-
-		auto iblEnd = std::chrono::high_resolution_clock::now();
-		auto iblDuration = std::chrono::duration_cast<std::chrono::milliseconds>(iblEnd - iblStart);
-		if (m_UseIBL)
-		{
-			VP_INFO("IBL maps generated in {}ms", iblDuration.count());
-		}
+		GenerateIBL(quality);
 
 		// =========================================================================
 		// PBR Rendering Setup (Chapter 37)
@@ -273,7 +302,20 @@ public:
 			m_PBRMaterial->SetUseIBL(true);
 		}
 
+		// Visibility buffer resolve: same lighting code, triangle data fetched per pixel
+		m_VisibilityResolveShader = std::make_shared<VizEngine::Shader>(
+			"resources/shaders/defaultlit.shader", "#define VISIBILITY_RESOLVE\n");
+		if (m_VisibilityResolveShader->IsValid())
+		{
+			m_VisibilityMaterial = std::make_shared<VizEngine::PBRMaterial>(m_VisibilityResolveShader, "Visibility Resolve");
+		}
+		else
+		{
+			VP_WARN("Visibility resolve shader failed to compile - visibility buffer disabled");
+		}
+
 		m_SphereMesh = std::shared_ptr<VizEngine::Mesh>(VizEngine::Mesh::CreateSphere(1.0f, 32).release());
+		m_SceneAssets.Register("builtin/sphere", m_SphereMesh);
 		VP_INFO("PBR rendering initialized");
 
 		// =========================================================================
@@ -332,9 +374,9 @@ public:
 		// =========================================================================
 		VP_INFO("Setting up post-processing...");
 
-		// Create Bloom Processor (half resolution for performance)
-		int bloomWidth = m_WindowWidth / 2;
-		int bloomHeight = m_WindowHeight / 2;
+		// Create Bloom Processor (resolution from the quality tier)
+		int bloomWidth = GetBloomWidth();
+		int bloomHeight = GetBloomHeight();
 		m_Bloom = std::make_unique<VizEngine::Bloom>(bloomWidth, bloomHeight);
 		m_Bloom->SetThreshold(m_BloomThreshold);
 		m_Bloom->SetKnee(m_BloomKnee);
@@ -356,10 +398,59 @@ public:
 		// Chapter 35: Instancing Demo Setup
 		// =========================================================================
 		SetupInstancingDemo();
+
+		// =========================================================================
+		// Scalability: apply the default tier, then benchmark for the best one
+		// (regression runs stay on the fixed default tier)
+		// =========================================================================
+		ApplyScalability(false);
+		if (!m_RunRegression)
+		{
+			m_Scalability.BeginCalibration();
+			m_ScalabilityCalibrating = true;
+		}
+
+		// =========================================================================
+		// Golden-image / frame-time regression run (--regression)
+		// =========================================================================
+		if (m_RunRegression)
+		{
+			SetupRegression();
+		}
 	}
 
 	void OnUpdate(float deltaTime) override
 	{
+		if (m_RunRenderService)
+		{
+			m_RenderService->Update();
+			if (m_RenderService->IsFinished())
+			{
+				const auto& stats = m_RenderService->GetStats();
+				auto& engine = VizEngine::Engine::Get();
+				engine.SetExitCode(stats.Failed > 0 ? 1 : 0);
+				engine.Quit();
+			}
+			return;
+		}
+
+		// Regression cases put the scene into a fixed state before any update
+		if (m_Regression)
+		{
+			m_Regression->BeginFrame();
+		}
+
+		// =========================================================================
+		// Scalability (calibration benchmark, then sustained frame-time drift)
+		// =========================================================================
+		m_Scalability.Update(deltaTime);
+		bool calibrationDone = m_ScalabilityCalibrating && !m_Scalability.IsCalibrating();
+		m_ScalabilityCalibrating = m_Scalability.IsCalibrating();
+		if (m_Scalability.ConsumeChange() || calibrationDone)
+		{
+			ApplyScalability(calibrationDone);
+		}
+
 		// =========================================================================
 		// Engine Stats
 		// =========================================================================
@@ -407,15 +498,22 @@ public:
 		// =========================================================================
 		// Object Rotation (skip ground plane by name, not index)
 		// =========================================================================
-		for (auto& obj : m_Scene)
+		if (m_RotationSpeed != 0.0f)
 		{
-			if (obj.Name == "Ground") continue;
-			obj.ObjectTransform.Rotation.y += m_RotationSpeed * deltaTime;
+			for (size_t i = 0; i < m_Scene.Size(); i++)
+			{
+				VizEngine::SceneObject& obj = m_Scene[i];
+				if (obj.Name == "Ground") continue;
+				obj.ObjectTransform.Rotation.y += m_RotationSpeed * deltaTime;
+				m_Scene.MarkChanged(i, VizEngine::SceneChange::Transform);
+			}
 		}
 	}
 
 	void OnRender() override
 	{
+		if (m_RunRenderService) return;
+
 		auto& engine = VizEngine::Engine::Get();
 		auto& renderer = engine.GetRenderer();
 
@@ -424,11 +522,47 @@ public:
 		// =========================================================================
 		m_LightSpaceMatrix = ComputeLightSpaceMatrix(m_Light);
 
+		// =========================================================================
+		// Views: per-object data once, visibility per view
+		// =========================================================================
+		m_Scene.SyncHandles(engine.GetResources());
+		m_RenderList.Update(m_Camera.GetPosition());
+
+		m_PreviewCamera = m_Camera;
+		m_PreviewCamera.SetAspectRatio(1.0f);  // Preview framebuffer is square
+		m_Views.GetView(m_PreviewView).Desc.Enabled = m_Framebuffer && m_ShowFramebufferTexture;
+
+		m_Views.SetCamera(m_MainView, m_Camera);
+		m_Views.SetCamera(m_PreviewView, m_PreviewCamera);
+		m_Views.BeginFrame(m_Scene, m_RenderList);
+		UpdatePrefabBatchLookup();
+
+		const VizEngine::RenderView& mainView = m_Views.GetView(m_MainView);
+
 		// =========================================================================
 		// Pass 1: Render scene from light's perspective to shadow map
 		// =========================================================================
-		if (m_ShadowMapFramebuffer && m_ShadowDepthShader)
+		const bool virtualShadows = m_UseVirtualShadows && UpdateVirtualShadows(mainView);
+		if (virtualShadows)
+		{
+			VP_PROFILE_PASS("Virtual Shadow Pages");
+
+			// Only pages that were requested and are missing or dirty
+			const auto& resources = engine.GetResources();
+			const auto& objects = m_Views.GetObjects();
+			m_VirtualShadows->RenderPages(*m_ShadowDepthShader, [&](uint32_t object) {
+				const auto& data = objects[object];
+				VizEngine::Mesh* mesh = resources.Get(m_Scene[data.SceneIndex].MeshId);
+				if (!mesh) return;
+
+				m_ShadowDepthShader->SetMatrix4fv("u_Model", data.Model);
+				mesh->Bind();
+				renderer.Draw(mesh->GetVertexArray(), mesh->GetIndexBuffer(), *m_ShadowDepthShader);
+			});
+		}
+		else if (m_ShadowMapFramebuffer && m_ShadowDepthShader)
 		{
+			VP_PROFILE_PASS("Shadow");
 			renderer.PushViewport();  // Save current viewport
 
 			m_ShadowMapFramebuffer->Bind();
@@ -443,16 +577,43 @@ public:
 			m_ShadowDepthShader->SetMatrix4fv("u_LightSpaceMatrix", m_LightSpaceMatrix);
 
 			// Render scene geometry (only need depth, no lighting)
-			// We need to set u_Model for each object since Scene::Render uses u_MVP
-			for (auto& obj : m_Scene)
+			// Every drawn object casts, using the model matrices shared by all views
+			const auto& resources = engine.GetResources();
+			const auto& objects = m_Views.GetObjects();
+			m_ShadowCasters.resize(objects.size());
+			for (uint32_t i = 0; i < m_ShadowCasters.size(); i++)
+			{
+				m_ShadowCasters[i] = i;
+			}
+			BuildInstancedRuns(m_ShadowCasters);
+
+			for (uint32_t i : m_SingleObjects)
 			{
-				if (!obj.Active || !obj.MeshPtr) continue;
+				const auto& data = objects[i];
+				VizEngine::Mesh* mesh = resources.Get(m_Scene[data.SceneIndex].MeshId);
+				if (!mesh) continue;
+
+				m_ShadowDepthShader->SetMatrix4fv("u_Model", data.Model);
+
+				mesh->Bind();
+				renderer.Draw(mesh->GetVertexArray(), mesh->GetIndexBuffer(), *m_ShadowDepthShader);
+			}
 
-				glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
-				m_ShadowDepthShader->SetMatrix4fv("u_Model", model);
+			// Prefab batches: one draw per batch
+			if (!m_InstancedRuns.empty())
+			{
+				UploadInstanceTransforms();
+				m_ShadowDepthShader->SetBool("u_Instanced", true);
+				for (const InstancedRun& run : m_InstancedRuns)
+				{
+					VizEngine::Mesh* mesh = resources.Get(m_Scene[objects[m_RunObjects[run.First]].SceneIndex].MeshId);
+					if (!mesh) continue;
 
-				obj.MeshPtr->Bind();
-				renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), *m_ShadowDepthShader);
+					mesh->Bind();
+					renderer.DrawInstanced(mesh->GetVertexArray(), mesh->GetIndexBuffer(), *m_ShadowDepthShader,
+						static_cast<int>(run.Count), run.First);
+				}
+				m_ShadowDepthShader->SetBool("u_Instanced", false);
 			}
 
 			// Disable polygon offset
@@ -469,19 +630,70 @@ public:
 		// Validate HDR resources before rendering
 		if (m_HDREnabled && m_HDRFramebuffer && m_DefaultLitShader && m_HDRFramebuffer->IsComplete())
 		{
+			// Visibility buffer: opaque ids first, shaded below in one full-screen resolve
+			const bool visibilityPath = m_UseVisibilityBuffer && RenderVisibilityGeometry(mainView);
+
+			// Opted-in transparents are drawn after the skybox at reduced resolution
+			const bool lowResPath = m_UseLowResTransparency && SplitLowResTransparents(mainView);
+			const std::vector<uint32_t>* transparent = lowResPath ? &m_FullResTransparent : nullptr;
+
+			// Node selection, loads and uploads before any drawing
+			const bool pointCloud = m_ShowPointCloud && UpdatePointCloud(mainView);
+
+			// Volume creation and its brick ranges happen outside the pass timings
+			const bool volume = m_ShowVolume && EnsureVolume();
+
+			VP_PROFILE_PASS("Scene");
 			m_HDRFramebuffer->Bind();
 			renderer.Clear(m_ClearColor);
 
 			// Setup shader with all common uniforms
 			SetupDefaultLitShader();
+			SetViewUniforms(mainView);
+
+			if (visibilityPath)
+			{
+				m_VisibilityMaterial->Bind();
+				m_VisibilityBuffer->Resolve(*m_VisibilityMaterial->GetShader());
 
-			// Render scene objects with PBR (Chapter 33: opaque first, then transparent)
-			RenderSceneObjects();
+				// Draws past the buffer's limits, forward
+				RenderOpaqueObjects(mainView, &m_VisibilityForward);
+			}
+			else
+			{
+				// Render scene objects with PBR (Chapter 33: opaque first, transparent after
+				// the instancing demo and the point cloud below)
+				RenderOpaqueObjects(mainView);
+			}
 
 			// =========================================================================
 			// Chapter 35: Instancing Demo
 			// =========================================================================
-			if (m_ShowInstancingDemo && m_InstancedShader && m_InstancedCubeMesh && m_InstanceVBO)
+			if (m_ShowInstancingDemo && m_UsePackedMaterials && m_PackedInstancedShader
+				&& m_MaterialPacker && m_MaterialPacker->IsBuilt() && m_InstanceMaterialBuffer)
+			{
+				// Every instance picks its own material; one draw for the whole grid
+				m_PackedInstancedShader->Bind();
+				m_PackedInstancedShader->SetMatrix4fv("u_View", m_Camera.GetViewMatrix());
+				m_PackedInstancedShader->SetMatrix4fv("u_Projection", m_Camera.GetProjectionMatrix());
+				m_PackedInstancedShader->SetVec3("u_ViewPos", m_Camera.GetPosition());
+				m_PackedInstancedShader->SetVec3("u_DirLightDirection", m_Light.GetDirection());
+				m_PackedInstancedShader->SetVec3("u_DirLightColor", m_Light.Diffuse);
+
+				m_MaterialPacker->Bind(*m_PackedInstancedShader, m_PackedBatchMaterial);
+				m_InstanceMaterialBuffer->BindBase(1);
+
+				m_InstancedCubeMesh->Bind();
+				renderer.DrawInstanced(
+					m_InstancedCubeMesh->GetVertexArray(),
+					m_InstancedCubeMesh->GetIndexBuffer(),
+					*m_PackedInstancedShader,
+					m_InstanceCount
+				);
+
+				m_MaterialPacker->Unbind();
+			}
+			else if (m_ShowInstancingDemo && m_InstancedShader && m_InstancedCubeMesh && m_InstanceVBO)
 			{
 				m_InstancedShader->Bind();
 				m_InstancedShader->SetMatrix4fv("u_View", m_Camera.GetViewMatrix());
@@ -500,6 +712,18 @@ public:
 				);
 			}
 
+			// =========================================================================
+			// Streamed point cloud (opaque, depth tested against the meshes)
+			// =========================================================================
+			if (pointCloud)
+			{
+				VP_PROFILE_PASS(VizEngine::PointCloud::PassName);
+				m_PointCloud->Render();
+			}
+
+			// Transparent objects blend over all opaque geometry, the point cloud included
+			RenderTransparentObjects(mainView, transparent);
+
 			// =========================================================================
 			// Render Skybox to HDR Buffer (before outlines so outlines draw on top)
 			// =========================================================================
@@ -508,6 +732,20 @@ public:
 				m_Skybox->Render(m_Camera);
 			}
 
+			if (lowResPath)
+			{
+				RenderLowResTransparents(mainView);
+			}
+
+			// =========================================================================
+			// Ray-marched volume (blended over everything, clipped by the scene depth)
+			// =========================================================================
+			if (volume)
+			{
+				VP_PROFILE_PASS(VizEngine::VolumeRenderer::PassName);
+				m_VolumeRenderer->Render(*m_HDRDepthTexture, mainView.View, mainView.Projection, m_Light.GetDirection());
+			}
+
 			// =========================================================================
 			// Chapter 32: Stencil Outline Pass (after skybox so outline is visible)
 			// =========================================================================
@@ -532,9 +770,10 @@ public:
 
 				// Setup shader with all common uniforms
 				SetupDefaultLitShader();
+				SetViewUniforms(mainView);
 
 				// Render scene
-				RenderSceneObjects();
+				RenderSceneObjects(mainView);
 
 				// Render skybox before outlines
 				if (m_ShowSkybox && m_Skybox)
@@ -546,12 +785,31 @@ public:
 			}
 		}
 
+		// =========================================================================
+		// Hi-Z pyramid from the scene depth (single compute dispatch)
+		// =========================================================================
+		if (m_HDREnabled && m_BuildHiZ && m_HDRDepthTexture)
+		{
+			VP_PROFILE_PASS("HiZ");
+			BuildHiZPyramid();
+		}
+
+		// =========================================================================
+		// Virtual shadow pages the scene depth needs (read back next frame)
+		// =========================================================================
+		if (virtualShadows && m_HDREnabled && m_HDRDepthTexture)
+		{
+			VP_PROFILE_PASS("Virtual Shadow Marking");
+			m_VirtualShadows->MarkPages(*m_HDRDepthTexture);
+		}
+
 		// =========================================================================
 		// Pass 3: Bloom Processing (Chapter 40)
 		// =========================================================================
 		std::shared_ptr<VizEngine::Texture> bloomTexture = nullptr;
 		if (m_HDREnabled && m_EnableBloom && m_Bloom && m_HDRColorTexture)
 		{
+			VP_PROFILE_PASS("Bloom");
 			// Update bloom parameters (in case they changed via ImGui)
 			m_Bloom->SetThreshold(m_BloomThreshold);
 			m_Bloom->SetKnee(m_BloomKnee);
@@ -567,6 +825,7 @@ public:
 		// Only perform tone mapping if HDR pipeline is active
 		if (m_HDREnabled && m_ToneMappingShader && m_HDRColorTexture && m_FullscreenQuad)
 		{
+			VP_PROFILE_PASS("ToneMapping");
 			renderer.SetViewport(0, 0, m_WindowWidth, m_WindowHeight);
 			// Don't clear here if HDR is disabled - LDR fallback already rendered
 			renderer.Clear(m_ClearColor);
@@ -620,44 +879,68 @@ public:
 		// Re-enable depth test
 		renderer.EnableDepthTest();
 
+		// =========================================================================
+		// Overdraw debug views + metrics (replays the main view's passes)
+		// =========================================================================
+		if (m_DebugView != 0 || m_MeasureOverdraw)
+		{
+			MeasureOverdraw(mainView, bloomTexture != nullptr);
+
+			if (m_DebugView != 0 && m_Overdraw && m_Overdraw->IsValid())
+			{
+				renderer.SetViewport(0, 0, m_WindowWidth, m_WindowHeight);
+				m_Overdraw->Visualize(static_cast<VizEngine::OverdrawPass>(m_DebugView - 1), m_OverdrawMaxCount);
+			}
+		}
+
 		// =========================================================================
 		// Render to preview Framebuffer (offscreen) - kept for F2 preview
+		// Reuses this frame's object data; skipped on frames the view is not due
 		// =========================================================================
-		if (m_Framebuffer)
+		const VizEngine::RenderView& previewView = m_Views.GetView(m_PreviewView);
+		if (previewView.Due && m_Framebuffer && m_DefaultLitShader)
 		{
-			float windowAspect = static_cast<float>(m_WindowWidth) / static_cast<float>(m_WindowHeight);
-			m_Camera.SetAspectRatio(1.0f);  // Framebuffer is square (800x800)
-			
+			VP_PROFILE_PASS("Preview");
 			m_Framebuffer->Bind();
 			renderer.SetViewport(0, 0, m_Framebuffer->GetWidth(), m_Framebuffer->GetHeight());
 			renderer.Clear(m_ClearColor);
 
-			// PBR shader already configured, just need to update camera for new aspect
-			m_DefaultLitShader->Bind();
-			m_DefaultLitShader->SetMatrix4fv("u_View", m_Camera.GetViewMatrix());
-			m_DefaultLitShader->SetMatrix4fv("u_Projection", m_Camera.GetProjectionMatrix());
+			// Lighting is already configured; only the camera differs
+			SetViewUniforms(previewView);
 
 			// Render scene objects with PBR
-			RenderSceneObjects();
+			RenderSceneObjects(previewView);
 		
 			// Render Skybox to offscreen framebuffer
 			if (m_ShowSkybox && m_Skybox)
 			{
-				m_Skybox->Render(m_Camera);
+				m_Skybox->Render(m_PreviewCamera);
 			}
 		
 			m_Framebuffer->Unbind();
-
-			// Restore camera to window aspect ratio
-			m_Camera.SetAspectRatio(windowAspect);
+			m_Views.MarkRendered(m_PreviewView);
 			
 			// Restore viewport to window size
 			renderer.SetViewport(0, 0, m_WindowWidth, m_WindowHeight);
 		}
+		m_Views.MarkRendered(m_MainView);
+
+		// Capture before ImGui draws on top
+		if (m_Regression && m_Regression->IsRunning())
+		{
+			m_Regression->EndFrame(m_WindowWidth, m_WindowHeight);
+			if (m_Regression->IsFinished())
+			{
+				engine.SetExitCode(m_Regression->GetExitCode());
+				engine.Quit();
+			}
+		}
 	}
 
 	void OnImGuiRender() override
 	{
+		if (m_RunRenderService) return;
+
 		auto& engine = VizEngine::Engine::Get();
 		auto& uiManager = engine.GetUIManager();
 
@@ -674,6 +957,107 @@ public:
 			uiManager.Separator();
 			uiManager.Text("Window: %d x %d", m_WindowWidth, m_WindowHeight);
 			uiManager.Separator();
+
+			const auto& stats = engine.GetRenderer().GetStats();
+			uiManager.Text("Draw calls: %u (%u instanced)", stats.DrawCalls, stats.InstancedDrawCalls);
+			uiManager.Text("Triangles: %llu", static_cast<unsigned long long>(stats.Triangles));
+			uiManager.Text("Frustum culled: %zu / %zu", m_Views.GetView(m_MainView).CulledCount, m_Views.GetObjects().size());
+
+			// Batched transform/culling kernels (forcing Scalar gives the reference path)
+			const char* isaNames[] = { "Scalar", "SSE4.2", "AVX2", "AVX-512" };
+			int isa = static_cast<int>(VizEngine::BatchMath::GetActiveISA());
+			if (uiManager.Combo("Batch Math", &isa, isaNames, 4))
+			{
+				VizEngine::BatchMath::SetActiveISA(static_cast<VizEngine::SimdISA>(isa));
+			}
+			uiManager.Text("Detected: %s", VizEngine::BatchMath::GetISAName(VizEngine::BatchMath::GetDetectedISA()));
+			if (uiManager.Button("Ray Benchmark (selected mesh)"))
+			{
+				RunRayBenchmark();
+			}
+			for (const auto& result : m_RayBenchmark)
+			{
+				uiManager.Text("%s: %.2f Mrays/s single, %.2f Mrays/s %d-wide packets",
+					VizEngine::BatchMath::GetISAName(result.ISA), result.SingleRaysPerSecond * 1e-6,
+					result.PacketRaysPerSecond * 1e-6, result.PacketWidth);
+			}
+			uiManager.Separator();
+
+			// Overdraw debug views
+			const char* debugViews[] = { "None", "Overdraw: Opaque", "Overdraw: Transparent", "Overdraw: Post (estimate)" };
+			uiManager.Combo("Debug View", &m_DebugView, debugViews, 4);
+			uiManager.Checkbox("Measure Overdraw", &m_MeasureOverdraw);
+			uiManager.SliderInt("Threshold", &m_OverdrawThreshold, 1, 16);
+			uiManager.SliderFloat("Heat Max", &m_OverdrawMaxCount, 1.0f, 32.0f);
+
+			const char* passNames[] = { "Opaque", "Transparent", "Post" };
+			for (int i = 0; i < static_cast<int>(VizEngine::OverdrawPass::Count); i++)
+			{
+				const auto& od = stats.GetOverdraw(static_cast<VizEngine::OverdrawPass>(i));
+				if (!od.Valid) continue;
+				uiManager.Text("%s%s: avg %.2f (covered %.2f), max %.0f, >%u: %.1f%%",
+					passNames[i], od.Estimated ? " (est.)" : "", od.Average, od.AverageCovered, od.Max, od.Threshold,
+					od.PercentAboveThreshold);
+			}
+			uiManager.Separator();
+
+			// Scalability tiers
+			const char* tierNames[] = { "Low", "Medium", "High", "Ultra" };
+			int tier = static_cast<int>(m_Scalability.GetTier());
+			if (uiManager.Combo("Quality", &tier, tierNames, 4))
+			{
+				m_Scalability.SetTier(static_cast<VizEngine::ScalabilityTier>(tier));
+				m_Scalability.ConsumeChange();
+				ApplyScalability(true);
+			}
+			bool autoAdjust = m_Scalability.GetAutoAdjust();
+			if (uiManager.Checkbox("Auto Adjust", &autoAdjust))
+			{
+				m_Scalability.SetAutoAdjust(autoAdjust);
+			}
+			uiManager.SliderFloat("Target (ms)", &m_Scalability.GetConfig().TargetFrameMs, 4.0f, 50.0f);
+			if (m_Scalability.IsCalibrating())
+			{
+				uiManager.Text("Calibrating...");
+			}
+			else
+			{
+				uiManager.Text("Frame cost: %.2f ms", m_Scalability.GetSmoothedFrameMs());
+				if (uiManager.Button("Recalibrate"))
+				{
+					m_Scalability.BeginCalibration();
+				}
+			}
+			uiManager.Separator();
+
+			// Frame-spike capture: Chrome traces of the frames around a hitch
+			VizEngine::SpikeCaptureConfig spike = VizEngine::Profiler::GetSpikeCapture();
+			bool spikeChanged = uiManager.Checkbox("Spike Capture", &spike.Enabled);
+			float spikeThreshold = static_cast<float>(spike.ThresholdMs);
+			if (uiManager.SliderFloat("Spike (ms)", &spikeThreshold, 10.0f, 200.0f))
+			{
+				spike.ThresholdMs = spikeThreshold;
+				spikeChanged = true;
+			}
+			if (spikeChanged)
+			{
+				VizEngine::Profiler::SetSpikeCapture(spike);
+			}
+			if (spike.Enabled)
+			{
+				if (uiManager.Button("Dump Trace Now"))
+				{
+					VizEngine::Profiler::DumpTrace(spike.OutputDirectory + "/manual_frame" +
+						std::to_string(VizEngine::Profiler::GetFrameIndex()) + ".json");
+				}
+				uiManager.Text("Captures: %u", VizEngine::Profiler::GetSpikeCaptureCount());
+				std::string lastTrace = VizEngine::Profiler::GetLastSpikeTrace();
+				if (!lastTrace.empty())
+				{
+					uiManager.Text("Last: %s", lastTrace.c_str());
+				}
+			}
+			uiManager.Separator();
 			uiManager.Text("Press F1 to toggle");
 
 			uiManager.EndWindow();
@@ -720,7 +1104,7 @@ public:
 		// =========================================================================
 		if (m_ShowShadowMap)
 		{
-			uiManager.StartFixedWindow("Shadow Map Debug", 360.0f, 420.0f);
+			uiManager.StartFixedWindow("Shadow Map Debug", 360.0f, 640.0f);
 
 			if (m_ShadowMapDepth && m_ShadowMapFramebuffer)
 			{
@@ -738,16 +1122,156 @@ public:
 					m_ShadowMapFramebuffer->GetWidth(),
 					m_ShadowMapFramebuffer->GetHeight()
 				);
-			}
-			else
-			{
-				uiManager.Text("Shadow map not available");
-			}
-
-			uiManager.Checkbox("Show Shadow Map", &m_ShowShadowMap);
 
-			uiManager.EndWindow();
+				// Filtering (the quality tier resets mode and taps)
+				const char* filterModes[] = { "PCF 3x3", "Hardware", "Vogel Disk", "PCSS" };
+				int filterMode = static_cast<int>(m_ShadowFilter.Mode);
+				if (uiManager.Combo("Filter", &filterMode, filterModes, 4))
+				{
+					m_ShadowFilter.Mode = static_cast<VizEngine::ShadowFilterMode>(filterMode);
+				}
+				switch (m_ShadowFilter.Mode)
+				{
+				case VizEngine::ShadowFilterMode::Hardware:
+				{
+					bool fourFetches = m_ShadowFilter.Taps > 1;
+					if (uiManager.Checkbox("4 Fetches", &fourFetches))
+					{
+						m_ShadowFilter.Taps = fourFetches ? 4 : 1;
+					}
+					break;
+				}
+				case VizEngine::ShadowFilterMode::PoissonDisk:
+					uiManager.SliderInt("Taps", &m_ShadowFilter.Taps, 1, 32);
+					uiManager.SliderFloat("Radius (texels)", &m_ShadowFilter.RadiusTexels, 0.5f, 8.0f);
+					break;
+				case VizEngine::ShadowFilterMode::PCSS:
+					uiManager.SliderInt("Taps", &m_ShadowFilter.Taps, 1, 32);
+					uiManager.SliderInt("Blocker Taps", &m_ShadowFilter.BlockerSearchTaps, 1, 16);
+					uiManager.SliderFloat("Light Size", &m_ShadowFilter.LightSize, 0.0f, 0.5f);
+					uiManager.SliderFloat("Max Penumbra", &m_ShadowFilter.MaxPenumbraTexels, 1.0f, 64.0f);
+					break;
+				default:
+					break;
+				}
+			}
+			else
+			{
+				uiManager.Text("Shadow map not available");
+			}
+
+			// Virtual shadow map (sampled with the Hardware filter's taps)
+			uiManager.Separator();
+			uiManager.Checkbox("Virtual Shadow Map", &m_UseVirtualShadows);
+			if (m_UseVirtualShadows && m_VirtualShadows && m_VirtualShadows->IsValid())
+			{
+				const auto& config = m_VirtualShadows->GetConfig();
+				const auto& vsm = m_VirtualShadows->GetStats();
+				uiManager.SliderFloat("LOD Bias", &m_VirtualShadowLodBias, -2.0f, 4.0f);
+				uiManager.Text("Virtual: %d levels of %dx%d", config.Levels,
+					config.PagesPerAxis * config.PageSize, config.PagesPerAxis * config.PageSize);
+				uiManager.Text("Resident: %u / %u pages", vsm.ResidentPages, vsm.PhysicalPages);
+				uiManager.Text("Requested: %u  Cached: %u", vsm.RequestedPages, vsm.CachedPages);
+				uiManager.Text("Rendered: %u  Deferred: %u", vsm.RenderedPages, vsm.DeferredPages);
+				uiManager.Text("Invalidated: %u  Evicted: %u", vsm.InvalidatedPages, vsm.EvictedPages);
+				uiManager.Text("Caster draws: %u  Culled: %u", vsm.CasterDraws, vsm.CastersCulled);
+				uiManager.Text("Memory: atlas %.1f MB, tables %.2f MB",
+					vsm.AtlasBytes / (1024.0 * 1024.0),
+					(vsm.PageTableBytes + vsm.RequestBytes) / (1024.0 * 1024.0));
+				uiManager.Image(
+					reinterpret_cast<void*>(static_cast<uintptr_t>(m_VirtualShadows->GetAtlas()->GetID())),
+					160.0f, 160.0f
+				);
+			}
+
+			uiManager.Checkbox("Show Shadow Map", &m_ShowShadowMap);
+
+			uiManager.EndWindow();
+		}
+
+		// =========================================================================
+		// Point Cloud Panel (--point-cloud)
+		// =========================================================================
+		if (m_PointCloud && m_PointCloud->IsOpen())
+		{
+			uiManager.StartWindow("Point Cloud");
+
+			auto& settings = m_PointCloud->GetSettings();
+			const auto& stats = m_PointCloud->GetStats();
+			uiManager.Checkbox("Show Point Cloud", &m_ShowPointCloud);
+
+			int budgetMillions = static_cast<int>(settings.PointBudget / 1000000);
+			if (uiManager.SliderInt("Budget (M points)", &budgetMillions, 1, 50))
+			{
+				settings.PointBudget = static_cast<uint64_t>(budgetMillions) * 1000000;
+			}
+			uiManager.SliderFloat("Min Node Pixels", &settings.MinNodePixels, 50.0f, 500.0f);
+			uiManager.SliderFloat("Point Scale", &settings.PointScale, 0.25f, 4.0f);
+			uiManager.SliderFloat("Max Point Size", &settings.MaxPointSize, 1.0f, 64.0f);
+			uiManager.SliderFloat("Brightness", &settings.Brightness, 0.0f, 4.0f);
+			uiManager.Checkbox("Round Points", &settings.RoundPoints);
+
+			bool placementChanged = uiManager.SliderFloat("Extent", &m_PointCloudExtent, 1.0f, 200.0f);
+			placementChanged |= uiManager.Checkbox("Z Up", &m_PointCloudZUp);
+			if (placementChanged) PlacePointCloud();
+
+			uiManager.Separator();
+			uiManager.Text("Cloud: %.1f M points, %u nodes", stats.TotalPoints * 1e-6, stats.TotalNodes);
+			uiManager.Text("Rendered: %.2f M points, %u nodes", stats.RenderedPoints * 1e-6, stats.VisibleNodes);
+			uiManager.Text("Resident: %u nodes, %.1f MB", stats.ResidentNodes, stats.GpuBytes / (1024.0 * 1024.0));
+			uiManager.Text("Loading: %u  Uploaded: %.1f MB  Evicted: %u",
+				stats.PendingLoads, stats.UploadedBytes / (1024.0 * 1024.0), stats.EvictedNodes);
+			uiManager.Text("GPU: %.2f ms, %.0f M points/s", stats.GpuMs, stats.PointsPerSecond * 1e-6);
+
+			uiManager.EndWindow();
+		}
+
+		// =========================================================================
+		// Volume Panel
+		// =========================================================================
+		uiManager.StartWindow("Volume");
+		uiManager.Checkbox("Show Volume", &m_ShowVolume);
+		if (m_VolumeRenderer && m_VolumeRenderer->GetVolume())
+		{
+			auto& settings = m_VolumeRenderer->GetSettings();
+			const auto& stats = m_VolumeRenderer->GetStats();
+
+			const char* presets[] = { "Grayscale", "Soft Tissue", "Bone" };
+			if (uiManager.Combo("Transfer Function", &m_VolumePreset, presets, 3))
+			{
+				ApplyVolumePreset();
+			}
+			uiManager.SliderFloat("Window Min", &settings.Window.x, 0.0f, 1.0f);
+			uiManager.SliderFloat("Window Max", &settings.Window.y, 0.0f, 1.0f);
+			uiManager.SliderFloat("Density", &settings.Density, 0.0f, 4.0f);
+			uiManager.SliderFloat("Brightness", &settings.Brightness, 0.0f, 4.0f);
+			uiManager.Checkbox("Shading", &settings.Shading);
+
+			uiManager.Separator();
+			uiManager.SliderFloat("Step (voxels)", &settings.StepSize, 0.1f, 4.0f);
+			uiManager.Checkbox("Adaptive Step", &settings.AdaptiveStep);
+			uiManager.SliderFloat("Distance Step Scale", &settings.DistanceStepScale, 0.0f, 2.0f);
+			uiManager.SliderFloat("Transparent Step Scale", &settings.TransparentStepScale, 1.0f, 8.0f);
+			uiManager.Checkbox("Jitter", &settings.Jitter);
+			uiManager.Checkbox("Skip Empty Space", &settings.SkipEmptySpace);
+			uiManager.SliderFloat("Termination Alpha", &settings.TerminationAlpha, 0.8f, 1.0f);
+			bool stepView = settings.Debug == VizEngine::VolumeDebugView::StepCount;
+			if (uiManager.Checkbox("Show Step Count", &stepView))
+			{
+				settings.Debug = stepView ? VizEngine::VolumeDebugView::StepCount : VizEngine::VolumeDebugView::None;
+			}
+
+			if (uiManager.SliderFloat("Extent", &m_VolumeExtent, 1.0f, 40.0f))
+			{
+				PlaceVolume();
+			}
+
+			uiManager.Separator();
+			uiManager.Text("Occupied bricks: %u / %u (%.0f%%)", stats.OccupiedBricks, stats.TotalBricks,
+				stats.TotalBricks > 0 ? 100.0 * stats.OccupiedBricks / stats.TotalBricks : 0.0);
+			uiManager.Text("GPU: %.2f ms", stats.GpuMs);
 		}
+		uiManager.EndWindow();
 
 		// =========================================================================
 		// Scene Objects Panel
@@ -755,6 +1279,17 @@ public:
 		uiManager.StartWindow("Scene Objects");
 
 		uiManager.Text("Objects (%zu)", m_Scene.Size());
+		uiManager.Text("Prefab instances: %zu (%zu batches)",
+			m_Scene.GetInstanceCount(), m_Scene.GetPrefabBatches().size());
+		if (uiManager.Button("Save Scene"))
+		{
+			SaveScene(m_SceneFilePath);
+		}
+		uiManager.SameLine();
+		if (uiManager.Button("Load Scene"))
+		{
+			LoadScene(m_SceneFilePath);
+		}
 		uiManager.Separator();
 
 		for (size_t i = 0; i < m_Scene.Size(); i++)
@@ -773,26 +1308,51 @@ public:
 		{
 			auto& obj = m_Scene[static_cast<size_t>(m_SelectedObject)];
 
+			size_t selected = static_cast<size_t>(m_SelectedObject);
+
 			uiManager.Text("Selected: %s", obj.Name.c_str());
-			uiManager.Checkbox("Active", &obj.Active);
+			if (uiManager.Checkbox("Active", &obj.Active))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Activation);
+			}
 
 			uiManager.Separator();
 			uiManager.Text("Transform");
-			uiManager.DragFloat3("Position", &obj.ObjectTransform.Position.x, 0.1f);
+			if (uiManager.DragFloat3("Position", &obj.ObjectTransform.Position.x, 0.1f))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Transform);
+			}
 
 			glm::vec3 rotDegrees = obj.ObjectTransform.GetRotationDegrees();
 			if (uiManager.DragFloat3("Rotation", &rotDegrees.x, 1.0f))
 			{
 				obj.ObjectTransform.SetRotationDegrees(rotDegrees);
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Transform);
 			}
 
-			uiManager.DragFloat3("Scale", &obj.ObjectTransform.Scale.x, 0.1f, 0.1f, 10.0f);
+			if (uiManager.DragFloat3("Scale", &obj.ObjectTransform.Scale.x, 0.1f, 0.1f, 10.0f))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Transform);
+			}
 
 			uiManager.Separator();
 			uiManager.Text("Material");
-			uiManager.ColorEdit4("Color", &obj.Color.x);
-			uiManager.SliderFloat("Roughness", &obj.Roughness, 0.05f, 1.0f);
-			uiManager.SliderFloat("Metallic", &obj.Metallic, 0.0f, 1.0f);
+			if (uiManager.ColorEdit4("Color", &obj.Color.x))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Material);
+			}
+			if (uiManager.SliderFloat("Roughness", &obj.Roughness, 0.05f, 1.0f))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Material);
+			}
+			if (uiManager.SliderFloat("Metallic", &obj.Metallic, 0.0f, 1.0f))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Material);
+			}
+			if (uiManager.Checkbox("Low Resolution", &obj.LowResolution))
+			{
+				m_Scene.MarkChanged(selected, VizEngine::SceneChange::Material);
+			}
 
 			uiManager.Separator();
 			if (uiManager.Button("Delete Object"))
@@ -821,16 +1381,13 @@ public:
 			newObj.Color = glm::vec4(0.9f, 0.5f, 0.3f, 1.0f);
 			newObj.TexturePtr = m_DefaultTexture;
 		}
-		if (m_DuckMesh)
+		if (m_DuckPrefab)
 		{
 			uiManager.SameLine();
 			if (uiManager.Button("Add Duck"))
 			{
-				auto& newObj = m_Scene.Add(m_DuckMesh, "Duck_" + std::to_string(m_NextObjectID++));
-				newObj.ObjectTransform.Scale = glm::vec3(0.02f);
-				newObj.Color = m_DuckColor;
-				newObj.Roughness = m_DuckRoughness;
-				newObj.TexturePtr = m_DuckTexture;
+				m_Scene.Instantiate(m_DuckPrefab, DuckTransform(glm::vec3(0.0f)),
+					"Duck_" + std::to_string(m_NextObjectID++));
 			}
 		}
 		if (m_SphereMesh)
@@ -939,6 +1496,25 @@ public:
 			uiManager.Text("IBL maps not generated!");
 		}
 
+		// Compact HDR storage, errors measured against the RGB16F originals
+		uiManager.Separator();
+		const char* storageNames[] = { "RGB16F", "RGB9_E5", "R11F_G11F_B10F", "BC6H" };
+		const char* mapNames[] = { "Environment", "Irradiance", "Prefiltered" };
+		for (int map = 0; map < 3; map++)
+		{
+			if (uiManager.Combo(mapNames[map], &m_CubemapStorage[map], storageNames, 4))
+			{
+				ApplyCubemapStorage(map);
+			}
+			const auto& report = m_CubemapReports[map];
+			if (report.MipLevels > 0)
+			{
+				uiManager.Text("  %.2f MB (RGB16F %.2f MB), error mean %.3f%% max %.2f%%, %.0f ms",
+					report.Bytes / (1024.0 * 1024.0), report.BaselineBytes / (1024.0 * 1024.0),
+					report.MeanRelativeError * 100.0, report.MaxRelativeError * 100.0, report.ConvertMs);
+			}
+		}
+
 		uiManager.Separator();
 		uiManager.Text("Lower Hemisphere");
 		uiManager.ColorEdit3("Ground Color", &m_LowerHemisphereColor.x);
@@ -1020,6 +1596,19 @@ public:
 			uiManager.SliderFloat("Brightness", &m_Brightness, -0.5f, 0.5f);
 		}
 
+		// Hi-Z pyramid section
+		if (uiManager.CollapsingHeader("Hi-Z Pyramid"))
+		{
+			uiManager.Checkbox("Build Hi-Z Pyramid", &m_BuildHiZ);
+			if (m_HiZPyramid)
+			{
+				uiManager.Text("%dx%d, %d levels, %d dispatch(es)",
+					m_HiZPyramid->GetWidth(), m_HiZPyramid->GetHeight(), m_HiZPyramid->GetMipLevels(),
+					m_Downsampler ? m_Downsampler->GetLastDispatchCount() : 0);
+			}
+			uiManager.Text("Max depth per texel (R32F); timing under HiZ in the profiler");
+		}
+
 		uiManager.EndWindow();
 
 		// =========================================================================
@@ -1045,17 +1634,57 @@ public:
 		{
 			uiManager.Text("Set alpha < 1.0 via Color editor above.");
 			uiManager.Text("Transparent objects are sorted back-to-front.");
+
+			uiManager.Separator();
+			uiManager.Checkbox("Reduced-Resolution Pass", &m_UseLowResTransparency);
+			if (m_UseLowResTransparency)
+			{
+				const char* scales[] = { "Half", "Quarter" };
+				uiManager.Combo("Resolution", &m_LowResScale, scales, 2);
+				const char* upsampleModes[] = { "Bilinear", "Bilateral", "Nearest Depth" };
+				uiManager.Combo("Upsample", &m_LowResUpsample, upsampleModes, 3);
+				uiManager.SliderFloat("Depth Threshold", &m_LowResDepthThreshold, 0.01f, 0.5f);
+				uiManager.Text("Reduced resolution: %d object(s)", static_cast<int>(m_LowResTransparent.size()));
+				uiManager.Text("Opt in per object: Material > Low Resolution");
+			}
 		}
 
 		// Chapter 35: Instancing
 		if (uiManager.CollapsingHeader("Instancing (Ch 35)"))
 		{
 			uiManager.Checkbox("Show Instancing Demo", &m_ShowInstancingDemo);
-			uiManager.ColorEdit3("Instance Color", &m_InstanceColor.x);
+			uiManager.Checkbox("Packed Materials", &m_UsePackedMaterials);
+			if (!m_UsePackedMaterials)
+			{
+				uiManager.ColorEdit3("Instance Color", &m_InstanceColor.x);
+			}
 			if (m_ShowInstancingDemo)
 			{
 				uiManager.Text("Instances: %d cubes", m_InstanceCount);
 				uiManager.Text("Drawn in 1 draw call");
+				if (m_UsePackedMaterials && m_MaterialPacker)
+				{
+					uiManager.Text("Materials: %d in batch, %d texture pools",
+						m_PackedMaterialCount, static_cast<int>(m_MaterialPacker->GetPoolCount()));
+				}
+			}
+		}
+
+		// Visibility buffer
+		if (uiManager.CollapsingHeader("Visibility Buffer"))
+		{
+			uiManager.Checkbox("Use Visibility Buffer", &m_UseVisibilityBuffer);
+			if (!m_VisibilityMaterial)
+			{
+				uiManager.Text("Resolve shader unavailable");
+			}
+			else if (m_UseVisibilityBuffer && m_VisibilityBuffer)
+			{
+				const auto& visStats = m_VisibilityBuffer->GetStats();
+				uiManager.Text("Draws: %u (%u forward)", visStats.Draws, visStats.Rejected);
+				uiManager.Text("Triangles: %llu", static_cast<unsigned long long>(visStats.Triangles));
+				uiManager.Text("Cached meshes: %u (%.2f MB)", visStats.CachedMeshes,
+					visStats.GeometryBytes / (1024.0 * 1024.0));
 			}
 		}
 
@@ -1064,6 +1693,8 @@ public:
 
 	void OnEvent(VizEngine::Event& e) override
 	{
+		if (m_RunRenderService) return;
+
 		VizEngine::EventDispatcher dispatcher(e);
 
 		// Handle window resize - update camera and track dimensions
@@ -1071,6 +1702,8 @@ public:
 			[this](VizEngine::WindowResizeEvent& event) {
 				m_WindowWidth = event.GetWidth();
 				m_WindowHeight = event.GetHeight();
+				m_Views.GetView(m_MainView).Desc.Width = m_WindowWidth;
+				m_Views.GetView(m_MainView).Desc.Height = m_WindowHeight;
 
 				if (m_WindowWidth > 0 && m_WindowHeight > 0)
 				{
@@ -1138,7 +1771,7 @@ public:
 					// Recreate Bloom processor with new dimensions (Chapter 40)
 					if (m_Bloom)
 					{
-						VP_INFO("Recreating Bloom processor: {}x{}", m_WindowWidth / 2, m_WindowHeight / 2);
+						VP_INFO("Recreating Bloom processor: {}x{}", GetBloomWidth(), GetBloomHeight());
 						
 						// Preserve old bloom processor and settings
 						auto oldBloom = std::move(m_Bloom);
@@ -1146,7 +1779,7 @@ public:
 						try
 						{
 							// Attempt to create new bloom processor
-							auto newBloom = std::make_unique<VizEngine::Bloom>(m_WindowWidth / 2, m_WindowHeight / 2);
+							auto newBloom = std::make_unique<VizEngine::Bloom>(GetBloomWidth(), GetBloomHeight());
 							
 							if (newBloom)
 							{
@@ -1178,6 +1811,14 @@ public:
 			}
 		);
 
+		// Left click picks the object under the cursor (UIManager consumes clicks on ImGui windows)
+		dispatcher.Dispatch<VizEngine::MouseButtonPressedEvent>(
+			[this](VizEngine::MouseButtonPressedEvent& event) {
+				if (event.GetMouseButton() != VizEngine::MouseCode::Left) return false;
+				return PickObject(VizEngine::Input::GetMousePosition());
+			}
+		);
+
 		// F1 toggles Engine Stats panel
 		dispatcher.Dispatch<VizEngine::KeyPressedEvent>(
 			[this](VizEngine::KeyPressedEvent& event) {
@@ -1228,182 +1869,1071 @@ public:
 
 private:
 	// =========================================================================
-	// Helper: Compute Light-Space Matrix for Shadow Mapping
+	// Picking: camera ray against each mesh's BVH (built on first use)
 	// =========================================================================
-	glm::mat4 ComputeLightSpaceMatrix(const VizEngine::DirectionalLight& light)
+	bool PickObject(const glm::vec2& mousePosition)
 	{
-		// Step 1: Create view matrix looking from light toward scene
-		glm::vec3 lightDir = light.GetDirection();  // Normalized direction
+		if (m_WindowWidth <= 0 || m_WindowHeight <= 0) return false;
+
+		glm::vec2 ndc(2.0f * mousePosition.x / static_cast<float>(m_WindowWidth) - 1.0f,
+			1.0f - 2.0f * mousePosition.y / static_cast<float>(m_WindowHeight));
+		glm::mat4 invViewProj = glm::inverse(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
+		glm::vec4 nearPoint = invViewProj * glm::vec4(ndc, -1.0f, 1.0f);
+		glm::vec4 farPoint = invViewProj * glm::vec4(ndc, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 direction = glm::vec3(farPoint) / farPoint.w - origin;
+
+		// Object-space rays keep the unnormalized direction, so T is the
+		// fraction of the near-far segment for every object
+		int picked = -1;
+		float closest = 1.0f;
+		for (size_t i = 0; i < m_Scene.Size(); i++)
+		{
+			auto& obj = m_Scene[i];
+			if (!obj.Active || !obj.MeshPtr) continue;
 
-		// Position light "behind" the scene (directional lights are infinitely far)
-		glm::vec3 lightPos = -lightDir * 15.0f;
+			auto bvh = obj.MeshPtr->GetBVH();
+			if (!bvh) bvh = obj.MeshPtr->BuildBVH();
+			if (!bvh) continue;
 
-		// Handle degenerate up vector (when light direction is vertical)
-		glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
-		if (glm::abs(glm::dot(lightDir, up)) > 0.999f)
-		{
-			up = glm::vec3(0.0f, 0.0f, 1.0f);
+			glm::mat4 invModel = glm::inverse(obj.ObjectTransform.GetModelMatrix());
+			glm::vec3 localOrigin = glm::vec3(invModel * glm::vec4(origin, 1.0f));
+			glm::vec3 localDirection = glm::vec3(invModel * glm::vec4(direction, 0.0f));
+
+			VizEngine::RayHit hit;
+			if (bvh->Intersect(localOrigin, localDirection, hit, closest))
+			{
+				closest = hit.T;
+				picked = static_cast<int>(i);
+			}
 		}
 
-		glm::mat4 lightView = glm::lookAt(
-			lightPos,                      // Light position (behind scene)
-			glm::vec3(0.0f, 0.0f, 0.0f),  // Look at origin (scene center)
-			up                            // Up vector
-		);
+		if (picked < 0) return false;
+		m_SelectedObject = picked;
+		return true;
+	}
 
-		// Step 2: Create orthographic projection
-		// Coverage determines how much of the scene gets shadows
-		float orthoSize = 15.0f;  // Adjust based on scene size
+	/** Rays/sec of the selected object's BVH: a 256x256 grid of parallel rays across its bounds. */
+	void RunRayBenchmark()
+	{
+		m_RayBenchmark.clear();
+		if (m_SelectedObject < 0 || m_SelectedObject >= static_cast<int>(m_Scene.Size())) return;
+		auto& mesh = m_Scene[static_cast<size_t>(m_SelectedObject)].MeshPtr;
+		if (!mesh) return;
 
-		glm::mat4 lightProjection = glm::ortho(
-			-orthoSize, orthoSize,   // Left, right
-			-orthoSize, orthoSize,   // Bottom, top
-			0.1f, 30.0f              // Near, far planes
-		);
+		auto bvh = mesh->BuildBVH();
+		if (!bvh) return;
 
-		// Step 3: Combine into light-space matrix
-		return lightProjection * lightView;
+		const size_t gridSize = 256;
+		glm::vec3 boundsMin = bvh->GetBoundsMin();
+		glm::vec3 extent = bvh->GetBoundsMax() - boundsMin;
+		VizEngine::Vec3Stream origins, directions;
+		origins.Resize(gridSize * gridSize);
+		directions.Resize(gridSize * gridSize);
+		for (size_t y = 0; y < gridSize; y++)
+		{
+			for (size_t x = 0; x < gridSize; x++)
+			{
+				size_t i = y * gridSize + x;
+				float fx = (static_cast<float>(x) + 0.5f) / static_cast<float>(gridSize);
+				float fy = (static_cast<float>(y) + 0.5f) / static_cast<float>(gridSize);
+				origins.Set(i, glm::vec3(boundsMin.x + fx * extent.x, boundsMin.y + fy * extent.y,
+					boundsMin.z + extent.z + 1.0f));
+				directions.Set(i, glm::vec3(0.0f, 0.0f, -1.0f));
+			}
+		}
+		m_RayBenchmark = bvh->Benchmark(origins, directions);
 	}
 
 	// =========================================================================
-	// Helper: Render all scene objects with PBR materials
+	// Hi-Z: max-depth pyramid of the HDR depth buffer, rebuilt every frame
 	// =========================================================================
-	void RenderSceneObjects()
+	void BuildHiZPyramid()
 	{
-		auto& renderer = VizEngine::Engine::Get().GetRenderer();
-
-		if (!m_PBRMaterial) return;
-
-		// Chapter 33: Separate opaque and transparent objects
-		std::vector<size_t> opaqueIndices;
-		std::vector<size_t> transparentIndices;
-
-		for (size_t i = 0; i < m_Scene.Size(); i++)
+		if (!m_Downsampler)
 		{
-			auto& obj = m_Scene[i];
-			if (!obj.Active || !obj.MeshPtr) continue;
-
-			if (obj.Color.a < 1.0f)
-				transparentIndices.push_back(i);
-			else
-				opaqueIndices.push_back(i);
+			m_Downsampler = std::make_unique<VizEngine::Downsampler>();
 		}
-
-		// Render opaque objects first
-		for (size_t idx : opaqueIndices)
+		if (!m_Downsampler->IsValid())
 		{
-			RenderSingleObject(m_Scene[idx], renderer);
+			m_BuildHiZ = false;
+			return;
 		}
 
-		// Sort transparent objects back-to-front (Chapter 33)
-		if (!transparentIndices.empty())
+		int width = m_HDRDepthTexture->GetWidth();
+		int height = m_HDRDepthTexture->GetHeight();
+		if (!m_HiZPyramid || m_HiZPyramid->GetWidth() != width || m_HiZPyramid->GetHeight() != height)
 		{
-			glm::vec3 camPos = m_Camera.GetPosition();
-			std::sort(transparentIndices.begin(), transparentIndices.end(),
-				[this, &camPos](size_t a, size_t b) {
-					float distA = glm::length(m_Scene[a].ObjectTransform.Position - camPos);
-					float distB = glm::length(m_Scene[b].ObjectTransform.Position - camPos);
-					return distA > distB;  // Far objects first
-				});
+			m_HiZPyramid = std::make_shared<VizEngine::Texture>(width, height, GL_R32F, GL_RED, GL_FLOAT);
+			m_HiZPyramid->AllocateMipLevels();
+			m_HiZPyramid->SetFilter(GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
+		}
 
-			// Enable blending for transparent objects
-			renderer.EnableBlending();
-			renderer.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			renderer.SetDepthMask(false);  // Don't write to depth buffer
+		m_Downsampler->GenerateFrom(*m_HDRDepthTexture, *m_HiZPyramid, VizEngine::DownsampleReduction::Max);
+	}
+
+	// =========================================================================
+	// Regression: canonical cases compared against golden images
+	// =========================================================================
+	void SetupRegression()
+	{
+		VizEngine::RegressionConfig config;
+		config.UpdateGoldens = m_UpdateGoldens;
+		if (!m_GoldenDir.empty()) config.GoldenDir = m_GoldenDir;
+		m_Regression = std::make_unique<VizEngine::RegressionHarness>(config);
+
+		// Every case starts from the same state; nothing animates
+		auto resetState = [this]() {
+			m_RotationSpeed = 0.0f;
+			for (size_t i = 0; i < m_Scene.Size(); i++)
+			{
+				VizEngine::SceneObject& obj = m_Scene[i];
+				if (obj.ObjectTransform.Rotation == glm::vec3(0.0f)) continue;
+				obj.ObjectTransform.Rotation = glm::vec3(0.0f);
+				m_Scene.MarkChanged(i, VizEngine::SceneChange::Transform);
+			}
+			m_Camera = VizEngine::Camera(45.0f, static_cast<float>(m_WindowWidth) / static_cast<float>(m_WindowHeight), 0.1f, 100.0f);
+			m_Camera.SetPosition(glm::vec3(0.0f, 6.0f, -15.0f));
 
-			for (size_t idx : transparentIndices)
+			m_ShowSkybox = true;
+			m_UseIBL = true;
+			for (int map = 0; map < 3; map++)
 			{
-				RenderSingleObject(m_Scene[idx], renderer);
+				if (m_CubemapStorage[map] == 0) continue;
+				m_CubemapStorage[map] = 0;
+				ApplyCubemapStorage(map);
 			}
+			m_EnableBloom = true;
+			m_BloomIntensity = 0.04f;
+			m_ToneMappingMode = 3;
+			m_Exposure = 1.0f;
+			m_EnableColorGrading = false;
+			m_EnableOutlines = false;
+			m_ShowInstancingDemo = false;
+			m_DebugView = 0;
+			m_MeasureOverdraw = false;
+		};
 
-			// Restore state
-			renderer.SetDepthMask(true);
-			renderer.DisableBlending();
-		}
+		m_Regression->AddCase("default_view", resetState);
+
+		m_Regression->AddCase("shadow_closeup", [this, resetState]() {
+			resetState();
+			m_Camera.SetPosition(glm::vec3(5.0f, 3.0f, -6.0f));
+			m_Camera.SetRotation(-0.35f, 0.6f);
+		});
+
+		m_Regression->AddCase("no_post", [this, resetState]() {
+			resetState();
+			m_EnableBloom = false;
+			m_ToneMappingMode = 0;
+			m_ShowSkybox = false;
+		});
+
+		m_Regression->AddCase("bright_bloom", [this, resetState]() {
+			resetState();
+			m_Exposure = 2.0f;
+			m_BloomIntensity = 0.2f;
+		});
+
+		m_Regression->AddCase("instancing", [this, resetState]() {
+			resetState();
+			m_ShowInstancingDemo = true;
+		});
+
+		m_Regression->Start();
 	}
 
-	// Helper: Render a single scene object with PBR material
-	void RenderSingleObject(VizEngine::SceneObject& obj, VizEngine::Renderer& renderer)
+	// =========================================================================
+	// Scene files: save the current scene and lights, load them back
+	// =========================================================================
+	void SaveScene(const std::string& path)
 	{
-		glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
-		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+		VizEngine::SceneEnvironment environment;
+		environment.Sun = m_Light;
+		for (int i = 0; i < 4; i++)
+		{
+			VizEngine::PointLight light(m_PBRLightPositions[i]);
+			light.Diffuse = m_PBRLightColors[i];   // Radiance as used by defaultlit
+			environment.PointLights.push_back(light);
+		}
+		environment.EnvironmentMap = "resources/textures/environments/qwantani_dusk_2_puresky_2k.hdr";
+		environment.UseIBL = m_UseIBL;
+		environment.IBLIntensity = m_IBLIntensity;
+		environment.LowerHemisphereColor = m_LowerHemisphereColor;
+		environment.LowerHemisphereIntensity = m_LowerHemisphereIntensity;
+		environment.ClearColor = glm::vec4(m_ClearColor[0], m_ClearColor[1], m_ClearColor[2], m_ClearColor[3]);
+
+		VizEngine::SceneFile::Save(path, m_Scene, environment, m_SceneAssets);
+	}
 
-		// Use Material System (Chapter 42)
-		m_PBRMaterial->SetModelMatrix(model);
-		m_PBRMaterial->SetNormalMatrix(normalMatrix);
-		m_PBRMaterial->SetAlbedo(glm::vec3(obj.Color));
-		m_PBRMaterial->SetAlpha(obj.Color.a);  // Chapter 33: alpha transparency
-		m_PBRMaterial->SetMetallic(obj.Metallic);
-		m_PBRMaterial->SetRoughness(obj.Roughness);
-		m_PBRMaterial->SetAO(1.0f);
+	void LoadScene(const std::string& path)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		auto file = VizEngine::SceneFile::Open(path);
+		if (!file) return;
 
-		// Handle texture
-		if (obj.TexturePtr)
+		m_SelectedObject = -1;
+		m_Scene.Clear();
+		size_t count = file->Instantiate(m_Scene, m_SceneAssets);
+
+		// The environment map is fixed at startup; only lighting values are restored
+		VizEngine::SceneEnvironment environment = file->ReadEnvironment();
+		if (environment.HasSun)
 		{
-			m_PBRMaterial->SetAlbedoTexture(obj.TexturePtr);
+			m_Light = environment.Sun;
 		}
-		else
+		for (size_t i = 0; i < environment.PointLights.size() && i < 4; i++)
 		{
-			m_PBRMaterial->SetAlbedoTexture(nullptr);
+			m_PBRLightPositions[i] = environment.PointLights[i].Position;
+			m_PBRLightColors[i] = environment.PointLights[i].Diffuse;
+		}
+		m_UseIBL = environment.UseIBL;
+		m_IBLIntensity = environment.IBLIntensity;
+		m_LowerHemisphereColor = environment.LowerHemisphereColor;
+		m_LowerHemisphereIntensity = environment.LowerHemisphereIntensity;
+		for (int i = 0; i < 4; i++)
+		{
+			m_ClearColor[i] = environment.ClearColor[i];
 		}
 
-		// Bind material (uploads all uniforms)
-		m_PBRMaterial->Bind();
-
-		obj.MeshPtr->Bind();
-		renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(),
-		              *m_PBRMaterial->GetShader());
+		auto end = std::chrono::high_resolution_clock::now();
+		VP_INFO("Loaded scene '{}': {} objects in {:.2f} ms", path, count,
+			std::chrono::duration<double, std::milli>(end - start).count());
 	}
 
 	// =========================================================================
-	// Helper: Setup default lit shader with common uniforms
+	// Scalability: (re)create tier-dependent resources
 	// =========================================================================
-	void SetupDefaultLitShader()
+	void CreateShadowMap(int shadowMapResolution)
 	{
-		if (!m_PBRMaterial) return;
-
-		// Set camera matrices on material
-		m_PBRMaterial->SetViewMatrix(m_Camera.GetViewMatrix());
-		m_PBRMaterial->SetProjectionMatrix(m_Camera.GetProjectionMatrix());
-		m_PBRMaterial->SetViewPosition(m_Camera.GetPosition());
+		// Create depth texture for shadow map
+		m_ShadowMapDepth = std::make_shared<VizEngine::Texture>(
+			shadowMapResolution, shadowMapResolution,
+			GL_DEPTH_COMPONENT24,   // Internal format (24-bit depth)
+			GL_DEPTH_COMPONENT,     // Format
+			GL_FLOAT                // Data type
+		);
+		
+		// Configure shadow map texture for correct sampling
+		m_ShadowMapDepth->SetWrap(GL_CLAMP_TO_BORDER, GL_CLAMP_TO_BORDER);
+		float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		m_ShadowMapDepth->SetBorderColor(borderColor);
 
-		// Configure lights via shader (material doesn't have light setters yet)
-		auto shader = m_PBRMaterial->GetShader();
-		shader->Bind();
+		// Create framebuffer and attach depth texture only (no color)
+		m_ShadowMapFramebuffer = std::make_shared<VizEngine::Framebuffer>(
+			shadowMapResolution, shadowMapResolution
+		);
+		m_ShadowMapFramebuffer->AttachDepthTexture(m_ShadowMapDepth);
 
-		shader->SetInt("u_LightCount", 4);
-		for (int i = 0; i < 4; ++i)
+		// Verify shadow map framebuffer is complete
+		if (!m_ShadowMapFramebuffer->IsComplete())
 		{
-			shader->SetVec3("u_LightPositions[" + std::to_string(i) + "]", m_PBRLightPositions[i]);
-			shader->SetVec3("u_LightColors[" + std::to_string(i) + "]", m_PBRLightColors[i]);
+			VP_ERROR("Shadow map framebuffer is not complete! Disabling shadows.");
+			m_ShadowMapFramebuffer.reset();
+			// Also reset depth texture to avoid binding invalid texture
+			m_ShadowMapDepth.reset();
+			m_ShowShadowMap = false;
 		}
-
-		// Directional light
-		shader->SetBool("u_UseDirLight", true);
-		shader->SetVec3("u_DirLightDirection", m_Light.GetDirection());
-		shader->SetVec3("u_DirLightColor", m_Light.Diffuse);
-
-		// Shadow mapping (only enable if shadow map resource is valid)
-		if (m_ShadowMapDepth)
+		else
 		{
-			m_PBRMaterial->SetLightSpaceMatrix(m_LightSpaceMatrix);
-			m_PBRMaterial->SetShadowMap(m_ShadowMapDepth);
-			m_PBRMaterial->SetUseShadows(true);
+			VP_INFO("Shadow map framebuffer created: {}x{}", shadowMapResolution, shadowMapResolution);
 		}
-		else
+	}
+
+	void GenerateIBL(const VizEngine::ScalabilitySettings& quality)
+	{
+		// Convolve the full-precision environment even if the skybox shows a compact copy
+		const auto& environment = m_CubemapSources[0];
+		if (!environment) return;
+
+		auto iblStart = std::chrono::high_resolution_clock::now();
+
+		m_IrradianceMap = VizEngine::CubemapUtils::GenerateIrradianceMap(
+			environment, quality.IrradianceResolution, quality.IrradianceSampleDelta);
+		m_PrefilteredMap = VizEngine::CubemapUtils::GeneratePrefilteredMap(
+			environment, quality.PrefilterResolution, quality.PrefilterSampleCount);
+		m_CubemapSources[1] = m_IrradianceMap;
+		m_CubemapSources[2] = m_PrefilteredMap;
+		ApplyCubemapStorage(1);
+		ApplyCubemapStorage(2);
+		if (!m_BRDFLut)
 		{
-			m_PBRMaterial->SetShadowMap(nullptr);
-			m_PBRMaterial->SetUseShadows(false);
+			// Environment-independent, generated once
+			m_BRDFLut = VizEngine::CubemapUtils::GenerateBRDFLUT(512);
 		}
 
-		// IBL (only enable if all IBL resources are valid)
-		const bool iblResourcesValid = m_UseIBL && m_IrradianceMap && m_PrefilteredMap && m_BRDFLut;
-		m_PBRMaterial->SetUseIBL(iblResourcesValid);
-		if (iblResourcesValid)
+		// Validate IBL maps and disable IBL if any failed
+		if (!m_IrradianceMap)
 		{
-			m_PBRMaterial->SetIrradianceMap(m_IrradianceMap);
-			m_PBRMaterial->SetPrefilteredMap(m_PrefilteredMap);
-			m_PBRMaterial->SetBRDFLUT(m_BRDFLut);
+			VP_ERROR("Failed to generate irradiance map - IBL disabled");
+			m_UseIBL = false;
+		}
+		if (!m_PrefilteredMap)
+		{
+			VP_ERROR("Failed to generate prefiltered environment map - IBL disabled");
+			m_UseIBL = false;
+		}
+		if (!m_BRDFLut)
+		{
+			VP_ERROR("Failed to generate BRDF LUT - IBL disabled");
+			m_UseIBL = false;
+		}
+
+		auto iblEnd = std::chrono::high_resolution_clock::now();
+		auto iblDuration = std::chrono::duration_cast<std::chrono::milliseconds>(iblEnd - iblStart);
+		if (m_UseIBL)
+		{
+			VP_INFO("IBL maps generated in {}ms", iblDuration.count());
+		}
+		m_IBLTier = m_Scalability.GetTier();
+	}
+
+	/**
+	 * Store one of the HDR cubemaps (0 = environment, 1 = irradiance,
+	 * 2 = prefiltered) in its selected format, converted from the RGB16F
+	 * original, and record the error report.
+	 */
+	void ApplyCubemapStorage(int map)
+	{
+		const auto& source = m_CubemapSources[map];
+		if (!source) return;
+
+		auto storage = static_cast<VizEngine::CubemapStorage>(m_CubemapStorage[map]);
+		auto converted = VizEngine::CubemapUtils::ConvertStorage(source, storage, &m_CubemapReports[map]);
+		if (!converted)
+		{
+			VP_WARN("Cubemap storage conversion failed, keeping RGB16F");
+			m_CubemapStorage[map] = static_cast<int>(VizEngine::CubemapStorage::RGB16F);
+			m_CubemapReports[map] = VizEngine::CubemapStorageReport();
+			converted = source;
+		}
+
+		std::shared_ptr<VizEngine::Texture>* targets[3] = { &m_SkyboxCubemap, &m_IrradianceMap, &m_PrefilteredMap };
+		*targets[map] = converted;
+		if (map == 0)
+		{
+			m_Skybox = std::make_unique<VizEngine::Skybox>(m_SkyboxCubemap);
+		}
+	}
+
+	int GetBloomWidth() const
+	{
+		return std::max(1, static_cast<int>(static_cast<float>(m_WindowWidth) * m_Scalability.GetSettings().BloomResolutionScale));
+	}
+
+	int GetBloomHeight() const
+	{
+		return std::max(1, static_cast<int>(static_cast<float>(m_WindowHeight) * m_Scalability.GetSettings().BloomResolutionScale));
+	}
+
+	/**
+	 * Apply the current tier. Precomputed IBL is only rebuilt when asked
+	 * (after calibration or a manual change), not on automatic adjustments:
+	 * it costs a hitch and has no per-frame cost to win back.
+	 */
+	void ApplyScalability(bool rebuildIBL)
+	{
+		const VizEngine::ScalabilitySettings& quality = m_Scalability.GetSettings();
+		VP_INFO("Applying {} quality tier", VizEngine::ScalabilityManager::GetTierName(m_Scalability.GetTier()));
+
+		if (!m_ShadowMapFramebuffer || m_ShadowMapFramebuffer->GetWidth() != quality.ShadowMapResolution)
+		{
+			CreateShadowMap(quality.ShadowMapResolution);
+		}
+
+		m_EnableBloom = quality.BloomEnabled;
+		m_BloomBlurPasses = quality.BloomBlurPasses;
+		if (m_Bloom && (m_Bloom->GetWidth() != GetBloomWidth() || m_Bloom->GetHeight() != GetBloomHeight()))
+		{
+			m_Bloom = std::make_unique<VizEngine::Bloom>(GetBloomWidth(), GetBloomHeight());
+			m_Bloom->SetThreshold(m_BloomThreshold);
+			m_Bloom->SetKnee(m_BloomKnee);
+			m_Bloom->SetBlurPasses(m_BloomBlurPasses);
+		}
+
+		m_ActiveLightCount = std::clamp(quality.MaxPointLights, 0, 4);
+		m_ShadowFilter.Mode = quality.ShadowFilter;
+		m_ShadowFilter.Taps = quality.ShadowFilterTaps;
+
+		if (rebuildIBL && m_IBLTier != m_Scalability.GetTier())
+		{
+			GenerateIBL(quality);
+		}
+	}
+
+	// =========================================================================
+	// Helper: Root transform for a duck instance
+	// =========================================================================
+	static VizEngine::Transform DuckTransform(const glm::vec3& position)
+	{
+		// Duck.glb's root node already scales by 0.01; 2x gives the usual 0.02
+		return VizEngine::Transform(position, glm::vec3(0.0f), glm::vec3(2.0f));
+	}
+
+	// =========================================================================
+	// Helper: Compute Light-Space Matrix for Shadow Mapping
+	// =========================================================================
+	glm::mat4 ComputeLightSpaceMatrix(const VizEngine::DirectionalLight& light)
+	{
+		// Step 1: Create view matrix looking from light toward scene
+		glm::vec3 lightDir = light.GetDirection();  // Normalized direction
+
+		// Position light "behind" the scene (directional lights are infinitely far)
+		glm::vec3 lightPos = -lightDir * 15.0f;
+
+		// Handle degenerate up vector (when light direction is vertical)
+		glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+		if (glm::abs(glm::dot(lightDir, up)) > 0.999f)
+		{
+			up = glm::vec3(0.0f, 0.0f, 1.0f);
+		}
+
+		glm::mat4 lightView = glm::lookAt(
+			lightPos,                      // Light position (behind scene)
+			glm::vec3(0.0f, 0.0f, 0.0f),  // Look at origin (scene center)
+			up                            // Up vector
+		);
+
+		// Step 2: Create orthographic projection
+		// Coverage determines how much of the scene gets shadows
+		float orthoSize = 15.0f;  // Adjust based on scene size
+
+		glm::mat4 lightProjection = glm::ortho(
+			-orthoSize, orthoSize,   // Left, right
+			-orthoSize, orthoSize,   // Bottom, top
+			0.1f, 30.0f              // Near, far planes
+		);
+
+		// Step 3: Combine into light-space matrix
+		return lightProjection * lightView;
+	}
+
+	// =========================================================================
+	// Helper: Render all scene objects visible in a view with PBR materials
+	// =========================================================================
+	void RenderSceneObjects(const VizEngine::RenderView& view, const std::vector<uint32_t>* opaque = nullptr,
+	                        const std::vector<uint32_t>* transparent = nullptr)
+	{
+		// Chapter 33: Opaque first, then transparent back-to-front. Lists and
+		// matrices come from RenderViewSet::BeginFrame, shared by every view.
+		// 'opaque' and 'transparent' replace the view's lists (subsets left to
+		// this pass by the visibility buffer and the reduced-resolution pass).
+		// Passes with other opaque geometry call the two halves themselves.
+		RenderOpaqueObjects(view, opaque);
+		RenderTransparentObjects(view, transparent);
+	}
+
+	// Helper: Opaque half of RenderSceneObjects()
+	void RenderOpaqueObjects(const VizEngine::RenderView& view, const std::vector<uint32_t>* opaque = nullptr)
+	{
+		auto& renderer = VizEngine::Engine::Get().GetRenderer();
+
+		if (!m_PBRMaterial) return;
+
+		const auto& objects = m_Views.GetObjects();
+
+		// Prefab batches become one instanced draw each
+		BuildInstancedRuns(opaque ? *opaque : view.Opaque);
+		for (uint32_t i : m_SingleObjects)
+		{
+			const auto& data = objects[i];
+			RenderSingleObject(m_Scene[data.SceneIndex], data.Model, data.Normal, renderer);
+		}
+		RenderInstancedRuns(renderer);
+	}
+
+	// Helper: Transparent half of RenderSceneObjects(), after all opaque geometry
+	void RenderTransparentObjects(const VizEngine::RenderView& view, const std::vector<uint32_t>* transparent = nullptr)
+	{
+		auto& renderer = VizEngine::Engine::Get().GetRenderer();
+
+		if (!m_PBRMaterial) return;
+
+		const auto& objects = m_Views.GetObjects();
+		const auto& transparentList = transparent ? *transparent : view.Transparent;
+		if (!transparentList.empty())
+		{
+			// Enable blending for transparent objects
+			renderer.EnableBlending();
+			renderer.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			renderer.SetDepthMask(false);  // Don't write to depth buffer
+
+			for (uint32_t i : transparentList)
+			{
+				const auto& data = objects[i];
+				RenderSingleObject(m_Scene[data.SceneIndex], data.Model, data.Normal, renderer);
+			}
+
+			// Restore state
+			renderer.SetDepthMask(true);
+			renderer.DisableBlending();
+		}
+	}
+
+	// Helper: Render a single scene object with PBR material
+	void RenderSingleObject(const VizEngine::SceneObject& obj, const glm::mat4& model,
+	                        const glm::mat3& normalMatrix, VizEngine::Renderer& renderer)
+	{
+		// Resolve handles to raw pointers (no shared_ptr copies in the draw loop)
+		const auto& resources = VizEngine::Engine::Get().GetResources();
+		VizEngine::Mesh* mesh = resources.Get(obj.MeshId);
+		if (!mesh) return;
+
+		// Use Material System (Chapter 42)
+		m_PBRMaterial->SetModelMatrix(model);
+		m_PBRMaterial->SetNormalMatrix(normalMatrix);
+		SetObjectMaterial(obj);
+
+		// Bind material (uploads all uniforms)
+		m_PBRMaterial->Bind();
+
+		mesh->Bind();
+		renderer.Draw(mesh->GetVertexArray(), mesh->GetIndexBuffer(),
+		              *m_PBRMaterial->GetShader());
+	}
+
+	// Helper: Surface parameters of an object on the scene PBR material
+	void SetObjectMaterial(const VizEngine::SceneObject& obj)
+	{
+		m_PBRMaterial->SetAlbedo(glm::vec3(obj.Color));
+		m_PBRMaterial->SetAlpha(obj.Color.a);  // Chapter 33: alpha transparency
+		m_PBRMaterial->SetMetallic(obj.Metallic);
+		m_PBRMaterial->SetRoughness(obj.Roughness);
+		m_PBRMaterial->SetAO(1.0f);
+
+		// Handle texture (null handle resolves to null and disables the map)
+		m_PBRMaterial->SetAlbedoTexture(VizEngine::Engine::Get().GetResources().Get(obj.TextureId));
+	}
+
+	// Helper: Draw the runs of the last BuildInstancedRuns() with PBR materials
+	void RenderInstancedRuns(VizEngine::Renderer& renderer)
+	{
+		if (m_InstancedRuns.empty()) return;
+
+		const auto& resources = VizEngine::Engine::Get().GetResources();
+		const auto& objects = m_Views.GetObjects();
+		UploadInstanceTransforms();
+
+		// A batch shares mesh and material, so the first instance stands for all
+		m_PBRMaterial->SetInstanced(true);
+		for (const InstancedRun& run : m_InstancedRuns)
+		{
+			const VizEngine::SceneObject& obj = m_Scene[objects[m_RunObjects[run.First]].SceneIndex];
+			VizEngine::Mesh* mesh = resources.Get(obj.MeshId);
+			if (!mesh) continue;
+
+			SetObjectMaterial(obj);
+			m_PBRMaterial->Bind();
+
+			mesh->Bind();
+			renderer.DrawInstanced(mesh->GetVertexArray(), mesh->GetIndexBuffer(),
+			                       *m_PBRMaterial->GetShader(), static_cast<int>(run.Count), run.First);
+		}
+		m_PBRMaterial->SetInstanced(false);
+	}
+
+	// =========================================================================
+	// Helper: Prefab batch of every scene object, for the instanced draws
+	// =========================================================================
+	void UpdatePrefabBatchLookup()
+	{
+		const auto& batches = m_Scene.GetPrefabBatches();
+		m_PrefabBatchOf.assign(m_Scene.Size(), -1);
+		for (size_t batch = 0; batch < batches.size(); batch++)
+		{
+			for (size_t index : batches[batch].Objects)
+			{
+				m_PrefabBatchOf[index] = static_cast<int32_t>(batch);
+			}
+		}
+	}
+
+	// =========================================================================
+	// Helper: Split a list of frame objects into instanced prefab runs
+	// =========================================================================
+	/**
+	 * Objects of one prefab batch that appear at least twice in the list
+	 * form a run (m_InstancedRuns, objects in m_RunObjects), drawn with one
+	 * instanced draw; everything else goes to m_SingleObjects. Runs are in
+	 * order of their first object, and objects keep their list order.
+	 */
+	void BuildInstancedRuns(const std::vector<uint32_t>& list)
+	{
+		constexpr uint32_t NoRun = std::numeric_limits<uint32_t>::max();
+		const auto& objects = m_Views.GetObjects();
+		const size_t batchCount = m_Scene.GetPrefabBatches().size();
+
+		m_BatchCount.assign(batchCount, 0);
+		m_BatchRun.assign(batchCount, NoRun);
+		for (uint32_t i : list)
+		{
+			int32_t batch = m_PrefabBatchOf[objects[i].SceneIndex];
+			if (batch >= 0) m_BatchCount[batch]++;
+		}
+
+		m_InstancedRuns.clear();
+		m_SingleObjects.clear();
+		uint32_t runObjects = 0;
+		for (uint32_t i : list)
+		{
+			int32_t batch = m_PrefabBatchOf[objects[i].SceneIndex];
+			if (batch < 0 || m_BatchCount[batch] < 2)
+			{
+				m_SingleObjects.push_back(i);
+				continue;
+			}
+
+			if (m_BatchRun[batch] == NoRun)
+			{
+				m_BatchRun[batch] = static_cast<uint32_t>(m_InstancedRuns.size());
+				m_InstancedRuns.push_back({ runObjects, 0 });
+				runObjects += m_BatchCount[batch];
+				m_RunObjects.resize(runObjects);
+			}
+			InstancedRun& run = m_InstancedRuns[m_BatchRun[batch]];
+			m_RunObjects[run.First + run.Count++] = i;
+		}
+		m_RunObjects.resize(runObjects);
+	}
+
+	// Helper: Upload the matrices of m_RunObjects and bind them for instanced draws
+	void UploadInstanceTransforms()
+	{
+		const auto& objects = m_Views.GetObjects();
+		m_InstanceTransforms.resize(m_RunObjects.size());
+		for (size_t i = 0; i < m_RunObjects.size(); i++)
+		{
+			const auto& data = objects[m_RunObjects[i]];
+			VizEngine::InstanceTransformGPU& instance = m_InstanceTransforms[i];
+			instance.Model = data.Model;
+			instance.NormalMatrix[0] = glm::vec4(data.Normal[0], 0.0f);
+			instance.NormalMatrix[1] = glm::vec4(data.Normal[1], 0.0f);
+			instance.NormalMatrix[2] = glm::vec4(data.Normal[2], 0.0f);
+		}
+
+		size_t bytes = m_InstanceTransforms.size() * sizeof(VizEngine::InstanceTransformGPU);
+		if (!m_InstanceTransformBuffer)
+		{
+			m_InstanceTransformBuffer = std::make_unique<VizEngine::ShaderStorageBuffer>(m_InstanceTransforms.data(), bytes);
+		}
+		else
+		{
+			m_InstanceTransformBuffer->SetData(m_InstanceTransforms.data(), bytes);
+		}
+		m_InstanceTransformBuffer->BindBase(VizEngine::PBRMaterial::InstanceTransformBinding);
+	}
+
+	// =========================================================================
+	// Helper: Visibility buffer geometry pass for a view's opaque objects
+	// =========================================================================
+	bool RenderVisibilityGeometry(const VizEngine::RenderView& view)
+	{
+		if (!m_VisibilityMaterial || m_WindowWidth <= 0 || m_WindowHeight <= 0) return false;
+
+		if (!m_VisibilityBuffer)
+		{
+			m_VisibilityBuffer = std::make_unique<VizEngine::VisibilityBuffer>(m_WindowWidth, m_WindowHeight);
+		}
+		m_VisibilityBuffer->Resize(m_WindowWidth, m_WindowHeight);
+		if (!m_VisibilityBuffer->IsValid()) return false;
+
+		VP_PROFILE_PASS("Visibility");
+		const auto& resources = VizEngine::Engine::Get().GetResources();
+		const auto& objects = m_Views.GetObjects();
+
+		m_VisibilityBuffer->BeginFrame();
+		m_VisibilityForward.clear();
+
+		// Prefab runs back to back, so each becomes one instanced command, then the rest
+		BuildInstancedRuns(view.Opaque);
+		m_RunObjects.insert(m_RunObjects.end(), m_SingleObjects.begin(), m_SingleObjects.end());
+		for (uint32_t i : m_RunObjects)
+		{
+			const auto& data = objects[i];
+			const VizEngine::SceneObject& obj = m_Scene[data.SceneIndex];
+			VizEngine::Mesh* mesh = resources.Get(obj.MeshId);
+			if (!mesh) continue;
+
+			VizEngine::VisibilityMaterial material;
+			material.BaseColor = obj.Color;
+			material.Metallic = obj.Metallic;
+			material.Roughness = obj.Roughness;
+			material.AlbedoTexture = resources.Get(obj.TextureId);
+
+			if (!m_VisibilityBuffer->Submit(obj.MeshId, *mesh, data.Model, data.Normal, material))
+			{
+				m_VisibilityForward.push_back(i);
+			}
+		}
+
+		m_VisibilityBuffer->RenderGeometry(view.ViewProjection);
+		return true;
+	}
+
+	// =========================================================================
+	// Helper: Page requests, caster changes and allocation for virtual shadows
+	// =========================================================================
+	bool UpdateVirtualShadows(const VizEngine::RenderView& view)
+	{
+		if (!m_ShadowDepthShader || !m_HDRDepthTexture) return false;
+
+		if (!m_VirtualShadows)
+		{
+			m_VirtualShadows = std::make_unique<VizEngine::VirtualShadowMap>();
+		}
+		if (!m_VirtualShadows->IsValid()) return false;
+
+		m_VirtualShadows->SetLodBias(m_VirtualShadowLodBias);
+		m_VirtualShadows->Update(view.View, view.Projection, m_HDRDepthTexture->GetHeight(),
+			m_Light.GetDirection(), m_Views.GetObjects());
+		return true;
+	}
+
+	// =========================================================================
+	// Helper: Open the point cloud on first use and select its nodes
+	// =========================================================================
+	bool UpdatePointCloud(const VizEngine::RenderView& view)
+	{
+		if (m_PointCloudPath.empty() || !m_HDRDepthTexture) return false;
+
+		if (!m_PointCloud)
+		{
+			m_PointCloud = std::make_unique<VizEngine::PointCloud>();
+			if (!m_PointCloud->Open(m_PointCloudPath))
+			{
+				m_PointCloud.reset();
+				m_PointCloudPath.clear();   // Don't retry every frame
+				return false;
+			}
+			PlacePointCloud();
+		}
+
+		m_PointCloud->Update(view.View, view.Projection, m_HDRDepthTexture->GetHeight());
+		return true;
+	}
+
+	// =========================================================================
+	// Helper: Center the point cloud at the origin, scaled to m_PointCloudExtent
+	// =========================================================================
+	void PlacePointCloud()
+	{
+		if (!m_PointCloud) return;
+
+		float size = m_PointCloud->GetSize();
+		glm::mat4 model = glm::mat4(1.0f);
+		if (m_PointCloudZUp)
+		{
+			// Scans are usually Z-up; the engine is Y-up
+			model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+		}
+		model = glm::scale(model, glm::vec3(m_PointCloudExtent / size));
+		model = glm::translate(model, glm::vec3(-0.5f * size));
+		m_PointCloud->SetTransform(model);
+	}
+
+	// =========================================================================
+	// Helper: Create the volume renderer and its volume on first use
+	// =========================================================================
+	bool EnsureVolume()
+	{
+		if (m_VolumeFailed || !m_HDRDepthTexture) return false;
+		if (m_VolumeRenderer) return true;
+
+		auto volumeRenderer = std::make_unique<VizEngine::VolumeRenderer>();
+		std::shared_ptr<VizEngine::Texture3D> volume = !m_VolumePath.empty()
+			? VizEngine::VolumeRenderer::LoadRaw(m_VolumePath, m_VolumeFileSize.x, m_VolumeFileSize.y,
+				m_VolumeFileSize.z, m_VolumeFileFormat)
+			: CreateVolumePhantom(160);
+		if (!volumeRenderer->SetVolume(volume))
+		{
+			m_VolumeFailed = true;   // Don't retry every frame
+			m_ShowVolume = false;
+			return false;
+		}
+
+		m_VolumeRenderer = std::move(volumeRenderer);
+		ApplyVolumePreset();
+		PlaceVolume();
+		return true;
+	}
+
+	// =========================================================================
+	// Helper: CT-like head phantom (air, skin, soft tissue, skull, ventricles)
+	// =========================================================================
+	static std::shared_ptr<VizEngine::Texture3D> CreateVolumePhantom(int size)
+	{
+		std::vector<uint16_t> voxels(static_cast<size_t>(size) * size * size);
+		const float inv = 2.0f / static_cast<float>(size - 1);
+
+		for (int z = 0; z < size; z++)
+		{
+			for (int y = 0; y < size; y++)
+			{
+				for (int x = 0; x < size; x++)
+				{
+					glm::vec3 p = glm::vec3(x, y, z) * inv - 1.0f;
+
+					// Distance to the head surface in units of its radii
+					float head = glm::length(p / glm::vec3(0.72f, 0.88f, 0.8f));
+					float value = 0.0f;
+					if (head < 1.0f)
+					{
+						value = 0.3f;                                        // Skin and soft tissue
+						if (head > 0.86f && head < 0.95f) value = 0.85f;     // Skull
+						else if (head <= 0.86f) value = 0.4f;                // Brain
+
+						// Ventricles: two fluid-filled lobes
+						glm::vec3 lobe(std::abs(p.x) - 0.14f, p.y - 0.05f, p.z);
+						if (glm::length(lobe / glm::vec3(0.08f, 0.22f, 0.3f)) < 1.0f) value = 0.22f;
+
+						// Dense inclusions
+						if (glm::length(p - glm::vec3(0.25f, -0.3f, 0.2f)) < 0.08f) value = 1.0f;
+						if (glm::length(p - glm::vec3(-0.3f, 0.35f, -0.15f)) < 0.05f) value = 0.95f;
+
+						// Scanner noise keeps tissue from looking synthetic
+						uint32_t h = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u);
+						value += (static_cast<float>(h % 1024) / 1023.0f - 0.5f) * 0.03f;
+					}
+
+					voxels[(static_cast<size_t>(z) * size + y) * size + x] =
+						static_cast<uint16_t>(glm::clamp(value, 0.0f, 1.0f) * 65535.0f);
+				}
+			}
+		}
+
+		return std::make_shared<VizEngine::Texture3D>(size, size, size, GL_R16, GL_RED, GL_UNSIGNED_SHORT, voxels.data());
+	}
+
+	// =========================================================================
+	// Helper: Apply the selected transfer function preset
+	// =========================================================================
+	void ApplyVolumePreset()
+	{
+		if (!m_VolumeRenderer) return;
+
+		switch (m_VolumePreset)
+		{
+		case 0: m_VolumeRenderer->SetTransferFunction(VizEngine::VolumeTransferFunction::Grayscale()); break;
+		case 1: m_VolumeRenderer->SetTransferFunction(VizEngine::VolumeTransferFunction::SoftTissue()); break;
+		default: m_VolumeRenderer->SetTransferFunction(VizEngine::VolumeTransferFunction::Bone()); break;
+		}
+	}
+
+	// =========================================================================
+	// Helper: Stand the volume above the ground, longest side m_VolumeExtent
+	// =========================================================================
+	void PlaceVolume()
+	{
+		if (!m_VolumeRenderer || !m_VolumeRenderer->GetVolume()) return;
+
+		const auto& volume = *m_VolumeRenderer->GetVolume();
+		glm::vec3 voxels(volume.GetWidth(), volume.GetHeight(), volume.GetDepth());
+		glm::vec3 extent = voxels * (m_VolumeExtent / std::max(voxels.x, std::max(voxels.y, voxels.z)));
+
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.5f * extent.y, 0.0f));
+		model = glm::scale(model, extent);
+		model = glm::translate(model, glm::vec3(-0.5f));
+		m_VolumeRenderer->SetTransform(model);
+	}
+
+	// =========================================================================
+	// Helper: Split a view's transparents by their reduced-resolution opt-in
+	// =========================================================================
+	bool SplitLowResTransparents(const VizEngine::RenderView& view)
+	{
+		m_FullResTransparent.clear();
+		m_LowResTransparent.clear();
+		if (!m_HDRDepthTexture) return false;
+
+		// Both lists stay back-to-front
+		const auto& objects = m_Views.GetObjects();
+		for (uint32_t i : view.Transparent)
+		{
+			const bool lowRes = m_Scene[objects[i].SceneIndex].LowResolution;
+			(lowRes ? m_LowResTransparent : m_FullResTransparent).push_back(i);
+		}
+		if (m_LowResTransparent.empty()) return false;
+
+		// Sized from the HDR depth, which keeps its old size if a resize failed
+		const int width = m_HDRDepthTexture->GetWidth();
+		const int height = m_HDRDepthTexture->GetHeight();
+		const auto scale = m_LowResScale == 0 ? VizEngine::LowResolutionScale::Half : VizEngine::LowResolutionScale::Quarter;
+		if (!m_LowResPass)
+		{
+			m_LowResPass = std::make_unique<VizEngine::LowResolutionPass>(width, height, scale);
+		}
+		m_LowResPass->Resize(width, height);
+		m_LowResPass->SetScale(scale);
+		return m_LowResPass->IsValid();
+	}
+
+	// =========================================================================
+	// Helper: Reduced-resolution transparents, composited into the HDR buffer
+	// =========================================================================
+	void RenderLowResTransparents(const VizEngine::RenderView& view)
+	{
+		auto& renderer = VizEngine::Engine::Get().GetRenderer();
+		const auto& objects = m_Views.GetObjects();
+
+		VP_PROFILE_PASS("Low-Res Transparency");
+		m_LowResPass->SetUpsample(static_cast<VizEngine::LowResolutionUpsample>(m_LowResUpsample));
+		m_LowResPass->SetDepthThreshold(m_LowResDepthThreshold);
+
+		if (!m_LowResPass->Begin(*m_HDRDepthTexture, view.Projection))
+		{
+			// Fall back to full resolution (opaques are already drawn)
+			const std::vector<uint32_t> noOpaque;
+			RenderSceneObjects(view, &noOpaque, &m_LowResTransparent);
+			return;
+		}
+
+		for (uint32_t i : m_LowResTransparent)
+		{
+			const auto& data = objects[i];
+			RenderSingleObject(m_Scene[data.SceneIndex], data.Model, data.Normal, renderer);
+		}
+
+		m_LowResPass->End();
+
+		m_HDRFramebuffer->Bind();
+		m_LowResPass->Composite();
+	}
+
+	// =========================================================================
+	// Helper: Count fragments per pixel for the main view's passes
+	// =========================================================================
+	void MeasureOverdraw(const VizEngine::RenderView& view, bool bloomRan)
+	{
+		if (!m_Overdraw)
+		{
+			m_Overdraw = std::make_unique<VizEngine::OverdrawAnalyzer>(m_WindowWidth, m_WindowHeight);
+		}
+		m_Overdraw->Resize(m_WindowWidth, m_WindowHeight);
+		if (!m_Overdraw->IsValid()) return;
+
+		auto& engine = VizEngine::Engine::Get();
+		auto& stats = engine.GetRenderer().GetStats();
+		const auto& resources = engine.GetResources();
+		const auto& objects = m_Views.GetObjects();
+		uint32_t threshold = static_cast<uint32_t>(m_OverdrawThreshold);
+
+		// Opaque: same submission order and depth behaviour as the real pass
+		m_Overdraw->BeginPass(VizEngine::OverdrawPass::Opaque, view.ViewProjection, VizEngine::OverdrawDepthMode::TestWrite);
+		for (uint32_t i : view.Opaque)
+		{
+			if (VizEngine::Mesh* mesh = resources.Get(m_Scene[objects[i].SceneIndex].MeshId))
+				m_Overdraw->Submit(*mesh, objects[i].Model);
+		}
+		stats.SetOverdraw(VizEngine::OverdrawPass::Opaque, m_Overdraw->EndPass(threshold));
+
+		// Transparent: tested against opaque depth, no depth writes
+		m_Overdraw->BeginPass(VizEngine::OverdrawPass::Transparent, view.ViewProjection, VizEngine::OverdrawDepthMode::TestOnly);
+		for (uint32_t i : view.Transparent)
+		{
+			if (VizEngine::Mesh* mesh = resources.Get(m_Scene[objects[i].SceneIndex].MeshId))
+				m_Overdraw->Submit(*mesh, objects[i].Model);
+		}
+		stats.SetOverdraw(VizEngine::OverdrawPass::Transparent, m_Overdraw->EndPass(threshold));
+
+		// Post (estimate): one full-screen layer per post draw, weighted by its
+		// resolution, rather than the real bloom and tone mapping draws
+		m_Overdraw->BeginPass(VizEngine::OverdrawPass::Post, view.ViewProjection, VizEngine::OverdrawDepthMode::Disabled);
+		if (bloomRan && m_Bloom)
+		{
+			float bloomWeight = static_cast<float>(m_Bloom->GetWidth() * m_Bloom->GetHeight())
+			                  / static_cast<float>(m_WindowWidth * m_WindowHeight);
+			int bloomDraws = 1 + 2 * m_Bloom->GetBlurPasses();   // Extract + H/V blur per pass
+			for (int i = 0; i < bloomDraws; i++)
+			{
+				m_Overdraw->SubmitFullscreen(bloomWeight);
+			}
+		}
+		if (m_HDREnabled)
+		{
+			m_Overdraw->SubmitFullscreen(1.0f);   // Tone mapping
+		}
+		stats.SetOverdraw(VizEngine::OverdrawPass::Post, m_Overdraw->EndPass(threshold));
+	}
+
+	// =========================================================================
+	// Helper: Per-view camera uniforms
+	// =========================================================================
+	void SetViewUniforms(const VizEngine::RenderView& view)
+	{
+		for (VizEngine::PBRMaterial* material : { m_PBRMaterial.get(), m_VisibilityMaterial.get() })
+		{
+			if (!material) continue;
+
+			material->SetViewMatrix(view.View);
+			material->SetProjectionMatrix(view.Projection);
+			material->SetViewPosition(view.Position);
+		}
+	}
+
+	// =========================================================================
+	// Helper: Setup default lit shader with common uniforms
+	// =========================================================================
+	void SetupDefaultLitShader()
+	{
+		if (!m_PBRMaterial) return;
+
+		SetupLitMaterial(*m_PBRMaterial);
+		if (m_VisibilityMaterial && m_UseVisibilityBuffer)
+		{
+			SetupLitMaterial(*m_VisibilityMaterial);   // Resolve lights exactly like the forward path
+		}
+	}
+
+	void SetupLitMaterial(VizEngine::PBRMaterial& material)
+	{
+		// Configure lights via shader (material doesn't have light setters yet)
+		const auto& shader = material.GetShader();
+		shader->Bind();
+
+		shader->SetInt("u_LightCount", m_ActiveLightCount);
+		for (int i = 0; i < m_ActiveLightCount; ++i)
+		{
+			shader->SetVec3("u_LightPositions[" + std::to_string(i) + "]", m_PBRLightPositions[i]);
+			shader->SetVec3("u_LightColors[" + std::to_string(i) + "]", m_PBRLightColors[i]);
+		}
+
+		// Directional light
+		shader->SetBool("u_UseDirLight", true);
+		shader->SetVec3("u_DirLightDirection", m_Light.GetDirection());
+		shader->SetVec3("u_DirLightColor", m_Light.Diffuse);
+
+		// Shadow mapping (only enable if shadow map resource is valid)
+		const bool virtualShadows = m_UseVirtualShadows && m_VirtualShadows && m_VirtualShadows->IsValid();
+		material.SetUseVirtualShadows(virtualShadows);
+		if (virtualShadows)
+		{
+			material.SetShadowMap(m_VirtualShadows->GetAtlas());
+			material.SetShadowFilter(m_ShadowFilter);
+			material.SetUseShadows(true);
+			m_VirtualShadows->BindPageTable();
+		}
+		else if (m_ShadowMapDepth)
+		{
+			material.SetLightSpaceMatrix(m_LightSpaceMatrix);
+			material.SetShadowMap(m_ShadowMapDepth);
+			material.SetShadowFilter(m_ShadowFilter);
+			material.SetUseShadows(true);
+		}
+		else
+		{
+			material.SetShadowMap(nullptr);
+			material.SetUseShadows(false);
+		}
+
+		// IBL (only enable if all IBL resources are valid)
+		const bool iblResourcesValid = m_UseIBL && m_IrradianceMap && m_PrefilteredMap && m_BRDFLut;
+		material.SetUseIBL(iblResourcesValid);
+		if (iblResourcesValid)
+		{
+			material.SetIrradianceMap(m_IrradianceMap);
+			material.SetPrefilteredMap(m_PrefilteredMap);
+			material.SetBRDFLUT(m_BRDFLut);
 			shader->SetFloat("u_MaxReflectionLOD", 4.0f);
 			shader->SetFloat("u_IBLIntensity", m_IBLIntensity);
 		}
@@ -1413,8 +2943,8 @@ private:
 		}
 
 		// Lower hemisphere fallback (prevents black reflections on flat surfaces)
-		m_PBRMaterial->SetLowerHemisphereColor(m_LowerHemisphereColor);
-		m_PBRMaterial->SetLowerHemisphereIntensity(m_LowerHemisphereIntensity);
+		material.SetLowerHemisphereColor(m_LowerHemisphereColor);
+		material.SetLowerHemisphereIntensity(m_LowerHemisphereIntensity);
 	}
 
 	// =========================================================================
@@ -1437,7 +2967,9 @@ private:
 		renderer.SetDepthFunc(GL_LEQUAL);  // Allow re-rendering at same depth
 
 		// Re-render selected object (writes 1s to stencil where visible)
-		RenderSingleObject(obj, renderer);
+		glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
+		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+		RenderSingleObject(obj, model, normalMatrix, renderer);
 
 		renderer.SetDepthFunc(GL_LESS);  // Restore
 
@@ -1514,10 +3046,83 @@ private:
 		m_InstancedCubeMesh->GetVertexArray().LinkInstanceBuffer(*m_InstanceVBO, instanceLayout, 6);
 
 		VP_INFO("Instancing demo ready: {} instances ({}x{} grid)", m_InstanceCount, gridSize, gridSize);
+
+		SetupPackedMaterials();
+	}
+
+	// Packs a handful of materials into texture array pools so the instancing
+	// grid can use a different material per cube without extra draws
+	void SetupPackedMaterials()
+	{
+		m_PackedInstancedShader = std::make_shared<VizEngine::Shader>("resources/shaders/packed_instanced.shader");
+
+		VizEngine::TexturePackerSettings settings;
+		settings.UniformLayerSize = 1024;  // Rescale large textures so they share one pool
+		m_MaterialPacker = std::make_unique<VizEngine::MaterialTexturePacker>(settings);
+
+		std::vector<VizEngine::Material> materials;
+		const glm::vec4 tints[] = {
+			glm::vec4(1.0f), glm::vec4(1.0f, 0.6f, 0.3f, 1.0f), glm::vec4(0.4f, 0.9f, 0.8f, 1.0f)
+		};
+		for (const auto& tint : tints)
+		{
+			VizEngine::Material checker(tint, 0.0f, 0.6f);
+			checker.BaseColorTexture = m_DefaultTexture;
+			materials.push_back(checker);
+
+			if (m_DuckTexture)
+			{
+				VizEngine::Material duck(tint, 0.0f, 0.5f);
+				duck.BaseColorTexture = m_DuckTexture;
+				materials.push_back(duck);
+			}
+		}
+		materials.emplace_back(glm::vec4(1.0f, 0.76f, 0.33f, 1.0f), 1.0f, 0.3f);   // Gold
+		materials.emplace_back(glm::vec4(0.95f, 0.64f, 0.54f, 1.0f), 1.0f, 0.4f);  // Copper
+		materials.emplace_back(glm::vec4(0.2f, 0.3f, 0.8f, 1.0f), 0.0f, 0.8f);     // Blue plastic
+
+		for (const auto& material : materials)
+		{
+			m_MaterialPacker->AddMaterial(material);
+		}
+		if (!m_MaterialPacker->Build())
+		{
+			VP_WARN("Material packing incomplete; some textures fall back to base color");
+		}
+
+		// Keep the materials that can share the first material's pools
+		std::vector<uint32_t> batch;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(materials.size()); ++i)
+		{
+			if (m_MaterialPacker->IsBatchCompatible(0, i))
+			{
+				batch.push_back(i);
+			}
+		}
+		m_PackedBatchMaterial = 0;
+		m_PackedMaterialCount = static_cast<int>(batch.size());
+
+		std::vector<uint32_t> instanceMaterials(m_InstanceCount);
+		for (int i = 0; i < m_InstanceCount; ++i)
+		{
+			instanceMaterials[i] = batch[static_cast<size_t>(i) % batch.size()];
+		}
+		m_InstanceMaterialBuffer = std::make_unique<VizEngine::ShaderStorageBuffer>(
+			instanceMaterials.data(), instanceMaterials.size() * sizeof(uint32_t), GL_STATIC_DRAW);
+
+		VP_INFO("Packed materials: {} of {} share one batch ({} pools)",
+			batch.size(), materials.size(), m_MaterialPacker->GetPoolCount());
 	}
 
 	// Scene
 	VizEngine::Scene m_Scene;
+	VizEngine::SceneRenderList m_RenderList{ m_Scene };  // Declared after m_Scene: detaches first
+
+	// Multi-view rendering (main camera + F2 preview share per-object data)
+	VizEngine::RenderViewSet m_Views;
+	uint32_t m_MainView = 0;
+	uint32_t m_PreviewView = 0;
+	VizEngine::Camera m_PreviewCamera;
 	VizEngine::Camera m_Camera;
 	VizEngine::DirectionalLight m_Light;
 
@@ -1529,10 +3134,8 @@ private:
 	std::shared_ptr<VizEngine::Mesh> m_PlaneMesh;
 
 	// Duck model assets (for spawning)
-	std::shared_ptr<VizEngine::Mesh> m_DuckMesh;
+	std::shared_ptr<const VizEngine::Prefab> m_DuckPrefab;
 	std::shared_ptr<VizEngine::Texture> m_DuckTexture;
-	glm::vec4 m_DuckColor = glm::vec4(1.0f);
-	float m_DuckRoughness = 0.5f;
 
 	// Framebuffer for offscreen rendering
 	std::shared_ptr<VizEngine::Framebuffer> m_Framebuffer;
@@ -1545,13 +3148,19 @@ private:
 	std::shared_ptr<VizEngine::Texture> m_ShadowMapDepth;
 	glm::mat4 m_LightSpaceMatrix;
 	bool m_ShowShadowMap = false;
+	VizEngine::ShadowFilterSettings m_ShadowFilter;
 
 	// Runtime state
 	float m_ClearColor[4] = { 0.1f, 0.1f, 0.15f, 1.0f };
 	float m_RotationSpeed = 0.5f;
 	int m_SelectedObject = 0;
+	std::vector<VizEngine::RayBenchmarkResult> m_RayBenchmark;
 	uint32_t m_NextObjectID = 1;  // Monotonic counter for unique object names
 
+	// Scene files (Save/Load buttons)
+	VizEngine::SceneAssetTable m_SceneAssets;
+	std::string m_SceneFilePath = "scene.vpscene";
+
 	// Camera controller settings
 	float m_MoveSpeed = 5.0f;
 	float m_SprintMultiplier = 2.5f;
@@ -1578,6 +3187,13 @@ private:
 	bool m_UseIBL = true;
 	float m_IBLIntensity = 0.3f;  // Lower default to balance direct vs ambient lighting
 
+	// Cubemap storage formats (environment, irradiance, prefiltered). The
+	// RGB16F originals stay alive as conversion sources so the formats can be
+	// switched and compared at runtime.
+	std::shared_ptr<VizEngine::Texture> m_CubemapSources[3];
+	int m_CubemapStorage[3] = { 0, 0, 0 };
+	VizEngine::CubemapStorageReport m_CubemapReports[3];
+
 	// Lower hemisphere fallback (prevents black reflections on flat surfaces)
 	glm::vec3 m_LowerHemisphereColor = glm::vec3(0.15f, 0.15f, 0.2f);  // Slightly blue-ish ground
 	float m_LowerHemisphereIntensity = 0.5f;
@@ -1616,6 +3232,72 @@ private:
 	bool m_HDREnabled = true;       // Tracks HDR pipeline availability
 	bool m_HdrFallbackWarned = false;  // One-time warning flag for HDR fallback
 
+	// Hi-Z pyramid (Post-Processing panel)
+	bool m_BuildHiZ = false;
+	std::unique_ptr<VizEngine::Downsampler> m_Downsampler;
+	std::shared_ptr<VizEngine::Texture> m_HiZPyramid;
+
+	// Prefab batches drawn instanced (forward opaque, shadow map, visibility buffer)
+	struct InstancedRun
+	{
+		uint32_t First = 0;    // Offset into m_RunObjects and the instance transforms
+		uint32_t Count = 0;
+	};
+	std::vector<int32_t> m_PrefabBatchOf;        // Scene index -> prefab batch, -1 if none
+	std::vector<uint32_t> m_BatchCount;          // Per batch: instances in the current list
+	std::vector<uint32_t> m_BatchRun;            // Per batch: run in the current list
+	std::vector<InstancedRun> m_InstancedRuns;
+	std::vector<uint32_t> m_RunObjects;          // Frame objects of every run, run after run
+	std::vector<uint32_t> m_SingleObjects;       // The rest of the current list
+	std::vector<uint32_t> m_ShadowCasters;
+	std::vector<VizEngine::InstanceTransformGPU> m_InstanceTransforms;
+	std::unique_ptr<VizEngine::ShaderStorageBuffer> m_InstanceTransformBuffer;
+
+	// Visibility buffer (opaque main-view geometry, shaded in one resolve)
+	std::shared_ptr<VizEngine::Shader> m_VisibilityResolveShader;
+	std::shared_ptr<VizEngine::PBRMaterial> m_VisibilityMaterial;
+	std::unique_ptr<VizEngine::VisibilityBuffer> m_VisibilityBuffer;
+	std::vector<uint32_t> m_VisibilityForward;   // Opaque objects the buffer rejected
+	bool m_UseVisibilityBuffer = false;
+
+	// Virtual shadow map (replaces the fixed shadow map while enabled)
+	std::unique_ptr<VizEngine::VirtualShadowMap> m_VirtualShadows;
+	bool m_UseVirtualShadows = false;
+	float m_VirtualShadowLodBias = 0.0f;
+
+	// Streamed point cloud (--point-cloud <file.vpc>)
+	std::string m_PointCloudPath;
+	std::unique_ptr<VizEngine::PointCloud> m_PointCloud;
+	bool m_ShowPointCloud = true;
+	bool m_PointCloudZUp = true;
+	float m_PointCloudExtent = 20.0f;              // World units across the octree cube
+
+	// Ray-marched volume (built-in phantom, or --volume <file.raw> <WxHxD> [u8|u16|f32])
+	std::unique_ptr<VizEngine::VolumeRenderer> m_VolumeRenderer;
+	std::string m_VolumePath;
+	glm::ivec3 m_VolumeFileSize = glm::ivec3(0);
+	VizEngine::VolumeFormat m_VolumeFileFormat = VizEngine::VolumeFormat::UInt8;
+	bool m_ShowVolume = false;
+	bool m_VolumeFailed = false;
+	int m_VolumePreset = 1;                        // Soft tissue
+	float m_VolumeExtent = 6.0f;                   // World units along the longest side
+
+	// Reduced-resolution transparency (per-object opt-in: SceneObject::LowResolution)
+	std::unique_ptr<VizEngine::LowResolutionPass> m_LowResPass;
+	std::vector<uint32_t> m_FullResTransparent;   // Back-to-front, drawn with the scene
+	std::vector<uint32_t> m_LowResTransparent;    // Back-to-front, drawn after the skybox
+	bool m_UseLowResTransparency = false;
+	int m_LowResScale = 0;                         // 0 = half, 1 = quarter
+	int m_LowResUpsample = 2;                      // LowResolutionUpsample
+	float m_LowResDepthThreshold = 0.1f;
+
+	// Overdraw debug views (0 = off, otherwise OverdrawPass + 1)
+	std::unique_ptr<VizEngine::OverdrawAnalyzer> m_Overdraw;
+	int m_DebugView = 0;
+	bool m_MeasureOverdraw = false;
+	int m_OverdrawThreshold = 4;
+	float m_OverdrawMaxCount = 8.0f;
+
 	// Post-Processing (Chapter 40)
 	std::unique_ptr<VizEngine::Bloom> m_Bloom;
 	bool m_EnableBloom = true;
@@ -1648,7 +3330,32 @@ private:
 	std::unique_ptr<VizEngine::VertexBuffer> m_InstanceVBO;
 	int m_InstanceCount = 0;
 	bool m_ShowInstancingDemo = false;
+
+	// Packed materials (texture array pools + material table)
+	std::shared_ptr<VizEngine::Shader> m_PackedInstancedShader;
+	std::unique_ptr<VizEngine::MaterialTexturePacker> m_MaterialPacker;
+	std::unique_ptr<VizEngine::ShaderStorageBuffer> m_InstanceMaterialBuffer;
+	uint32_t m_PackedBatchMaterial = 0;
+	int m_PackedMaterialCount = 0;
+	bool m_UsePackedMaterials = false;
 	glm::vec3 m_InstanceColor = glm::vec3(0.4f, 0.7f, 0.9f);  // Light blue
+
+	// Scalability tiers
+	VizEngine::ScalabilityManager m_Scalability;
+	VizEngine::ScalabilityTier m_IBLTier = VizEngine::ScalabilityTier::Count;   // Tier the IBL maps were built with
+	bool m_ScalabilityCalibrating = false;
+	int m_ActiveLightCount = 4;
+
+	// Regression run (--regression [--update-goldens] [--golden-dir <dir>])
+	bool m_RunRegression = false;
+	bool m_UpdateGoldens = false;
+	std::string m_GoldenDir;                 // Empty = RegressionConfig default
+	std::unique_ptr<VizEngine::RegressionHarness> m_Regression;
+
+	// Render service run (--render-service <jobs.txt> [--render-service-port <port>])
+	bool m_RunRenderService = false;
+	VizEngine::RenderServiceConfig m_RenderServiceConfig;
+	std::unique_ptr<VizEngine::RenderService> m_RenderService;
 };
 
 std::unique_ptr<VizEngine::Application> VizEngine::CreateApplication(VizEngine::EngineConfig& config)
@@ -1656,6 +3363,107 @@ std::unique_ptr<VizEngine::Application> VizEngine::CreateApplication(VizEngine::
 	config.Title = "Sandbox - VizPsyche";
 	config.Width = 800;
 	config.Height = 800;
-	return std::make_unique<Sandbox>();
+
+	// Headless regression run: fixed size, no vsync, hidden window
+	bool regression = std::find(config.Args.begin(), config.Args.end(), "--regression") != config.Args.end();
+	bool updateGoldens = std::find(config.Args.begin(), config.Args.end(), "--update-goldens") != config.Args.end();
+	if (regression || updateGoldens)
+	{
+		config.Headless = true;
+		config.VSync = false;
+	}
+
+	// Headless render service: jobs from a file and/or a local socket
+	VizEngine::RenderServiceConfig serviceConfig;
+	bool renderService = false;
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		if (config.Args[i] == "--render-service")
+		{
+			serviceConfig.JobFile = config.Args[i + 1];
+			renderService = true;
+		}
+		else if (config.Args[i] == "--render-service-port")
+		{
+			serviceConfig.Port = std::atoi(config.Args[i + 1].c_str());
+			renderService = true;
+		}
+	}
+
+	// Frame-spike traces from the first frame (--spike-capture <ms>)
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		if (config.Args[i] == "--spike-capture")
+		{
+			VizEngine::SpikeCaptureConfig spike;
+			spike.Enabled = true;
+			spike.ThresholdMs = std::atof(config.Args[i + 1].c_str());
+			VizEngine::Profiler::SetSpikeCapture(spike);
+		}
+	}
+
+	// Prometheus metrics (--metrics-port <port>, --metrics-socket <path>,
+	// --metrics-file <path>, --metrics-interval <seconds>)
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		const std::string& value = config.Args[i + 1];
+		if (config.Args[i] == "--metrics-port") config.Metrics.Port = std::atoi(value.c_str());
+		else if (config.Args[i] == "--metrics-socket") config.Metrics.SocketPath = value;
+		else if (config.Args[i] == "--metrics-file") config.Metrics.FilePath = value;
+		else if (config.Args[i] == "--metrics-interval") config.Metrics.SampleIntervalSeconds = std::atof(value.c_str());
+	}
+
+	// GL command trace for GLReplay (--gl-capture <file> [--gl-capture-start <frame>]
+	// [--gl-capture-frames <n>])
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		const std::string& value = config.Args[i + 1];
+		if (config.Args[i] == "--gl-capture") config.GLCapture.Path = value;
+		else if (config.Args[i] == "--gl-capture-start") config.GLCapture.StartFrame = static_cast<uint32_t>(std::atoi(value.c_str()));
+		else if (config.Args[i] == "--gl-capture-frames") config.GLCapture.FrameCount = static_cast<uint32_t>(std::atoi(value.c_str()));
+	}
+
+	auto sandbox = std::make_unique<Sandbox>(regression || updateGoldens, updateGoldens);
+	if (renderService)
+	{
+		config.Headless = true;
+		config.VSync = false;
+		sandbox->EnableRenderService(serviceConfig);
+	}
+
+	// Golden images outside the working directory (--golden-dir <dir>), e.g. the
+	// source tree's regression/golden when run from CTest
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		if (config.Args[i] == "--golden-dir") sandbox->SetGoldenDir(config.Args[i + 1]);
+	}
+
+	// Out-of-core point cloud (--point-cloud <file.vpc>, see PointCloudConverter)
+	for (size_t i = 0; i + 1 < config.Args.size(); i++)
+	{
+		if (config.Args[i] == "--point-cloud") sandbox->SetPointCloud(config.Args[i + 1]);
+	}
+
+	// Scalar volume to ray-march (--volume <file.raw> <WxHxD> [u8|u16|f32])
+	for (size_t i = 0; i + 2 < config.Args.size(); i++)
+	{
+		if (config.Args[i] != "--volume") continue;
+
+		glm::ivec3 size(0);
+		if (std::sscanf(config.Args[i + 2].c_str(), "%dx%dx%d", &size.x, &size.y, &size.z) != 3)
+		{
+			VP_ERROR("--volume expects <file.raw> <WxHxD> [u8|u16|f32]");
+			continue;
+		}
+
+		VizEngine::VolumeFormat format = VizEngine::VolumeFormat::UInt8;
+		if (i + 3 < config.Args.size())
+		{
+			if (config.Args[i + 3] == "u16") format = VizEngine::VolumeFormat::UInt16;
+			else if (config.Args[i + 3] == "f32") format = VizEngine::VolumeFormat::Float32;
+		}
+		sandbox->SetVolumeFile(config.Args[i + 1], size, format);
+	}
+	return sandbox;
 }
 
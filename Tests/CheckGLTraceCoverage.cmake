@@ -0,0 +1,98 @@
+# =============================================================================
+# GL trace coverage check (run with cmake -P)
+# =============================================================================
+# Fails if engine or Sandbox code calls a glad entry point that is missing
+# from the GLTrace.h command tables. Untraced calls still reach the driver
+# during capture but are absent from the trace, so replays drift silently.
+#
+# Inputs:
+#   GLTRACE_HEADER  VizEngine/src/VizEngine/OpenGL/GLTrace.h
+#   GLAD_HEADER     VizEngine/include/glad/glad.h
+#   SOURCE_DIRS     ;-separated directories to scan (*.cpp, *.h)
+
+foreach(var GLTRACE_HEADER GLAD_HEADER SOURCE_DIRS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "CheckGLTraceCoverage: ${var} is not set")
+    endif()
+endforeach()
+
+# Called outside a capture or with no effect on the rendered frames
+set(UNTRACED_ALLOWED
+    DebugMessageCallback    # Installed by ErrorHandling before any capture starts
+)
+
+# Table entries whose name differs from the GL function
+set(ENTRY_ALIASES
+    "Barrier=MemoryBarrier"
+)
+
+# The capture hooks and the replayer call the driver directly by design
+set(EXCLUDED_FILES
+    GLCapture.cpp
+    GLReplay.cpp
+)
+
+# -----------------------------------------------------------------------------
+# Traced entry points
+# -----------------------------------------------------------------------------
+file(READ "${GLTRACE_HEADER}" trace_header)
+string(REGEX MATCHALL "X\\([A-Za-z0-9]+" traced "${trace_header}")
+list(TRANSFORM traced REPLACE "^X\\(" "")
+foreach(alias ${ENTRY_ALIASES})
+    string(REPLACE "=" ";" pair "${alias}")
+    list(GET pair 0 entry)
+    list(GET pair 1 function)
+    list(FIND traced ${entry} index)
+    if(NOT index EQUAL -1)
+        list(APPEND traced ${function})
+    endif()
+endforeach()
+list(APPEND traced ${UNTRACED_ALLOWED})
+
+# -----------------------------------------------------------------------------
+# Entry points called by the sources
+# -----------------------------------------------------------------------------
+file(READ "${GLAD_HEADER}" glad_header)
+
+set(sources "")
+foreach(dir ${SOURCE_DIRS})
+    file(GLOB_RECURSE dir_sources "${dir}/*.cpp" "${dir}/*.h")
+    list(APPEND sources ${dir_sources})
+endforeach()
+
+set(missing "")
+foreach(source ${sources})
+    get_filename_component(source_name "${source}" NAME)
+    list(FIND EXCLUDED_FILES ${source_name} excluded)
+    if(NOT excluded EQUAL -1)
+        continue()
+    endif()
+
+    file(READ "${source}" content)
+    string(REGEX MATCHALL "gl[A-Z][A-Za-z0-9]*\\(" calls "${content}")
+    list(REMOVE_DUPLICATES calls)
+    foreach(call ${calls})
+        string(REGEX REPLACE "^gl([A-Za-z0-9]+)\\($" "\\1" name "${call}")
+        # Only glad entry points; skips helpers like glTF loaders
+        string(FIND "${glad_header}" "glad_gl${name};" declared)
+        if(declared EQUAL -1)
+            continue()
+        endif()
+        list(FIND traced ${name} index)
+        if(index EQUAL -1)
+            file(RELATIVE_PATH relative "${CMAKE_CURRENT_LIST_DIR}/.." "${source}")
+            list(APPEND missing "gl${name} (${relative})")
+        endif()
+    endforeach()
+endforeach()
+
+if(missing)
+    list(REMOVE_DUPLICATES missing)
+    list(JOIN missing "\n  " missing_text)
+    message(FATAL_ERROR "GL entry points missing from the GLTrace.h command tables:\n  ${missing_text}\n"
+        "Add them to VP_GL_TRACE_VALUE_COMMANDS (plain values) or VP_GL_TRACE_CUSTOM_COMMANDS "
+        "(hand-written hooks) and bump GLTraceHeader::CurrentVersion.")
+endif()
+
+list(LENGTH sources source_count)
+message(STATUS "GL trace coverage: ${source_count} files checked")
@@ -0,0 +1,391 @@
+// Tests/src/BatchMathTests.cpp
+
+// BatchMath kernels against the scalar reference. Every SIMD instruction set
+// the CPU supports is forced with SetActiveISA() and run on random streams
+// whose sizes are not multiples of the vector width, so vector bodies and
+// scalar tails are both covered. The scalar kernels themselves are checked
+// against Transform (glm) and by quaternion/Euler round trips.
+//
+// Exit code 0 when every check passes; registered with CTest.
+
+#include <VizEngine/Log.h>
+#include <VizEngine/Core/BatchMath.h>
+#include <VizEngine/Core/Transform.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace VizEngine;
+
+namespace
+{
+	constexpr float Pi = 3.14159265358979f;
+
+	// Sizes around every lane count (4, 8, 16) and longer streams with tails
+	const size_t StreamSizes[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1001 };
+
+	int g_Failures = 0;
+	int g_Checks = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		g_Checks++;
+		if (!condition)
+		{
+			// Keep the log readable when a kernel is wrong for a whole stream
+			if (g_Failures < 50) VP_ERROR("FAILED: {}", what);
+			g_Failures++;
+		}
+	}
+
+	bool Near(float a, float b, float tolerance)
+	{
+		return std::abs(a - b) <= tolerance * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+	}
+
+	// =========================================================================
+	// Random streams
+	// =========================================================================
+
+	struct Random
+	{
+		std::mt19937 Engine{ 1234567u };
+
+		float Uniform(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(Engine); }
+
+		glm::vec3 Vec3(float lo, float hi) { return glm::vec3(Uniform(lo, hi), Uniform(lo, hi), Uniform(lo, hi)); }
+
+		glm::mat4 Mat4()
+		{
+			glm::mat4 m;
+			for (int c = 0; c < 4; c++)
+				for (int r = 0; r < 4; r++)
+					m[c][r] = Uniform(-4.0f, 4.0f);
+			return m;
+		}
+
+		Vec3Stream Stream3(size_t count, float lo, float hi)
+		{
+			Vec3Stream s;
+			s.Resize(count);
+			for (size_t i = 0; i < count; i++) s.Set(i, Vec3(lo, hi));
+			return s;
+		}
+
+		Mat4Stream StreamM(size_t count)
+		{
+			Mat4Stream s;
+			s.Resize(count);
+			for (size_t i = 0; i < count; i++) s.Set(i, Mat4());
+			return s;
+		}
+
+		Vec4Stream Quaternions(size_t count)
+		{
+			Vec4Stream s;
+			s.Resize(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				glm::vec4 q(Uniform(-1.0f, 1.0f), Uniform(-1.0f, 1.0f), Uniform(-1.0f, 1.0f), Uniform(-1.0f, 1.0f));
+				float len = glm::length(q);
+				s.Set(i, len > 1e-3f ? q / len : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+			}
+			return s;
+		}
+	};
+
+	// =========================================================================
+	// Stream comparisons
+	// =========================================================================
+
+	void CompareStreams(const std::vector<float>& reference, const std::vector<float>& actual, float tolerance,
+		const std::string& what)
+	{
+		Check(reference.size() == actual.size(), what + ": size");
+		for (size_t i = 0; i < std::min(reference.size(), actual.size()); i++)
+		{
+			Check(Near(reference[i], actual[i], tolerance),
+				what + "[" + std::to_string(i) + "] " + std::to_string(reference[i]) + " vs " + std::to_string(actual[i]));
+		}
+	}
+
+	void Compare(const Vec3Stream& reference, const Vec3Stream& actual, float tolerance, const std::string& what)
+	{
+		CompareStreams(reference.X, actual.X, tolerance, what + ".x");
+		CompareStreams(reference.Y, actual.Y, tolerance, what + ".y");
+		CompareStreams(reference.Z, actual.Z, tolerance, what + ".z");
+	}
+
+	void Compare(const Vec4Stream& reference, const Vec4Stream& actual, float tolerance, const std::string& what)
+	{
+		CompareStreams(reference.X, actual.X, tolerance, what + ".x");
+		CompareStreams(reference.Y, actual.Y, tolerance, what + ".y");
+		CompareStreams(reference.Z, actual.Z, tolerance, what + ".z");
+		CompareStreams(reference.W, actual.W, tolerance, what + ".w");
+	}
+
+	void Compare(const Mat4Stream& reference, const Mat4Stream& actual, float tolerance, const std::string& what)
+	{
+		for (int e = 0; e < 16; e++)
+		{
+			CompareStreams(reference.M[e], actual.M[e], tolerance, what + ".m" + std::to_string(e));
+		}
+	}
+
+	// =========================================================================
+	// Frustum helpers
+	// =========================================================================
+
+	// Axis-aligned frustum box [-10, 10]^3: a uniform scale as "view-projection"
+	FrustumPlanes BoxFrustum()
+	{
+		glm::mat4 viewProjection(1.0f);
+		viewProjection[0][0] = viewProjection[1][1] = viewProjection[2][2] = 0.1f;
+		return BatchMath::ExtractFrustumPlanes(viewProjection);
+	}
+
+	// Smallest signed plane distance minus the bound's reach; near 0 the SIMD
+	// and scalar results may legitimately round to different sides
+	float CullMargin(const FrustumPlanes& frustum, const glm::vec3& center, const glm::vec3& extent, float radius)
+	{
+		float margin = 1e30f;
+		for (const glm::vec4& plane : frustum.Planes)
+		{
+			float reach = radius + std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+			float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			margin = std::min(margin, std::abs(distance + reach));
+		}
+		return margin;
+	}
+
+	// =========================================================================
+	// SIMD kernels against the scalar reference
+	// =========================================================================
+
+	void CompareWithScalar(SimdISA isa)
+	{
+		const std::string name = BatchMath::GetISAName(isa);
+		Random random;
+		const FrustumPlanes frustum = BoxFrustum();
+
+		for (size_t count : StreamSizes)
+		{
+			const std::string suffix = " (" + name + ", n=" + std::to_string(count) + ")";
+
+			Vec3Stream points = random.Stream3(count, -50.0f, 50.0f);
+			Vec3Stream position = random.Stream3(count, -50.0f, 50.0f);
+			Vec3Stream rotation = random.Stream3(count, -2.0f * Pi, 2.0f * Pi);
+			Vec3Stream scale = random.Stream3(count, 0.1f, 4.0f);
+			Vec3Stream euler = random.Stream3(count, -Pi, Pi);
+			Vec4Stream quaternions = random.Quaternions(count);
+			Mat4Stream a = random.StreamM(count);
+			Mat4Stream b = random.StreamM(count);
+			glm::mat4 matrix = random.Mat4();
+			Vec3Stream centers = random.Stream3(count, -14.0f, 14.0f);
+			Vec3Stream extents = random.Stream3(count, 0.0f, 3.0f);
+			std::vector<float> radii(count);
+			for (float& r : radii) r = random.Uniform(0.0f, 3.0f);
+
+			// Reference
+			BatchMath::SetActiveISA(SimdISA::Scalar);
+			Vec3Stream refPoints, refEuler;
+			Vec4Stream refQuaternions;
+			Mat4Stream refProduct, refParent, refCompose;
+			std::vector<uint8_t> refSpheres, refBoxes;
+			BatchMath::TransformPoints(matrix, points, refPoints);
+			BatchMath::MultiplyMatrices(a, b, refProduct);
+			BatchMath::MultiplyMatrices(matrix, a, refParent);
+			BatchMath::ComposeTransforms(position, rotation, scale, refCompose);
+			BatchMath::EulerToQuaternions(euler, refQuaternions);
+			BatchMath::QuaternionsToEuler(quaternions, refEuler);
+			BatchMath::CullSpheres(frustum, centers, radii, refSpheres);
+			BatchMath::CullBoxes(frustum, centers, extents, refBoxes);
+
+			// Under test
+			Check(BatchMath::SetActiveISA(isa), "SetActiveISA" + suffix);
+			Vec3Stream outPoints, outEuler;
+			Vec4Stream outQuaternions;
+			Mat4Stream outProduct, outParent, outCompose;
+			std::vector<uint8_t> outSpheres, outBoxes;
+			BatchMath::TransformPoints(matrix, points, outPoints);
+			BatchMath::MultiplyMatrices(a, b, outProduct);
+			BatchMath::MultiplyMatrices(matrix, a, outParent);
+			BatchMath::ComposeTransforms(position, rotation, scale, outCompose);
+			BatchMath::EulerToQuaternions(euler, outQuaternions);
+			BatchMath::QuaternionsToEuler(quaternions, outEuler);
+			size_t spheres = BatchMath::CullSpheres(frustum, centers, radii, outSpheres);
+			size_t boxes = BatchMath::CullBoxes(frustum, centers, extents, outBoxes);
+
+			// FMA and a different summation order only move the last bits;
+			// sin/cos/atan2 are polynomial approximations
+			Compare(refPoints, outPoints, 1e-5f, "TransformPoints" + suffix);
+			Compare(refProduct, outProduct, 1e-5f, "MultiplyMatrices" + suffix);
+			Compare(refParent, outParent, 1e-5f, "MultiplyMatrices(parent)" + suffix);
+			Compare(refCompose, outCompose, 2e-5f, "ComposeTransforms" + suffix);
+			Compare(refQuaternions, outQuaternions, 2e-5f, "EulerToQuaternions" + suffix);
+			Compare(refEuler, outEuler, 5e-5f, "QuaternionsToEuler" + suffix);
+
+			Check(outSpheres.size() == count && outBoxes.size() == count, "Cull output sizes" + suffix);
+			size_t expectedSpheres = 0, expectedBoxes = 0;
+			for (size_t i = 0; i < std::min(count, std::min(outSpheres.size(), outBoxes.size())); i++)
+			{
+				expectedSpheres += outSpheres[i];
+				expectedBoxes += outBoxes[i];
+
+				const glm::vec3 center = centers.Get(i);
+				if (CullMargin(frustum, center, glm::vec3(0.0f), radii[i]) > 1e-4f)
+				{
+					Check(outSpheres[i] == refSpheres[i], "CullSpheres[" + std::to_string(i) + "]" + suffix);
+				}
+				if (CullMargin(frustum, center, extents.Get(i), 0.0f) > 1e-4f)
+				{
+					Check(outBoxes[i] == refBoxes[i], "CullBoxes[" + std::to_string(i) + "]" + suffix);
+				}
+			}
+			Check(spheres == expectedSpheres, "CullSpheres count" + suffix);
+			Check(boxes == expectedBoxes, "CullBoxes count" + suffix);
+		}
+
+		BatchMath::SetActiveISA(SimdISA::Scalar);
+	}
+
+	// =========================================================================
+	// Scalar reference against glm and round trips (run under every ISA)
+	// =========================================================================
+
+	void CheckReference(SimdISA isa)
+	{
+		const std::string suffix = std::string(" (") + BatchMath::GetISAName(isa) + ")";
+		Check(BatchMath::SetActiveISA(isa), "SetActiveISA" + suffix);
+		Random random;
+		const size_t count = 257;
+
+		// ComposeTransforms matches Transform::GetModelMatrix()
+		Vec3Stream position = random.Stream3(count, -50.0f, 50.0f);
+		Vec3Stream rotation = random.Stream3(count, -2.0f * Pi, 2.0f * Pi);
+		Vec3Stream scale = random.Stream3(count, 0.1f, 4.0f);
+		Mat4Stream models;
+		BatchMath::ComposeTransforms(position, rotation, scale, models);
+		for (size_t i = 0; i < count; i++)
+		{
+			glm::mat4 expected = Transform(position.Get(i), rotation.Get(i), scale.Get(i)).GetModelMatrix();
+			glm::mat4 actual = models.Get(i);
+			for (int c = 0; c < 4; c++)
+				for (int r = 0; r < 4; r++)
+					Check(Near(expected[c][r], actual[c][r], 2e-5f),
+						"ComposeTransforms vs Transform[" + std::to_string(i) + "]" + suffix);
+		}
+
+		// Euler -> quaternion -> Euler returns the angles inside the canonical
+		// range (|y| < pi/2), away from gimbal lock
+		Vec3Stream euler;
+		euler.Resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			euler.Set(i, glm::vec3(random.Uniform(-Pi * 0.99f, Pi * 0.99f), random.Uniform(-Pi * 0.45f, Pi * 0.45f),
+				random.Uniform(-Pi * 0.99f, Pi * 0.99f)));
+		}
+		Vec4Stream quaternions;
+		Vec3Stream roundTrip;
+		BatchMath::EulerToQuaternions(euler, quaternions);
+		BatchMath::QuaternionsToEuler(quaternions, roundTrip);
+		for (size_t i = 0; i < count; i++)
+		{
+			Check(Near(glm::length(quaternions.Get(i)), 1.0f, 1e-5f), "EulerToQuaternions unit length" + suffix);
+		}
+		Compare(euler, roundTrip, 1e-4f, "Euler round trip" + suffix);
+
+		// The quaternion is the same rotation as Rx * Ry * Rz
+		for (size_t i = 0; i < count; i++)
+		{
+			glm::mat4 expected = Transform(glm::vec3(0.0f), euler.Get(i), glm::vec3(1.0f)).GetModelMatrix();
+			glm::mat4 actual = glm::mat4_cast(quaternions.GetQuat(i));
+			for (int c = 0; c < 3; c++)
+				for (int r = 0; r < 3; r++)
+					Check(Near(expected[c][r], actual[c][r], 2e-5f), "EulerToQuaternions rotation" + suffix);
+		}
+
+		// Quaternion -> Euler -> quaternion is the same rotation (q or -q),
+		// gimbal lock included
+		Vec4Stream random4 = random.Quaternions(count);
+		for (size_t i = 0; i < 4; i++)
+		{
+			// Pure y rotations of +-90 degrees, with x/z mixed in
+			float s = std::sqrt(0.5f);
+			glm::quat lock = glm::quat(s, 0.0f, (i & 1) ? s : -s, 0.0f) * glm::quat(std::cos(0.3f * i), std::sin(0.3f * i), 0.0f, 0.0f);
+			random4.SetQuat(i, glm::normalize(lock));
+		}
+		Vec3Stream anglesBack;
+		Vec4Stream quaternionsBack;
+		BatchMath::QuaternionsToEuler(random4, anglesBack);
+		BatchMath::EulerToQuaternions(anglesBack, quaternionsBack);
+		for (size_t i = 0; i < count; i++)
+		{
+			float d = std::abs(glm::dot(random4.Get(i), quaternionsBack.Get(i)));
+			Check(Near(d, 1.0f, 1e-4f), "Quaternion round trip[" + std::to_string(i) + "]" + suffix);
+			Check(std::abs(anglesBack.Y[i]) <= Pi * 0.5f + 1e-4f, "QuaternionsToEuler y range" + suffix);
+		}
+
+		// Frustum: fully inside, fully outside, straddling a plane
+		const FrustumPlanes frustum = BoxFrustum();
+		Vec3Stream centers;
+		std::vector<float> radii;
+		centers.Push(glm::vec3(0.0f));            radii.push_back(1.0f);    // Inside
+		centers.Push(glm::vec3(12.0f, 0, 0));     radii.push_back(1.0f);    // Outside +x
+		centers.Push(glm::vec3(0, -11.5f, 0));    radii.push_back(2.0f);    // Straddles -y
+		centers.Push(glm::vec3(0, 0, 25.0f));     radii.push_back(16.0f);   // Straddles +z
+		centers.Push(glm::vec3(-30.0f, 30, 0));   radii.push_back(5.0f);    // Outside
+		std::vector<uint8_t> visible;
+		size_t visibleCount = BatchMath::CullSpheres(frustum, centers, radii, visible);
+		const uint8_t expectedVisible[] = { 1, 0, 1, 1, 0 };
+		for (size_t i = 0; i < 5; i++)
+		{
+			Check(visible[i] == expectedVisible[i], "CullSpheres known case " + std::to_string(i) + suffix);
+		}
+		Check(visibleCount == 3, "CullSpheres known count" + suffix);
+
+		Vec3Stream extents;
+		extents.Push(glm::vec3(1.0f));
+		extents.Push(glm::vec3(1.0f));
+		extents.Push(glm::vec3(0.1f, 2.0f, 0.1f));
+		extents.Push(glm::vec3(1.0f, 1.0f, 15.5f));
+		extents.Push(glm::vec3(5.0f));
+		visibleCount = BatchMath::CullBoxes(frustum, centers, extents, visible);
+		for (size_t i = 0; i < 5; i++)
+		{
+			Check(visible[i] == expectedVisible[i], "CullBoxes known case " + std::to_string(i) + suffix);
+		}
+		Check(visibleCount == 3, "CullBoxes known count" + suffix);
+	}
+}
+
+int main()
+{
+	VizEngine::Log::Init();
+
+	const SimdISA detected = BatchMath::GetDetectedISA();
+	VP_INFO("Detected {}", BatchMath::GetISAName(detected));
+
+	CheckReference(SimdISA::Scalar);
+
+	const SimdISA simd[] = { SimdISA::SSE42, SimdISA::AVX2, SimdISA::AVX512 };
+	for (SimdISA isa : simd)
+	{
+		if (static_cast<int>(isa) > static_cast<int>(detected))
+		{
+			VP_INFO("{}: not supported on this CPU, skipped", BatchMath::GetISAName(isa));
+			continue;
+		}
+
+		const int failuresBefore = g_Failures;
+		CompareWithScalar(isa);
+		CheckReference(isa);
+		VP_INFO("{}: {}", BatchMath::GetISAName(isa), g_Failures == failuresBefore ? "passed" : "FAILED");
+	}
+
+	VP_INFO("{} checks, {} failures", g_Checks, g_Failures);
+	return g_Failures == 0 ? 0 : 1;
+}
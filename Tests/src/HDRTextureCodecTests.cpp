@@ -0,0 +1,467 @@
+// Tests/src/HDRTextureCodecTests.cpp
+
+// HDRTextureCodec encoders against reference decoders written from the
+// format specifications: RGB9_E5 (GL 4.6, section 8.5.2) and BC6H unsigned
+// float (GL_ARB_texture_compression_bptc; D3D modes 11 and 12, the only ones
+// the encoder emits). Encoded data is decoded again and compared with the
+// input after the documented clamping: NaN and negatives become 0, values
+// above the format's range clamp to its maximum.
+//
+// BC6H images use sizes that are not multiples of 4, so the edge blocks'
+// repeated texels are exercised too.
+//
+// Exit code 0 when every check passes; registered with CTest.
+
+#include <VizEngine/Log.h>
+#include <VizEngine/OpenGL/HDRTextureCodec.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace VizEngine;
+
+namespace
+{
+	constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+	constexpr float Inf = std::numeric_limits<float>::infinity();
+	constexpr float HalfMax = 65504.0f;
+	constexpr float RGB9E5Max = 65408.0f;
+
+	// Widths and heights around the 4x4 block size
+	const int ImageSizes[][2] = { { 1, 1 }, { 3, 5 }, { 4, 4 }, { 7, 2 }, { 13, 9 }, { 64, 33 } };
+
+	int g_Failures = 0;
+	int g_Checks = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		g_Checks++;
+		if (!condition)
+		{
+			if (g_Failures < 50) VP_ERROR("FAILED: {}", what);
+			g_Failures++;
+		}
+	}
+
+	/** What the encoders are documented to store for an input value. */
+	float Clamped(float value, float maxValue)
+	{
+		if (!(value > 0.0f)) return 0.0f;
+		return std::min(value, maxValue);
+	}
+
+	// =========================================================================
+	// Reference decoders
+	// =========================================================================
+
+	/** GL_UNSIGNED_INT_5_9_9_9_REV: 9-bit mantissas, 5-bit shared exponent, bias 15. */
+	void DecodeRGB9E5(uint32_t packed, float (&rgb)[3])
+	{
+		const int exponent = static_cast<int>(packed >> 27) - 15 - 9;
+		for (int c = 0; c < 3; c++)
+		{
+			rgb[c] = std::ldexp(static_cast<float>((packed >> (9 * c)) & 0x1FFu), exponent);
+		}
+	}
+
+	float HalfToFloat(int half)
+	{
+		const int exponent = (half >> 10) & 0x1F;
+		const int mantissa = half & 0x3FF;
+		if (exponent == 0) return std::ldexp(static_cast<float>(mantissa), -24);
+		return std::ldexp(1.0f + mantissa / 1024.0f, exponent - 15);
+	}
+
+	struct BitReader
+	{
+		const uint8_t* Block;
+		int Position = 0;
+
+		int Read(int count)
+		{
+			int value = 0;
+			for (int i = 0; i < count; i++, Position++)
+			{
+				value |= ((Block[Position >> 3] >> (Position & 7)) & 1) << i;
+			}
+			return value;
+		}
+	};
+
+	int UnquantizeUnsigned(int value, int bits)
+	{
+		if (value == 0) return 0;
+		if (value == (1 << bits) - 1) return 0xFFFF;
+		return ((value << 16) + 0x8000) >> bits;
+	}
+
+	/**
+	 * Decode one BC6H unsigned block to 16 RGB texels (row-major).
+	 * @return false for a mode other than 11 (10-bit endpoints) and 12
+	 *         (11-bit endpoint + 9-bit deltas)
+	 */
+	bool DecodeBC6HBlock(const uint8_t* block, float (&texels)[16][3], int& modeNumber)
+	{
+		static const int Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		BitReader reader{ block };
+		const int mode = reader.Read(5);
+		int e0[3], e1[3], bits;
+		if (mode == 0x03)
+		{
+			// rw gw bw rx gx bx, 10 bits each
+			modeNumber = 11;
+			bits = 10;
+			for (int c = 0; c < 3; c++) e0[c] = reader.Read(10);
+			for (int c = 0; c < 3; c++) e1[c] = reader.Read(10);
+		}
+		else if (mode == 0x07)
+		{
+			// rw[9:0] gw[9:0] bw[9:0] rx[8:0] rw[10] gx[8:0] gw[10] bx[8:0] bw[10]
+			modeNumber = 12;
+			bits = 11;
+			for (int c = 0; c < 3; c++) e0[c] = reader.Read(10);
+			for (int c = 0; c < 3; c++)
+			{
+				int delta = reader.Read(9);
+				e0[c] |= reader.Read(1) << 10;
+				if (delta & 0x100) delta -= 0x200;                 // Sign-extend
+				e1[c] = (e0[c] + delta) & 0x7FF;                   // Transformed endpoints wrap
+			}
+		}
+		else
+		{
+			modeNumber = mode;
+			return false;
+		}
+
+		for (int p = 0; p < 16; p++)
+		{
+			const int index = reader.Read(p == 0 ? 3 : 4);         // Anchor index drops its top bit
+			const int w = Weights[index];
+			for (int c = 0; c < 3; c++)
+			{
+				const int a = UnquantizeUnsigned(e0[c], bits);
+				const int b = UnquantizeUnsigned(e1[c], bits);
+				const int interpolated = ((64 - w) * a + w * b + 32) >> 6;
+				texels[p][c] = HalfToFloat((interpolated * 31) >> 6);
+			}
+		}
+		return true;
+	}
+
+	bool DecodeBC6H(const std::vector<uint8_t>& blocks, int width, int height, std::vector<float>& rgb,
+		const std::string& what)
+	{
+		const int blocksX = (width + 3) / 4;
+		const int blocksY = (height + 3) / 4;
+		rgb.assign(static_cast<size_t>(width) * height * 3, 0.0f);
+		bool valid = true;
+		for (int by = 0; by < blocksY; by++)
+		{
+			for (int bx = 0; bx < blocksX; bx++)
+			{
+				float texels[16][3];
+				int mode = 0;
+				if (!DecodeBC6HBlock(blocks.data() + (static_cast<size_t>(by) * blocksX + bx) * 16, texels, mode))
+				{
+					Check(false, what + ": block " + std::to_string(bx) + "," + std::to_string(by) +
+						" uses mode bits " + std::to_string(mode));
+					valid = false;
+					continue;
+				}
+				for (int y = 0; y < 4; y++)
+				{
+					for (int x = 0; x < 4; x++)
+					{
+						int px = bx * 4 + x, py = by * 4 + y;
+						if (px >= width || py >= height) continue;
+						for (int c = 0; c < 3; c++) rgb[(static_cast<size_t>(py) * width + px) * 3 + c] = texels[y * 4 + x][c];
+					}
+				}
+			}
+		}
+		return valid;
+	}
+
+	// =========================================================================
+	// RGB9_E5
+	// =========================================================================
+
+	void CheckRGB9E5Texel(const float (&input)[3], const std::string& what)
+	{
+		uint32_t packed = 0;
+		HDRTextureCodec::PackRGB9E5(input, 1, &packed);
+		float decoded[3];
+		DecodeRGB9E5(packed, decoded);
+
+		// Half a step of the shared exponent; every channel shares the brightest one's step
+		const int shared = static_cast<int>(packed >> 27);
+		const float step = std::ldexp(1.0f, shared - 15 - 9);
+		float brightest = 0.0f;
+		for (int c = 0; c < 3; c++) brightest = std::max(brightest, Clamped(input[c], RGB9E5Max));
+
+		for (int c = 0; c < 3; c++)
+		{
+			const float expected = Clamped(input[c], RGB9E5Max);
+			Check(std::abs(decoded[c] - expected) <= step * 0.5f,
+				what + " channel " + std::to_string(c) + ": " + std::to_string(expected) + " -> " + std::to_string(decoded[c]));
+		}
+		// The shared exponent is the smallest that holds the brightest channel
+		if (brightest > 0.0f)
+		{
+			Check(brightest <= step * 511.5f && (shared == 0 || brightest > step * 255.5f),
+				what + ": shared exponent " + std::to_string(shared) + " for " + std::to_string(brightest));
+		}
+	}
+
+	void CheckRGB9E5()
+	{
+		// Exact values and the documented clamping
+		struct Case { float In[3]; float Out[3]; const char* Name; };
+		const Case cases[] = {
+			{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, "zero" },
+			{ { 1.0f, 0.5f, 0.25f }, { 1.0f, 0.5f, 0.25f }, "powers of two" },
+			{ { 1024.0f, 3.0f, 0.0f }, { 1024.0f, 4.0f, 0.0f }, "channel below the shared step" },
+			{ { NaN, 2.0f, -3.0f }, { 0.0f, 2.0f, 0.0f }, "NaN and negative" },
+			{ { -Inf, -0.0f, -1e-30f }, { 0.0f, 0.0f, 0.0f }, "all negative" },
+			{ { 70000.0f, Inf, 65504.0f }, { RGB9E5Max, RGB9E5Max, RGB9E5Max }, "above range" },
+			{ { 1e9f, 1.0f, 0.0f }, { RGB9E5Max, 0.0f, 0.0f }, "huge next to small" },
+		};
+		for (const Case& c : cases)
+		{
+			uint32_t packed = 0;
+			HDRTextureCodec::PackRGB9E5(c.In, 1, &packed);
+			float decoded[3];
+			DecodeRGB9E5(packed, decoded);
+			for (int i = 0; i < 3; i++)
+			{
+				Check(decoded[i] == c.Out[i], std::string("RGB9E5 ") + c.Name + " channel " + std::to_string(i) + ": " +
+					std::to_string(decoded[i]) + " vs " + std::to_string(c.Out[i]));
+			}
+			CheckRGB9E5Texel(c.In, std::string("RGB9E5 ") + c.Name);
+		}
+
+		// Rounding that carries into the next exponent (511.75 rounds to 512)
+		const float carry[3] = { 511.75f, 1.0f, 0.0f };
+		CheckRGB9E5Texel(carry, "RGB9E5 rounding carry");
+
+		// Random values over the whole range, including subnormal exponents
+		std::mt19937 engine(1234567u);
+		std::uniform_real_distribution<float> exponent(-20.0f, 17.0f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::vector<float> rgb(3 * 4099);
+		for (float& value : rgb)
+		{
+			float r = unit(engine);
+			value = r < 0.02f ? -r : r < 0.04f ? NaN : std::exp2(exponent(engine));
+		}
+		std::vector<uint32_t> packed(rgb.size() / 3);
+		HDRTextureCodec::PackRGB9E5(rgb.data(), packed.size(), packed.data());
+		for (size_t i = 0; i < packed.size(); i++)
+		{
+			uint32_t single = 0;
+			const float texel[3] = { rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2] };
+			HDRTextureCodec::PackRGB9E5(texel, 1, &single);
+			Check(single == packed[i], "RGB9E5 stream matches single texels");
+			CheckRGB9E5Texel(texel, "RGB9E5 random " + std::to_string(i));
+		}
+	}
+
+	// =========================================================================
+	// BC6H
+	// =========================================================================
+
+	struct ErrorStats
+	{
+		double Sum = 0.0;
+		double Max = 0.0;
+		size_t Count = 0;
+
+		void Add(double error)
+		{
+			Sum += error;
+			Max = std::max(Max, error);
+			Count++;
+		}
+		double Mean() const { return Count ? Sum / Count : 0.0; }
+	};
+
+	/** Error of each channel relative to the texel's brightest channel (what the encoder minimises). */
+	ErrorStats CompareBC6H(const std::vector<float>& input, const std::vector<float>& decoded)
+	{
+		ErrorStats stats;
+		for (size_t t = 0; t + 2 < input.size(); t += 3)
+		{
+			float expected[3], brightest = 0.0f;
+			for (int c = 0; c < 3; c++)
+			{
+				expected[c] = Clamped(input[t + c], HalfMax);
+				brightest = std::max(brightest, expected[c]);
+			}
+			// Half floats cannot resolve detail below ~6e-5 anyway
+			const float scale = std::max(brightest, 1e-3f);
+			for (int c = 0; c < 3; c++) stats.Add(std::abs(decoded[t + c] - expected[c]) / scale);
+		}
+		return stats;
+	}
+
+	std::vector<float> EncodeDecode(const std::vector<float>& input, int width, int height, const std::string& what,
+		unsigned int threads = 0)
+	{
+		std::vector<uint8_t> blocks;
+		HDRTextureCodec::EncodeBC6H(input.data(), width, height, blocks, threads);
+		Check(blocks.size() == HDRTextureCodec::GetBC6HSize(width, height), what + ": encoded size");
+
+		std::vector<float> decoded;
+		DecodeBC6H(blocks, width, height, decoded, what);
+		return decoded;
+	}
+
+	void CheckBC6HImages()
+	{
+		std::mt19937 engine(1234567u);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		for (const auto& size : ImageSizes)
+		{
+			const int width = size[0], height = size[1];
+			const std::string name = std::to_string(width) + "x" + std::to_string(height);
+			const size_t texels = static_cast<size_t>(width) * height;
+
+			// Smooth HDR content: a hue cycle every 64 texels across, brightness
+			// doubling every 4 rows from 2^-6 (a sky or light probe, not noise)
+			std::vector<float> smooth(texels * 3);
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					float hue = 6.2831853f * x / 64.0f;
+					float brightness = std::exp2(-6.0f + y / 4.0f);
+					float* texel = &smooth[(static_cast<size_t>(y) * width + x) * 3];
+					texel[0] = brightness * (0.6f + 0.4f * std::cos(hue));
+					texel[1] = brightness * (0.6f + 0.4f * std::cos(hue + 2.1f));
+					texel[2] = brightness * (0.6f + 0.4f * std::cos(hue + 4.2f));
+				}
+			}
+			ErrorStats smoothError = CompareBC6H(smooth, EncodeDecode(smooth, width, height, "BC6H smooth " + name));
+			// Measured around 0.027 mean, 0.10 max; the bounds catch regressions, not noise
+			Check(smoothError.Mean() < 0.04 && smoothError.Max < 0.15,
+				"BC6H smooth " + name + " error mean " + std::to_string(smoothError.Mean()) + ", max " + std::to_string(smoothError.Max));
+
+			// Noise within one order of magnitude: single-region modes are lossy
+			// here, but every texel stays in the block's colour range
+			std::vector<float> noise(texels * 3);
+			for (float& value : noise) value = 1.0f + 9.0f * unit(engine);
+			ErrorStats noiseError = CompareBC6H(noise, EncodeDecode(noise, width, height, "BC6H noise " + name));
+			Check(noiseError.Mean() < 0.25 && noiseError.Max < 1.0,
+				"BC6H noise " + name + " error mean " + std::to_string(noiseError.Mean()) + ", max " + std::to_string(noiseError.Max));
+
+			// Thread count never changes the result
+			std::vector<uint8_t> single, threaded;
+			HDRTextureCodec::EncodeBC6H(smooth.data(), width, height, single, 1);
+			HDRTextureCodec::EncodeBC6H(smooth.data(), width, height, threaded, 4);
+			Check(single == threaded, "BC6H " + name + " threads 1 vs 4");
+
+			VP_INFO("BC6H {}: smooth error mean {:.4f} max {:.4f}, noise mean {:.4f} max {:.4f}", name,
+				smoothError.Mean(), smoothError.Max, noiseError.Mean(), noiseError.Max);
+		}
+	}
+
+	void CheckBC6HSpecialValues()
+	{
+		// Flat colours are reproduced to within endpoint quantization
+		const float flat[][3] = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.25f, 2.0f, 40.0f }, { 1000.0f, 10.0f, 0.1f } };
+		for (const auto& colour : flat)
+		{
+			std::vector<float> image;
+			for (int i = 0; i < 16; i++) image.insert(image.end(), { colour[0], colour[1], colour[2] });
+			std::vector<float> decoded = EncodeDecode(image, 4, 4, "BC6H flat");
+			ErrorStats error = CompareBC6H(image, decoded);
+			Check(error.Max < 0.01, "BC6H flat (" + std::to_string(colour[0]) + ", " + std::to_string(colour[1]) + ", " +
+				std::to_string(colour[2]) + ") error " + std::to_string(error.Max));
+		}
+
+		// NaN and negatives decode to 0, values above the half range to 65504
+		const float special[][3] = {
+			{ NaN, NaN, NaN }, { -1.0f, -1000.0f, -0.0f }, { -Inf, NaN, -1e-20f },
+			{ 70000.0f, 1e9f, Inf }, { HalfMax, HalfMax, HalfMax },
+		};
+		const float expected[][3] = {
+			{ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f },
+			{ HalfMax, HalfMax, HalfMax }, { HalfMax, HalfMax, HalfMax },
+		};
+		for (size_t s = 0; s < std::size(special); s++)
+		{
+			std::vector<float> image;
+			for (int i = 0; i < 16; i++) image.insert(image.end(), { special[s][0], special[s][1], special[s][2] });
+			std::vector<float> decoded = EncodeDecode(image, 4, 4, "BC6H special " + std::to_string(s));
+			for (size_t i = 0; i < decoded.size(); i++)
+			{
+				Check(std::abs(decoded[i] - expected[s][i % 3]) <= expected[s][i % 3] * 0.002f,
+					"BC6H special case " + std::to_string(s) + " value " + std::to_string(decoded[i]));
+			}
+		}
+
+		// NaN, negative and out-of-range texels mixed into blocks of ordinary ones
+		for (float outlier : { NaN, -5.0f, -Inf, 1e6f, Inf })
+		{
+			std::vector<float> mixed;
+			for (int i = 0; i < 16; i++) mixed.insert(mixed.end(), { 2.0f, 2.0f, 2.0f });
+			mixed[15 * 3] = mixed[15 * 3 + 1] = mixed[15 * 3 + 2] = outlier;
+			const std::string what = "BC6H block with outlier " + std::to_string(outlier);
+			std::vector<float> decoded = EncodeDecode(mixed, 4, 4, what);
+			for (float value : decoded) Check(std::isfinite(value) && value >= 0.0f && value <= HalfMax, what + ": in range");
+			// Two colours on one line: both ends are representable
+			const float target = Clamped(outlier, HalfMax);
+			Check(decoded.size() == 48 && std::abs(decoded[45] - target) <= 0.01f * std::max(target, 2.0f)
+				&& std::abs(decoded[0] - 2.0f) <= 0.05f * std::max(target, 2.0f),
+				what + ": decoded " + std::to_string(decoded[45]) + " and " + std::to_string(decoded[0]));
+		}
+
+		// The edge blocks of a 5x5 image repeat the last column and row
+		std::vector<float> edge(5 * 5 * 3);
+		for (int y = 0; y < 5; y++)
+			for (int x = 0; x < 5; x++)
+				for (int c = 0; c < 3; c++)
+					edge[(y * 5 + x) * 3 + c] = (x == 4 || y == 4) ? 8.0f : 1.0f + 0.1f * c;
+		std::vector<uint8_t> blocks;
+		HDRTextureCodec::EncodeBC6H(edge.data(), 5, 5, blocks);
+		Check(blocks.size() == 4 * 16, "BC6H 5x5 is 2x2 blocks");
+		for (int b = 1; b < 4 && blocks.size() == 64; b++)
+		{
+			float texels[16][3];
+			int mode = 0;
+			Check(DecodeBC6HBlock(blocks.data() + b * 16, texels, mode), "BC6H edge block mode");
+			for (const auto& texel : texels) Check(std::abs(texel[0] - 8.0f) < 0.08f, "BC6H edge block repeats the edge texel");
+		}
+
+		// Degenerate sizes
+		Check(HDRTextureCodec::GetBC6HSize(1, 1) == 16 && HDRTextureCodec::GetBC6HSize(5, 4) == 32 &&
+			HDRTextureCodec::GetBC6HSize(0, 0) == 16, "GetBC6HSize");
+		std::vector<uint8_t> empty;
+		HDRTextureCodec::EncodeBC6H(nullptr, 4, 4, empty);
+		Check(empty.size() == 16, "EncodeBC6H without input still sizes the output");
+	}
+}
+
+int main()
+{
+	VizEngine::Log::Init();
+
+	int failuresBefore = g_Failures;
+	CheckRGB9E5();
+	VP_INFO("RGB9_E5: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	failuresBefore = g_Failures;
+	CheckBC6HSpecialValues();
+	CheckBC6HImages();
+	VP_INFO("BC6H: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	VP_INFO("{} checks, {} failures", g_Checks, g_Failures);
+	return g_Failures == 0 ? 0 : 1;
+}
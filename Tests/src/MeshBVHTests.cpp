@@ -0,0 +1,662 @@
+// Tests/src/MeshBVHTests.cpp
+
+// MeshBVH builds and ray queries against brute-force intersection of every
+// triangle (double precision Moller-Trumbore). Every SIMD instruction set the
+// CPU supports is forced with SetActiveISA() and queried with single rays
+// and with packets whose sizes are not multiples of the packet width.
+//
+// Meshes cover a random triangle soup, flat and axis-aligned geometry (zero
+// thickness node boxes, rays parallel to node slabs), degenerate triangles
+// mixed into a soup, and inputs with no valid triangle at all.
+//
+// Rays whose reference answer sits on a triangle edge, grazes a triangle's
+// plane or ties with another triangle are only checked for consistency: the
+// kernels are not watertight there (see MeshBVH) and may legitimately differ.
+//
+// Exit code 0 when every check passes; registered with CTest.
+
+#include <VizEngine/Log.h>
+#include <VizEngine/Core/BatchMath.h>
+#include <VizEngine/Core/MeshBVH.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace VizEngine;
+
+namespace
+{
+	// Packet sizes around every width (4, 8, 16) plus tails
+	const size_t PacketSizes[] = { 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33 };
+
+	const MeshBVHBuildSettings BuildVariants[] = {
+		{ 4, 0 },     // Defaults
+		{ 1, 1 },     // One triangle per leaf, single-threaded
+		{ 16, 2 },    // Widest leaves
+	};
+
+	// Positions are stored with padding to exercise strideBytes
+	constexpr size_t FloatsPerVertex = 5;
+
+	int g_Failures = 0;
+	int g_Checks = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		g_Checks++;
+		if (!condition)
+		{
+			// Keep the log readable when a kernel is wrong for a whole stream
+			if (g_Failures < 50) VP_ERROR("FAILED: {}", what);
+			g_Failures++;
+		}
+	}
+
+	bool Near(double a, double b, double tolerance)
+	{
+		return std::abs(a - b) <= tolerance * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+	}
+
+	// =========================================================================
+	// Test meshes
+	// =========================================================================
+
+	struct TestMesh
+	{
+		std::string Name;
+		std::vector<float> Positions;        // FloatsPerVertex per vertex, xyz first
+		std::vector<uint32_t> Indices;
+		std::vector<uint8_t> Degenerate;     // Per triangle: zero area, must never be hit
+
+		Vec3Stream Origins;
+		Vec3Stream Directions;
+
+		uint32_t AddVertex(const glm::vec3& p)
+		{
+			Positions.insert(Positions.end(), { p.x, p.y, p.z, -1.0f, -1.0f });
+			return static_cast<uint32_t>(Positions.size() / FloatsPerVertex - 1);
+		}
+
+		void AddTriangle(uint32_t a, uint32_t b, uint32_t c, bool degenerate = false)
+		{
+			Indices.insert(Indices.end(), { a, b, c });
+			Degenerate.push_back(degenerate ? 1 : 0);
+		}
+
+		void AddTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, bool degenerate = false)
+		{
+			AddTriangle(AddVertex(a), AddVertex(b), AddVertex(c), degenerate);
+		}
+
+		size_t VertexCount() const { return Positions.size() / FloatsPerVertex; }
+		size_t TriangleCount() const { return Indices.size() / 3; }
+
+		glm::vec3 Vertex(uint32_t index) const
+		{
+			const float* p = &Positions[index * FloatsPerVertex];
+			return glm::vec3(p[0], p[1], p[2]);
+		}
+
+		glm::vec3 Centroid(size_t triangle) const
+		{
+			return (Vertex(Indices[triangle * 3]) + Vertex(Indices[triangle * 3 + 1]) + Vertex(Indices[triangle * 3 + 2]))
+				/ 3.0f;
+		}
+
+		void AddRay(const glm::vec3& origin, const glm::vec3& direction)
+		{
+			Origins.Push(origin);
+			Directions.Push(direction);
+		}
+
+		std::unique_ptr<MeshBVH> Build(const MeshBVHBuildSettings& settings) const
+		{
+			return MeshBVH::Build(Positions.data(), FloatsPerVertex * sizeof(float), VertexCount(),
+				Indices.data(), Indices.size(), settings);
+		}
+	};
+
+	struct Random
+	{
+		std::mt19937 Engine{ 1234567u };
+
+		float Uniform(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(Engine); }
+		size_t Index(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(Engine); }
+
+		glm::vec3 Vec3(float lo, float hi) { return glm::vec3(Uniform(lo, hi), Uniform(lo, hi), Uniform(lo, hi)); }
+
+		glm::vec3 Direction()
+		{
+			glm::vec3 d;
+			do { d = Vec3(-1.0f, 1.0f); } while (glm::length(d) < 0.1f);
+			return d;
+		}
+	};
+
+	// Random rays, half of them aimed at triangles so hits are common
+	void AddRandomRays(TestMesh& mesh, Random& random, size_t count, float originRange)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			glm::vec3 origin = random.Vec3(-originRange, originRange);
+			if (i % 2 == 0 && mesh.TriangleCount() > 0)
+			{
+				glm::vec3 target = mesh.Centroid(random.Index(mesh.TriangleCount())) + random.Vec3(-0.2f, 0.2f);
+				mesh.AddRay(origin, (target - origin) * random.Uniform(0.5f, 2.0f));
+			}
+			else
+			{
+				mesh.AddRay(origin, random.Direction());
+			}
+		}
+	}
+
+	TestMesh MakeSoup(Random& random, size_t triangles)
+	{
+		TestMesh mesh;
+		mesh.Name = "soup";
+		for (size_t i = 0; i < triangles; i++)
+		{
+			glm::vec3 center = random.Vec3(-10.0f, 10.0f);
+			mesh.AddTriangle(center + random.Vec3(-1.0f, 1.0f), center + random.Vec3(-1.0f, 1.0f),
+				center + random.Vec3(-1.0f, 1.0f));
+		}
+		AddRandomRays(mesh, random, 1500, 15.0f);
+		return mesh;
+	}
+
+	// One plane: every node box has zero thickness in y
+	TestMesh MakeFlatGrid(Random& random)
+	{
+		TestMesh mesh;
+		mesh.Name = "flat grid";
+		const int cells = 48;
+		const float size = 16.0f / cells;
+		std::vector<uint32_t> grid;
+		for (int z = 0; z <= cells; z++)
+			for (int x = 0; x <= cells; x++)
+				grid.push_back(mesh.AddVertex(glm::vec3(-8.0f + x * size, 0.0f, -8.0f + z * size)));
+		for (int z = 0; z < cells; z++)
+		{
+			for (int x = 0; x < cells; x++)
+			{
+				uint32_t i = static_cast<uint32_t>(z * (cells + 1) + x);
+				mesh.AddTriangle(grid[i], grid[i + 1], grid[i + cells + 1]);
+				mesh.AddTriangle(grid[i + 1], grid[i + cells + 2], grid[i + cells + 1]);
+			}
+		}
+
+		for (int i = 0; i < 400; i++)
+		{
+			glm::vec3 ground(random.Uniform(-9.0f, 9.0f), 0.0f, random.Uniform(-9.0f, 9.0f));
+			mesh.AddRay(ground + glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));        // Straight down
+			mesh.AddRay(ground - glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f));         // Straight up
+			mesh.AddRay(ground + glm::vec3(0.0f, 4.0f, 0.0f), random.Direction() - glm::vec3(0.0f, 2.0f, 0.0f));
+			mesh.AddRay(ground, glm::vec3(1.0f, 0.0f, 0.0f));                                      // In the plane
+			mesh.AddRay(ground, glm::vec3(random.Uniform(-1.0f, 1.0f), 0.0f, random.Uniform(-1.0f, 1.0f)));
+			mesh.AddRay(ground + glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f));      // Parallel above
+		}
+		return mesh;
+	}
+
+	// Axis-aligned box surface: node slabs coincide with faces
+	TestMesh MakeBox(Random& random)
+	{
+		TestMesh mesh;
+		mesh.Name = "box";
+		const int cells = 6;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (float side : { -1.0f, 1.0f })
+			{
+				int u = (axis + 1) % 3, v = (axis + 2) % 3;
+				for (int j = 0; j < cells; j++)
+				{
+					for (int i = 0; i < cells; i++)
+					{
+						glm::vec3 corner[4];
+						for (int k = 0; k < 4; k++)
+						{
+							corner[k][axis] = side;
+							corner[k][u] = -1.0f + 2.0f * (i + (k & 1)) / cells;
+							corner[k][v] = -1.0f + 2.0f * (j + (k >> 1)) / cells;
+						}
+						mesh.AddTriangle(corner[0], corner[1], corner[3]);
+						mesh.AddTriangle(corner[0], corner[3], corner[2]);
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < 300; i++)
+		{
+			int axis = i % 3;
+			glm::vec3 origin = random.Vec3(-0.95f, 0.95f);
+			glm::vec3 direction(0.0f);
+			origin[axis] = (i & 4) ? 3.0f : -3.0f;
+			direction[axis] = (i & 4) ? -1.0f : 1.0f;
+			mesh.AddRay(origin, direction);                           // Along an axis, from outside
+			glm::vec3 inside = origin;
+			inside[axis] = 0.0f;
+			mesh.AddRay(inside, direction * 0.25f);                   // From inside
+			glm::vec3 onSlab = origin;
+			onSlab[(axis + 1) % 3] = (i & 8) ? 1.0f : -1.0f;          // In a face's plane
+			mesh.AddRay(onSlab, direction);
+			glm::vec3 outside = origin;
+			outside[(axis + 1) % 3] = 1.5f;                           // Parallel, beside the box
+			mesh.AddRay(outside, direction);
+		}
+		AddRandomRays(mesh, random, 300, 4.0f);
+		return mesh;
+	}
+
+	// A soup with zero-area triangles, plus triangles Build() must skip
+	TestMesh MakeDegenerate(Random& random)
+	{
+		TestMesh mesh = MakeSoup(random, 200);
+		mesh.Name = "degenerate";
+		mesh.Origins = Vec3Stream();
+		mesh.Directions = Vec3Stream();
+
+		std::vector<glm::vec3> degenerateCenters;
+		for (int i = 0; i < 60; i++)
+		{
+			glm::vec3 a(std::round(random.Uniform(-8.0f, 8.0f)), std::round(random.Uniform(-8.0f, 8.0f)), 0.5f);
+			if (i % 3 == 0)
+			{
+				// Collinear along x: exact zero determinant for any ray
+				mesh.AddTriangle(a, a + glm::vec3(1.0f, 0.0f, 0.0f), a + glm::vec3(2.0f, 0.0f, 0.0f), true);
+			}
+			else if (i % 3 == 1)
+			{
+				uint32_t v = mesh.AddVertex(a);
+				mesh.AddTriangle(v, v, mesh.AddVertex(a + glm::vec3(0.0f, 1.0f, 0.0f)), true);   // Repeated index
+			}
+			else
+			{
+				uint32_t v = mesh.AddVertex(a);
+				mesh.AddTriangle(v, v, v, true);                                                  // A point
+			}
+			degenerateCenters.push_back(a + glm::vec3(0.5f, 0.0f, 0.0f));
+		}
+
+		// Skipped by Build(); the reference treats them as absent
+		const uint32_t outOfRange = static_cast<uint32_t>(mesh.VertexCount() + 10);
+		mesh.AddTriangle(0, 1, outOfRange, true);
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		mesh.AddTriangle(glm::vec3(nan, 0.0f, 0.0f), glm::vec3(1.0f), glm::vec3(2.0f, 1.0f, 1.0f), true);
+		mesh.AddTriangle(glm::vec3(INFINITY, 0.0f, 0.0f), glm::vec3(1.0f), glm::vec3(2.0f, 1.0f, 1.0f), true);
+
+		for (const glm::vec3& center : degenerateCenters)
+		{
+			mesh.AddRay(center + glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+			mesh.AddRay(center - glm::vec3(3.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+		}
+		AddRandomRays(mesh, random, 600, 15.0f);
+		return mesh;
+	}
+
+	// =========================================================================
+	// Brute-force reference
+	// =========================================================================
+
+	struct ReferenceHit
+	{
+		bool Hit = false;
+		double T = 0.0, U = 0.0, V = 0.0;
+		uint32_t Triangle = RayHit::NoTriangle;
+		bool Ambiguous = false;    // Edge, grazing or tMax case: kernels may differ
+		bool Tied = false;         // Another triangle is hit at (nearly) the same T
+	};
+
+	struct TriangleTest
+	{
+		bool Valid = false;        // Finite, in range and with non-zero area
+		bool Hit = false;
+		bool Ambiguous = false;
+		double T = 0.0, U = 0.0, V = 0.0;
+	};
+
+	TriangleTest IntersectTriangle(const TestMesh& mesh, size_t triangle, const glm::vec3& origin,
+		const glm::vec3& direction)
+	{
+		TriangleTest result;
+		const size_t vertexCount = mesh.VertexCount();
+		double v[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			uint32_t index = mesh.Indices[triangle * 3 + i];
+			if (index >= vertexCount) return result;
+			glm::vec3 p = mesh.Vertex(index);
+			for (int a = 0; a < 3; a++)
+			{
+				if (!std::isfinite(p[a])) return result;
+				v[i][a] = p[a];
+			}
+		}
+
+		const double o[3] = { origin.x, origin.y, origin.z };
+		const double d[3] = { direction.x, direction.y, direction.z };
+		double e1[3], e2[3], s[3];
+		for (int a = 0; a < 3; a++)
+		{
+			e1[a] = v[1][a] - v[0][a];
+			e2[a] = v[2][a] - v[0][a];
+			s[a] = o[a] - v[0][a];
+		}
+		const double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+		const double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (area == 0.0) return result;
+		result.Valid = true;
+
+		const double p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+		const double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+		if (det == 0.0) return result;    // Exactly in the plane: the float kernels get det == 0 too
+
+		// Nearly in the plane: float and double round differently
+		const double directionLength = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+		const bool grazing = std::abs(det) < 1e-5 * area * directionLength;
+
+		const double q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+		result.U = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+		result.V = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+		result.T = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+
+		const double slack = 1e-6;    // BVHEdgeEpsilon
+		result.Hit = result.U >= -slack && result.V >= -slack && result.U + result.V <= 1.0 + slack && result.T > 0.0;
+
+		// Within rounding of an edge (inside or out), of the origin, or grazing
+		const double margin = 1e-4;
+		const double edge = std::min({ std::abs(result.U + slack), std::abs(result.V + slack),
+			std::abs(1.0 + slack - result.U - result.V) });
+		const bool nearEdge = edge < margin && result.U > -margin && result.V > -margin && result.U + result.V < 1.0 + margin;
+		result.Ambiguous = (grazing && result.T > -margin) || (nearEdge && result.T > -margin) ||
+			(std::abs(result.T) < margin && result.U > -margin && result.V > -margin && result.U + result.V < 1.0 + margin);
+		return result;
+	}
+
+	ReferenceHit BruteForce(const TestMesh& mesh, const glm::vec3& origin, const glm::vec3& direction, float tMax)
+	{
+		ReferenceHit best;
+		best.T = tMax;
+		double second = std::numeric_limits<double>::infinity();
+		for (size_t t = 0; t < mesh.TriangleCount(); t++)
+		{
+			TriangleTest test = IntersectTriangle(mesh, t, origin, direction);
+			if (!test.Valid) continue;
+			if (test.Ambiguous && test.T < tMax * (1.0 + 1e-4)) best.Ambiguous = true;
+			if (!test.Hit) continue;
+			if (Near(test.T, tMax, 1e-5)) best.Ambiguous = true;
+			if (test.T >= tMax) continue;
+
+			if (!best.Hit || test.T < best.T)
+			{
+				if (best.Hit) second = best.T;
+				best.Hit = true;
+				best.T = test.T;
+				best.U = test.U;
+				best.V = test.V;
+				best.Triangle = static_cast<uint32_t>(t);
+			}
+			else
+			{
+				second = std::min(second, test.T);
+			}
+		}
+		best.Tied = best.Hit && Near(best.T, second, 1e-4);
+		return best;
+	}
+
+	// =========================================================================
+	// Comparisons
+	// =========================================================================
+
+	// Any reported hit must be a real intersection of that triangle, whatever the ray
+	void CheckConsistent(const TestMesh& mesh, const glm::vec3& origin, const glm::vec3& direction, const RayHit& hit,
+		float tMax, const std::string& what)
+	{
+		if (!hit.IsHit()) return;
+		if (hit.Triangle >= mesh.TriangleCount())
+		{
+			Check(false, what + ": triangle index " + std::to_string(hit.Triangle) + " out of range");
+			return;
+		}
+		Check(!mesh.Degenerate[hit.Triangle], what + ": hit degenerate triangle " + std::to_string(hit.Triangle));
+
+		TriangleTest test = IntersectTriangle(mesh, hit.Triangle, origin, direction);
+		const double slack = 1e-3;
+		Check(test.Valid && hit.T > 0.0f && hit.T < tMax, what + ": T " + std::to_string(hit.T) + " out of (0, tMax)");
+		Check(test.Valid && Near(hit.T, test.T, slack) && hit.U >= -slack && hit.V >= -slack && hit.U + hit.V <= 1.0 + slack,
+			what + ": reported hit (T " + std::to_string(hit.T) + ") is not on triangle " + std::to_string(hit.Triangle));
+		Check(!test.Valid || (Near(hit.U, test.U, slack) && Near(hit.V, test.V, slack)),
+			what + ": barycentrics " + std::to_string(hit.U) + ", " + std::to_string(hit.V) + " vs " +
+			std::to_string(test.U) + ", " + std::to_string(test.V));
+	}
+
+	void CompareHit(const TestMesh& mesh, size_t ray, const ReferenceHit& reference, const RayHit& hit, float tMax,
+		const std::string& what)
+	{
+		const std::string where = what + " ray " + std::to_string(ray);
+		CheckConsistent(mesh, mesh.Origins.Get(ray), mesh.Directions.Get(ray), hit, tMax, where);
+		if (reference.Ambiguous) return;
+
+		Check(hit.IsHit() == reference.Hit, where + ": " + (reference.Hit ? "missed" : "unexpected hit"));
+		if (!hit.IsHit() || !reference.Hit) return;
+
+		Check(Near(hit.T, reference.T, 1e-4), where + ": T " + std::to_string(hit.T) + " vs " + std::to_string(reference.T));
+		if (!reference.Tied)
+		{
+			Check(hit.Triangle == reference.Triangle,
+				where + ": triangle " + std::to_string(hit.Triangle) + " vs " + std::to_string(reference.Triangle));
+		}
+	}
+
+	Vec3Stream Prefix(const Vec3Stream& stream, size_t count)
+	{
+		Vec3Stream prefix;
+		prefix.Resize(count);
+		for (size_t i = 0; i < count; i++) prefix.Set(i, stream.Get(i));
+		return prefix;
+	}
+
+	void CheckQueries(const TestMesh& mesh, const MeshBVH& bvh, const std::vector<ReferenceHit>& references, float tMax,
+		const std::string& suffix)
+	{
+		const size_t rayCount = mesh.Origins.Size();
+
+		// Single rays
+		for (size_t i = 0; i < rayCount; i++)
+		{
+			const glm::vec3 origin = mesh.Origins.Get(i);
+			const glm::vec3 direction = mesh.Directions.Get(i);
+			RayHit hit;
+			bool result = bvh.Intersect(origin, direction, hit, tMax);
+			Check(result == hit.IsHit(), "Intersect return value" + suffix);
+			CompareHit(mesh, i, references[i], hit, tMax, "Intersect" + suffix);
+
+			if (!references[i].Ambiguous)
+			{
+				Check(bvh.Occluded(origin, direction, tMax) == references[i].Hit,
+					"Occluded ray " + std::to_string(i) + suffix);
+			}
+		}
+
+		// Packets: the whole stream, then short streams that end in a partial packet
+		RayHitStream hits;
+		bvh.Intersect(mesh.Origins, mesh.Directions, hits, tMax);
+		Check(hits.Size() == rayCount, "Intersect(streams) size" + suffix);
+		for (size_t i = 0; i < std::min(rayCount, hits.Size()); i++)
+		{
+			CompareHit(mesh, i, references[i], hits.Get(i), tMax, "Intersect(streams)" + suffix);
+		}
+
+		std::vector<uint8_t> occluded;
+		bvh.Occluded(mesh.Origins, mesh.Directions, occluded, tMax);
+		Check(occluded.size() == rayCount, "Occluded(streams) size" + suffix);
+		for (size_t i = 0; i < std::min(rayCount, occluded.size()); i++)
+		{
+			if (references[i].Ambiguous) continue;
+			Check((occluded[i] != 0) == references[i].Hit, "Occluded(streams) ray " + std::to_string(i) + suffix);
+		}
+
+		for (size_t count : PacketSizes)
+		{
+			if (count > rayCount) break;
+			RayHitStream partial;
+			bvh.Intersect(Prefix(mesh.Origins, count), Prefix(mesh.Directions, count), partial, tMax);
+			Check(partial.Size() == count, "Intersect(streams) n=" + std::to_string(count) + " size" + suffix);
+			for (size_t i = 0; i < std::min(count, partial.Size()); i++)
+			{
+				CompareHit(mesh, i, references[i], partial.Get(i), tMax,
+					"Intersect(streams) n=" + std::to_string(count) + suffix);
+			}
+		}
+	}
+
+	// =========================================================================
+	// Test driver
+	// =========================================================================
+
+	struct PreparedMesh
+	{
+		TestMesh Mesh;
+		std::vector<std::unique_ptr<MeshBVH>> BVHs;        // One per BuildVariants entry
+		std::vector<ReferenceHit> Unbounded;               // tMax = FLT_MAX
+		std::vector<ReferenceHit> Bounded;                 // tMax = BoundedT
+	};
+
+	constexpr float BoundedT = 6.0f;
+
+	std::vector<PreparedMesh> PrepareMeshes()
+	{
+		Random random;
+		std::vector<TestMesh> meshes;
+		meshes.push_back(MakeSoup(random, 2000));
+		meshes.push_back(MakeFlatGrid(random));
+		meshes.push_back(MakeBox(random));
+		meshes.push_back(MakeDegenerate(random));
+
+		std::vector<PreparedMesh> prepared;
+		for (TestMesh& mesh : meshes)
+		{
+			PreparedMesh entry;
+			entry.Mesh = std::move(mesh);
+			const TestMesh& m = entry.Mesh;
+
+			size_t validTriangles = 0;
+			for (uint8_t degenerate : m.Degenerate) validTriangles += degenerate ? 0 : 1;
+
+			for (const MeshBVHBuildSettings& settings : BuildVariants)
+			{
+				entry.BVHs.push_back(m.Build(settings));
+				const MeshBVH* bvh = entry.BVHs.back().get();
+				Check(bvh != nullptr, "Build " + m.Name);
+				if (!bvh) continue;
+				// Zero-area triangles are kept (they never hit); invalid ones are skipped
+				Check(bvh->GetStats().Triangles >= validTriangles && bvh->GetStats().Triangles <= m.TriangleCount(),
+					"Build " + m.Name + " triangle count " + std::to_string(bvh->GetStats().Triangles));
+				Check(bvh->GetStats().Leaves > 0, "Build " + m.Name + " leaves");
+			}
+
+			for (size_t i = 0; i < m.Origins.Size(); i++)
+			{
+				entry.Unbounded.push_back(BruteForce(m, m.Origins.Get(i), m.Directions.Get(i), FLT_MAX));
+				entry.Bounded.push_back(BruteForce(m, m.Origins.Get(i), m.Directions.Get(i), BoundedT));
+			}
+
+			size_t hits = 0, ambiguous = 0;
+			for (const ReferenceHit& r : entry.Unbounded)
+			{
+				hits += r.Hit ? 1 : 0;
+				ambiguous += r.Ambiguous ? 1 : 0;
+			}
+			VP_INFO("Mesh '{}': {} triangles, {} rays, {} hits, {} on edges (consistency only)",
+				m.Name, m.TriangleCount(), m.Origins.Size(), hits, ambiguous);
+			Check(hits > m.Origins.Size() / 10, "Mesh " + m.Name + " has too few hits to be meaningful");
+			prepared.push_back(std::move(entry));
+		}
+		return prepared;
+	}
+
+	void CheckEmpty()
+	{
+		const float positions[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+		const uint32_t indices[3] = { 0, 1, 2 };
+		const uint32_t outOfRange[3] = { 0, 1, 7 };
+		const float nanPositions[9] = { 0, 0, 0, 1, 0, std::numeric_limits<float>::quiet_NaN(), 0, 1, 0 };
+
+		Check(MeshBVH::Build(nullptr, 12, 0, nullptr, 0) == nullptr, "Build of an empty mesh returns nullptr");
+		Check(MeshBVH::Build(positions, 12, 3, indices, 2) == nullptr, "Build of a partial triangle returns nullptr");
+		Check(MeshBVH::Build(positions, 12, 3, outOfRange, 3) == nullptr, "Build with only out-of-range indices returns nullptr");
+		Check(MeshBVH::Build(nanPositions, 12, 3, indices, 3) == nullptr, "Build with only NaN positions returns nullptr");
+
+		// One triangle: the root is a leaf
+		auto single = MeshBVH::Build(positions, 12, 3, indices, 3);
+		Check(single != nullptr, "Build of one triangle");
+		if (single)
+		{
+			RayHit hit;
+			Check(single->Intersect(glm::vec3(0.25f, 0.25f, -1.0f), glm::vec3(0.0f, 0.0f, 1.0f), hit) && hit.Triangle == 0
+				&& Near(hit.T, 1.0, 1e-6) && Near(hit.U, 0.25, 1e-6) && Near(hit.V, 0.25, 1e-6), "Single triangle hit");
+			Check(!single->Intersect(glm::vec3(0.25f, 0.25f, -1.0f), glm::vec3(0.0f, 0.0f, 1.0f), hit, 0.5f),
+				"Single triangle beyond tMax");
+			Check(!single->Intersect(glm::vec3(0.25f, 0.25f, -1.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit),
+				"Single triangle behind the origin");
+		}
+	}
+
+	void CheckISA(const std::vector<PreparedMesh>& meshes, SimdISA isa)
+	{
+		const std::string name = BatchMath::GetISAName(isa);
+		Check(BatchMath::SetActiveISA(isa), "SetActiveISA " + name);
+
+		for (const PreparedMesh& entry : meshes)
+		{
+			for (size_t b = 0; b < entry.BVHs.size(); b++)
+			{
+				if (!entry.BVHs[b]) continue;
+				const std::string suffix = " (" + name + ", " + entry.Mesh.Name + ", leaf " +
+					std::to_string(BuildVariants[b].MaxLeafSize) + ")";
+				CheckQueries(entry.Mesh, *entry.BVHs[b], entry.Unbounded, FLT_MAX, suffix);
+				CheckQueries(entry.Mesh, *entry.BVHs[b], entry.Bounded, BoundedT, suffix + " tMax");
+			}
+		}
+
+		BatchMath::SetActiveISA(SimdISA::Scalar);
+	}
+}
+
+int main()
+{
+	VizEngine::Log::Init();
+
+	const SimdISA detected = BatchMath::GetDetectedISA();
+	VP_INFO("Detected {}", BatchMath::GetISAName(detected));
+
+	CheckEmpty();
+	const std::vector<PreparedMesh> meshes = PrepareMeshes();
+
+	const SimdISA isas[] = { SimdISA::Scalar, SimdISA::SSE42, SimdISA::AVX2, SimdISA::AVX512 };
+	for (SimdISA isa : isas)
+	{
+		if (static_cast<int>(isa) > static_cast<int>(detected))
+		{
+			VP_INFO("{}: not supported on this CPU, skipped", BatchMath::GetISAName(isa));
+			continue;
+		}
+
+		const int failuresBefore = g_Failures;
+		CheckISA(meshes, isa);
+		VP_INFO("{} ({}-ray packets): {}", BatchMath::GetISAName(isa), BatchMath::GetLaneCount(isa),
+			g_Failures == failuresBefore ? "passed" : "FAILED");
+	}
+
+	VP_INFO("{} checks, {} failures", g_Checks, g_Failures);
+	return g_Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,573 @@
+// Tests/src/PointCloudFileTests.cpp
+
+// PointSource readers on files generated by the test itself: LAS 1.2 and
+// 1.4 (point formats 0, 2, 3 and 7, extra bytes per record), binary and
+// ASCII PLY (extra properties, trailing face elements, 8-bit, 16-bit and
+// float color) and XYZ text with and without color columns.
+//
+// Every file is read whole and in several parts; both must return exactly
+// the points that were written. Truncated payloads must return the complete
+// records only, and LAZ, big-endian PLY and other unsupported inputs must
+// fail to open.
+//
+// Exit code 0 when every check passes; registered with CTest.
+
+#include <VizEngine/Log.h>
+#include <VizEngine/Core/PointCloudFile.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace VizEngine;
+
+namespace
+{
+	int g_Failures = 0;
+	int g_Checks = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		g_Checks++;
+		if (!condition)
+		{
+			if (g_Failures < 50) VP_ERROR("FAILED: {}", what);
+			g_Failures++;
+		}
+	}
+
+	std::vector<std::string> g_TempFiles;
+
+	std::string WriteTemp(const std::string& name, const std::vector<uint8_t>& bytes)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / ("vizengine_pointsource_" + name)).string();
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		g_TempFiles.push_back(path);
+		return path;
+	}
+
+	std::string WriteTemp(const std::string& name, const std::string& text)
+	{
+		return WriteTemp(name, std::vector<uint8_t>(text.begin(), text.end()));
+	}
+
+	/** Little-endian byte buffer. */
+	struct Bytes
+	{
+		std::vector<uint8_t> Data;
+
+		template<typename T>
+		void Put(T value)
+		{
+			uint8_t raw[sizeof(T)];
+			std::memcpy(raw, &value, sizeof(T));
+			Data.insert(Data.end(), raw, raw + sizeof(T));
+		}
+
+		template<typename T>
+		void PutAt(size_t offset, T value)
+		{
+			std::memcpy(Data.data() + offset, &value, sizeof(T));
+		}
+
+		void PutText(const std::string& text) { Data.insert(Data.end(), text.begin(), text.end()); }
+	};
+
+	std::vector<SourcePoint> ReadAll(const PointSource& source, unsigned parts)
+	{
+		std::vector<SourcePoint> points;
+		for (unsigned part = 0; part < parts; part++)
+		{
+			source.Read(part, parts, [&](const SourcePoint* batch, size_t count) {
+				points.insert(points.end(), batch, batch + count);
+			});
+		}
+		return points;
+	}
+
+	/**
+	 * Open a file and compare what every split returns with the expected points.
+	 */
+	void CheckRead(const std::string& path, const std::vector<SourcePoint>& expected, bool color,
+		PointSource::Format format, const std::string& name)
+	{
+		PointSource source;
+		const bool opened = source.Open(path);
+		Check(opened, name + " opens");
+		if (!opened) return;
+
+		Check(source.GetFormat() == format, name + " format");
+		Check(source.HasColor() == color, name + " color detected");
+		if (format != PointSource::Format::XYZ)
+		{
+			Check(source.GetPointCount() == expected.size(), name + " point count " + std::to_string(source.GetPointCount()));
+		}
+
+		for (unsigned parts : { 1u, 3u, 7u })
+		{
+			const std::vector<SourcePoint> points = ReadAll(source, parts);
+			const std::string what = name + " (" + std::to_string(parts) + " parts)";
+			Check(points.size() == expected.size(), what + " read " + std::to_string(points.size()) +
+				" of " + std::to_string(expected.size()) + " points");
+
+			size_t bad = 0;
+			size_t firstBad = 0;
+			for (size_t i = 0; i < points.size() && i < expected.size(); i++)
+			{
+				const SourcePoint& a = points[i];
+				const SourcePoint& b = expected[i];
+				const bool match = std::abs(a.X - b.X) < 1e-6 && std::abs(a.Y - b.Y) < 1e-6 && std::abs(a.Z - b.Z) < 1e-6 &&
+					a.R == b.R && a.G == b.G && a.B == b.B;
+				if (!match && bad++ == 0) firstBad = i;
+			}
+			Check(bad == 0, what + " " + std::to_string(bad) + " points differ, first at " + std::to_string(firstBad));
+		}
+	}
+
+	void ExpectRejected(const std::string& path, const std::string& what)
+	{
+		PointSource source;
+		Check(!source.Open(path), what + " rejected");
+	}
+
+	// =========================================================================
+	// LAS
+	// =========================================================================
+
+	struct LASPoint
+	{
+		int32_t X, Y, Z;
+		uint16_t R, G, B;
+	};
+
+	constexpr double LASScale[3] = { 0.01, 0.001, 0.25 };
+	constexpr double LASOffset[3] = { 450000.0, -5200000.0, 12.5 };
+
+	int LASColorOffset(int pointFormat)
+	{
+		switch (pointFormat)
+		{
+		case 2: return 20;
+		case 3: return 28;
+		case 7: return 30;
+		default: return -1;
+		}
+	}
+
+	/**
+	 * LAS file with no VLRs. LAS 1.4 headers store the count in the 64-bit
+	 * field only; the legacy 32-bit field is 0 as for formats 6-10.
+	 */
+	std::vector<uint8_t> MakeLAS(int minor, uint8_t formatByte, uint16_t recordLength,
+		const std::vector<LASPoint>& points, uint64_t declaredCount)
+	{
+		const uint16_t headerSize = minor >= 4 ? 375 : 227;
+
+		Bytes file;
+		file.Data.resize(headerSize, 0);
+		std::memcpy(file.Data.data(), "LASF", 4);
+		file.Data[24] = 1;
+		file.Data[25] = static_cast<uint8_t>(minor);
+		file.PutAt<uint16_t>(94, headerSize);
+		file.PutAt<uint32_t>(96, headerSize);
+		file.Data[104] = formatByte;
+		file.PutAt<uint16_t>(105, recordLength);
+		file.PutAt<uint32_t>(107, minor >= 4 ? 0u : static_cast<uint32_t>(declaredCount));
+		if (minor >= 4) file.PutAt<uint64_t>(247, declaredCount);
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double lo = 1e300, hi = -1e300;
+			for (const LASPoint& p : points)
+			{
+				const int32_t value = axis == 0 ? p.X : axis == 1 ? p.Y : p.Z;
+				lo = std::min(lo, value * LASScale[axis] + LASOffset[axis]);
+				hi = std::max(hi, value * LASScale[axis] + LASOffset[axis]);
+			}
+			file.PutAt<double>(131 + axis * 8, LASScale[axis]);
+			file.PutAt<double>(155 + axis * 8, LASOffset[axis]);
+			file.PutAt<double>(179 + axis * 16, hi);
+			file.PutAt<double>(187 + axis * 16, lo);
+		}
+
+		const int colorOffset = LASColorOffset(formatByte & 0x3F);
+		for (const LASPoint& p : points)
+		{
+			const size_t record = file.Data.size();
+			file.Data.resize(record + recordLength, 0xCD);   // Fields the reader ignores are garbage
+			file.PutAt<int32_t>(record + 0, p.X);
+			file.PutAt<int32_t>(record + 4, p.Y);
+			file.PutAt<int32_t>(record + 8, p.Z);
+			if (colorOffset >= 0)
+			{
+				file.PutAt<uint16_t>(record + colorOffset + 0, p.R);
+				file.PutAt<uint16_t>(record + colorOffset + 2, p.G);
+				file.PutAt<uint16_t>(record + colorOffset + 4, p.B);
+			}
+		}
+		return file.Data;
+	}
+
+	std::vector<LASPoint> MakeLASPoints(size_t count, bool wideColor)
+	{
+		std::vector<LASPoint> points(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const int32_t n = static_cast<int32_t>(i);
+			points[i].X = n * 37 - 100000;
+			points[i].Y = -n * 1013 + 7;
+			points[i].Z = (n % 211) - 50;
+			if (wideColor)
+			{
+				points[i].R = static_cast<uint16_t>(n * 257);
+				points[i].G = static_cast<uint16_t>(65535 - n * 13);
+				points[i].B = static_cast<uint16_t>(n * 7919);
+			}
+			else
+			{
+				points[i].R = static_cast<uint16_t>(n % 256);
+				points[i].G = static_cast<uint16_t>(255 - n % 256);
+				points[i].B = static_cast<uint16_t>((n * 31) % 256);
+			}
+		}
+		return points;
+	}
+
+	std::vector<SourcePoint> ExpectedLAS(const std::vector<LASPoint>& points, bool color, int colorShift)
+	{
+		std::vector<SourcePoint> expected(points.size());
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			expected[i].X = points[i].X * LASScale[0] + LASOffset[0];
+			expected[i].Y = points[i].Y * LASScale[1] + LASOffset[1];
+			expected[i].Z = points[i].Z * LASScale[2] + LASOffset[2];
+			if (color)
+			{
+				expected[i].R = static_cast<uint8_t>(points[i].R >> colorShift);
+				expected[i].G = static_cast<uint8_t>(points[i].G >> colorShift);
+				expected[i].B = static_cast<uint8_t>(points[i].B >> colorShift);
+			}
+		}
+		return expected;
+	}
+
+	void CheckLAS()
+	{
+		struct Case
+		{
+			const char* Name;
+			int Minor;
+			uint8_t Format;
+			uint16_t RecordLength;
+			size_t Count;
+			bool WideColor;
+		};
+		// More points than one read batch, and record lengths with extra bytes
+		const Case cases[] = {
+			{ "LAS 1.2 format 0", 2, 0, 20, 1000, false },
+			{ "LAS 1.2 format 0 extra bytes", 2, 0, 28, 333, false },
+			{ "LAS 1.2 format 2 16-bit color", 2, 2, 26, 20000, true },
+			{ "LAS 1.2 format 2 8-bit color", 2, 2, 26, 500, false },
+			{ "LAS 1.2 format 3 16-bit color", 2, 3, 34, 777, true },
+			{ "LAS 1.4 format 7 16-bit color", 4, 7, 36, 17000, true },
+			{ "LAS 1.4 format 7 8-bit color", 4, 7, 40, 64, false },
+		};
+
+		for (const Case& c : cases)
+		{
+			const std::vector<LASPoint> points = MakeLASPoints(c.Count, c.WideColor);
+			const bool color = LASColorOffset(c.Format) >= 0;
+			const std::string path = WriteTemp("las.las", MakeLAS(c.Minor, c.Format, c.RecordLength, points, points.size()));
+			CheckRead(path, ExpectedLAS(points, color, c.WideColor ? 8 : 0), color, PointSource::Format::LAS, c.Name);
+
+			PointSource source;
+			if (source.Open(path))
+			{
+				const SourcePoint first = ExpectedLAS({ points[0] }, false, 0)[0];
+				Check(source.HasBounds() && source.GetBoundsMin()[0] <= first.X && first.X <= source.GetBoundsMax()[0] &&
+					source.GetBoundsMin()[2] <= first.Z && first.Z <= source.GetBoundsMax()[2], std::string(c.Name) + " bounds");
+			}
+		}
+
+		// 8-bit colors are only assumed while every sampled channel fits in a byte
+		{
+			std::vector<LASPoint> points = MakeLASPoints(300, false);
+			points[299].B = 256;
+			const std::string path = WriteTemp("las_one_wide.las", MakeLAS(2, 2, 26, points, points.size()));
+			CheckRead(path, ExpectedLAS(points, true, 8), true, PointSource::Format::LAS, "LAS one 16-bit sample");
+		}
+
+		// Truncated payloads keep the complete records only
+		{
+			const std::vector<LASPoint> points = MakeLASPoints(100, true);
+			std::vector<uint8_t> file = MakeLAS(2, 2, 26, points, points.size());
+			file.resize(file.size() - 26 * 40 - 11);
+			const std::vector<LASPoint> complete(points.begin(), points.begin() + 59);
+			CheckRead(WriteTemp("las_truncated.las", file), ExpectedLAS(complete, true, 8), true,
+				PointSource::Format::LAS, "LAS 1.2 truncated payload");
+		}
+		{
+			const std::vector<LASPoint> points = MakeLASPoints(10, false);
+			std::vector<uint8_t> file = MakeLAS(4, 7, 36, points, 1000000);
+			CheckRead(WriteTemp("las14_overcount.las", file), ExpectedLAS(points, true, 0), true,
+				PointSource::Format::LAS, "LAS 1.4 count past the end");
+		}
+		{
+			std::vector<uint8_t> file = MakeLAS(2, 0, 20, MakeLASPoints(5, false), 5);
+			file.resize(227);
+			CheckRead(WriteTemp("las_header_only.las", file), {}, false, PointSource::Format::LAS, "LAS header only");
+		}
+
+		// Rejected inputs
+		{
+			std::vector<uint8_t> file = MakeLAS(2, 0, 20, MakeLASPoints(5, false), 5);
+			file.resize(226);
+			ExpectRejected(WriteTemp("las_short_header.las", file), "LAS truncated header");
+		}
+		for (uint8_t compressed : { uint8_t(0x80 | 3), uint8_t(0x40 | 3), uint8_t(0xC0 | 7) })
+		{
+			const std::vector<LASPoint> points = MakeLASPoints(5, false);
+			ExpectRejected(WriteTemp("laz.laz", MakeLAS((compressed & 0x3F) >= 6 ? 4 : 2, compressed, 36, points, 5)),
+				"LAZ point format byte " + std::to_string(compressed));
+		}
+		ExpectRejected(WriteTemp("las_format11.las", MakeLAS(4, 11, 40, MakeLASPoints(5, false), 5)), "LAS point format 11");
+		ExpectRejected(WriteTemp("las_short_record.las", MakeLAS(2, 0, 19, MakeLASPoints(5, false), 5)), "LAS 19-byte records");
+	}
+
+	// =========================================================================
+	// PLY
+	// =========================================================================
+
+	std::vector<SourcePoint> MakePoints(size_t count)
+	{
+		std::vector<SourcePoint> points(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const double n = static_cast<double>(i);
+			points[i].X = n * 0.5 - 10.0;
+			points[i].Y = 1000.0 - n * 0.25;
+			points[i].Z = std::fmod(n * 0.125, 7.0);
+			points[i].R = static_cast<uint8_t>(i);
+			points[i].G = static_cast<uint8_t>(255 - i % 256);
+			points[i].B = static_cast<uint8_t>(i * 7);
+		}
+		return points;
+	}
+
+	std::vector<SourcePoint> WithoutColor(std::vector<SourcePoint> points)
+	{
+		for (SourcePoint& p : points) p.R = p.G = p.B = 255;
+		return points;
+	}
+
+	/**
+	 * Binary PLY: float x, a double normal component between the positions
+	 * and the color, then color as uchar or ushort (value * 257).
+	 */
+	std::vector<uint8_t> MakeBinaryPLY(const std::vector<SourcePoint>& points, const char* colorType, size_t declaredCount,
+		bool trailingFaces)
+	{
+		const bool wide = std::strcmp(colorType, "ushort") == 0;
+		Bytes file;
+		file.PutText("ply\nformat binary_little_endian 1.0\ncomment generated\nelement vertex " +
+			std::to_string(declaredCount) + "\nproperty float x\nproperty double y\nproperty float z\nproperty double nx\n");
+		if (*colorType)
+		{
+			file.PutText(std::string("property ") + colorType + " red\nproperty " + colorType + " green\nproperty " +
+				colorType + " blue\n");
+		}
+		file.PutText(trailingFaces ? "element face 1\nproperty list uchar int vertex_indices\nend_header\n" : "end_header\n");
+
+		for (const SourcePoint& p : points)
+		{
+			file.Put(static_cast<float>(p.X));
+			file.Put(p.Y);
+			file.Put(static_cast<float>(p.Z));
+			file.Put(-1.0);
+			if (wide)
+			{
+				file.Put(static_cast<uint16_t>(p.R * 257));
+				file.Put(static_cast<uint16_t>(p.G * 257));
+				file.Put(static_cast<uint16_t>(p.B * 257));
+			}
+			else if (*colorType)
+			{
+				file.Put(p.R);
+				file.Put(p.G);
+				file.Put(p.B);
+			}
+		}
+		if (trailingFaces)
+		{
+			file.Put<uint8_t>(3);
+			for (int32_t index : { 0, 1, 2 }) file.Put(index);
+		}
+		return file.Data;
+	}
+
+	void CheckPLY()
+	{
+		const std::vector<SourcePoint> points = MakePoints(300);
+
+		CheckRead(WriteTemp("binary_uchar.ply", MakeBinaryPLY(points, "uchar", points.size(), false)),
+			points, true, PointSource::Format::PLYBinary, "PLY binary 8-bit color");
+		CheckRead(WriteTemp("binary_ushort.ply", MakeBinaryPLY(points, "ushort", points.size(), true)),
+			points, true, PointSource::Format::PLYBinary, "PLY binary 16-bit color, trailing faces");
+		CheckRead(WriteTemp("binary_plain.ply", MakeBinaryPLY(points, "", points.size(), false)),
+			WithoutColor(points), false, PointSource::Format::PLYBinary, "PLY binary without color");
+
+		// Truncated payload: a declared count past the end keeps the complete records
+		{
+			std::vector<uint8_t> file = MakeBinaryPLY(points, "uchar", points.size(), false);
+			file.resize(file.size() - 27 * 100 - 5);
+			const std::vector<SourcePoint> complete(points.begin(), points.begin() + 199);
+			CheckRead(WriteTemp("binary_truncated.ply", file), complete, true, PointSource::Format::PLYBinary,
+				"PLY binary truncated payload");
+		}
+		CheckRead(WriteTemp("binary_overcount.ply", MakeBinaryPLY(points, "uchar", 100000, false)),
+			points, true, PointSource::Format::PLYBinary, "PLY binary count past the end");
+
+		// ASCII: color as uchar or float, faces after the vertices
+		{
+			const std::vector<SourcePoint> few(points.begin(), points.begin() + 50);
+			std::string text = "ply\r\nformat ascii 1.0\r\nelement vertex 50\r\nproperty double x\r\nproperty double y\r\n"
+				"property double z\r\nproperty uchar red\r\nproperty uchar green\r\nproperty uchar blue\r\nend_header\r\n";
+			for (const SourcePoint& p : few)
+			{
+				text += std::to_string(p.X) + " " + std::to_string(p.Y) + " " + std::to_string(p.Z) + " " +
+					std::to_string(p.R) + " " + std::to_string(p.G) + " " + std::to_string(p.B) + "\r\n";
+			}
+			CheckRead(WriteTemp("ascii_crlf.ply", text), few, true, PointSource::Format::PLYAscii, "PLY ascii CRLF");
+		}
+		{
+			const std::vector<SourcePoint> few(points.begin(), points.begin() + 40);
+			std::string text = "ply\nformat ascii 1.0\nelement vertex 40\nproperty float x\nproperty float y\nproperty float z\n"
+				"element face 3\nproperty list uchar int vertex_indices\nend_header\n";
+			for (const SourcePoint& p : few)
+			{
+				text += std::to_string(p.X) + " " + std::to_string(p.Y) + " " + std::to_string(p.Z) + "\n";
+			}
+			// Face lines have three or more numbers and would otherwise read as points
+			text += "3 0 1 2\n3 2 1 0\n4 0 1 2 3\n";
+			CheckRead(WriteTemp("ascii_faces.ply", text), WithoutColor(few), false, PointSource::Format::PLYAscii,
+				"PLY ascii with faces");
+		}
+		{
+			std::string text = "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+				"property float red\nproperty float green\nproperty float blue\nend_header\n"
+				"0 0 0 0 0.5 1\n1 2 3 1 1 1\n-1 -2 -3 0.25 2 -1\n";
+			std::vector<SourcePoint> expected(3);
+			expected[0] = { 0.0, 0.0, 0.0, 0, 127, 255 };
+			expected[1] = { 1.0, 2.0, 3.0, 255, 255, 255 };
+			expected[2] = { -1.0, -2.0, -3.0, 63, 255, 0 };
+			CheckRead(WriteTemp("ascii_float_color.ply", text), expected, true, PointSource::Format::PLYAscii,
+				"PLY ascii float color");
+		}
+
+		// Rejected inputs
+		ExpectRejected(WriteTemp("big_endian.ply", std::string("ply\nformat binary_big_endian 1.0\nelement vertex 1\n"
+			"property float x\nproperty float y\nproperty float z\nend_header\n")), "PLY big-endian");
+		ExpectRejected(WriteTemp("no_end.ply", std::string("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n")),
+			"PLY without end_header");
+		ExpectRejected(WriteTemp("header_eof.ply", std::string("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+			"property float y\nproperty float z\nend_header")), "PLY ending in the header");
+		ExpectRejected(WriteTemp("no_z.ply", std::string("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+			"property float y\nend_header\n1 2\n")), "PLY without z");
+		ExpectRejected(WriteTemp("faces_first.ply", std::string("ply\nformat ascii 1.0\nelement face 1\n"
+			"property list uchar int vertex_indices\nelement vertex 1\nproperty float x\nproperty float y\n"
+			"property float z\nend_header\n3 0 0 0\n1 2 3\n")), "PLY faces before vertices");
+		ExpectRejected(WriteTemp("list_vertex.ply", std::string("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+			"property float y\nproperty float z\nproperty list uchar float extra\nend_header\n1 2 3 0\n")), "PLY vertex list property");
+	}
+
+	// =========================================================================
+	// XYZ
+	// =========================================================================
+
+	void CheckXYZ()
+	{
+		const std::vector<SourcePoint> points = MakePoints(2000);
+
+		auto line = [](const SourcePoint& p, const char* separator) {
+			return std::to_string(p.X) + separator + std::to_string(p.Y) + separator + std::to_string(p.Z);
+		};
+		auto rgb = [](const SourcePoint& p, const char* separator) {
+			return std::string(separator) + std::to_string(p.R) + separator + std::to_string(p.G) + separator + std::to_string(p.B);
+		};
+
+		{
+			std::string text;
+			for (const SourcePoint& p : points) text += line(p, " ") + "\n";
+			CheckRead(WriteTemp("plain.xyz", text), WithoutColor(points), false, PointSource::Format::XYZ, "XYZ positions");
+		}
+		{
+			std::string text = "// x y z r g b\n";
+			for (const SourcePoint& p : points) text += line(p, "\t") + rgb(p, "\t") + "\n";
+			CheckRead(WriteTemp("color.txt", text), points, true, PointSource::Format::XYZ, "XYZ color");
+		}
+		{
+			// .pts: a count line, then "x y z intensity r g b"
+			std::string text = std::to_string(points.size()) + "\n";
+			for (const SourcePoint& p : points) text += line(p, " ") + " -1204" + rgb(p, " ") + "\r\n";
+			CheckRead(WriteTemp("intensity.pts", text), points, true, PointSource::Format::XYZ, "PTS intensity and color");
+		}
+		{
+			std::string text = "x,y,z\n";
+			for (const SourcePoint& p : points) text += line(p, ",") + "\n";
+			CheckRead(WriteTemp("comma.csv", text), WithoutColor(points), false, PointSource::Format::XYZ, "CSV positions");
+		}
+
+		// Truncated payloads: a cut-off last line is skipped, a complete one without '\n' is kept
+		{
+			std::string text;
+			for (const SourcePoint& p : points) text += line(p, " ") + rgb(p, " ") + "\n";
+			const std::string cut = line(points[0], " ") + " 1 2";
+			CheckRead(WriteTemp("cut.xyz", text + cut), points, true, PointSource::Format::XYZ, "XYZ cut-off last line");
+
+			std::vector<SourcePoint> withLast = points;
+			withLast.push_back(points[5]);
+			CheckRead(WriteTemp("no_newline.xyz", text + line(points[5], " ") + rgb(points[5], " ")), withLast, true,
+				PointSource::Format::XYZ, "XYZ last line without newline");
+		}
+
+		// Rejected inputs
+		ExpectRejected(WriteTemp("words.xyz", std::string("no numbers here\n1 2\n")), "XYZ without positions");
+		ExpectRejected(WriteTemp("empty.xyz", std::string()), "empty XYZ");
+		ExpectRejected(WriteTemp("points.dat", std::string("1 2 3\n")), "unknown extension");
+	}
+}
+
+int main()
+{
+	VizEngine::Log::Init();
+
+	{
+		PointSource source;
+		Check(!source.Open((std::filesystem::temp_directory_path() / "vizengine_pointsource_missing.las").string()),
+			"missing file rejected");
+		Check(ReadAll(source, 4).empty(), "unopened source reads nothing");
+	}
+
+	int failuresBefore = g_Failures;
+	CheckLAS();
+	VP_INFO("LAS: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	failuresBefore = g_Failures;
+	CheckPLY();
+	VP_INFO("PLY: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	failuresBefore = g_Failures;
+	CheckXYZ();
+	VP_INFO("XYZ: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	std::error_code ignored;
+	for (const std::string& path : g_TempFiles) std::filesystem::remove(path, ignored);
+
+	VP_INFO("{} checks, {} failures", g_Checks, g_Failures);
+	return g_Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+// Tests/src/SceneFileTests.cpp
+
+// SceneFile Save -> Open -> Instantiate round trip, and Open() on damaged
+// copies of a saved file: truncated, wrong section strides, section offsets
+// and sizes outside the file, bad magic/version and an unterminated string
+// table must all return nullptr instead of handing out spans past the end.
+//
+// No GL context: SceneFile only stores and compares resource pointers, so
+// meshes, textures and materials are stand-in pointers that are never
+// dereferenced.
+//
+// Exit code 0 when every check passes; registered with CTest.
+
+#include <VizEngine/Log.h>
+#include <VizEngine/Core/Scene.h>
+#include <VizEngine/Core/SceneFile.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace VizEngine;
+using namespace VizEngine::SceneFileFormat;
+
+namespace
+{
+	int g_Failures = 0;
+	int g_Checks = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		g_Checks++;
+		if (!condition)
+		{
+			if (g_Failures < 50) VP_ERROR("FAILED: {}", what);
+			g_Failures++;
+		}
+	}
+
+	/**
+	 * Distinct non-null pointer of type T without constructing a T (which
+	 * would need GL). The aliasing shared_ptr owns a small int instead.
+	 */
+	template<typename T>
+	std::shared_ptr<T> StandIn()
+	{
+		auto storage = std::make_shared<uint64_t>(0);
+		return std::shared_ptr<T>(storage, reinterpret_cast<T*>(storage.get()));
+	}
+
+	std::string TempPath(const std::string& name)
+	{
+		return (std::filesystem::temp_directory_path() / ("vizengine_scenefile_" + name + ".vpscene")).string();
+	}
+
+	std::vector<uint8_t> ReadBytes(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	void WriteBytes(const std::string& path, const std::vector<uint8_t>& bytes)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	bool Equal(const glm::vec3& a, const glm::vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+	bool Equal(const glm::vec4& a, const glm::vec4& b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+
+	struct Fixture
+	{
+		std::shared_ptr<Mesh> Cube = StandIn<Mesh>();
+		std::shared_ptr<Mesh> Sphere = StandIn<Mesh>();
+		std::shared_ptr<Mesh> Unregistered = StandIn<Mesh>();
+		std::shared_ptr<Texture> Bricks = StandIn<Texture>();
+		std::shared_ptr<Texture> UnregisteredTexture = StandIn<Texture>();
+		std::shared_ptr<RenderMaterial> Gold = StandIn<RenderMaterial>();
+
+		SceneAssetTable Assets;
+		Scene Source;
+		SceneEnvironment Environment;
+
+		Fixture()
+		{
+			Assets.Register("cube", Cube);
+			Assets.Register("sphere", Sphere);
+			Assets.Register("bricks", Bricks);
+			Assets.Register("gold", Gold);
+
+			for (int i = 0; i < 5; i++)
+			{
+				SceneObject& obj = Source.Add(i % 2 == 0 ? Cube : Sphere, "Object " + std::to_string(i));
+				float f = static_cast<float>(i);
+				obj.ObjectTransform.Position = glm::vec3(f, -f, 0.5f * f);
+				obj.ObjectTransform.Rotation = glm::vec3(0.1f * f, 0.2f, -0.3f);
+				obj.ObjectTransform.Scale = glm::vec3(1.0f + f, 2.0f, 0.25f);
+				obj.Color = glm::vec4(0.1f * f, 0.2f, 0.3f, 1.0f - 0.1f * f);
+				obj.Roughness = 0.05f * f;
+				obj.Metallic = 1.0f - 0.05f * f;
+				obj.Active = i != 3;
+				obj.LowResolution = i == 4;
+			}
+			Source[1].TexturePtr = Bricks;
+			Source[2].TexturePtr = UnregisteredTexture;   // Saved as no texture
+			Source[3].MaterialRef = Gold;
+			Source[4].Name = "Object 0";                  // Shares a string with object 0
+
+			// Skipped on save: its mesh is not in the table
+			Source.Add(Unregistered, "Dropped");
+
+			Environment.HasSun = false;
+			Environment.Sun.Direction = glm::vec3(0.0f, -1.0f, 0.5f);
+			Environment.Sun.Diffuse = glm::vec3(1.0f, 0.9f, 0.8f);
+			Environment.PointLights.emplace_back(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(1.0f, 0.5f, 0.25f));
+			Environment.PointLights.emplace_back(glm::vec3(-4.0f, 5.0f, -6.0f));
+			Environment.PointLights.back().Quadratic = 0.5f;
+			Environment.EnvironmentMap = "textures/sky.hdr";
+			Environment.UseIBL = false;
+			Environment.IBLIntensity = 2.5f;
+			Environment.LowerHemisphereColor = glm::vec3(0.3f, 0.2f, 0.1f);
+			Environment.LowerHemisphereIntensity = 0.75f;
+			Environment.ClearColor = glm::vec4(0.0f, 0.5f, 1.0f, 1.0f);
+		}
+	};
+
+	// =========================================================================
+	// Round trip
+	// =========================================================================
+
+	void CheckObject(const SceneObject& loaded, const SceneObject& saved, const std::string& what)
+	{
+		Check(loaded.MeshPtr == saved.MeshPtr, what + " mesh");
+		Check(loaded.Name == saved.Name, what + " name");
+		Check(Equal(loaded.ObjectTransform.Position, saved.ObjectTransform.Position) &&
+			Equal(loaded.ObjectTransform.Rotation, saved.ObjectTransform.Rotation) &&
+			Equal(loaded.ObjectTransform.Scale, saved.ObjectTransform.Scale), what + " transform");
+		Check(Equal(loaded.Color, saved.Color), what + " color");
+		Check(loaded.Roughness == saved.Roughness && loaded.Metallic == saved.Metallic, what + " roughness/metallic");
+		Check(loaded.MaterialRef == saved.MaterialRef, what + " material");
+		Check(loaded.Active == saved.Active && loaded.LowResolution == saved.LowResolution, what + " flags");
+	}
+
+	void CheckRoundTrip(const Fixture& fixture, const std::string& path)
+	{
+		Check(SceneFile::Save(path, fixture.Source, fixture.Environment, fixture.Assets), "Save");
+
+		std::unique_ptr<SceneFile> file = SceneFile::Open(path);
+		Check(file != nullptr, "Open saved file");
+		if (!file) return;
+
+		Check(file->GetObjects().size() == 5, "object records (unregistered mesh skipped)");
+		Check(file->GetMeshNames().size() == 2, "mesh names");
+		Check(file->GetTextureNames().size() == 1, "texture names (unregistered texture not saved)");
+		Check(file->GetMaterialNames().size() == 1, "material names");
+		Check(file->GetObjects().size() == 5 && file->GetObjects()[0].Name == file->GetObjects()[4].Name,
+			"duplicate names share one string");
+		Check(std::strcmp(file->GetString(0xFFFFFFF0u), "") == 0, "out-of-range string offset");
+
+		Scene loaded;
+		Check(file->Instantiate(loaded, fixture.Assets) == 5, "Instantiate count");
+		Check(loaded.Size() == 5, "Instantiate scene size");
+		for (size_t i = 0; i < 5 && i < loaded.Size(); i++)
+		{
+			CheckObject(loaded[i], fixture.Source[i], "object " + std::to_string(i));
+		}
+		if (loaded.Size() == 5)
+		{
+			Check(loaded[1].TexturePtr == fixture.Bricks, "registered texture");
+			Check(loaded[0].TexturePtr == nullptr && loaded[2].TexturePtr == nullptr, "missing textures are none");
+		}
+
+		// Instantiate appends and resolves names against the table it is given
+		SceneAssetTable partial;
+		partial.Register("sphere", fixture.Sphere);
+		Check(file->Instantiate(loaded, partial) == 2, "Instantiate with unresolved mesh skips its objects");
+		Check(loaded.Size() == 7, "Instantiate appends");
+		if (loaded.Size() == 7)
+		{
+			Check(loaded[5].MeshPtr == fixture.Sphere && loaded[6].MeshPtr == fixture.Sphere, "partial table meshes");
+			Check(loaded[5].TexturePtr == nullptr && loaded[6].MaterialRef == nullptr, "partial table textures/materials");
+		}
+
+		const SceneEnvironment& saved = fixture.Environment;
+		SceneEnvironment env = file->ReadEnvironment();
+		Check(env.HasSun == saved.HasSun && env.UseIBL == saved.UseIBL, "environment flags");
+		Check(Equal(env.Sun.Direction, saved.Sun.Direction) && Equal(env.Sun.Ambient, saved.Sun.Ambient) &&
+			Equal(env.Sun.Diffuse, saved.Sun.Diffuse) && Equal(env.Sun.Specular, saved.Sun.Specular), "sun");
+		Check(env.EnvironmentMap == saved.EnvironmentMap, "environment map");
+		Check(env.IBLIntensity == saved.IBLIntensity, "IBL intensity");
+		Check(Equal(env.LowerHemisphereColor, saved.LowerHemisphereColor) &&
+			env.LowerHemisphereIntensity == saved.LowerHemisphereIntensity, "lower hemisphere");
+		Check(Equal(env.ClearColor, saved.ClearColor), "clear color");
+		Check(env.PointLights.size() == saved.PointLights.size(), "point light count");
+		for (size_t i = 0; i < env.PointLights.size() && i < saved.PointLights.size(); i++)
+		{
+			const PointLight& a = env.PointLights[i];
+			const PointLight& b = saved.PointLights[i];
+			Check(Equal(a.Position, b.Position) && Equal(a.Ambient, b.Ambient) && Equal(a.Diffuse, b.Diffuse) &&
+				Equal(a.Specular, b.Specular) && a.Constant == b.Constant && a.Linear == b.Linear &&
+				a.Quadratic == b.Quadratic, "point light " + std::to_string(i));
+		}
+	}
+
+	void CheckEmptyScene(const std::string& path)
+	{
+		Scene empty;
+		SceneEnvironment environment;
+		SceneAssetTable assets;
+		Check(SceneFile::Save(path, empty, environment, assets), "Save empty scene");
+
+		std::unique_ptr<SceneFile> file = SceneFile::Open(path);
+		Check(file != nullptr, "Open empty scene");
+		if (!file) return;
+
+		Scene loaded;
+		Check(file->Instantiate(loaded, assets) == 0 && loaded.Size() == 0, "Instantiate empty scene");
+		Check(file->GetObjects().empty() && file->GetPointLights().empty(), "empty sections");
+		Check(file->ReadEnvironment().EnvironmentMap.empty(), "empty environment map");
+	}
+
+	// =========================================================================
+	// Malformed files
+	// =========================================================================
+
+	Header ReadHeader(const std::vector<uint8_t>& bytes)
+	{
+		Header header;
+		std::memcpy(&header, bytes.data(), sizeof(Header));
+		return header;
+	}
+
+	std::vector<uint8_t> WithHeader(std::vector<uint8_t> bytes, const Header& header)
+	{
+		std::memcpy(bytes.data(), &header, sizeof(Header));
+		return bytes;
+	}
+
+	void ExpectRejected(const std::string& path, const std::vector<uint8_t>& bytes, const std::string& what)
+	{
+		WriteBytes(path, bytes);
+		Check(SceneFile::Open(path) == nullptr, what + " rejected");
+	}
+
+	void CheckMalformed(const std::string& savedPath, const std::string& path)
+	{
+		const std::vector<uint8_t> good = ReadBytes(savedPath);
+		Check(good.size() > sizeof(Header), "saved file size");
+		if (good.size() <= sizeof(Header)) return;
+
+		// The rewrite itself must not be what makes Open() fail
+		WriteBytes(path, good);
+		Check(SceneFile::Open(path) != nullptr, "unmodified copy opens");
+
+		Check(SceneFile::Open(TempPath("missing")) == nullptr, "missing file rejected");
+
+		// Truncated
+		const size_t truncatedSizes[] = { 0, 1, sizeof(Header) - 1, sizeof(Header), good.size() / 2, good.size() - 1 };
+		for (size_t size : truncatedSizes)
+		{
+			ExpectRejected(path, std::vector<uint8_t>(good.begin(), good.begin() + static_cast<std::ptrdiff_t>(size)),
+				"truncated to " + std::to_string(size) + " bytes");
+		}
+		std::vector<uint8_t> extended = good;
+		extended.resize(good.size() + Alignment, 0);
+		ExpectRejected(path, extended, "trailing bytes");
+
+		const Header header = ReadHeader(good);
+		auto objects = [](Header& h) -> SectionEntry& { return h.Sections[static_cast<size_t>(Section::Objects)]; };
+		auto meshes = [](Header& h) -> SectionEntry& { return h.Sections[static_cast<size_t>(Section::Meshes)]; };
+		auto strings = [](Header& h) -> SectionEntry& { return h.Sections[static_cast<size_t>(Section::Strings)]; };
+
+		// Header fields
+		{
+			Header h = header;
+			h.Magic ^= 1u;
+			ExpectRejected(path, WithHeader(good, h), "bad magic");
+		}
+		{
+			Header h = header;
+			h.Version = Version + 1;
+			ExpectRejected(path, WithHeader(good, h), "newer version");
+		}
+		{
+			Header h = header;
+			h.SectionCount--;
+			ExpectRejected(path, WithHeader(good, h), "section count");
+		}
+
+		// Wrong stride: a writer with a different record layout. Offset, Size
+		// and Count stay valid, so only the stride check can reject these.
+		const uint32_t objectStrides[] = { sizeof(ObjectRecord) - 4, sizeof(ObjectRecord) + 16, 0 };
+		for (uint32_t stride : objectStrides)
+		{
+			Header h = header;
+			objects(h).Stride = stride;
+			ExpectRejected(path, WithHeader(good, h), "object stride " + std::to_string(stride));
+		}
+		{
+			Header h = header;
+			meshes(h).Stride = sizeof(uint64_t);
+			ExpectRejected(path, WithHeader(good, h), "mesh name stride");
+		}
+
+		// Records reinterpreted with a different stride but a matching size
+		{
+			Header h = header;
+			meshes(h).Stride = sizeof(uint64_t);
+			meshes(h).Count /= 2;
+			ExpectRejected(path, WithHeader(good, h), "mesh names as 64-bit records");
+		}
+
+		// Size and count disagree
+		{
+			Header h = header;
+			objects(h).Count++;
+			ExpectRejected(path, WithHeader(good, h), "object count past size");
+		}
+		{
+			Header h = header;
+			objects(h).Size += sizeof(ObjectRecord);
+			ExpectRejected(path, WithHeader(good, h), "object size past count");
+		}
+
+		// Bad offsets: misaligned, past the end, overlapping the end, near 2^64
+		const uint64_t fileSize = good.size();
+		const uint64_t badOffsets[] = {
+			header.Sections[static_cast<size_t>(Section::Objects)].Offset + 2,
+			fileSize,
+			fileSize - sizeof(ObjectRecord),
+			~uint64_t(0) - (Alignment - 1),
+		};
+		for (uint64_t offset : badOffsets)
+		{
+			Header h = header;
+			objects(h).Offset = offset;
+			ExpectRejected(path, WithHeader(good, h), "object offset " + std::to_string(offset));
+		}
+
+		// Every string must be NUL-terminated inside the blob
+		{
+			Header h = header;
+			std::vector<uint8_t> bytes = good;
+			bytes[static_cast<size_t>(strings(h).Offset + strings(h).Size - 1)] = 'x';
+			ExpectRejected(path, bytes, "unterminated string table");
+		}
+		{
+			Header h = header;
+			strings(h).Count = 0;
+			strings(h).Size = 0;
+			ExpectRejected(path, WithHeader(good, h), "empty string table");
+		}
+	}
+}
+
+int main()
+{
+	VizEngine::Log::Init();
+
+	const std::string savedPath = TempPath("saved");
+	const std::string damagedPath = TempPath("damaged");
+
+	int failuresBefore = g_Failures;
+	Fixture fixture;
+	CheckRoundTrip(fixture, savedPath);
+	CheckEmptyScene(damagedPath);
+	VP_INFO("Round trip: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	failuresBefore = g_Failures;
+	CheckMalformed(savedPath, damagedPath);
+	VP_INFO("Malformed files: {}", g_Failures == failuresBefore ? "passed" : "FAILED");
+
+	std::error_code ignored;
+	std::filesystem::remove(savedPath, ignored);
+	std::filesystem::remove(damagedPath, ignored);
+
+	VP_INFO("{} checks, {} failures", g_Checks, g_Failures);
+	return g_Failures == 0 ? 0 : 1;
+}
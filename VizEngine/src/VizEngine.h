@@ -19,8 +19,21 @@
 #include "VizEngine/OpenGL/Framebuffer.h"
 #include "VizEngine/OpenGL/FullscreenQuad.h"
 #include "VizEngine/OpenGL/CubemapUtils.h"
+#include "VizEngine/OpenGL/HDRTextureCodec.h"
 #include "VizEngine/Renderer/Skybox.h"
 #include "VizEngine/Renderer/Bloom.h"
+#include "VizEngine/Renderer/SceneRenderList.h"
+#include "VizEngine/Renderer/RenderViewSet.h"
+#include "VizEngine/Renderer/OverdrawAnalyzer.h"
+#include "VizEngine/Renderer/RegressionHarness.h"
+#include "VizEngine/Renderer/Scalability.h"
+#include "VizEngine/Renderer/RenderService.h"
+#include "VizEngine/Renderer/Downsampler.h"
+#include "VizEngine/Renderer/VisibilityBuffer.h"
+#include "VizEngine/Renderer/LowResolutionPass.h"
+#include "VizEngine/Renderer/VirtualShadowMap.h"
+#include "VizEngine/Renderer/PointCloud.h"
+#include "VizEngine/Renderer/VolumeRenderer.h"
 
 // Material System (Chapter 38)
 #include "VizEngine/Renderer/MaterialParameter.h"
@@ -29,10 +42,23 @@
 #include "VizEngine/Renderer/UnlitMaterial.h"
 #include "VizEngine/Renderer/MaterialFactory.h"
 
+// Material batching (texture array pools, shared samplers)
+#include "VizEngine/OpenGL/TextureArray.h"
+#include "VizEngine/OpenGL/Sampler.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/Renderer/MaterialTexturePacker.h"
+
+// GL command capture and replay
+#include "VizEngine/OpenGL/GLCapture.h"
+#include "VizEngine/OpenGL/GLReplay.h"
+
 // Core types
 #include "VizEngine/Core/Camera.h"
 #include "VizEngine/Core/Transform.h"
 #include "VizEngine/Core/Scene.h"
+#include "VizEngine/Core/Handle.h"
+#include "VizEngine/Core/ResourceManager.h"
+#include "VizEngine/Core/Profiler.h"
 #include "VizEngine/Core/Mesh.h"
 #include "VizEngine/Core/Light.h"
 #include "VizEngine/Core/Input.h"
@@ -40,6 +66,13 @@
 // Asset loading
 #include "VizEngine/Core/Model.h"
 #include "VizEngine/Core/Material.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/SceneFile.h"
+#include "VizEngine/Core/Prefab.h"
+#include "VizEngine/Core/BatchMath.h"
+#include "VizEngine/Core/MeshBVH.h"
+#include "VizEngine/Core/MetricsExporter.h"
+#include "VizEngine/Core/PointCloudFile.h"
 
 // Events (for event-driven applications)
 #include "VizEngine/Events/Event.h"
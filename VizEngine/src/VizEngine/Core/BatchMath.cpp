@@ -0,0 +1,341 @@
+// VizEngine/src/VizEngine/Core/BatchMath.cpp
+
+#include "BatchMath.h"
+#include "BatchMathKernels.h"
+#include "VizEngine/Log.h"
+
+#include <atomic>
+
+#if VP_BATCHMATH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace
+		{
+			using Detail::KernelTable;
+			using Detail::StreamIn;
+			using Detail::StreamOut;
+
+			// =================================================================
+			// CPU feature detection
+			// =================================================================
+
+#if VP_BATCHMATH_X86
+			void Cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+			{
+#if defined(_MSC_VER)
+				int r[4];
+				__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+				for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned int>(r[i]);
+#else
+				__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+			}
+
+			uint64_t ReadXCR0()
+			{
+#if defined(_MSC_VER)
+				return _xgetbv(0);
+#else
+				unsigned int lo = 0, hi = 0;
+				__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+				return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+			}
+#endif
+
+			SimdISA DetectISA()
+			{
+#if VP_BATCHMATH_X86
+				unsigned int regs[4] = {};
+				Cpuid(0, 0, regs);
+				unsigned int maxLeaf = regs[0];
+				if (maxLeaf < 1) return SimdISA::Scalar;
+
+				Cpuid(1, 0, regs);
+				const unsigned int ecx1 = regs[2];
+				const bool sse42 = (ecx1 & (1u << 20)) != 0;
+				const bool fma = (ecx1 & (1u << 12)) != 0;
+				const bool osxsave = (ecx1 & (1u << 27)) != 0;
+				const bool avx = (ecx1 & (1u << 28)) != 0;
+
+				if (!sse42) return SimdISA::Scalar;
+
+				// The OS must save the wider registers on context switches
+				uint64_t xcr0 = osxsave ? ReadXCR0() : 0;
+				const bool ymmState = (xcr0 & 0x6) == 0x6;     // XMM + YMM
+				const bool zmmState = (xcr0 & 0xE6) == 0xE6;   // + opmask, ZMM0-15 upper, ZMM16-31
+
+				bool avx2 = false;
+				bool avx512 = false;
+				if (maxLeaf >= 7)
+				{
+					Cpuid(7, 0, regs);
+					avx2 = (regs[1] & (1u << 5)) != 0;
+					avx512 = (regs[1] & (1u << 16)) != 0;
+				}
+
+				if (avx && avx512 && fma && zmmState) return SimdISA::AVX512;
+				if (avx && avx2 && fma && ymmState) return SimdISA::AVX2;
+				return SimdISA::SSE42;
+#else
+				return SimdISA::Scalar;
+#endif
+			}
+
+			// =================================================================
+			// Dispatch
+			// =================================================================
+
+			const KernelTable* KernelsFor(SimdISA isa)
+			{
+				// Only reached for ISAs the CPU supports: the getters initialize
+				// their tables with code built for that instruction set
+				switch (isa)
+				{
+				case SimdISA::AVX512: return Detail::GetAVX512Kernels();
+				case SimdISA::AVX2:   return Detail::GetAVX2Kernels();
+				case SimdISA::SSE42:  return Detail::GetSSE42Kernels();
+				default:              return &Detail::GetScalarKernels();
+				}
+			}
+
+			struct Dispatch
+			{
+				SimdISA Detected = SimdISA::Scalar;
+				std::atomic<SimdISA> Active{ SimdISA::Scalar };
+				std::atomic<const KernelTable*> Kernels{ nullptr };
+
+				Dispatch()
+				{
+					Detected = DetectISA();
+
+					// Fall back past any ISA this build does not include
+					SimdISA isa = Detected;
+					const KernelTable* kernels = KernelsFor(isa);
+					while (!kernels)
+					{
+						isa = static_cast<SimdISA>(static_cast<int>(isa) - 1);
+						kernels = KernelsFor(isa);
+					}
+					Active = isa;
+					Kernels = kernels;
+
+					VP_CORE_INFO("BatchMath: detected {}, using {} kernels", GetISAName(Detected), GetISAName(isa));
+				}
+			};
+
+			Dispatch& GetDispatch()
+			{
+				static Dispatch dispatch;
+				return dispatch;
+			}
+
+			const KernelTable& K()
+			{
+				return *GetDispatch().Kernels.load(std::memory_order_acquire);
+			}
+
+			// =================================================================
+			// Stream views
+			// =================================================================
+
+			StreamIn In(const Vec3Stream& s) { StreamIn v; v.C[0] = s.X.data(); v.C[1] = s.Y.data(); v.C[2] = s.Z.data(); return v; }
+			StreamOut Out(Vec3Stream& s) { StreamOut v; v.C[0] = s.X.data(); v.C[1] = s.Y.data(); v.C[2] = s.Z.data(); return v; }
+
+			StreamIn In(const Vec4Stream& s)
+			{
+				StreamIn v;
+				v.C[0] = s.X.data(); v.C[1] = s.Y.data(); v.C[2] = s.Z.data(); v.C[3] = s.W.data();
+				return v;
+			}
+
+			StreamOut Out(Vec4Stream& s)
+			{
+				StreamOut v;
+				v.C[0] = s.X.data(); v.C[1] = s.Y.data(); v.C[2] = s.Z.data(); v.C[3] = s.W.data();
+				return v;
+			}
+
+			StreamIn In(const Mat4Stream& s)
+			{
+				StreamIn v;
+				for (int e = 0; e < 16; e++) v.C[e] = s.M[e].data();
+				return v;
+			}
+
+			StreamOut Out(Mat4Stream& s)
+			{
+				StreamOut v;
+				for (int e = 0; e < 16; e++) v.C[e] = s.M[e].data();
+				return v;
+			}
+
+			bool SameSize(size_t a, size_t b, const char* function)
+			{
+				if (a == b) return true;
+				VP_CORE_ERROR("BatchMath::{}: stream sizes differ ({} vs {})", function, a, b);
+				return false;
+			}
+		}
+
+		namespace Detail
+		{
+			const KernelTable& GetActiveKernels()
+			{
+				return K();
+			}
+		}
+
+		SimdISA GetDetectedISA()
+		{
+			return GetDispatch().Detected;
+		}
+
+		SimdISA GetActiveISA()
+		{
+			return GetDispatch().Active.load(std::memory_order_acquire);
+		}
+
+		bool SetActiveISA(SimdISA isa)
+		{
+			Dispatch& dispatch = GetDispatch();
+			if (static_cast<int>(isa) > static_cast<int>(dispatch.Detected))
+			{
+				VP_CORE_WARN("BatchMath: {} is not supported on this CPU", GetISAName(isa));
+				return false;
+			}
+
+			const KernelTable* kernels = KernelsFor(isa);
+			if (!kernels)
+			{
+				VP_CORE_WARN("BatchMath: {} kernels are not part of this build", GetISAName(isa));
+				return false;
+			}
+
+			dispatch.Kernels.store(kernels, std::memory_order_release);
+			dispatch.Active.store(isa, std::memory_order_release);
+			return true;
+		}
+
+		const char* GetISAName(SimdISA isa)
+		{
+			switch (isa)
+			{
+			case SimdISA::SSE42:  return "SSE4.2";
+			case SimdISA::AVX2:   return "AVX2";
+			case SimdISA::AVX512: return "AVX-512";
+			default:              return "Scalar";
+			}
+		}
+
+		int GetLaneCount(SimdISA isa)
+		{
+			switch (isa)
+			{
+			case SimdISA::SSE42:  return 4;
+			case SimdISA::AVX2:   return 8;
+			case SimdISA::AVX512: return 16;
+			default:              return 1;
+			}
+		}
+
+		// =====================================================================
+		// Transforms
+		// =====================================================================
+
+		void TransformPoints(const glm::mat4& matrix, const Vec3Stream& points, Vec3Stream& out)
+		{
+			out.Resize(points.Size());
+			K().TransformPoints(&matrix[0][0], In(points), Out(out), points.Size());
+		}
+
+		void MultiplyMatrices(const Mat4Stream& a, const Mat4Stream& b, Mat4Stream& out)
+		{
+			if (!SameSize(a.Size(), b.Size(), "MultiplyMatrices")) return;
+			out.Resize(a.Size());
+			K().MultiplyMatrices(In(a), In(b), Out(out), a.Size());
+		}
+
+		void MultiplyMatrices(const glm::mat4& parent, const Mat4Stream& local, Mat4Stream& out)
+		{
+			out.Resize(local.Size());
+			K().MultiplyByMatrix(&parent[0][0], In(local), Out(out), local.Size());
+		}
+
+		void ComposeTransforms(const Vec3Stream& position, const Vec3Stream& rotation,
+			const Vec3Stream& scale, Mat4Stream& out)
+		{
+			if (!SameSize(position.Size(), rotation.Size(), "ComposeTransforms") ||
+				!SameSize(position.Size(), scale.Size(), "ComposeTransforms"))
+			{
+				return;
+			}
+			out.Resize(position.Size());
+			K().ComposeTransforms(In(position), In(rotation), In(scale), Out(out), position.Size());
+		}
+
+		// =====================================================================
+		// Rotations
+		// =====================================================================
+
+		void EulerToQuaternions(const Vec3Stream& euler, Vec4Stream& out)
+		{
+			out.Resize(euler.Size());
+			K().EulerToQuaternions(In(euler), Out(out), euler.Size());
+		}
+
+		void QuaternionsToEuler(const Vec4Stream& quaternions, Vec3Stream& out)
+		{
+			out.Resize(quaternions.Size());
+			K().QuaternionsToEuler(In(quaternions), Out(out), quaternions.Size());
+		}
+
+		// =====================================================================
+		// Frustum tests
+		// =====================================================================
+
+		FrustumPlanes ExtractFrustumPlanes(const glm::mat4& m)
+		{
+			glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+			glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+			glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+			glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+			FrustumPlanes frustum = { {
+				row3 + row0, row3 - row0,   // Left, right
+				row3 + row1, row3 - row1,   // Bottom, top
+				row3 + row2, row3 - row2    // Near, far
+			} };
+			for (glm::vec4& plane : frustum.Planes)
+			{
+				plane /= glm::length(glm::vec3(plane));
+			}
+			return frustum;
+		}
+
+		size_t CullSpheres(const FrustumPlanes& frustum, const Vec3Stream& centers,
+			const std::vector<float>& radii, std::vector<uint8_t>& visible)
+		{
+			if (!SameSize(centers.Size(), radii.size(), "CullSpheres")) return 0;
+			visible.resize(centers.Size());
+			return K().CullSpheres(&frustum.Planes[0][0], In(centers), radii.data(), visible.data(), centers.Size());
+		}
+
+		size_t CullBoxes(const FrustumPlanes& frustum, const Vec3Stream& centers,
+			const Vec3Stream& extents, std::vector<uint8_t>& visible)
+		{
+			if (!SameSize(centers.Size(), extents.Size(), "CullBoxes")) return 0;
+			visible.resize(centers.Size());
+			return K().CullBoxes(&frustum.Planes[0][0], In(centers), In(extents), visible.data(), centers.Size());
+		}
+	}
+}
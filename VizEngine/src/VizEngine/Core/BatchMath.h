@@ -0,0 +1,207 @@
+// VizEngine/src/VizEngine/Core/BatchMath.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include "gtc/quaternion.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Instruction sets the batch kernels are built for, in preference order.
+	 */
+	enum class SimdISA : uint8_t
+	{
+		Scalar,    // Reference implementation, always available
+		SSE42,     // 4 lanes
+		AVX2,      // 8 lanes with FMA
+		AVX512     // 16 lanes (AVX-512F)
+	};
+
+	/**
+	 * Structure-of-arrays vec3 stream: one contiguous array per component,
+	 * so a kernel loads 4/8/16 objects' X values with a single instruction.
+	 */
+	struct VizEngine_API Vec3Stream
+	{
+		std::vector<float> X, Y, Z;
+
+		void Resize(size_t count) { X.resize(count); Y.resize(count); Z.resize(count); }
+		void Clear() { X.clear(); Y.clear(); Z.clear(); }
+		size_t Size() const { return X.size(); }
+
+		void Set(size_t i, const glm::vec3& v) { X[i] = v.x; Y[i] = v.y; Z[i] = v.z; }
+		glm::vec3 Get(size_t i) const { return glm::vec3(X[i], Y[i], Z[i]); }
+		void Push(const glm::vec3& v) { X.push_back(v.x); Y.push_back(v.y); Z.push_back(v.z); }
+	};
+
+	/**
+	 * Structure-of-arrays vec4 stream. Quaternions are stored (x, y, z, w).
+	 */
+	struct VizEngine_API Vec4Stream
+	{
+		std::vector<float> X, Y, Z, W;
+
+		void Resize(size_t count) { X.resize(count); Y.resize(count); Z.resize(count); W.resize(count); }
+		void Clear() { X.clear(); Y.clear(); Z.clear(); W.clear(); }
+		size_t Size() const { return X.size(); }
+
+		void Set(size_t i, const glm::vec4& v) { X[i] = v.x; Y[i] = v.y; Z[i] = v.z; W[i] = v.w; }
+		glm::vec4 Get(size_t i) const { return glm::vec4(X[i], Y[i], Z[i], W[i]); }
+
+		void SetQuat(size_t i, const glm::quat& q) { X[i] = q.x; Y[i] = q.y; Z[i] = q.z; W[i] = q.w; }
+		glm::quat GetQuat(size_t i) const { return glm::quat(W[i], X[i], Y[i], Z[i]); }
+	};
+
+	/**
+	 * Structure-of-arrays mat4 stream. Element [c * 4 + r] holds column c,
+	 * row r of every matrix (glm's column-major order).
+	 */
+	struct VizEngine_API Mat4Stream
+	{
+		std::vector<float> M[16];
+
+		void Resize(size_t count) { for (auto& e : M) e.resize(count); }
+		void Clear() { for (auto& e : M) e.clear(); }
+		size_t Size() const { return M[0].size(); }
+
+		void Set(size_t i, const glm::mat4& m)
+		{
+			for (int c = 0; c < 4; c++)
+				for (int r = 0; r < 4; r++)
+					M[c * 4 + r][i] = m[c][r];
+		}
+
+		glm::mat4 Get(size_t i) const
+		{
+			glm::mat4 m;
+			for (int c = 0; c < 4; c++)
+				for (int r = 0; r < 4; r++)
+					m[c][r] = M[c * 4 + r][i];
+			return m;
+		}
+	};
+
+	/**
+	 * Six normalized planes (xyz = inward normal, w = distance):
+	 * left, right, bottom, top, near, far.
+	 */
+	struct FrustumPlanes
+	{
+		glm::vec4 Planes[6];
+	};
+
+	/**
+	 * Batched math over SoA streams with runtime instruction-set dispatch.
+	 *
+	 * The best kernel set the CPU and OS support is picked on first use
+	 * (CPUID leaf 1/7 plus XGETBV for the AVX/AVX-512 register state), so one
+	 * binary runs everywhere and uses 16-wide AVX-512 where it can. Each call
+	 * processes a whole stream: engine systems gather thousands of objects
+	 * into streams once per frame instead of calling glm per object.
+	 *
+	 * The scalar kernels are the reference the SIMD kernels are checked
+	 * against; SetActiveISA(SimdISA::Scalar) forces them for comparisons.
+	 * SIMD sin/cos/atan2 are polynomial approximations (about 1e-6 absolute
+	 * error for angles within a few thousand radians); the scalar path uses
+	 * the C library. Stream tails shorter than a vector run the scalar path.
+	 *
+	 * Euler angles follow Transform: radians, applied as Rx * Ry * Rz, so
+	 * ComposeTransforms() matches Transform::GetModelMatrix().
+	 *
+	 * Usage:
+	 *   Vec3Stream position, rotation, scale;   // Filled from the scene
+	 *   Mat4Stream models;
+	 *   BatchMath::ComposeTransforms(position, rotation, scale, models);
+	 *   std::vector<uint8_t> visible;
+	 *   BatchMath::CullSpheres(BatchMath::ExtractFrustumPlanes(viewProj), centers, radii, visible);
+	 */
+	namespace BatchMath
+	{
+		/** @return Best instruction set this CPU and OS support */
+		VizEngine_API SimdISA GetDetectedISA();
+
+		/** @return Instruction set the kernels currently run with */
+		VizEngine_API SimdISA GetActiveISA();
+
+		/**
+		 * Override the dispatch (benchmarks, reference comparisons).
+		 * @return false if the ISA is not supported or not compiled in
+		 */
+		VizEngine_API bool SetActiveISA(SimdISA isa);
+
+		VizEngine_API const char* GetISAName(SimdISA isa);
+
+		/** @return Floats per vector of an instruction set (1 for Scalar) */
+		VizEngine_API int GetLaneCount(SimdISA isa);
+
+		// =====================================================================
+		// Transforms
+		// =====================================================================
+
+		/**
+		 * out[i] = matrix * (points[i], 1), without a perspective divide.
+		 */
+		VizEngine_API void TransformPoints(const glm::mat4& matrix, const Vec3Stream& points, Vec3Stream& out);
+
+		/**
+		 * out[i] = a[i] * b[i]. Streams must have the same size; out may alias neither.
+		 */
+		VizEngine_API void MultiplyMatrices(const Mat4Stream& a, const Mat4Stream& b, Mat4Stream& out);
+
+		/**
+		 * out[i] = parent * local[i] (children of one parent, instanced sets).
+		 */
+		VizEngine_API void MultiplyMatrices(const glm::mat4& parent, const Mat4Stream& local, Mat4Stream& out);
+
+		/**
+		 * Model matrices from translation, Euler rotation (radians) and scale,
+		 * identical to Transform::GetModelMatrix().
+		 */
+		VizEngine_API void ComposeTransforms(const Vec3Stream& position, const Vec3Stream& rotation,
+			const Vec3Stream& scale, Mat4Stream& out);
+
+		// =====================================================================
+		// Rotations
+		// =====================================================================
+
+		/**
+		 * Unit quaternions equal to Rx(e.x) * Ry(e.y) * Rz(e.z).
+		 */
+		VizEngine_API void EulerToQuaternions(const Vec3Stream& euler, Vec4Stream& out);
+
+		/**
+		 * Inverse of EulerToQuaternions(); y is in [-pi/2, pi/2]. At gimbal
+		 * lock (|y| = pi/2) z is 0 and x carries the combined rotation.
+		 * Quaternions must be normalized.
+		 */
+		VizEngine_API void QuaternionsToEuler(const Vec4Stream& quaternions, Vec3Stream& out);
+
+		// =====================================================================
+		// Frustum tests
+		// =====================================================================
+
+		/**
+		 * Gribb/Hartmann planes of a view-projection matrix, normalized.
+		 */
+		VizEngine_API FrustumPlanes ExtractFrustumPlanes(const glm::mat4& viewProjection);
+
+		/**
+		 * visible[i] = 1 if sphere i is not fully outside any plane, else 0.
+		 * @return Number of visible spheres
+		 */
+		VizEngine_API size_t CullSpheres(const FrustumPlanes& frustum, const Vec3Stream& centers,
+			const std::vector<float>& radii, std::vector<uint8_t>& visible);
+
+		/**
+		 * Same test for axis-aligned boxes given as center and half extents.
+		 * @return Number of visible boxes
+		 */
+		VizEngine_API size_t CullBoxes(const FrustumPlanes& frustum, const Vec3Stream& centers,
+			const Vec3Stream& extents, std::vector<uint8_t>& visible);
+	}
+}
@@ -0,0 +1,77 @@
+// VizEngine/src/VizEngine/Core/BatchMathAVX2.cpp
+
+// 8-wide kernels with fused multiply-add. Built with -mavx2 -mfma
+// (/arch:AVX2 on MSVC); only called after CPUID and XGETBV report AVX2,
+// FMA and OS-saved YMM state.
+
+#include "BatchMathKernels.h"
+
+#if VP_BATCHMATH_X86
+#include <immintrin.h>
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			namespace
+			{
+				struct Avx2
+				{
+					using V = __m256;
+					using M = __m256;
+					static constexpr size_t Width = 8;
+
+					static V Load(const float* p) { return _mm256_loadu_ps(p); }
+					static V LoadBytes(const uint8_t* p) { return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)))); }
+					static void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+					static V Set(float f) { return _mm256_set1_ps(f); }
+
+					static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+					static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+					static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+					static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+					static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+					static V Sqrt(V v) { return _mm256_sqrt_ps(v); }
+					static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+					static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+					static V Abs(V v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+					static V Neg(V v) { return _mm256_xor_ps(v, _mm256_set1_ps(-0.0f)); }
+					static V Round(V v) { return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+					static V Floor(V v) { return _mm256_floor_ps(v); }
+
+					static M Less(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+					static M Greater(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+					static M GreaterEqual(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+					static M Equal(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+					static M And(M a, M b) { return _mm256_and_ps(a, b); }
+					static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+					static V Select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+					static int Bits(M m) { return _mm256_movemask_ps(m); }
+				};
+			}
+
+			const KernelTable* GetAVX2Kernels()
+			{
+				static const KernelTable table = SimdKernels<Avx2>::Table();
+				return &table;
+			}
+		}
+	}
+}
+
+#else
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			const KernelTable* GetAVX2Kernels() { return nullptr; }
+		}
+	}
+}
+
+#endif
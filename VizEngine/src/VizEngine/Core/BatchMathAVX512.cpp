@@ -0,0 +1,77 @@
+// VizEngine/src/VizEngine/Core/BatchMathAVX512.cpp
+
+// 16-wide kernels on AVX-512F with mask registers. Built with -mavx512f
+// (/arch:AVX512 on MSVC); only called after CPUID and XGETBV report
+// AVX-512F and OS-saved ZMM/opmask state.
+
+#include "BatchMathKernels.h"
+
+#if VP_BATCHMATH_X86
+#include <immintrin.h>
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			namespace
+			{
+				struct Avx512
+				{
+					using V = __m512;
+					using M = __mmask16;
+					static constexpr size_t Width = 16;
+
+					static V Load(const float* p) { return _mm512_loadu_ps(p); }
+					static V LoadBytes(const uint8_t* p) { return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))); }
+					static void Store(float* p, V v) { _mm512_storeu_ps(p, v); }
+					static V Set(float f) { return _mm512_set1_ps(f); }
+
+					static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+					static V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+					static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+					static V Div(V a, V b) { return _mm512_div_ps(a, b); }
+					static V MulAdd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+					static V Sqrt(V v) { return _mm512_sqrt_ps(v); }
+					static V Min(V a, V b) { return _mm512_min_ps(a, b); }
+					static V Max(V a, V b) { return _mm512_max_ps(a, b); }
+					static V Abs(V v) { return _mm512_abs_ps(v); }
+					static V Neg(V v) { return _mm512_sub_ps(_mm512_setzero_ps(), v); }
+					static V Round(V v) { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+					static V Floor(V v) { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+					static M Less(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+					static M Greater(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+					static M GreaterEqual(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+					static M Equal(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+					static M And(M a, M b) { return static_cast<M>(a & b); }
+					static M Or(M a, M b) { return static_cast<M>(a | b); }
+					static V Select(M m, V a, V b) { return _mm512_mask_blend_ps(m, b, a); }
+					static int Bits(M m) { return static_cast<int>(m); }
+				};
+			}
+
+			const KernelTable* GetAVX512Kernels()
+			{
+				static const KernelTable table = SimdKernels<Avx512>::Table();
+				return &table;
+			}
+		}
+	}
+}
+
+#else
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			const KernelTable* GetAVX512Kernels() { return nullptr; }
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,840 @@
+// VizEngine/src/VizEngine/Core/BatchMathKernels.h
+
+#pragma once
+
+// Internal to the BatchMath translation units. Each instruction-set file is
+// compiled with its own target flags and includes this header, so it must not
+// define non-template inline functions (the linker could keep an AVX copy and
+// call it on a CPU without AVX). Everything below is either a plain declaration
+// or a template instantiated with a type local to one translation unit. That
+// includes the standard library: std::abs, std::copysign or std::countr_zero
+// are such functions, so the kernels use operators and compiler intrinsics.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VP_BATCHMATH_X86 1
+#else
+#define VP_BATCHMATH_X86 0
+#endif
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			/** Component arrays of an input stream (3, 4 or 16 used) */
+			struct StreamIn
+			{
+				const float* C[16] = {};
+			};
+
+			/** Component arrays of an output stream */
+			struct StreamOut
+			{
+				float* C[16] = {};
+			};
+
+			/**
+			 * Quantized 4-wide BVH node, one cache line. Child bounds are 8-bit
+			 * steps of Scale (a power of two) from Origin, so Origin + q * Scale
+			 * rounds once with or without FMA and the builder can verify every
+			 * decoded bound encloses the child. Unused children are BVHNoHit.
+			 */
+			struct BVHNode
+			{
+				float Origin[3];
+				float Scale[3];
+				uint8_t Lo[3][4];          // [axis][child]
+				uint8_t Hi[3][4];
+				uint32_t Child[4];         // Node index, or BVHLeafBit | first triangle << 4 | (count - 1)
+			};
+
+			constexpr uint32_t BVHLeafBit = 0x80000000u;
+			constexpr uint32_t BVHNoHit = 0xFFFFFFFFu;
+			constexpr int BVHStackSize = 256;           // 3 entries per level of a tree at most 64 deep
+			constexpr float BVHBoxSlack = 1.0000004f;   // Slab test rounding (2 * gamma(3))
+			constexpr float BVHEdgeEpsilon = 1e-6f;     // Barycentric slack: rays along a shared edge hit a side
+
+			/** What the ray kernels traverse */
+			struct BVHView
+			{
+				const BVHNode* Nodes = nullptr;
+				uint32_t Root = 0;           // Node index or leaf reference
+				const float* Tri[9] = {};    // Leaf-ordered v0 xyz, edge1 xyz, edge2 xyz; 16 padding entries
+			};
+
+			/** Per-ray results; Triangle is a leaf-order index or BVHNoHit */
+			struct RayHitsOut
+			{
+				float* T = nullptr;
+				float* U = nullptr;
+				float* V = nullptr;
+				uint32_t* Triangle = nullptr;
+			};
+
+			/**
+			 * One implementation of every batch operation. Matrices passed as
+			 * const float* are 16 column-major floats; planes are 6 x (nx, ny, nz, d).
+			 */
+			struct KernelTable
+			{
+				void (*TransformPoints)(const float* matrix, const StreamIn& points, const StreamOut& out, size_t count);
+				void (*MultiplyMatrices)(const StreamIn& a, const StreamIn& b, const StreamOut& out, size_t count);
+				void (*MultiplyByMatrix)(const float* parent, const StreamIn& local, const StreamOut& out, size_t count);
+				void (*ComposeTransforms)(const StreamIn& position, const StreamIn& rotation, const StreamIn& scale,
+					const StreamOut& out, size_t count);
+				void (*EulerToQuaternions)(const StreamIn& euler, const StreamOut& out, size_t count);
+				void (*QuaternionsToEuler)(const StreamIn& quaternions, const StreamOut& out, size_t count);
+				size_t (*CullSpheres)(const float* planes, const StreamIn& centers, const float* radii,
+					uint8_t* visible, size_t count);
+				size_t (*CullBoxes)(const float* planes, const StreamIn& centers, const StreamIn& extents,
+					uint8_t* visible, size_t count);
+
+				// Rays are origin + t * direction with 0 < t < tMax; anyHit stops at the first hit
+				bool (*IntersectRay)(const BVHView& bvh, const float* origin, const float* direction, float tMax,
+					bool anyHit, float* tuv, uint32_t* triangle);
+				void (*IntersectRays)(const BVHView& bvh, const StreamIn& origins, const StreamIn& directions,
+					float tMax, bool anyHit, const RayHitsOut& out, size_t count);
+			};
+
+			// Defined in BatchMathScalar.cpp / BatchMathSSE42.cpp / BatchMathAVX2.cpp / BatchMathAVX512.cpp.
+			// The SIMD getters return nullptr when the file was built for another architecture.
+			const KernelTable& GetScalarKernels();
+			const KernelTable* GetSSE42Kernels();
+			const KernelTable* GetAVX2Kernels();
+			const KernelTable* GetAVX512Kernels();
+
+			/** Table SetActiveISA() selected (BatchMath.cpp), for engine code outside BatchMath */
+			const KernelTable& GetActiveKernels();
+
+			/**
+			 * Vector implementation of KernelTable, written once against an
+			 * instruction-set wrapper S:
+			 *
+			 *   using V (float vector), M (lane mask); static constexpr size_t Width
+			 *   Load, LoadBytes (Width uint8 as floats), Store, Set, Add, Sub, Mul, Div, MulAdd (a * b + c), Sqrt,
+			 *   Min, Max, Abs, Neg, Round (to nearest), Floor,
+			 *   Less, Greater, GreaterEqual, Equal, And, Or, Select (m ? a : b),
+			 *   Bits (lane mask as an integer, lane 0 in bit 0)
+			 *
+			 * Whole vectors run here; the remaining count % Width objects go
+			 * through the scalar kernels.
+			 */
+			template<typename S>
+			struct SimdKernels
+			{
+				using V = typename S::V;
+				using M = typename S::M;
+				static constexpr size_t W = S::Width;
+
+				static constexpr float Pi = 3.14159265358979323846f;
+				static constexpr float HalfPi = 1.57079632679489661923f;
+				static constexpr float QuarterPi = 0.78539816339744830962f;
+
+				static KernelTable Table()
+				{
+					KernelTable table;
+					table.TransformPoints = &TransformPoints;
+					table.MultiplyMatrices = &MultiplyMatrices;
+					table.MultiplyByMatrix = &MultiplyByMatrix;
+					table.ComposeTransforms = &ComposeTransforms;
+					table.EulerToQuaternions = &EulerToQuaternions;
+					table.QuaternionsToEuler = &QuaternionsToEuler;
+					table.CullSpheres = &CullSpheres;
+					table.CullBoxes = &CullBoxes;
+					table.IntersectRay = &IntersectRay;
+					table.IntersectRays = &IntersectRays;
+					return table;
+				}
+
+				// =============================================================
+				// Helpers
+				// =============================================================
+
+				static StreamIn Advance(const StreamIn& s, size_t n)
+				{
+					StreamIn r;
+					for (int i = 0; i < 16; i++) r.C[i] = s.C[i] ? s.C[i] + n : nullptr;
+					return r;
+				}
+
+				static StreamOut Advance(const StreamOut& s, size_t n)
+				{
+					StreamOut r;
+					for (int i = 0; i < 16; i++) r.C[i] = s.C[i] ? s.C[i] + n : nullptr;
+					return r;
+				}
+
+				static size_t WholeVectors(size_t count) { return count - count % W; }
+
+				/**
+				 * sin and cos after reduction to [-pi/4, pi/4] by quadrant
+				 * (Cody-Waite split of pi/2, Cephes minimax polynomials).
+				 */
+				static void SinCos(V x, V& s, V& c)
+				{
+					V j = S::Round(S::Mul(x, S::Set(2.0f / Pi)));
+					V r = S::Sub(x, S::Mul(j, S::Set(1.5703125f)));
+					r = S::Sub(r, S::Mul(j, S::Set(4.837512969970703125e-4f)));
+					r = S::Sub(r, S::Mul(j, S::Set(7.54978995489188216e-8f)));
+
+					V z = S::Mul(r, r);
+					V sp = S::MulAdd(z, S::Set(-1.9515295891e-4f), S::Set(8.3321608736e-3f));
+					sp = S::MulAdd(sp, z, S::Set(-1.6666654611e-1f));
+					V sinR = S::MulAdd(S::Mul(sp, z), r, r);
+
+					V cp = S::MulAdd(z, S::Set(2.443315711809948e-5f), S::Set(-1.388731625493765e-3f));
+					cp = S::MulAdd(cp, z, S::Set(4.166664568298827e-2f));
+					V cosR = S::Add(S::Sub(S::Set(1.0f), S::Mul(z, S::Set(0.5f))), S::Mul(S::Mul(z, z), cp));
+
+					// Quadrant q in 0..3: sin = s, c, -s, -c; cos = c, -s, -c, s
+					V q = S::Sub(j, S::Mul(S::Floor(S::Mul(j, S::Set(0.25f))), S::Set(4.0f)));
+					V odd = S::Sub(q, S::Mul(S::Floor(S::Mul(q, S::Set(0.5f))), S::Set(2.0f)));
+					M swap = S::Greater(odd, S::Set(0.5f));
+					M sinNeg = S::Greater(q, S::Set(1.5f));
+					M cosNeg = S::And(S::Greater(q, S::Set(0.5f)), S::Less(q, S::Set(2.5f)));
+
+					V sv = S::Select(swap, cosR, sinR);
+					V cv = S::Select(swap, sinR, cosR);
+					s = S::Select(sinNeg, S::Neg(sv), sv);
+					c = S::Select(cosNeg, S::Neg(cv), cv);
+				}
+
+				/** atan with Cephes range reduction at tan(pi/8) and tan(3pi/8) */
+				static V Atan(V x)
+				{
+					V ax = S::Abs(x);
+					M big = S::Greater(ax, S::Set(2.414213562373095f));
+					M mid = S::Greater(ax, S::Set(0.4142135623730950f));
+
+					V t = S::Select(big, S::Div(S::Set(-1.0f), ax),
+						S::Select(mid, S::Div(S::Sub(ax, S::Set(1.0f)), S::Add(ax, S::Set(1.0f))), ax));
+					V base = S::Select(big, S::Set(HalfPi), S::Select(mid, S::Set(QuarterPi), S::Set(0.0f)));
+
+					V z = S::Mul(t, t);
+					V p = S::MulAdd(z, S::Set(8.05374449538e-2f), S::Set(-1.38776856032e-1f));
+					p = S::MulAdd(p, z, S::Set(1.99777106478e-1f));
+					p = S::MulAdd(p, z, S::Set(-3.33329491539e-1f));
+					V r = S::Add(base, S::MulAdd(S::Mul(p, z), t, t));
+
+					return S::Select(S::Less(x, S::Set(0.0f)), S::Neg(r), r);
+				}
+
+				static V Atan2(V y, V x)
+				{
+					V zero = S::Set(0.0f);
+					M xZero = S::Equal(x, zero);
+					M xNeg = S::Less(x, zero);
+					M yNeg = S::Less(y, zero);
+
+					V r = Atan(S::Div(y, S::Select(xZero, S::Set(1.0f), x)));
+					r = S::Select(xNeg, S::Add(r, S::Select(yNeg, S::Set(-Pi), S::Set(Pi))), r);
+
+					V onAxis = S::Select(yNeg, S::Set(-HalfPi), S::Select(S::Equal(y, zero), zero, S::Set(HalfPi)));
+					return S::Select(xZero, onAxis, r);
+				}
+
+				// =============================================================
+				// Transforms
+				// =============================================================
+
+				static void TransformPoints(const float* m, const StreamIn& points, const StreamOut& out, size_t count)
+				{
+					V mv[16];
+					for (int i = 0; i < 16; i++) mv[i] = S::Set(m[i]);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V x = S::Load(points.C[0] + i);
+						V y = S::Load(points.C[1] + i);
+						V z = S::Load(points.C[2] + i);
+						for (int r = 0; r < 3; r++)
+						{
+							V v = S::MulAdd(mv[r], x, mv[12 + r]);
+							v = S::MulAdd(mv[4 + r], y, v);
+							v = S::MulAdd(mv[8 + r], z, v);
+							S::Store(out.C[r] + i, v);
+						}
+					}
+					GetScalarKernels().TransformPoints(m, Advance(points, whole), Advance(out, whole), count - whole);
+				}
+
+				static void MultiplyMatrices(const StreamIn& a, const StreamIn& b, const StreamOut& out, size_t count)
+				{
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V av[16];
+						for (int e = 0; e < 16; e++) av[e] = S::Load(a.C[e] + i);
+
+						for (int c = 0; c < 4; c++)
+						{
+							V b0 = S::Load(b.C[c * 4 + 0] + i);
+							V b1 = S::Load(b.C[c * 4 + 1] + i);
+							V b2 = S::Load(b.C[c * 4 + 2] + i);
+							V b3 = S::Load(b.C[c * 4 + 3] + i);
+							for (int r = 0; r < 4; r++)
+							{
+								V v = S::Mul(av[r], b0);
+								v = S::MulAdd(av[4 + r], b1, v);
+								v = S::MulAdd(av[8 + r], b2, v);
+								v = S::MulAdd(av[12 + r], b3, v);
+								S::Store(out.C[c * 4 + r] + i, v);
+							}
+						}
+					}
+					GetScalarKernels().MultiplyMatrices(Advance(a, whole), Advance(b, whole), Advance(out, whole), count - whole);
+				}
+
+				static void MultiplyByMatrix(const float* parent, const StreamIn& local, const StreamOut& out, size_t count)
+				{
+					V pv[16];
+					for (int e = 0; e < 16; e++) pv[e] = S::Set(parent[e]);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							V l0 = S::Load(local.C[c * 4 + 0] + i);
+							V l1 = S::Load(local.C[c * 4 + 1] + i);
+							V l2 = S::Load(local.C[c * 4 + 2] + i);
+							V l3 = S::Load(local.C[c * 4 + 3] + i);
+							for (int r = 0; r < 4; r++)
+							{
+								V v = S::Mul(pv[r], l0);
+								v = S::MulAdd(pv[4 + r], l1, v);
+								v = S::MulAdd(pv[8 + r], l2, v);
+								v = S::MulAdd(pv[12 + r], l3, v);
+								S::Store(out.C[c * 4 + r] + i, v);
+							}
+						}
+					}
+					GetScalarKernels().MultiplyByMatrix(parent, Advance(local, whole), Advance(out, whole), count - whole);
+				}
+
+				static void ComposeTransforms(const StreamIn& position, const StreamIn& rotation, const StreamIn& scale,
+					const StreamOut& out, size_t count)
+				{
+					V zero = S::Set(0.0f);
+					V one = S::Set(1.0f);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V sx, cx, sy, cy, sz, cz;
+						SinCos(S::Load(rotation.C[0] + i), sx, cx);
+						SinCos(S::Load(rotation.C[1] + i), sy, cy);
+						SinCos(S::Load(rotation.C[2] + i), sz, cz);
+
+						V scaleX = S::Load(scale.C[0] + i);
+						V scaleY = S::Load(scale.C[1] + i);
+						V scaleZ = S::Load(scale.C[2] + i);
+						V sxsy = S::Mul(sx, sy);
+						V cxsy = S::Mul(cx, sy);
+
+						// Columns of Rx * Ry * Rz, scaled per axis
+						S::Store(out.C[0] + i, S::Mul(S::Mul(cy, cz), scaleX));
+						S::Store(out.C[1] + i, S::Mul(S::MulAdd(sxsy, cz, S::Mul(cx, sz)), scaleX));
+						S::Store(out.C[2] + i, S::Mul(S::Sub(S::Mul(sx, sz), S::Mul(cxsy, cz)), scaleX));
+						S::Store(out.C[3] + i, zero);
+
+						S::Store(out.C[4] + i, S::Mul(S::Neg(S::Mul(cy, sz)), scaleY));
+						S::Store(out.C[5] + i, S::Mul(S::Sub(S::Mul(cx, cz), S::Mul(sxsy, sz)), scaleY));
+						S::Store(out.C[6] + i, S::Mul(S::MulAdd(cxsy, sz, S::Mul(sx, cz)), scaleY));
+						S::Store(out.C[7] + i, zero);
+
+						S::Store(out.C[8] + i, S::Mul(sy, scaleZ));
+						S::Store(out.C[9] + i, S::Mul(S::Neg(S::Mul(sx, cy)), scaleZ));
+						S::Store(out.C[10] + i, S::Mul(S::Mul(cx, cy), scaleZ));
+						S::Store(out.C[11] + i, zero);
+
+						S::Store(out.C[12] + i, S::Load(position.C[0] + i));
+						S::Store(out.C[13] + i, S::Load(position.C[1] + i));
+						S::Store(out.C[14] + i, S::Load(position.C[2] + i));
+						S::Store(out.C[15] + i, one);
+					}
+					GetScalarKernels().ComposeTransforms(Advance(position, whole), Advance(rotation, whole),
+						Advance(scale, whole), Advance(out, whole), count - whole);
+				}
+
+				// =============================================================
+				// Rotations
+				// =============================================================
+
+				static void EulerToQuaternions(const StreamIn& euler, const StreamOut& out, size_t count)
+				{
+					V half = S::Set(0.5f);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V sx, cx, sy, cy, sz, cz;
+						SinCos(S::Mul(S::Load(euler.C[0] + i), half), sx, cx);
+						SinCos(S::Mul(S::Load(euler.C[1] + i), half), sy, cy);
+						SinCos(S::Mul(S::Load(euler.C[2] + i), half), sz, cz);
+
+						// qx * qy * qz
+						V cycz = S::Mul(cy, cz);
+						V sysz = S::Mul(sy, sz);
+						V sycz = S::Mul(sy, cz);
+						V cysz = S::Mul(cy, sz);
+						S::Store(out.C[0] + i, S::MulAdd(sx, cycz, S::Mul(cx, sysz)));
+						S::Store(out.C[1] + i, S::Sub(S::Mul(cx, sycz), S::Mul(sx, cysz)));
+						S::Store(out.C[2] + i, S::MulAdd(cx, cysz, S::Mul(sx, sycz)));
+						S::Store(out.C[3] + i, S::Sub(S::Mul(cx, cycz), S::Mul(sx, sysz)));
+					}
+					GetScalarKernels().EulerToQuaternions(Advance(euler, whole), Advance(out, whole), count - whole);
+				}
+
+				static void QuaternionsToEuler(const StreamIn& quaternions, const StreamOut& out, size_t count)
+				{
+					V one = S::Set(1.0f);
+					V two = S::Set(2.0f);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V x = S::Load(quaternions.C[0] + i);
+						V y = S::Load(quaternions.C[1] + i);
+						V z = S::Load(quaternions.C[2] + i);
+						V w = S::Load(quaternions.C[3] + i);
+
+						// Rotation matrix entries (row, column) the angles are read from
+						V r02 = S::Mul(two, S::MulAdd(x, z, S::Mul(w, y)));
+						V r12 = S::Mul(two, S::Sub(S::Mul(y, z), S::Mul(w, x)));
+						V r22 = S::Sub(one, S::Mul(two, S::MulAdd(x, x, S::Mul(y, y))));
+						V r01 = S::Mul(two, S::Sub(S::Mul(x, y), S::Mul(w, z)));
+						V r00 = S::Sub(one, S::Mul(two, S::MulAdd(y, y, S::Mul(z, z))));
+						V r21 = S::Mul(two, S::MulAdd(y, z, S::Mul(w, x)));
+						V r11 = S::Sub(one, S::Mul(two, S::MulAdd(x, x, S::Mul(z, z))));
+
+						V sinY = S::Min(S::Max(r02, S::Set(-1.0f)), one);
+						V angleY = Atan2(sinY, S::Sqrt(S::Sub(one, S::Mul(sinY, sinY))));
+
+						M locked = S::Greater(S::Abs(sinY), S::Set(0.9999f));
+						V angleX = S::Select(locked, Atan2(r21, r11), Atan2(S::Neg(r12), r22));
+						V angleZ = S::Select(locked, S::Set(0.0f), Atan2(S::Neg(r01), r00));
+
+						S::Store(out.C[0] + i, angleX);
+						S::Store(out.C[1] + i, angleY);
+						S::Store(out.C[2] + i, angleZ);
+					}
+					GetScalarKernels().QuaternionsToEuler(Advance(quaternions, whole), Advance(out, whole), count - whole);
+				}
+
+				// =============================================================
+				// Frustum tests
+				// =============================================================
+
+				static size_t WriteMask(M visible, uint8_t* out)
+				{
+					uint32_t bits = static_cast<uint32_t>(S::Bits(visible));
+					size_t count = 0;
+					for (size_t lane = 0; lane < W; lane++)
+					{
+						uint8_t v = static_cast<uint8_t>((bits >> lane) & 1u);
+						out[lane] = v;
+						count += v;
+					}
+					return count;
+				}
+
+				static size_t CullSpheres(const float* planes, const StreamIn& centers, const float* radii,
+					uint8_t* visible, size_t count)
+				{
+					V pv[24];
+					for (int e = 0; e < 24; e++) pv[e] = S::Set(planes[e]);
+
+					size_t visibleCount = 0;
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V x = S::Load(centers.C[0] + i);
+						V y = S::Load(centers.C[1] + i);
+						V z = S::Load(centers.C[2] + i);
+						V negRadius = S::Neg(S::Load(radii + i));
+
+						M inside = S::GreaterEqual(S::MulAdd(pv[0], x, S::MulAdd(pv[1], y, S::MulAdd(pv[2], z, pv[3]))), negRadius);
+						for (int p = 1; p < 6; p++)
+						{
+							const V* n = pv + p * 4;
+							V d = S::MulAdd(n[0], x, S::MulAdd(n[1], y, S::MulAdd(n[2], z, n[3])));
+							inside = S::And(inside, S::GreaterEqual(d, negRadius));
+						}
+						visibleCount += WriteMask(inside, visible + i);
+					}
+					return visibleCount + GetScalarKernels().CullSpheres(planes, Advance(centers, whole),
+						radii + whole, visible + whole, count - whole);
+				}
+
+				static size_t CullBoxes(const float* planes, const StreamIn& centers, const StreamIn& extents,
+					uint8_t* visible, size_t count)
+				{
+					V pv[24];
+					V absNormal[18];
+					for (int p = 0; p < 6; p++)
+					{
+						for (int k = 0; k < 4; k++) pv[p * 4 + k] = S::Set(planes[p * 4 + k]);
+						for (int k = 0; k < 3; k++) absNormal[p * 3 + k] = S::Abs(pv[p * 4 + k]);
+					}
+
+					size_t visibleCount = 0;
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V x = S::Load(centers.C[0] + i);
+						V y = S::Load(centers.C[1] + i);
+						V z = S::Load(centers.C[2] + i);
+						V ex = S::Load(extents.C[0] + i);
+						V ey = S::Load(extents.C[1] + i);
+						V ez = S::Load(extents.C[2] + i);
+
+						M inside = S::GreaterEqual(S::Set(0.0f), S::Set(0.0f));   // All lanes
+						for (int p = 0; p < 6; p++)
+						{
+							const V* n = pv + p * 4;
+							const V* a = absNormal + p * 3;
+							V d = S::MulAdd(n[0], x, S::MulAdd(n[1], y, S::MulAdd(n[2], z, n[3])));
+							V reach = S::MulAdd(a[0], ex, S::MulAdd(a[1], ey, S::Mul(a[2], ez)));
+							inside = S::And(inside, S::GreaterEqual(d, S::Neg(reach)));
+						}
+						visibleCount += WriteMask(inside, visible + i);
+					}
+					return visibleCount + GetScalarKernels().CullBoxes(planes, Advance(centers, whole),
+						Advance(extents, whole), visible + whole, count - whole);
+				}
+
+				// =============================================================
+				// Ray queries
+				// =============================================================
+
+				static constexpr float LaneIndex[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+				/** 1 / d with |d| clamped away from 0: a 0 * inf slab product would be NaN */
+				static float SafeInverse(float d)
+				{
+					// Same clamp as the vector overload (-0 becomes +tiny)
+					return 1.0f / (d > 1e-20f || d < -1e-20f ? d : (d < 0.0f ? -1e-20f : 1e-20f));
+				}
+
+				/** Index of the lowest set bit of a non-zero mask */
+				static int LowestBit(uint32_t bits)
+				{
+#if defined(_MSC_VER)
+					unsigned long index;
+					_BitScanForward(&index, bits);
+					return static_cast<int>(index);
+#else
+					return __builtin_ctz(bits);
+#endif
+				}
+
+				static V SafeInverse(V d)
+				{
+					V tiny = S::Set(1e-20f);
+					V clamped = S::Select(S::Less(d, S::Set(0.0f)), S::Neg(tiny), tiny);
+					return S::Div(S::Set(1.0f), S::Select(S::Less(S::Abs(d), tiny), clamped, d));
+				}
+
+				/**
+				 * Bounds of the node's children in lanes 0-3. q * Scale is exact,
+				 * so this matches the builder's check with or without FMA.
+				 */
+				static void ChildBounds(const BVHNode& node, V* lo, V* hi)
+				{
+					for (int a = 0; a < 3; a++)
+					{
+						V origin = S::Set(node.Origin[a]);
+						V scale = S::Set(node.Scale[a]);
+						lo[a] = S::MulAdd(S::LoadBytes(node.Lo[a]), scale, origin);
+						hi[a] = S::MulAdd(S::LoadBytes(node.Hi[a]), scale, origin);
+					}
+				}
+
+				static int ChildCount(const BVHNode& node)
+				{
+					int count = 1;
+					while (count < 4 && node.Child[count] != BVHNoHit) count++;
+					return count;
+				}
+
+				/** Push the hit children far to near, so the nearest is traversed next */
+				static void PushChildren(uint32_t* stack, int& top, const uint32_t* refs, const float* tNear, int count)
+				{
+					uint32_t r[4];
+					float t[4];
+					for (int i = 0; i < count; i++)
+					{
+						int j = i;
+						for (; j > 0 && t[j - 1] < tNear[i]; j--)
+						{
+							r[j] = r[j - 1];
+							t[j] = t[j - 1];
+						}
+						r[j] = refs[i];
+						t[j] = tNear[i];
+					}
+					for (int i = 0; i < count; i++) stack[top++] = r[i];
+				}
+
+				/**
+				 * Moller-Trumbore for W ray/triangle pairs, both faces. tri holds
+				 * v0 xyz, edge1 xyz, edge2 xyz. det == 0 gives inf/NaN, which fail
+				 * the range tests.
+				 */
+				static M TriangleTest(const V* o, const V* d, const V* tri, V& t, V& u, V& v)
+				{
+					V px = S::Sub(S::Mul(d[1], tri[8]), S::Mul(d[2], tri[7]));
+					V py = S::Sub(S::Mul(d[2], tri[6]), S::Mul(d[0], tri[8]));
+					V pz = S::Sub(S::Mul(d[0], tri[7]), S::Mul(d[1], tri[6]));
+					V invDet = S::Div(S::Set(1.0f), S::MulAdd(tri[3], px, S::MulAdd(tri[4], py, S::Mul(tri[5], pz))));
+
+					V sx = S::Sub(o[0], tri[0]);
+					V sy = S::Sub(o[1], tri[1]);
+					V sz = S::Sub(o[2], tri[2]);
+					u = S::Mul(S::MulAdd(sx, px, S::MulAdd(sy, py, S::Mul(sz, pz))), invDet);
+
+					V qx = S::Sub(S::Mul(sy, tri[5]), S::Mul(sz, tri[4]));
+					V qy = S::Sub(S::Mul(sz, tri[3]), S::Mul(sx, tri[5]));
+					V qz = S::Sub(S::Mul(sx, tri[4]), S::Mul(sy, tri[3]));
+					v = S::Mul(S::MulAdd(d[0], qx, S::MulAdd(d[1], qy, S::Mul(d[2], qz))), invDet);
+					t = S::Mul(S::MulAdd(tri[6], qx, S::MulAdd(tri[7], qy, S::Mul(tri[8], qz))), invDet);
+
+					V low = S::Set(-BVHEdgeEpsilon);
+					M hit = S::And(S::GreaterEqual(u, low), S::GreaterEqual(v, low));
+					hit = S::And(hit, S::GreaterEqual(S::Set(1.0f + BVHEdgeEpsilon), S::Add(u, v)));
+					return S::And(hit, S::Greater(t, S::Set(0.0f)));
+				}
+
+				/**
+				 * One ray: the four child boxes of a node in one vector, leaf
+				 * triangles W at a time.
+				 */
+				static bool IntersectRay(const BVHView& bvh, const float* origin, const float* direction, float tMax,
+					bool anyHit, float* tuv, uint32_t* triangle)
+				{
+					V o[3], d[3], invDv[3];
+					for (int a = 0; a < 3; a++)
+					{
+						o[a] = S::Set(origin[a]);
+						d[a] = S::Set(direction[a]);
+						invDv[a] = S::Set(SafeInverse(direction[a]));
+					}
+
+					float tBest = tMax, uBest = 0.0f, vBest = 0.0f;
+					uint32_t best = BVHNoHit;
+
+					uint32_t stack[BVHStackSize];
+					int top = 0;
+					stack[top++] = bvh.Root;
+					while (top > 0)
+					{
+						uint32_t ref = stack[--top];
+						if (ref & BVHLeafBit)
+						{
+							uint32_t first = (ref & ~BVHLeafBit) >> 4;
+							uint32_t count = (ref & 15u) + 1;
+							for (uint32_t i = 0; i < count; i += static_cast<uint32_t>(W))
+							{
+								// Lanes past the leaf read the next leaf or the padding
+								V tri[9];
+								for (int c = 0; c < 9; c++) tri[c] = S::Load(bvh.Tri[c] + first + i);
+
+								V t, u, v;
+								M hit = TriangleTest(o, d, tri, t, u, v);
+								hit = S::And(hit, S::Less(t, S::Set(tBest)));
+								hit = S::And(hit, S::Less(S::Load(LaneIndex), S::Set(static_cast<float>(count - i))));
+								uint32_t bits = static_cast<uint32_t>(S::Bits(hit));
+								if (!bits) continue;
+
+								float ts[16], us[16], vs[16];
+								S::Store(ts, t);
+								S::Store(us, u);
+								S::Store(vs, v);
+								for (size_t lane = 0; lane < W; lane++)
+								{
+									if (((bits >> lane) & 1u) && ts[lane] < tBest)
+									{
+										tBest = ts[lane];
+										uBest = us[lane];
+										vBest = vs[lane];
+										best = first + i + static_cast<uint32_t>(lane);
+									}
+								}
+								if (anyHit)
+								{
+									top = 0;
+									break;
+								}
+							}
+							continue;
+						}
+
+						// The four children side by side in lanes 0-3
+						const BVHNode& node = bvh.Nodes[ref];
+						V lo[3], hi[3];
+						ChildBounds(node, lo, hi);
+						V t0 = S::Set(0.0f), t1 = S::Set(tBest);
+						for (int a = 0; a < 3; a++)
+						{
+							V tl = S::Mul(S::Sub(lo[a], o[a]), invDv[a]);
+							V th = S::Mul(S::Sub(hi[a], o[a]), invDv[a]);
+							t0 = S::Max(t0, S::Min(tl, th));
+							t1 = S::Min(t1, S::Max(tl, th));
+						}
+						M boxHit = S::GreaterEqual(S::Mul(t1, S::Set(BVHBoxSlack)), t0);
+						boxHit = S::And(boxHit, S::Less(S::Load(LaneIndex), S::Set(static_cast<float>(ChildCount(node)))));
+						uint32_t bits = static_cast<uint32_t>(S::Bits(boxHit));
+						if (!bits) continue;
+
+						float entry[16];
+						S::Store(entry, t0);
+						uint32_t refs[4];
+						float tNear[4];
+						int hits = 0;
+						for (int c = 0; c < 4; c++)
+						{
+							if (!((bits >> c) & 1u)) continue;
+							refs[hits] = node.Child[c];
+							tNear[hits++] = entry[c];
+						}
+						PushChildren(stack, top, refs, tNear, hits);
+					}
+
+					*triangle = best;
+					if (best == BVHNoHit) return false;
+					tuv[0] = tBest;
+					tuv[1] = uBest;
+					tuv[2] = vBest;
+					return true;
+				}
+
+				/**
+				 * W rays per packet: each box and triangle is tested against the
+				 * whole packet, and a subtree is entered if any of its rays hit the
+				 * box. Best for coherent rays (camera, shadow rays to one light).
+				 */
+				static void IntersectRays(const BVHView& bvh, const StreamIn& origins, const StreamIn& directions,
+					float tMax, bool anyHit, const RayHitsOut& out, size_t count)
+				{
+					const uint32_t allLanes = (1u << W) - 1u;
+					V zero = S::Set(0.0f);
+					V slack = S::Set(BVHBoxSlack);
+
+					size_t whole = WholeVectors(count);
+					for (size_t i = 0; i < whole; i += W)
+					{
+						V o[3], d[3], invD[3];
+						for (int a = 0; a < 3; a++)
+						{
+							o[a] = S::Load(origins.C[a] + i);
+							d[a] = S::Load(directions.C[a] + i);
+							invD[a] = SafeInverse(d[a]);
+						}
+
+						// tLimit culls boxes and triangles: the closest hit so far, or
+						// -1 once an any-hit ray is done
+						V tBest = S::Set(tMax), tLimit = tBest, uBest = zero, vBest = zero;
+						uint32_t best[16];
+						for (size_t lane = 0; lane < W; lane++) best[lane] = BVHNoHit;
+						uint32_t done = 0;
+
+						uint32_t stack[BVHStackSize];
+						int top = 0;
+						stack[top++] = bvh.Root;
+						while (top > 0)
+						{
+							uint32_t ref = stack[--top];
+							if (ref & BVHLeafBit)
+							{
+								uint32_t first = (ref & ~BVHLeafBit) >> 4;
+								uint32_t leafCount = (ref & 15u) + 1;
+								for (uint32_t k = first; k < first + leafCount; k++)
+								{
+									V tri[9];
+									for (int c = 0; c < 9; c++) tri[c] = S::Set(bvh.Tri[c][k]);
+
+									V t, u, v;
+									M hit = TriangleTest(o, d, tri, t, u, v);
+									hit = S::And(hit, S::Less(t, tLimit));
+									uint32_t bits = static_cast<uint32_t>(S::Bits(hit));
+									if (!bits) continue;
+
+									tBest = S::Select(hit, t, tBest);
+									uBest = S::Select(hit, u, uBest);
+									vBest = S::Select(hit, v, vBest);
+									tLimit = anyHit ? S::Select(hit, S::Set(-1.0f), tLimit) : tBest;
+									for (size_t lane = 0; lane < W; lane++)
+									{
+										if ((bits >> lane) & 1u) best[lane] = k;
+									}
+									done |= bits;
+								}
+								if (anyHit && done == allLanes) break;
+								continue;
+							}
+
+							const BVHNode& node = bvh.Nodes[ref];
+							float lo[3][16], hi[3][16];
+							{
+								V lv[3], hv[3];
+								ChildBounds(node, lv, hv);
+								for (int a = 0; a < 3; a++)
+								{
+									S::Store(lo[a], lv[a]);
+									S::Store(hi[a], hv[a]);
+								}
+							}
+
+							uint32_t refs[4];
+							float tNear[4];
+							int hits = 0;
+							for (int c = 0, children = ChildCount(node); c < children; c++)
+							{
+								V t0 = zero, t1 = tLimit;
+								for (int a = 0; a < 3; a++)
+								{
+									V tl = S::Mul(S::Sub(S::Set(lo[a][c]), o[a]), invD[a]);
+									V th = S::Mul(S::Sub(S::Set(hi[a][c]), o[a]), invD[a]);
+									t0 = S::Max(t0, S::Min(tl, th));
+									t1 = S::Min(t1, S::Max(tl, th));
+								}
+								uint32_t bits = static_cast<uint32_t>(S::Bits(S::GreaterEqual(S::Mul(t1, slack), t0)));
+								if (!bits) continue;
+
+								// Order by the entry distance of the first ray that hits
+								float entry[16];
+								S::Store(entry, t0);
+								refs[hits] = node.Child[c];
+								tNear[hits++] = entry[LowestBit(bits)];
+							}
+							PushChildren(stack, top, refs, tNear, hits);
+						}
+
+						S::Store(out.T + i, tBest);
+						S::Store(out.U + i, uBest);
+						S::Store(out.V + i, vBest);
+						for (size_t lane = 0; lane < W; lane++) out.Triangle[i + lane] = best[lane];
+					}
+
+					RayHitsOut tail;
+					tail.T = out.T + whole;
+					tail.U = out.U + whole;
+					tail.V = out.V + whole;
+					tail.Triangle = out.Triangle + whole;
+					GetScalarKernels().IntersectRays(bvh, Advance(origins, whole), Advance(directions, whole),
+						tMax, anyHit, tail, count - whole);
+				}
+			};
+		}
+	}
+}
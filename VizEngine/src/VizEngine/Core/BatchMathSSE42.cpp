@@ -0,0 +1,76 @@
+// VizEngine/src/VizEngine/Core/BatchMathSSE42.cpp
+
+// 4-wide kernels. Built with -msse4.2 on GCC/Clang; MSVC x64 accepts the
+// intrinsics as is. Only called after CPUID reports SSE4.2.
+
+#include "BatchMathKernels.h"
+
+#if VP_BATCHMATH_X86
+#include <nmmintrin.h>
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			namespace
+			{
+				struct Sse42
+				{
+					using V = __m128;
+					using M = __m128;
+					static constexpr size_t Width = 4;
+
+					static V Load(const float* p) { return _mm_loadu_ps(p); }
+					static V LoadBytes(const uint8_t* p) { return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_loadu_si32(p))); }
+					static void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+					static V Set(float f) { return _mm_set1_ps(f); }
+
+					static V Add(V a, V b) { return _mm_add_ps(a, b); }
+					static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+					static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+					static V Div(V a, V b) { return _mm_div_ps(a, b); }
+					static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+					static V Sqrt(V v) { return _mm_sqrt_ps(v); }
+					static V Min(V a, V b) { return _mm_min_ps(a, b); }
+					static V Max(V a, V b) { return _mm_max_ps(a, b); }
+					static V Abs(V v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+					static V Neg(V v) { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+					static V Round(V v) { return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+					static V Floor(V v) { return _mm_floor_ps(v); }
+
+					static M Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+					static M Greater(V a, V b) { return _mm_cmpgt_ps(a, b); }
+					static M GreaterEqual(V a, V b) { return _mm_cmpge_ps(a, b); }
+					static M Equal(V a, V b) { return _mm_cmpeq_ps(a, b); }
+					static M And(M a, M b) { return _mm_and_ps(a, b); }
+					static M Or(M a, M b) { return _mm_or_ps(a, b); }
+					static V Select(M m, V a, V b) { return _mm_blendv_ps(b, a, m); }
+					static int Bits(M m) { return _mm_movemask_ps(m); }
+				};
+			}
+
+			const KernelTable* GetSSE42Kernels()
+			{
+				static const KernelTable table = SimdKernels<Sse42>::Table();
+				return &table;
+			}
+		}
+	}
+}
+
+#else
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			const KernelTable* GetSSE42Kernels() { return nullptr; }
+		}
+	}
+}
+
+#endif
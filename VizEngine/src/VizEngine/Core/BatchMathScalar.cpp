@@ -0,0 +1,334 @@
+// VizEngine/src/VizEngine/Core/BatchMathScalar.cpp
+
+// Reference kernels: one object at a time with the C library's sin/cos/atan2.
+// The SIMD kernels fall back to these for stream tails.
+
+#include "BatchMathKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VizEngine
+{
+	namespace BatchMath
+	{
+		namespace Detail
+		{
+			namespace
+			{
+				void TransformPoints(const float* m, const StreamIn& points, const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						float x = points.C[0][i];
+						float y = points.C[1][i];
+						float z = points.C[2][i];
+						for (int r = 0; r < 3; r++)
+						{
+							out.C[r][i] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r];
+						}
+					}
+				}
+
+				void MultiplyMatrices(const StreamIn& a, const StreamIn& b, const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							for (int r = 0; r < 4; r++)
+							{
+								float v = 0.0f;
+								for (int k = 0; k < 4; k++)
+								{
+									v += a.C[k * 4 + r][i] * b.C[c * 4 + k][i];
+								}
+								out.C[c * 4 + r][i] = v;
+							}
+						}
+					}
+				}
+
+				void MultiplyByMatrix(const float* parent, const StreamIn& local, const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							for (int r = 0; r < 4; r++)
+							{
+								float v = 0.0f;
+								for (int k = 0; k < 4; k++)
+								{
+									v += parent[k * 4 + r] * local.C[c * 4 + k][i];
+								}
+								out.C[c * 4 + r][i] = v;
+							}
+						}
+					}
+				}
+
+				void ComposeTransforms(const StreamIn& position, const StreamIn& rotation, const StreamIn& scale,
+					const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						float sx = std::sin(rotation.C[0][i]), cx = std::cos(rotation.C[0][i]);
+						float sy = std::sin(rotation.C[1][i]), cy = std::cos(rotation.C[1][i]);
+						float sz = std::sin(rotation.C[2][i]), cz = std::cos(rotation.C[2][i]);
+						float scaleX = scale.C[0][i];
+						float scaleY = scale.C[1][i];
+						float scaleZ = scale.C[2][i];
+
+						// Rx * Ry * Rz:
+						//   | cy cz             -cy sz              sy     |
+						//   | cx sz + sx sy cz   cx cz - sx sy sz  -sx cy  |
+						//   | sx sz - cx sy cz   sx cz + cx sy sz   cx cy  |
+						out.C[0][i] = cy * cz * scaleX;
+						out.C[1][i] = (cx * sz + sx * sy * cz) * scaleX;
+						out.C[2][i] = (sx * sz - cx * sy * cz) * scaleX;
+						out.C[3][i] = 0.0f;
+
+						out.C[4][i] = -cy * sz * scaleY;
+						out.C[5][i] = (cx * cz - sx * sy * sz) * scaleY;
+						out.C[6][i] = (sx * cz + cx * sy * sz) * scaleY;
+						out.C[7][i] = 0.0f;
+
+						out.C[8][i] = sy * scaleZ;
+						out.C[9][i] = -sx * cy * scaleZ;
+						out.C[10][i] = cx * cy * scaleZ;
+						out.C[11][i] = 0.0f;
+
+						out.C[12][i] = position.C[0][i];
+						out.C[13][i] = position.C[1][i];
+						out.C[14][i] = position.C[2][i];
+						out.C[15][i] = 1.0f;
+					}
+				}
+
+				void EulerToQuaternions(const StreamIn& euler, const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						float sx = std::sin(euler.C[0][i] * 0.5f), cx = std::cos(euler.C[0][i] * 0.5f);
+						float sy = std::sin(euler.C[1][i] * 0.5f), cy = std::cos(euler.C[1][i] * 0.5f);
+						float sz = std::sin(euler.C[2][i] * 0.5f), cz = std::cos(euler.C[2][i] * 0.5f);
+
+						// qx * qy * qz
+						out.C[0][i] = sx * cy * cz + cx * sy * sz;
+						out.C[1][i] = cx * sy * cz - sx * cy * sz;
+						out.C[2][i] = cx * cy * sz + sx * sy * cz;
+						out.C[3][i] = cx * cy * cz - sx * sy * sz;
+					}
+				}
+
+				void QuaternionsToEuler(const StreamIn& quaternions, const StreamOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						float x = quaternions.C[0][i];
+						float y = quaternions.C[1][i];
+						float z = quaternions.C[2][i];
+						float w = quaternions.C[3][i];
+
+						float sinY = std::clamp(2.0f * (x * z + w * y), -1.0f, 1.0f);
+						out.C[1][i] = std::asin(sinY);
+
+						if (std::abs(sinY) > 0.9999f)
+						{
+							// Gimbal lock: x and z rotate about the same axis
+							out.C[0][i] = std::atan2(2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + z * z));
+							out.C[2][i] = 0.0f;
+						}
+						else
+						{
+							out.C[0][i] = std::atan2(-2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y));
+							out.C[2][i] = std::atan2(-2.0f * (x * y - w * z), 1.0f - 2.0f * (y * y + z * z));
+						}
+					}
+				}
+
+				size_t CullSpheres(const float* planes, const StreamIn& centers, const float* radii,
+					uint8_t* visible, size_t count)
+				{
+					size_t visibleCount = 0;
+					for (size_t i = 0; i < count; i++)
+					{
+						float x = centers.C[0][i];
+						float y = centers.C[1][i];
+						float z = centers.C[2][i];
+
+						bool inside = true;
+						for (int p = 0; p < 6 && inside; p++)
+						{
+							const float* n = planes + p * 4;
+							inside = n[0] * x + n[1] * y + n[2] * z + n[3] >= -radii[i];
+						}
+						visible[i] = inside ? 1 : 0;
+						visibleCount += visible[i];
+					}
+					return visibleCount;
+				}
+
+				size_t CullBoxes(const float* planes, const StreamIn& centers, const StreamIn& extents,
+					uint8_t* visible, size_t count)
+				{
+					size_t visibleCount = 0;
+					for (size_t i = 0; i < count; i++)
+					{
+						float x = centers.C[0][i];
+						float y = centers.C[1][i];
+						float z = centers.C[2][i];
+
+						bool inside = true;
+						for (int p = 0; p < 6 && inside; p++)
+						{
+							const float* n = planes + p * 4;
+							float reach = std::abs(n[0]) * extents.C[0][i] + std::abs(n[1]) * extents.C[1][i] +
+								std::abs(n[2]) * extents.C[2][i];
+							inside = n[0] * x + n[1] * y + n[2] * z + n[3] >= -reach;
+						}
+						visible[i] = inside ? 1 : 0;
+						visibleCount += visible[i];
+					}
+					return visibleCount;
+				}
+
+				// =============================================================
+				// Ray queries
+				// =============================================================
+
+				float SafeInverse(float d)
+				{
+					return 1.0f / (std::abs(d) > 1e-20f ? d : std::copysign(1e-20f, d));
+				}
+
+				/** Moller-Trumbore, both faces; tri points at v0 xyz, edge1 xyz, edge2 xyz of triangle k */
+				bool TriangleTest(const BVHView& bvh, uint32_t k, const float* o, const float* d,
+					float& t, float& u, float& v)
+				{
+					float e1[3] = { bvh.Tri[3][k], bvh.Tri[4][k], bvh.Tri[5][k] };
+					float e2[3] = { bvh.Tri[6][k], bvh.Tri[7][k], bvh.Tri[8][k] };
+					float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+					float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+					if (det == 0.0f) return false;
+					float invDet = 1.0f / det;
+
+					float s[3] = { o[0] - bvh.Tri[0][k], o[1] - bvh.Tri[1][k], o[2] - bvh.Tri[2][k] };
+					u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+					if (!(u >= -BVHEdgeEpsilon)) return false;
+
+					float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+					v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * invDet;
+					if (!(v >= -BVHEdgeEpsilon) || !(u + v <= 1.0f + BVHEdgeEpsilon)) return false;
+
+					t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+					return t > 0.0f;
+				}
+
+				bool IntersectRay(const BVHView& bvh, const float* origin, const float* direction, float tMax,
+					bool anyHit, float* tuv, uint32_t* triangle)
+				{
+					float invD[3] = { SafeInverse(direction[0]), SafeInverse(direction[1]), SafeInverse(direction[2]) };
+					float tBest = tMax, uBest = 0.0f, vBest = 0.0f;
+					uint32_t best = BVHNoHit;
+
+					uint32_t stack[BVHStackSize];
+					int top = 0;
+					stack[top++] = bvh.Root;
+					while (top > 0)
+					{
+						uint32_t ref = stack[--top];
+						if (ref & BVHLeafBit)
+						{
+							uint32_t first = (ref & ~BVHLeafBit) >> 4;
+							uint32_t count = (ref & 15u) + 1;
+							for (uint32_t k = first; k < first + count; k++)
+							{
+								float t, u, v;
+								if (TriangleTest(bvh, k, origin, direction, t, u, v) && t < tBest)
+								{
+									tBest = t;
+									uBest = u;
+									vBest = v;
+									best = k;
+									if (anyHit) break;
+								}
+							}
+							if (anyHit && best != BVHNoHit) break;
+							continue;
+						}
+
+						// Children that hit, pushed far to near
+						const BVHNode& node = bvh.Nodes[ref];
+						uint32_t refs[4];
+						float tNear[4];
+						int hits = 0;
+						for (int c = 0; c < 4 && node.Child[c] != BVHNoHit; c++)
+						{
+							float t0 = 0.0f, t1 = tBest;
+							for (int a = 0; a < 3; a++)
+							{
+								float lo = node.Origin[a] + static_cast<float>(node.Lo[a][c]) * node.Scale[a];
+								float hi = node.Origin[a] + static_cast<float>(node.Hi[a][c]) * node.Scale[a];
+								float tl = (lo - origin[a]) * invD[a];
+								float th = (hi - origin[a]) * invD[a];
+								t0 = std::max(t0, std::min(tl, th));
+								t1 = std::min(t1, std::max(tl, th));
+							}
+							if (t0 > t1 * BVHBoxSlack) continue;
+
+							int j = hits++;
+							for (; j > 0 && tNear[j - 1] < t0; j--)
+							{
+								refs[j] = refs[j - 1];
+								tNear[j] = tNear[j - 1];
+							}
+							refs[j] = node.Child[c];
+							tNear[j] = t0;
+						}
+						for (int i = 0; i < hits; i++) stack[top++] = refs[i];
+					}
+
+					*triangle = best;
+					if (best == BVHNoHit) return false;
+					tuv[0] = tBest;
+					tuv[1] = uBest;
+					tuv[2] = vBest;
+					return true;
+				}
+
+				void IntersectRays(const BVHView& bvh, const StreamIn& origins, const StreamIn& directions,
+					float tMax, bool anyHit, const RayHitsOut& out, size_t count)
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						float origin[3] = { origins.C[0][i], origins.C[1][i], origins.C[2][i] };
+						float direction[3] = { directions.C[0][i], directions.C[1][i], directions.C[2][i] };
+						float tuv[3] = { tMax, 0.0f, 0.0f };
+						IntersectRay(bvh, origin, direction, tMax, anyHit, tuv, &out.Triangle[i]);
+						out.T[i] = tuv[0];
+						out.U[i] = tuv[1];
+						out.V[i] = tuv[2];
+					}
+				}
+			}
+
+			const KernelTable& GetScalarKernels()
+			{
+				static const KernelTable table = {
+					&TransformPoints,
+					&MultiplyMatrices,
+					&MultiplyByMatrix,
+					&ComposeTransforms,
+					&EulerToQuaternions,
+					&QuaternionsToEuler,
+					&CullSpheres,
+					&CullBoxes,
+					&IntersectRay,
+					&IntersectRays
+				};
+				return table;
+			}
+		}
+	}
+}
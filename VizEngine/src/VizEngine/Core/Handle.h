@@ -0,0 +1,76 @@
+// VizEngine/src/VizEngine/Core/Handle.h
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace VizEngine
+{
+	/**
+	 * 32-bit generational handle to an entry in a ResourcePool<T>.
+	 *
+	 * Low 20 bits: slot index (up to ~1M live entries per pool)
+	 * High 12 bits: generation, bumped every time the slot is reused
+	 *
+	 * A handle whose generation no longer matches its slot is stale and
+	 * resolves to nullptr, so dangling references are detected instead of
+	 * aliasing whatever reused the slot. Value 0 is the null handle
+	 * (generations start at 1). Handles are trivially copyable: passing one
+	 * around costs nothing, unlike shared_ptr's atomic refcount.
+	 */
+	template<typename T>
+	struct Handle
+	{
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t GenerationBits = 12;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1u;
+		static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1u;
+		static constexpr uint32_t MaxIndex = IndexMask;
+
+		uint32_t Value = 0;
+
+		constexpr Handle() = default;
+
+		static constexpr Handle Make(uint32_t index, uint32_t generation)
+		{
+			Handle h;
+			h.Value = (index & IndexMask) | ((generation & GenerationMask) << IndexBits);
+			return h;
+		}
+
+		constexpr uint32_t Index() const { return Value & IndexMask; }
+		constexpr uint32_t Generation() const { return (Value >> IndexBits) & GenerationMask; }
+
+		constexpr bool IsNull() const { return Value == 0; }
+		constexpr explicit operator bool() const { return Value != 0; }
+
+		constexpr bool operator==(const Handle& other) const { return Value == other.Value; }
+		constexpr bool operator!=(const Handle& other) const { return Value != other.Value; }
+	};
+
+	static_assert(sizeof(Handle<int>) == 4, "Handles must stay 32 bits");
+
+	// Resource handle types used by the render path
+	class Mesh;
+	class Texture;
+	class Shader;
+	class RenderMaterial;
+
+	using MeshHandle = Handle<Mesh>;
+	using TextureHandle = Handle<Texture>;
+	using ShaderHandle = Handle<Shader>;
+	using MaterialHandle = Handle<RenderMaterial>;
+}
+
+namespace std
+{
+	template<typename T>
+	struct hash<VizEngine::Handle<T>>
+	{
+		size_t operator()(const VizEngine::Handle<T>& handle) const noexcept
+		{
+			return std::hash<uint32_t>()(handle.Value);
+		}
+	};
+}
@@ -0,0 +1,149 @@
+// VizEngine/src/VizEngine/Core/MappedFile.cpp
+
+#include "MappedFile.h"
+#include "VizEngine/Log.h"
+
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace VizEngine
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_Data(std::exchange(other.m_Data, nullptr))
+		, m_Size(std::exchange(other.m_Size, 0))
+		, m_File(std::exchange(other.m_File, -1))
+		, m_Mapping(std::exchange(other.m_Mapping, 0))
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+			m_File = std::exchange(other.m_File, -1);
+			m_Mapping = std::exchange(other.m_Mapping, 0);
+		}
+		return *this;
+	}
+
+#ifdef _WIN32
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			VP_CORE_ERROR("MappedFile: cannot open '{}'", path);
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			VP_CORE_ERROR("MappedFile: '{}' is empty or unreadable", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!data)
+		{
+			VP_CORE_ERROR("MappedFile: cannot map '{}' (error {})", path, GetLastError());
+			if (mapping) CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(size.QuadPart);
+		m_File = reinterpret_cast<intptr_t>(file);
+		m_Mapping = reinterpret_cast<intptr_t>(mapping);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data) UnmapViewOfFile(m_Data);
+		if (m_Mapping) CloseHandle(reinterpret_cast<HANDLE>(m_Mapping));
+		if (m_File != -1) CloseHandle(reinterpret_cast<HANDLE>(m_File));
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_File = -1;
+		m_Mapping = 0;
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			VP_CORE_ERROR("MappedFile: cannot open '{}'", path);
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			VP_CORE_ERROR("MappedFile: '{}' is empty or unreadable", path);
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			VP_CORE_ERROR("MappedFile: cannot map '{}'", path);
+			::close(fd);
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(info.st_size);
+		m_File = fd;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data) munmap(const_cast<uint8_t*>(m_Data), m_Size);
+		if (m_File != -1) ::close(static_cast<int>(m_File));
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_File = -1;
+		m_Mapping = 0;
+	}
+
+#endif
+}
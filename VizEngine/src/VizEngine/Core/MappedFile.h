@@ -0,0 +1,52 @@
+// VizEngine/src/VizEngine/Core/MappedFile.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace VizEngine
+{
+	/**
+	 * Read-only memory mapping of a whole file.
+	 *
+	 * The OS pages the file in on first access instead of copying it into a
+	 * heap buffer, so opening a large file is cheap and untouched parts never
+	 * cost anything. The data stays valid until Close() or destruction.
+	 */
+	class VizEngine_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		// Non-copyable
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Movable
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/**
+		 * Map a file, closing any previous mapping.
+		 * @return false if the file cannot be opened or mapped (logged)
+		 */
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+		// Platform handles (file descriptor on POSIX)
+		intptr_t m_File = -1;
+		intptr_t m_Mapping = 0;
+	};
+}
@@ -29,9 +29,9 @@ namespace VizEngine
 
 		// Textures (nullptr if not present)
 		std::shared_ptr<Texture> BaseColorTexture = nullptr;
-		std::shared_ptr<Texture> MetallicRoughnessTexture = nullptr;  // G=roughness, B=metallic
+		std::shared_ptr<Texture> MetallicRoughnessTexture = nullptr;  // G=roughness, B=metallic (R=occlusion if ORM)
 		std::shared_ptr<Texture> NormalTexture = nullptr;
-		std::shared_ptr<Texture> OcclusionTexture = nullptr;
+		std::shared_ptr<Texture> OcclusionTexture = nullptr;          // R=occlusion; same object as above if ORM
 		std::shared_ptr<Texture> EmissiveTexture = nullptr;
 
 		// Emissive
@@ -64,6 +64,10 @@ namespace VizEngine
 		bool HasNormalTexture() const { return NormalTexture != nullptr; }
 		bool HasOcclusionTexture() const { return OcclusionTexture != nullptr; }
 		bool HasEmissiveTexture() const { return EmissiveTexture != nullptr; }
+
+		// Occlusion, roughness and metallic in one texture (R/G/B): the glTF
+		// importer packs separate images or detects sources that share one
+		bool HasPackedORM() const { return OcclusionTexture && OcclusionTexture == MetallicRoughnessTexture; }
 		bool HasAnyTexture() const 
 		{ 
 			return HasBaseColorTexture() || HasMetallicRoughnessTexture() || 
@@ -1,5 +1,7 @@
 #include "Mesh.h"
+#include "Profiler.h"
 #include <cmath>
+#include <string>
 
 namespace VizEngine
 {
@@ -97,6 +99,7 @@ namespace VizEngine
 
 	void Mesh::SetupMesh(const float* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount)
 	{
+		VP_PROFILE_EVENT(Upload, "Mesh " + std::to_string(vertexDataSize / sizeof(Vertex)) + " vertices");
 		m_VertexArray = std::make_unique<VertexArray>();
 		m_VertexBuffer = std::make_unique<VertexBuffer>(vertexData, static_cast<unsigned int>(vertexDataSize));
 
@@ -110,6 +113,38 @@ namespace VizEngine
 
 		m_VertexArray->LinkVertexBuffer(*m_VertexBuffer, layout);
 		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, static_cast<unsigned int>(indexCount));
+
+		// Bounds for culling (vertex data is interleaved Vertex structs)
+		const size_t floatsPerVertex = sizeof(Vertex) / sizeof(float);
+		const size_t vertexCount = vertexDataSize / sizeof(Vertex);
+		m_VertexCount = vertexCount;
+		if (vertexCount > 0)
+		{
+			m_BoundsMin = glm::vec3(vertexData[0], vertexData[1], vertexData[2]);
+			m_BoundsMax = m_BoundsMin;
+			for (size_t i = 1; i < vertexCount; i++)
+			{
+				const float* p = vertexData + i * floatsPerVertex;
+				glm::vec3 position(p[0], p[1], p[2]);
+				m_BoundsMin = glm::min(m_BoundsMin, position);
+				m_BoundsMax = glm::max(m_BoundsMax, position);
+			}
+		}
+	}
+
+	std::shared_ptr<const MeshBVH> Mesh::BuildBVH(const MeshBVHBuildSettings& settings)
+	{
+		// The buffers are the only copy of the geometry
+		std::vector<Vertex> vertices(m_VertexCount);
+		std::vector<unsigned int> indices(GetIndexCount());
+		glGetNamedBufferSubData(m_VertexBuffer->GetID(), 0,
+			static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)), vertices.data());
+		glGetNamedBufferSubData(m_IndexBuffer->GetID(), 0,
+			static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned int)), indices.data());
+
+		m_BVH = MeshBVH::Build(&vertices.data()->Position.x, sizeof(Vertex), vertices.size(),
+			indices.data(), indices.size(), settings);
+		return m_BVH;
 	}
 
 	void Mesh::Bind() const
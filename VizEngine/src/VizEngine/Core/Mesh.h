@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VizEngine/Core.h"
+#include "VizEngine/Core/MeshBVH.h"
 #include "glm.hpp"
 #include "VizEngine/OpenGL/VertexArray.h"
 #include "VizEngine/OpenGL/VertexBuffer.h"
@@ -53,9 +54,32 @@ namespace VizEngine
 		void Unbind() const;
 
 		unsigned int GetIndexCount() const { return m_IndexBuffer->GetCount(); }
+		size_t GetVertexCount() const { return m_VertexCount; }
 		const VertexArray& GetVertexArray() const { return *m_VertexArray; }
+		const VertexBuffer& GetVertexBuffer() const { return *m_VertexBuffer; }
 		const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
 
+		// Local-space bounds (computed from vertex positions at creation)
+		const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+		const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+		glm::vec3 GetBoundsCenter() const { return (m_BoundsMin + m_BoundsMax) * 0.5f; }
+		float GetBoundsRadius() const { return glm::length(m_BoundsMax - m_BoundsMin) * 0.5f; }
+
+		/**
+		 * Build the optional CPU-side triangle BVH for ray queries (picking,
+		 * occlusion). Reads the vertex and index buffers back from the GPU,
+		 * so call it on the GL thread; the BVH itself can then be queried from
+		 * any thread. Rebuilds if one exists.
+		 * @return The BVH, or nullptr if the mesh has no valid triangles
+		 */
+		std::shared_ptr<const MeshBVH> BuildBVH(const MeshBVHBuildSettings& settings = {});
+
+		/** @return The BVH from BuildBVH()/SetBVH(), or nullptr */
+		const std::shared_ptr<const MeshBVH>& GetBVH() const { return m_BVH; }
+
+		/** Attach a BVH built elsewhere (e.g. on a worker from the source data). */
+		void SetBVH(std::shared_ptr<const MeshBVH> bvh) { m_BVH = std::move(bvh); }
+
 		// Factory methods for common shapes
 		static std::unique_ptr<Mesh> CreatePyramid();
 		static std::unique_ptr<Mesh> CreateCube();
@@ -68,6 +92,12 @@ namespace VizEngine
 		std::unique_ptr<VertexArray> m_VertexArray;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+
+		glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+		glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+		size_t m_VertexCount = 0;
+
+		std::shared_ptr<const MeshBVH> m_BVH;
 	};
 }
 
@@ -0,0 +1,724 @@
+// VizEngine/src/VizEngine/Core/MeshBVH.cpp
+
+#include "MeshBVH.h"
+#include "BatchMathKernels.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace VizEngine
+{
+	using BatchMath::Detail::BVHNode;
+	using BatchMath::Detail::BVHView;
+	using BatchMath::Detail::BVHLeafBit;
+	using BatchMath::Detail::BVHNoHit;
+
+	struct MeshBVH::Storage
+	{
+		std::vector<BVHNode> Nodes;
+		std::vector<float> Tri[9];            // v0 xyz, edge1 xyz, edge2 xyz in leaf order
+		std::vector<uint32_t> TriangleIds;    // Leaf order -> index buffer triangle
+		uint32_t Root = 0;
+
+		BVHView View() const
+		{
+			BVHView view;
+			view.Nodes = Nodes.data();
+			view.Root = Root;
+			for (int c = 0; c < 9; c++) view.Tri[c] = Tri[c].data();
+			return view;
+		}
+	};
+
+	namespace
+	{
+		constexpr int BinCount = 16;
+		constexpr uint32_t ParallelBinThreshold = 65536;    // Triangles before binning is split across threads
+		constexpr uint32_t ParallelTaskThreshold = 4096;    // Triangles before a subtree becomes a task
+		constexpr uint32_t MedianSplitDepth = 32;
+		constexpr uint32_t MaxTriangles = (1u << 27) - 16;  // Leaf references keep 27 bits of triangle index
+		constexpr float TraversalCost = 1.0f;               // Relative to one triangle test
+
+		// =====================================================================
+		// Build tree
+		// =====================================================================
+
+		struct Box
+		{
+			float Min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			float Max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+			void Grow(const float* p)
+			{
+				for (int a = 0; a < 3; a++)
+				{
+					Min[a] = std::min(Min[a], p[a]);
+					Max[a] = std::max(Max[a], p[a]);
+				}
+			}
+
+			void Grow(const Box& b)
+			{
+				for (int a = 0; a < 3; a++)
+				{
+					Min[a] = std::min(Min[a], b.Min[a]);
+					Max[a] = std::max(Max[a], b.Max[a]);
+				}
+			}
+
+			float Area() const
+			{
+				if (Min[0] > Max[0]) return 0.0f;
+				float dx = Max[0] - Min[0], dy = Max[1] - Min[1], dz = Max[2] - Min[2];
+				return 2.0f * (dx * dy + dy * dz + dz * dx);
+			}
+		};
+
+		struct Primitive
+		{
+			Box Bounds;
+			float Center[3];
+		};
+
+		struct BuildNode
+		{
+			Box Bounds;
+			std::unique_ptr<BuildNode> Child[2];
+			uint32_t First = 0;    // Range of the triangle order, leaves only
+			uint32_t Count = 0;
+
+			bool IsLeaf() const { return !Child[0]; }
+		};
+
+		struct Bins
+		{
+			Box Bounds[3][BinCount];
+			uint32_t Count[3][BinCount] = {};
+		};
+
+		/** Run fn(begin, end, chunk) over up to `chunks` slices, all but the first as tasks. */
+		template<typename Fn>
+		void ForChunks(uint32_t begin, uint32_t end, unsigned chunks, const Fn& fn)
+		{
+			uint32_t step = (end - begin + chunks - 1) / chunks;
+			std::vector<std::future<void>> jobs;
+			for (unsigned c = 1; c < chunks; c++)
+			{
+				uint32_t b = begin + c * step;
+				uint32_t e = std::min(end, b + step);
+				if (b < e) jobs.push_back(std::async(std::launch::async, [&fn, b, e, c]() { fn(b, e, c); }));
+			}
+			fn(begin, std::min(end, begin + step), 0u);
+			for (auto& job : jobs) job.get();
+		}
+
+		class Builder
+		{
+		public:
+			Builder(const std::vector<Primitive>& primitives, std::vector<uint32_t>& order,
+				uint32_t maxLeafSize, unsigned threads)
+				: m_Primitives(primitives), m_Order(order), m_MaxLeafSize(maxLeafSize), m_Threads(threads)
+			{
+				while ((1u << m_TaskDepth) < threads * 2) m_TaskDepth++;
+			}
+
+			std::unique_ptr<BuildNode> Build(uint32_t begin, uint32_t end, uint32_t depth)
+			{
+				auto node = std::make_unique<BuildNode>();
+				const uint32_t count = end - begin;
+				const bool parallel = count >= ParallelBinThreshold && m_Threads > 1;
+
+				// Bounds of the triangles and of their centroids
+				Box centroids;
+				if (parallel)
+				{
+					std::vector<Box> bounds(m_Threads), centers(m_Threads);
+					ForChunks(begin, end, m_Threads, [&](uint32_t b, uint32_t e, unsigned chunk)
+					{
+						GrowBounds(b, e, bounds[chunk], centers[chunk]);
+					});
+					for (unsigned i = 0; i < m_Threads; i++)
+					{
+						node->Bounds.Grow(bounds[i]);
+						centroids.Grow(centers[i]);
+					}
+				}
+				else
+				{
+					GrowBounds(begin, end, node->Bounds, centroids);
+				}
+
+				UpdateDepth(depth);
+				if (count <= 1)
+				{
+					node->First = begin;
+					node->Count = count;
+					return node;
+				}
+
+				uint32_t mid = begin;
+				int largest = 0;
+				for (int a = 1; a < 3; a++)
+				{
+					if (centroids.Max[a] - centroids.Min[a] > centroids.Max[largest] - centroids.Min[largest]) largest = a;
+				}
+				const bool degenerate = !(centroids.Max[largest] > centroids.Min[largest]);
+
+				if (!degenerate && depth < MedianSplitDepth)
+				{
+					float k[3];
+					for (int a = 0; a < 3; a++)
+					{
+						float extent = centroids.Max[a] - centroids.Min[a];
+						k[a] = extent > 0.0f ? BinCount * (1.0f - 1e-6f) / extent : 0.0f;
+					}
+
+					Bins bins;
+					if (parallel)
+					{
+						std::vector<Bins> partial(m_Threads);
+						ForChunks(begin, end, m_Threads, [&](uint32_t b, uint32_t e, unsigned chunk)
+						{
+							Bin(b, e, centroids, k, partial[chunk]);
+						});
+						for (const Bins& p : partial)
+						{
+							for (int a = 0; a < 3; a++)
+							{
+								for (int i = 0; i < BinCount; i++)
+								{
+									bins.Bounds[a][i].Grow(p.Bounds[a][i]);
+									bins.Count[a][i] += p.Count[a][i];
+								}
+							}
+						}
+					}
+					else
+					{
+						Bin(begin, end, centroids, k, bins);
+					}
+
+					// Sweep: cost of splitting after bin i on each axis
+					float bestCost = FLT_MAX;
+					int bestAxis = -1, bestBin = 0;
+					for (int a = 0; a < 3; a++)
+					{
+						if (k[a] == 0.0f) continue;
+
+						float rightArea[BinCount];
+						uint32_t rightCount[BinCount];
+						Box right;
+						uint32_t n = 0;
+						for (int i = BinCount - 1; i > 0; i--)
+						{
+							right.Grow(bins.Bounds[a][i]);
+							n += bins.Count[a][i];
+							rightArea[i] = right.Area();
+							rightCount[i] = n;
+						}
+
+						Box left;
+						n = 0;
+						for (int i = 0; i < BinCount - 1; i++)
+						{
+							left.Grow(bins.Bounds[a][i]);
+							n += bins.Count[a][i];
+							if (n == 0 || rightCount[i + 1] == 0) continue;
+							float cost = left.Area() * n + rightArea[i + 1] * rightCount[i + 1];
+							if (cost < bestCost)
+							{
+								bestCost = cost;
+								bestAxis = a;
+								bestBin = i;
+							}
+						}
+					}
+
+					float area = node->Bounds.Area();
+					float splitCost = TraversalCost + (area > 0.0f ? bestCost / area : 0.0f);
+					if (count <= m_MaxLeafSize && (bestAxis < 0 || static_cast<float>(count) <= splitCost))
+					{
+						node->First = begin;
+						node->Count = count;
+						return node;
+					}
+
+					if (bestAxis >= 0)
+					{
+						const float minC = centroids.Min[bestAxis];
+						const float kA = k[bestAxis];
+						auto split = std::partition(m_Order.begin() + begin, m_Order.begin() + end, [&](uint32_t t)
+						{
+							return BinIndex(m_Primitives[t].Center[bestAxis], minC, kA) <= bestBin;
+						});
+						mid = static_cast<uint32_t>(split - m_Order.begin());
+					}
+				}
+
+				// Identical centroids, depth limit or a one-sided partition
+				if (mid == begin || mid == end)
+				{
+					if (count <= m_MaxLeafSize)
+					{
+						node->First = begin;
+						node->Count = count;
+						return node;
+					}
+					mid = begin + count / 2;
+					std::nth_element(m_Order.begin() + begin, m_Order.begin() + mid, m_Order.begin() + end,
+						[&](uint32_t a, uint32_t b)
+						{
+							return m_Primitives[a].Center[largest] < m_Primitives[b].Center[largest];
+						});
+				}
+
+				if (count >= ParallelTaskThreshold && depth < m_TaskDepth)
+				{
+					auto left = std::async(std::launch::async, [this, begin, mid, depth]()
+					{
+						return Build(begin, mid, depth + 1);
+					});
+					node->Child[1] = Build(mid, end, depth + 1);
+					node->Child[0] = left.get();
+				}
+				else
+				{
+					node->Child[0] = Build(begin, mid, depth + 1);
+					node->Child[1] = Build(mid, end, depth + 1);
+				}
+				return node;
+			}
+
+			uint32_t GetDepth() const { return m_Depth.load(); }
+
+		private:
+			static int BinIndex(float center, float min, float k)
+			{
+				return std::min(BinCount - 1, static_cast<int>((center - min) * k));
+			}
+
+			void GrowBounds(uint32_t begin, uint32_t end, Box& bounds, Box& centroids) const
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const Primitive& p = m_Primitives[m_Order[i]];
+					bounds.Grow(p.Bounds);
+					centroids.Grow(p.Center);
+				}
+			}
+
+			void Bin(uint32_t begin, uint32_t end, const Box& centroids, const float* k, Bins& bins) const
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const Primitive& p = m_Primitives[m_Order[i]];
+					for (int a = 0; a < 3; a++)
+					{
+						int b = BinIndex(p.Center[a], centroids.Min[a], k[a]);
+						bins.Count[a][b]++;
+						bins.Bounds[a][b].Grow(p.Bounds);
+					}
+				}
+			}
+
+			void UpdateDepth(uint32_t depth)
+			{
+				uint32_t current = m_Depth.load();
+				while (depth > current && !m_Depth.compare_exchange_weak(current, depth)) {}
+			}
+
+			const std::vector<Primitive>& m_Primitives;
+			std::vector<uint32_t>& m_Order;
+			uint32_t m_MaxLeafSize;
+			unsigned m_Threads;
+			uint32_t m_TaskDepth = 0;
+			std::atomic<uint32_t> m_Depth{ 0 };
+		};
+
+		// =====================================================================
+		// Compression
+		// =====================================================================
+
+		/**
+		 * Quantize up to four child boxes against their parent's box: per axis
+		 * the smallest power-of-two step that spans the parent in 255 steps,
+		 * then each bound rounded outwards and checked with the exact decode
+		 * the traversal uses.
+		 */
+		void Quantize(const Box& parent, const BuildNode* const* children, int count, BVHNode& out)
+		{
+			for (int a = 0; a < 3; a++)
+			{
+				const float origin = parent.Min[a];
+				const float extent = parent.Max[a] - parent.Min[a];
+				int exponent = -126;
+				if (extent > 0.0f)
+				{
+					std::frexp(extent / 255.0f, &exponent);
+					exponent = std::clamp(exponent, -126, 127);
+				}
+
+				for (;; exponent++)
+				{
+					const float scale = std::ldexp(1.0f, exponent);
+					auto decode = [&](int q) { return origin + static_cast<float>(q) * scale; };
+
+					bool fits = true;
+					for (int c = 0; c < count && fits; c++)
+					{
+						const Box& box = children[c]->Bounds;
+						int lo = std::clamp(static_cast<int>(std::floor((box.Min[a] - origin) / scale)), 0, 255);
+						while (lo > 0 && decode(lo) > box.Min[a]) lo--;
+						int hi = std::clamp(static_cast<int>(std::ceil((box.Max[a] - origin) / scale)), 0, 255);
+						while (hi < 255 && decode(hi) < box.Max[a]) hi++;
+
+						fits = decode(lo) <= box.Min[a] && decode(hi) >= box.Max[a];
+						out.Lo[a][c] = static_cast<uint8_t>(lo);
+						out.Hi[a][c] = static_cast<uint8_t>(hi);
+					}
+					if (fits || exponent >= 127)
+					{
+						out.Origin[a] = origin;
+						out.Scale[a] = scale;
+						break;
+					}
+				}
+			}
+		}
+
+		class Flattener
+		{
+		public:
+			Flattener(MeshBVH::Storage& storage, const std::vector<uint32_t>& order, const std::vector<float>& triangles)
+				: m_Storage(storage), m_Order(order), m_Triangles(triangles) {}
+
+			uint32_t Leaf(const BuildNode& leaf)
+			{
+				uint32_t first = static_cast<uint32_t>(m_Storage.TriangleIds.size());
+				for (uint32_t i = leaf.First; i < leaf.First + leaf.Count; i++)
+				{
+					uint32_t primitive = m_Order[i];
+					const float* t = &m_Triangles[primitive * 10];    // 9 floats + original index
+					for (int c = 0; c < 9; c++) m_Storage.Tri[c].push_back(t[c]);
+					uint32_t id;
+					std::memcpy(&id, &t[9], sizeof(id));
+					m_Storage.TriangleIds.push_back(id);
+				}
+				m_Leaves++;
+				return BVHLeafBit | (first << 4) | (leaf.Count - 1);
+			}
+
+			uint32_t Node(const BuildNode& node)
+			{
+				// Open the largest inner child until there are four
+				const BuildNode* children[4] = { node.Child[0].get(), node.Child[1].get() };
+				int count = 2;
+				while (count < 4)
+				{
+					int open = -1;
+					float openArea = -1.0f;
+					for (int c = 0; c < count; c++)
+					{
+						if (!children[c]->IsLeaf() && children[c]->Bounds.Area() > openArea)
+						{
+							open = c;
+							openArea = children[c]->Bounds.Area();
+						}
+					}
+					if (open < 0) break;
+					const BuildNode* opened = children[open];
+					children[open] = opened->Child[0].get();
+					children[count++] = opened->Child[1].get();
+				}
+
+				BVHNode out = {};
+				Quantize(node.Bounds, children, count, out);
+
+				uint32_t index = static_cast<uint32_t>(m_Storage.Nodes.size());
+				m_Storage.Nodes.push_back(out);
+				for (int c = 0; c < 4; c++)
+				{
+					uint32_t ref = BVHNoHit;
+					if (c < count) ref = children[c]->IsLeaf() ? Leaf(*children[c]) : Node(*children[c]);
+					m_Storage.Nodes[index].Child[c] = ref;
+				}
+				return index;
+			}
+
+			size_t GetLeafCount() const { return m_Leaves; }
+
+		private:
+			MeshBVH::Storage& m_Storage;
+			const std::vector<uint32_t>& m_Order;
+			const std::vector<float>& m_Triangles;
+			size_t m_Leaves = 0;
+		};
+
+		double Seconds(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	// =========================================================================
+	// MeshBVH
+	// =========================================================================
+
+	MeshBVH::MeshBVH() : m_Storage(std::make_unique<Storage>()) {}
+	MeshBVH::~MeshBVH() = default;
+
+	std::unique_ptr<MeshBVH> MeshBVH::Build(const float* positions, size_t strideBytes, size_t vertexCount,
+		const uint32_t* indices, size_t indexCount, const MeshBVHBuildSettings& settings)
+	{
+		auto start = std::chrono::steady_clock::now();
+		const size_t triangleCount = indexCount / 3;
+		if (triangleCount > MaxTriangles)
+		{
+			VP_CORE_ERROR("MeshBVH: {} triangles exceed the limit of {}", triangleCount, MaxTriangles);
+			return nullptr;
+		}
+
+		auto position = [&](uint32_t index)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + index * strideBytes);
+		};
+
+		// Valid triangles: bounds and centroid for the build, vertex + edges
+		// (and the original index) for the leaves
+		std::vector<Primitive> primitives;
+		std::vector<float> triangles;
+		primitives.reserve(triangleCount);
+		triangles.reserve(triangleCount * 10);
+		size_t skipped = 0;
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			const uint32_t* tri = indices + t * 3;
+			if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount)
+			{
+				skipped++;
+				continue;
+			}
+			const float* v[3] = { position(tri[0]), position(tri[1]), position(tri[2]) };
+			bool finite = true;
+			for (int i = 0; i < 3; i++)
+			{
+				for (int a = 0; a < 3; a++) finite = finite && std::isfinite(v[i][a]);
+			}
+			if (!finite)
+			{
+				skipped++;
+				continue;
+			}
+
+			Primitive p;
+			for (int i = 0; i < 3; i++) p.Bounds.Grow(v[i]);
+			for (int a = 0; a < 3; a++) p.Center[a] = (p.Bounds.Min[a] + p.Bounds.Max[a]) * 0.5f;
+			primitives.push_back(p);
+
+			for (int a = 0; a < 3; a++) triangles.push_back(v[0][a]);
+			for (int a = 0; a < 3; a++) triangles.push_back(v[1][a] - v[0][a]);
+			for (int a = 0; a < 3; a++) triangles.push_back(v[2][a] - v[0][a]);
+			uint32_t id = static_cast<uint32_t>(t);
+			float packed;
+			std::memcpy(&packed, &id, sizeof(id));
+			triangles.push_back(packed);
+		}
+
+		if (skipped > 0)
+		{
+			VP_CORE_WARN("MeshBVH: skipped {} triangles with invalid indices or positions", skipped);
+		}
+		if (primitives.empty())
+		{
+			VP_CORE_ERROR("MeshBVH: no valid triangles");
+			return nullptr;
+		}
+
+		unsigned threads = settings.Threads ? settings.Threads : std::max(1u, std::thread::hardware_concurrency());
+		uint32_t maxLeafSize = std::clamp(settings.MaxLeafSize, 1u, 16u);
+
+		std::vector<uint32_t> order(primitives.size());
+		for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+
+		Builder builder(primitives, order, maxLeafSize, threads);
+		std::unique_ptr<BuildNode> root = builder.Build(0, static_cast<uint32_t>(primitives.size()), 0);
+
+		std::unique_ptr<MeshBVH> bvh(new MeshBVH());
+		Storage& storage = *bvh->m_Storage;
+		for (auto& component : storage.Tri) component.reserve(primitives.size() + 16);
+		storage.TriangleIds.reserve(primitives.size());
+
+		Flattener flattener(storage, order, triangles);
+		storage.Root = root->IsLeaf() ? flattener.Leaf(*root) : flattener.Node(*root);
+
+		// Whole-vector loads past the last leaf read zeros (det == 0, never a hit)
+		for (auto& component : storage.Tri) component.resize(component.size() + 16, 0.0f);
+
+		bvh->m_BoundsMin = glm::vec3(root->Bounds.Min[0], root->Bounds.Min[1], root->Bounds.Min[2]);
+		bvh->m_BoundsMax = glm::vec3(root->Bounds.Max[0], root->Bounds.Max[1], root->Bounds.Max[2]);
+
+		MeshBVHStats& stats = bvh->m_Stats;
+		stats.Triangles = primitives.size();
+		stats.Nodes = storage.Nodes.size();
+		stats.Leaves = flattener.GetLeafCount();
+		stats.Depth = builder.GetDepth();
+		stats.MemoryBytes = storage.Nodes.size() * sizeof(BVHNode) +
+			storage.Tri[0].size() * sizeof(float) * 9 + storage.TriangleIds.size() * sizeof(uint32_t);
+		stats.BuildMs = Seconds(start) * 1000.0;
+
+		VP_CORE_INFO("MeshBVH: {} triangles, {} nodes, {} leaves, depth {}, {:.1f} KB, built in {:.1f} ms",
+			stats.Triangles, stats.Nodes, stats.Leaves, stats.Depth, stats.MemoryBytes / 1024.0, stats.BuildMs);
+		return bvh;
+	}
+
+	// =========================================================================
+	// Queries
+	// =========================================================================
+
+	bool MeshBVH::Intersect(const glm::vec3& origin, const glm::vec3& direction, RayHit& hit, float tMax) const
+	{
+		float tuv[3];
+		uint32_t triangle = BVHNoHit;
+		BatchMath::Detail::GetActiveKernels().IntersectRay(m_Storage->View(), &origin.x, &direction.x, tMax,
+			false, tuv, &triangle);
+
+		hit = RayHit();
+		if (triangle == BVHNoHit) return false;
+		hit.T = tuv[0];
+		hit.U = tuv[1];
+		hit.V = tuv[2];
+		hit.Triangle = m_Storage->TriangleIds[triangle];
+		return true;
+	}
+
+	bool MeshBVH::Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+	{
+		float tuv[3];
+		uint32_t triangle = BVHNoHit;
+		return BatchMath::Detail::GetActiveKernels().IntersectRay(m_Storage->View(), &origin.x, &direction.x, tMax,
+			true, tuv, &triangle);
+	}
+
+	namespace
+	{
+		bool SameRayCount(const Vec3Stream& origins, const Vec3Stream& directions, const char* function)
+		{
+			if (origins.Size() == directions.Size()) return true;
+			VP_CORE_ERROR("MeshBVH::{}: {} origins but {} directions", function, origins.Size(), directions.Size());
+			return false;
+		}
+
+		BatchMath::Detail::StreamIn In(const Vec3Stream& s)
+		{
+			BatchMath::Detail::StreamIn v;
+			v.C[0] = s.X.data();
+			v.C[1] = s.Y.data();
+			v.C[2] = s.Z.data();
+			return v;
+		}
+
+		BatchMath::Detail::RayHitsOut Out(RayHitStream& hits)
+		{
+			BatchMath::Detail::RayHitsOut out;
+			out.T = hits.T.data();
+			out.U = hits.U.data();
+			out.V = hits.V.data();
+			out.Triangle = hits.Triangle.data();
+			return out;
+		}
+	}
+
+	void MeshBVH::Intersect(const Vec3Stream& origins, const Vec3Stream& directions, RayHitStream& hits,
+		float tMax) const
+	{
+		if (!SameRayCount(origins, directions, "Intersect")) return;
+		hits.Resize(origins.Size());
+		BatchMath::Detail::GetActiveKernels().IntersectRays(m_Storage->View(), In(origins), In(directions), tMax,
+			false, Out(hits), origins.Size());
+
+		for (uint32_t& triangle : hits.Triangle)
+		{
+			if (triangle != BVHNoHit) triangle = m_Storage->TriangleIds[triangle];
+		}
+	}
+
+	void MeshBVH::Occluded(const Vec3Stream& origins, const Vec3Stream& directions, std::vector<uint8_t>& occluded,
+		float tMax) const
+	{
+		if (!SameRayCount(origins, directions, "Occluded")) return;
+		RayHitStream hits;
+		hits.Resize(origins.Size());
+		BatchMath::Detail::GetActiveKernels().IntersectRays(m_Storage->View(), In(origins), In(directions), tMax,
+			true, Out(hits), origins.Size());
+
+		occluded.resize(origins.Size());
+		for (size_t i = 0; i < occluded.size(); i++)
+		{
+			occluded[i] = hits.Triangle[i] != BVHNoHit ? 1 : 0;
+		}
+	}
+
+	std::vector<RayBenchmarkResult> MeshBVH::Benchmark(const Vec3Stream& origins, const Vec3Stream& directions,
+		int repeats) const
+	{
+		std::vector<RayBenchmarkResult> results;
+		if (!SameRayCount(origins, directions, "Benchmark") || origins.Size() == 0) return results;
+		repeats = std::max(1, repeats);
+
+		const BVHView view = m_Storage->View();
+		const double rays = static_cast<double>(origins.Size()) * repeats;
+		RayHitStream hits;
+		hits.Resize(origins.Size());
+
+		const SimdISA previous = BatchMath::GetActiveISA();
+		const int detected = static_cast<int>(BatchMath::GetDetectedISA());
+		for (int i = 0; i <= detected; i++)
+		{
+			SimdISA isa = static_cast<SimdISA>(i);
+			if (!BatchMath::SetActiveISA(isa)) continue;
+			const auto& kernels = BatchMath::Detail::GetActiveKernels();
+
+			RayBenchmarkResult result;
+			result.ISA = isa;
+			result.PacketWidth = BatchMath::GetLaneCount(isa);
+
+			auto start = std::chrono::steady_clock::now();
+			for (int r = 0; r < repeats; r++)
+			{
+				for (size_t ray = 0; ray < origins.Size(); ray++)
+				{
+					float origin[3] = { origins.X[ray], origins.Y[ray], origins.Z[ray] };
+					float direction[3] = { directions.X[ray], directions.Y[ray], directions.Z[ray] };
+					float tuv[3];
+					uint32_t triangle;
+					kernels.IntersectRay(view, origin, direction, FLT_MAX, false, tuv, &triangle);
+				}
+			}
+			result.SingleRaysPerSecond = rays / std::max(Seconds(start), 1e-9);
+
+			start = std::chrono::steady_clock::now();
+			for (int r = 0; r < repeats; r++)
+			{
+				kernels.IntersectRays(view, In(origins), In(directions), FLT_MAX, false, Out(hits), origins.Size());
+			}
+			result.PacketRaysPerSecond = rays / std::max(Seconds(start), 1e-9);
+
+			result.Hits = static_cast<size_t>(std::count_if(hits.Triangle.begin(), hits.Triangle.end(),
+				[](uint32_t t) { return t != BVHNoHit; }));
+			results.push_back(result);
+
+			VP_CORE_INFO("MeshBVH benchmark {}: {:.2f} Mrays/s single, {:.2f} Mrays/s {}-wide packets ({} hits)",
+				BatchMath::GetISAName(isa), result.SingleRaysPerSecond / 1e6, result.PacketRaysPerSecond / 1e6,
+				result.PacketWidth, result.Hits);
+		}
+		BatchMath::SetActiveISA(previous);
+		return results;
+	}
+}
@@ -0,0 +1,167 @@
+// VizEngine/src/VizEngine/Core/MeshBVH.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/BatchMath.h"
+#include "glm.hpp"
+#include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Result of a ray query. The hit point is origin + T * direction, so T is
+	 * in units of the direction's length (directions need not be normalized).
+	 */
+	struct VizEngine_API RayHit
+	{
+		static constexpr uint32_t NoTriangle = 0xFFFFFFFFu;
+
+		float T = 0.0f;
+		float U = 0.0f;                    // Barycentric weight of the triangle's second vertex
+		float V = 0.0f;                    // ... and of its third
+		uint32_t Triangle = NoTriangle;    // Index into the index buffer / 3
+
+		bool IsHit() const { return Triangle != NoTriangle; }
+	};
+
+	/**
+	 * Structure-of-arrays results of a ray stream, one entry per ray.
+	 * Misses have Triangle == RayHit::NoTriangle.
+	 */
+	struct VizEngine_API RayHitStream
+	{
+		std::vector<float> T, U, V;
+		std::vector<uint32_t> Triangle;
+
+		void Resize(size_t count) { T.resize(count); U.resize(count); V.resize(count); Triangle.resize(count); }
+		size_t Size() const { return T.size(); }
+
+		RayHit Get(size_t i) const
+		{
+			RayHit hit;
+			hit.T = T[i];
+			hit.U = U[i];
+			hit.V = V[i];
+			hit.Triangle = Triangle[i];
+			return hit;
+		}
+	};
+
+	struct VizEngine_API MeshBVHBuildSettings
+	{
+		uint32_t MaxLeafSize = 4;    // Triangles per leaf, 1-16
+		uint32_t Threads = 0;        // Builder threads, 0 = hardware concurrency
+	};
+
+	struct VizEngine_API MeshBVHStats
+	{
+		size_t Triangles = 0;
+		size_t Nodes = 0;            // 4-wide nodes
+		size_t Leaves = 0;
+		uint32_t Depth = 0;          // Of the binary build tree
+		size_t MemoryBytes = 0;
+		double BuildMs = 0.0;
+	};
+
+	/** Rays per second of one instruction set (see MeshBVH::Benchmark) */
+	struct VizEngine_API RayBenchmarkResult
+	{
+		SimdISA ISA = SimdISA::Scalar;
+		int PacketWidth = 1;
+		double SingleRaysPerSecond = 0.0;
+		double PacketRaysPerSecond = 0.0;
+		size_t Hits = 0;
+	};
+
+	/**
+	 * CPU-side triangle BVH of one mesh for ray queries (picking, occlusion,
+	 * baking) in the mesh's local space.
+	 *
+	 * Build: binned SAH (16 bins per axis) over triangle centroids. Large
+	 * ranges are binned by several threads and subtrees are built as tasks.
+	 * Leaves hold up to MaxLeafSize triangles; past depth 32 splits fall back
+	 * to object medians to bound the depth.
+	 *
+	 * Layout: the binary tree is collapsed into 4-wide nodes of 64 bytes that
+	 * store child boxes as 8-bit offsets (half the size of float boxes).
+	 * Triangles are stored once, in leaf order, as structure-of-arrays
+	 * vertex + two edges for the SIMD tests.
+	 *
+	 * Queries run on the BatchMath kernels of the active instruction set:
+	 *  - Intersect(ray): one ray, leaf triangles tested 4/8/16 at a time
+	 *  - Intersect(streams): packets of 4/8/16 rays traversing together,
+	 *    each box and triangle tested against the whole packet
+	 * Occluded() variants stop at the first hit. Packets pay off for
+	 * coherent rays (neighbouring camera pixels, shadow rays to one light);
+	 * scattered rays are better served by the single-ray path.
+	 *
+	 * Triangle tests are Moller-Trumbore with a small barycentric tolerance,
+	 * not watertight: a ray exactly along a shared edge can, rarely, hit a
+	 * different side (or neither) depending on the instruction set.
+	 *
+	 * The BVH is immutable after Build() and safe to query from any thread.
+	 *
+	 * Usage:
+	 *   auto bvh = mesh->BuildBVH();
+	 *   RayHit hit;
+	 *   if (bvh->Intersect(localOrigin, localDirection, hit)) { ... hit.Triangle ... }
+	 */
+	class VizEngine_API MeshBVH
+	{
+	public:
+		/**
+		 * Build from an indexed triangle list.
+		 * @param positions First vertex position (x, y, z floats)
+		 * @param strideBytes Distance between consecutive positions
+		 * @return nullptr if there are no valid triangles (logged). Triangles
+		 *         with out-of-range indices or non-finite positions are skipped.
+		 */
+		static std::unique_ptr<MeshBVH> Build(const float* positions, size_t strideBytes, size_t vertexCount,
+			const uint32_t* indices, size_t indexCount, const MeshBVHBuildSettings& settings = {});
+
+		~MeshBVH();
+
+		MeshBVH(const MeshBVH&) = delete;
+		MeshBVH& operator=(const MeshBVH&) = delete;
+
+		/** Closest hit with 0 < T < tMax. */
+		bool Intersect(const glm::vec3& origin, const glm::vec3& direction, RayHit& hit, float tMax = FLT_MAX) const;
+
+		/** Any hit with 0 < T < tMax (shadow and visibility rays). */
+		bool Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax = FLT_MAX) const;
+
+		/** Closest hit of every ray; streams must have the same size. */
+		void Intersect(const Vec3Stream& origins, const Vec3Stream& directions, RayHitStream& hits,
+			float tMax = FLT_MAX) const;
+
+		/** occluded[i] = 1 if ray i hits anything with 0 < T < tMax. */
+		void Occluded(const Vec3Stream& origins, const Vec3Stream& directions, std::vector<uint8_t>& occluded,
+			float tMax = FLT_MAX) const;
+
+		/**
+		 * Trace the rays with every instruction set this CPU supports, single
+		 * rays and packets, and restore the active one afterwards.
+		 * @param repeats Passes over the rays per measurement
+		 */
+		std::vector<RayBenchmarkResult> Benchmark(const Vec3Stream& origins, const Vec3Stream& directions,
+			int repeats = 4) const;
+
+		const MeshBVHStats& GetStats() const { return m_Stats; }
+		const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+		const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+
+		struct Storage;                    // Nodes and triangles, opaque outside MeshBVH.cpp
+
+	private:
+		MeshBVH();
+
+		std::unique_ptr<Storage> m_Storage;
+		MeshBVHStats m_Stats;
+		glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+		glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+	};
+}
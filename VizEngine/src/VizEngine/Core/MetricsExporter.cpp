@@ -0,0 +1,665 @@
+// VizEngine/src/VizEngine/Core/MetricsExporter.cpp
+
+#include "MetricsExporter.h"
+#include "Profiler.h"
+#include "ResourceManager.h"
+#include "VizEngine/OpenGL/DeletionQueue.h"
+#include "VizEngine/OpenGL/RenderStats.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+	#include <afunix.h>
+	#include <windows.h>
+	#include <psapi.h>
+	using SocketHandle = SOCKET;
+	constexpr SocketHandle kInvalidSocket = INVALID_SOCKET;
+	constexpr int kSendFlags = 0;
+#else
+	#include <arpa/inet.h>
+	#include <cerrno>
+	#include <netinet/in.h>
+	#include <sys/select.h>
+	#include <sys/socket.h>
+	#include <sys/time.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+	using SocketHandle = int;
+	constexpr SocketHandle kInvalidSocket = -1;
+	// A scraper that hangs up mid-response must not raise SIGPIPE in the host
+	#ifdef MSG_NOSIGNAL
+		constexpr int kSendFlags = MSG_NOSIGNAL;
+	#else
+		constexpr int kSendFlags = 0;   // Apple: SO_NOSIGPIPE is set per client instead
+	#endif
+#endif
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr GLenum GpuMemoryTotalNVX = 0x9048;       // GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX (KiB)
+		constexpr GLenum GpuMemoryAvailableNVX = 0x9049;   // GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX (KiB)
+		constexpr GLenum TextureFreeMemoryATI = 0x87FC;    // GL_TEXTURE_FREE_MEMORY_ATI (KiB, 4 values)
+
+		constexpr int PollTimeoutMs = 200;       // Publishing thread wakes at least this often
+		constexpr int ClientTimeoutMs = 1000;    // Slow scrapers are dropped
+		constexpr size_t MaxRequestBytes = 8192;
+
+		double NowSeconds()
+		{
+			using Clock = std::chrono::steady_clock;
+			return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+		}
+
+		void CloseSocket(SocketHandle socket)
+		{
+#ifdef _WIN32
+			closesocket(socket);
+#else
+			::close(socket);
+#endif
+		}
+
+		uint64_t ResidentBytes()
+		{
+#if defined(_WIN32)
+			PROCESS_MEMORY_COUNTERS counters{};
+			if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			{
+				return static_cast<uint64_t>(counters.WorkingSetSize);
+			}
+			return 0;
+#elif defined(__linux__)
+			// Second field of statm: resident pages
+			unsigned long long size = 0, resident = 0;
+			FILE* file = std::fopen("/proc/self/statm", "r");
+			if (!file) return 0;
+			int read = std::fscanf(file, "%llu %llu", &size, &resident);
+			std::fclose(file);
+			return read == 2 ? resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+			return 0;
+#endif
+		}
+
+		bool HasExtension(const char* name)
+		{
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; i++)
+			{
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+				if (extension && std::strcmp(extension, name) == 0) return true;
+			}
+			return false;
+		}
+
+		std::string EscapeLabel(const std::string& value)
+		{
+			std::string out;
+			out.reserve(value.size());
+			for (char c : value)
+			{
+				if (c == '\\') out += "\\\\";
+				else if (c == '"') out += "\\\"";
+				else if (c == '\n') out += "\\n";
+				else out += c;
+			}
+			return out;
+		}
+
+		/**
+		 * Prometheus text exposition writer.
+		 */
+		class TextWriter
+		{
+		public:
+			TextWriter()
+			{
+				m_Out.imbue(std::locale::classic());
+				m_Out.precision(10);
+			}
+
+			void Header(const std::string& name, const char* type, const std::string& help)
+			{
+				m_Out << "# HELP vizengine_" << name << ' ' << help << "\n";
+				m_Out << "# TYPE vizengine_" << name << ' ' << type << "\n";
+			}
+
+			template<typename T>
+			void Sample(const std::string& name, T value, const std::string& labels = {})
+			{
+				m_Out << "vizengine_" << name;
+				if (!labels.empty()) m_Out << '{' << labels << '}';
+				m_Out << ' ' << value << "\n";
+			}
+
+			template<typename T>
+			void Single(const std::string& name, const char* type, const std::string& help, T value)
+			{
+				Header(name, type, help);
+				Sample(name, value);
+			}
+
+			std::string Str() const { return m_Out.str(); }
+
+		private:
+			std::ostringstream m_Out;
+		};
+
+		std::vector<double> FrameBuckets()
+		{
+			return { 0.004, 0.008, 0.0125, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25, 0.5, 1.0 };
+		}
+	}
+
+	// =========================================================================
+	// Endpoint: HTTP/1.0 GET /metrics on TCP loopback or a Unix domain socket
+	// =========================================================================
+
+	class MetricsExporter::Endpoint
+	{
+	public:
+		~Endpoint()
+		{
+			if (m_Socket != kInvalidSocket) CloseSocket(m_Socket);
+			if (!m_UnixPath.empty())
+			{
+				std::error_code ec;
+				std::filesystem::remove(m_UnixPath, ec);
+			}
+		}
+
+		bool OpenTcp(int port)
+		{
+			m_Socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+			if (m_Socket == kInvalidSocket) return false;
+
+			int reuse = 1;
+			setsockopt(m_Socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_port = htons(static_cast<uint16_t>(port));
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);   // Local scrapers / agents only
+
+			m_Name = "http://127.0.0.1:" + std::to_string(port) + "/metrics";
+			return bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+				listen(m_Socket, 4) == 0;
+		}
+
+		bool OpenUnix(const std::string& path)
+		{
+			sockaddr_un address{};
+			if (path.size() >= sizeof(address.sun_path)) return false;
+
+			m_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (m_Socket == kInvalidSocket) return false;
+
+			// A stale socket file from a previous run would make bind fail
+			std::error_code ec;
+			std::filesystem::remove(path, ec);
+
+			address.sun_family = AF_UNIX;
+			std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+			m_Name = "unix:" + path;
+			if (bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) return false;
+			m_UnixPath = path;
+			return listen(m_Socket, 4) == 0;
+		}
+
+		SocketHandle GetSocket() const { return m_Socket; }
+		const std::string& GetName() const { return m_Name; }
+
+		/**
+		 * Accept one pending client and answer its request.
+		 */
+		void Serve(const MetricsExporter& exporter)
+		{
+			SocketHandle client = accept(m_Socket, nullptr, nullptr);
+			if (client == kInvalidSocket) return;
+
+#ifdef _WIN32
+			DWORD timeout = ClientTimeoutMs;
+#else
+			timeval timeout{ ClientTimeoutMs / 1000, (ClientTimeoutMs % 1000) * 1000 };
+#endif
+			setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+			setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+			int noSigPipe = 1;
+			setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+			// Only the request line matters; read until the end of the headers
+			std::string request;
+			char buffer[1024];
+			while (request.find("\r\n\r\n") == std::string::npos && request.size() < MaxRequestBytes)
+			{
+				auto received = recv(client, buffer, sizeof(buffer), 0);
+				if (received <= 0) break;
+				request.append(buffer, static_cast<size_t>(received));
+			}
+
+			std::string status = "200 OK";
+			std::string body;
+			if (request.rfind("GET /metrics", 0) == 0 || request.rfind("GET / ", 0) == 0)
+			{
+				body = exporter.Render();
+			}
+			else if (request.rfind("GET ", 0) == 0)
+			{
+				status = "404 Not Found";
+				body = "Metrics are served at /metrics\n";
+			}
+			else
+			{
+				status = "405 Method Not Allowed";
+			}
+
+			std::string response = "HTTP/1.0 " + status + "\r\n"
+				"Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+				"Content-Length: " + std::to_string(body.size()) + "\r\n"
+				"Connection: close\r\n\r\n" + body;
+
+			size_t sent = 0;
+			while (sent < response.size())
+			{
+				auto result = send(client, response.data() + sent, static_cast<int>(response.size() - sent), kSendFlags);
+				if (result <= 0)
+				{
+#ifndef _WIN32
+					// EPIPE / ECONNRESET: the scraper went away; EAGAIN: it hit ClientTimeoutMs
+					if (result < 0 && errno != EPIPE && errno != ECONNRESET && errno != EAGAIN && errno != EWOULDBLOCK)
+					{
+						VP_CORE_WARN("Metrics endpoint '{}': send failed ({})", m_Name, std::strerror(errno));
+					}
+#endif
+					break;
+				}
+				sent += static_cast<size_t>(result);
+			}
+			CloseSocket(client);
+		}
+
+	private:
+		SocketHandle m_Socket = kInvalidSocket;
+		std::string m_Name;
+		std::string m_UnixPath;   // Removed on close
+	};
+
+	// =========================================================================
+	// Histogram
+	// =========================================================================
+
+	void MetricsExporter::Histogram::Observe(double value)
+	{
+		size_t bucket = 0;
+		while (bucket < Bounds.size() && value > Bounds[bucket]) bucket++;
+		Counts[bucket]++;
+		Sum += value;
+		Count++;
+	}
+
+	// =========================================================================
+	// MetricsExporter
+	// =========================================================================
+
+	MetricsExporter::MetricsExporter()
+	{
+		for (Histogram* histogram : { &m_FrameTime, &m_GpuFrameTime })
+		{
+			histogram->Bounds = FrameBuckets();
+			histogram->Counts.assign(histogram->Bounds.size() + 1, 0);
+		}
+		m_Snapshot.FrameTime = m_FrameTime;
+		m_Snapshot.GpuFrameTime = m_GpuFrameTime;
+	}
+
+	MetricsExporter::~MetricsExporter()
+	{
+		Stop();
+	}
+
+	bool MetricsExporter::Start(const MetricsConfig& config)
+	{
+		Stop();
+		m_Config = config;
+		m_Config.FrameSampleRate = std::max(1u, config.FrameSampleRate);
+		m_Config.SampleIntervalSeconds = std::max(0.1, config.SampleIntervalSeconds);
+		if (!m_Config.IsEnabled()) return true;
+
+		m_StartSeconds = NowSeconds();
+		m_LastSnapshotSeconds = m_StartSeconds;
+
+		// Driver-reported video memory, where the vendor exposes it
+		if (HasExtension("GL_NVX_gpu_memory_info")) m_GpuMemoryQuery = 1;
+		else if (HasExtension("GL_ATI_meminfo")) m_GpuMemoryQuery = 2;
+
+		bool ok = true;
+		if (m_Config.Port > 0 || !m_Config.SocketPath.empty())
+		{
+#ifdef _WIN32
+			WSADATA data;
+			if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+			{
+				VP_CORE_ERROR("Metrics: WSAStartup failed");
+				return false;
+			}
+#endif
+			if (m_Config.Port > 0)
+			{
+				auto endpoint = std::make_unique<Endpoint>();
+				if (endpoint->OpenTcp(m_Config.Port)) m_Endpoints.push_back(std::move(endpoint));
+				else { VP_CORE_ERROR("Metrics: cannot listen on port {}", m_Config.Port); ok = false; }
+			}
+			if (!m_Config.SocketPath.empty())
+			{
+				auto endpoint = std::make_unique<Endpoint>();
+				if (endpoint->OpenUnix(m_Config.SocketPath)) m_Endpoints.push_back(std::move(endpoint));
+				else { VP_CORE_ERROR("Metrics: cannot listen on socket {}", m_Config.SocketPath); ok = false; }
+			}
+		}
+
+		for (const auto& endpoint : m_Endpoints)
+		{
+			VP_CORE_INFO("Metrics: serving {}", endpoint->GetName());
+		}
+		if (!m_Config.FilePath.empty())
+		{
+			VP_CORE_INFO("Metrics: writing {} every {:.1f} s", m_Config.FilePath, m_Config.SampleIntervalSeconds);
+		}
+
+		m_Running = true;
+		m_Thread = std::thread(&MetricsExporter::PublishLoop, this);
+		return ok;
+	}
+
+	void MetricsExporter::Stop()
+	{
+		if (!m_Running.exchange(false)) return;
+		if (m_Thread.joinable()) m_Thread.join();
+
+		bool sockets = !m_Endpoints.empty();
+		m_Endpoints.clear();
+#ifdef _WIN32
+		if (sockets || m_Config.Port > 0 || !m_Config.SocketPath.empty()) WSACleanup();
+#else
+		(void)sockets;
+#endif
+	}
+
+	void MetricsExporter::OnFrame(double frameSeconds, const FrameTimings& profile, const RenderStats& stats,
+		const ResourceManager* resources)
+	{
+		if (!m_Running.load(std::memory_order_relaxed)) return;
+
+		m_Frames++;
+		if (m_Frames % m_Config.FrameSampleRate == 0)
+		{
+			m_FrameTime.Observe(frameSeconds);
+			m_DrawCallSum += stats.DrawCalls;
+			m_TriangleSum += static_cast<double>(stats.Triangles);
+			m_IntervalFrames++;
+
+			// Profiler frames resolve a few frames late; count each once
+			if (profile.Valid && profile.Frame != m_LastProfiledFrame)
+			{
+				m_LastProfiledFrame = profile.Frame;
+				if (profile.GpuFrameMs > 0.0)
+				{
+					m_GpuFrameTime.Observe(profile.GpuFrameMs / 1000.0);
+				}
+				for (const PassTiming& pass : profile.Passes)
+				{
+					auto [it, inserted] = m_PassAccum.try_emplace(pass.Name);
+					if (inserted) m_PassOrder.push_back(pass.Name);
+					it->second.CpuSeconds += pass.CpuMs / 1000.0;
+					it->second.GpuSeconds += pass.GpuMs / 1000.0;
+					it->second.Samples++;
+				}
+			}
+		}
+
+		double now = NowSeconds();
+		if (now - m_LastSnapshotSeconds >= m_Config.SampleIntervalSeconds)
+		{
+			m_LastSnapshotSeconds = now;
+			TakeSnapshot(resources);
+		}
+	}
+
+	void MetricsExporter::TakeSnapshot(const ResourceManager* resources)
+	{
+		Snapshot snapshot;
+		snapshot.FrameTime = m_FrameTime;
+		snapshot.GpuFrameTime = m_GpuFrameTime;
+		snapshot.Frames = m_Frames;
+		snapshot.UptimeSeconds = NowSeconds() - m_StartSeconds;
+
+		for (const std::string& name : m_PassOrder)
+		{
+			PassAccum& accum = m_PassAccum[name];
+			if (accum.Samples == 0) continue;   // Pass not run this interval
+			PassAccum mean;
+			mean.CpuSeconds = accum.CpuSeconds / accum.Samples;
+			mean.GpuSeconds = accum.GpuSeconds / accum.Samples;
+			mean.Samples = accum.Samples;
+			snapshot.Passes.emplace_back(name, mean);
+			accum = PassAccum();
+		}
+
+		if (m_IntervalFrames > 0)
+		{
+			snapshot.DrawCalls = m_DrawCallSum / m_IntervalFrames;
+			snapshot.Triangles = m_TriangleSum / m_IntervalFrames;
+		}
+		m_DrawCallSum = 0.0;
+		m_TriangleSum = 0.0;
+		m_IntervalFrames = 0;
+
+		snapshot.ResidentBytes = ResidentBytes();
+		if (m_GpuMemoryQuery == 1)
+		{
+			GLint totalKiB = 0, availableKiB = 0;
+			glGetIntegerv(GpuMemoryTotalNVX, &totalKiB);
+			glGetIntegerv(GpuMemoryAvailableNVX, &availableKiB);
+			snapshot.GpuMemoryTotalBytes = static_cast<int64_t>(totalKiB) * 1024;
+			snapshot.GpuMemoryAvailableBytes = static_cast<int64_t>(availableKiB) * 1024;
+		}
+		else if (m_GpuMemoryQuery == 2)
+		{
+			GLint free[4] = {};
+			glGetIntegerv(TextureFreeMemoryATI, free);
+			snapshot.GpuMemoryAvailableBytes = static_cast<int64_t>(free[0]) * 1024;
+		}
+
+		if (resources)
+		{
+			snapshot.Meshes = resources->GetMeshCount();
+			snapshot.Textures = resources->GetTextureCount();
+			snapshot.Shaders = resources->GetShaderCount();
+			snapshot.Materials = resources->GetMaterialCount();
+			snapshot.TextureBytes = resources->GetTextureMemoryEstimate();
+		}
+		snapshot.DeletionQueueDepth = DeletionQueue::GetPendingCount();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Snapshot = std::move(snapshot);
+		m_SnapshotVersion++;
+	}
+
+	void MetricsExporter::SetGauge(const std::string& name, const std::string& help, double value, const std::string& labels)
+	{
+		if (!m_Running.load(std::memory_order_relaxed)) return;
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		Gauge& gauge = m_Gauges[{ name, labels }];
+		if (gauge.Help.empty()) gauge.Help = help;
+		gauge.Value = value;
+	}
+
+	void MetricsExporter::RemoveGauge(const std::string& name, const std::string& labels)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Gauges.erase({ name, labels });
+	}
+
+	std::string MetricsExporter::Render() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		const Snapshot& s = m_Snapshot;
+		TextWriter out;
+
+		auto histogram = [&out](const std::string& name, const std::string& help, const Histogram& h)
+		{
+			out.Header(name, "histogram", help);
+			uint64_t cumulative = 0;
+			for (size_t i = 0; i < h.Counts.size(); i++)
+			{
+				cumulative += h.Counts[i];
+				std::ostringstream bound;
+				bound.imbue(std::locale::classic());
+				if (i < h.Bounds.size()) bound << h.Bounds[i];
+				else bound << "+Inf";
+				out.Sample(name + "_bucket", cumulative, "le=\"" + bound.str() + "\"");
+			}
+			out.Sample(name + "_sum", h.Sum);
+			out.Sample(name + "_count", h.Count);
+		};
+
+		histogram("frame_time_seconds", "Wall time between frames.", s.FrameTime);
+		histogram("frame_gpu_time_seconds", "GPU time of all top-level profiler passes per frame.", s.GpuFrameTime);
+		out.Single("frames_total", "counter", "Frames rendered.", s.Frames);
+		out.Single("uptime_seconds", "counter", "Seconds since the exporter started.", s.UptimeSeconds);
+
+		if (!s.Passes.empty())
+		{
+			out.Header("pass_cpu_seconds", "gauge", "Mean CPU time per profiler pass over the last interval.");
+			for (const auto& [name, pass] : s.Passes)
+			{
+				out.Sample("pass_cpu_seconds", pass.CpuSeconds, "pass=\"" + EscapeLabel(name) + "\"");
+			}
+			out.Header("pass_gpu_seconds", "gauge", "Mean GPU time per profiler pass over the last interval.");
+			for (const auto& [name, pass] : s.Passes)
+			{
+				out.Sample("pass_gpu_seconds", pass.GpuSeconds, "pass=\"" + EscapeLabel(name) + "\"");
+			}
+		}
+
+		out.Single("draw_calls", "gauge", "Mean draw calls per frame over the last interval.", s.DrawCalls);
+		out.Single("triangles", "gauge", "Mean triangles per frame over the last interval.", s.Triangles);
+
+		if (s.ResidentBytes > 0)
+		{
+			out.Single("process_resident_bytes", "gauge", "Resident set size of the process.", s.ResidentBytes);
+		}
+		if (s.GpuMemoryTotalBytes >= 0)
+		{
+			out.Single("gpu_memory_total_bytes", "gauge", "Dedicated video memory reported by the driver.", s.GpuMemoryTotalBytes);
+		}
+		if (s.GpuMemoryAvailableBytes >= 0)
+		{
+			out.Single("gpu_memory_available_bytes", "gauge", "Free video memory reported by the driver.", s.GpuMemoryAvailableBytes);
+		}
+
+		out.Header("resources", "gauge", "Resources registered with the ResourceManager.");
+		out.Sample("resources", s.Meshes, "type=\"mesh\"");
+		out.Sample("resources", s.Textures, "type=\"texture\"");
+		out.Sample("resources", s.Shaders, "type=\"shader\"");
+		out.Sample("resources", s.Materials, "type=\"material\"");
+		out.Single("texture_memory_bytes", "gauge", "Estimated GPU memory of registered textures.", s.TextureBytes);
+		out.Single("deletion_queue_depth", "gauge", "GL objects waiting for the GPU before release.", s.DeletionQueueDepth);
+
+		const std::string* lastName = nullptr;
+		for (const auto& [key, gauge] : m_Gauges)
+		{
+			if (!lastName || *lastName != key.first)
+			{
+				out.Header(key.first, "gauge", gauge.Help);
+				lastName = &key.first;
+			}
+			out.Sample(key.first, gauge.Value, key.second);
+		}
+
+		return out.Str();
+	}
+
+	void MetricsExporter::PublishLoop()
+	{
+		uint64_t writtenVersion = 0;
+
+		while (m_Running.load())
+		{
+			if (m_Endpoints.empty())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeoutMs));
+			}
+			else
+			{
+				fd_set readable;
+				FD_ZERO(&readable);
+				SocketHandle maxSocket = 0;
+				for (const auto& endpoint : m_Endpoints)
+				{
+					FD_SET(endpoint->GetSocket(), &readable);
+					maxSocket = std::max(maxSocket, endpoint->GetSocket());
+				}
+
+				timeval timeout{ 0, PollTimeoutMs * 1000 };
+				int ready = select(static_cast<int>(maxSocket) + 1, &readable, nullptr, nullptr, &timeout);
+				if (ready > 0)
+				{
+					for (const auto& endpoint : m_Endpoints)
+					{
+						if (FD_ISSET(endpoint->GetSocket(), &readable)) endpoint->Serve(*this);
+					}
+				}
+			}
+
+			if (!m_Config.FilePath.empty())
+			{
+				uint64_t version;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					version = m_SnapshotVersion;
+				}
+				if (version != writtenVersion)
+				{
+					writtenVersion = version;
+
+					// Write-then-rename so collectors never read a partial file
+					std::string temp = m_Config.FilePath + ".tmp";
+					{
+						std::ofstream file(temp, std::ios::out | std::ios::trunc | std::ios::binary);
+						file << Render();
+					}
+					std::error_code ec;
+					std::filesystem::rename(temp, m_Config.FilePath, ec);
+					if (ec)
+					{
+						VP_CORE_WARN("Metrics: cannot write {}: {}", m_Config.FilePath, ec.message());
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,181 @@
+// VizEngine/src/VizEngine/Core/MetricsExporter.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+	struct FrameTimings;
+	struct RenderStats;
+	class ResourceManager;
+
+	/**
+	 * Where and how often metrics are published. Any combination of the
+	 * three outputs may be active; with none the exporter stays idle.
+	 */
+	struct MetricsConfig
+	{
+		int Port = 0;                        // HTTP GET /metrics on 127.0.0.1:Port (0 = off)
+		std::string SocketPath;              // Same endpoint on a Unix domain socket (empty = off)
+		std::string FilePath;                // Rewritten every interval, for textfile collectors (empty = off)
+		double SampleIntervalSeconds = 5.0;  // Pass times, memory and gauges are snapshotted this often
+		uint32_t FrameSampleRate = 1;        // Record every Nth frame in the frame-time histograms
+
+		bool IsEnabled() const { return Port > 0 || !SocketPath.empty() || !FilePath.empty(); }
+	};
+
+	/**
+	 * Prometheus text-format metrics for long-running deployments.
+	 *
+	 * The frame loop only does constant-time work: OnFrame() bumps histogram
+	 * buckets and accumulates per-pass times. Once per sample interval the
+	 * accumulated values, memory figures and registered gauges are copied
+	 * into a snapshot under a mutex. A background thread serves that
+	 * snapshot over HTTP (TCP and/or Unix domain socket) and rewrites the
+	 * metrics file, so scrapes never touch the render thread.
+	 *
+	 * Exported series (all prefixed vizengine_):
+	 *   frame_time_seconds, frame_gpu_time_seconds    histograms
+	 *   frames_total, uptime_seconds                  counters
+	 *   pass_cpu_seconds, pass_gpu_seconds {pass}     mean over the last interval
+	 *   draw_calls, triangles                         mean per frame over the last interval
+	 *   process_resident_bytes, gpu_memory_*_bytes    memory (GPU via NVX/ATI extensions)
+	 *   resources {type}, texture_memory_bytes        registered resources
+	 *   deletion_queue_depth                          GL objects awaiting release
+	 *   plus anything published with SetGauge(), e.g. loader queue depths
+	 *
+	 * Usage:
+	 *   EngineConfig::Metrics.Port = 9464;   // Engine owns the exporter
+	 *   Engine::Get().GetMetrics().SetGauge("render_service_queue_depth", "Jobs by stage", depth, "stage=\"waiting\"");
+	 */
+	class VizEngine_API MetricsExporter
+	{
+	public:
+		MetricsExporter();
+		~MetricsExporter();
+
+		MetricsExporter(const MetricsExporter&) = delete;
+		MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+		/**
+		 * Open the configured outputs and start the publishing thread.
+		 * @return false if an endpoint could not be opened (others keep running)
+		 */
+		bool Start(const MetricsConfig& config);
+
+		/**
+		 * Stop the publishing thread and close all endpoints.
+		 */
+		void Stop();
+
+		bool IsRunning() const { return m_Running.load(); }
+
+		/**
+		 * Record a finished frame. Render thread, once per frame after
+		 * Profiler::EndFrame(); also takes the periodic snapshot.
+		 * @param frameSeconds Wall time since the previous frame
+		 * @param profile Most recent resolved profiler frame (may be invalid)
+		 */
+		void OnFrame(double frameSeconds, const FrameTimings& profile, const RenderStats& stats,
+			const ResourceManager* resources);
+
+		/**
+		 * Publish a gauge. Thread-safe; cheap enough to call every frame.
+		 * @param name Metric name without the vizengine_ prefix
+		 * @param labels Prometheus label list without braces (e.g. queue="models")
+		 */
+		void SetGauge(const std::string& name, const std::string& help, double value, const std::string& labels = {});
+
+		/** Remove a gauge published with SetGauge() */
+		void RemoveGauge(const std::string& name, const std::string& labels = {});
+
+		/**
+		 * @return The current snapshot in Prometheus text exposition format
+		 */
+		std::string Render() const;
+
+		const MetricsConfig& GetConfig() const { return m_Config; }
+
+	private:
+		class Endpoint;
+
+		struct Histogram
+		{
+			std::vector<double> Bounds;     // Upper bounds in seconds, ascending (+Inf implicit)
+			std::vector<uint64_t> Counts;   // Per bucket, not cumulative (last = +Inf)
+			double Sum = 0.0;
+			uint64_t Count = 0;
+
+			void Observe(double value);
+		};
+
+		struct PassAccum
+		{
+			double CpuSeconds = 0.0;
+			double GpuSeconds = 0.0;
+			uint32_t Samples = 0;
+		};
+
+		struct Gauge
+		{
+			std::string Help;
+			double Value = 0.0;
+		};
+
+		struct Snapshot
+		{
+			Histogram FrameTime;
+			Histogram GpuFrameTime;
+			uint64_t Frames = 0;
+			double UptimeSeconds = 0.0;
+			std::vector<std::pair<std::string, PassAccum>> Passes;   // Means over the last interval
+			double DrawCalls = 0.0;
+			double Triangles = 0.0;
+			uint64_t ResidentBytes = 0;
+			int64_t GpuMemoryTotalBytes = -1;       // -1 = unknown
+			int64_t GpuMemoryAvailableBytes = -1;
+			size_t Meshes = 0, Textures = 0, Shaders = 0, Materials = 0;
+			uint64_t TextureBytes = 0;
+			size_t DeletionQueueDepth = 0;
+		};
+
+		void TakeSnapshot(const ResourceManager* resources);
+		void PublishLoop();
+
+		MetricsConfig m_Config;
+
+		// Render thread only
+		Histogram m_FrameTime;
+		Histogram m_GpuFrameTime;
+		uint64_t m_Frames = 0;
+		uint64_t m_LastProfiledFrame = 0;
+		std::unordered_map<std::string, PassAccum> m_PassAccum;
+		std::vector<std::string> m_PassOrder;
+		double m_DrawCallSum = 0.0;
+		double m_TriangleSum = 0.0;
+		uint32_t m_IntervalFrames = 0;
+		double m_StartSeconds = 0.0;
+		double m_LastSnapshotSeconds = 0.0;
+		int m_GpuMemoryQuery = 0;            // 0 = none, 1 = NVX, 2 = ATI
+
+		// Shared with the publishing thread
+		mutable std::mutex m_Mutex;
+		Snapshot m_Snapshot;
+		uint64_t m_SnapshotVersion = 0;
+		std::map<std::pair<std::string, std::string>, Gauge> m_Gauges;   // (name, labels)
+
+		std::vector<std::unique_ptr<Endpoint>> m_Endpoints;
+		std::thread m_Thread;
+		std::atomic<bool> m_Running{ false };
+	};
+}
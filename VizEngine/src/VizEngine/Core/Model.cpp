@@ -1,4 +1,5 @@
 #include "Model.h"
+#include "Profiler.h"
 #include "VizEngine/Log.h"
 
 // tinygltf is header-only, implementation is in TinyGLTF.cpp
@@ -8,11 +9,41 @@
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
 #include "tiny_gltf.h"
 
+#include "gtc/matrix_transform.hpp"
+#include "gtc/quaternion.hpp"
 #include <filesystem>
 #include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace VizEngine
 {
+	/**
+	 * Occlusion + metallic-roughness packed into one RGBA8 image
+	 * (R = occlusion, G = roughness, B = metallic, A = 255).
+	 */
+	struct PackedImage
+	{
+		int Width = 0;
+		int Height = 0;
+		std::vector<unsigned char> Pixels;
+	};
+
+	struct ModelSource
+	{
+		std::string FilePath;
+		tinygltf::Model Gltf;
+
+		// Built during parsing, keyed by ORMKey(occlusion image, metallic-roughness image)
+		std::unordered_map<uint64_t, PackedImage> ORMImages;
+	};
+
+	void ModelSourceDeleter::operator()(ModelSource* source) const
+	{
+		delete source;
+	}
+
 	// Default material for meshes without one assigned
 	Material Model::s_DefaultMaterial = Material(glm::vec4(0.8f, 0.8f, 0.8f, 1.0f), 0.0f, 0.5f);
 
@@ -22,21 +53,28 @@ namespace VizEngine
 	class Model::ModelLoader
 	{
 	public:
-		static std::unique_ptr<Model> Load(const std::string& filepath);
+		static ModelSourcePtr Parse(const std::string& filepath);
+		static std::unique_ptr<Model> Create(ModelSourcePtr source);
 
 	private:
 		ModelLoader(Model* model, const std::string& filepath);
 
-		void LoadMaterials(const tinygltf::Model& gltfModel);
+		void LoadMaterials(const ModelSource& source);
 		void LoadMeshes(const tinygltf::Model& gltfModel);
+		void LoadNodes(const tinygltf::Model& gltfModel);
+		void AddNode(const tinygltf::Model& gltfModel, int nodeIndex, int parent, int depth);
 		void LoadIndices(const tinygltf::Model& gltfModel,
 			const tinygltf::Accessor& accessor,
 			std::vector<unsigned int>& indices);
 		std::shared_ptr<Texture> LoadTexture(const tinygltf::Model& gltfModel, int textureIndex);
 
+		static void PackORMImages(ModelSource& source);
+
 		Model* m_Model;
 		std::string m_Directory;
-		std::unordered_map<int, std::shared_ptr<Texture>> m_TextureCache;
+		std::unordered_map<int, std::shared_ptr<Texture>> m_ImageCache;    // By glTF image index
+		std::unordered_map<uint64_t, std::shared_ptr<Texture>> m_ORMCache;  // By ORMKey
+		std::vector<std::vector<size_t>> m_PrimitiveMeshes;                 // Model meshes per glTF mesh
 	};
 
 	//==========================================================================
@@ -60,6 +98,42 @@ namespace VizEngine
 		return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 	}
 
+	// glTF image behind a texture index, or -1
+	static int GetImageIndex(const tinygltf::Model& model, int textureIndex)
+	{
+		if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size())) return -1;
+		int source = model.textures[textureIndex].source;
+		return (source >= 0 && source < static_cast<int>(model.images.size())) ? source : -1;
+	}
+
+	static uint64_t ORMKey(int occlusionImage, int metallicRoughnessImage)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(occlusionImage)) << 32)
+			| static_cast<uint32_t>(metallicRoughnessImage);
+	}
+
+	// Bilinear fetch of one channel from a decoded 8-bit image, at UV in [0, 1]
+	static float SampleChannel(const tinygltf::Image& image, int channel, float u, float v)
+	{
+		float x = u * static_cast<float>(image.width) - 0.5f;
+		float y = v * static_cast<float>(image.height) - 0.5f;
+		int x0 = static_cast<int>(std::floor(x));
+		int y0 = static_cast<int>(std::floor(y));
+		float fx = x - static_cast<float>(x0);
+		float fy = y - static_cast<float>(y0);
+
+		auto texel = [&](int px, int py) {
+			px = px < 0 ? 0 : (px >= image.width ? image.width - 1 : px);
+			py = py < 0 ? 0 : (py >= image.height ? image.height - 1 : py);
+			size_t index = (static_cast<size_t>(py) * image.width + px) * image.component + channel;
+			return static_cast<float>(image.image[index]);
+		};
+
+		float top = texel(x0, y0) + (texel(x0 + 1, y0) - texel(x0, y0)) * fx;
+		float bottom = texel(x0, y0 + 1) + (texel(x0 + 1, y0 + 1) - texel(x0, y0 + 1)) * fx;
+		return top + (bottom - top) * fy;
+	}
+
 	template<typename T>
 	static const T* GetBufferData(const tinygltf::Model& model, const tinygltf::Accessor& accessor)
 	{
@@ -175,7 +249,17 @@ namespace VizEngine
 	//==========================================================================
 	std::unique_ptr<Model> Model::LoadFromFile(const std::string& filepath)
 	{
-		return ModelLoader::Load(filepath);
+		return ModelLoader::Create(ModelLoader::Parse(filepath));
+	}
+
+	ModelSourcePtr Model::ParseFile(const std::string& filepath)
+	{
+		return ModelLoader::Parse(filepath);
+	}
+
+	std::unique_ptr<Model> Model::LoadFromSource(ModelSourcePtr source)
+	{
+		return ModelLoader::Create(std::move(source));
 	}
 
 	size_t Model::GetMaterialIndexForMesh(size_t meshIndex) const
@@ -206,8 +290,9 @@ namespace VizEngine
 	{
 	}
 
-	std::unique_ptr<Model> Model::ModelLoader::Load(const std::string& filepath)
+	ModelSourcePtr Model::ModelLoader::Parse(const std::string& filepath)
 	{
+		VP_PROFILE_EVENT(AssetLoad, filepath);
 		VP_CORE_INFO("Loading model: {}", filepath);
 
 		// Check if file exists first for clearer error messages
@@ -217,7 +302,9 @@ namespace VizEngine
 			return nullptr;
 		}
 
-		tinygltf::Model gltfModel;
+		ModelSourcePtr source(new ModelSource());
+		source->FilePath = filepath;
+		tinygltf::Model& gltfModel = source->Gltf;
 		tinygltf::TinyGLTF loader;
 		std::string err, warn;
 
@@ -253,6 +340,85 @@ namespace VizEngine
 			return nullptr;
 		}
 
+		PackORMImages(*source);
+
+		return source;
+	}
+
+	void Model::ModelLoader::PackORMImages(ModelSource& source)
+	{
+		const tinygltf::Model& gltfModel = source.Gltf;
+
+		for (const auto& gltfMat : gltfModel.materials)
+		{
+			const auto& occlusion = gltfMat.occlusionTexture;
+			const auto& metallicRoughness = gltfMat.pbrMetallicRoughness.metallicRoughnessTexture;
+
+			int occlusionImage = GetImageIndex(gltfModel, occlusion.index);
+			int mrImage = GetImageIndex(gltfModel, metallicRoughness.index);
+
+			// Already packed (one image) or nothing to pack
+			if (occlusionImage < 0 || mrImage < 0 || occlusionImage == mrImage) continue;
+			if (occlusion.texCoord != metallicRoughness.texCoord) continue;
+
+			uint64_t key = ORMKey(occlusionImage, mrImage);
+			if (source.ORMImages.count(key)) continue;
+
+			const tinygltf::Image& occ = gltfModel.images[occlusionImage];
+			const tinygltf::Image& mr = gltfModel.images[mrImage];
+
+			// Only decoded 8-bit images (external files left undecoded keep separate textures)
+			auto usable = [](const tinygltf::Image& image, int minComponents) {
+				return !image.image.empty() && image.bits == 8 && image.component >= minComponents &&
+					image.image.size() >= static_cast<size_t>(image.width) * image.height * image.component;
+			};
+			if (!usable(occ, 1) || !usable(mr, 3)) continue;
+
+			// Keep the more detailed of the two resolutions
+			const bool useMRSize = static_cast<int64_t>(mr.width) * mr.height >= static_cast<int64_t>(occ.width) * occ.height;
+			PackedImage packed;
+			packed.Width = useMRSize ? mr.width : occ.width;
+			packed.Height = useMRSize ? mr.height : occ.height;
+			packed.Pixels.resize(static_cast<size_t>(packed.Width) * packed.Height * 4);
+
+			const bool sameSize = occ.width == mr.width && occ.height == mr.height;
+			for (int y = 0; y < packed.Height; y++)
+			{
+				for (int x = 0; x < packed.Width; x++)
+				{
+					size_t pixel = static_cast<size_t>(y) * packed.Width + x;
+					unsigned char* out = &packed.Pixels[pixel * 4];
+
+					if (sameSize)
+					{
+						out[0] = occ.image[pixel * occ.component];
+						out[1] = mr.image[pixel * mr.component + 1];
+						out[2] = mr.image[pixel * mr.component + 2];
+					}
+					else
+					{
+						float u = (static_cast<float>(x) + 0.5f) / static_cast<float>(packed.Width);
+						float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(packed.Height);
+						out[0] = static_cast<unsigned char>(SampleChannel(occ, 0, u, v) + 0.5f);
+						out[1] = static_cast<unsigned char>(SampleChannel(mr, 1, u, v) + 0.5f);
+						out[2] = static_cast<unsigned char>(SampleChannel(mr, 2, u, v) + 0.5f);
+					}
+					out[3] = 255;
+				}
+			}
+
+			source.ORMImages.emplace(key, std::move(packed));
+		}
+	}
+
+	std::unique_ptr<Model> Model::ModelLoader::Create(ModelSourcePtr source)
+	{
+		if (!source) return nullptr;
+		VP_PROFILE_EVENT(Upload, "Model " + source->FilePath);
+
+		const std::string& filepath = source->FilePath;
+		const tinygltf::Model& gltfModel = source->Gltf;
+
 		// Create model instance
 		auto model = std::unique_ptr<Model>(new Model());
 		model->m_FilePath = filepath;
@@ -261,8 +427,9 @@ namespace VizEngine
 
 		// Use ModelLoader to do the actual loading
 		ModelLoader modelLoader(model.get(), filepath);
-		modelLoader.LoadMaterials(gltfModel);
+		modelLoader.LoadMaterials(*source);
 		modelLoader.LoadMeshes(gltfModel);
+		modelLoader.LoadNodes(gltfModel);
 
 		VP_CORE_INFO("Loaded model '{}': {} meshes, {} materials",
 			model->m_Name, model->m_Meshes.size(), model->m_Materials.size());
@@ -270,8 +437,12 @@ namespace VizEngine
 		return model;
 	}
 
-	void Model::ModelLoader::LoadMaterials(const tinygltf::Model& gltfModel)
+	void Model::ModelLoader::LoadMaterials(const ModelSource& source)
 	{
+		const tinygltf::Model& gltfModel = source.Gltf;
+		int packedCount = 0;
+		int sharedCount = 0;
+
 		for (const auto& gltfMat : gltfModel.materials)
 		{
 			Material material;
@@ -294,9 +465,36 @@ namespace VizEngine
 				material.BaseColorTexture = LoadTexture(gltfModel, pbr.baseColorTexture.index);
 			}
 
-			if (pbr.metallicRoughnessTexture.index >= 0)
+			// Metallic-roughness and occlusion: one texture when the source already
+			// shares an image, or the ORM image packed during parsing
+			int occlusionImage = GetImageIndex(gltfModel, gltfMat.occlusionTexture.index);
+			int mrImage = GetImageIndex(gltfModel, pbr.metallicRoughnessTexture.index);
+			auto packed = source.ORMImages.find(ORMKey(occlusionImage, mrImage));
+
+			if (packed != source.ORMImages.end())
 			{
-				material.MetallicRoughnessTexture = LoadTexture(gltfModel, pbr.metallicRoughnessTexture.index);
+				auto& orm = m_ORMCache[packed->first];
+				if (!orm)
+				{
+					orm = std::make_shared<Texture>(packed->second.Pixels.data(),
+						packed->second.Width, packed->second.Height, 4);
+				}
+				material.MetallicRoughnessTexture = orm;
+				material.OcclusionTexture = orm;
+				packedCount++;
+			}
+			else
+			{
+				if (pbr.metallicRoughnessTexture.index >= 0)
+				{
+					material.MetallicRoughnessTexture = LoadTexture(gltfModel, pbr.metallicRoughnessTexture.index);
+				}
+				if (gltfMat.occlusionTexture.index >= 0)
+				{
+					// Same image: LoadTexture returns the same texture (already packed)
+					material.OcclusionTexture = LoadTexture(gltfModel, gltfMat.occlusionTexture.index);
+					if (material.HasPackedORM()) sharedCount++;
+				}
 			}
 
 			if (gltfMat.normalTexture.index >= 0)
@@ -304,10 +502,6 @@ namespace VizEngine
 				material.NormalTexture = LoadTexture(gltfModel, gltfMat.normalTexture.index);
 			}
 
-			if (gltfMat.occlusionTexture.index >= 0)
-			{
-				material.OcclusionTexture = LoadTexture(gltfModel, gltfMat.occlusionTexture.index);
-			}
 
 			if (gltfMat.emissiveTexture.index >= 0)
 			{
@@ -342,12 +536,18 @@ namespace VizEngine
 		{
 			m_Model->m_Materials.push_back(Model::s_DefaultMaterial);
 		}
+
+		if (packedCount > 0 || sharedCount > 0)
+		{
+			VP_CORE_INFO("ORM: {} materials packed at import, {} already packed in the source", packedCount, sharedCount);
+		}
 	}
 
 	void Model::ModelLoader::LoadMeshes(const tinygltf::Model& gltfModel)
 	{
 		for (const auto& gltfMesh : gltfModel.meshes)
 		{
+			std::vector<size_t>& primitiveMeshes = m_PrimitiveMeshes.emplace_back();
 			for (const auto& primitive : gltfMesh.primitives)
 			{
 				if (primitive.mode != TINYGLTF_MODE_TRIANGLES && primitive.mode != -1)
@@ -608,6 +808,7 @@ namespace VizEngine
 
 				auto mesh = std::make_shared<Mesh>(vertices, indices);
 				m_Model->m_Meshes.push_back(mesh);
+				primitiveMeshes.push_back(m_Model->m_Meshes.size() - 1);
 
 				size_t materialIndex = 0;
 				if (primitive.material >= 0)
@@ -627,6 +828,105 @@ namespace VizEngine
 		}
 	}
 
+	void Model::ModelLoader::LoadNodes(const tinygltf::Model& gltfModel)
+	{
+		if (gltfModel.nodes.empty()) return;
+
+		std::vector<int> roots;
+		if (!gltfModel.scenes.empty())
+		{
+			size_t sceneIndex = gltfModel.defaultScene >= 0 && gltfModel.defaultScene < static_cast<int>(gltfModel.scenes.size())
+				? static_cast<size_t>(gltfModel.defaultScene) : 0;
+			roots = gltfModel.scenes[sceneIndex].nodes;
+		}
+		else
+		{
+			// No scene: every node that is nobody's child is a root
+			std::vector<bool> isChild(gltfModel.nodes.size(), false);
+			for (const auto& node : gltfModel.nodes)
+			{
+				for (int child : node.children)
+				{
+					if (child >= 0 && child < static_cast<int>(isChild.size())) isChild[child] = true;
+				}
+			}
+			for (size_t i = 0; i < isChild.size(); i++)
+			{
+				if (!isChild[i]) roots.push_back(static_cast<int>(i));
+			}
+		}
+
+		for (int root : roots)
+		{
+			AddNode(gltfModel, root, -1, 0);
+		}
+	}
+
+	void Model::ModelLoader::AddNode(const tinygltf::Model& gltfModel, int nodeIndex, int parent, int depth)
+	{
+		if (nodeIndex < 0 || nodeIndex >= static_cast<int>(gltfModel.nodes.size()))
+		{
+			VP_CORE_WARN("Node index {} out of range, skipping", nodeIndex);
+			return;
+		}
+		if (depth > static_cast<int>(gltfModel.nodes.size()))
+		{
+			VP_CORE_ERROR("Node hierarchy contains a cycle, skipping node {}", nodeIndex);
+			return;
+		}
+
+		const tinygltf::Node& gltfNode = gltfModel.nodes[nodeIndex];
+		ModelNode node;
+		node.Name = gltfNode.name;
+		node.Parent = parent;
+
+		if (gltfNode.matrix.size() == 16)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				node.LocalTransform[i / 4][i % 4] = static_cast<float>(gltfNode.matrix[i]);  // Column-major
+			}
+		}
+		else
+		{
+			glm::vec3 translation(0.0f);
+			glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+			glm::vec3 scale(1.0f);
+			if (gltfNode.translation.size() == 3)
+			{
+				translation = glm::vec3(static_cast<float>(gltfNode.translation[0]),
+					static_cast<float>(gltfNode.translation[1]), static_cast<float>(gltfNode.translation[2]));
+			}
+			if (gltfNode.rotation.size() == 4)
+			{
+				// glTF stores x, y, z, w; glm::quat takes w first
+				rotation = glm::quat(static_cast<float>(gltfNode.rotation[3]), static_cast<float>(gltfNode.rotation[0]),
+					static_cast<float>(gltfNode.rotation[1]), static_cast<float>(gltfNode.rotation[2]));
+			}
+			if (gltfNode.scale.size() == 3)
+			{
+				scale = glm::vec3(static_cast<float>(gltfNode.scale[0]),
+					static_cast<float>(gltfNode.scale[1]), static_cast<float>(gltfNode.scale[2]));
+			}
+			node.LocalTransform = glm::translate(glm::mat4(1.0f), translation)
+				* glm::mat4_cast(rotation)
+				* glm::scale(glm::mat4(1.0f), scale);
+		}
+
+		if (gltfNode.mesh >= 0 && gltfNode.mesh < static_cast<int>(m_PrimitiveMeshes.size()))
+		{
+			node.Meshes = m_PrimitiveMeshes[gltfNode.mesh];
+		}
+
+		int index = static_cast<int>(m_Model->m_Nodes.size());
+		m_Model->m_Nodes.push_back(std::move(node));
+
+		for (int child : gltfNode.children)
+		{
+			AddNode(gltfModel, child, index, depth + 1);
+		}
+	}
+
 	void Model::ModelLoader::LoadIndices(const tinygltf::Model& gltfModel,
 		const tinygltf::Accessor& accessor,
 		std::vector<unsigned int>& indices)
@@ -718,11 +1018,6 @@ namespace VizEngine
 			return nullptr;
 		}
 
-		if (m_TextureCache.find(textureIndex) != m_TextureCache.end())
-		{
-			return m_TextureCache[textureIndex];
-		}
-
 		const auto& texture = gltfModel.textures[textureIndex];
 
 		if (texture.source < 0 || texture.source >= static_cast<int>(gltfModel.images.size()))
@@ -730,6 +1025,13 @@ namespace VizEngine
 			return nullptr;
 		}
 
+		// Cached per image, so textures sharing an image share one GL texture
+		auto cached = m_ImageCache.find(texture.source);
+		if (cached != m_ImageCache.end())
+		{
+			return cached->second;
+		}
+
 		const auto& image = gltfModel.images[texture.source];
 		std::shared_ptr<Texture> tex;
 
@@ -754,7 +1056,7 @@ namespace VizEngine
 
 		if (tex)
 		{
-			m_TextureCache[textureIndex] = tex;
+			m_ImageCache[texture.source] = tex;
 		}
 
 		return tex;
@@ -12,6 +12,31 @@
 
 namespace VizEngine
 {
+	/**
+	 * A parsed glTF file with its embedded images decoded, before any GL
+	 * upload. Opaque outside Model.cpp (keeps tinygltf out of the header).
+	 */
+	struct ModelSource;
+
+	struct VizEngine_API ModelSourceDeleter
+	{
+		void operator()(ModelSource* source) const;
+	};
+
+	using ModelSourcePtr = std::unique_ptr<ModelSource, ModelSourceDeleter>;
+
+	/**
+	 * A node of the model's scene graph (glTF node).
+	 * Nodes are stored parents-first, so Parent is always a lower index.
+	 */
+	struct VizEngine_API ModelNode
+	{
+		std::string Name;
+		int Parent = -1;                              // Node index, -1 = root
+		glm::mat4 LocalTransform = glm::mat4(1.0f);   // Relative to the parent
+		std::vector<size_t> Meshes;                   // Indices into GetMeshes()
+	};
+
 	/**
 	 * Model represents a loaded 3D model file (glTF/GLB).
 	 * 
@@ -33,6 +58,17 @@ namespace VizEngine
 		 */
 		static std::unique_ptr<Model> LoadFromFile(const std::string& filepath);
 
+		/**
+		 * Loading in two steps, so file I/O and image decoding can run on a
+		 * worker thread while the GL thread keeps rendering:
+		 *   ParseFile       - no GL calls, safe off the GL thread
+		 *   LoadFromSource  - creates meshes and textures; GL thread only
+		 * LoadFromFile() is ParseFile() followed by LoadFromSource().
+		 * Both return nullptr on failure.
+		 */
+		static ModelSourcePtr ParseFile(const std::string& filepath);
+		static std::unique_ptr<Model> LoadFromSource(ModelSourcePtr source);
+
 		~Model() = default;
 
 		// Prevent copying (models can be large)
@@ -47,6 +83,9 @@ namespace VizEngine
 		const std::vector<std::shared_ptr<Mesh>>& GetMeshes() const { return m_Meshes; }
 		const std::vector<Material>& GetMaterials() const { return m_Materials; }
 
+		// Scene graph of the default glTF scene (empty if the file has no nodes)
+		const std::vector<ModelNode>& GetNodes() const { return m_Nodes; }
+
 		// Get the material index for a specific mesh
 		size_t GetMaterialIndexForMesh(size_t meshIndex) const;
 		
@@ -78,6 +117,7 @@ namespace VizEngine
 		std::vector<std::shared_ptr<Mesh>> m_Meshes;
 		std::vector<Material> m_Materials;
 		std::vector<size_t> m_MeshMaterialIndices;  // Material index for each mesh
+		std::vector<ModelNode> m_Nodes;
 
 		// Texture cache to avoid reloading same texture
 		std::unordered_map<int, std::shared_ptr<Texture>> m_TextureCache;
@@ -0,0 +1,1258 @@
+// VizEngine/src/VizEngine/Core/PointCloudFile.cpp
+
+#include "PointCloudFile.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+	using namespace PointCloudFormat;
+
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		constexpr size_t BatchPoints = 16384;        // Points handed to a sink at once
+		constexpr int CountLevel = 7;                // 128^3 counting grid
+		constexpr uint32_t CountCells = 1u << CountLevel;
+		constexpr size_t MaxFlushPoints = 8192;      // Per-thread buffer per chunk before appending
+		constexpr size_t DistributeBufferBytes = 256ull << 20;
+
+		double SecondsSince(Clock::time_point start)
+		{
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		template<typename T>
+		T Load(const uint8_t* data)
+		{
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			return value;
+		}
+
+		uint8_t ToColor(double value, bool isFloat, int shift)
+		{
+			if (isFloat) value *= 255.0;
+			else value = static_cast<double>(static_cast<uint32_t>(std::max(value, 0.0)) >> shift);
+			return static_cast<uint8_t>(std::clamp(value, 0.0, 255.0));
+		}
+
+		bool IsSeparator(char c)
+		{
+			return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+		}
+
+		std::string Extension(const std::string& path)
+		{
+			std::string ext = std::filesystem::path(path).extension().string();
+			std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return ext;
+		}
+
+		struct Cube
+		{
+			double Min[3] = { 0.0, 0.0, 0.0 };
+			double Size = 1.0;
+		};
+
+		/** Position relative to the cube; false for points outside it (or NaN). */
+		bool ToRecord(const SourcePoint& point, const Cube& cube, PointRecord& out)
+		{
+			const double world[3] = { point.X, point.Y, point.Z };
+			for (int axis = 0; axis < 3; axis++)
+			{
+				double rel = world[axis] - cube.Min[axis];
+				if (!(rel >= 0.0 && rel <= cube.Size)) return false;
+				out.Position[axis] = static_cast<float>(rel);
+			}
+			out.Color[0] = point.R;
+			out.Color[1] = point.G;
+			out.Color[2] = point.B;
+			out.Color[3] = 255;
+			return true;
+		}
+
+		/**
+		 * Cell of a relative coordinate at an octree level. Scaling by a power
+		 * of two is exact, so a cell at level k is always the parent (>> 1) of
+		 * the point's cell at level k + 1.
+		 */
+		uint32_t CellAt(float rel, double size, int level)
+		{
+			const uint32_t cells = 1u << level;
+			double cell = std::floor(static_cast<double>(rel) * cells / size);
+			return std::min(static_cast<uint32_t>(std::max(cell, 0.0)), cells - 1);
+		}
+
+		uint64_t NodeKey(int level, uint32_t x, uint32_t y, uint32_t z)
+		{
+			return (static_cast<uint64_t>(level) << 60) | (static_cast<uint64_t>(x) << 40) |
+				(static_cast<uint64_t>(y) << 20) | z;
+		}
+
+		int KeyLevel(uint64_t key) { return static_cast<int>(key >> 60); }
+		uint32_t KeyX(uint64_t key) { return static_cast<uint32_t>(key >> 40) & 0xFFFFF; }
+		uint32_t KeyY(uint64_t key) { return static_cast<uint32_t>(key >> 20) & 0xFFFFF; }
+		uint32_t KeyZ(uint64_t key) { return static_cast<uint32_t>(key) & 0xFFFFF; }
+
+		void ParallelFor(unsigned threads, const std::function<void(unsigned)>& job)
+		{
+			std::vector<std::thread> workers;
+			for (unsigned t = 1; t < threads; t++) workers.emplace_back(job, t);
+			job(0);
+			for (auto& worker : workers) worker.join();
+		}
+
+		/** One bit per sample cell, cleared through the list of touched words. */
+		class SampleGrid
+		{
+		public:
+			explicit SampleGrid(uint32_t resolution)
+				: m_Bits((static_cast<size_t>(resolution) * resolution * resolution + 63) / 64, 0) {}
+
+			bool Take(size_t cell)
+			{
+				uint64_t& word = m_Bits[cell >> 6];
+				const uint64_t bit = 1ull << (cell & 63);
+				if (word & bit) return false;
+				if (word == 0) m_Touched.push_back(static_cast<uint32_t>(cell >> 6));
+				word |= bit;
+				return true;
+			}
+
+			void Clear()
+			{
+				for (uint32_t word : m_Touched) m_Bits[word] = 0;
+				m_Touched.clear();
+			}
+
+		private:
+			std::vector<uint64_t> m_Bits;
+			std::vector<uint32_t> m_Touched;
+		};
+
+		struct Chunk
+		{
+			int Level = 0;
+			uint32_t X = 0, Y = 0, Z = 0;
+			uint64_t Count = 0;
+		};
+
+		/**
+		 * Shared state of the indexing phase: node point runs are appended to
+		 * the output at atomically reserved offsets, each thread through its
+		 * own stream.
+		 */
+		class OctreeWriter
+		{
+		public:
+			struct Context
+			{
+				std::fstream File;
+				SampleGrid Grid;
+				Context(const std::string& path, uint32_t resolution)
+					: File(path, std::ios::in | std::ios::out | std::ios::binary), Grid(resolution) {}
+			};
+
+			OctreeWriter(const Cube& cube, uint32_t maxNodePoints, int gridLevel)
+				: m_Cube(cube), m_MaxNodePoints(maxNodePoints), m_GridLevel(gridLevel) {}
+
+			/** Build a chunk's subtree; its root stays in memory for the upper levels. */
+			void IndexChunk(Context& context, const Chunk& chunk, std::vector<PointRecord>&& points)
+			{
+				IndexNode(context, chunk.Level, chunk.X, chunk.Y, chunk.Z, std::move(points), true);
+			}
+
+			/** Build and write the levels above the chunk roots, down to the root. */
+			void BuildUpperLevels(Context& context)
+			{
+				for (int level = MaxDepth; level > 0; level--)
+				{
+					std::map<uint64_t, std::vector<uint64_t>> parents;
+					for (const auto& [key, node] : m_Pending)
+					{
+						if (KeyLevel(key) != level) continue;
+						parents[NodeKey(level - 1, KeyX(key) >> 1, KeyY(key) >> 1, KeyZ(key) >> 1)].push_back(key);
+					}
+
+					for (const auto& [parentKey, childKeys] : parents)
+					{
+						std::vector<PointRecord> points;
+						for (uint64_t key : childKeys)
+						{
+							auto& child = m_Pending[key].Points;
+							points.insert(points.end(), child.begin(), child.end());
+							child.clear();
+							child.shrink_to_fit();
+						}
+
+						PendingNode parent;
+						std::vector<PointRecord> children[8];
+						Split(context.Grid, level - 1, KeyX(parentKey), KeyY(parentKey), KeyZ(parentKey),
+							points, parent.Points, children);
+
+						for (uint64_t key : childKeys)
+						{
+							const int octant = static_cast<int>((KeyX(key) & 1) | ((KeyY(key) & 1) << 1) | ((KeyZ(key) & 1) << 2));
+							// A leaf chunk whose points all moved up leaves nothing behind
+							if (children[octant].empty() && !m_Pending[key].HasChildren) continue;
+							WriteNode(context, level, KeyX(key), KeyY(key), KeyZ(key), children[octant]);
+							parent.HasChildren = true;
+						}
+						for (uint64_t key : childKeys) m_Pending.erase(key);
+						m_Pending[parentKey] = std::move(parent);
+					}
+				}
+
+				auto root = m_Pending.find(NodeKey(0, 0, 0, 0));
+				if (root != m_Pending.end())
+				{
+					WriteNode(context, 0, 0, 0, 0, root->second.Points);
+					m_Pending.erase(root);
+				}
+			}
+
+			uint64_t Reserve(uint64_t bytes) { return m_End.fetch_add(bytes); }
+			uint64_t GetEnd() const { return m_End.load(); }
+			uint64_t GetPoints() const { return m_Points.load(); }
+			int GetDepth() const { return m_Depth.load(); }
+			bool Failed() const { return m_Failed.load(); }
+			void Fail() { m_Failed = true; }
+
+			struct WrittenNode
+			{
+				uint64_t Offset = 0;
+				uint32_t PointCount = 0;
+			};
+			const std::unordered_map<uint64_t, WrittenNode>& GetNodes() const { return m_Nodes; }
+
+		private:
+			struct PendingNode
+			{
+				std::vector<PointRecord> Points;
+				bool HasChildren = false;
+			};
+
+			/**
+			 * Keep the first point in every sample cell of the node, pass the
+			 * others to the child octant the cell lies in.
+			 */
+			void Split(SampleGrid& grid, int level, uint32_t x, uint32_t y, uint32_t z,
+				const std::vector<PointRecord>& points, std::vector<PointRecord>& selected,
+				std::vector<PointRecord> (&children)[8])
+			{
+				const int sampleLevel = level + m_GridLevel;
+				const uint32_t resolution = 1u << m_GridLevel;
+				const uint32_t base[3] = { x << m_GridLevel, y << m_GridLevel, z << m_GridLevel };
+
+				for (const PointRecord& point : points)
+				{
+					uint32_t cell[3];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						cell[axis] = CellAt(point.Position[axis], m_Cube.Size, sampleLevel) - base[axis];
+						cell[axis] = std::min(cell[axis], resolution - 1);   // Also catches underflow
+					}
+
+					const size_t index = (static_cast<size_t>(cell[2]) * resolution + cell[1]) * resolution + cell[0];
+					if (grid.Take(index))
+					{
+						selected.push_back(point);
+						continue;
+					}
+
+					const int half = m_GridLevel - 1;
+					const int octant = static_cast<int>((cell[0] >> half) | ((cell[1] >> half) << 1) | ((cell[2] >> half) << 2));
+					children[octant].push_back(point);
+				}
+				grid.Clear();
+			}
+
+			void IndexNode(Context& context, int level, uint32_t x, uint32_t y, uint32_t z,
+				std::vector<PointRecord>&& points, bool chunkRoot)
+			{
+				if (points.size() <= m_MaxNodePoints || level >= MaxDepth)
+				{
+					if (chunkRoot) KeepPending(level, x, y, z, std::move(points), false);
+					else WriteNode(context, level, x, y, z, points);
+					return;
+				}
+
+				std::vector<PointRecord> selected;
+				std::vector<PointRecord> children[8];
+				Split(context.Grid, level, x, y, z, points, selected, children);
+				std::vector<PointRecord>().swap(points);
+
+				if (chunkRoot) KeepPending(level, x, y, z, std::move(selected), true);
+				else WriteNode(context, level, x, y, z, selected);
+
+				for (int octant = 0; octant < 8; octant++)
+				{
+					if (children[octant].empty()) continue;
+					IndexNode(context, level + 1,
+						x * 2 + (octant & 1), y * 2 + ((octant >> 1) & 1), z * 2 + ((octant >> 2) & 1),
+						std::move(children[octant]), false);
+				}
+			}
+
+			void KeepPending(int level, uint32_t x, uint32_t y, uint32_t z, std::vector<PointRecord>&& points, bool hasChildren)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				PendingNode& node = m_Pending[NodeKey(level, x, y, z)];
+				node.Points = std::move(points);
+				node.HasChildren = hasChildren;
+			}
+
+			void WriteNode(Context& context, int level, uint32_t x, uint32_t y, uint32_t z,
+				const std::vector<PointRecord>& points)
+			{
+				const uint64_t bytes = points.size() * sizeof(PointRecord);
+				const uint64_t offset = Reserve(bytes);
+				if (bytes > 0)
+				{
+					context.File.seekp(static_cast<std::streamoff>(offset));
+					context.File.write(reinterpret_cast<const char*>(points.data()), static_cast<std::streamsize>(bytes));
+					if (!context.File) Fail();
+				}
+
+				m_Points += points.size();
+				int depth = m_Depth.load();
+				while (level > depth && !m_Depth.compare_exchange_weak(depth, level)) {}
+
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Nodes[NodeKey(level, x, y, z)] = { offset, static_cast<uint32_t>(points.size()) };
+			}
+
+			Cube m_Cube;
+			uint32_t m_MaxNodePoints;
+			int m_GridLevel;
+
+			std::atomic<uint64_t> m_End{ sizeof(Header) };
+			std::atomic<uint64_t> m_Points{ 0 };
+			std::atomic<int> m_Depth{ 0 };
+			std::atomic<bool> m_Failed{ false };
+
+			std::mutex m_Mutex;
+			std::unordered_map<uint64_t, WrittenNode> m_Nodes;
+			std::map<uint64_t, PendingNode> m_Pending;
+		};
+	}
+
+	// =========================================================================
+	// PointSource
+	// =========================================================================
+
+	double PointSource::ReadScalar(const uint8_t* data, Scalar type)
+	{
+		switch (type)
+		{
+		case Scalar::Int8:    return static_cast<double>(Load<int8_t>(data));
+		case Scalar::UInt8:   return static_cast<double>(Load<uint8_t>(data));
+		case Scalar::Int16:   return static_cast<double>(Load<int16_t>(data));
+		case Scalar::UInt16:  return static_cast<double>(Load<uint16_t>(data));
+		case Scalar::Int32:   return static_cast<double>(Load<int32_t>(data));
+		case Scalar::UInt32:  return static_cast<double>(Load<uint32_t>(data));
+		case Scalar::Float32: return static_cast<double>(Load<float>(data));
+		case Scalar::Float64: return Load<double>(data);
+		}
+		return 0.0;
+	}
+
+	bool PointSource::ParseScalar(const std::string& name, Scalar& type)
+	{
+		static const std::pair<const char*, Scalar> names[] = {
+			{ "char", Scalar::Int8 },     { "int8", Scalar::Int8 },
+			{ "uchar", Scalar::UInt8 },   { "uint8", Scalar::UInt8 },
+			{ "short", Scalar::Int16 },   { "int16", Scalar::Int16 },
+			{ "ushort", Scalar::UInt16 }, { "uint16", Scalar::UInt16 },
+			{ "int", Scalar::Int32 },     { "int32", Scalar::Int32 },
+			{ "uint", Scalar::UInt32 },   { "uint32", Scalar::UInt32 },
+			{ "float", Scalar::Float32 }, { "float32", Scalar::Float32 },
+			{ "double", Scalar::Float64 }, { "float64", Scalar::Float64 }
+		};
+		for (const auto& [text, value] : names)
+		{
+			if (name == text)
+			{
+				type = value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool PointSource::Open(const std::string& path)
+	{
+		m_Path = path;
+		m_PointCount = 0;
+		m_HasColor = false;
+		m_HasBounds = false;
+		m_Position[0] = m_Position[1] = m_Position[2] = Property();
+		m_Color[0] = m_Color[1] = m_Color[2] = Property();
+		for (int axis = 0; axis < 3; axis++)
+		{
+			m_Scale[axis] = 1.0;
+			m_Offset[axis] = 0.0;
+		}
+		m_ColorShift = 0;
+
+		if (!m_File.Open(path)) return false;
+
+		const uint8_t* data = m_File.GetData();
+		const size_t size = m_File.GetSize();
+		if (size >= 4 && std::memcmp(data, "ply", 3) == 0 && (data[3] == '\n' || data[3] == '\r'))
+			return OpenPLY();
+		if (size >= 4 && std::memcmp(data, "LASF", 4) == 0)
+			return OpenLAS();
+
+		const std::string ext = Extension(path);
+		if (ext == ".xyz" || ext == ".txt" || ext == ".pts" || ext == ".csv")
+			return OpenXYZ();
+
+		VP_CORE_ERROR("PointSource: unknown point format '{}'", path);
+		m_File.Close();
+		return false;
+	}
+
+	bool PointSource::OpenPLY()
+	{
+		const char* text = reinterpret_cast<const char*>(m_File.GetData());
+		const size_t size = m_File.GetSize();
+
+		// The header is plain text up to "end_header"
+		const std::string_view file(text, size);
+		const size_t endHeader = file.find("end_header");
+		if (endHeader == std::string_view::npos)
+		{
+			VP_CORE_ERROR("PointSource: '{}' has no PLY end_header", m_Path);
+			return false;
+		}
+		const size_t headerEnd = file.find('\n', endHeader);
+		if (headerEnd == std::string_view::npos)
+		{
+			VP_CORE_ERROR("PointSource: '{}' ends in the PLY header", m_Path);
+			return false;
+		}
+
+		std::istringstream header(std::string(text, endHeader));
+		std::string line;
+		bool binary = false;
+		bool inVertex = false;
+		bool seenVertex = false;
+		bool trailingElements = false;
+		int offset = 0;
+		int column = 0;
+		Scalar colorType = Scalar::UInt8;
+
+		while (std::getline(header, line))
+		{
+			std::istringstream words(line);
+			std::string keyword;
+			words >> keyword;
+
+			if (keyword == "format")
+			{
+				std::string format;
+				words >> format;
+				if (format == "ascii") binary = false;
+				else if (format == "binary_little_endian") binary = true;
+				else
+				{
+					VP_CORE_ERROR("PointSource: '{}' uses unsupported PLY format '{}'", m_Path, format);
+					return false;
+				}
+			}
+			else if (keyword == "element")
+			{
+				std::string name;
+				uint64_t count = 0;
+				words >> name >> count;
+				if (name == "vertex")
+				{
+					if (seenVertex)
+					{
+						VP_CORE_ERROR("PointSource: '{}' must start with the PLY vertex element", m_Path);
+						return false;
+					}
+					inVertex = true;
+					seenVertex = true;
+					m_PointCount = count;
+				}
+				else
+				{
+					if (!seenVertex && count > 0)
+					{
+						VP_CORE_ERROR("PointSource: '{}' must start with the PLY vertex element", m_Path);
+						return false;
+					}
+					if (seenVertex && count > 0) trailingElements = true;
+					inVertex = false;
+				}
+			}
+			else if (keyword == "property" && inVertex)
+			{
+				std::string typeName, name;
+				words >> typeName >> name;
+				Scalar type = Scalar::Float32;
+				if (typeName == "list" || !ParseScalar(typeName, type))
+				{
+					VP_CORE_ERROR("PointSource: '{}' has unsupported vertex property '{}'", m_Path, line);
+					return false;
+				}
+
+				Property property;
+				property.Offset = binary ? offset : column;
+				property.Type = type;
+				if (name == "x") m_Position[0] = property;
+				else if (name == "y") m_Position[1] = property;
+				else if (name == "z") m_Position[2] = property;
+				else if (name == "red" || name == "r" || name == "diffuse_red") { m_Color[0] = property; colorType = type; }
+				else if (name == "green" || name == "g" || name == "diffuse_green") m_Color[1] = property;
+				else if (name == "blue" || name == "b" || name == "diffuse_blue") m_Color[2] = property;
+
+				static constexpr int scalarSizes[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+				offset += scalarSizes[static_cast<int>(type)];
+				column++;
+			}
+		}
+
+		if (!seenVertex || m_Position[0].Offset < 0 || m_Position[1].Offset < 0 || m_Position[2].Offset < 0)
+		{
+			VP_CORE_ERROR("PointSource: '{}' has no PLY vertex positions", m_Path);
+			return false;
+		}
+
+		m_HasColor = m_Color[0].Offset >= 0 && m_Color[1].Offset >= 0 && m_Color[2].Offset >= 0;
+		m_ColorShift = (colorType == Scalar::UInt16 || colorType == Scalar::Int16) ? 8 : 0;
+		m_DataOffset = headerEnd + 1;
+
+		if (binary)
+		{
+			m_Format = Format::PLYBinary;
+			m_RecordSize = static_cast<size_t>(offset);
+			const uint64_t available = (size - m_DataOffset) / m_RecordSize;
+			if (available < m_PointCount)
+			{
+				VP_CORE_WARN("PointSource: '{}' is truncated ({} of {} points)", m_Path, available, m_PointCount);
+				m_PointCount = available;
+			}
+			m_DataEnd = m_DataOffset + m_PointCount * m_RecordSize;
+		}
+		else
+		{
+			m_Format = Format::PLYAscii;
+			m_RecordSize = 0;
+			m_DataEnd = size;
+
+			// Faces after the vertices would parse as points: find the last vertex line
+			if (trailingElements)
+			{
+				size_t position = m_DataOffset;
+				for (uint64_t i = 0; i < m_PointCount && position < size; i++)
+				{
+					const void* newline = std::memchr(text + position, '\n', size - position);
+					position = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text) + 1 : size;
+				}
+				m_DataEnd = position;
+			}
+		}
+
+		VP_CORE_INFO("PointSource: '{}' PLY {} ({} points{})", m_Path, binary ? "binary" : "ascii",
+			m_PointCount, m_HasColor ? ", color" : "");
+		return true;
+	}
+
+	bool PointSource::OpenLAS()
+	{
+		const uint8_t* data = m_File.GetData();
+		const size_t size = m_File.GetSize();
+		if (size < 227)
+		{
+			VP_CORE_ERROR("PointSource: '{}' has a truncated LAS header", m_Path);
+			return false;
+		}
+
+		const uint8_t versionMinor = data[25];
+		const uint16_t headerSize = Load<uint16_t>(data + 94);
+		const uint32_t pointOffset = Load<uint32_t>(data + 96);
+		const uint8_t formatByte = data[104];
+		const uint16_t recordLength = Load<uint16_t>(data + 105);
+
+		// Bits 6-7 mark LAZ compression
+		if (formatByte & 0xC0)
+		{
+			VP_CORE_ERROR("PointSource: '{}' is compressed (LAZ); decompress it to LAS first", m_Path);
+			return false;
+		}
+		const int pointFormat = formatByte & 0x3F;
+		if (pointFormat > 10 || recordLength < 20)
+		{
+			VP_CORE_ERROR("PointSource: '{}' uses unsupported LAS point format {}", m_Path, pointFormat);
+			return false;
+		}
+
+		uint64_t count = Load<uint32_t>(data + 107);
+		if (versionMinor >= 4 && headerSize >= 375 && size >= 255)
+		{
+			const uint64_t extended = Load<uint64_t>(data + 247);
+			if (extended > 0) count = extended;
+		}
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			m_Scale[axis] = Load<double>(data + 131 + axis * 8);
+			m_Offset[axis] = Load<double>(data + 155 + axis * 8);
+			m_BoundsMax[axis] = Load<double>(data + 179 + axis * 16);
+			m_BoundsMin[axis] = Load<double>(data + 187 + axis * 16);
+			m_Position[axis] = { axis * 4, Scalar::Int32 };
+		}
+		m_HasBounds = m_BoundsMin[0] <= m_BoundsMax[0] && m_BoundsMin[1] <= m_BoundsMax[1] && m_BoundsMin[2] <= m_BoundsMax[2];
+
+		// RGB follows the format's fixed fields
+		int colorOffset = -1;
+		switch (pointFormat)
+		{
+		case 2: colorOffset = 20; break;
+		case 3: case 5: colorOffset = 28; break;
+		case 7: case 8: case 10: colorOffset = 30; break;
+		default: break;
+		}
+		if (colorOffset >= 0 && colorOffset + 6 <= recordLength)
+		{
+			for (int channel = 0; channel < 3; channel++) m_Color[channel] = { colorOffset + channel * 2, Scalar::UInt16 };
+			m_HasColor = true;
+		}
+
+		m_Format = Format::LAS;
+		m_DataOffset = pointOffset;
+		m_RecordSize = recordLength;
+		const uint64_t available = pointOffset < size ? (size - pointOffset) / recordLength : 0;
+		if (available < count)
+		{
+			VP_CORE_WARN("PointSource: '{}' is truncated ({} of {} points)", m_Path, available, count);
+			count = available;
+		}
+		m_PointCount = count;
+		m_DataEnd = m_DataOffset + m_PointCount * m_RecordSize;
+
+		// The spec asks for 16-bit color, but many writers store 8-bit values
+		if (m_HasColor)
+		{
+			uint16_t maxValue = 0;
+			const uint64_t samples = std::min<uint64_t>(m_PointCount, 65536);
+			for (uint64_t i = 0; i < samples; i++)
+			{
+				const uint8_t* record = data + m_DataOffset + i * m_RecordSize + colorOffset;
+				for (int channel = 0; channel < 3; channel++)
+					maxValue = std::max(maxValue, Load<uint16_t>(record + channel * 2));
+			}
+			m_ColorShift = maxValue > 255 ? 8 : 0;
+		}
+
+		VP_CORE_INFO("PointSource: '{}' LAS 1.{} format {} ({} points{})", m_Path, versionMinor, pointFormat,
+			m_PointCount, m_HasColor ? ", color" : "");
+		return true;
+	}
+
+	bool PointSource::OpenXYZ()
+	{
+		const char* text = reinterpret_cast<const char*>(m_File.GetData());
+		const size_t size = m_File.GetSize();
+
+		m_Format = Format::XYZ;
+		m_DataOffset = 0;
+		m_DataEnd = size;
+		m_RecordSize = 0;
+
+		// Columns of the first line with a position: "x y z", "x y z r g b"
+		// or "x y z intensity r g b"
+		size_t position = 0;
+		size_t sampledLines = 0;
+		size_t sampledBytes = 0;
+		int columns = 0;
+		while (position < size && sampledBytes < (1u << 16))
+		{
+			const void* newline = std::memchr(text + position, '\n', size - position);
+			const size_t end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text) : size;
+
+			int lineColumns = 0;
+			const char* cursor = text + position;
+			const char* last = text + end;
+			while (cursor < last)
+			{
+				while (cursor < last && IsSeparator(*cursor)) cursor++;
+				if (cursor >= last) break;
+				double value;
+				auto result = std::from_chars(cursor, last, value);
+				if (result.ec != std::errc()) break;
+				lineColumns++;
+				cursor = result.ptr;
+			}
+			if (columns == 0 && lineColumns >= 3) columns = lineColumns;
+
+			sampledLines++;
+			sampledBytes += end + 1 - position;
+			position = end + 1;
+		}
+
+		if (columns < 3)
+		{
+			VP_CORE_ERROR("PointSource: '{}' has no 'x y z' lines", m_Path);
+			return false;
+		}
+
+		for (int axis = 0; axis < 3; axis++) m_Position[axis] = { axis, Scalar::Float64 };
+		if (columns >= 6)
+		{
+			const int first = columns >= 7 ? 4 : 3;
+			for (int channel = 0; channel < 3; channel++) m_Color[channel] = { first + channel, Scalar::UInt8 };
+			m_HasColor = true;
+		}
+
+		m_PointCount = sampledLines > 0 ? static_cast<uint64_t>(static_cast<double>(size) * sampledLines / sampledBytes) : 0;
+		VP_CORE_INFO("PointSource: '{}' XYZ ({} columns, ~{} points)", m_Path, columns, m_PointCount);
+		return true;
+	}
+
+	void PointSource::Read(unsigned part, unsigned parts,
+		const std::function<void(const SourcePoint* points, size_t count)>& sink) const
+	{
+		if (!m_File.IsOpen() || parts == 0 || part >= parts) return;
+
+		if (m_RecordSize > 0)
+		{
+			const size_t first = static_cast<size_t>(m_PointCount * part / parts);
+			const size_t last = static_cast<size_t>(m_PointCount * (part + 1) / parts);
+			ReadBinary(first, last, sink);
+		}
+		else
+		{
+			const size_t bytes = m_DataEnd - m_DataOffset;
+			const size_t begin = m_DataOffset + bytes * part / parts;
+			const size_t end = m_DataOffset + bytes * (part + 1) / parts;
+			ReadText(begin, end, sink);
+		}
+	}
+
+	void PointSource::ReadBinary(size_t first, size_t last,
+		const std::function<void(const SourcePoint*, size_t)>& sink) const
+	{
+		const uint8_t* records = m_File.GetData() + m_DataOffset;
+		const bool colorIsFloat = m_Color[0].Type == Scalar::Float32 || m_Color[0].Type == Scalar::Float64;
+
+		std::vector<SourcePoint> batch;
+		batch.reserve(BatchPoints);
+
+		for (size_t i = first; i < last; i++)
+		{
+			const uint8_t* record = records + i * m_RecordSize;
+			SourcePoint point;
+			point.X = ReadScalar(record + m_Position[0].Offset, m_Position[0].Type) * m_Scale[0] + m_Offset[0];
+			point.Y = ReadScalar(record + m_Position[1].Offset, m_Position[1].Type) * m_Scale[1] + m_Offset[1];
+			point.Z = ReadScalar(record + m_Position[2].Offset, m_Position[2].Type) * m_Scale[2] + m_Offset[2];
+			if (m_HasColor)
+			{
+				point.R = ToColor(ReadScalar(record + m_Color[0].Offset, m_Color[0].Type), colorIsFloat, m_ColorShift);
+				point.G = ToColor(ReadScalar(record + m_Color[1].Offset, m_Color[1].Type), colorIsFloat, m_ColorShift);
+				point.B = ToColor(ReadScalar(record + m_Color[2].Offset, m_Color[2].Type), colorIsFloat, m_ColorShift);
+			}
+
+			batch.push_back(point);
+			if (batch.size() == BatchPoints)
+			{
+				sink(batch.data(), batch.size());
+				batch.clear();
+			}
+		}
+		if (!batch.empty()) sink(batch.data(), batch.size());
+	}
+
+	void PointSource::ReadText(size_t begin, size_t end,
+		const std::function<void(const SourcePoint*, size_t)>& sink) const
+	{
+		const char* text = reinterpret_cast<const char*>(m_File.GetData());
+		const bool colorIsFloat = m_Color[0].Type == Scalar::Float32 || m_Color[0].Type == Scalar::Float64;
+
+		int columns = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			columns = std::max(columns, m_Position[axis].Offset + 1);
+			if (m_HasColor) columns = std::max(columns, m_Color[axis].Offset + 1);
+		}
+		std::vector<double> values(static_cast<size_t>(columns));
+
+		// A line belongs to the part it starts in
+		size_t position = begin;
+		if (position > m_DataOffset && text[position - 1] != '\n')
+		{
+			const void* newline = std::memchr(text + position, '\n', m_DataEnd - position);
+			position = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text) + 1 : m_DataEnd;
+		}
+
+		std::vector<SourcePoint> batch;
+		batch.reserve(BatchPoints);
+
+		while (position < end)
+		{
+			const void* newline = std::memchr(text + position, '\n', m_DataEnd - position);
+			const size_t lineEnd = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text) : m_DataEnd;
+
+			const char* cursor = text + position;
+			const char* last = text + lineEnd;
+			int parsed = 0;
+			while (parsed < columns && cursor < last)
+			{
+				while (cursor < last && IsSeparator(*cursor)) cursor++;
+				if (cursor >= last) break;
+				auto result = std::from_chars(cursor, last, values[parsed]);
+				if (result.ec != std::errc()) break;
+				cursor = result.ptr;
+				parsed++;
+			}
+			position = lineEnd + 1;
+
+			// Comments, counts (.pts) and short lines are skipped
+			if (parsed < columns) continue;
+
+			SourcePoint point;
+			point.X = values[m_Position[0].Offset];
+			point.Y = values[m_Position[1].Offset];
+			point.Z = values[m_Position[2].Offset];
+			if (m_HasColor)
+			{
+				point.R = ToColor(values[m_Color[0].Offset], colorIsFloat, m_ColorShift);
+				point.G = ToColor(values[m_Color[1].Offset], colorIsFloat, m_ColorShift);
+				point.B = ToColor(values[m_Color[2].Offset], colorIsFloat, m_ColorShift);
+			}
+
+			batch.push_back(point);
+			if (batch.size() == BatchPoints)
+			{
+				sink(batch.data(), batch.size());
+				batch.clear();
+			}
+		}
+		if (!batch.empty()) sink(batch.data(), batch.size());
+	}
+
+	// =========================================================================
+	// PointCloudConverter
+	// =========================================================================
+
+	PointCloudConverter::PointCloudConverter(const PointCloudBuildSettings& settings)
+		: m_Settings(settings)
+	{
+	}
+
+	bool PointCloudConverter::Convert(const std::string& inputPath, const std::string& outputPath)
+	{
+		namespace fs = std::filesystem;
+		m_Stats = PointCloudBuildStats();
+		const auto totalStart = Clock::now();
+
+		uint32_t gridResolution = std::clamp(m_Settings.GridResolution, 2u, 512u);
+		int gridLevel = 1;
+		while ((2u << gridLevel) <= gridResolution) gridLevel++;
+		gridResolution = 1u << gridLevel;   // Power of two, so sample cells nest in child cells
+
+		const uint32_t maxNodePoints = std::max(m_Settings.MaxNodePoints, 1u);
+		const uint64_t maxChunkPoints = std::max<uint64_t>(m_Settings.MaxChunkPoints, maxNodePoints);
+
+		PointSource source;
+		if (!source.Open(inputPath)) return false;
+
+		const unsigned threads = m_Settings.Threads > 0 ? m_Settings.Threads : std::max(1u, std::thread::hardware_concurrency());
+		// More parts than threads balances uneven text lines
+		const unsigned parts = threads * 4;
+
+		auto readParallel = [&](const std::function<void(unsigned thread, const SourcePoint*, size_t)>& sink)
+		{
+			std::atomic<unsigned> nextPart{ 0 };
+			ParallelFor(threads, [&](unsigned thread)
+			{
+				for (unsigned part = nextPart++; part < parts; part = nextPart++)
+					source.Read(part, parts, [&](const SourcePoint* points, size_t count) { sink(thread, points, count); });
+			});
+		};
+
+		// ---------------------------------------------------------------------
+		// 1. Bounds
+		// ---------------------------------------------------------------------
+		auto phaseStart = Clock::now();
+		double boundsMin[3], boundsMax[3];
+		if (source.HasBounds())
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				boundsMin[axis] = source.GetBoundsMin()[axis];
+				boundsMax[axis] = source.GetBoundsMax()[axis];
+			}
+		}
+		else
+		{
+			constexpr double inf = std::numeric_limits<double>::infinity();
+			std::vector<std::array<double, 6>> threadBounds(threads, { inf, inf, inf, -inf, -inf, -inf });
+			readParallel([&](unsigned thread, const SourcePoint* points, size_t count)
+			{
+				auto& bounds = threadBounds[thread];
+				for (size_t i = 0; i < count; i++)
+				{
+					const double world[3] = { points[i].X, points[i].Y, points[i].Z };
+					for (int axis = 0; axis < 3; axis++)
+					{
+						bounds[axis] = std::min(bounds[axis], world[axis]);
+						bounds[axis + 3] = std::max(bounds[axis + 3], world[axis]);
+					}
+				}
+			});
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				boundsMin[axis] = inf;
+				boundsMax[axis] = -inf;
+				for (const auto& bounds : threadBounds)
+				{
+					boundsMin[axis] = std::min(boundsMin[axis], bounds[axis]);
+					boundsMax[axis] = std::max(boundsMax[axis], bounds[axis + 3]);
+				}
+			}
+		}
+
+		if (!(boundsMin[0] <= boundsMax[0] && boundsMin[1] <= boundsMax[1] && boundsMin[2] <= boundsMax[2]))
+		{
+			VP_CORE_ERROR("PointCloudConverter: '{}' has no points", inputPath);
+			return false;
+		}
+
+		// Cube around the bounds, padded so the maximum lands inside
+		Cube cube;
+		double extent = std::max({ boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] });
+		cube.Size = std::max(extent * 1.0001, 1e-3);
+		for (int axis = 0; axis < 3; axis++)
+			cube.Min[axis] = (boundsMin[axis] + boundsMax[axis]) * 0.5 - cube.Size * 0.5;
+		m_Stats.BoundsSeconds = SecondsSince(phaseStart);
+
+		// ---------------------------------------------------------------------
+		// 2. Counting grid and chunks
+		// ---------------------------------------------------------------------
+		phaseStart = Clock::now();
+		const size_t countCells = static_cast<size_t>(CountCells) * CountCells * CountCells;
+		auto cellIndex = [](uint32_t x, uint32_t y, uint32_t z, uint32_t cells)
+		{
+			return (static_cast<size_t>(z) * cells + y) * cells + x;
+		};
+
+		std::vector<std::atomic<uint64_t>> counts(countCells);
+		std::atomic<uint64_t> inputPoints{ 0 };
+		readParallel([&](unsigned, const SourcePoint* points, size_t count)
+		{
+			inputPoints += count;
+			PointRecord record;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!ToRecord(points[i], cube, record)) continue;
+				const size_t cell = cellIndex(
+					CellAt(record.Position[0], cube.Size, CountLevel),
+					CellAt(record.Position[1], cube.Size, CountLevel),
+					CellAt(record.Position[2], cube.Size, CountLevel), CountCells);
+				counts[cell].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+		m_Stats.InputPoints = inputPoints.load();
+
+		// Count pyramid, level CountLevel down to the root
+		std::vector<std::vector<uint64_t>> pyramid(CountLevel + 1);
+		pyramid[CountLevel].resize(countCells);
+		for (size_t i = 0; i < countCells; i++) pyramid[CountLevel][i] = counts[i].load(std::memory_order_relaxed);
+		std::vector<std::atomic<uint64_t>>().swap(counts);
+
+		for (int level = CountLevel - 1; level >= 0; level--)
+		{
+			const uint32_t cells = 1u << level;
+			pyramid[level].assign(static_cast<size_t>(cells) * cells * cells, 0);
+			for (uint32_t z = 0; z < cells * 2; z++)
+				for (uint32_t y = 0; y < cells * 2; y++)
+					for (uint32_t x = 0; x < cells * 2; x++)
+						pyramid[level][cellIndex(x >> 1, y >> 1, z >> 1, cells)] += pyramid[level + 1][cellIndex(x, y, z, cells * 2)];
+		}
+
+		// Largest cells that fit the chunk budget, top-down
+		std::vector<Chunk> chunks;
+		std::vector<Chunk> stack = { Chunk{ 0, 0, 0, 0, pyramid[0][0] } };
+		while (!stack.empty())
+		{
+			Chunk cell = stack.back();
+			stack.pop_back();
+			if (cell.Count == 0) continue;
+			if (cell.Count <= maxChunkPoints || cell.Level == CountLevel)
+			{
+				chunks.push_back(cell);
+				continue;
+			}
+			const uint32_t childCells = 2u << cell.Level;
+			for (int octant = 0; octant < 8; octant++)
+			{
+				Chunk child;
+				child.Level = cell.Level + 1;
+				child.X = cell.X * 2 + (octant & 1);
+				child.Y = cell.Y * 2 + ((octant >> 1) & 1);
+				child.Z = cell.Z * 2 + ((octant >> 2) & 1);
+				child.Count = pyramid[child.Level][cellIndex(child.X, child.Y, child.Z, childCells)];
+				stack.push_back(child);
+			}
+		}
+		pyramid.clear();
+
+		if (chunks.empty())
+		{
+			VP_CORE_ERROR("PointCloudConverter: '{}' has no points inside its bounds", inputPath);
+			return false;
+		}
+
+		std::vector<uint32_t> chunkOfCell(countCells, 0);
+		for (uint32_t i = 0; i < chunks.size(); i++)
+		{
+			const Chunk& chunk = chunks[i];
+			const int shift = CountLevel - chunk.Level;
+			const uint32_t span = 1u << shift;
+			for (uint32_t z = 0; z < span; z++)
+				for (uint32_t y = 0; y < span; y++)
+					for (uint32_t x = 0; x < span; x++)
+						chunkOfCell[cellIndex((chunk.X << shift) + x, (chunk.Y << shift) + y, (chunk.Z << shift) + z, CountCells)] = i;
+		}
+		m_Stats.Chunks = static_cast<uint32_t>(chunks.size());
+		m_Stats.CountSeconds = SecondsSince(phaseStart);
+
+		// ---------------------------------------------------------------------
+		// 3. Distribute points to chunk files
+		// ---------------------------------------------------------------------
+		phaseStart = Clock::now();
+		const fs::path tempDirectory = m_Settings.TempDirectory.empty()
+			? fs::path(outputPath + ".tmp") : fs::path(m_Settings.TempDirectory);
+		std::error_code ec;
+		fs::create_directories(tempDirectory, ec);
+		if (ec)
+		{
+			VP_CORE_ERROR("PointCloudConverter: cannot create '{}': {}", tempDirectory.string(), ec.message());
+			return false;
+		}
+
+		auto chunkPath = [&](size_t chunk) { return (tempDirectory / ("chunk_" + std::to_string(chunk) + ".bin")).string(); };
+		auto cleanup = [&]()
+		{
+			std::error_code ignored;
+			fs::remove_all(tempDirectory, ignored);
+		};
+
+		const size_t flushPoints = std::clamp<size_t>(
+			DistributeBufferBytes / sizeof(PointRecord) / (static_cast<size_t>(threads) * chunks.size()), 256, MaxFlushPoints);
+		std::vector<std::mutex> chunkMutexes(chunks.size());
+		std::atomic<bool> writeFailed{ false };
+
+		auto flush = [&](size_t chunk, std::vector<PointRecord>& buffer)
+		{
+			if (buffer.empty()) return;
+			std::lock_guard<std::mutex> lock(chunkMutexes[chunk]);
+			std::ofstream file(chunkPath(chunk), std::ios::binary | std::ios::app);
+			file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(PointRecord)));
+			if (!file) writeFailed = true;
+			buffer.clear();
+		};
+
+		std::vector<std::vector<std::vector<PointRecord>>> buffers(threads);
+		for (auto& threadBuffers : buffers) threadBuffers.resize(chunks.size());
+
+		readParallel([&](unsigned thread, const SourcePoint* points, size_t count)
+		{
+			auto& threadBuffers = buffers[thread];
+			PointRecord record;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!ToRecord(points[i], cube, record)) continue;
+				const uint32_t chunk = chunkOfCell[cellIndex(
+					CellAt(record.Position[0], cube.Size, CountLevel),
+					CellAt(record.Position[1], cube.Size, CountLevel),
+					CellAt(record.Position[2], cube.Size, CountLevel), CountCells)];
+				auto& buffer = threadBuffers[chunk];
+				buffer.push_back(record);
+				if (buffer.size() >= flushPoints) flush(chunk, buffer);
+			}
+		});
+		for (auto& threadBuffers : buffers)
+			for (size_t chunk = 0; chunk < threadBuffers.size(); chunk++) flush(chunk, threadBuffers[chunk]);
+		buffers.clear();
+		chunkOfCell.clear();
+		chunkOfCell.shrink_to_fit();
+
+		if (writeFailed)
+		{
+			VP_CORE_ERROR("PointCloudConverter: failed to write chunks to '{}'", tempDirectory.string());
+			cleanup();
+			return false;
+		}
+		m_Stats.DistributeSeconds = SecondsSince(phaseStart);
+
+		// ---------------------------------------------------------------------
+		// 4-5. Index chunks, then the levels above them
+		// ---------------------------------------------------------------------
+		phaseStart = Clock::now();
+		{
+			std::ofstream create(outputPath, std::ios::binary | std::ios::trunc);
+			Header placeholder{};
+			create.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+			if (!create)
+			{
+				VP_CORE_ERROR("PointCloudConverter: cannot write '{}'", outputPath);
+				cleanup();
+				return false;
+			}
+		}
+
+		std::vector<uint32_t> order(chunks.size());
+		for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return chunks[a].Count > chunks[b].Count; });
+
+		OctreeWriter writer(cube, maxNodePoints, gridLevel);
+		std::atomic<size_t> nextChunk{ 0 };
+		ParallelFor(std::min<unsigned>(threads, static_cast<unsigned>(chunks.size())), [&](unsigned)
+		{
+			OctreeWriter::Context context(outputPath, gridResolution);
+			if (!context.File)
+			{
+				writer.Fail();
+				return;
+			}
+
+			for (size_t next = nextChunk++; next < order.size() && !writer.Failed(); next = nextChunk++)
+			{
+				const uint32_t chunk = order[next];
+				const std::string path = chunkPath(chunk);
+
+				std::vector<PointRecord> points;
+				{
+					std::ifstream file(path, std::ios::binary | std::ios::ate);
+					if (!file)
+					{
+						writer.Fail();
+						return;
+					}
+					points.resize(static_cast<size_t>(file.tellg()) / sizeof(PointRecord));
+					file.seekg(0);
+					file.read(reinterpret_cast<char*>(points.data()), static_cast<std::streamsize>(points.size() * sizeof(PointRecord)));
+					if (!file) writer.Fail();
+				}
+				std::error_code ignored;
+				fs::remove(path, ignored);
+
+				writer.IndexChunk(context, chunks[chunk], std::move(points));
+			}
+		});
+
+		{
+			OctreeWriter::Context context(outputPath, gridResolution);
+			if (!context.File) writer.Fail();
+			else writer.BuildUpperLevels(context);
+		}
+		cleanup();
+
+		// Breadth-first node table, children contiguous
+		const auto& written = writer.GetNodes();
+		std::vector<NodeRecord> table;
+		std::vector<uint64_t> keys;
+		const uint64_t rootKey = NodeKey(0, 0, 0, 0);
+		if (!writer.Failed() && written.count(rootKey))
+		{
+			table.reserve(written.size());
+			keys.reserve(written.size());
+			keys.push_back(rootKey);
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				const uint64_t key = keys[i];
+				const auto& node = written.at(key);
+
+				NodeRecord record{};
+				record.Offset = node.Offset;
+				record.PointCount = node.PointCount;
+				record.FirstChild = NoChildren;
+				record.X = KeyX(key);
+				record.Y = KeyY(key);
+				record.Z = KeyZ(key);
+				record.Level = static_cast<uint8_t>(KeyLevel(key));
+
+				for (int octant = 0; octant < 8; octant++)
+				{
+					const uint64_t child = NodeKey(KeyLevel(key) + 1,
+						record.X * 2 + (octant & 1), record.Y * 2 + ((octant >> 1) & 1), record.Z * 2 + ((octant >> 2) & 1));
+					if (!written.count(child)) continue;
+					if (record.FirstChild == NoChildren) record.FirstChild = static_cast<uint32_t>(keys.size());
+					record.ChildMask |= static_cast<uint8_t>(1u << octant);
+					keys.push_back(child);
+				}
+				table.push_back(record);
+			}
+			if (table.size() != written.size())
+				VP_CORE_WARN("PointCloudConverter: {} nodes are not reachable from the root", written.size() - table.size());
+		}
+
+		bool ok = !writer.Failed() && !table.empty();
+		if (ok)
+		{
+			Header header{};
+			header.Magic = Magic;
+			header.Version = Version;
+			header.PointCount = writer.GetPoints();
+			for (int axis = 0; axis < 3; axis++) header.Min[axis] = cube.Min[axis];
+			header.Size = cube.Size;
+			header.NodeCount = static_cast<uint32_t>(table.size());
+			header.GridResolution = gridResolution;
+			header.HierarchyOffset = writer.GetEnd();
+			header.Flags = source.HasColor() ? HasColor : 0u;
+
+			std::fstream file(outputPath, std::ios::in | std::ios::out | std::ios::binary);
+			file.seekp(static_cast<std::streamoff>(header.HierarchyOffset));
+			file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(NodeRecord)));
+			file.seekp(0);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			ok = static_cast<bool>(file);
+		}
+
+		if (!ok)
+		{
+			VP_CORE_ERROR("PointCloudConverter: failed to write '{}'", outputPath);
+			std::error_code ignored;
+			fs::remove(outputPath, ignored);
+			return false;
+		}
+
+		m_Stats.IndexSeconds = SecondsSince(phaseStart);
+		m_Stats.Points = writer.GetPoints();
+		m_Stats.Nodes = static_cast<uint32_t>(table.size());
+		m_Stats.Depth = writer.GetDepth();
+		m_Stats.TotalSeconds = SecondsSince(totalStart);
+
+		VP_CORE_INFO("PointCloudConverter: '{}' -> '{}' ({} points, {} nodes, depth {}, {} chunks, {} threads, {:.2f}s)",
+			inputPath, outputPath, m_Stats.Points, m_Stats.Nodes, m_Stats.Depth, m_Stats.Chunks, threads, m_Stats.TotalSeconds);
+		if (m_Stats.Points < m_Stats.InputPoints)
+			VP_CORE_WARN("PointCloudConverter: dropped {} points outside the bounds", m_Stats.InputPoints - m_Stats.Points);
+		return true;
+	}
+}
@@ -0,0 +1,235 @@
+// VizEngine/src/VizEngine/Core/PointCloudFile.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace VizEngine
+{
+	// =========================================================================
+	// On-disk layout
+	// =========================================================================
+
+	/**
+	 * Point cloud octree format (.vpc).
+	 *
+	 * The cloud's bounding cube is split into an octree. Every node stores a
+	 * subsample of the points in its cell, at most one per cell of a
+	 * GridResolution^3 grid over the node; the remaining points go to the
+	 * children. Drawing a node together with all of its ancestors shows every
+	 * point of its cell once (additive LOD), so a renderer can stop at any
+	 * depth.
+	 *
+	 * Layout: Header, then the points of every node as contiguous runs of
+	 * PointRecord, then the node table (HierarchyOffset) in breadth-first
+	 * order with each node's children contiguous. The root is node 0.
+	 * Positions are relative to Header::Min, so large georeferenced
+	 * coordinates keep float precision.
+	 */
+	namespace PointCloudFormat
+	{
+		constexpr uint32_t Magic = 0x4C435056;   // "VPCL"
+		constexpr uint32_t Version = 1;
+		constexpr uint32_t NoChildren = 0xFFFFFFFFu;
+		constexpr int MaxDepth = 15;             // Deeper cells keep all their points
+
+		enum HeaderFlags : uint32_t
+		{
+			HasColor = 1u << 0
+		};
+
+		struct Header
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t PointCount;
+			double Min[3];             // Cube origin (world)
+			double Size;               // Cube edge length
+			uint32_t NodeCount;
+			uint32_t GridResolution;   // Sample cells per node axis
+			uint64_t HierarchyOffset;  // NodeRecord[NodeCount]
+			uint32_t Flags;            // HeaderFlags
+			uint32_t Reserved;
+		};
+
+		struct NodeRecord
+		{
+			uint64_t Offset;           // First PointRecord, from the start of the file
+			uint32_t PointCount;
+			uint32_t FirstChild;       // Node index, NoChildren for leaves
+			uint32_t X, Y, Z;          // Cell coordinates at Level
+			uint8_t Level;             // 0 = root
+			uint8_t ChildMask;         // Bit i = octant i (x | y << 1 | z << 2) exists
+			uint16_t Reserved;
+		};
+
+		struct PointRecord
+		{
+			float Position[3];         // Relative to Header::Min
+			uint8_t Color[4];          // sRGB, alpha unused
+		};
+
+		static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 72);
+		static_assert(std::is_trivially_copyable_v<NodeRecord> && sizeof(NodeRecord) == 32);
+		static_assert(std::is_trivially_copyable_v<PointRecord> && sizeof(PointRecord) == 16);
+	}
+
+	// =========================================================================
+	// Input formats
+	// =========================================================================
+
+	/**
+	 * One point read from a source file (world coordinates, 8-bit color).
+	 */
+	struct SourcePoint
+	{
+		double X = 0.0, Y = 0.0, Z = 0.0;
+		uint8_t R = 255, G = 255, B = 255;
+	};
+
+	/**
+	 * Point input from PLY (ASCII or binary little-endian, vertex element
+	 * first), LAS 1.0-1.4 (uncompressed) or ASCII XYZ ("x y z [r g b]" per
+	 * line, .xyz/.txt/.pts).
+	 *
+	 * The file is memory mapped and split into byte ranges (records for
+	 * binary formats, whole lines for ASCII) so several threads can parse
+	 * it at once without copying it.
+	 */
+	class VizEngine_API PointSource
+	{
+	public:
+		enum class Format : uint8_t { PLYAscii, PLYBinary, LAS, XYZ };
+
+		PointSource() = default;
+
+		/**
+		 * Map and identify a file (by header, then extension).
+		 * @return false on unknown or unsupported formats (logged)
+		 */
+		bool Open(const std::string& path);
+
+		/**
+		 * Parse part `part` of `parts` equal shares, in batches.
+		 * Safe to call concurrently for different parts.
+		 */
+		void Read(unsigned part, unsigned parts,
+			const std::function<void(const SourcePoint* points, size_t count)>& sink) const;
+
+		Format GetFormat() const { return m_Format; }
+		uint64_t GetPointCount() const { return m_PointCount; }   // Estimate for ASCII XYZ
+		bool HasColor() const { return m_HasColor; }
+
+		/** LAS headers carry bounds; other formats need a pass over the points. */
+		bool HasBounds() const { return m_HasBounds; }
+		const double* GetBoundsMin() const { return m_BoundsMin; }
+		const double* GetBoundsMax() const { return m_BoundsMax; }
+
+	private:
+		enum class Scalar : uint8_t { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+		struct Property
+		{
+			int Offset = -1;   // Byte offset (binary) or column (ASCII); -1 = absent
+			Scalar Type = Scalar::Float32;
+		};
+
+		static double ReadScalar(const uint8_t* data, Scalar type);
+		static bool ParseScalar(const std::string& name, Scalar& type);
+
+		bool OpenPLY();
+		bool OpenLAS();
+		bool OpenXYZ();
+
+		void ReadBinary(size_t first, size_t last, const std::function<void(const SourcePoint*, size_t)>& sink) const;
+		void ReadText(size_t begin, size_t end, const std::function<void(const SourcePoint*, size_t)>& sink) const;
+
+		MappedFile m_File;
+		std::string m_Path;
+		Format m_Format = Format::XYZ;
+		uint64_t m_PointCount = 0;
+		bool m_HasColor = false;
+		bool m_HasBounds = false;
+		double m_BoundsMin[3] = { 0.0, 0.0, 0.0 };
+		double m_BoundsMax[3] = { 0.0, 0.0, 0.0 };
+
+		// Record layout
+		size_t m_DataOffset = 0;
+		size_t m_DataEnd = 0;
+		size_t m_RecordSize = 0;                 // 0 for ASCII
+		Property m_Position[3];
+		Property m_Color[3];
+		double m_Scale[3] = { 1.0, 1.0, 1.0 };    // LAS integer coordinates
+		double m_Offset[3] = { 0.0, 0.0, 0.0 };
+		int m_ColorShift = 0;                    // 16-bit color to 8 bits
+	};
+
+	// =========================================================================
+	// Conversion
+	// =========================================================================
+
+	struct PointCloudBuildSettings
+	{
+		unsigned Threads = 0;                  // 0 = all hardware threads
+		uint32_t MaxNodePoints = 20000;        // Leaves keep up to this many points
+		uint32_t GridResolution = 128;         // Sample cells per node axis
+		uint64_t MaxChunkPoints = 4000000;     // Points indexed in memory at once, per thread
+		std::string TempDirectory;             // Default: <output>.tmp
+	};
+
+	struct PointCloudBuildStats
+	{
+		uint64_t InputPoints = 0;
+		uint64_t Points = 0;                   // Written (points outside the bounds are dropped)
+		uint32_t Nodes = 0;
+		uint32_t Chunks = 0;
+		int Depth = 0;
+		double BoundsSeconds = 0.0;
+		double CountSeconds = 0.0;
+		double DistributeSeconds = 0.0;
+		double IndexSeconds = 0.0;
+		double TotalSeconds = 0.0;
+	};
+
+	/**
+	 * Builds a .vpc octree from a point file on disk, using all cores and
+	 * bounded memory.
+	 *
+	 * 1. Bounds (from the LAS header or a parallel pass) give the cube.
+	 * 2. A parallel pass counts points in a 128^3 grid; cells are merged
+	 *    bottom-up into chunks of at most MaxChunkPoints.
+	 * 3. A parallel pass appends every point to its chunk's temporary file.
+	 * 4. Threads take chunks (largest first), load one at a time, build its
+	 *    subtree in memory and write the nodes to the output at reserved
+	 *    offsets. The subsamples of the chunk roots stay in memory.
+	 * 5. The levels above the chunks are built from those subsamples: each
+	 *    parent takes one point per grid cell from its children, which keep
+	 *    the rest.
+	 *
+	 * Usage:
+	 *   PointCloudConverter converter(settings);
+	 *   if (converter.Convert("scan.las", "scan.vpc")) ...converter.GetStats()
+	 */
+	class VizEngine_API PointCloudConverter
+	{
+	public:
+		explicit PointCloudConverter(const PointCloudBuildSettings& settings = PointCloudBuildSettings());
+
+		/**
+		 * @return false on read/write errors (logged); the output is removed
+		 */
+		bool Convert(const std::string& inputPath, const std::string& outputPath);
+
+		const PointCloudBuildStats& GetStats() const { return m_Stats; }
+
+	private:
+		PointCloudBuildSettings m_Settings;
+		PointCloudBuildStats m_Stats;
+	};
+}
@@ -0,0 +1,121 @@
+// VizEngine/src/VizEngine/Core/Prefab.cpp
+
+#include "Prefab.h"
+#include "VizEngine/Core/Model.h"
+#include "VizEngine/Log.h"
+
+namespace VizEngine
+{
+	std::shared_ptr<const Prefab> Prefab::FromModel(const Model& model)
+	{
+		if (!model.IsValid())
+		{
+			VP_CORE_ERROR("Prefab: model '{}' has no meshes", model.GetName());
+			return nullptr;
+		}
+
+		std::shared_ptr<Prefab> prefab(new Prefab());
+		prefab->m_Name = model.GetName();
+
+		// Materials: the fields SceneObject renders with
+		const auto& materials = model.GetMaterials();
+		prefab->m_Materials.reserve(materials.size() + 1);
+		for (const Material& source : materials)
+		{
+			PrefabMaterial material;
+			material.Color = source.BaseColor;
+			material.Roughness = source.Roughness;
+			material.Metallic = source.Metallic;
+			material.TexturePtr = source.BaseColorTexture;
+			prefab->m_Materials.push_back(std::move(material));
+		}
+
+		auto addPart = [&](size_t meshIndex, uint32_t node)
+		{
+			size_t materialIndex = model.GetMaterialIndexForMesh(meshIndex);
+			if (materialIndex >= prefab->m_Materials.size())
+			{
+				// Mesh without a material: same default as Model::GetMaterialForMesh
+				const Material& fallback = model.GetMaterialForMesh(meshIndex);
+				PrefabMaterial material;
+				material.Color = fallback.BaseColor;
+				material.Roughness = fallback.Roughness;
+				material.Metallic = fallback.Metallic;
+				materialIndex = prefab->m_Materials.size();
+				prefab->m_Materials.push_back(std::move(material));
+			}
+
+			PrefabPart part;
+			part.MeshPtr = model.GetMeshes()[meshIndex];
+			part.Material = static_cast<uint32_t>(materialIndex);
+			part.Node = node;
+			part.Name = prefab->m_Nodes[node].Name.empty()
+				? prefab->m_Name + "/" + std::to_string(prefab->m_Parts.size())
+				: prefab->m_Nodes[node].Name;
+			prefab->m_Parts.push_back(std::move(part));
+		};
+
+		const auto& nodes = model.GetNodes();
+		if (nodes.empty())
+		{
+			PrefabNode root;
+			root.Name = prefab->m_Name;
+			prefab->m_Nodes.push_back(std::move(root));
+			for (size_t i = 0; i < model.GetMeshCount(); i++)
+			{
+				addPart(i, 0);
+			}
+		}
+		else
+		{
+			// Model nodes are parents-first, so one forward pass resolves World
+			prefab->m_Nodes.reserve(nodes.size());
+			for (const ModelNode& source : nodes)
+			{
+				PrefabNode node;
+				node.Name = source.Name;
+				node.Parent = source.Parent;
+				node.Local = source.LocalTransform;
+				node.World = source.Parent >= 0
+					? prefab->m_Nodes[source.Parent].World * source.LocalTransform
+					: source.LocalTransform;
+
+				uint32_t nodeIndex = static_cast<uint32_t>(prefab->m_Nodes.size());
+				prefab->m_Nodes.push_back(std::move(node));
+				for (size_t meshIndex : source.Meshes)
+				{
+					addPart(meshIndex, nodeIndex);
+				}
+			}
+		}
+
+		if (prefab->m_Parts.empty())
+		{
+			VP_CORE_ERROR("Prefab: no node of model '{}' references a mesh", model.GetName());
+			return nullptr;
+		}
+
+		VP_CORE_INFO("Prefab '{}': {} parts, {} nodes, {} materials",
+			prefab->m_Name, prefab->m_Parts.size(), prefab->m_Nodes.size(), prefab->m_Materials.size());
+		return prefab;
+	}
+
+	std::shared_ptr<const Prefab> Prefab::FromMesh(std::shared_ptr<Mesh> mesh,
+		const PrefabMaterial& material, const std::string& name)
+	{
+		std::shared_ptr<Prefab> prefab(new Prefab());
+		prefab->m_Name = name;
+
+		PrefabNode root;
+		root.Name = name;
+		prefab->m_Nodes.push_back(std::move(root));
+		prefab->m_Materials.push_back(material);
+
+		PrefabPart part;
+		part.Name = name;
+		part.MeshPtr = std::move(mesh);
+		prefab->m_Parts.push_back(std::move(part));
+
+		return prefab;
+	}
+}
@@ -0,0 +1,110 @@
+// VizEngine/src/VizEngine/Core/Prefab.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	class Mesh;
+	class Model;
+	class Texture;
+	class RenderMaterial;
+
+	/**
+	 * Material fields a prefab part gives its SceneObject.
+	 */
+	struct VizEngine_API PrefabMaterial
+	{
+		glm::vec4 Color = glm::vec4(1.0f);
+		float Roughness = 0.5f;
+		float Metallic = 0.0f;
+		std::shared_ptr<Texture> TexturePtr;
+		std::shared_ptr<RenderMaterial> MaterialRef;
+		bool LowResolution = false;
+	};
+
+	/**
+	 * A node of the prefab's hierarchy, parents first.
+	 */
+	struct VizEngine_API PrefabNode
+	{
+		std::string Name;
+		int32_t Parent = -1;                   // Node index, -1 = root
+		glm::mat4 Local = glm::mat4(1.0f);     // Relative to the parent
+		glm::mat4 World = glm::mat4(1.0f);     // Relative to the prefab origin
+	};
+
+	/**
+	 * One drawable of a prefab: a mesh at a node with a material.
+	 * Becomes one SceneObject per instance.
+	 */
+	struct VizEngine_API PrefabPart
+	{
+		std::string Name;
+		std::shared_ptr<Mesh> MeshPtr;
+		uint32_t Material = 0;                 // Index into GetMaterials()
+		uint32_t Node = 0;                     // Index into GetNodes()
+	};
+
+	/**
+	 * Immutable description of a multi-mesh object: its hierarchy, parts and
+	 * materials. Built once (normally from a Model) and shared as
+	 * shared_ptr<const Prefab>; every instance references the same meshes,
+	 * textures, materials and node matrices, so instantiating costs one
+	 * SceneObject per part and nothing else.
+	 *
+	 * Instances are placed with Scene::Instantiate(). Per-instance edits go
+	 * to the instance's SceneObjects, never to the prefab (copy-on-write):
+	 * an object whose mesh or material fields differ from its part's is
+	 * treated as overridden and drawn on its own.
+	 *
+	 * Usage:
+	 *   auto duck = Prefab::FromModel(*model);
+	 *   uint32_t id = scene.Instantiate(duck, Transform(glm::vec3(0, 0, 3)));
+	 */
+	class VizEngine_API Prefab
+	{
+	public:
+		/**
+		 * Build a prefab from a loaded model: its node hierarchy, one part per
+		 * mesh placed on a node, and its materials (base color, roughness,
+		 * metallic, base color texture). Models without nodes get a single
+		 * root node holding every mesh.
+		 * @return nullptr if the model has no meshes (logged)
+		 */
+		static std::shared_ptr<const Prefab> FromModel(const Model& model);
+
+		/**
+		 * Build a single-part prefab around one mesh.
+		 */
+		static std::shared_ptr<const Prefab> FromMesh(std::shared_ptr<Mesh> mesh,
+			const PrefabMaterial& material, const std::string& name);
+
+		const std::string& GetName() const { return m_Name; }
+		const std::vector<PrefabNode>& GetNodes() const { return m_Nodes; }
+		const std::vector<PrefabPart>& GetParts() const { return m_Parts; }
+		const std::vector<PrefabMaterial>& GetMaterials() const { return m_Materials; }
+
+		size_t GetPartCount() const { return m_Parts.size(); }
+
+		/** Material of a part (no bounds checking). */
+		const PrefabMaterial& GetPartMaterial(size_t part) const { return m_Materials[m_Parts[part].Material]; }
+
+		/** Part placement relative to the prefab origin (no bounds checking). */
+		const glm::mat4& GetPartMatrix(size_t part) const { return m_Nodes[m_Parts[part].Node].World; }
+
+	private:
+		Prefab() = default;
+
+		std::string m_Name;
+		std::vector<PrefabNode> m_Nodes;
+		std::vector<PrefabPart> m_Parts;
+		std::vector<PrefabMaterial> m_Materials;
+	};
+}
@@ -0,0 +1,598 @@
+// VizEngine/src/VizEngine/Core/Profiler.cpp
+
+#include "Profiler.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace VizEngine
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		struct RecordedPass
+		{
+			const char* Name = "";
+			uint32_t Depth = 0;
+			Clock::time_point CpuBegin;
+			Clock::time_point CpuEnd;
+			bool Closed = false;
+		};
+
+		struct RecordedFrame
+		{
+			uint64_t Frame = 0;
+			bool Pending = false;      // Recorded, not yet resolved
+			Clock::time_point Begin;
+			double CpuFrameMs = 0.0;
+			std::vector<RecordedPass> Passes;
+			std::vector<GLuint> Queries;   // Two timestamps per pass, grown on demand
+			std::vector<ProfileEvent> Events;
+			RenderStats Stats;
+			GLint64 GpuSyncNs = 0;     // GL_TIMESTAMP read at BeginFrame (0 = not sampled)
+		};
+
+		struct ProfilerState
+		{
+			bool Enabled = true;
+			bool GpuTiming = false;    // Set by Init() once a context exists
+			bool InFrame = false;
+			bool WarnedUnbalanced = false;
+			uint64_t FrameCounter = 0;
+			std::array<RecordedFrame, Profiler::MaxFramesInFlight> Frames;
+			std::vector<uint32_t> OpenPasses;   // Indices into the current frame's passes
+			FrameTimings LastFrame;
+
+			// Events arrive from any thread; EndFrame() moves them into the frame
+			std::mutex EventMutex;
+			std::vector<ProfileEvent> PendingEvents;
+			std::thread::id RenderThread = std::this_thread::get_id();
+
+			// Spike capture
+			SpikeCaptureConfig Spike;
+			std::deque<FrameTimings> History;
+			uint64_t SpikeFrame = 0;          // Spike waiting for its trailing frames (0 = none)
+			double SpikeMs = 0.0;
+			double LastCaptureMs = -1.0e12;
+			uint32_t CaptureCount = 0;
+			std::string LastCapturePath;
+			std::future<void> Writer;         // Trace file being written
+		};
+
+		const Clock::time_point& Epoch()
+		{
+			static const Clock::time_point epoch = Clock::now();
+			return epoch;
+		}
+
+		ProfilerState& State()
+		{
+			static ProfilerState state;
+			return state;
+		}
+
+		RecordedFrame& CurrentFrame(ProfilerState& state)
+		{
+			return state.Frames[state.FrameCounter % Profiler::MaxFramesInFlight];
+		}
+
+		double ToMs(Clock::duration duration)
+		{
+			return std::chrono::duration<double, std::milli>(duration).count();
+		}
+
+		double SinceEpochMs(Clock::time_point time)
+		{
+			return ToMs(time - Epoch());
+		}
+
+		uint32_t WorkerThreadIndex()
+		{
+			static std::atomic<uint32_t> next{ 1 };
+			thread_local uint32_t index = next++;
+			return index;
+		}
+
+		// =====================================================================
+		// Trace output (Chrome trace event format, times in microseconds)
+		// =====================================================================
+
+		const char* EventTypeName(ProfileEventType type)
+		{
+			switch (type)
+			{
+			case ProfileEventType::Upload:        return "Upload";
+			case ProfileEventType::ShaderCompile: return "ShaderCompile";
+			default:                              return "AssetLoad";
+			}
+		}
+
+		std::string Escape(const std::string& text)
+		{
+			std::string out;
+			out.reserve(text.size());
+			for (char c : text)
+			{
+				switch (c)
+				{
+				case '"':  out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\n': out += "\\n"; break;
+				case '\t': out += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) >= 0x20) out += c;
+					break;
+				}
+			}
+			return out;
+		}
+
+		// Track ids: 0 = render thread CPU, 1 = GPU, 2+ = event threads
+		constexpr uint32_t CpuTrack = 0;
+		constexpr uint32_t GpuTrack = 1;
+
+		bool WriteTrace(const std::string& path, const std::deque<FrameTimings>& frames, uint64_t spikeFrame, double thresholdMs)
+		{
+			std::filesystem::path parent = std::filesystem::path(path).parent_path();
+			if (!parent.empty())
+			{
+				std::error_code ec;
+				std::filesystem::create_directories(parent, ec);
+			}
+
+			std::ofstream file(path, std::ios::out | std::ios::trunc);
+			if (!file.is_open()) return false;
+
+			auto us = [](double ms) { return static_cast<long long>(ms * 1000.0); };
+			bool first = true;
+			auto begin = [&]() -> std::ofstream& { file << (first ? "\n" : ",\n"); first = false; return file; };
+
+			file << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"spikeFrame\":" << spikeFrame
+				<< ",\"thresholdMs\":" << thresholdMs << "},\"traceEvents\":[";
+
+			begin() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"VizEngine\"}}";
+			begin() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << CpuTrack << ",\"args\":{\"name\":\"CPU\"}}";
+			begin() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GpuTrack << ",\"args\":{\"name\":\"GPU\"}}";
+
+			uint32_t maxThread = 0;
+			for (const FrameTimings& frame : frames)
+			{
+				const bool spike = frame.Frame == spikeFrame;
+				begin() << "{\"name\":\"Frame " << frame.Frame << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << CpuTrack
+					<< ",\"ts\":" << us(frame.StartMs) << ",\"dur\":" << us(frame.CpuFrameMs)
+					<< ",\"args\":{\"cpuMs\":" << frame.CpuFrameMs << ",\"gpuMs\":" << frame.GpuFrameMs
+					<< ",\"events\":" << frame.Events.size() << ",\"spike\":" << (spike ? "true" : "false") << "}}";
+
+				if (spike)
+				{
+					begin() << "{\"name\":\"Spike\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << CpuTrack
+						<< ",\"ts\":" << us(frame.StartMs) << "}";
+				}
+
+				for (const PassTiming& pass : frame.Passes)
+				{
+					begin() << "{\"name\":\"" << Escape(pass.Name) << "\",\"cat\":\"pass\",\"ph\":\"X\",\"pid\":1,\"tid\":" << CpuTrack
+						<< ",\"ts\":" << us(pass.CpuStartMs) << ",\"dur\":" << us(pass.CpuMs) << "}";
+					if (pass.GpuMs > 0.0 && pass.GpuStartMs > 0.0)
+					{
+						begin() << "{\"name\":\"" << Escape(pass.Name) << "\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << GpuTrack
+							<< ",\"ts\":" << us(pass.GpuStartMs) << ",\"dur\":" << us(pass.GpuMs) << "}";
+					}
+				}
+
+				for (const ProfileEvent& event : frame.Events)
+				{
+					uint32_t track = event.Thread == 0 ? CpuTrack : GpuTrack + event.Thread;
+					maxThread = std::max(maxThread, event.Thread);
+					begin() << "{\"name\":\"" << Escape(event.Name) << "\",\"cat\":\"" << EventTypeName(event.Type)
+						<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+						<< ",\"ts\":" << us(event.StartMs) << ",\"dur\":" << us(event.DurationMs)
+						<< ",\"args\":{\"frame\":" << frame.Frame << "}}";
+				}
+
+				begin() << "{\"name\":\"Renderer\",\"ph\":\"C\",\"pid\":1,\"ts\":" << us(frame.StartMs)
+					<< ",\"args\":{\"drawCalls\":" << frame.Stats.DrawCalls
+					<< ",\"instancedDrawCalls\":" << frame.Stats.InstancedDrawCalls
+					<< ",\"triangles\":" << frame.Stats.Triangles
+					<< ",\"instances\":" << frame.Stats.Instances << "}}";
+			}
+
+			for (uint32_t thread = 1; thread <= maxThread; thread++)
+			{
+				begin() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GpuTrack + thread
+					<< ",\"args\":{\"name\":\"Worker " << thread << "\"}}";
+			}
+
+			file << "\n]}\n";
+			return file.good();
+		}
+
+		void WaitForWriter(ProfilerState& state)
+		{
+			if (state.Writer.valid())
+			{
+				state.Writer.wait();
+			}
+		}
+
+		void WriteSpikeTrace(ProfilerState& state)
+		{
+			const SpikeCaptureConfig& config = state.Spike;
+			std::string path = (std::filesystem::path(config.OutputDirectory) /
+				("spike_frame" + std::to_string(state.SpikeFrame) + "_" +
+				 std::to_string(static_cast<int>(state.SpikeMs)) + "ms.json")).string();
+
+			// The previous file is finished before the history is handed over again
+			WaitForWriter(state);
+
+			std::deque<FrameTimings> frames = state.History;
+			uint64_t spikeFrame = state.SpikeFrame;
+			double threshold = config.ThresholdMs;
+			state.Writer = std::async(std::launch::async, [path, frames = std::move(frames), spikeFrame, threshold]()
+			{
+				if (!WriteTrace(path, frames, spikeFrame, threshold))
+				{
+					VP_CORE_ERROR("Profiler: failed to write spike trace {}", path);
+				}
+			});
+
+			VP_CORE_WARN("Profiler: frame {} took {:.1f} ms, writing {} frames to {}",
+				spikeFrame, state.SpikeMs, state.History.size(), path);
+
+			state.CaptureCount++;
+			state.LastCapturePath = path;
+			state.SpikeFrame = 0;
+		}
+
+		/**
+		 * Add a resolved frame to the history, start a capture on a spike and
+		 * write it once the trailing frames have resolved.
+		 */
+		void TrackSpikes(ProfilerState& state, const FrameTimings& timings)
+		{
+			const SpikeCaptureConfig& config = state.Spike;
+			if (!config.Enabled) return;
+
+			state.History.push_back(timings);
+			double keepAfterMs = timings.StartMs - config.HistorySeconds * 1000.0;
+			while (state.History.size() > 1 &&
+				state.History.front().StartMs < keepAfterMs &&
+				state.History.front().Frame != state.SpikeFrame)
+			{
+				state.History.pop_front();
+			}
+
+			if (state.SpikeFrame == 0 && state.CaptureCount < config.MaxCaptures &&
+				timings.StartMs - state.LastCaptureMs >= config.CooldownSeconds * 1000.0)
+			{
+				double frameMs = std::max(timings.CpuFrameMs, timings.GpuFrameMs);
+				if (frameMs >= config.ThresholdMs)
+				{
+					state.SpikeFrame = timings.Frame;
+					state.SpikeMs = frameMs;
+					state.LastCaptureMs = timings.StartMs;
+				}
+			}
+
+			if (state.SpikeFrame != 0 && timings.Frame >= state.SpikeFrame + config.FramesAfterSpike)
+			{
+				WriteSpikeTrace(state);
+			}
+		}
+
+		void Resolve(ProfilerState& state, RecordedFrame& frame)
+		{
+			if (!frame.Pending) return;
+			frame.Pending = false;
+
+			FrameTimings timings;
+			timings.Frame = frame.Frame;
+			timings.CpuFrameMs = frame.CpuFrameMs;
+			timings.StartMs = SinceEpochMs(frame.Begin);
+			timings.Stats = frame.Stats;
+			timings.Events = std::move(frame.Events);
+			frame.Events.clear();
+			timings.Passes.reserve(frame.Passes.size());
+
+			for (size_t i = 0; i < frame.Passes.size(); i++)
+			{
+				const RecordedPass& pass = frame.Passes[i];
+
+				PassTiming timing;
+				timing.Name = pass.Name;
+				timing.Depth = pass.Depth;
+				timing.CpuMs = ToMs(pass.CpuEnd - pass.CpuBegin);
+				timing.CpuStartMs = SinceEpochMs(pass.CpuBegin);
+
+				if (state.GpuTiming && pass.Closed)
+				{
+					// Blocks only if the GPU is still behind this frame
+					GLuint64 begin = 0;
+					GLuint64 end = 0;
+					glGetQueryObjectui64v(frame.Queries[i * 2], GL_QUERY_RESULT, &begin);
+					glGetQueryObjectui64v(frame.Queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+					timing.GpuMs = end > begin ? static_cast<double>(end - begin) / 1.0e6 : 0.0;
+
+					if (frame.GpuSyncNs != 0)
+					{
+						timing.GpuStartMs = timings.StartMs +
+							static_cast<double>(static_cast<GLint64>(begin) - frame.GpuSyncNs) / 1.0e6;
+					}
+				}
+
+				if (timing.Depth == 0)
+				{
+					timings.GpuFrameMs += timing.GpuMs;
+				}
+				timings.Passes.push_back(std::move(timing));
+			}
+
+			timings.Valid = true;
+			TrackSpikes(state, timings);
+			state.LastFrame = std::move(timings);
+		}
+	}
+
+	const PassTiming* FrameTimings::Find(const std::string& name) const
+	{
+		for (const PassTiming& pass : Passes)
+		{
+			if (pass.Name == name) return &pass;
+		}
+		return nullptr;
+	}
+
+	void Profiler::Init()
+	{
+		ProfilerState& state = State();
+		state.GpuTiming = true;
+		state.RenderThread = std::this_thread::get_id();
+		VP_CORE_INFO("Profiler initialized (GPU timestamps, {} frames in flight)", MaxFramesInFlight);
+	}
+
+	void Profiler::Shutdown()
+	{
+		ProfilerState& state = State();
+		for (RecordedFrame& frame : state.Frames)
+		{
+			if (state.GpuTiming && !frame.Queries.empty())
+			{
+				glDeleteQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+			}
+			frame = RecordedFrame();
+		}
+		state.GpuTiming = false;
+		state.InFrame = false;
+		state.OpenPasses.clear();
+
+		// A capture still waiting for its trailing frames is written with what there is
+		if (state.SpikeFrame != 0)
+		{
+			WriteSpikeTrace(state);
+		}
+		WaitForWriter(state);
+		state.History.clear();
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		State().Enabled = enabled;
+	}
+
+	bool Profiler::IsEnabled()
+	{
+		return State().Enabled;
+	}
+
+	void Profiler::BeginFrame()
+	{
+		ProfilerState& state = State();
+		if (!state.Enabled) return;
+
+		state.FrameCounter++;
+		RecordedFrame& frame = CurrentFrame(state);
+
+		// The slot's previous frame is MaxFramesInFlight frames old by now
+		Resolve(state, frame);
+
+		frame.Frame = state.FrameCounter;
+		frame.Begin = Clock::now();
+		frame.Passes.clear();
+		frame.Stats = RenderStats();
+		frame.GpuSyncNs = 0;
+		if (state.GpuTiming && state.Spike.Enabled)
+		{
+			// Maps this frame's GPU timestamps onto the CPU timeline in traces
+			glGetInteger64v(GL_TIMESTAMP, &frame.GpuSyncNs);
+		}
+		state.OpenPasses.clear();
+		state.InFrame = true;
+	}
+
+	void Profiler::EndFrame()
+	{
+		ProfilerState& state = State();
+		if (!state.InFrame) return;
+
+		if (!state.OpenPasses.empty())
+		{
+			if (!state.WarnedUnbalanced)
+			{
+				VP_CORE_WARN("Profiler: {} pass(es) still open at end of frame", state.OpenPasses.size());
+				state.WarnedUnbalanced = true;
+			}
+			while (!state.OpenPasses.empty())
+			{
+				EndPass();
+			}
+		}
+
+		RecordedFrame& frame = CurrentFrame(state);
+		frame.CpuFrameMs = ToMs(Clock::now() - frame.Begin);
+		{
+			std::lock_guard<std::mutex> lock(state.EventMutex);
+			frame.Events.swap(state.PendingEvents);
+			state.PendingEvents.clear();
+		}
+		frame.Pending = true;
+		state.InFrame = false;
+	}
+
+	void Profiler::BeginPass(const char* name)
+	{
+		ProfilerState& state = State();
+		if (!state.InFrame) return;
+
+		RecordedFrame& frame = CurrentFrame(state);
+		uint32_t index = static_cast<uint32_t>(frame.Passes.size());
+
+		RecordedPass pass;
+		pass.Name = name;
+		pass.Depth = static_cast<uint32_t>(state.OpenPasses.size());
+		pass.CpuBegin = Clock::now();
+		frame.Passes.push_back(pass);
+		state.OpenPasses.push_back(index);
+
+		if (state.GpuTiming)
+		{
+			if (frame.Queries.size() < (index + 1) * 2)
+			{
+				size_t oldSize = frame.Queries.size();
+				frame.Queries.resize((index + 1) * 2);
+				glGenQueries(static_cast<GLsizei>(frame.Queries.size() - oldSize), frame.Queries.data() + oldSize);
+			}
+			glQueryCounter(frame.Queries[index * 2], GL_TIMESTAMP);
+		}
+	}
+
+	void Profiler::EndPass()
+	{
+		ProfilerState& state = State();
+		if (!state.InFrame || state.OpenPasses.empty()) return;
+
+		RecordedFrame& frame = CurrentFrame(state);
+		uint32_t index = state.OpenPasses.back();
+		state.OpenPasses.pop_back();
+
+		RecordedPass& pass = frame.Passes[index];
+		pass.CpuEnd = Clock::now();
+		pass.Closed = true;
+
+		if (state.GpuTiming)
+		{
+			glQueryCounter(frame.Queries[index * 2 + 1], GL_TIMESTAMP);
+		}
+	}
+
+	void Profiler::Flush()
+	{
+		ProfilerState& state = State();
+
+		// Oldest first, so LastFrame ends up as the newest
+		for (int age = MaxFramesInFlight - 1; age >= 0; age--)
+		{
+			if (state.FrameCounter < static_cast<uint64_t>(age)) continue;
+			uint64_t frameNumber = state.FrameCounter - static_cast<uint64_t>(age);
+			RecordedFrame& frame = state.Frames[frameNumber % MaxFramesInFlight];
+			if (frame.Frame == frameNumber)
+			{
+				Resolve(state, frame);
+			}
+		}
+	}
+
+	const FrameTimings& Profiler::GetLastFrame()
+	{
+		return State().LastFrame;
+	}
+
+	uint64_t Profiler::GetFrameIndex()
+	{
+		return State().FrameCounter;
+	}
+
+	double Profiler::NowMs()
+	{
+		return SinceEpochMs(Clock::now());
+	}
+
+	void Profiler::RecordEvent(ProfileEventType type, std::string name, double startMs)
+	{
+		ProfilerState& state = State();
+		if (!state.Enabled) return;
+
+		ProfileEvent event;
+		event.Type = type;
+		event.Name = std::move(name);
+		event.StartMs = startMs;
+		event.DurationMs = NowMs() - startMs;
+		event.Thread = std::this_thread::get_id() == state.RenderThread ? 0 : WorkerThreadIndex();
+
+		std::lock_guard<std::mutex> lock(state.EventMutex);
+		state.PendingEvents.push_back(std::move(event));
+	}
+
+	void Profiler::SetFrameStats(const RenderStats& stats)
+	{
+		ProfilerState& state = State();
+		if (!state.InFrame) return;
+		CurrentFrame(state).Stats = stats;
+	}
+
+	void Profiler::SetSpikeCapture(const SpikeCaptureConfig& config)
+	{
+		ProfilerState& state = State();
+		if (!config.Enabled)
+		{
+			state.History.clear();
+			state.SpikeFrame = 0;
+		}
+		state.Spike = config;
+	}
+
+	const SpikeCaptureConfig& Profiler::GetSpikeCapture()
+	{
+		return State().Spike;
+	}
+
+	bool Profiler::DumpTrace(const std::string& path)
+	{
+		ProfilerState& state = State();
+		if (state.History.empty())
+		{
+			VP_CORE_WARN("Profiler: no history to dump (enable spike capture first)");
+			return false;
+		}
+
+		WaitForWriter(state);
+		if (!WriteTrace(path, state.History, 0, state.Spike.ThresholdMs))
+		{
+			VP_CORE_ERROR("Profiler: failed to write trace {}", path);
+			return false;
+		}
+		VP_CORE_INFO("Profiler: wrote {} frames to {}", state.History.size(), path);
+		return true;
+	}
+
+	uint32_t Profiler::GetSpikeCaptureCount()
+	{
+		return State().CaptureCount;
+	}
+
+	std::string Profiler::GetLastSpikeTrace()
+	{
+		return State().LastCapturePath;
+	}
+}
@@ -0,0 +1,223 @@
+// VizEngine/src/VizEngine/Core/Profiler.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/OpenGL/RenderStats.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * CPU and GPU time of one named pass in a frame.
+	 */
+	struct PassTiming
+	{
+		std::string Name;
+		uint32_t Depth = 0;    // Nesting level (0 = top-level pass)
+		double CpuMs = 0.0;
+		double GpuMs = 0.0;    // 0 when GPU timing is unavailable
+		double CpuStartMs = 0.0;   // Profiler::NowMs() timeline
+		double GpuStartMs = 0.0;   // GPU timestamp mapped onto the same timeline (spike capture only)
+	};
+
+	/**
+	 * Kinds of work that commonly cause hitches, recorded as they happen.
+	 */
+	enum class ProfileEventType : uint8_t
+	{
+		AssetLoad,       // File read and decode (models, images)
+		Upload,          // GPU resource creation and data upload
+		ShaderCompile
+	};
+
+	/**
+	 * One asset load, upload or shader compile. Recorded from any thread and
+	 * attached to the frame during which it finished.
+	 */
+	struct ProfileEvent
+	{
+		ProfileEventType Type = ProfileEventType::AssetLoad;
+		std::string Name;
+		double StartMs = 0.0;      // Profiler::NowMs() timeline
+		double DurationMs = 0.0;
+		uint32_t Thread = 0;       // 0 = render thread, then in order of first event
+	};
+
+	/**
+	 * All passes recorded between BeginFrame() and EndFrame().
+	 */
+	struct FrameTimings
+	{
+		uint64_t Frame = 0;
+		double CpuFrameMs = 0.0;   // BeginFrame() to EndFrame()
+		double GpuFrameMs = 0.0;   // Sum of top-level pass GPU times
+		double StartMs = 0.0;      // Profiler::NowMs() at BeginFrame()
+		std::vector<PassTiming> Passes;   // In begin order
+		std::vector<ProfileEvent> Events;
+		RenderStats Stats;         // Renderer counters at the end of the frame
+		bool Valid = false;
+
+		/** @return Pass with this name, or nullptr */
+		const PassTiming* Find(const std::string& name) const;
+	};
+
+	/**
+	 * Automatic trace dumps for frames over a time budget.
+	 */
+	struct SpikeCaptureConfig
+	{
+		bool Enabled = false;
+		double ThresholdMs = 50.0;         // CPU or GPU frame time that counts as a spike
+		double HistorySeconds = 3.0;       // Frames kept before the spike
+		uint32_t FramesAfterSpike = 10;    // Frames recorded after it before writing
+		double CooldownSeconds = 5.0;      // Minimum time between two dumps
+		uint32_t MaxCaptures = 20;         // Per session
+		std::string OutputDirectory = "traces";
+	};
+
+	/**
+	 * Per-pass CPU and GPU timing.
+	 *
+	 * Passes are bracketed with BeginPass()/EndPass() (or VP_PROFILE_PASS) and
+	 * may nest. CPU time comes from a steady clock; GPU time from a pair of
+	 * GL_TIMESTAMP queries around the pass, so nested passes do not conflict
+	 * the way GL_TIME_ELAPSED queries would. Query results are read
+	 * MaxFramesInFlight frames later, when the GPU has finished with them, so
+	 * GetLastFrame() describes a frame a few frames old and never stalls.
+	 * Flush() waits for the most recent frame instead (regression runs).
+	 *
+	 * The engine calls BeginFrame()/EndFrame() around every loop iteration.
+	 *
+	 * Spike capture keeps the last few seconds of resolved frames (passes, GPU
+	 * times, renderer counters and events) in a ring buffer. When a frame
+	 * exceeds the threshold, the history around it is written as a Chrome
+	 * trace (chrome://tracing, Perfetto) on a background thread.
+	 */
+	class VizEngine_API Profiler
+	{
+	public:
+		/**
+		 * Create the query pools. Requires a current GL context.
+		 */
+		static void Init();
+
+		/**
+		 * Release the query pools.
+		 */
+		static void Shutdown();
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		/**
+		 * Start recording a frame; resolves the oldest frame in flight.
+		 */
+		static void BeginFrame();
+
+		/**
+		 * Finish recording the current frame.
+		 */
+		static void EndFrame();
+
+		/**
+		 * Open a pass. Names must stay valid until the frame resolves
+		 * (string literals are the intended use).
+		 */
+		static void BeginPass(const char* name);
+
+		/**
+		 * Close the most recently opened pass.
+		 */
+		static void EndPass();
+
+		/**
+		 * Wait for the GPU and resolve every recorded frame.
+		 */
+		static void Flush();
+
+		/**
+		 * @return Most recent frame whose timings have resolved
+		 */
+		static const FrameTimings& GetLastFrame();
+
+		/**
+		 * @return Number of the frame being recorded (FrameTimings::Frame)
+		 */
+		static uint64_t GetFrameIndex();
+
+		/**
+		 * @return Milliseconds on the profiler's steady clock (trace timeline)
+		 */
+		static double NowMs();
+
+		/**
+		 * Record an event that started at startMs (NowMs()). Thread-safe;
+		 * usually called through VP_PROFILE_EVENT.
+		 */
+		static void RecordEvent(ProfileEventType type, std::string name, double startMs);
+
+		/**
+		 * Renderer counters of the current frame; the engine calls this
+		 * right before EndFrame().
+		 */
+		static void SetFrameStats(const RenderStats& stats);
+
+		static void SetSpikeCapture(const SpikeCaptureConfig& config);
+		static const SpikeCaptureConfig& GetSpikeCapture();
+
+		/**
+		 * Write the frames currently in the history to a trace file now.
+		 * @return false if the history is empty or the file cannot be opened
+		 */
+		static bool DumpTrace(const std::string& path);
+
+		/** @return Trace files written by spike capture this session */
+		static uint32_t GetSpikeCaptureCount();
+
+		/** @return Path of the most recent spike trace (empty if none) */
+		static std::string GetLastSpikeTrace();
+
+		/** Frames recorded before their GPU timings are read back. */
+		static constexpr int MaxFramesInFlight = 3;
+	};
+
+	/**
+	 * RAII pass for VP_PROFILE_PASS.
+	 */
+	class ProfilePassScope
+	{
+	public:
+		explicit ProfilePassScope(const char* name) { Profiler::BeginPass(name); }
+		~ProfilePassScope() { Profiler::EndPass(); }
+
+		ProfilePassScope(const ProfilePassScope&) = delete;
+		ProfilePassScope& operator=(const ProfilePassScope&) = delete;
+	};
+
+	/**
+	 * RAII event for VP_PROFILE_EVENT.
+	 */
+	class ProfileEventScope
+	{
+	public:
+		ProfileEventScope(ProfileEventType type, std::string name)
+			: m_Type(type), m_Name(std::move(name)), m_StartMs(Profiler::NowMs()) {}
+		~ProfileEventScope() { Profiler::RecordEvent(m_Type, std::move(m_Name), m_StartMs); }
+
+		ProfileEventScope(const ProfileEventScope&) = delete;
+		ProfileEventScope& operator=(const ProfileEventScope&) = delete;
+
+	private:
+		ProfileEventType m_Type;
+		std::string m_Name;
+		double m_StartMs;
+	};
+}
+
+#define VP_PROFILE_CONCAT_INNER(a, b) a##b
+#define VP_PROFILE_CONCAT(a, b) VP_PROFILE_CONCAT_INNER(a, b)
+#define VP_PROFILE_PASS(name) ::VizEngine::ProfilePassScope VP_PROFILE_CONCAT(vpProfilePass, __LINE__)(name)
+#define VP_PROFILE_EVENT(type, name) ::VizEngine::ProfileEventScope VP_PROFILE_CONCAT(vpProfileEvent, __LINE__)(::VizEngine::ProfileEventType::type, name)
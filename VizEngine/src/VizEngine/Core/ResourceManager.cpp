@@ -0,0 +1,96 @@
+// VizEngine/src/VizEngine/Core/ResourceManager.cpp
+
+#include "ResourceManager.h"
+#include "VizEngine/Core/Mesh.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/Renderer/RenderMaterial.h"
+
+namespace VizEngine
+{
+	ResourceManager::~ResourceManager()
+	{
+		Clear();
+	}
+
+	template<typename T>
+	Handle<T> ResourceManager::AcquireIn(Registry<T>& registry, const std::shared_ptr<T>& resource, RefPolicy policy)
+	{
+		if (!resource) return Handle<T>();
+
+		auto it = registry.Lookup.find(resource.get());
+		if (it != registry.Lookup.end())
+		{
+			registry.Pool.AddRef(it->second);
+			return it->second;
+		}
+
+		Handle<T> handle = registry.Pool.Create(resource, policy);
+		if (handle)
+		{
+			registry.Lookup.emplace(resource.get(), handle);
+		}
+		return handle;
+	}
+
+	template<typename T>
+	void ResourceManager::ReleaseIn(Registry<T>& registry, Handle<T> handle)
+	{
+		std::shared_ptr<T>* entry = registry.Pool.Get(handle);
+		if (!entry) return;
+
+		const T* key = entry->get();
+		if (registry.Pool.Release(handle))
+		{
+			registry.Lookup.erase(key);
+		}
+	}
+
+	MeshHandle ResourceManager::Acquire(const std::shared_ptr<Mesh>& resource, RefPolicy policy)
+	{
+		return AcquireIn(m_Meshes, resource, policy);
+	}
+
+	TextureHandle ResourceManager::Acquire(const std::shared_ptr<Texture>& resource, RefPolicy policy)
+	{
+		return AcquireIn(m_Textures, resource, policy);
+	}
+
+	ShaderHandle ResourceManager::Acquire(const std::shared_ptr<Shader>& resource, RefPolicy policy)
+	{
+		return AcquireIn(m_Shaders, resource, policy);
+	}
+
+	MaterialHandle ResourceManager::Acquire(const std::shared_ptr<RenderMaterial>& resource, RefPolicy policy)
+	{
+		return AcquireIn(m_Materials, resource, policy);
+	}
+
+	void ResourceManager::Release(MeshHandle handle) { ReleaseIn(m_Meshes, handle); }
+	void ResourceManager::Release(TextureHandle handle) { ReleaseIn(m_Textures, handle); }
+	void ResourceManager::Release(ShaderHandle handle) { ReleaseIn(m_Shaders, handle); }
+	void ResourceManager::Release(MaterialHandle handle) { ReleaseIn(m_Materials, handle); }
+
+	void ResourceManager::Clear()
+	{
+		// Materials reference textures and shaders, so drop them first
+		m_Materials.Pool.Clear();
+		m_Materials.Lookup.clear();
+		m_Meshes.Pool.Clear();
+		m_Meshes.Lookup.clear();
+		m_Textures.Pool.Clear();
+		m_Textures.Lookup.clear();
+		m_Shaders.Pool.Clear();
+		m_Shaders.Lookup.clear();
+	}
+
+	size_t ResourceManager::GetTextureMemoryEstimate() const
+	{
+		size_t bytes = 0;
+		for (const std::shared_ptr<Texture>& texture : m_Textures.Pool)
+		{
+			if (texture) bytes += texture->GetMemoryEstimate();
+		}
+		return bytes;
+	}
+}
@@ -0,0 +1,138 @@
+// VizEngine/src/VizEngine/Core/ResourceManager.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Handle.h"
+#include "VizEngine/Core/ResourcePool.h"
+#include <memory>
+#include <unordered_map>
+
+namespace VizEngine
+{
+	/**
+	 * Engine-owned registry that maps meshes, textures, shaders and materials
+	 * to generational handles.
+	 *
+	 * Each registered resource is held by exactly one shared_ptr inside its
+	 * pool; everything else refers to it through a 32-bit handle and resolves
+	 * it to a raw pointer with Get(). Handle copies, validation and Counted
+	 * references are plain integer operations, so the per-draw path never
+	 * touches shared_ptr's atomic refcount.
+	 *
+	 * Registering the same object twice returns the same handle (and, for
+	 * Counted entries, adds a reference). The manager is destroyed during
+	 * Engine::Shutdown while the GL context is still current; handles held
+	 * past that point resolve to nullptr.
+	 *
+	 * Main/render thread only.
+	 */
+	class VizEngine_API ResourceManager
+	{
+	public:
+		ResourceManager() = default;
+		~ResourceManager();
+
+		ResourceManager(const ResourceManager&) = delete;
+		ResourceManager& operator=(const ResourceManager&) = delete;
+
+		// =====================================================================
+		// Registration
+		// =====================================================================
+
+		/**
+		 * Register a resource, or add a reference if it is already registered.
+		 * @param resource Object to track (null returns a null handle)
+		 * @param policy   Lifetime policy for a newly created entry
+		 * @return Handle to the resource
+		 */
+		MeshHandle Acquire(const std::shared_ptr<Mesh>& resource, RefPolicy policy = RefPolicy::Counted);
+		TextureHandle Acquire(const std::shared_ptr<Texture>& resource, RefPolicy policy = RefPolicy::Counted);
+		ShaderHandle Acquire(const std::shared_ptr<Shader>& resource, RefPolicy policy = RefPolicy::Counted);
+		MaterialHandle Acquire(const std::shared_ptr<RenderMaterial>& resource, RefPolicy policy = RefPolicy::Counted);
+
+		/**
+		 * Add a reference to a Counted entry.
+		 */
+		void AddRef(MeshHandle handle) { m_Meshes.Pool.AddRef(handle); }
+		void AddRef(TextureHandle handle) { m_Textures.Pool.AddRef(handle); }
+		void AddRef(ShaderHandle handle) { m_Shaders.Pool.AddRef(handle); }
+		void AddRef(MaterialHandle handle) { m_Materials.Pool.AddRef(handle); }
+
+		/**
+		 * Drop a reference. Counted entries are unregistered at zero and Owned
+		 * entries immediately; the object itself is freed once no shared_ptr
+		 * outside the manager refers to it.
+		 */
+		void Release(MeshHandle handle);
+		void Release(TextureHandle handle);
+		void Release(ShaderHandle handle);
+		void Release(MaterialHandle handle);
+
+		// =====================================================================
+		// Resolution (hot path)
+		// =====================================================================
+
+		/** @return The resource, or nullptr if the handle is null or stale */
+		Mesh* Get(MeshHandle handle) const { return Resolve(m_Meshes, handle); }
+		Texture* Get(TextureHandle handle) const { return Resolve(m_Textures, handle); }
+		Shader* Get(ShaderHandle handle) const { return Resolve(m_Shaders, handle); }
+		RenderMaterial* Get(MaterialHandle handle) const { return Resolve(m_Materials, handle); }
+
+		/** @return Handle of an already registered object (null if unknown); no reference added */
+		MeshHandle Find(const Mesh* resource) const { return FindIn(m_Meshes, resource); }
+		TextureHandle Find(const Texture* resource) const { return FindIn(m_Textures, resource); }
+		ShaderHandle Find(const Shader* resource) const { return FindIn(m_Shaders, resource); }
+		MaterialHandle Find(const RenderMaterial* resource) const { return FindIn(m_Materials, resource); }
+
+		// =====================================================================
+		// Maintenance
+		// =====================================================================
+
+		/**
+		 * Unregister everything, including Persistent entries.
+		 */
+		void Clear();
+
+		size_t GetMeshCount() const { return m_Meshes.Pool.Size(); }
+		size_t GetTextureCount() const { return m_Textures.Pool.Size(); }
+		size_t GetShaderCount() const { return m_Shaders.Pool.Size(); }
+		size_t GetMaterialCount() const { return m_Materials.Pool.Size(); }
+
+		/** @return Sum of Texture::GetMemoryEstimate() over registered textures */
+		size_t GetTextureMemoryEstimate() const;
+
+	private:
+		template<typename T>
+		struct Registry
+		{
+			ResourcePool<std::shared_ptr<T>, T> Pool;
+			std::unordered_map<const T*, Handle<T>> Lookup;   // Dedupe by object address
+		};
+
+		template<typename T>
+		static T* Resolve(const Registry<T>& registry, Handle<T> handle)
+		{
+			const std::shared_ptr<T>* entry = registry.Pool.Get(handle);
+			return entry ? entry->get() : nullptr;
+		}
+
+		template<typename T>
+		static Handle<T> FindIn(const Registry<T>& registry, const T* resource)
+		{
+			auto it = registry.Lookup.find(resource);
+			return it != registry.Lookup.end() ? it->second : Handle<T>();
+		}
+
+		template<typename T>
+		static Handle<T> AcquireIn(Registry<T>& registry, const std::shared_ptr<T>& resource, RefPolicy policy);
+
+		template<typename T>
+		static void ReleaseIn(Registry<T>& registry, Handle<T> handle);
+
+		Registry<Mesh> m_Meshes;
+		Registry<Texture> m_Textures;
+		Registry<Shader> m_Shaders;
+		Registry<RenderMaterial> m_Materials;
+	};
+}
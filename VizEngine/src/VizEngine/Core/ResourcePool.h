@@ -0,0 +1,232 @@
+// VizEngine/src/VizEngine/Core/ResourcePool.h
+
+#pragma once
+
+#include "VizEngine/Core/Handle.h"
+#include "VizEngine/Log.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * How a pool entry's lifetime is managed. Chosen per entry at creation.
+	 */
+	enum class RefPolicy : uint8_t
+	{
+		Owned,       // One owner calls Destroy(); AddRef/Release are errors
+		Counted,     // AddRef/Release (non-atomic, main thread); destroyed at zero
+		Persistent   // Lives until the pool is cleared; Destroy/Release are ignored
+	};
+
+	/**
+	 * Dense, generational storage addressed by Handle<Tag>.
+	 *
+	 * Values live contiguously (swap-remove on destroy), so iterating every
+	 * live entry is a linear walk. A sparse slot table maps handle indices to
+	 * dense positions and stores the generation used for validation, which is
+	 * one bounds check and one compare. Reference counts are plain integers:
+	 * the pool is meant for the main/render thread, so nothing here is atomic.
+	 *
+	 * @tparam T   Stored value type
+	 * @tparam Tag Handle tag (defaults to T); lets a pool of shared_ptr<Mesh>
+	 *             hand out Handle<Mesh>
+	 */
+	template<typename T, typename Tag = T>
+	class ResourcePool
+	{
+	public:
+		using HandleType = Handle<Tag>;
+
+		/**
+		 * Insert a value.
+		 * @return Handle to the new entry (null if the pool is full)
+		 */
+		HandleType Create(T value, RefPolicy policy = RefPolicy::Owned)
+		{
+			uint32_t slot;
+			if (!m_FreeSlots.empty())
+			{
+				slot = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+			}
+			else
+			{
+				if (m_Slots.size() > HandleType::MaxIndex)
+				{
+					VP_CORE_ERROR("ResourcePool: capacity exhausted ({} slots)", m_Slots.size());
+					return HandleType();
+				}
+				slot = static_cast<uint32_t>(m_Slots.size());
+				m_Slots.push_back(SlotInfo{});
+			}
+
+			SlotInfo& info = m_Slots[slot];
+			info.Dense = static_cast<uint32_t>(m_Dense.size());
+			info.RefCount = 1;
+			info.Policy = policy;
+
+			m_Dense.push_back(std::move(value));
+			m_DenseToSlot.push_back(slot);
+
+			return HandleType::Make(slot, info.Generation);
+		}
+
+		/**
+		 * Remove an entry. Stale or null handles are ignored.
+		 * @return true if the entry was removed
+		 */
+		bool Destroy(HandleType handle)
+		{
+			SlotInfo* info = Resolve(handle);
+			if (!info) return false;
+
+			if (info->Policy == RefPolicy::Persistent) return false;
+			if (info->Policy == RefPolicy::Counted && info->RefCount > 1)
+			{
+				VP_CORE_WARN("ResourcePool: destroying counted entry with {} outstanding references", info->RefCount);
+			}
+
+			Erase(handle.Index());
+			return true;
+		}
+
+		/**
+		 * Add a reference to a Counted entry.
+		 */
+		void AddRef(HandleType handle)
+		{
+			SlotInfo* info = Resolve(handle);
+			if (!info) return;
+
+			if (info->Policy == RefPolicy::Owned)
+			{
+				VP_CORE_ERROR("ResourcePool: AddRef on an Owned entry");
+				return;
+			}
+			info->RefCount++;
+		}
+
+		/**
+		 * Drop a reference; Counted entries are destroyed when it reaches zero.
+		 * @return true if the entry was destroyed
+		 */
+		bool Release(HandleType handle)
+		{
+			SlotInfo* info = Resolve(handle);
+			if (!info || info->Policy == RefPolicy::Persistent) return false;
+
+			if (info->Policy == RefPolicy::Owned)
+			{
+				Erase(handle.Index());
+				return true;
+			}
+
+			if (--info->RefCount == 0)
+			{
+				Erase(handle.Index());
+				return true;
+			}
+			return false;
+		}
+
+		/** @return Pointer to the value, or nullptr if the handle is null or stale */
+		T* Get(HandleType handle)
+		{
+			SlotInfo* info = Resolve(handle);
+			return info ? &m_Dense[info->Dense] : nullptr;
+		}
+
+		const T* Get(HandleType handle) const
+		{
+			const SlotInfo* info = Resolve(handle);
+			return info ? &m_Dense[info->Dense] : nullptr;
+		}
+
+		bool IsValid(HandleType handle) const { return Resolve(handle) != nullptr; }
+
+		uint32_t GetRefCount(HandleType handle) const
+		{
+			const SlotInfo* info = Resolve(handle);
+			return info ? info->RefCount : 0;
+		}
+
+		/** Handle of the entry at a dense position (for iteration). */
+		HandleType HandleAt(size_t denseIndex) const
+		{
+			uint32_t slot = m_DenseToSlot[denseIndex];
+			return HandleType::Make(slot, m_Slots[slot].Generation);
+		}
+
+		/** Remove every entry, including Persistent ones. Outstanding handles become stale. */
+		void Clear()
+		{
+			while (!m_Dense.empty())
+			{
+				Erase(m_DenseToSlot.back());
+			}
+		}
+
+		size_t Size() const { return m_Dense.size(); }
+		bool Empty() const { return m_Dense.empty(); }
+
+		// Dense iteration over live values
+		auto begin() { return m_Dense.begin(); }
+		auto end() { return m_Dense.end(); }
+		auto begin() const { return m_Dense.begin(); }
+		auto end() const { return m_Dense.end(); }
+
+	private:
+		struct SlotInfo
+		{
+			uint32_t Dense = 0;
+			uint32_t Generation = 1;     // 0 is reserved so Handle::Value 0 is null
+			uint32_t RefCount = 0;       // 0 = slot free
+			RefPolicy Policy = RefPolicy::Owned;
+		};
+
+		SlotInfo* Resolve(HandleType handle)
+		{
+			uint32_t index = handle.Index();
+			if (handle.IsNull() || index >= m_Slots.size()) return nullptr;
+
+			SlotInfo& info = m_Slots[index];
+			return (info.RefCount != 0 && info.Generation == handle.Generation()) ? &info : nullptr;
+		}
+
+		const SlotInfo* Resolve(HandleType handle) const
+		{
+			return const_cast<ResourcePool*>(this)->Resolve(handle);
+		}
+
+		void Erase(uint32_t slot)
+		{
+			SlotInfo& info = m_Slots[slot];
+			uint32_t dense = info.Dense;
+			uint32_t last = static_cast<uint32_t>(m_Dense.size() - 1);
+
+			// Swap-remove keeps values contiguous
+			if (dense != last)
+			{
+				m_Dense[dense] = std::move(m_Dense[last]);
+				m_DenseToSlot[dense] = m_DenseToSlot[last];
+				m_Slots[m_DenseToSlot[dense]].Dense = dense;
+			}
+			m_Dense.pop_back();
+			m_DenseToSlot.pop_back();
+
+			// Bump generation so old handles go stale; skip 0 on wrap
+			info.Generation = (info.Generation + 1) & HandleType::GenerationMask;
+			if (info.Generation == 0) info.Generation = 1;
+			info.RefCount = 0;
+
+			m_FreeSlots.push_back(slot);
+		}
+
+		std::vector<T> m_Dense;
+		std::vector<uint32_t> m_DenseToSlot;
+		std::vector<SlotInfo> m_Slots;
+		std::vector<uint32_t> m_FreeSlots;
+	};
+}
@@ -1,8 +1,38 @@
 #include "Scene.h"
+#include "VizEngine/Core/ResourceManager.h"
+#include "VizEngine/Log.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <map>
 
 namespace VizEngine
 {
+	namespace
+	{
+		template<typename T>
+		void SyncHandle(ResourceManager& resources, Handle<T>& handle, const std::shared_ptr<T>& resource)
+		{
+			// get() reads the pointer without touching the refcount
+			if (resources.Get(handle) == resource.get()) return;
+
+			resources.Release(handle);
+			handle = resources.Acquire(resource);
+		}
+
+		// True while an instance object still draws its part exactly as the prefab does
+		bool MatchesPrefabPart(const SceneObject& obj, const Prefab& prefab, uint32_t part)
+		{
+			const PrefabMaterial& material = prefab.GetPartMaterial(part);
+			return obj.MeshPtr == prefab.GetParts()[part].MeshPtr
+				&& obj.Color == material.Color
+				&& obj.Roughness == material.Roughness
+				&& obj.Metallic == material.Metallic
+				&& obj.TexturePtr == material.TexturePtr
+				&& obj.MaterialRef == material.MaterialRef
+				&& obj.LowResolution == material.LowResolution;
+		}
+	}
+
 	SceneObject& Scene::Add(std::shared_ptr<Mesh> mesh, const std::string& name)
 	{
 		SceneObject obj;
@@ -13,6 +43,13 @@ namespace VizEngine
 		obj.Name = name;
 
 		m_Objects.push_back(std::move(obj));
+
+		// Handles are resolved on the next SyncHandles, after the caller has
+		// finished configuring the object
+		size_t index = m_Objects.size() - 1;
+		m_PendingHandleSync.push_back(index);
+		Notify(SceneChange::Added, index);
+
 		return m_Objects.back();
 	}
 
@@ -20,13 +57,290 @@ namespace VizEngine
 	{
 		if (index < m_Objects.size())
 		{
+			uint32_t instanceID = m_Objects[index].PrefabInstanceID;
+			ReleaseHandles(m_Objects[index]);
 			m_Objects.erase(m_Objects.begin() + static_cast<std::ptrdiff_t>(index));
+
+			// Keep pending indices pointing at the same objects
+			size_t write = 0;
+			for (size_t pending : m_PendingHandleSync)
+			{
+				if (pending == index) continue;
+				m_PendingHandleSync[write++] = pending > index ? pending - 1 : pending;
+			}
+			m_PendingHandleSync.resize(write);
+
+			OnObjectRemoved(index, instanceID);
+			Notify(SceneChange::Removed, index);
 		}
 	}
 
 	void Scene::Clear()
 	{
+		for (auto& obj : m_Objects)
+		{
+			ReleaseHandles(obj);
+		}
 		m_Objects.clear();
+		m_PendingHandleSync.clear();
+		m_Instances.clear();
+
+		Notify(SceneChange::Cleared, 0);
+	}
+
+	void Scene::MarkChanged(size_t index, SceneChange change)
+	{
+		if (index >= m_Objects.size()) return;
+
+		if (change == SceneChange::Mesh || change == SceneChange::Material)
+		{
+			m_PendingHandleSync.push_back(index);
+		}
+		Notify(change, index);
+	}
+
+	uint32_t Scene::AddListener(SceneListener listener)
+	{
+		uint32_t id = m_NextListenerID++;
+		m_Listeners.emplace_back(id, std::move(listener));
+		return id;
+	}
+
+	void Scene::RemoveListener(uint32_t id)
+	{
+		for (auto it = m_Listeners.begin(); it != m_Listeners.end(); ++it)
+		{
+			if (it->first == id)
+			{
+				m_Listeners.erase(it);
+				return;
+			}
+		}
+	}
+
+	void Scene::Notify(SceneChange change, size_t index)
+	{
+		// Transforms do not affect batch membership
+		if (change != SceneChange::Transform)
+		{
+			m_PrefabBatchesDirty = true;
+		}
+
+		for (auto& [id, listener] : m_Listeners)
+		{
+			listener(change, index);
+		}
+	}
+
+	// =========================================================================
+	// Prefab Instances
+	// =========================================================================
+
+	uint32_t Scene::Instantiate(const std::shared_ptr<const Prefab>& prefab, const Transform& root,
+		const std::string& name)
+	{
+		if (!prefab)
+		{
+			VP_CORE_ERROR("Scene::Instantiate called with a null prefab");
+			return 0;
+		}
+
+		PrefabInstance instance;
+		instance.ID = m_NextInstanceID++;
+		instance.Source = prefab;
+		instance.Root = root;
+
+		const std::string& baseName = name.empty() ? prefab->GetName() : name;
+		const size_t partCount = prefab->GetPartCount();
+		const glm::mat4 rootMatrix = root.GetModelMatrix();
+
+		m_Objects.reserve(m_Objects.size() + partCount);
+		instance.Objects.reserve(partCount);
+		for (size_t i = 0; i < partCount; i++)
+		{
+			const PrefabPart& part = prefab->GetParts()[i];
+			const PrefabMaterial& material = prefab->GetPartMaterial(i);
+
+			SceneObject& obj = Add(part.MeshPtr, partCount == 1 ? baseName : baseName + "/" + part.Name);
+			obj.ObjectTransform = Transform::FromMatrix(rootMatrix * prefab->GetPartMatrix(i));
+			obj.Color = material.Color;
+			obj.Roughness = material.Roughness;
+			obj.Metallic = material.Metallic;
+			obj.TexturePtr = material.TexturePtr;
+			obj.MaterialRef = material.MaterialRef;
+			obj.LowResolution = material.LowResolution;
+			obj.PrefabInstanceID = instance.ID;
+			obj.PrefabPart = static_cast<uint32_t>(i);
+
+			instance.Objects.push_back(m_Objects.size() - 1);
+		}
+
+		uint32_t id = instance.ID;
+		m_Instances.emplace(id, std::move(instance));
+		m_PrefabBatchesDirty = true;
+		return id;
+	}
+
+	bool Scene::SetInstanceTransform(uint32_t id, const Transform& root)
+	{
+		auto it = m_Instances.find(id);
+		if (it == m_Instances.end()) return false;
+
+		PrefabInstance& instance = it->second;
+		instance.Root = root;
+
+		const glm::mat4 rootMatrix = root.GetModelMatrix();
+		for (size_t part = 0; part < instance.Objects.size(); part++)
+		{
+			size_t index = instance.Objects[part];
+			if (index == InvalidIndex) continue;
+
+			m_Objects[index].ObjectTransform = Transform::FromMatrix(rootMatrix * instance.Source->GetPartMatrix(part));
+			MarkChanged(index, SceneChange::Transform);
+		}
+		return true;
+	}
+
+	void Scene::RemoveInstance(uint32_t id)
+	{
+		auto it = m_Instances.find(id);
+		if (it == m_Instances.end()) return;
+
+		// Highest index first so the remaining indices stay valid
+		std::vector<size_t> objects;
+		for (size_t index : it->second.Objects)
+		{
+			if (index != InvalidIndex) objects.push_back(index);
+		}
+		std::sort(objects.begin(), objects.end(), std::greater<size_t>());
+
+		for (size_t index : objects)
+		{
+			Remove(index);
+		}
+	}
+
+	const PrefabInstance* Scene::FindInstance(uint32_t id) const
+	{
+		auto it = m_Instances.find(id);
+		return it != m_Instances.end() ? &it->second : nullptr;
+	}
+
+	const std::vector<PrefabBatch>& Scene::GetPrefabBatches()
+	{
+		if (m_PrefabBatchesDirty)
+		{
+			RebuildPrefabBatches();
+			m_PrefabBatchesDirty = false;
+		}
+		return m_PrefabBatches;
+	}
+
+	void Scene::OnObjectRemoved(size_t index, uint32_t instanceID)
+	{
+		// Keep every instance's object indices pointing at the same objects
+		for (auto& [id, instance] : m_Instances)
+		{
+			for (size_t& object : instance.Objects)
+			{
+				if (object == InvalidIndex) continue;
+				if (object == index) object = InvalidIndex;
+				else if (object > index) object--;
+			}
+		}
+
+		// Forget the instance once its last object is gone
+		auto it = m_Instances.find(instanceID);
+		if (it != m_Instances.end())
+		{
+			const auto& objects = it->second.Objects;
+			if (std::all_of(objects.begin(), objects.end(), [](size_t object) { return object == InvalidIndex; }))
+			{
+				m_Instances.erase(it);
+			}
+		}
+	}
+
+	void Scene::RebuildPrefabBatches()
+	{
+		m_PrefabBatches.clear();
+
+		std::map<std::pair<const Prefab*, uint32_t>, size_t> batchIndex;
+		for (const auto& [id, instance] : m_Instances)
+		{
+			const Prefab* prefab = instance.Source.get();
+			for (size_t part = 0; part < instance.Objects.size(); part++)
+			{
+				size_t index = instance.Objects[part];
+				if (index == InvalidIndex) continue;
+
+				const SceneObject& obj = m_Objects[index];
+				uint32_t partIndex = static_cast<uint32_t>(part);
+				if (!obj.Active || !MatchesPrefabPart(obj, *prefab, partIndex)) continue;
+
+				auto [it, inserted] = batchIndex.try_emplace({ prefab, partIndex }, m_PrefabBatches.size());
+				if (inserted)
+				{
+					PrefabBatch batch;
+					batch.Source = prefab;
+					batch.Part = partIndex;
+					m_PrefabBatches.push_back(std::move(batch));
+				}
+				m_PrefabBatches[it->second].Objects.push_back(index);
+			}
+		}
+
+		// Scene order, independent of instance map iteration
+		for (PrefabBatch& batch : m_PrefabBatches)
+		{
+			std::sort(batch.Objects.begin(), batch.Objects.end());
+		}
+		std::sort(m_PrefabBatches.begin(), m_PrefabBatches.end(),
+			[](const PrefabBatch& a, const PrefabBatch& b) { return a.Objects.front() < b.Objects.front(); });
+	}
+
+	void Scene::SyncHandles(ResourceManager& resources)
+	{
+		if (m_Resources != &resources)
+		{
+			// First sync, or switching managers: handles from the old one mean nothing here
+			if (m_Resources)
+			{
+				for (auto& obj : m_Objects)
+				{
+					ReleaseHandles(obj);
+				}
+			}
+			m_Resources = &resources;
+
+			m_PendingHandleSync.resize(m_Objects.size());
+			for (size_t i = 0; i < m_Objects.size(); i++)
+			{
+				m_PendingHandleSync[i] = i;
+			}
+		}
+
+		for (size_t index : m_PendingHandleSync)
+		{
+			SceneObject& obj = m_Objects[index];
+			SyncHandle(resources, obj.MeshId, obj.MeshPtr);
+			SyncHandle(resources, obj.TextureId, obj.TexturePtr);
+			SyncHandle(resources, obj.MaterialId, obj.MaterialRef);
+		}
+		m_PendingHandleSync.clear();
+	}
+
+	void Scene::ReleaseHandles(SceneObject& obj)
+	{
+		if (m_Resources)
+		{
+			m_Resources->Release(obj.MeshId);
+			m_Resources->Release(obj.TextureId);
+			m_Resources->Release(obj.MaterialId);
+		}
+		obj.MeshId = MeshHandle();
+		obj.TextureId = TextureHandle();
+		obj.MaterialId = MaterialHandle();
 	}
 
 	void Scene::Update(float deltaTime)
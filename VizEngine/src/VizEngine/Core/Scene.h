@@ -2,14 +2,63 @@
 
 #include "VizEngine/Core.h"
 #include "VizEngine/Core/SceneObject.h"
+#include "VizEngine/Core/Prefab.h"
 #include "VizEngine/Core/Camera.h"
 #include "VizEngine/OpenGL/Renderer.h"
 #include "VizEngine/OpenGL/Shader.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
 namespace VizEngine
 {
+	class ResourceManager;
+
+	/**
+	 * Kinds of scene edits reported to listeners (see Scene::AddListener).
+	 */
+	enum class SceneChange : uint8_t
+	{
+		Added,        // Object appended at index
+		Removed,      // Object at index erased; later indices shift down by one
+		Cleared,      // Every object removed (index unused)
+		Activation,   // Active flag toggled
+		Material,     // Color/alpha, Roughness/Metallic, LowResolution, TexturePtr or MaterialRef changed
+		Mesh,         // MeshPtr swapped
+		Transform     // ObjectTransform edited
+	};
+
+	/**
+	 * Callback for scene edits. Called synchronously from the editing call.
+	 */
+	using SceneListener = std::function<void(SceneChange change, size_t index)>;
+
+	/**
+	 * A prefab placed in a scene by Scene::Instantiate().
+	 */
+	struct VizEngine_API PrefabInstance
+	{
+		uint32_t ID = 0;
+		std::shared_ptr<const Prefab> Source;
+		Transform Root;
+		std::vector<size_t> Objects;    // Scene index per part, Scene::InvalidIndex once removed
+	};
+
+	/**
+	 * Instance objects that still draw one prefab part with the prefab's own
+	 * mesh and material, so a renderer can submit them as one instanced draw:
+	 * same mesh, same material, one model matrix per object.
+	 */
+	struct VizEngine_API PrefabBatch
+	{
+		const Prefab* Source = nullptr;
+		uint32_t Part = 0;
+		std::vector<size_t> Objects;    // Active, non-overridden objects in scene order
+	};
+
 	/**
 	 * Scene manages a collection of SceneObjects.
 	 * 
@@ -20,6 +69,8 @@ namespace VizEngine
 	class VizEngine_API Scene
 	{
 	public:
+		static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+
 		Scene() = default;
 		~Scene() = default;
 
@@ -43,6 +94,12 @@ namespace VizEngine
 		 */
 		SceneObject& Add(std::shared_ptr<Mesh> mesh, const std::string& name = "Object");
 
+		/**
+		 * Reserve storage for bulk adds (e.g. SceneFile::Instantiate).
+		 * References returned by Add() stay valid until the reserve is exceeded.
+		 */
+		void Reserve(size_t count) { m_Objects.reserve(count); }
+
 		/**
 		 * Remove an object by index.
 		 * @param index The index of the object to remove
@@ -54,6 +111,70 @@ namespace VizEngine
 		 */
 		void Clear();
 
+		/**
+		 * Report an edit to an existing object.
+		 * SceneObject fields are plain data, so code that changes Active, Color,
+		 * TexturePtr, MaterialRef, MeshPtr or the transform of an object already
+		 * in the scene calls this to let listeners (render lists, handle sync)
+		 * update incrementally. Add/Remove/Clear report themselves.
+		 * @param index Object index
+		 * @param change What changed
+		 */
+		void MarkChanged(size_t index, SceneChange change);
+
+		/**
+		 * Subscribe to scene edits.
+		 * @return Listener ID for RemoveListener()
+		 */
+		uint32_t AddListener(SceneListener listener);
+
+		/**
+		 * Unsubscribe a listener.
+		 */
+		void RemoveListener(uint32_t id);
+
+		// =====================================================================
+		// Prefab Instances
+		// =====================================================================
+
+		/**
+		 * Add one object per prefab part, placed at root * part matrix.
+		 * The objects share the prefab's meshes, textures and materials;
+		 * their material fields start as the prefab's values and may be
+		 * edited per object like any other (report edits with MarkChanged),
+		 * which takes that object out of its prefab batch.
+		 * Removing an instance's objects one by one is allowed.
+		 * @param name Display name (default: the prefab's name); multi-part
+		 *             objects are named "<name>/<part>"
+		 * @return Instance ID (never 0), or 0 if prefab is null
+		 */
+		uint32_t Instantiate(const std::shared_ptr<const Prefab>& prefab, const Transform& root,
+			const std::string& name = "");
+
+		/**
+		 * Move an instance: re-places every remaining object of it.
+		 * @return false if the ID is unknown
+		 */
+		bool SetInstanceTransform(uint32_t id, const Transform& root);
+
+		/**
+		 * Remove every remaining object of an instance.
+		 */
+		void RemoveInstance(uint32_t id);
+
+		/** @return Instance, or nullptr if the ID is unknown or fully removed */
+		const PrefabInstance* FindInstance(uint32_t id) const;
+
+		/** Number of live prefab instances. */
+		size_t GetInstanceCount() const { return m_Instances.size(); }
+
+		/**
+		 * Prefab batches for the current objects. Rebuilt on the first call
+		 * after an add, remove, activation, mesh or material change; free
+		 * otherwise (transform edits do not change batches).
+		 */
+		const std::vector<PrefabBatch>& GetPrefabBatches();
+
 		// =====================================================================
 		// Access (container-like)
 		// =====================================================================
@@ -99,8 +220,41 @@ namespace VizEngine
 		 */
 		void Render(Renderer& renderer, Shader& shader, const Camera& camera);
 
+		// =====================================================================
+		// Resource Handles
+		// =====================================================================
+
+		/**
+		 * Register objects' meshes, textures and materials with the resource
+		 * manager and refresh their MeshId/TextureId/MaterialId handles.
+		 * The first call (or a call with a different manager) visits every
+		 * object; later calls only visit objects added or marked with a Mesh
+		 * or Material change since the previous call. Call once per frame
+		 * before rendering.
+		 *
+		 * The scene holds one Counted reference per object handle and drops it
+		 * in Remove()/Clear().
+		 * @param resources Manager to register with (normally Engine::GetResources())
+		 */
+		void SyncHandles(ResourceManager& resources);
+
 	private:
+		void ReleaseHandles(SceneObject& obj);
+		void Notify(SceneChange change, size_t index);
+		void OnObjectRemoved(size_t index, uint32_t instanceID);
+		void RebuildPrefabBatches();
+
 		std::vector<SceneObject> m_Objects;
+		ResourceManager* m_Resources = nullptr;  // Set by SyncHandles
+		std::vector<size_t> m_PendingHandleSync;  // Objects whose handles may be stale
+
+		std::unordered_map<uint32_t, PrefabInstance> m_Instances;
+		uint32_t m_NextInstanceID = 1;
+		std::vector<PrefabBatch> m_PrefabBatches;
+		bool m_PrefabBatchesDirty = false;
+
+		std::vector<std::pair<uint32_t, SceneListener>> m_Listeners;
+		uint32_t m_NextListenerID = 1;
 	};
 }
 
@@ -0,0 +1,455 @@
+// VizEngine/src/VizEngine/Core/SceneFile.cpp
+
+#include "SceneFile.h"
+#include "VizEngine/Core/Scene.h"
+#include "VizEngine/Renderer/RenderMaterial.h"
+#include "VizEngine/Log.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace VizEngine
+{
+	using namespace SceneFileFormat;
+
+	namespace
+	{
+		size_t AlignUp(size_t value)
+		{
+			return (value + Alignment - 1) & ~(Alignment - 1);
+		}
+
+		void CopyVec3(float (&dst)[3], const glm::vec3& src)
+		{
+			dst[0] = src.x; dst[1] = src.y; dst[2] = src.z;
+		}
+
+		glm::vec3 ToVec3(const float (&src)[3])
+		{
+			return glm::vec3(src[0], src[1], src[2]);
+		}
+
+		/**
+		 * Deduplicating string blob. Offset 0 is always the empty string.
+		 */
+		class StringTable
+		{
+		public:
+			StringTable() { m_Data.push_back('\0'); }
+
+			uint32_t Add(const std::string& value)
+			{
+				if (value.empty()) return 0;
+
+				auto it = m_Offsets.find(value);
+				if (it != m_Offsets.end()) return it->second;
+
+				uint32_t offset = static_cast<uint32_t>(m_Data.size());
+				m_Data.insert(m_Data.end(), value.begin(), value.end());
+				m_Data.push_back('\0');
+				m_Offsets.emplace(value, offset);
+				return offset;
+			}
+
+			const std::vector<char>& GetData() const { return m_Data; }
+
+		private:
+			std::vector<char> m_Data;
+			std::unordered_map<std::string, uint32_t> m_Offsets;
+		};
+
+		/**
+		 * Resource pointer -> index into a name section, adding names on first use.
+		 */
+		template<typename T>
+		uint32_t IndexOf(const T* resource, const SceneAssetTable& assets, StringTable& strings,
+			std::vector<uint32_t>& names, std::unordered_map<const T*, uint32_t>& indices)
+		{
+			if (!resource) return InvalidIndex;
+
+			auto it = indices.find(resource);
+			if (it != indices.end()) return it->second;
+
+			uint32_t index = InvalidIndex;
+			if (const std::string* name = assets.FindName(resource))
+			{
+				index = static_cast<uint32_t>(names.size());
+				names.push_back(strings.Add(*name));
+			}
+			indices.emplace(resource, index);
+			return index;
+		}
+
+		template<typename T>
+		std::shared_ptr<T> ResolveIndex(const std::vector<std::shared_ptr<T>>& table, uint32_t index)
+		{
+			return index < table.size() ? table[index] : nullptr;
+		}
+
+		template<typename Record>
+		bool MapSection(const MappedFile& file, const SectionEntry& entry, std::span<const Record>& out, const char* name)
+		{
+			if (entry.Count == 0)
+			{
+				out = {};
+				return true;
+			}
+			if (entry.Stride != sizeof(Record) ||
+				entry.Offset % alignof(Record) != 0 ||
+				entry.Size != static_cast<uint64_t>(entry.Count) * sizeof(Record) ||
+				entry.Offset > file.GetSize() || entry.Size > file.GetSize() - entry.Offset)
+			{
+				VP_CORE_ERROR("SceneFile: malformed {} section", name);
+				return false;
+			}
+			out = std::span<const Record>(reinterpret_cast<const Record*>(file.GetData() + entry.Offset), entry.Count);
+			return true;
+		}
+	}
+
+	// =========================================================================
+	// SceneAssetTable
+	// =========================================================================
+
+	namespace
+	{
+		template<typename T, typename Registry>
+		void RegisterIn(Registry& registry, const std::string& name, const std::shared_ptr<T>& resource)
+		{
+			if (!resource || name.empty()) return;
+
+			// Re-registering a name replaces the previous entry
+			auto existing = registry.ByName.find(name);
+			if (existing != registry.ByName.end())
+			{
+				registry.ByPointer.erase(existing->second.get());
+			}
+			registry.ByName[name] = resource;
+			registry.ByPointer[resource.get()] = name;
+		}
+
+		template<typename T, typename Registry>
+		std::shared_ptr<T> FindIn(const Registry& registry, const std::string& name)
+		{
+			auto it = registry.ByName.find(name);
+			return it != registry.ByName.end() ? it->second : nullptr;
+		}
+
+		template<typename T, typename Registry>
+		const std::string* FindNameIn(const Registry& registry, const T* resource)
+		{
+			auto it = registry.ByPointer.find(resource);
+			return it != registry.ByPointer.end() ? &it->second : nullptr;
+		}
+	}
+
+	void SceneAssetTable::Register(const std::string& name, const std::shared_ptr<Mesh>& mesh) { RegisterIn(m_Meshes, name, mesh); }
+	void SceneAssetTable::Register(const std::string& name, const std::shared_ptr<Texture>& texture) { RegisterIn(m_Textures, name, texture); }
+	void SceneAssetTable::Register(const std::string& name, const std::shared_ptr<RenderMaterial>& material) { RegisterIn(m_Materials, name, material); }
+
+	std::shared_ptr<Mesh> SceneAssetTable::FindMesh(const std::string& name) const { return FindIn<Mesh>(m_Meshes, name); }
+	std::shared_ptr<Texture> SceneAssetTable::FindTexture(const std::string& name) const { return FindIn<Texture>(m_Textures, name); }
+	std::shared_ptr<RenderMaterial> SceneAssetTable::FindMaterial(const std::string& name) const { return FindIn<RenderMaterial>(m_Materials, name); }
+
+	const std::string* SceneAssetTable::FindName(const Mesh* mesh) const { return FindNameIn(m_Meshes, mesh); }
+	const std::string* SceneAssetTable::FindName(const Texture* texture) const { return FindNameIn(m_Textures, texture); }
+	const std::string* SceneAssetTable::FindName(const RenderMaterial* material) const { return FindNameIn(m_Materials, material); }
+
+	void SceneAssetTable::Clear()
+	{
+		m_Meshes = {};
+		m_Textures = {};
+		m_Materials = {};
+	}
+
+	// =========================================================================
+	// Save
+	// =========================================================================
+
+	bool SceneFile::Save(const std::string& path, const Scene& scene,
+		const SceneEnvironment& environment, const SceneAssetTable& assets)
+	{
+		StringTable strings;
+		std::vector<uint32_t> meshNames, textureNames, materialNames;
+		std::unordered_map<const Mesh*, uint32_t> meshIndices;
+		std::unordered_map<const Texture*, uint32_t> textureIndices;
+		std::unordered_map<const RenderMaterial*, uint32_t> materialIndices;
+
+		std::vector<ObjectRecord> objects;
+		objects.reserve(scene.Size());
+		size_t skipped = 0;
+
+		for (const SceneObject& obj : scene)
+		{
+			uint32_t mesh = IndexOf(obj.MeshPtr.get(), assets, strings, meshNames, meshIndices);
+			if (mesh == InvalidIndex)
+			{
+				skipped++;
+				continue;
+			}
+
+			ObjectRecord record{};
+			CopyVec3(record.Position, obj.ObjectTransform.Position);
+			CopyVec3(record.Rotation, obj.ObjectTransform.Rotation);
+			CopyVec3(record.Scale, obj.ObjectTransform.Scale);
+			std::memcpy(record.Color, &obj.Color.x, sizeof(record.Color));
+			record.Roughness = obj.Roughness;
+			record.Metallic = obj.Metallic;
+			record.Mesh = mesh;
+			record.Texture = IndexOf(obj.TexturePtr.get(), assets, strings, textureNames, textureIndices);
+			record.Material = IndexOf(obj.MaterialRef.get(), assets, strings, materialNames, materialIndices);
+			record.Name = strings.Add(obj.Name);
+			record.Flags = (obj.Active ? ObjectActive : 0u) | (obj.LowResolution ? ObjectLowResolution : 0u);
+			objects.push_back(record);
+		}
+
+		if (skipped > 0)
+		{
+			VP_CORE_WARN("SceneFile: skipped {} object(s) with meshes missing from the asset table", skipped);
+		}
+
+		std::vector<PointLightRecord> lights;
+		lights.reserve(environment.PointLights.size());
+		for (const PointLight& light : environment.PointLights)
+		{
+			PointLightRecord record{};
+			CopyVec3(record.Position, light.Position);
+			CopyVec3(record.Ambient, light.Ambient);
+			CopyVec3(record.Diffuse, light.Diffuse);
+			CopyVec3(record.Specular, light.Specular);
+			record.Constant = light.Constant;
+			record.Linear = light.Linear;
+			record.Quadratic = light.Quadratic;
+			lights.push_back(record);
+		}
+
+		EnvironmentRecord env{};
+		CopyVec3(env.SunDirection, environment.Sun.Direction);
+		CopyVec3(env.SunAmbient, environment.Sun.Ambient);
+		CopyVec3(env.SunDiffuse, environment.Sun.Diffuse);
+		CopyVec3(env.SunSpecular, environment.Sun.Specular);
+		std::memcpy(env.ClearColor, &environment.ClearColor.x, sizeof(env.ClearColor));
+		CopyVec3(env.LowerHemisphereColor, environment.LowerHemisphereColor);
+		env.LowerHemisphereIntensity = environment.LowerHemisphereIntensity;
+		env.IBLIntensity = environment.IBLIntensity;
+		env.EnvironmentMap = strings.Add(environment.EnvironmentMap);
+		env.Flags = (environment.UseIBL ? EnvironmentUseIBL : 0u) | (environment.HasSun ? EnvironmentHasSun : 0u);
+
+		// Lay out sections after the header, each aligned
+		struct Payload { const void* Data; size_t Count; size_t Stride; };
+		const Payload payloads[static_cast<size_t>(Section::Count)] = {
+			{ strings.GetData().data(), strings.GetData().size(), 1 },
+			{ meshNames.data(), meshNames.size(), sizeof(uint32_t) },
+			{ textureNames.data(), textureNames.size(), sizeof(uint32_t) },
+			{ materialNames.data(), materialNames.size(), sizeof(uint32_t) },
+			{ objects.data(), objects.size(), sizeof(ObjectRecord) },
+			{ lights.data(), lights.size(), sizeof(PointLightRecord) },
+			{ &env, 1, sizeof(EnvironmentRecord) },
+		};
+
+		Header header{};
+		header.Magic = Magic;
+		header.Version = Version;
+		header.SectionCount = static_cast<uint32_t>(Section::Count);
+
+		size_t offset = AlignUp(sizeof(Header));
+		for (size_t i = 0; i < static_cast<size_t>(Section::Count); i++)
+		{
+			SectionEntry& entry = header.Sections[i];
+			entry.Offset = offset;
+			entry.Size = payloads[i].Count * payloads[i].Stride;
+			entry.Count = static_cast<uint32_t>(payloads[i].Count);
+			entry.Stride = static_cast<uint32_t>(payloads[i].Stride);
+			offset = AlignUp(offset + static_cast<size_t>(entry.Size));
+		}
+		header.FileSize = offset;
+
+		std::vector<uint8_t> buffer(offset, 0);
+		std::memcpy(buffer.data(), &header, sizeof(Header));
+		for (size_t i = 0; i < static_cast<size_t>(Section::Count); i++)
+		{
+			if (header.Sections[i].Size > 0)
+			{
+				std::memcpy(buffer.data() + header.Sections[i].Offset, payloads[i].Data, static_cast<size_t>(header.Sections[i].Size));
+			}
+		}
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			VP_CORE_ERROR("SceneFile: cannot write '{}'", path);
+			return false;
+		}
+		out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		if (!out)
+		{
+			VP_CORE_ERROR("SceneFile: write to '{}' failed", path);
+			return false;
+		}
+
+		VP_CORE_INFO("SceneFile: saved '{}' ({} objects, {} meshes, {} bytes)",
+			path, objects.size(), meshNames.size(), buffer.size());
+		return true;
+	}
+
+	// =========================================================================
+	// Load
+	// =========================================================================
+
+	std::unique_ptr<SceneFile> SceneFile::Open(const std::string& path)
+	{
+		std::unique_ptr<SceneFile> file(new SceneFile());
+		if (!file->m_File.Open(path)) return nullptr;
+
+		const MappedFile& mapped = file->m_File;
+		if (mapped.GetSize() < sizeof(Header))
+		{
+			VP_CORE_ERROR("SceneFile: '{}' is too small", path);
+			return nullptr;
+		}
+
+		Header header;
+		std::memcpy(&header, mapped.GetData(), sizeof(Header));
+		if (header.Magic != Magic)
+		{
+			VP_CORE_ERROR("SceneFile: '{}' is not a scene file", path);
+			return nullptr;
+		}
+		if (header.Version != Version || header.SectionCount != static_cast<uint32_t>(Section::Count))
+		{
+			VP_CORE_ERROR("SceneFile: '{}' has unsupported version {} ({} sections)",
+				path, header.Version, header.SectionCount);
+			return nullptr;
+		}
+		if (header.FileSize != mapped.GetSize())
+		{
+			VP_CORE_ERROR("SceneFile: '{}' is truncated ({} of {} bytes)", path, mapped.GetSize(), header.FileSize);
+			return nullptr;
+		}
+
+		auto section = [&](Section s) -> const SectionEntry& { return header.Sections[static_cast<size_t>(s)]; };
+
+		std::span<const EnvironmentRecord> environment;
+		if (!MapSection(mapped, section(Section::Strings), file->m_Strings, "strings") ||
+			!MapSection(mapped, section(Section::Meshes), file->m_MeshNames, "mesh") ||
+			!MapSection(mapped, section(Section::Textures), file->m_TextureNames, "texture") ||
+			!MapSection(mapped, section(Section::Materials), file->m_MaterialNames, "material") ||
+			!MapSection(mapped, section(Section::Objects), file->m_Objects, "object") ||
+			!MapSection(mapped, section(Section::PointLights), file->m_PointLights, "light") ||
+			!MapSection(mapped, section(Section::Environment), environment, "environment"))
+		{
+			return nullptr;
+		}
+
+		// Every string offset below the blob size is then NUL-terminated
+		if (file->m_Strings.empty() || file->m_Strings.back() != '\0')
+		{
+			VP_CORE_ERROR("SceneFile: '{}' has an unterminated string table", path);
+			return nullptr;
+		}
+		file->m_Environment = environment.empty() ? nullptr : environment.data();
+
+		return file;
+	}
+
+	const char* SceneFile::GetString(uint32_t offset) const
+	{
+		return offset < m_Strings.size() ? m_Strings.data() + offset : "";
+	}
+
+	size_t SceneFile::Instantiate(Scene& scene, const SceneAssetTable& assets) const
+	{
+		// Resolve each referenced resource once, not once per object
+		std::vector<std::shared_ptr<Mesh>> meshes(m_MeshNames.size());
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			const char* name = GetString(m_MeshNames[i]);
+			meshes[i] = assets.FindMesh(name);
+			if (!meshes[i])
+			{
+				VP_CORE_WARN("SceneFile: mesh '{}' is not in the asset table; its objects are skipped", name);
+			}
+		}
+
+		std::vector<std::shared_ptr<Texture>> textures(m_TextureNames.size());
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			const char* name = GetString(m_TextureNames[i]);
+			textures[i] = assets.FindTexture(name);
+			if (!textures[i])
+			{
+				VP_CORE_WARN("SceneFile: texture '{}' is not in the asset table", name);
+			}
+		}
+
+		std::vector<std::shared_ptr<RenderMaterial>> materials(m_MaterialNames.size());
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			const char* name = GetString(m_MaterialNames[i]);
+			materials[i] = assets.FindMaterial(name);
+			if (!materials[i])
+			{
+				VP_CORE_WARN("SceneFile: material '{}' is not in the asset table", name);
+			}
+		}
+
+		scene.Reserve(scene.Size() + m_Objects.size());
+
+		size_t added = 0;
+		for (const ObjectRecord& record : m_Objects)
+		{
+			std::shared_ptr<Mesh> mesh = ResolveIndex(meshes, record.Mesh);
+			if (!mesh) continue;
+
+			SceneObject& obj = scene.Add(mesh, GetString(record.Name));
+			obj.ObjectTransform.Position = ToVec3(record.Position);
+			obj.ObjectTransform.Rotation = ToVec3(record.Rotation);
+			obj.ObjectTransform.Scale = ToVec3(record.Scale);
+			obj.Color = glm::vec4(record.Color[0], record.Color[1], record.Color[2], record.Color[3]);
+			obj.Roughness = record.Roughness;
+			obj.Metallic = record.Metallic;
+			obj.TexturePtr = ResolveIndex(textures, record.Texture);
+			obj.MaterialRef = ResolveIndex(materials, record.Material);
+			obj.Active = (record.Flags & ObjectActive) != 0;
+			obj.LowResolution = (record.Flags & ObjectLowResolution) != 0;
+			added++;
+		}
+
+		return added;
+	}
+
+	SceneEnvironment SceneFile::ReadEnvironment() const
+	{
+		SceneEnvironment environment;
+
+		environment.PointLights.reserve(m_PointLights.size());
+		for (const PointLightRecord& record : m_PointLights)
+		{
+			PointLight light;
+			light.Position = ToVec3(record.Position);
+			light.Ambient = ToVec3(record.Ambient);
+			light.Diffuse = ToVec3(record.Diffuse);
+			light.Specular = ToVec3(record.Specular);
+			light.Constant = record.Constant;
+			light.Linear = record.Linear;
+			light.Quadratic = record.Quadratic;
+			environment.PointLights.push_back(light);
+		}
+
+		if (!m_Environment) return environment;
+
+		const EnvironmentRecord& env = *m_Environment;
+		environment.HasSun = (env.Flags & EnvironmentHasSun) != 0;
+		environment.Sun.Direction = ToVec3(env.SunDirection);
+		environment.Sun.Ambient = ToVec3(env.SunAmbient);
+		environment.Sun.Diffuse = ToVec3(env.SunDiffuse);
+		environment.Sun.Specular = ToVec3(env.SunSpecular);
+		environment.ClearColor = glm::vec4(env.ClearColor[0], env.ClearColor[1], env.ClearColor[2], env.ClearColor[3]);
+		environment.LowerHemisphereColor = ToVec3(env.LowerHemisphereColor);
+		environment.LowerHemisphereIntensity = env.LowerHemisphereIntensity;
+		environment.IBLIntensity = env.IBLIntensity;
+		environment.UseIBL = (env.Flags & EnvironmentUseIBL) != 0;
+		environment.EnvironmentMap = GetString(env.EnvironmentMap);
+		return environment;
+	}
+}
@@ -0,0 +1,270 @@
+// VizEngine/src/VizEngine/Core/SceneFile.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Light.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "glm.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+	class Scene;
+	class Mesh;
+	class Texture;
+	class RenderMaterial;
+
+	// =========================================================================
+	// On-disk layout
+	// =========================================================================
+
+	/**
+	 * Binary scene format (.vpscene).
+	 *
+	 * A fixed header holds a table of sections; each section is a flat array
+	 * of one POD record type, 16-byte aligned, so a mapped file is used in
+	 * place. Strings live in one NUL-terminated blob and are referenced by
+	 * byte offset. Meshes, textures and materials are stored as names only;
+	 * the application maps names to loaded resources with a SceneAssetTable.
+	 *
+	 * Little-endian, no padding surprises: every record is static_asserted
+	 * below. Readers reject sections whose Stride differs from the record
+	 * size, so a layout change needs a new Version.
+	 */
+	namespace SceneFileFormat
+	{
+		constexpr uint32_t Magic = 0x43535056;   // "VPSC"
+		constexpr uint32_t Version = 1;
+		constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+		constexpr size_t Alignment = 16;
+
+		enum class Section : uint32_t
+		{
+			Strings = 0,     // char[], every string NUL-terminated
+			Meshes,          // uint32_t name offsets
+			Textures,        // uint32_t name offsets
+			Materials,       // uint32_t name offsets
+			Objects,         // ObjectRecord[]
+			PointLights,     // PointLightRecord[]
+			Environment,     // EnvironmentRecord[1]
+			Count
+		};
+
+		struct SectionEntry
+		{
+			uint64_t Offset;   // From the start of the file
+			uint64_t Size;     // Bytes
+			uint32_t Count;    // Records
+			uint32_t Stride;   // Bytes per record
+		};
+
+		struct Header
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint32_t SectionCount;
+			uint32_t Reserved;
+			uint64_t FileSize;
+			uint64_t Reserved2;
+			SectionEntry Sections[static_cast<size_t>(Section::Count)];
+		};
+
+		enum ObjectFlags : uint32_t
+		{
+			ObjectActive = 1u << 0,
+			ObjectLowResolution = 1u << 1
+		};
+
+		struct ObjectRecord
+		{
+			float Position[3];
+			float Rotation[3];   // Euler radians
+			float Scale[3];
+			float Color[4];
+			float Roughness;
+			float Metallic;
+			uint32_t Mesh;       // Index into Meshes, or InvalidIndex
+			uint32_t Texture;    // Index into Textures, or InvalidIndex
+			uint32_t Material;   // Index into Materials, or InvalidIndex
+			uint32_t Name;       // String offset
+			uint32_t Flags;      // ObjectFlags
+			uint32_t Padding[4];
+		};
+
+		struct PointLightRecord
+		{
+			float Position[3];
+			float Ambient[3];
+			float Diffuse[3];
+			float Specular[3];
+			float Constant;
+			float Linear;
+			float Quadratic;
+			uint32_t Padding;
+		};
+
+		enum EnvironmentFlags : uint32_t
+		{
+			EnvironmentUseIBL = 1u << 0,
+			EnvironmentHasSun = 1u << 1
+		};
+
+		struct EnvironmentRecord
+		{
+			float SunDirection[3];
+			float SunAmbient[3];
+			float SunDiffuse[3];
+			float SunSpecular[3];
+			float ClearColor[4];
+			float LowerHemisphereColor[3];
+			float LowerHemisphereIntensity;
+			float IBLIntensity;
+			uint32_t EnvironmentMap;   // String offset (empty string = none)
+			uint32_t Flags;            // EnvironmentFlags
+			uint32_t Padding;
+		};
+
+		static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 32 + 24 * static_cast<size_t>(Section::Count));
+		static_assert(std::is_trivially_copyable_v<ObjectRecord> && sizeof(ObjectRecord) == 96);
+		static_assert(std::is_trivially_copyable_v<PointLightRecord> && sizeof(PointLightRecord) == 64);
+		static_assert(std::is_trivially_copyable_v<EnvironmentRecord> && sizeof(EnvironmentRecord) == 96);
+	}
+
+	// =========================================================================
+	// Runtime types
+	// =========================================================================
+
+	/**
+	 * Lights and environment settings saved alongside the objects.
+	 */
+	struct SceneEnvironment
+	{
+		bool HasSun = true;
+		DirectionalLight Sun;
+		std::vector<PointLight> PointLights;
+
+		std::string EnvironmentMap;   // HDR path, empty = none
+		bool UseIBL = true;
+		float IBLIntensity = 1.0f;
+		glm::vec3 LowerHemisphereColor = glm::vec3(0.15f, 0.15f, 0.2f);
+		float LowerHemisphereIntensity = 0.5f;
+		glm::vec4 ClearColor = glm::vec4(0.1f, 0.1f, 0.15f, 1.0f);
+	};
+
+	/**
+	 * Two-way mapping between names and loaded meshes, textures and
+	 * materials. Saving looks up each object's resources by pointer;
+	 * loading looks names up once per referenced resource.
+	 */
+	class VizEngine_API SceneAssetTable
+	{
+	public:
+		void Register(const std::string& name, const std::shared_ptr<Mesh>& mesh);
+		void Register(const std::string& name, const std::shared_ptr<Texture>& texture);
+		void Register(const std::string& name, const std::shared_ptr<RenderMaterial>& material);
+
+		std::shared_ptr<Mesh> FindMesh(const std::string& name) const;
+		std::shared_ptr<Texture> FindTexture(const std::string& name) const;
+		std::shared_ptr<RenderMaterial> FindMaterial(const std::string& name) const;
+
+		/** @return Registered name, or nullptr if the object is unknown */
+		const std::string* FindName(const Mesh* mesh) const;
+		const std::string* FindName(const Texture* texture) const;
+		const std::string* FindName(const RenderMaterial* material) const;
+
+		void Clear();
+
+	private:
+		template<typename T>
+		struct Registry
+		{
+			std::unordered_map<std::string, std::shared_ptr<T>> ByName;
+			std::unordered_map<const T*, std::string> ByPointer;
+		};
+
+		Registry<Mesh> m_Meshes;
+		Registry<Texture> m_Textures;
+		Registry<RenderMaterial> m_Materials;
+	};
+
+	/**
+	 * A memory-mapped .vpscene file.
+	 *
+	 * Open() maps the file and validates the header and section table once;
+	 * the accessors then return spans straight into the mapping, with no
+	 * per-object parsing. Instantiate() resolves each referenced resource
+	 * name once and appends the objects to a Scene.
+	 *
+	 * Usage:
+	 *   SceneFile::Save("level.vpscene", scene, environment, assets);
+	 *   ...
+	 *   if (auto file = SceneFile::Open("level.vpscene"))
+	 *   {
+	 *       scene.Clear();
+	 *       file->Instantiate(scene, assets);
+	 *       SceneEnvironment env = file->ReadEnvironment();
+	 *   }
+	 */
+	class VizEngine_API SceneFile
+	{
+	public:
+		/**
+		 * Write a scene. Objects whose mesh is not in the asset table are
+		 * skipped (logged); unknown textures/materials are saved as none.
+		 * @return false on I/O failure
+		 */
+		static bool Save(const std::string& path, const Scene& scene,
+			const SceneEnvironment& environment, const SceneAssetTable& assets);
+
+		/**
+		 * Map and validate a file.
+		 * @return nullptr if the file is missing or malformed (logged)
+		 */
+		static std::unique_ptr<SceneFile> Open(const std::string& path);
+
+		/**
+		 * Append the file's objects to a scene.
+		 * Objects whose mesh name cannot be resolved are skipped (logged once per name).
+		 * @return Number of objects added
+		 */
+		size_t Instantiate(Scene& scene, const SceneAssetTable& assets) const;
+
+		/**
+		 * Copy out the lights and environment settings.
+		 */
+		SceneEnvironment ReadEnvironment() const;
+
+		// =====================================================================
+		// Raw access (views into the mapping, valid while this object lives)
+		// =====================================================================
+
+		std::span<const SceneFileFormat::ObjectRecord> GetObjects() const { return m_Objects; }
+		std::span<const SceneFileFormat::PointLightRecord> GetPointLights() const { return m_PointLights; }
+		std::span<const uint32_t> GetMeshNames() const { return m_MeshNames; }
+		std::span<const uint32_t> GetTextureNames() const { return m_TextureNames; }
+		std::span<const uint32_t> GetMaterialNames() const { return m_MaterialNames; }
+
+		/** @return String at a byte offset, or "" if out of range */
+		const char* GetString(uint32_t offset) const;
+
+	private:
+		SceneFile() = default;
+
+		MappedFile m_File;
+		std::span<const char> m_Strings;
+		std::span<const uint32_t> m_MeshNames;
+		std::span<const uint32_t> m_TextureNames;
+		std::span<const uint32_t> m_MaterialNames;
+		std::span<const SceneFileFormat::ObjectRecord> m_Objects;
+		std::span<const SceneFileFormat::PointLightRecord> m_PointLights;
+		const SceneFileFormat::EnvironmentRecord* m_Environment = nullptr;
+	};
+}
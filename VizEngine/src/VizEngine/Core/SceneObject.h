@@ -3,6 +3,7 @@
 #include "VizEngine/Core.h"
 #include "VizEngine/Core/Transform.h"
 #include "VizEngine/Core/Mesh.h"
+#include "VizEngine/Core/Handle.h"
 #include "VizEngine/OpenGL/Texture.h"
 #include "glm.hpp"
 #include <memory>
@@ -38,11 +39,22 @@ namespace VizEngine
 		float Roughness = 0.5f;                      // 0 = smooth, 1 = rough
 		float Metallic = 0.0f;                       // 0 = dielectric, 1 = metal
 		std::shared_ptr<Texture> TexturePtr;        // Optional albedo texture
+		bool LowResolution = false;                  // Transparent: draw in the reduced-resolution pass
 
 		// Material (Option 2: Material reference - production approach)
 		// When set, this takes precedence over direct properties above
 		std::shared_ptr<RenderMaterial> MaterialRef;
 
+		// Resource handles (Scene::SyncHandles keeps these matching the pointers above)
+		// The render path resolves them to raw pointers instead of copying shared_ptrs.
+		MeshHandle MeshId;
+		TextureHandle TextureId;
+		MaterialHandle MaterialId;
+
+		// Prefab instance this object belongs to (Scene::Instantiate)
+		uint32_t PrefabInstanceID = 0;               // 0 = not part of an instance
+		uint32_t PrefabPart = 0;                     // Part index within the instance's prefab
+
 		// State
 		bool Active = true;                          // Enable/disable rendering
 		std::string Name = "Object";                 // Display name for UI
@@ -4,6 +4,7 @@
 #include "glm.hpp"
 #include "gtc/matrix_transform.hpp"
 #include "gtc/quaternion.hpp"
+#include <cmath>
 
 namespace VizEngine
 {
@@ -38,6 +39,37 @@ namespace VizEngine
 			return model;
 		}
 
+		/**
+		 * Inverse of GetModelMatrix() for matrices built from translation,
+		 * rotation and per-axis scale (shear is dropped). A mirrored matrix
+		 * gets a negative Scale.x.
+		 */
+		static Transform FromMatrix(const glm::mat4& matrix)
+		{
+			Transform result;
+			result.Position = glm::vec3(matrix[3]);
+
+			glm::vec3 axes[3] = { glm::vec3(matrix[0]), glm::vec3(matrix[1]), glm::vec3(matrix[2]) };
+			result.Scale = glm::vec3(glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]));
+			if (glm::dot(glm::cross(axes[0], axes[1]), axes[2]) < 0.0f)
+			{
+				result.Scale.x = -result.Scale.x;
+			}
+			for (int i = 0; i < 3; i++)
+			{
+				if (result.Scale[i] != 0.0f) axes[i] /= result.Scale[i];
+			}
+
+			// Rotation = Rx * Ry * Rz; axes[column][row]. z is solved after
+			// removing x, which stays accurate near gimbal lock.
+			float x = std::atan2(-axes[2][1], axes[2][2]);
+			float cosX = std::cos(x), sinX = std::sin(x);
+			result.Rotation.x = x;
+			result.Rotation.y = std::atan2(axes[2][0], std::sqrt(axes[0][0] * axes[0][0] + axes[1][0] * axes[1][0]));
+			result.Rotation.z = std::atan2(cosX * axes[0][1] + sinX * axes[0][2], cosX * axes[1][1] + sinX * axes[1][2]);
+			return result;
+		}
+
 		// Convenience methods for rotation in degrees
 		void SetRotationDegrees(const glm::vec3& degrees)
 		{
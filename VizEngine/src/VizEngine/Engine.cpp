@@ -6,8 +6,13 @@
 #include "OpenGL/GLFWManager.h"
 #include "OpenGL/Renderer.h"
 #include "OpenGL/ErrorHandling.h"
+#include "OpenGL/DeletionQueue.h"
+#include "OpenGL/GLCapture.h"
 #include "GUI/UIManager.h"
 #include "Core/Input.h"
+#include "Core/ResourceManager.h"
+#include "Core/Profiler.h"
+#include "Core/MetricsExporter.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -33,6 +38,7 @@ namespace VizEngine
 		if (!Init(config))
 		{
 			VP_CORE_ERROR("Engine initialization failed!");
+			m_ExitCode = 1;
 			return;
 		}
 
@@ -55,6 +61,10 @@ namespace VizEngine
 				m_DeltaTime = static_cast<float>(currentTime - prevTime);
 				prevTime = currentTime;
 
+				// Per-frame renderer counters start from zero
+				m_Renderer->ResetStats();
+				Profiler::BeginFrame();
+
 				// Poll events first to get fresh input data
 				m_Window->PollEvents();
 
@@ -70,7 +80,12 @@ namespace VizEngine
 				// Present phase
 				m_UIManager->Render();
 				m_Window->SwapBuffers();
+				DeletionQueue::EndFrame();  // Fence this frame's releases, free retired ones
 				Input::EndFrame();  // Reset scroll delta for next frame
+				Profiler::SetFrameStats(m_Renderer->GetStats());
+				Profiler::EndFrame();
+				m_Metrics->OnFrame(m_DeltaTime, Profiler::GetLastFrame(), m_Renderer->GetStats(), m_Resources.get());
+				GLCapture::EndFrame();  // After every GL call of the frame
 			}
 
 			// Application cleanup (normal exit)
@@ -79,6 +94,7 @@ namespace VizEngine
 		catch (const std::exception& e)
 		{
 			VP_CORE_ERROR("Exception in engine loop: {}", e.what());
+			m_ExitCode = 1;
 			if (appCreated)
 			{
 				app->OnDestroy();
@@ -87,6 +103,7 @@ namespace VizEngine
 		catch (...)
 		{
 			VP_CORE_ERROR("Unknown exception in engine loop");
+			m_ExitCode = 1;
 			if (appCreated)
 			{
 				app->OnDestroy();
@@ -119,6 +136,18 @@ namespace VizEngine
 		return *m_UIManager;
 	}
 
+	ResourceManager& Engine::GetResources()
+	{
+		VP_CORE_ASSERT(m_Resources, "Engine not initialized or already shut down!");
+		return *m_Resources;
+	}
+
+	MetricsExporter& Engine::GetMetrics()
+	{
+		VP_CORE_ASSERT(m_Metrics, "Engine not initialized or already shut down!");
+		return *m_Metrics;
+	}
+
 	bool Engine::Init(const EngineConfig& config)
 	{
 		// Guard against double initialization
@@ -136,7 +165,8 @@ namespace VizEngine
 			m_Window = std::make_unique<GLFWManager>(
 				config.Width,
 				config.Height,
-				config.Title.c_str()
+				config.Title.c_str(),
+				!config.Headless
 			);
 		}
 		catch (const std::exception& e)
@@ -158,6 +188,14 @@ namespace VizEngine
 			return false;
 		}
 
+		// Trace from the first GL call so replays can recreate every object
+		if (config.GLCapture.IsEnabled())
+		{
+			GLCapture::Begin(config.GLCapture);
+		}
+
+		glfwSwapInterval(config.VSync ? 1 : 0);
+
 		// OpenGL state setup
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -171,10 +209,24 @@ namespace VizEngine
 		// Create subsystems
 		m_UIManager = std::make_unique<UIManager>(m_Window->GetWindow());
 		m_Renderer = std::make_unique<Renderer>();
+		m_Resources = std::make_unique<ResourceManager>();
 
 		// Enable OpenGL debug output
 		ErrorHandling::HandleErrors();
 
+		// Defer GL object deletion until the GPU is done with them
+		DeletionQueue::Init();
+
+		// Per-pass CPU/GPU timings
+		Profiler::Init();
+
+		// Idle unless an output is configured; SetGauge() is then a no-op
+		m_Metrics = std::make_unique<MetricsExporter>();
+		if (config.Metrics.IsEnabled())
+		{
+			m_Metrics->Start(config.Metrics);
+		}
+
 		VP_CORE_INFO("Engine initialized successfully");
 		return true;
 	}
@@ -195,6 +247,19 @@ namespace VizEngine
 	{
 		VP_CORE_INFO("Shutting down Engine...");
 
+		// Keep a partial trace if the run ends before the last captured frame
+		GLCapture::End();
+
+		// Stop serving before the subsystems it samples go away
+		m_Metrics.reset();
+
+		// Drop registered resources first so their GL objects join the queue
+		m_Resources.reset();
+
+		// Release queued GL objects while the context is still current
+		DeletionQueue::Shutdown();
+		Profiler::Shutdown();
+
 		// Reset subsystems in reverse order of creation
 		m_Renderer.reset();
 		m_UIManager.reset();
@@ -2,8 +2,11 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include "Core.h"
+#include "Core/MetricsExporter.h"
+#include "OpenGL/GLCapture.h"
 
 namespace VizEngine
 {
@@ -12,6 +15,7 @@ namespace VizEngine
 	class GLFWManager;
 	class Renderer;
 	class UIManager;
+	class ResourceManager;
 	class Event;
 
 	/**
@@ -24,6 +28,10 @@ namespace VizEngine
 		uint32_t Width = 800;
 		uint32_t Height = 800;
 		bool VSync = true;
+		bool Headless = false;           // Hidden window (offscreen/regression runs)
+		std::vector<std::string> Args;   // Command-line arguments after the program name
+		MetricsConfig Metrics;           // Prometheus export (off unless an output is set)
+		GLCaptureConfig GLCapture;       // GL command trace for GLReplay (off unless a path is set)
 	};
 
 	/**
@@ -55,10 +63,18 @@ namespace VizEngine
 		 */
 		void Quit();
 
+		/**
+		 * Set the process exit code returned from main().
+		 */
+		void SetExitCode(int code) { m_ExitCode = code; }
+		int GetExitCode() const { return m_ExitCode; }
+
 		// Subsystem accessors
 		GLFWManager& GetWindow();
 		Renderer& GetRenderer();
 		UIManager& GetUIManager();
+		ResourceManager& GetResources();
+		MetricsExporter& GetMetrics();
 
 		/**
 		 * Get the delta time (seconds) since the last frame.
@@ -90,9 +106,12 @@ namespace VizEngine
 		std::unique_ptr<GLFWManager> m_Window;
 		std::unique_ptr<Renderer> m_Renderer;
 		std::unique_ptr<UIManager> m_UIManager;
+		std::unique_ptr<ResourceManager> m_Resources;
+		std::unique_ptr<MetricsExporter> m_Metrics;
 
 		Application* m_App = nullptr;  // Stored for event routing
 		float m_DeltaTime = 0.0f;
 		bool m_Running = false;
+		int m_ExitCode = 0;
 	};
 }
@@ -1,19 +1,24 @@
 #pragma once
 
-#ifdef VP_PLATFORM_WINDOWS
+#if defined(VP_PLATFORM_WINDOWS) || defined(__linux__)
 
 #include "Engine.h"
 #include "Application.h"  // For CreateApplication declaration
 
-int main()
+int main(int argc, char** argv)
 {
 	VizEngine::Log::Init();
 
 	VizEngine::EngineConfig config;
+	for (int i = 1; i < argc; i++)
+	{
+		config.Args.emplace_back(argv[i]);
+	}
+
 	auto app = VizEngine::CreateApplication(config);
 	VizEngine::Engine::Get().Run(std::move(app), config);
 
-	return 0;
+	return VizEngine::Engine::Get().GetExitCode();
 }
 
 #endif
@@ -30,10 +30,12 @@ namespace VizEngine
 		constexpr int BloomTexture = 10;
 		constexpr int ColorGradingLUT = 11;
 
-		// User/custom (12-15)
+		// User/custom (12-14)
 		constexpr int Custom0 = 12;
 		constexpr int Custom1 = 13;
 		constexpr int Custom2 = 14;
-		constexpr int Custom3 = 15;
+
+		// Shadow map again, bound with a depth-comparison sampler (15)
+		constexpr int ShadowMapCompare = 15;
 	}
 }
\ No newline at end of file
@@ -6,12 +6,17 @@
 #include "Framebuffer.h"
 #include "VertexArray.h"
 #include "VertexBuffer.h"
+#include "DeletionQueue.h"
+#include "HDRTextureCodec.h"
 #include "VizEngine/Log.h"
 
 #include <glad/glad.h>
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <vector>
 
 namespace
 {
@@ -65,6 +70,181 @@ namespace
 
 namespace VizEngine
 {
+	namespace
+	{
+		// Radiance below which relative errors are measured against this instead
+		constexpr double RelativeErrorFloor = 1e-4;
+
+		int LevelSize(int resolution, int level)
+		{
+			return std::max(1, resolution >> level);
+		}
+
+		/** Levels allocated on a cubemap (glGenerateMipmap allocates full chains). */
+		int CountCubemapLevels(const Texture& cubemap)
+		{
+			const int maxLevels = Texture::CalculateMipLevels(cubemap.GetWidth(), cubemap.GetHeight());
+			int levels = 0;
+			glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.GetID());
+			for (; levels < maxLevels; levels++)
+			{
+				GLint width = 0;
+				glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, levels, GL_TEXTURE_WIDTH, &width);
+				if (width == 0) break;
+			}
+			glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+			return levels;
+		}
+
+		/** All six faces of one level as RGB floats, +X -X +Y -Y +Z -Z. */
+		void ReadCubemapLevel(const Texture& cubemap, int level, std::vector<float>& texels)
+		{
+			const int size = LevelSize(cubemap.GetWidth(), level);
+			texels.resize(static_cast<size_t>(size) * size * 3 * 6);
+			glGetTextureImage(cubemap.GetID(), level, GL_RGB, GL_FLOAT,
+				static_cast<GLsizei>(texels.size() * sizeof(float)), texels.data());
+		}
+
+		size_t StorageBytes(CubemapStorage storage, int resolution, int levels)
+		{
+			size_t bytes = 0;
+			for (int level = 0; level < levels; level++)
+			{
+				const int size = LevelSize(resolution, level);
+				const size_t texels = static_cast<size_t>(size) * size;
+				switch (storage)
+				{
+				case CubemapStorage::RGB16F: bytes += texels * 8; break;
+				case CubemapStorage::BC6H:   bytes += HDRTextureCodec::GetBC6HSize(size, size); break;
+				default:                     bytes += texels * 4; break;
+				}
+			}
+			return bytes * 6;
+		}
+
+		/** Float-to-float blit of every face and level; the GPU does the conversion. */
+		std::shared_ptr<Texture> BlitCubemap(const Texture& source, int levels, GLenum internalFormat)
+		{
+			auto converted = std::make_shared<Texture>(source.GetWidth(), internalFormat, levels);
+			if (converted->GetID() == 0) return nullptr;
+
+			GLint prevRead = 0, prevDraw = 0;
+			glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevRead);
+			glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDraw);
+			const GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+			glDisable(GL_SCISSOR_TEST);
+
+			unsigned int framebuffers[2];
+			glGenFramebuffers(2, framebuffers);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+
+			bool complete = true;
+			for (int level = 0; level < levels && complete; level++)
+			{
+				const int size = LevelSize(source.GetWidth(), level);
+				for (unsigned int face = 0; face < 6; face++)
+				{
+					glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+						GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, source.GetID(), level);
+					glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+						GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, converted->GetID(), level);
+					if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE ||
+						glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+					{
+						VP_CORE_ERROR("ConvertStorage: Blit framebuffer incomplete (level {}, face {})", level, face);
+						complete = false;
+						break;
+					}
+					glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+				}
+			}
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevRead));
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(prevDraw));
+			if (scissor) glEnable(GL_SCISSOR_TEST);
+			DeletionQueue::Enqueue(GLResourceType::Framebuffer, framebuffers[0]);
+			DeletionQueue::Enqueue(GLResourceType::Framebuffer, framebuffers[1]);
+
+			return complete ? converted : nullptr;
+		}
+
+		/** Read back every level and encode it on the CPU (RGB9E5 or BC6H). */
+		std::shared_ptr<Texture> EncodeCubemap(const Texture& source, int levels, CubemapStorage storage)
+		{
+			const bool bc6h = storage == CubemapStorage::BC6H;
+			const GLenum internalFormat = bc6h ? GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT : GL_RGB9_E5;
+			auto converted = std::make_shared<Texture>(source.GetWidth(), internalFormat, levels);
+			if (converted->GetID() == 0) return nullptr;
+
+			std::vector<float> texels;
+			std::vector<uint32_t> packed;
+			std::vector<uint8_t> blocks, faceBlocks;
+			for (int level = 0; level < levels; level++)
+			{
+				const int size = LevelSize(source.GetWidth(), level);
+				const size_t faceTexels = static_cast<size_t>(size) * size;
+				ReadCubemapLevel(source, level, texels);
+
+				// The DSA 3D uploads address cubemap faces as layers 0-5
+				if (bc6h)
+				{
+					blocks.clear();
+					for (size_t face = 0; face < 6; face++)
+					{
+						HDRTextureCodec::EncodeBC6H(texels.data() + face * faceTexels * 3, size, size, faceBlocks);
+						blocks.insert(blocks.end(), faceBlocks.begin(), faceBlocks.end());
+					}
+					glCompressedTextureSubImage3D(converted->GetID(), level, 0, 0, 0, size, size, 6,
+						internalFormat, static_cast<GLsizei>(blocks.size()), blocks.data());
+				}
+				else
+				{
+					packed.resize(faceTexels * 6);
+					HDRTextureCodec::PackRGB9E5(texels.data(), packed.size(), packed.data());
+					glTextureSubImage3D(converted->GetID(), level, 0, 0, 0, size, size, 6,
+						GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, packed.data());
+				}
+			}
+			return converted;
+		}
+
+		void MeasureStorageError(const Texture& source, const Texture& converted, int levels,
+			CubemapStorageReport& report)
+		{
+			std::vector<float> expected, actual;
+			double relativeSum = 0.0, squaredSum = 0.0;
+			size_t texelCount = 0;
+			for (int level = 0; level < levels; level++)
+			{
+				ReadCubemapLevel(source, level, expected);
+				ReadCubemapLevel(converted, level, actual);
+				for (size_t i = 0; i < expected.size(); i += 3)
+				{
+					double length = 0.0, error = 0.0;
+					for (size_t c = 0; c < 3; c++)
+					{
+						double e = expected[i + c];
+						double d = static_cast<double>(actual[i + c]) - e;
+						length += e * e;
+						error += d * d;
+					}
+					double relative = std::sqrt(error) / std::max(std::sqrt(length), RelativeErrorFloor);
+					relativeSum += relative;
+					squaredSum += error;
+					report.MaxRelativeError = std::max(report.MaxRelativeError, relative);
+				}
+				texelCount += expected.size() / 3;
+			}
+
+			if (texelCount > 0)
+			{
+				report.MeanRelativeError = relativeSum / static_cast<double>(texelCount);
+				report.RMSError = std::sqrt(squaredSum / static_cast<double>(texelCount * 3));
+			}
+		}
+	}
+
 	std::shared_ptr<Texture> CubemapUtils::EquirectangularToCubemap(
 		std::shared_ptr<Texture> equirectangularMap,
 		int resolution)
@@ -122,7 +302,7 @@ namespace VizEngine
 		if (!framebuffer->IsComplete())
 		{
 			VP_CORE_ERROR("Cubemap conversion: Framebuffer incomplete after depth attachment");
-			glDeleteRenderbuffers(1, &rbo);
+			DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 			return nullptr;
 		}
 
@@ -131,7 +311,7 @@ namespace VizEngine
 		if (!shader->IsValid())
 		{
 			VP_CORE_ERROR("Cubemap conversion: Failed to load shader 'resources/shaders/equirect_to_cube.shader'");
-			glDeleteRenderbuffers(1, &rbo);
+			DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 			return nullptr;
 		}
 
@@ -190,7 +370,7 @@ namespace VizEngine
 			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 			{
 				VP_CORE_ERROR("Cubemap conversion: FBO incomplete for face {}", i);
-				glDeleteRenderbuffers(1, &rbo);
+				DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 				glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
 				return nullptr;
 			}
@@ -214,7 +394,7 @@ namespace VizEngine
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
 		// Cleanup
-		glDeleteRenderbuffers(1, &rbo);
+		DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 
 		VP_CORE_INFO("Cubemap conversion complete (with mipmaps)!");
 
@@ -223,7 +403,8 @@ namespace VizEngine
 
 	std::shared_ptr<Texture> CubemapUtils::GenerateIrradianceMap(
 		std::shared_ptr<Texture> environmentMap,
-		int resolution)
+		int resolution,
+		float sampleDelta)
 	{
 		if (!environmentMap || !environmentMap->IsCubemap())
 		{
@@ -250,7 +431,7 @@ namespace VizEngine
 		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		{
 			VP_CORE_ERROR("GenerateIrradianceMap: Framebuffer incomplete after depth attachment");
-			glDeleteRenderbuffers(1, &rbo);
+			DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 			framebuffer->Unbind();
 			return nullptr;
 		}
@@ -260,7 +441,7 @@ namespace VizEngine
 		if (!shader->IsValid())
 		{
 			VP_CORE_ERROR("Failed to load irradiance_convolution.shader");
-			glDeleteRenderbuffers(1, &rbo);
+			DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 			framebuffer->Unbind();
 			return nullptr;
 		}
@@ -290,6 +471,7 @@ namespace VizEngine
 		shader->SetMatrix4fv("u_Projection", captureProjection);
 		environmentMap->Bind(0);
 		shader->SetInt("u_EnvironmentMap", 0);
+		shader->SetFloat("u_SampleDelta", sampleDelta);
 
 		GLint prevViewport[4];
 		glGetIntegerv(GL_VIEWPORT, prevViewport);
@@ -308,7 +490,7 @@ namespace VizEngine
 
 		framebuffer->Unbind();
 		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-		glDeleteRenderbuffers(1, &rbo);
+		DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 
 		VP_CORE_INFO("Irradiance map complete!");
 		return irradianceMap;
@@ -316,7 +498,8 @@ namespace VizEngine
 
 	std::shared_ptr<Texture> CubemapUtils::GeneratePrefilteredMap(
 		std::shared_ptr<Texture> environmentMap,
-		int resolution)
+		int resolution,
+		int sampleCount)
 	{
 		if (!environmentMap || !environmentMap->IsCubemap())
 		{
@@ -368,6 +551,7 @@ namespace VizEngine
 		shader->SetMatrix4fv("u_Projection", captureProjection);
 		environmentMap->Bind(0);
 		shader->SetInt("u_EnvironmentMap", 0);
+		shader->SetInt("u_SampleCount", sampleCount);
 
 		// Create framebuffer
 		auto framebuffer = std::make_shared<Framebuffer>(resolution, resolution);
@@ -388,7 +572,7 @@ namespace VizEngine
 		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		{
 			VP_CORE_ERROR("GeneratePrefilteredMap: Framebuffer not usable");
-			glDeleteRenderbuffers(1, &rbo);
+			DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 			framebuffer->Unbind();
 			return nullptr;
 		}
@@ -423,7 +607,7 @@ namespace VizEngine
 			}
 		}
 
-		glDeleteRenderbuffers(1, &rbo);
+		DeletionQueue::Enqueue(GLResourceType::Renderbuffer, rbo);
 
 		framebuffer->Unbind();
 		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
@@ -494,5 +678,73 @@ namespace VizEngine
 		VP_CORE_INFO("BRDF LUT complete!");
 		return brdfLUT;
 	}
+
+	std::shared_ptr<Texture> CubemapUtils::ConvertStorage(
+		std::shared_ptr<Texture> cubemap,
+		CubemapStorage storage,
+		CubemapStorageReport* report)
+	{
+		if (!cubemap || !cubemap->IsCubemap())
+		{
+			VP_CORE_ERROR("ConvertStorage: Input must be a cubemap!");
+			return nullptr;
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		const int levels = CountCubemapLevels(*cubemap);
+
+		std::shared_ptr<Texture> converted;
+		switch (storage)
+		{
+		case CubemapStorage::RGB16F:     converted = cubemap; break;
+		case CubemapStorage::R11G11B10F: converted = BlitCubemap(*cubemap, levels, GL_R11F_G11F_B10F); break;
+		case CubemapStorage::RGB9E5:
+		case CubemapStorage::BC6H:       converted = EncodeCubemap(*cubemap, levels, storage); break;
+		default:
+			VP_CORE_ERROR("ConvertStorage: Unknown storage format {}", static_cast<int>(storage));
+			return nullptr;
+		}
+		if (!converted)
+		{
+			VP_CORE_ERROR("ConvertStorage: Failed to convert cubemap to {}", GetStorageName(storage));
+			return nullptr;
+		}
+
+		const size_t baselineBytes = StorageBytes(CubemapStorage::RGB16F, cubemap->GetWidth(), levels);
+		const size_t bytes = StorageBytes(storage, cubemap->GetWidth(), levels);
+		if (report)
+		{
+			// Include the GPU work of the blit path in the timing
+			glFinish();
+			*report = CubemapStorageReport();
+			report->Storage = storage;
+			report->MipLevels = levels;
+			report->BaselineBytes = baselineBytes;
+			report->Bytes = bytes;
+			report->ConvertMs = std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - start).count();
+			if (converted != cubemap)
+			{
+				MeasureStorageError(*cubemap, *converted, levels, *report);
+			}
+		}
+
+		VP_CORE_INFO("Cubemap stored as {} ({}x{}, {} levels): {:.2f} MB -> {:.2f} MB",
+			GetStorageName(storage), cubemap->GetWidth(), cubemap->GetWidth(), levels,
+			baselineBytes / (1024.0 * 1024.0), bytes / (1024.0 * 1024.0));
+		return converted;
+	}
+
+	const char* CubemapUtils::GetStorageName(CubemapStorage storage)
+	{
+		switch (storage)
+		{
+		case CubemapStorage::RGB16F:     return "RGB16F";
+		case CubemapStorage::RGB9E5:     return "RGB9_E5";
+		case CubemapStorage::R11G11B10F: return "R11F_G11F_B10F";
+		case CubemapStorage::BC6H:       return "BC6H";
+		default:                         return "Unknown";
+		}
+	}
 }
 
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "VizEngine/Core.h"
 
@@ -9,6 +11,34 @@ namespace VizEngine
 {
 	class Texture;
 
+	/**
+	 * Storage formats for HDR cubemaps (environment, irradiance, prefiltered).
+	 */
+	enum class CubemapStorage : uint8_t
+	{
+		RGB16F = 0,     // 6 bytes/texel (drivers typically pad to 8), the generated baseline
+		RGB9E5,         // 4 bytes, 9-bit mantissas with a shared exponent (CPU packed)
+		R11G11B10F,     // 4 bytes, 6/6/5-bit mantissas, no sign (GPU blit)
+		BC6H,           // 1 byte, block compressed (CPU encoder, slowest to convert)
+		Count
+	};
+
+	/**
+	 * Cost and error of a converted cubemap, measured against its source
+	 * over every face of every mip level.
+	 */
+	struct VizEngine_API CubemapStorageReport
+	{
+		CubemapStorage Storage = CubemapStorage::RGB16F;
+		int MipLevels = 0;
+		size_t BaselineBytes = 0;          // Source as RGB16F padded to 8 bytes/texel
+		size_t Bytes = 0;
+		double MeanRelativeError = 0.0;    // Per texel: |converted - source| / |source| (RGB vectors)
+		double MaxRelativeError = 0.0;
+		double RMSError = 0.0;             // Per channel, absolute (linear radiance)
+		double ConvertMs = 0.0;
+	};
+
 	/**
 	 * Utilities for cubemap texture operations.
 	 */
@@ -33,11 +63,13 @@ namespace VizEngine
 		 * Convolves environment over hemisphere for each direction.
 		 * @param environmentMap Source HDR cubemap
 		 * @param resolution Resolution per face (32 typical)
+		 * @param sampleDelta Angular step of the hemisphere walk in radians (smaller = more samples)
 		 * @return Irradiance cubemap for diffuse IBL
 		 */
 		static std::shared_ptr<Texture> GenerateIrradianceMap(
 			std::shared_ptr<Texture> environmentMap,
-			int resolution = 32
+			int resolution = 32,
+			float sampleDelta = 0.025f
 		);
 
 		/**
@@ -45,11 +77,13 @@ namespace VizEngine
 		 * Each mip level stores environment convolved for that roughness.
 		 * @param environmentMap Source HDR cubemap
 		 * @param resolution Base resolution (512 typical)
+		 * @param sampleCount GGX importance samples per texel (1024 typical)
 		 * @return Pre-filtered cubemap with roughness in mip chain
 		 */
 		static std::shared_ptr<Texture> GeneratePrefilteredMap(
 			std::shared_ptr<Texture> environmentMap,
-			int resolution = 512
+			int resolution = 512,
+			int sampleCount = 1024
 		);
 
 		/**
@@ -60,5 +94,24 @@ namespace VizEngine
 		 * @return 2D RG texture for BRDF lookup
 		 */
 		static std::shared_ptr<Texture> GenerateBRDFLUT(int resolution = 512);
+
+		/**
+		 * Copy an HDR cubemap, all allocated mip levels, into a more compact
+		 * storage format. R11G11B10F is blitted on the GPU; RGB9E5 and BC6H
+		 * read the levels back and encode on the CPU (BC6H takes seconds for
+		 * a 1024 chain). The source is left untouched.
+		 * @param cubemap Source cubemap, normally RGB16F from the Generate* functions
+		 * @param storage Target format
+		 * @param report Optional cost/error report; reads both cubemaps back (GPU sync)
+		 * @return New cubemap, the source itself for RGB16F, nullptr on failure
+		 */
+		static std::shared_ptr<Texture> ConvertStorage(
+			std::shared_ptr<Texture> cubemap,
+			CubemapStorage storage,
+			CubemapStorageReport* report = nullptr
+		);
+
+		/** @return Display name of a storage format */
+		static const char* GetStorageName(CubemapStorage storage);
 	};
 }
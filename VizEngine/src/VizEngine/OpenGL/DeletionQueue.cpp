@@ -0,0 +1,214 @@
+// VizEngine/src/VizEngine/OpenGL/DeletionQueue.cpp
+
+#include "DeletionQueue.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr size_t kTypeCount = static_cast<size_t>(GLResourceType::Count);
+
+		struct DeletionBatch
+		{
+			GLsync Fence = nullptr;
+			std::array<std::vector<GLuint>, kTypeCount> Names;
+
+			bool Empty() const
+			{
+				for (const auto& names : Names)
+				{
+					if (!names.empty()) return false;
+				}
+				return true;
+			}
+		};
+
+		struct QueueState
+		{
+			std::mutex Mutex;
+			bool Active = false;
+			DeletionBatch Current;
+			std::deque<DeletionBatch> InFlight;
+			std::vector<DeletionBatch> FreeBatches;  // Recycled to keep vector capacity
+			size_t PendingCount = 0;
+		};
+
+		QueueState& State()
+		{
+			static QueueState state;
+			return state;
+		}
+
+		void DeleteNames(GLResourceType type, GLsizei count, const GLuint* names)
+		{
+			if (count <= 0) return;
+
+			switch (type)
+			{
+			case GLResourceType::Texture:      glDeleteTextures(count, names); break;
+			case GLResourceType::Buffer:       glDeleteBuffers(count, names); break;
+			case GLResourceType::Framebuffer:  glDeleteFramebuffers(count, names); break;
+			case GLResourceType::Renderbuffer: glDeleteRenderbuffers(count, names); break;
+			case GLResourceType::VertexArray:  glDeleteVertexArrays(count, names); break;
+			case GLResourceType::Sampler:      glDeleteSamplers(count, names); break;
+			case GLResourceType::Program:
+				// No batched entry point for programs
+				for (GLsizei i = 0; i < count; ++i)
+				{
+					glDeleteProgram(names[i]);
+				}
+				break;
+			case GLResourceType::Count:
+				break;
+			}
+		}
+
+		// Caller holds the mutex
+		void ReleaseBatch(QueueState& state, DeletionBatch& batch)
+		{
+			for (size_t t = 0; t < kTypeCount; ++t)
+			{
+				auto& names = batch.Names[t];
+				DeleteNames(static_cast<GLResourceType>(t), static_cast<GLsizei>(names.size()), names.data());
+				state.PendingCount -= names.size();
+				names.clear();
+			}
+
+			if (batch.Fence)
+			{
+				glDeleteSync(batch.Fence);
+				batch.Fence = nullptr;
+			}
+		}
+	}
+
+	void DeletionQueue::Init()
+	{
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		state.Active = true;
+		VP_CORE_INFO("DeletionQueue initialized (max {} frames in flight)", MaxFramesInFlight);
+	}
+
+	void DeletionQueue::Enqueue(GLResourceType type, unsigned int id)
+	{
+		if (id == 0 || type == GLResourceType::Count) return;
+
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+
+		if (!state.Active)
+		{
+			GLuint name = id;
+			DeleteNames(type, 1, &name);
+			return;
+		}
+
+		state.Current.Names[static_cast<size_t>(type)].push_back(id);
+		state.PendingCount++;
+	}
+
+	void DeletionQueue::EndFrame()
+	{
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		if (!state.Active) return;
+
+		// Seal this frame's batch behind a fence covering every command issued so far
+		if (!state.Current.Empty())
+		{
+			state.Current.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			state.InFlight.push_back(std::move(state.Current));
+
+			if (!state.FreeBatches.empty())
+			{
+				state.Current = std::move(state.FreeBatches.back());
+				state.FreeBatches.pop_back();
+			}
+			else
+			{
+				state.Current = DeletionBatch{};
+			}
+		}
+
+		// Release retired batches in submission order
+		while (!state.InFlight.empty())
+		{
+			DeletionBatch& oldest = state.InFlight.front();
+
+			// Poll without waiting, unless too many frames are backed up
+			bool mustWait = state.InFlight.size() > static_cast<size_t>(MaxFramesInFlight);
+			GLuint64 timeout = mustWait ? 1000000000ull : 0;  // 1 second
+			GLenum result = glClientWaitSync(oldest.Fence, mustWait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+
+			if (result == GL_TIMEOUT_EXPIRED)
+			{
+				if (mustWait)
+				{
+					VP_CORE_WARN("DeletionQueue: GPU fence timed out with {} frames in flight", state.InFlight.size());
+				}
+				break;
+			}
+
+			if (result == GL_WAIT_FAILED)
+			{
+				// Fence is unusable; fall back to a full sync before deleting
+				VP_CORE_ERROR("DeletionQueue: glClientWaitSync failed, forcing glFinish");
+				glFinish();
+			}
+
+			ReleaseBatch(state, oldest);
+			state.FreeBatches.push_back(std::move(oldest));
+			state.InFlight.pop_front();
+		}
+	}
+
+	void DeletionQueue::Flush()
+	{
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		if (!state.Active) return;
+
+		glFinish();
+
+		for (auto& batch : state.InFlight)
+		{
+			ReleaseBatch(state, batch);
+		}
+		state.InFlight.clear();
+		ReleaseBatch(state, state.Current);
+	}
+
+	void DeletionQueue::Shutdown()
+	{
+		Flush();
+
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		state.Active = false;
+		state.FreeBatches.clear();
+		VP_CORE_INFO("DeletionQueue shut down");
+	}
+
+	bool DeletionQueue::IsActive()
+	{
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		return state.Active;
+	}
+
+	size_t DeletionQueue::GetPendingCount()
+	{
+		auto& state = State();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		return state.PendingCount;
+	}
+}
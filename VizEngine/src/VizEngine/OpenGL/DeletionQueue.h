@@ -0,0 +1,84 @@
+// VizEngine/src/VizEngine/OpenGL/DeletionQueue.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace VizEngine
+{
+	/**
+	 * Kinds of GL object names the deletion queue knows how to release.
+	 * Each kind is released with one batched glDelete* call per frame.
+	 */
+	enum class GLResourceType : uint8_t
+	{
+		Texture = 0,
+		Buffer,
+		Framebuffer,
+		Renderbuffer,
+		VertexArray,
+		Sampler,
+		Program,
+		Count
+	};
+
+	/**
+	 * Fence-guarded deferred deletion of GL objects.
+	 *
+	 * Deleting a texture or buffer while the GPU may still be reading it forces
+	 * the driver to either stall or keep a hidden copy alive. Instead, RAII
+	 * wrappers hand their names to this queue. Names released during a frame
+	 * are grouped into a batch; at the end of the frame a fence is inserted
+	 * behind that frame's commands, and the batch is only deleted once the
+	 * fence has signaled, i.e. once no in-flight frame can reference it.
+	 *
+	 * When the queue is not active (before Engine::Init, after shutdown, or in
+	 * tools that never start it) Enqueue() deletes immediately, matching the
+	 * previous destructor behavior.
+	 */
+	class VizEngine_API DeletionQueue
+	{
+	public:
+		/**
+		 * Start deferring deletions. Requires a current GL context.
+		 */
+		static void Init();
+
+		/**
+		 * Queue a GL name for deletion after the current frame retires.
+		 * A zero name is ignored.
+		 * @param type Kind of GL object
+		 * @param id GL object name
+		 */
+		static void Enqueue(GLResourceType type, unsigned int id);
+
+		/**
+		 * Close the current frame's batch behind a fence and release every
+		 * older batch whose fence has already signaled. Never blocks unless
+		 * more than MaxFramesInFlight batches are outstanding.
+		 * Call once per frame, after SwapBuffers.
+		 */
+		static void EndFrame();
+
+		/**
+		 * Wait for the GPU and release everything queued so far.
+		 */
+		static void Flush();
+
+		/**
+		 * Flush and stop deferring; later Enqueue() calls delete immediately.
+		 */
+		static void Shutdown();
+
+		/** @return true between Init() and Shutdown() */
+		static bool IsActive();
+
+		/** @return Number of GL names waiting to be released */
+		static size_t GetPendingCount();
+
+		/** Batches older than this are waited on rather than polled. */
+		static constexpr int MaxFramesInFlight = 3;
+	};
+}
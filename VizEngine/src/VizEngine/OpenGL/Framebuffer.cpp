@@ -2,6 +2,7 @@
 
 #include "Framebuffer.h"
 #include "Texture.h"
+#include "DeletionQueue.h"
 #include "VizEngine/Log.h"
 
 #include <glad/glad.h>
@@ -21,7 +22,7 @@ namespace VizEngine
 		if (m_fbo != 0)
 		{
 			VP_CORE_INFO("Framebuffer destroyed: ID={}", m_fbo);
-			glDeleteFramebuffers(1, &m_fbo);
+			DeletionQueue::Enqueue(GLResourceType::Framebuffer, m_fbo);
 			m_fbo = 0;
 		}
 	}
@@ -51,7 +52,7 @@ namespace VizEngine
 			// Delete current FBO
 			if (m_fbo != 0)
 			{
-				glDeleteFramebuffers(1, &m_fbo);
+				DeletionQueue::Enqueue(GLResourceType::Framebuffer, m_fbo);
 			}
 
 			// Move data
@@ -0,0 +1,570 @@
+// VizEngine/src/VizEngine/OpenGL/GLCapture.cpp
+
+#include "GLCapture.h"
+#include "GLTrace.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr size_t FlushBytes = 4 * 1024 * 1024;
+
+		/**
+		 * Buffered append-only trace file.
+		 */
+		class TraceWriter
+		{
+		public:
+			bool Open(const std::string& path)
+			{
+				m_File = std::fopen(path.c_str(), "wb");
+				m_Failed = m_File == nullptr;
+				m_Bytes = 0;
+				m_Buffer.clear();
+				m_Buffer.reserve(FlushBytes + 64 * 1024);
+				return m_File != nullptr;
+			}
+
+			void Command(GLTraceCommand command)
+			{
+				Value(static_cast<uint16_t>(command));
+			}
+
+			template<typename T>
+			void Value(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Append(&value, sizeof(T));
+			}
+
+			void Blob(const void* data, size_t size)
+			{
+				Value(static_cast<uint32_t>(data ? size : 0));
+				if (data) Append(data, size);
+			}
+
+			void Append(const void* data, size_t size)
+			{
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+				if (m_Buffer.size() >= FlushBytes) Flush();
+			}
+
+			void Flush()
+			{
+				if (m_File && !m_Buffer.empty())
+				{
+					if (std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File) != m_Buffer.size() && !m_Failed)
+					{
+						VP_CORE_ERROR("GLCapture: write failed, trace will be truncated");
+						m_Failed = true;
+					}
+					m_Bytes += m_Buffer.size();
+				}
+				m_Buffer.clear();
+			}
+
+			/** Flush, rewrite the header at the start of the file and close. */
+			bool Close(const GLTraceHeader& header)
+			{
+				if (!m_File) return false;
+				Flush();
+				std::fseek(m_File, 0, SEEK_SET);
+				std::fwrite(&header, sizeof(header), 1, m_File);
+				std::fclose(m_File);
+				m_File = nullptr;
+				return !m_Failed;
+			}
+
+			uint64_t GetBytesWritten() const { return m_Bytes + m_Buffer.size(); }
+
+		private:
+			FILE* m_File = nullptr;
+			std::vector<uint8_t> m_Buffer;
+			uint64_t m_Bytes = 0;
+			bool m_Failed = false;
+		};
+
+		struct CaptureState
+		{
+			GLCaptureConfig Config;
+			GLTraceHeader Header;
+			TraceWriter Writer;
+			uint32_t Frame = 0;
+			bool Active = false;
+			bool SetupWritten = false;
+			std::vector<void(*)()> Restores;   // Put the driver pointers back
+		};
+
+		CaptureState s_Capture;
+
+		// =====================================================================
+		// Hook plumbing
+		// =====================================================================
+
+		/**
+		 * Driver entry point saved when the glad pointer at Slot was hooked.
+		 */
+		template<auto* Slot>
+		struct Original
+		{
+			static inline std::remove_pointer_t<decltype(Slot)> Fn = nullptr;
+
+			static void Restore()
+			{
+				if (Fn) *Slot = Fn;
+				Fn = nullptr;
+			}
+		};
+
+		template<auto* Slot>
+		void Install(std::remove_pointer_t<decltype(Slot)> hook)
+		{
+			using Saved = Original<Slot>;
+			if (!*Slot || Saved::Fn) return;   // Not provided by the driver, or already hooked
+			Saved::Fn = *Slot;
+			*Slot = hook;
+			s_Capture.Restores.push_back(&Saved::Restore);
+		}
+
+		/** Driver function, whether or not it is currently hooked */
+		template<auto* Slot>
+		auto Driver()
+		{
+			return Original<Slot>::Fn ? Original<Slot>::Fn : *Slot;
+		}
+
+		template<typename T>
+		void WriteArgument(TraceWriter& writer, T value)
+		{
+			if constexpr (std::is_pointer_v<T>)
+			{
+				using Pointee = std::remove_pointer_t<T>;
+				if constexpr (std::is_same_v<Pointee, const void>)
+				{
+					// Offset into the bound buffer object
+					writer.Value(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+				}
+				else
+				{
+					// Output parameters are not recorded
+					static_assert(!std::is_const_v<Pointee>, "client-memory inputs need a custom hook");
+				}
+			}
+			else
+			{
+				writer.Value(value);
+			}
+		}
+
+		/**
+		 * Hook for entry points whose arguments are plain values.
+		 */
+		template<auto* Slot, GLTraceCommand Id, typename Fn = std::remove_pointer_t<decltype(Slot)>>
+		struct ValueHook;
+
+		template<auto* Slot, GLTraceCommand Id, typename R, typename... A>
+		struct ValueHook<Slot, Id, R (APIENTRYP)(A...)>
+		{
+			static R APIENTRY Call(A... args)
+			{
+				TraceWriter& writer = s_Capture.Writer;
+				writer.Command(Id);
+				(WriteArgument(writer, args), ...);
+				return Original<Slot>::Fn(args...);
+			}
+
+			static void Install() { VizEngine::Install<Slot>(&Call); }
+		};
+
+		template<auto* Slot, GLTraceCommand Id>
+		void APIENTRY HookGen(GLsizei n, GLuint* names)
+		{
+			Original<Slot>::Fn(n, names);
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(Id);
+			writer.Value(n);
+			writer.Append(names, sizeof(GLuint) * static_cast<size_t>(std::max(n, 0)));
+		}
+
+		template<auto* Slot, GLTraceCommand Id>
+		void APIENTRY HookDelete(GLsizei n, const GLuint* names)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(Id);
+			writer.Value(n);
+			writer.Append(names, sizeof(GLuint) * static_cast<size_t>(std::max(n, 0)));
+			Original<Slot>::Fn(n, names);
+		}
+
+		GLint Alignment(GLenum pname)
+		{
+			GLint alignment = 4;
+			Driver<&glad_glGetIntegerv>()(pname, &alignment);
+			return alignment;
+		}
+
+		// =====================================================================
+		// Hooks with client memory, names or handles
+		// =====================================================================
+
+		GLuint APIENTRY HookCreateProgram()
+		{
+			GLuint program = Original<&glad_glCreateProgram>::Fn();
+			s_Capture.Writer.Command(GLTraceCommand::CreateProgram);
+			s_Capture.Writer.Value(program);
+			return program;
+		}
+
+		GLuint APIENTRY HookCreateShader(GLenum type)
+		{
+			GLuint shader = Original<&glad_glCreateShader>::Fn(type);
+			s_Capture.Writer.Command(GLTraceCommand::CreateShader);
+			s_Capture.Writer.Value(type);
+			s_Capture.Writer.Value(shader);
+			return shader;
+		}
+
+		void APIENTRY HookUseProgram(GLuint program)
+		{
+			s_Capture.Writer.Command(GLTraceCommand::UseProgram);
+			s_Capture.Writer.Value(program);
+			Original<&glad_glUseProgram>::Fn(program);
+		}
+
+		GLint APIENTRY HookGetUniformLocation(GLuint program, const GLchar* name)
+		{
+			GLint location = Original<&glad_glGetUniformLocation>::Fn(program, name);
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::GetUniformLocation);
+			writer.Value(program);
+			writer.Blob(name, name ? std::strlen(name) : 0);
+			writer.Value(location);
+			return location;
+		}
+
+		void APIENTRY HookShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+		{
+			// Stored as one joined string
+			std::string source;
+			for (GLsizei i = 0; i < count; i++)
+			{
+				if (!strings[i]) continue;
+				if (lengths && lengths[i] >= 0) source.append(strings[i], static_cast<size_t>(lengths[i]));
+				else source.append(strings[i]);
+			}
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::ShaderSource);
+			writer.Value(shader);
+			writer.Blob(source.data(), source.size());
+			Original<&glad_glShaderSource>::Fn(shader, count, strings, lengths);
+		}
+
+		GLsync APIENTRY HookFenceSync(GLenum condition, GLbitfield flags)
+		{
+			GLsync sync = Original<&glad_glFenceSync>::Fn(condition, flags);
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::FenceSync);
+			writer.Value(condition);
+			writer.Value(flags);
+			writer.Value(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(sync)));
+			return sync;
+		}
+
+		GLenum APIENTRY HookClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::ClientWaitSync);
+			writer.Value(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(sync)));
+			writer.Value(flags);
+			writer.Value(timeout);
+			return Original<&glad_glClientWaitSync>::Fn(sync, flags, timeout);
+		}
+
+		void APIENTRY HookDeleteSync(GLsync sync)
+		{
+			s_Capture.Writer.Command(GLTraceCommand::DeleteSync);
+			s_Capture.Writer.Value(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(sync)));
+			Original<&glad_glDeleteSync>::Fn(sync);
+		}
+
+		void APIENTRY HookBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::BufferData);
+			writer.Value(target);
+			writer.Value(static_cast<int64_t>(size));
+			writer.Value(usage);
+			writer.Blob(data, static_cast<size_t>(size));
+			Original<&glad_glBufferData>::Fn(target, size, data, usage);
+		}
+
+		void APIENTRY HookBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::BufferSubData);
+			writer.Value(target);
+			writer.Value(static_cast<int64_t>(offset));
+			writer.Blob(data, static_cast<size_t>(size));
+			Original<&glad_glBufferSubData>::Fn(target, offset, size, data);
+		}
+
+		// Uploads read client memory (no pixel unpack buffer is ever bound)
+		void APIENTRY HookTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+			GLint border, GLenum format, GLenum type, const void* pixels)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::TexImage2D);
+			writer.Value(target); writer.Value(level); writer.Value(internalFormat);
+			writer.Value(width); writer.Value(height); writer.Value(border);
+			writer.Value(format); writer.Value(type);
+			writer.Blob(pixels, pixels ? GLTraceImageSize(width, height, 1, format, type, Alignment(GL_UNPACK_ALIGNMENT)) : 0);
+			Original<&glad_glTexImage2D>::Fn(target, level, internalFormat, width, height, border, format, type, pixels);
+		}
+
+		void APIENTRY HookTexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+			GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::TexImage3D);
+			writer.Value(target); writer.Value(level); writer.Value(internalFormat);
+			writer.Value(width); writer.Value(height); writer.Value(depth); writer.Value(border);
+			writer.Value(format); writer.Value(type);
+			writer.Blob(pixels, pixels ? GLTraceImageSize(width, height, depth, format, type, Alignment(GL_UNPACK_ALIGNMENT)) : 0);
+			Original<&glad_glTexImage3D>::Fn(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+		}
+
+		// DSA uploads, also from client memory
+		void APIENTRY HookTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffset,
+			GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::TextureSubImage2D);
+			writer.Value(texture); writer.Value(level);
+			writer.Value(xoffset); writer.Value(yoffset);
+			writer.Value(width); writer.Value(height);
+			writer.Value(format); writer.Value(type);
+			writer.Blob(pixels, pixels ? GLTraceImageSize(width, height, 1, format, type, Alignment(GL_UNPACK_ALIGNMENT)) : 0);
+			Original<&glad_glTextureSubImage2D>::Fn(texture, level, xoffset, yoffset, width, height, format, type, pixels);
+		}
+
+		void APIENTRY HookTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+			GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::TextureSubImage3D);
+			writer.Value(texture); writer.Value(level);
+			writer.Value(xoffset); writer.Value(yoffset); writer.Value(zoffset);
+			writer.Value(width); writer.Value(height); writer.Value(depth);
+			writer.Value(format); writer.Value(type);
+			writer.Blob(pixels, pixels ? GLTraceImageSize(width, height, depth, format, type, Alignment(GL_UNPACK_ALIGNMENT)) : 0);
+			Original<&glad_glTextureSubImage3D>::Fn(texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+		}
+
+		void APIENTRY HookCompressedTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+			GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::CompressedTextureSubImage3D);
+			writer.Value(texture); writer.Value(level);
+			writer.Value(xoffset); writer.Value(yoffset); writer.Value(zoffset);
+			writer.Value(width); writer.Value(height); writer.Value(depth);
+			writer.Value(format);
+			writer.Blob(data, static_cast<size_t>(std::max(imageSize, 0)));
+			Original<&glad_glCompressedTextureSubImage3D>::Fn(texture, level, xoffset, yoffset, zoffset, width, height, depth,
+				format, imageSize, data);
+		}
+
+		void APIENTRY HookTexParameterfv(GLenum target, GLenum pname, const GLfloat* params)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::TexParameterfv);
+			writer.Value(target);
+			writer.Value(pname);
+			writer.Blob(params, sizeof(GLfloat) * (pname == GL_TEXTURE_BORDER_COLOR ? 4 : 1));
+			Original<&glad_glTexParameterfv>::Fn(target, pname, params);
+		}
+
+		void APIENTRY HookSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat* params)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::SamplerParameterfv);
+			writer.Value(sampler);
+			writer.Value(pname);
+			writer.Blob(params, sizeof(GLfloat) * (pname == GL_TEXTURE_BORDER_COLOR ? 4 : 1));
+			Original<&glad_glSamplerParameterfv>::Fn(sampler, pname, params);
+		}
+
+		void APIENTRY HookClearBufferfv(GLenum buffer, GLint drawBuffer, const GLfloat* value)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::ClearBufferfv);
+			writer.Value(buffer);
+			writer.Value(drawBuffer);
+			writer.Blob(value, sizeof(GLfloat) * (buffer == GL_COLOR ? 4 : 1));
+			Original<&glad_glClearBufferfv>::Fn(buffer, drawBuffer, value);
+		}
+
+		void APIENTRY HookClearBufferuiv(GLenum buffer, GLint drawBuffer, const GLuint* value)
+		{
+			// Only GL_COLOR takes unsigned values
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(GLTraceCommand::ClearBufferuiv);
+			writer.Value(buffer);
+			writer.Value(drawBuffer);
+			writer.Blob(value, sizeof(GLuint) * 4);
+			Original<&glad_glClearBufferuiv>::Fn(buffer, drawBuffer, value);
+		}
+
+		template<auto* Slot, GLTraceCommand Id, size_t Floats>
+		void APIENTRY HookUniformMatrix(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+		{
+			TraceWriter& writer = s_Capture.Writer;
+			writer.Command(Id);
+			writer.Value(location);
+			writer.Value(transpose);
+			writer.Blob(value, sizeof(GLfloat) * Floats * static_cast<size_t>(std::max(count, 0)));
+			Original<Slot>::Fn(location, count, transpose, value);
+		}
+
+		void InstallHooks()
+		{
+#define VP_GL_INSTALL_VALUE(name, ...) ValueHook<&glad_gl##name, GLTraceCommand::name>::Install();
+			VP_GL_TRACE_VALUE_COMMANDS(VP_GL_INSTALL_VALUE)
+
+			// Value-only on capture; the replayer handles them specially
+			VP_GL_INSTALL_VALUE(CopyImageSubData)
+			VP_GL_INSTALL_VALUE(ReadPixels)
+			VP_GL_INSTALL_VALUE(GetTextureImage)
+			VP_GL_INSTALL_VALUE(GetNamedBufferSubData)
+#undef VP_GL_INSTALL_VALUE
+			ValueHook<&glad_glMemoryBarrier, GLTraceCommand::Barrier>::Install();
+
+#define VP_GL_INSTALL_NAMES(type) \
+			Install<&glad_glGen##type>(&HookGen<&glad_glGen##type, GLTraceCommand::Gen##type>); \
+			Install<&glad_glDelete##type>(&HookDelete<&glad_glDelete##type, GLTraceCommand::Delete##type>);
+			VP_GL_INSTALL_NAMES(Buffers)
+			VP_GL_INSTALL_NAMES(Textures)
+			VP_GL_INSTALL_NAMES(Framebuffers)
+			VP_GL_INSTALL_NAMES(Renderbuffers)
+			VP_GL_INSTALL_NAMES(VertexArrays)
+			VP_GL_INSTALL_NAMES(Samplers)
+			VP_GL_INSTALL_NAMES(Queries)
+#undef VP_GL_INSTALL_NAMES
+
+			Install<&glad_glCreateProgram>(&HookCreateProgram);
+			Install<&glad_glCreateShader>(&HookCreateShader);
+			Install<&glad_glUseProgram>(&HookUseProgram);
+			Install<&glad_glGetUniformLocation>(&HookGetUniformLocation);
+			Install<&glad_glShaderSource>(&HookShaderSource);
+			Install<&glad_glFenceSync>(&HookFenceSync);
+			Install<&glad_glClientWaitSync>(&HookClientWaitSync);
+			Install<&glad_glDeleteSync>(&HookDeleteSync);
+			Install<&glad_glBufferData>(&HookBufferData);
+			Install<&glad_glBufferSubData>(&HookBufferSubData);
+			Install<&glad_glTexImage2D>(&HookTexImage2D);
+			Install<&glad_glTexImage3D>(&HookTexImage3D);
+			Install<&glad_glTextureSubImage2D>(&HookTextureSubImage2D);
+			Install<&glad_glTextureSubImage3D>(&HookTextureSubImage3D);
+			Install<&glad_glCompressedTextureSubImage3D>(&HookCompressedTextureSubImage3D);
+			Install<&glad_glTexParameterfv>(&HookTexParameterfv);
+			Install<&glad_glSamplerParameterfv>(&HookSamplerParameterfv);
+			Install<&glad_glClearBufferfv>(&HookClearBufferfv);
+			Install<&glad_glClearBufferuiv>(&HookClearBufferuiv);
+			Install<&glad_glUniformMatrix3fv>(&HookUniformMatrix<&glad_glUniformMatrix3fv, GLTraceCommand::UniformMatrix3fv, 9>);
+			Install<&glad_glUniformMatrix4fv>(&HookUniformMatrix<&glad_glUniformMatrix4fv, GLTraceCommand::UniformMatrix4fv, 16>);
+		}
+
+		void RemoveHooks()
+		{
+			for (auto restore : s_Capture.Restores) restore();
+			s_Capture.Restores.clear();
+		}
+	}
+
+	bool GLCapture::Begin(const GLCaptureConfig& config)
+	{
+		End();
+
+		if (!s_Capture.Writer.Open(config.Path))
+		{
+			VP_CORE_ERROR("GLCapture: cannot create {}", config.Path);
+			return false;
+		}
+
+		s_Capture.Config = config;
+		s_Capture.Config.StartFrame = std::max(1u, config.StartFrame);
+		s_Capture.Frame = 0;
+		s_Capture.SetupWritten = false;
+
+		// The initial viewport is the default framebuffer
+		GLint viewport[4] = {};
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		s_Capture.Header = GLTraceHeader();
+		s_Capture.Header.Width = static_cast<uint32_t>(viewport[2]);
+		s_Capture.Header.Height = static_cast<uint32_t>(viewport[3]);
+		s_Capture.Writer.Value(s_Capture.Header);   // Rewritten with the frame count on close
+
+		InstallHooks();
+		s_Capture.Active = true;
+
+		VP_CORE_INFO("GLCapture: recording {} frames after {} warm-up frames to {}",
+			s_Capture.Config.FrameCount, s_Capture.Config.StartFrame, config.Path);
+		return true;
+	}
+
+	void GLCapture::EndFrame()
+	{
+		if (!s_Capture.Active) return;
+
+		s_Capture.Frame++;
+		if (s_Capture.Frame < s_Capture.Config.StartFrame) return;
+
+		if (!s_Capture.SetupWritten)
+		{
+			s_Capture.Writer.Command(GLTraceCommand::SetupEnd);
+			s_Capture.Header.SetupFrames = s_Capture.Frame;
+			s_Capture.SetupWritten = true;
+			return;
+		}
+
+		s_Capture.Writer.Command(GLTraceCommand::FrameEnd);
+		s_Capture.Header.FrameCount++;
+		if (s_Capture.Header.FrameCount >= s_Capture.Config.FrameCount)
+		{
+			End();
+		}
+	}
+
+	void GLCapture::End()
+	{
+		if (!s_Capture.Active) return;
+
+		RemoveHooks();
+		s_Capture.Active = false;
+
+		if (!s_Capture.SetupWritten)
+		{
+			s_Capture.Writer.Command(GLTraceCommand::SetupEnd);
+			s_Capture.Header.SetupFrames = s_Capture.Frame;
+		}
+
+		double megabytes = s_Capture.Writer.GetBytesWritten() / (1024.0 * 1024.0);
+		if (s_Capture.Writer.Close(s_Capture.Header))
+		{
+			VP_CORE_INFO("GLCapture: wrote {} frames ({:.1f} MB) to {}",
+				s_Capture.Header.FrameCount, megabytes, s_Capture.Config.Path);
+		}
+	}
+
+	bool GLCapture::IsActive()
+	{
+		return s_Capture.Active;
+	}
+}
@@ -0,0 +1,60 @@
+// VizEngine/src/VizEngine/OpenGL/GLCapture.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstdint>
+#include <string>
+
+namespace VizEngine
+{
+	/**
+	 * What to record. Capture always starts with the GL context so the trace
+	 * contains every object the recorded frames touch; the first StartFrame
+	 * frames are stored as an untimed setup prefix.
+	 */
+	struct GLCaptureConfig
+	{
+		std::string Path;            // Trace file (empty = capture off)
+		uint32_t StartFrame = 10;    // Frames of warm-up folded into the setup prefix (min 1)
+		uint32_t FrameCount = 60;    // Frames recorded for replay
+
+		bool IsEnabled() const { return !Path.empty(); }
+	};
+
+	/**
+	 * Records the GL command stream into a binary trace for GLReplayer.
+	 *
+	 * Begin() swaps the glad function pointers of the entry points listed in
+	 * GLTrace.h for recording hooks; each hook appends the call and any client
+	 * data it reads (buffer and texture uploads, shader sources, uniform
+	 * arrays) to the trace and forwards to the driver. Calls outside that
+	 * table (ImGui uses its own loader) are not recorded. Capture ends by
+	 * itself after FrameCount frames and restores the original pointers.
+	 *
+	 * Render thread only.
+	 */
+	class VizEngine_API GLCapture
+	{
+	public:
+		/**
+		 * Install the hooks and open the trace. Call right after the GL
+		 * loader, before any GL object is created.
+		 * @return false if the trace file cannot be created (logged)
+		 */
+		static bool Begin(const GLCaptureConfig& config);
+
+		/**
+		 * Mark the end of a frame. Call once per frame, after SwapBuffers.
+		 */
+		static void EndFrame();
+
+		/**
+		 * Finish early: write what was recorded and remove the hooks.
+		 */
+		static void End();
+
+		/** @return true while hooks are installed */
+		static bool IsActive();
+	};
+}
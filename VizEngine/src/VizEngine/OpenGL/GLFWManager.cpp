@@ -9,10 +9,10 @@
 
 namespace VizEngine
 {
-	GLFWManager::GLFWManager(unsigned int width, unsigned int height, const std::string& title)
+	GLFWManager::GLFWManager(unsigned int width, unsigned int height, const std::string& title, bool visible)
 		: m_Window(nullptr), m_Width(0), m_Height(0)
 	{
-		Init(width, height, title);
+		Init(width, height, title, visible);
 	}
 
 	GLFWManager::~GLFWManager()
@@ -20,7 +20,7 @@ namespace VizEngine
 		Shutdown();
 	}
 
-	void GLFWManager::Init(unsigned int width, unsigned int height, const std::string& title)
+	void GLFWManager::Init(unsigned int width, unsigned int height, const std::string& title, bool visible)
 	{
 		if (!glfwInit())
 		{
@@ -35,6 +35,7 @@ namespace VizEngine
 		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+		glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
 		m_Window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
 		if (!m_Window)
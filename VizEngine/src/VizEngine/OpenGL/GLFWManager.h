@@ -12,7 +12,7 @@ namespace VizEngine
 	class VizEngine_API GLFWManager
 	{
 	public:
-		GLFWManager(unsigned int width, unsigned int height, const std::string& title);
+		GLFWManager(unsigned int width, unsigned int height, const std::string& title, bool visible = true);
 		~GLFWManager();
 
 		void PollEvents();
@@ -31,7 +31,7 @@ namespace VizEngine
 		int m_Width, m_Height;
 		EventCallbackFn m_EventCallback;
 
-		void Init(unsigned int width, unsigned int height, const std::string& title);
+		void Init(unsigned int width, unsigned int height, const std::string& title, bool visible);
 		void Shutdown();
 
 		static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
@@ -0,0 +1,634 @@
+// VizEngine/src/VizEngine/OpenGL/GLReplay.cpp
+
+#include "GLReplay.h"
+#include "GLTrace.h"
+#include "GLFWManager.h"
+#include "VizEngine/Log.h"
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace VizEngine
+{
+	namespace
+	{
+		double NowMs()
+		{
+			using Clock = std::chrono::steady_clock;
+			return std::chrono::duration<double, std::milli>(Clock::now().time_since_epoch()).count();
+		}
+
+		/**
+		 * Bounds-checked cursor over the mapped trace.
+		 */
+		class TraceReader
+		{
+		public:
+			TraceReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+			template<typename T>
+			T Value()
+			{
+				T value{};
+				if (const uint8_t* bytes = Bytes(sizeof(T)))
+				{
+					std::memcpy(&value, bytes, sizeof(T));
+				}
+				return value;
+			}
+
+			const uint8_t* Bytes(size_t count)
+			{
+				if (m_Failed || count > m_Size - m_Position)
+				{
+					m_Failed = true;
+					return nullptr;
+				}
+				const uint8_t* bytes = m_Data + m_Position;
+				m_Position += count;
+				return bytes;
+			}
+
+			/** @return Blob bytes, or nullptr for an empty blob */
+			const uint8_t* Blob(size_t& size)
+			{
+				size = Value<uint32_t>();
+				return size ? Bytes(size) : nullptr;
+			}
+
+			bool AtEnd() const { return m_Position >= m_Size; }
+			bool Failed() const { return m_Failed; }
+			size_t GetPosition() const { return m_Position; }
+			void Seek(size_t position) { m_Position = position; }
+
+		private:
+			const uint8_t* m_Data;
+			size_t m_Size;
+			size_t m_Position = 0;
+			bool m_Failed = false;
+		};
+
+		/**
+		 * Translation from captured names to the ones this context created.
+		 */
+		struct ReplayState
+		{
+			std::unordered_map<GLuint, GLuint> Names[static_cast<size_t>(GLTraceObject::Count)];
+			std::unordered_map<uint64_t, GLint> Locations;   // (program, captured location)
+			std::unordered_map<uint64_t, GLsync> Syncs;
+			GLuint CurrentProgram = 0;
+			std::vector<uint8_t> Scratch = std::vector<uint8_t>(64 * 1024);   // Output parameters
+			std::vector<GLfloat> Floats;                                      // Aligned copies of float arrays
+
+			static uint64_t LocationKey(GLuint program, GLint location)
+			{
+				return (static_cast<uint64_t>(program) << 32) | static_cast<uint32_t>(location);
+			}
+
+			template<typename T>
+			T Translate(GLTraceObject kind, T value) const
+			{
+				if constexpr (std::is_integral_v<T>)
+				{
+					if (kind == GLTraceObject::None) return value;
+					if (kind == GLTraceObject::Location)
+					{
+						auto it = Locations.find(LocationKey(CurrentProgram, static_cast<GLint>(value)));
+						return it != Locations.end() ? static_cast<T>(it->second) : value;
+					}
+					const auto& names = Names[static_cast<size_t>(kind)];
+					auto it = names.find(static_cast<GLuint>(value));
+					return it != names.end() ? static_cast<T>(it->second) : value;   // 0 and unknown names pass through
+				}
+				else
+				{
+					(void)kind;
+					return value;
+				}
+			}
+
+			GLuint Name(GLTraceObject kind, GLuint value) const { return Translate(kind, value); }
+
+			const GLfloat* CopyFloats(const uint8_t* bytes, size_t size)
+			{
+				Floats.resize(size / sizeof(GLfloat) + 1);
+				if (bytes) std::memcpy(Floats.data(), bytes, size);
+				return Floats.data();
+			}
+
+			void* Output(size_t size)
+			{
+				if (Scratch.size() < size) Scratch.resize(size);
+				return Scratch.data();
+			}
+		};
+
+		template<typename T>
+		T ReadArgument(TraceReader& reader, ReplayState& state)
+		{
+			if constexpr (std::is_pointer_v<T>)
+			{
+				if constexpr (std::is_same_v<std::remove_pointer_t<T>, const void>)
+				{
+					return reinterpret_cast<T>(static_cast<uintptr_t>(reader.Value<uint64_t>()));
+				}
+				else
+				{
+					return reinterpret_cast<T>(state.Scratch.data());
+				}
+			}
+			else
+			{
+				return reader.Value<T>();
+			}
+		}
+
+		/**
+		 * Replay of a command recorded by GLCapture's ValueHook.
+		 */
+		template<auto* Slot, typename Fn = std::remove_pointer_t<decltype(Slot)>>
+		struct ValueReplay;
+
+		template<auto* Slot, typename R, typename... A>
+		struct ValueReplay<Slot, R (APIENTRYP)(A...)>
+		{
+			template<GLTraceObject... Kinds>
+			static void Run(TraceReader& reader, ReplayState& state)
+			{
+				// Braced initialization reads the arguments left to right
+				std::tuple<A...> args{ ReadArgument<A>(reader, state)... };
+				if (reader.Failed()) return;
+
+				constexpr GLTraceObject kinds[] = { GLTraceObject::None, Kinds... };
+				[&]<size_t... I>(std::index_sequence<I...>)
+				{
+					(*Slot)(state.Translate(I + 1 < std::size(kinds) ? kinds[I + 1] : GLTraceObject::None, std::get<I>(args))...);
+				}(std::index_sequence_for<A...>{});
+			}
+		};
+
+		template<typename GenFn>
+		void ReplayGen(TraceReader& reader, ReplayState& state, GLTraceObject kind, GenFn gen)
+		{
+			GLsizei count = reader.Value<GLsizei>();
+			const uint8_t* captured = reader.Bytes(sizeof(GLuint) * static_cast<size_t>(std::max(count, 0)));
+			if (!captured) return;
+
+			std::vector<GLuint> names(static_cast<size_t>(count));
+			gen(count, names.data());
+			for (GLsizei i = 0; i < count; i++)
+			{
+				GLuint name;
+				std::memcpy(&name, captured + sizeof(GLuint) * i, sizeof(GLuint));
+				state.Names[static_cast<size_t>(kind)][name] = names[i];
+			}
+		}
+
+		template<typename DeleteFn>
+		void ReplayDelete(TraceReader& reader, ReplayState& state, GLTraceObject kind, DeleteFn destroy)
+		{
+			GLsizei count = reader.Value<GLsizei>();
+			const uint8_t* captured = reader.Bytes(sizeof(GLuint) * static_cast<size_t>(std::max(count, 0)));
+			if (!captured) return;
+
+			std::vector<GLuint> names(static_cast<size_t>(count));
+			for (GLsizei i = 0; i < count; i++)
+			{
+				GLuint name;
+				std::memcpy(&name, captured + sizeof(GLuint) * i, sizeof(GLuint));
+				names[i] = state.Name(kind, name);
+			}
+			destroy(count, names.data());
+		}
+
+		/**
+		 * Execute commands until `until` (SetupEnd or FrameEnd).
+		 * @return false at the end of the trace or on a malformed command
+		 */
+		bool Execute(TraceReader& reader, ReplayState& state, GLTraceCommand until, uint32_t& calls)
+		{
+			using enum GLTraceObject;
+
+			while (!reader.AtEnd())
+			{
+				auto command = static_cast<GLTraceCommand>(reader.Value<uint16_t>());
+				switch (command)
+				{
+				case GLTraceCommand::SetupEnd:
+				case GLTraceCommand::FrameEnd:
+					if (command == until) return true;
+					VP_CORE_ERROR("GLReplayer: unexpected frame marker");
+					return false;
+
+#define VP_GL_REPLAY_VALUE(name, ...) \
+				case GLTraceCommand::name: ValueReplay<&glad_gl##name>::Run<__VA_ARGS__>(reader, state); break;
+				VP_GL_TRACE_VALUE_COMMANDS(VP_GL_REPLAY_VALUE)
+#undef VP_GL_REPLAY_VALUE
+
+				case GLTraceCommand::Barrier: ValueReplay<&glad_glMemoryBarrier>::Run<>(reader, state); break;
+
+#define VP_GL_REPLAY_NAMES(type, kind) \
+				case GLTraceCommand::Gen##type: ReplayGen(reader, state, kind, glad_glGen##type); break; \
+				case GLTraceCommand::Delete##type: ReplayDelete(reader, state, kind, glad_glDelete##type); break;
+				VP_GL_REPLAY_NAMES(Buffers, Buffer)
+				VP_GL_REPLAY_NAMES(Textures, Texture)
+				VP_GL_REPLAY_NAMES(Framebuffers, Framebuffer)
+				VP_GL_REPLAY_NAMES(Renderbuffers, Renderbuffer)
+				VP_GL_REPLAY_NAMES(VertexArrays, VertexArray)
+				VP_GL_REPLAY_NAMES(Samplers, Sampler)
+				VP_GL_REPLAY_NAMES(Queries, Query)
+#undef VP_GL_REPLAY_NAMES
+
+				case GLTraceCommand::CreateProgram:
+				{
+					GLuint captured = reader.Value<GLuint>();
+					state.Names[static_cast<size_t>(Program)][captured] = glCreateProgram();
+					break;
+				}
+				case GLTraceCommand::CreateShader:
+				{
+					GLenum type = reader.Value<GLenum>();
+					GLuint captured = reader.Value<GLuint>();
+					if (!reader.Failed()) state.Names[static_cast<size_t>(Shader)][captured] = glCreateShader(type);
+					break;
+				}
+				case GLTraceCommand::UseProgram:
+				{
+					state.CurrentProgram = state.Name(Program, reader.Value<GLuint>());
+					glUseProgram(state.CurrentProgram);
+					break;
+				}
+				case GLTraceCommand::GetUniformLocation:
+				{
+					GLuint program = state.Name(Program, reader.Value<GLuint>());
+					size_t size = 0;
+					const uint8_t* bytes = reader.Blob(size);
+					GLint captured = reader.Value<GLint>();
+					if (reader.Failed()) break;
+					std::string name(reinterpret_cast<const char*>(bytes), size);
+					state.Locations[ReplayState::LocationKey(program, captured)] = glGetUniformLocation(program, name.c_str());
+					break;
+				}
+				case GLTraceCommand::ShaderSource:
+				{
+					GLuint shader = state.Name(Shader, reader.Value<GLuint>());
+					size_t size = 0;
+					const GLchar* source = reinterpret_cast<const GLchar*>(reader.Blob(size));
+					GLint length = static_cast<GLint>(size);
+					if (!reader.Failed()) glShaderSource(shader, 1, &source, &length);
+					break;
+				}
+				case GLTraceCommand::FenceSync:
+				{
+					GLenum condition = reader.Value<GLenum>();
+					GLbitfield flags = reader.Value<GLbitfield>();
+					uint64_t captured = reader.Value<uint64_t>();
+					if (!reader.Failed()) state.Syncs[captured] = glFenceSync(condition, flags);
+					break;
+				}
+				case GLTraceCommand::ClientWaitSync:
+				{
+					uint64_t captured = reader.Value<uint64_t>();
+					GLbitfield flags = reader.Value<GLbitfield>();
+					GLuint64 timeout = reader.Value<GLuint64>();
+					auto it = state.Syncs.find(captured);
+					if (it != state.Syncs.end()) glClientWaitSync(it->second, flags, timeout);
+					break;
+				}
+				case GLTraceCommand::DeleteSync:
+				{
+					auto it = state.Syncs.find(reader.Value<uint64_t>());
+					if (it != state.Syncs.end())
+					{
+						glDeleteSync(it->second);
+						state.Syncs.erase(it);
+					}
+					break;
+				}
+				case GLTraceCommand::BufferData:
+				{
+					GLenum target = reader.Value<GLenum>();
+					int64_t size = reader.Value<int64_t>();
+					GLenum usage = reader.Value<GLenum>();
+					size_t dataSize = 0;
+					const uint8_t* data = reader.Blob(dataSize);
+					if (!reader.Failed()) glBufferData(target, static_cast<GLsizeiptr>(size), data, usage);
+					break;
+				}
+				case GLTraceCommand::BufferSubData:
+				{
+					GLenum target = reader.Value<GLenum>();
+					int64_t offset = reader.Value<int64_t>();
+					size_t size = 0;
+					const uint8_t* data = reader.Blob(size);
+					if (!reader.Failed()) glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+					break;
+				}
+				case GLTraceCommand::TexImage2D:
+				{
+					auto [target, level, internalFormat, width, height, border, format, type] =
+						std::tuple{ reader.Value<GLenum>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLsizei>(),
+							reader.Value<GLsizei>(), reader.Value<GLint>(), reader.Value<GLenum>(), reader.Value<GLenum>() };
+					size_t size = 0;
+					const uint8_t* pixels = reader.Blob(size);
+					if (!reader.Failed()) glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+					break;
+				}
+				case GLTraceCommand::TexImage3D:
+				{
+					auto [target, level, internalFormat, width, height, depth, border, format, type] =
+						std::tuple{ reader.Value<GLenum>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLsizei>(),
+							reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLint>(), reader.Value<GLenum>(),
+							reader.Value<GLenum>() };
+					size_t size = 0;
+					const uint8_t* pixels = reader.Blob(size);
+					if (!reader.Failed()) glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+					break;
+				}
+				case GLTraceCommand::TextureSubImage2D:
+				{
+					GLuint texture = state.Name(Texture, reader.Value<GLuint>());
+					auto [level, xoffset, yoffset, width, height, format, type] =
+						std::tuple{ reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLsizei>(),
+							reader.Value<GLsizei>(), reader.Value<GLenum>(), reader.Value<GLenum>() };
+					size_t size = 0;
+					const uint8_t* pixels = reader.Blob(size);
+					if (!reader.Failed()) glTextureSubImage2D(texture, level, xoffset, yoffset, width, height, format, type, pixels);
+					break;
+				}
+				case GLTraceCommand::TextureSubImage3D:
+				{
+					GLuint texture = state.Name(Texture, reader.Value<GLuint>());
+					auto [level, xoffset, yoffset, zoffset, width, height, depth, format, type] =
+						std::tuple{ reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(),
+							reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLenum>(),
+							reader.Value<GLenum>() };
+					size_t size = 0;
+					const uint8_t* pixels = reader.Blob(size);
+					if (!reader.Failed()) glTextureSubImage3D(texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+					break;
+				}
+				case GLTraceCommand::CompressedTextureSubImage3D:
+				{
+					GLuint texture = state.Name(Texture, reader.Value<GLuint>());
+					auto [level, xoffset, yoffset, zoffset, width, height, depth, format] =
+						std::tuple{ reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(),
+							reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLenum>() };
+					size_t size = 0;
+					const uint8_t* data = reader.Blob(size);
+					if (!reader.Failed())
+					{
+						glCompressedTextureSubImage3D(texture, level, xoffset, yoffset, zoffset, width, height, depth, format,
+							static_cast<GLsizei>(size), data);
+					}
+					break;
+				}
+				case GLTraceCommand::TexParameterfv:
+				{
+					GLenum target = reader.Value<GLenum>();
+					GLenum pname = reader.Value<GLenum>();
+					size_t size = 0;
+					const uint8_t* values = reader.Blob(size);
+					if (!reader.Failed()) glTexParameterfv(target, pname, state.CopyFloats(values, size));
+					break;
+				}
+				case GLTraceCommand::SamplerParameterfv:
+				{
+					GLuint sampler = state.Name(Sampler, reader.Value<GLuint>());
+					GLenum pname = reader.Value<GLenum>();
+					size_t size = 0;
+					const uint8_t* values = reader.Blob(size);
+					if (!reader.Failed()) glSamplerParameterfv(sampler, pname, state.CopyFloats(values, size));
+					break;
+				}
+				case GLTraceCommand::ClearBufferfv:
+				{
+					GLenum buffer = reader.Value<GLenum>();
+					GLint drawBuffer = reader.Value<GLint>();
+					size_t size = 0;
+					const uint8_t* values = reader.Blob(size);
+					if (!reader.Failed()) glClearBufferfv(buffer, drawBuffer, state.CopyFloats(values, size));
+					break;
+				}
+				case GLTraceCommand::ClearBufferuiv:
+				{
+					GLenum buffer = reader.Value<GLenum>();
+					GLint drawBuffer = reader.Value<GLint>();
+					size_t size = 0;
+					const uint8_t* bytes = reader.Blob(size);
+					if (reader.Failed()) break;
+					GLuint values[4] = {};
+					if (bytes) std::memcpy(values, bytes, std::min(size, sizeof(values)));
+					glClearBufferuiv(buffer, drawBuffer, values);
+					break;
+				}
+				case GLTraceCommand::UniformMatrix3fv:
+				case GLTraceCommand::UniformMatrix4fv:
+				{
+					GLint location = state.Translate(Location, reader.Value<GLint>());
+					GLboolean transpose = reader.Value<GLboolean>();
+					size_t size = 0;
+					const uint8_t* values = reader.Blob(size);
+					if (reader.Failed()) break;
+					if (command == GLTraceCommand::UniformMatrix3fv)
+						glUniformMatrix3fv(location, static_cast<GLsizei>(size / (9 * sizeof(GLfloat))), transpose, state.CopyFloats(values, size));
+					else
+						glUniformMatrix4fv(location, static_cast<GLsizei>(size / (16 * sizeof(GLfloat))), transpose, state.CopyFloats(values, size));
+					break;
+				}
+				case GLTraceCommand::CopyImageSubData:
+				{
+					// Source and destination are textures or renderbuffers depending on their targets
+					auto [srcName, srcTarget, srcLevel, srcX, srcY, srcZ, dstName, dstTarget, dstLevel, dstX, dstY, dstZ, width, height, depth] =
+						std::tuple{ reader.Value<GLuint>(), reader.Value<GLenum>(), reader.Value<GLint>(), reader.Value<GLint>(),
+							reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLuint>(), reader.Value<GLenum>(),
+							reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLint>(),
+							reader.Value<GLsizei>(), reader.Value<GLsizei>(), reader.Value<GLsizei>() };
+					if (reader.Failed()) break;
+					GLuint src = state.Name(srcTarget == GL_RENDERBUFFER ? Renderbuffer : Texture, srcName);
+					GLuint dst = state.Name(dstTarget == GL_RENDERBUFFER ? Renderbuffer : Texture, dstName);
+					glCopyImageSubData(src, srcTarget, srcLevel, srcX, srcY, srcZ, dst, dstTarget, dstLevel, dstX, dstY, dstZ,
+						width, height, depth);
+					break;
+				}
+				case GLTraceCommand::ReadPixels:
+				{
+					auto [x, y, width, height, format, type] =
+						std::tuple{ reader.Value<GLint>(), reader.Value<GLint>(), reader.Value<GLsizei>(), reader.Value<GLsizei>(),
+							reader.Value<GLenum>(), reader.Value<GLenum>() };
+					if (reader.Failed()) break;
+					GLint alignment = 4;
+					glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+					void* pixels = state.Output(GLTraceImageSize(width, height, 1, format, type, alignment));
+					glReadPixels(x, y, width, height, format, type, pixels);
+					break;
+				}
+				case GLTraceCommand::GetTextureImage:
+				{
+					GLuint texture = state.Name(Texture, reader.Value<GLuint>());
+					auto [level, format, type, bufSize] =
+						std::tuple{ reader.Value<GLint>(), reader.Value<GLenum>(), reader.Value<GLenum>(), reader.Value<GLsizei>() };
+					if (reader.Failed()) break;
+					glGetTextureImage(texture, level, format, type, bufSize, state.Output(static_cast<size_t>(std::max(bufSize, 0))));
+					break;
+				}
+				case GLTraceCommand::GetNamedBufferSubData:
+				{
+					// Readbacks (counters, request lists, mesh data) go to scratch memory of their size
+					GLuint buffer = state.Name(Buffer, reader.Value<GLuint>());
+					GLintptr offset = reader.Value<GLintptr>();
+					GLsizeiptr size = reader.Value<GLsizeiptr>();
+					if (reader.Failed()) break;
+					glGetNamedBufferSubData(buffer, offset, size, state.Output(static_cast<size_t>(std::max<GLsizeiptr>(size, 0))));
+					break;
+				}
+
+				default:
+					VP_CORE_ERROR("GLReplayer: unknown command {} at offset {}", static_cast<int>(command), reader.GetPosition());
+					return false;
+				}
+
+				if (reader.Failed())
+				{
+					VP_CORE_ERROR("GLReplayer: trace ends inside a command");
+					return false;
+				}
+				calls++;
+			}
+			return false;
+		}
+
+		const GLTraceHeader* Header(const MappedFile& file)
+		{
+			return file.IsOpen() ? reinterpret_cast<const GLTraceHeader*>(file.GetData()) : nullptr;
+		}
+	}
+
+	GLReplayer::GLReplayer() = default;
+	GLReplayer::~GLReplayer() = default;
+
+	bool GLReplayer::Load(const std::string& path)
+	{
+		if (!m_File.Open(path)) return false;
+
+		GLTraceHeader header;
+		if (m_File.GetSize() < sizeof(header))
+		{
+			VP_CORE_ERROR("GLReplayer: {} is too small to be a trace", path);
+			m_File.Close();
+			return false;
+		}
+		std::memcpy(&header, m_File.GetData(), sizeof(header));
+		if (header.Magic != GLTraceHeader::MagicValue || header.Version != GLTraceHeader::CurrentVersion)
+		{
+			VP_CORE_ERROR("GLReplayer: {} is not a version {} trace", path, GLTraceHeader::CurrentVersion);
+			m_File.Close();
+			return false;
+		}
+
+		VP_CORE_INFO("GLReplayer: {} - {}x{}, {} setup frames, {} recorded frames, {:.1f} MB", path,
+			header.Width, header.Height, header.SetupFrames, header.FrameCount, m_File.GetSize() / (1024.0 * 1024.0));
+		return true;
+	}
+
+	bool GLReplayer::CreateContext()
+	{
+		try
+		{
+			m_Window = std::make_unique<GLFWManager>(std::max(GetWidth(), 1u), std::max(GetHeight(), 1u), "GLReplay", false);
+		}
+		catch (const std::exception& e)
+		{
+			VP_CORE_ERROR("GLReplayer: failed to create window: {}", e.what());
+			return false;
+		}
+
+		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+		{
+			VP_CORE_ERROR("GLReplayer: failed to initialize GLAD");
+			m_Window.reset();
+			return false;
+		}
+
+		glfwSwapInterval(0);
+		VP_CORE_INFO("GLReplayer: {} on {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+			reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+		return true;
+	}
+
+	bool GLReplayer::Replay(const GLReplayOptions& options, GLReplayResult& result)
+	{
+		result = GLReplayResult();
+		if (!m_File.IsOpen()) return false;
+
+		TraceReader reader(m_File.GetData() + sizeof(GLTraceHeader), m_File.GetSize() - sizeof(GLTraceHeader));
+		ReplayState state;
+		uint32_t calls = 0;
+
+		// Setup prefix: objects, uploads and warm-up frames
+		double setupStart = NowMs();
+		if (!Execute(reader, state, GLTraceCommand::SetupEnd, calls))
+		{
+			VP_CORE_ERROR("GLReplayer: trace has no setup marker");
+			return false;
+		}
+		glFinish();
+		result.SetupMs = NowMs() - setupStart;
+
+		uint32_t frameCount = GetFrameCount();
+		uint32_t loops = std::max(options.Loops, 1u);
+		size_t framesStart = reader.GetPosition();
+
+		// One elapsed-time query per frame, read back after the run
+		std::vector<GLuint> queries(static_cast<size_t>(frameCount) * loops);
+		if (!queries.empty()) glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+		result.Frames.resize(queries.size());
+
+		for (uint32_t loop = 0; loop < loops; loop++)
+		{
+			reader.Seek(framesStart);
+			for (uint32_t frame = 0; frame < frameCount; frame++)
+			{
+				size_t index = static_cast<size_t>(loop) * frameCount + frame;
+				GLReplayFrame& timing = result.Frames[index];
+
+				glBeginQuery(GL_TIME_ELAPSED, queries[index]);
+				double start = NowMs();
+				bool ok = Execute(reader, state, GLTraceCommand::FrameEnd, timing.Calls);
+				timing.CpuMs = NowMs() - start;
+				glEndQuery(GL_TIME_ELAPSED);
+
+				if (options.Present && m_Window) m_Window->SwapBuffers();
+				else glFlush();
+
+				if (!ok)
+				{
+					VP_CORE_ERROR("GLReplayer: trace ended in frame {}", frame);
+					result.Frames.resize(index);
+					glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+					return false;
+				}
+			}
+		}
+
+		glFinish();
+		for (size_t i = 0; i < queries.size(); i++)
+		{
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &elapsed);
+			result.Frames[i].GpuMs = elapsed / 1.0e6;
+		}
+		if (!queries.empty()) glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+		return true;
+	}
+
+	uint32_t GLReplayer::GetWidth() const { const GLTraceHeader* h = Header(m_File); return h ? h->Width : 0; }
+	uint32_t GLReplayer::GetHeight() const { const GLTraceHeader* h = Header(m_File); return h ? h->Height : 0; }
+	uint32_t GLReplayer::GetFrameCount() const { const GLTraceHeader* h = Header(m_File); return h ? h->FrameCount : 0; }
+	uint32_t GLReplayer::GetSetupFrames() const { const GLTraceHeader* h = Header(m_File); return h ? h->SetupFrames : 0; }
+}
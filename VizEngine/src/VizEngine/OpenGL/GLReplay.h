@@ -0,0 +1,85 @@
+// VizEngine/src/VizEngine/OpenGL/GLReplay.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	class GLFWManager;
+
+	struct GLReplayOptions
+	{
+		uint32_t Loops = 1;      // Times the recorded frames are played back to back
+		bool Present = true;     // SwapBuffers after each frame (false = glFlush only)
+	};
+
+	struct GLReplayFrame
+	{
+		double CpuMs = 0.0;      // Time to submit the frame's commands
+		double GpuMs = 0.0;      // GL_TIME_ELAPSED around the frame
+		uint32_t Calls = 0;
+	};
+
+	struct GLReplayResult
+	{
+		double SetupMs = 0.0;               // Untimed prefix, including glFinish
+		std::vector<GLReplayFrame> Frames;  // Loops x recorded frames
+	};
+
+	/**
+	 * Plays a GLCapture trace back as fast as possible.
+	 *
+	 * The setup prefix (object creation, uploads, warm-up frames) runs once;
+	 * the recorded frames then run Loops times with nothing but the trace
+	 * between them, so CPU time is pure submission and driver overhead.
+	 * Object names, uniform locations and sync handles from the capture are
+	 * translated to the ones this context creates.
+	 *
+	 * Usage:
+	 *   GLReplayer replayer;
+	 *   if (replayer.Load("frame.vpgl") && replayer.CreateContext())
+	 *       replayer.Replay(options, result);
+	 */
+	class VizEngine_API GLReplayer
+	{
+	public:
+		GLReplayer();
+		~GLReplayer();
+
+		GLReplayer(const GLReplayer&) = delete;
+		GLReplayer& operator=(const GLReplayer&) = delete;
+
+		/**
+		 * Map a trace file and validate its header.
+		 * @return false if the file is missing or not a trace of this version (logged)
+		 */
+		bool Load(const std::string& path);
+
+		/**
+		 * Create a hidden window of the captured size with vsync off and load
+		 * GL. Not needed if the caller already has a current 4.6 context.
+		 */
+		bool CreateContext();
+
+		/**
+		 * Run the trace on the current context.
+		 * @return false if the trace is malformed (logged)
+		 */
+		bool Replay(const GLReplayOptions& options, GLReplayResult& result);
+
+		uint32_t GetWidth() const;
+		uint32_t GetHeight() const;
+		uint32_t GetFrameCount() const;
+		uint32_t GetSetupFrames() const;
+
+	private:
+		MappedFile m_File;
+		std::unique_ptr<GLFWManager> m_Window;
+	};
+}
@@ -0,0 +1,472 @@
+// VizEngine/src/VizEngine/OpenGL/HDRTextureCodec.cpp
+
+#include "HDRTextureCodec.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// =========================================================================
+		// RGB9_E5 (GL 4.6 specification, section 8.5.2)
+		// =========================================================================
+		constexpr int RGB9E5MantissaBits = 9;
+		constexpr int RGB9E5ExponentBias = 15;
+		constexpr float RGB9E5Max = 65408.0f;            // (2^9 - 1) / 2^9 * 2^16
+
+		float ClampRGB9E5(float value)
+		{
+			// !(value > 0) also catches NaN
+			return !(value > 0.0f) ? 0.0f : std::min(value, RGB9E5Max);
+		}
+
+		// =========================================================================
+		// BC6H unsigned float, single-region modes
+		// =========================================================================
+		constexpr int HalfMax = 0x7BFF;                   // 65504, the largest finite half
+
+		// Interpolation weights of 4-bit indices (out of 64)
+		constexpr int IndexWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		struct BC6HMode
+		{
+			uint32_t Bits;             // Mode field (5 bits)
+			int EndpointBits;
+			int DeltaBits;             // 0 = second endpoint stored raw
+		};
+
+		constexpr BC6HMode Mode10Bit = { 0x03, 10, 0 };   // D3D mode 11
+		constexpr BC6HMode Mode11Bit = { 0x07, 11, 9 };   // D3D mode 12
+
+		/** Non-negative float to the nearest half-float bit pattern, clamped to HalfMax. */
+		int FloatToHalfBits(float value)
+		{
+			if (!(value > 0.0f)) return 0;
+			if (value >= 65504.0f) return HalfMax;
+
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			int exponent = static_cast<int>(bits >> 23) - 127;
+			uint32_t mantissa = bits & 0x7FFFFFu;
+			if (exponent < -14)
+			{
+				// Subnormal half: value / 2^-24, rounded
+				return static_cast<int>(std::lround(std::ldexp(value, 24)));
+			}
+			// The rounding carry may ripple into the exponent, which is still correct
+			int half = ((exponent + 15) << 10) | static_cast<int>(mantissa >> 13);
+			half += static_cast<int>((mantissa >> 12) & 1u);
+			return std::min(half, HalfMax);
+		}
+
+		int Unquantize(int value, int bits)
+		{
+			if (value == 0) return 0;
+			if (value == (1 << bits) - 1) return 0xFFFF;
+			return ((value << 16) + 0x8000) >> bits;
+		}
+
+		/** Decoder output (half bits) of an unquantized value. */
+		int FinishUnsigned(int value)
+		{
+			return (value * 31) >> 6;
+		}
+
+		/** Quantized endpoint whose decoded value is closest to a half bit pattern. */
+		int QuantizeEndpoint(float half, int bits)
+		{
+			const int maxValue = (1 << bits) - 1;
+			int guess = static_cast<int>(std::lround(half * static_cast<float>(1 << (bits - 10)) / 31.0f));
+			int best = 0;
+			float bestError = 1e30f;
+			for (int candidate = guess - 1; candidate <= guess + 1; candidate++)
+			{
+				int c = std::clamp(candidate, 0, maxValue);
+				float error = std::abs(static_cast<float>(FinishUnsigned(Unquantize(c, bits))) - half);
+				if (error < bestError)
+				{
+					bestError = error;
+					best = c;
+				}
+			}
+			return best;
+		}
+
+		float HalfBitsToFloat(int half)
+		{
+			int exponent = half >> 10;
+			int mantissa = half & 0x3FF;
+			if (exponent == 0) return std::ldexp(static_cast<float>(mantissa), -24);
+			return std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+		}
+
+		/**
+		 * One 4x4 block. Endpoints are fitted on the half bit patterns (the
+		 * decoder interpolates those), but candidates are compared by linear
+		 * error relative to each texel's brightest channel: half-bit distances
+		 * alone let a near-black channel outweigh the visible ones.
+		 */
+		struct BC6HBlock
+		{
+			int Half[16][3];
+			float Linear[16][3];
+			float Weight[16];
+		};
+
+		struct BC6HCandidate
+		{
+			int A[3] = {};             // Quantized endpoints
+			int B[3] = {};
+			uint8_t Indices[16] = {};
+			float Error = FLT_MAX;
+		};
+
+		/** Pick indices for quantized endpoints; returns the weighted squared error. */
+		float AssignIndices(const BC6HBlock& block, const BC6HMode& mode, BC6HCandidate& candidate)
+		{
+			float palette[16][3];
+			for (int c = 0; c < 3; c++)
+			{
+				int a = Unquantize(candidate.A[c], mode.EndpointBits);
+				int b = Unquantize(candidate.B[c], mode.EndpointBits);
+				for (int i = 0; i < 16; i++)
+				{
+					int w = IndexWeights[i];
+					palette[i][c] = HalfBitsToFloat(FinishUnsigned((a * (64 - w) + b * w + 32) >> 6));
+				}
+			}
+
+			float total = 0.0f;
+			for (int p = 0; p < 16; p++)
+			{
+				float best = FLT_MAX;
+				for (int i = 0; i < 16; i++)
+				{
+					float dr = palette[i][0] - block.Linear[p][0];
+					float dg = palette[i][1] - block.Linear[p][1];
+					float db = palette[i][2] - block.Linear[p][2];
+					float error = dr * dr + dg * dg + db * db;
+					if (error < best)
+					{
+						best = error;
+						candidate.Indices[p] = static_cast<uint8_t>(i);
+					}
+				}
+				total += best * block.Weight[p];
+			}
+			return total;
+		}
+
+		/** Quantize float endpoints (half-bit space) for a mode and assign indices. */
+		BC6HCandidate Evaluate(const BC6HBlock& block, const BC6HMode& mode, const float (&a)[3], const float (&b)[3])
+		{
+			BC6HCandidate candidate;
+			for (int c = 0; c < 3; c++)
+			{
+				candidate.A[c] = QuantizeEndpoint(a[c], mode.EndpointBits);
+				candidate.B[c] = QuantizeEndpoint(b[c], mode.EndpointBits);
+				if (mode.DeltaBits > 0)
+				{
+					// Symmetric range so the endpoints can always be swapped for the anchor
+					int limit = (1 << (mode.DeltaBits - 1)) - 1;
+					candidate.B[c] = candidate.A[c] + std::clamp(candidate.B[c] - candidate.A[c], -limit, limit);
+				}
+			}
+			candidate.Error = AssignIndices(block, mode, candidate);
+			return candidate;
+		}
+
+		/** Least-squares endpoints for fixed indices; false if the system is singular. */
+		bool Refit(const BC6HBlock& block, const uint8_t (&indices)[16], float (&a)[3], float (&b)[3])
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float pa[3] = {}, pb[3] = {};
+			for (int p = 0; p < 16; p++)
+			{
+				float beta = static_cast<float>(IndexWeights[indices[p]]) / 64.0f;
+				float alpha = 1.0f - beta;
+				aa += alpha * alpha;
+				ab += alpha * beta;
+				bb += beta * beta;
+				for (int c = 0; c < 3; c++)
+				{
+					pa[c] += alpha * static_cast<float>(block.Half[p][c]);
+					pb[c] += beta * static_cast<float>(block.Half[p][c]);
+				}
+			}
+
+			float det = aa * bb - ab * ab;
+			if (std::abs(det) < 1e-6f) return false;
+			for (int c = 0; c < 3; c++)
+			{
+				a[c] = std::clamp((bb * pa[c] - ab * pb[c]) / det, 0.0f, static_cast<float>(HalfMax));
+				b[c] = std::clamp((aa * pb[c] - ab * pa[c]) / det, 0.0f, static_cast<float>(HalfMax));
+			}
+			return true;
+		}
+
+		/** Endpoints at the extremes of the texels along their principal axis. */
+		void PrincipalEndpoints(const BC6HBlock& block, float (&a)[3], float (&b)[3])
+		{
+			float mean[3] = {};
+			float lo[3] = { 1e30f, 1e30f, 1e30f }, hi[3] = { -1e30f, -1e30f, -1e30f };
+			for (int p = 0; p < 16; p++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					float v = static_cast<float>(block.Half[p][c]);
+					mean[c] += v;
+					lo[c] = std::min(lo[c], v);
+					hi[c] = std::max(hi[c], v);
+				}
+			}
+			for (int c = 0; c < 3; c++) mean[c] /= 16.0f;
+
+			float cov[6] = {};    // xx, xy, xz, yy, yz, zz
+			for (int p = 0; p < 16; p++)
+			{
+				float d[3];
+				for (int c = 0; c < 3; c++) d[c] = static_cast<float>(block.Half[p][c]) - mean[c];
+				cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+				cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+			}
+
+			// Power iteration from the bounding box diagonal
+			float axis[3] = { hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2] };
+			for (int iteration = 0; iteration < 8; iteration++)
+			{
+				float next[3] = {
+					cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+					cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+					cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+				};
+				float length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+				if (length < 1e-12f) break;
+				for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+			}
+			float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+			if (axisLength < 1e-12f)
+			{
+				// Flat block
+				for (int c = 0; c < 3; c++) a[c] = b[c] = mean[c];
+				return;
+			}
+			for (int c = 0; c < 3; c++) axis[c] /= axisLength;
+
+			float tMin = 1e30f, tMax = -1e30f;
+			for (int p = 0; p < 16; p++)
+			{
+				float t = 0.0f;
+				for (int c = 0; c < 3; c++) t += (static_cast<float>(block.Half[p][c]) - mean[c]) * axis[c];
+				tMin = std::min(tMin, t);
+				tMax = std::max(tMax, t);
+			}
+			for (int c = 0; c < 3; c++)
+			{
+				a[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, static_cast<float>(HalfMax));
+				b[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, static_cast<float>(HalfMax));
+			}
+		}
+
+		BC6HCandidate EncodeMode(const BC6HBlock& block, const BC6HMode& mode, const float (&startA)[3],
+			const float (&startB)[3])
+		{
+			BC6HCandidate best = Evaluate(block, mode, startA, startB);
+			for (int iteration = 0; iteration < 2 && best.Error > 0.0f; iteration++)
+			{
+				float a[3], b[3];
+				if (!Refit(block, best.Indices, a, b)) break;
+				BC6HCandidate refined = Evaluate(block, mode, a, b);
+				if (refined.Error >= best.Error) break;
+				best = refined;
+			}
+			return best;
+		}
+
+		class BlockWriter
+		{
+		public:
+			explicit BlockWriter(uint8_t* block) : m_Block(block) { std::memset(block, 0, 16); }
+
+			void Write(uint32_t value, int bits)
+			{
+				for (int i = 0; i < bits; i++, m_Position++)
+				{
+					if ((value >> i) & 1u) m_Block[m_Position >> 3] |= static_cast<uint8_t>(1u << (m_Position & 7));
+				}
+			}
+
+		private:
+			uint8_t* m_Block;
+			int m_Position = 0;
+		};
+
+		void WriteBlock(const BC6HMode& mode, BC6HCandidate& candidate, uint8_t* block)
+		{
+			// The first index is stored without its top bit, which must be 0
+			if (candidate.Indices[0] & 8)
+			{
+				std::swap(candidate.A, candidate.B);
+				for (auto& index : candidate.Indices) index = static_cast<uint8_t>(15 - index);
+			}
+
+			BlockWriter writer(block);
+			writer.Write(mode.Bits, 5);
+			if (mode.DeltaBits == 0)
+			{
+				for (int c = 0; c < 3; c++) writer.Write(static_cast<uint32_t>(candidate.A[c]), 10);
+				for (int c = 0; c < 3; c++) writer.Write(static_cast<uint32_t>(candidate.B[c]), 10);
+			}
+			else
+			{
+				// rw[9:0] gw[9:0] bw[9:0], then per channel delta[8:0] followed by w[10]
+				for (int c = 0; c < 3; c++) writer.Write(static_cast<uint32_t>(candidate.A[c]) & 0x3FFu, 10);
+				for (int c = 0; c < 3; c++)
+				{
+					writer.Write(static_cast<uint32_t>(candidate.B[c] - candidate.A[c]) & 0x1FFu, 9);
+					writer.Write(static_cast<uint32_t>(candidate.A[c]) >> 10, 1);
+				}
+			}
+
+			writer.Write(candidate.Indices[0], 3);
+			for (int p = 1; p < 16; p++) writer.Write(candidate.Indices[p], 4);
+		}
+
+		void EncodeBC6HBlock(const float* rgb, int width, int height, int blockX, int blockY, uint8_t* output)
+		{
+			BC6HBlock block;
+			for (int y = 0; y < 4; y++)
+			{
+				int sy = std::min(blockY * 4 + y, height - 1);
+				for (int x = 0; x < 4; x++)
+				{
+					int sx = std::min(blockX * 4 + x, width - 1);
+					const float* texel = rgb + (static_cast<size_t>(sy) * width + sx) * 3;
+					int p = y * 4 + x;
+					float brightest = 0.0f;
+					for (int c = 0; c < 3; c++)
+					{
+						block.Half[p][c] = FloatToHalfBits(texel[c]);
+						block.Linear[p][c] = HalfBitsToFloat(block.Half[p][c]);
+						brightest = std::max(brightest, block.Linear[p][c]);
+					}
+					block.Weight[p] = 1.0f / (brightest * brightest + 1e-8f);
+				}
+			}
+
+			// Start from the principal axis and from the bounding box diagonal
+			float starts[2][2][3];
+			PrincipalEndpoints(block, starts[0][0], starts[0][1]);
+			for (int c = 0; c < 3; c++)
+			{
+				starts[1][0][c] = starts[1][1][c] = static_cast<float>(block.Half[0][c]);
+				for (int p = 1; p < 16; p++)
+				{
+					starts[1][0][c] = std::min(starts[1][0][c], static_cast<float>(block.Half[p][c]));
+					starts[1][1][c] = std::max(starts[1][1][c], static_cast<float>(block.Half[p][c]));
+				}
+			}
+
+			BC6HCandidate best;
+			const BC6HMode* bestMode = &Mode10Bit;
+			for (const BC6HMode* mode : { &Mode10Bit, &Mode11Bit })
+			{
+				for (const auto& start : starts)
+				{
+					BC6HCandidate candidate = EncodeMode(block, *mode, start[0], start[1]);
+					if (candidate.Error < best.Error)
+					{
+						best = candidate;
+						bestMode = mode;
+					}
+				}
+				if (best.Error == 0.0f) break;
+			}
+			WriteBlock(*bestMode, best, output);
+		}
+	}
+
+	namespace HDRTextureCodec
+	{
+		void PackRGB9E5(const float* rgb, size_t texelCount, uint32_t* packed)
+		{
+			constexpr int N = RGB9E5MantissaBits;
+			constexpr int B = RGB9E5ExponentBias;
+
+			for (size_t i = 0; i < texelCount; i++)
+			{
+				float r = ClampRGB9E5(rgb[i * 3 + 0]);
+				float g = ClampRGB9E5(rgb[i * 3 + 1]);
+				float b = ClampRGB9E5(rgb[i * 3 + 2]);
+				float maxChannel = std::max({ r, g, b });
+
+				// floor(log2(max)) from frexp's [0.5, 1) mantissa
+				int exponent = -B - 1;
+				if (maxChannel > 0.0f)
+				{
+					int e;
+					std::frexp(maxChannel, &e);
+					exponent = std::max(exponent, e - 1);
+				}
+				int shared = exponent + 1 + B;
+				if (std::floor(maxChannel / std::ldexp(1.0f, shared - B - N) + 0.5f) == static_cast<float>(1 << N))
+				{
+					shared++;
+				}
+
+				float scale = std::ldexp(1.0f, -(shared - B - N));
+				uint32_t rs = static_cast<uint32_t>(std::floor(r * scale + 0.5f));
+				uint32_t gs = static_cast<uint32_t>(std::floor(g * scale + 0.5f));
+				uint32_t bs = static_cast<uint32_t>(std::floor(b * scale + 0.5f));
+				packed[i] = rs | (gs << 9) | (bs << 18) | (static_cast<uint32_t>(shared) << 27);
+			}
+		}
+
+		size_t GetBC6HSize(int width, int height)
+		{
+			size_t blocksX = static_cast<size_t>(std::max(width, 1) + 3) / 4;
+			size_t blocksY = static_cast<size_t>(std::max(height, 1) + 3) / 4;
+			return blocksX * blocksY * 16;
+		}
+
+		void EncodeBC6H(const float* rgb, int width, int height, std::vector<uint8_t>& blocks, unsigned int threads)
+		{
+			blocks.assign(GetBC6HSize(width, height), 0);
+			if (!rgb || width <= 0 || height <= 0) return;
+
+			const int blocksX = (width + 3) / 4;
+			const int blocksY = (height + 3) / 4;
+			auto encodeRows = [&](int begin, int end)
+			{
+				for (int by = begin; by < end; by++)
+				{
+					for (int bx = 0; bx < blocksX; bx++)
+					{
+						EncodeBC6HBlock(rgb, width, height, bx, by,
+							blocks.data() + (static_cast<size_t>(by) * blocksX + bx) * 16);
+					}
+				}
+			};
+
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			threads = std::min(threads, static_cast<unsigned int>(blocksY));
+
+			int step = (blocksY + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+			std::vector<std::future<void>> jobs;
+			for (unsigned int t = 1; t < threads; t++)
+			{
+				int begin = static_cast<int>(t) * step;
+				int end = std::min(blocksY, begin + step);
+				if (begin < end) jobs.push_back(std::async(std::launch::async, encodeRows, begin, end));
+			}
+			encodeRows(0, std::min(blocksY, step));
+			for (auto& job : jobs) job.get();
+		}
+	}
+}
@@ -0,0 +1,49 @@
+// VizEngine/src/VizEngine/OpenGL/HDRTextureCodec.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * CPU encoders for compact HDR texture formats. They need no GL context,
+	 * so they can run offline or on a worker thread; the results upload with
+	 * glTextureSubImage* / glCompressedTextureSubImage*.
+	 *
+	 * Input is tightly packed RGB floats. Negative and NaN values become 0
+	 * (both formats are unsigned), values above the format's range clamp.
+	 */
+	namespace HDRTextureCodec
+	{
+		/**
+		 * Pack to GL_RGB9_E5 (type GL_UNSIGNED_INT_5_9_9_9_REV) with the
+		 * GL specification's shared-exponent rounding. 4 bytes per texel,
+		 * 9 mantissa bits per channel relative to the brightest one.
+		 */
+		VizEngine_API void PackRGB9E5(const float* rgb, size_t texelCount, uint32_t* packed);
+
+		/** @return Bytes of BC6H data for one width x height image (16 per 4x4 block) */
+		VizEngine_API size_t GetBC6HSize(int width, int height);
+
+		/**
+		 * Encode to BC6H unsigned float (GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT),
+		 * 1 byte per texel. Each block picks the better of the single-region
+		 * 10-bit and 11-bit + 9-bit delta modes, starting from principal-axis
+		 * and bounding-box endpoints with least-squares refits, by error
+		 * relative to each texel's brightness. Blocks at the right and bottom
+		 * edges of images that are not multiples of 4 repeat the last texels.
+		 *
+		 * Partitioned (two-region) modes are not used, so blocks that mix two
+		 * unrelated colours (sharp edges) lose more than a full encoder would.
+		 *
+		 * @param blocks Resized to GetBC6HSize(width, height); rows of blocks, top to bottom
+		 * @param threads Encoder threads, 0 = hardware concurrency
+		 */
+		VizEngine_API void EncodeBC6H(const float* rgb, int width, int height, std::vector<uint8_t>& blocks,
+			unsigned int threads = 0);
+	}
+}
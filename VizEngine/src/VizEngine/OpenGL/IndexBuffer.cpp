@@ -1,4 +1,5 @@
 #include "IndexBuffer.h"
+#include "DeletionQueue.h"
 
 namespace VizEngine
 {
@@ -15,7 +16,7 @@ namespace VizEngine
 	{
 		if (m_ibo != 0)
 		{
-			glDeleteBuffers(1, &m_ibo);
+			DeletionQueue::Enqueue(GLResourceType::Buffer, m_ibo);
 		}
 	}
 
@@ -34,7 +35,7 @@ namespace VizEngine
 		{
 			if (m_ibo != 0)
 			{
-				glDeleteBuffers(1, &m_ibo);
+				DeletionQueue::Enqueue(GLResourceType::Buffer, m_ibo);
 			}
 			m_ibo = other.m_ibo;
 			m_Count = other.m_Count;
@@ -0,0 +1,62 @@
+// VizEngine/src/VizEngine/OpenGL/RenderStats.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace VizEngine
+{
+	/**
+	 * Passes measured by the overdraw analyzer.
+	 */
+	enum class OverdrawPass : uint8_t
+	{
+		Opaque = 0,
+		Transparent,
+		Post,
+		Count
+	};
+
+	/**
+	 * Fragment-count summary for one pass (see OverdrawAnalyzer).
+	 */
+	struct OverdrawMetrics
+	{
+		float Average = 0.0f;                 // Fragments per screen pixel
+		float AverageCovered = 0.0f;          // Fragments per pixel touched at least once
+		float Max = 0.0f;                     // Worst pixel
+		float Coverage = 0.0f;                // Percent of pixels touched
+		float PercentAboveThreshold = 0.0f;   // Percent of pixels shaded more than Threshold times
+		uint32_t Threshold = 4;
+		uint64_t Fragments = 0;               // Sum over all pixels
+		bool Valid = false;                   // False until the pass has been measured
+		bool Estimated = false;               // Built from full-screen layers per draw, not the real draws
+	};
+
+	/**
+	 * Counters collected by the Renderer.
+	 * Draw counters are reset every frame by the engine; overdraw metrics
+	 * persist and only change when an analysis pass runs.
+	 */
+	struct RenderStats
+	{
+		uint32_t DrawCalls = 0;               // Draw() + DrawInstanced()
+		uint32_t InstancedDrawCalls = 0;
+		uint64_t Triangles = 0;               // Including every instance
+		uint64_t Instances = 0;
+
+		OverdrawMetrics Overdraw[static_cast<size_t>(OverdrawPass::Count)];
+
+		const OverdrawMetrics& GetOverdraw(OverdrawPass pass) const { return Overdraw[static_cast<size_t>(pass)]; }
+		void SetOverdraw(OverdrawPass pass, const OverdrawMetrics& metrics) { Overdraw[static_cast<size_t>(pass)] = metrics; }
+
+		void ResetFrameCounters()
+		{
+			DrawCalls = 0;
+			InstancedDrawCalls = 0;
+			Triangles = 0;
+			Instances = 0;
+		}
+	};
+}
@@ -56,6 +56,10 @@ namespace VizEngine
 		ib.Bind();
 
 		glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr);
+
+		m_Stats.DrawCalls++;
+		m_Stats.Triangles += ib.GetCount() / 3;
+		m_Stats.Instances++;
 	}
 
 	void Renderer::EnablePolygonOffset(float factor, float units)
@@ -167,12 +171,18 @@ namespace VizEngine
 	// =========================================================================
 
 	void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib,
-	                             const Shader& shader, int instanceCount) const
+	                             const Shader& shader, int instanceCount, uint32_t baseInstance) const
 	{
 		shader.Bind();
 		va.Bind();
 		ib.Bind();
 
-		glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr, instanceCount);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr,
+			instanceCount, baseInstance);
+
+		m_Stats.DrawCalls++;
+		m_Stats.InstancedDrawCalls++;
+		m_Stats.Triangles += static_cast<uint64_t>(ib.GetCount() / 3) * static_cast<uint64_t>(instanceCount);
+		m_Stats.Instances += static_cast<uint64_t>(instanceCount);
 	}
 }
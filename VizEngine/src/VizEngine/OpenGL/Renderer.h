@@ -4,6 +4,7 @@
 #include "VertexArray.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
+#include "RenderStats.h"
 #include "VizEngine/Core.h"
 #include <vector>
 #include <array>
@@ -65,10 +66,25 @@ namespace VizEngine
 		// Chapter 35: Instancing
 		// =====================================================================
 
+		/**
+		 * @param baseInstance First gl_BaseInstance (offset into per-instance
+		 *                     data that shaders index themselves)
+		 */
 		void DrawInstanced(const VertexArray& va, const IndexBuffer& ib,
-		                   const Shader& shader, int instanceCount) const;
+		                   const Shader& shader, int instanceCount, uint32_t baseInstance = 0) const;
+
+		// =====================================================================
+		// Statistics
+		// =====================================================================
+
+		const RenderStats& GetStats() const { return m_Stats; }
+		RenderStats& GetStats() { return m_Stats; }
+
+		/** Reset per-frame counters (called by the engine at frame start). */
+		void ResetStats() { m_Stats.ResetFrameCounters(); }
 
 	private:
 		std::vector<std::array<int, 4>> m_ViewportStack;
+		mutable RenderStats m_Stats;  // Updated from const draw calls
 	};
 }
\ No newline at end of file
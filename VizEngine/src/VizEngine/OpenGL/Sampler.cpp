@@ -0,0 +1,93 @@
+// VizEngine/src/VizEngine/OpenGL/Sampler.cpp
+
+#include "Sampler.h"
+#include "DeletionQueue.h"
+#include "VizEngine/Log.h"
+
+namespace VizEngine
+{
+	bool SamplerDesc::operator==(const SamplerDesc& other) const
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			if (BorderColor[i] != other.BorderColor[i]) return false;
+		}
+
+		return MinFilter == other.MinFilter
+			&& MagFilter == other.MagFilter
+			&& WrapS == other.WrapS
+			&& WrapT == other.WrapT
+			&& WrapR == other.WrapR
+			&& MaxAnisotropy == other.MaxAnisotropy
+			&& CompareMode == other.CompareMode
+			&& CompareFunc == other.CompareFunc;
+	}
+
+	Sampler::Sampler(const SamplerDesc& desc)
+		: m_Desc(desc)
+	{
+		glGenSamplers(1, &m_Sampler);
+
+		glSamplerParameteri(m_Sampler, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(desc.MinFilter));
+		glSamplerParameteri(m_Sampler, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(desc.MagFilter));
+		glSamplerParameteri(m_Sampler, GL_TEXTURE_WRAP_S, static_cast<GLint>(desc.WrapS));
+		glSamplerParameteri(m_Sampler, GL_TEXTURE_WRAP_T, static_cast<GLint>(desc.WrapT));
+		glSamplerParameteri(m_Sampler, GL_TEXTURE_WRAP_R, static_cast<GLint>(desc.WrapR));
+		glSamplerParameterfv(m_Sampler, GL_TEXTURE_BORDER_COLOR, desc.BorderColor);
+
+		if (desc.MaxAnisotropy > 1.0f)
+		{
+			// Core since GL 4.6
+			float maxSupported = 1.0f;
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxSupported);
+			float anisotropy = desc.MaxAnisotropy < maxSupported ? desc.MaxAnisotropy : maxSupported;
+			glSamplerParameterf(m_Sampler, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
+		}
+
+		if (desc.CompareMode != GL_NONE)
+		{
+			glSamplerParameteri(m_Sampler, GL_TEXTURE_COMPARE_MODE, static_cast<GLint>(desc.CompareMode));
+			glSamplerParameteri(m_Sampler, GL_TEXTURE_COMPARE_FUNC, static_cast<GLint>(desc.CompareFunc));
+		}
+	}
+
+	Sampler::~Sampler()
+	{
+		if (m_Sampler != 0)
+		{
+			DeletionQueue::Enqueue(GLResourceType::Sampler, m_Sampler);
+		}
+	}
+
+	Sampler::Sampler(Sampler&& other) noexcept
+		: m_Sampler(other.m_Sampler)
+		, m_Desc(other.m_Desc)
+	{
+		other.m_Sampler = 0;
+	}
+
+	Sampler& Sampler::operator=(Sampler&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_Sampler != 0)
+			{
+				DeletionQueue::Enqueue(GLResourceType::Sampler, m_Sampler);
+			}
+			m_Sampler = other.m_Sampler;
+			m_Desc = other.m_Desc;
+			other.m_Sampler = 0;
+		}
+		return *this;
+	}
+
+	void Sampler::Bind(unsigned int unit) const
+	{
+		glBindSampler(unit, m_Sampler);
+	}
+
+	void Sampler::Unbind(unsigned int unit)
+	{
+		glBindSampler(unit, 0);
+	}
+}
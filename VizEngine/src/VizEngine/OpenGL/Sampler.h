@@ -0,0 +1,70 @@
+// VizEngine/src/VizEngine/OpenGL/Sampler.h
+
+#pragma once
+
+#include <glad/glad.h>
+#include "VizEngine/Core.h"
+
+namespace VizEngine
+{
+	/**
+	 * Filtering and addressing state for a sampler object.
+	 * Defaults match the per-texture state set by Texture's file constructors.
+	 */
+	struct VizEngine_API SamplerDesc
+	{
+		unsigned int MinFilter = GL_LINEAR_MIPMAP_LINEAR;
+		unsigned int MagFilter = GL_LINEAR;
+		unsigned int WrapS = GL_REPEAT;
+		unsigned int WrapT = GL_REPEAT;
+		unsigned int WrapR = GL_REPEAT;
+		float MaxAnisotropy = 1.0f;
+		float BorderColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		// Depth comparison (sampler2DShadow); GL_NONE disables
+		unsigned int CompareMode = GL_NONE;
+		unsigned int CompareFunc = GL_LEQUAL;
+
+		bool operator==(const SamplerDesc& other) const;
+	};
+
+	/**
+	 * RAII wrapper for OpenGL sampler objects.
+	 *
+	 * A sampler bound to a texture unit overrides the filtering/wrap state
+	 * stored in whatever texture is bound there, so one sampler can be shared
+	 * by many textures instead of duplicating state per texture.
+	 */
+	class VizEngine_API Sampler
+	{
+	public:
+		explicit Sampler(const SamplerDesc& desc = {});
+		~Sampler();
+
+		// Non-copyable
+		Sampler(const Sampler&) = delete;
+		Sampler& operator=(const Sampler&) = delete;
+
+		// Movable
+		Sampler(Sampler&& other) noexcept;
+		Sampler& operator=(Sampler&& other) noexcept;
+
+		/**
+		 * Bind this sampler to a texture unit.
+		 * @param unit Texture unit (matches Texture::Bind slot)
+		 */
+		void Bind(unsigned int unit) const;
+
+		/**
+		 * Remove any sampler from a texture unit (texture state applies again).
+		 */
+		static void Unbind(unsigned int unit);
+
+		inline unsigned int GetID() const { return m_Sampler; }
+		inline const SamplerDesc& GetDesc() const { return m_Desc; }
+
+	private:
+		unsigned int m_Sampler = 0;
+		SamplerDesc m_Desc;
+	};
+}
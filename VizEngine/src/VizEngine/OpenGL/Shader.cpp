@@ -1,5 +1,7 @@
 #include "Shader.h"
+#include "DeletionQueue.h"
 #include "VizEngine/Log.h"
+#include "VizEngine/Core/Profiler.h"
 #include <stdexcept>
 
 namespace VizEngine
@@ -9,18 +11,18 @@ namespace VizEngine
 	{
 		enum class ShaderType
 		{
-			NONE = -1, VERTEX = 0, FRAGMENT = 1
+			NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
 		};
 
 		std::ifstream input(shaderFile, std::ios::binary);
 		if (!input)
 		{
 			VP_CORE_ERROR("Failed to open shader file: {}", shaderFile);
-			return {"", ""};
+			return {"", "", ""};
 		}
 
 		std::string contents;
-		std::stringstream ss[2];
+		std::stringstream ss[3];
 		ShaderType shaderType = ShaderType::NONE;
 		while (getline(input, contents))
 		{
@@ -34,6 +36,10 @@ namespace VizEngine
 				{
 					shaderType = ShaderType::FRAGMENT;
 				}
+				else if (contents.find("compute") != std::string::npos)
+				{
+					shaderType = ShaderType::COMPUTE;
+				}
 			}
 			else
 			{
@@ -43,23 +49,55 @@ namespace VizEngine
 				}
 			}
 		}
-		return {ss[0].str(), ss[1].str()};
+		return {ss[0].str(), ss[1].str(), ss[2].str()};
+	}
+
+	namespace
+	{
+		// Insert lines right after the #version directive (which must stay first)
+		void InsertDefines(std::string& source, const std::string& defines)
+		{
+			if (source.empty() || defines.empty()) return;
+
+			size_t version = source.find("#version");
+			size_t lineEnd = version == std::string::npos ? std::string::npos : source.find('\n', version);
+			if (lineEnd == std::string::npos)
+			{
+				source.insert(0, defines);
+				return;
+			}
+			source.insert(lineEnd + 1, defines);
+		}
 	}
 
 	// Constructor that builds the final Shader
 	Shader::Shader(const std::string& shaderFile)
+		: Shader(shaderFile, std::string())
+	{
+	}
+
+	Shader::Shader(const std::string& shaderFile, const std::string& defines)
 		: m_shaderPath(shaderFile), m_program(0)
 	{
+		VP_PROFILE_EVENT(ShaderCompile, shaderFile);
+
 		// Parse the shader file
 		ShaderPrograms shaders = ShaderParser(shaderFile);
-		if (shaders.VertexProgram.empty() || shaders.FragmentProgram.empty())
+		m_IsCompute = !shaders.ComputeProgram.empty();
+		if (!m_IsCompute && (shaders.VertexProgram.empty() || shaders.FragmentProgram.empty()))
 		{
 			VP_CORE_ERROR("Failed to parse shader file: {}", shaderFile);
 			throw std::runtime_error("Failed to parse shader: " + shaderFile);
 		}
+
+		InsertDefines(shaders.VertexProgram, defines);
+		InsertDefines(shaders.FragmentProgram, defines);
+		InsertDefines(shaders.ComputeProgram, defines);
 		
 		// Compile and link
-		m_program = CreateShader(shaders.VertexProgram, shaders.FragmentProgram);
+		m_program = m_IsCompute
+			? CreateComputeShader(shaders.ComputeProgram)
+			: CreateShader(shaders.VertexProgram, shaders.FragmentProgram);
 		if (m_program == 0)
 		{
 			VP_CORE_ERROR("Failed to compile/link shader: {}", shaderFile);
@@ -71,7 +109,7 @@ namespace VizEngine
 	{
 		if (m_program != 0)
 		{
-			glDeleteProgram(m_program);
+			DeletionQueue::Enqueue(GLResourceType::Program, m_program);
 		}
 	}
 
@@ -79,6 +117,7 @@ namespace VizEngine
 	Shader::Shader(Shader&& other) noexcept
 		: m_shaderPath(std::move(other.m_shaderPath)),
 		  m_program(other.m_program),
+		  m_IsCompute(other.m_IsCompute),
 		  m_LocationCache(std::move(other.m_LocationCache))
 	{
 		other.m_program = 0;
@@ -91,10 +130,11 @@ namespace VizEngine
 		{
 			if (m_program != 0)
 			{
-				glDeleteProgram(m_program);
+				DeletionQueue::Enqueue(GLResourceType::Program, m_program);
 			}
 			m_shaderPath = std::move(other.m_shaderPath);
 			m_program = other.m_program;
+			m_IsCompute = other.m_IsCompute;
 			m_LocationCache = std::move(other.m_LocationCache);
 			other.m_program = 0;
 		}
@@ -171,6 +211,31 @@ namespace VizEngine
 		return program;
 	}
 
+	unsigned int Shader::CreateComputeShader(const std::string& comp)
+	{
+		unsigned int program = glCreateProgram();
+
+		unsigned int cs = CompileShader(GL_COMPUTE_SHADER, comp);
+		if (!CheckCompileErrors(cs, "COMPUTE"))
+		{
+			glDeleteShader(cs);
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		glAttachShader(program, cs);
+		glLinkProgram(program);
+		glDeleteShader(cs);
+
+		if (!CheckCompileErrors(program, "PROGRAM"))
+		{
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+
 	// utility uniform functions
 	void Shader::SetBool(const std::string& name, bool value)
 	{
@@ -192,6 +257,11 @@ namespace VizEngine
 		glUniform2f(GetUniformLocation(name), value.x, value.y);
 	}
 
+	void Shader::SetIVec2(const std::string& name, int x, int y)
+	{
+		glUniform2i(GetUniformLocation(name), x, y);
+	}
+
 	void Shader::SetVec3(const std::string& name, const glm::vec3& value)
 	{
 		glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
@@ -12,10 +12,12 @@
 namespace VizEngine
 {
 	// Struct to return two or more strings. For Vertex and Fragment Shader Programs from the same file.
+	// A file with a "#shader compute" section builds a compute-only program instead.
 	struct ShaderPrograms
 	{
 		std::string VertexProgram;
 		std::string FragmentProgram;
+		std::string ComputeProgram;
 	};
 
 	// Shader Class
@@ -24,6 +26,12 @@ namespace VizEngine
 	public:
 		// Constructor that build the Shader Program
 		Shader(const std::string& shaderFile);
+
+		/**
+		 * Build with extra preprocessor lines inserted after each stage's #version.
+		 * @param defines e.g. "#define MAX_TAPS 16\n"
+		 */
+		Shader(const std::string& shaderFile, const std::string& defines);
 		// Destructor
 		~Shader();
 
@@ -42,6 +50,7 @@ namespace VizEngine
 
 		// Validation
 		bool IsValid() const { return m_program != 0; }
+		bool IsCompute() const { return m_IsCompute; }
 
 		// Utility uniform functions
 		void SetBool(const std::string& name, bool value);
@@ -53,10 +62,12 @@ namespace VizEngine
 		void SetMatrix4fv(const std::string& name, const glm::mat4& matrix);
 		void SetMatrix3fv(const std::string& name, const glm::mat3& matrix);
 		void SetVec2(const std::string& name, const glm::vec2& value);
+		void SetIVec2(const std::string& name, int x, int y);
 
 	private:
 		std::string m_shaderPath;
 		unsigned int m_program;
+		bool m_IsCompute = false;
 		std::unordered_map<std::string, int> m_LocationCache;
 
 		// Shader parser with a return type of ShaderPrograms
@@ -65,6 +76,8 @@ namespace VizEngine
 		unsigned int CompileShader(unsigned int type, const std::string& source);
 		// Creates the final shader 
 		unsigned int CreateShader(const std::string& vert, const std::string& frag);
+		// Creates a compute-only program
+		unsigned int CreateComputeShader(const std::string& comp);
 		// Get uniform location for the set shader uniforms
 		int GetUniformLocation(const std::string& name);
 		// Utility function for checking shader compilation/linking errors.
@@ -0,0 +1,70 @@
+// VizEngine/src/VizEngine/OpenGL/ShaderStorageBuffer.cpp
+
+#include "ShaderStorageBuffer.h"
+#include "DeletionQueue.h"
+
+namespace VizEngine
+{
+	ShaderStorageBuffer::ShaderStorageBuffer(const void* data, size_t size, unsigned int usage)
+		: m_Size(size), m_Usage(usage)
+	{
+		glGenBuffers(1, &m_Buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	ShaderStorageBuffer::~ShaderStorageBuffer()
+	{
+		if (m_Buffer != 0)
+		{
+			DeletionQueue::Enqueue(GLResourceType::Buffer, m_Buffer);
+		}
+	}
+
+	ShaderStorageBuffer::ShaderStorageBuffer(ShaderStorageBuffer&& other) noexcept
+		: m_Buffer(other.m_Buffer)
+		, m_Size(other.m_Size)
+		, m_Usage(other.m_Usage)
+	{
+		other.m_Buffer = 0;
+		other.m_Size = 0;
+	}
+
+	ShaderStorageBuffer& ShaderStorageBuffer::operator=(ShaderStorageBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_Buffer != 0)
+			{
+				DeletionQueue::Enqueue(GLResourceType::Buffer, m_Buffer);
+			}
+			m_Buffer = other.m_Buffer;
+			m_Size = other.m_Size;
+			m_Usage = other.m_Usage;
+			other.m_Buffer = 0;
+			other.m_Size = 0;
+		}
+		return *this;
+	}
+
+	void ShaderStorageBuffer::SetData(const void* data, size_t size, size_t offset)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer);
+
+		if (offset + size > m_Size)
+		{
+			// Grow: allocate new storage, then write the requested range
+			m_Size = offset + size;
+			glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(m_Size), nullptr, m_Usage);
+		}
+
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void ShaderStorageBuffer::BindBase(unsigned int binding) const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_Buffer);
+	}
+}
@@ -0,0 +1,57 @@
+// VizEngine/src/VizEngine/OpenGL/ShaderStorageBuffer.h
+
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+#include "VizEngine/Core.h"
+
+namespace VizEngine
+{
+	/**
+	 * RAII wrapper for a shader storage buffer (GL_SHADER_STORAGE_BUFFER).
+	 * Holds std430 arrays that shaders index directly, e.g. material tables
+	 * or per-instance data addressed with gl_InstanceID.
+	 */
+	class VizEngine_API ShaderStorageBuffer
+	{
+	public:
+		/**
+		 * @param data Initial contents (may be nullptr)
+		 * @param size Size in bytes
+		 * @param usage Usage hint (e.g., GL_DYNAMIC_DRAW, GL_STATIC_DRAW)
+		 */
+		ShaderStorageBuffer(const void* data, size_t size, unsigned int usage = GL_DYNAMIC_DRAW);
+		~ShaderStorageBuffer();
+
+		// Non-copyable
+		ShaderStorageBuffer(const ShaderStorageBuffer&) = delete;
+		ShaderStorageBuffer& operator=(const ShaderStorageBuffer&) = delete;
+
+		// Movable
+		ShaderStorageBuffer(ShaderStorageBuffer&& other) noexcept;
+		ShaderStorageBuffer& operator=(ShaderStorageBuffer&& other) noexcept;
+
+		/**
+		 * Update contents. When the write does not fit, the buffer is
+		 * reallocated and previous contents are discarded.
+		 * @param data Source bytes
+		 * @param size Number of bytes
+		 * @param offset Destination offset in bytes
+		 */
+		void SetData(const void* data, size_t size, size_t offset = 0);
+
+		/**
+		 * Bind to an indexed binding point (layout(std430, binding = N)).
+		 */
+		void BindBase(unsigned int binding) const;
+
+		inline unsigned int GetID() const { return m_Buffer; }
+		inline size_t GetSize() const { return m_Size; }
+
+	private:
+		unsigned int m_Buffer = 0;
+		size_t m_Size = 0;
+		unsigned int m_Usage = GL_DYNAMIC_DRAW;
+	};
+}
@@ -1,5 +1,7 @@
 #include "Texture.h"
+#include "DeletionQueue.h"
 #include "VizEngine/Log.h"
+#include "VizEngine/Core/Profiler.h"
 #include "stb_image.h"
 #include <vector>
 
@@ -9,6 +11,7 @@ namespace VizEngine
 		: m_texture(0), m_FilePath(path), m_LocalBuffer(nullptr),
 		  m_Width(0), m_Height(0), m_BPP(0)
 	{
+		VP_PROFILE_EVENT(AssetLoad, path);
 		stbi_set_flip_vertically_on_load(1);
 		m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
 
@@ -28,6 +31,8 @@ namespace VizEngine
 
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		m_InternalFormat = GL_RGBA8;
+		m_MipLevels = CalculateMipLevels(m_Width, m_Height);
 		glBindTexture(GL_TEXTURE_2D, 0);
 
 		stbi_image_free(m_LocalBuffer);
@@ -38,6 +43,7 @@ namespace VizEngine
 		: m_texture(0), m_FilePath("embedded"), m_LocalBuffer(nullptr),
 		  m_Width(width), m_Height(height), m_BPP(channels)
 	{
+		VP_PROFILE_EVENT(Upload, "Texture " + std::to_string(width) + "x" + std::to_string(height));
 		if (!data || width <= 0 || height <= 0 || channels <= 0)
 		{
 			VP_CORE_ERROR("Failed to create texture from raw data: invalid parameters (data, width, height, or channels)");
@@ -78,6 +84,8 @@ namespace VizEngine
 
 		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		m_InternalFormat = internalFormat;
+		m_MipLevels = CalculateMipLevels(m_Width, m_Height);
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
@@ -85,6 +93,7 @@ namespace VizEngine
 		: m_texture(0), m_FilePath("framebuffer"), m_LocalBuffer(nullptr),
 		  m_Width(width), m_Height(height), m_BPP(4)
 	{
+		VP_PROFILE_EVENT(Upload, "Render target " + std::to_string(width) + "x" + std::to_string(height));
 		glGenTextures(1, &m_texture);
 		glBindTexture(GL_TEXTURE_2D, m_texture);
 
@@ -100,6 +109,9 @@ namespace VizEngine
 			dataType,             // e.g., GL_UNSIGNED_BYTE or GL_FLOAT
 			nullptr               // no pixel data (allocate empty)
 		);
+		m_InternalFormat = internalFormat;
+		m_Format = format;
+		m_DataType = dataType;
 
 		// Set texture parameters suitable for framebuffer attachments
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -116,6 +128,7 @@ namespace VizEngine
 		: m_texture(0), m_FilePath(filepath), m_LocalBuffer(nullptr),
 		  m_Width(0), m_Height(0), m_BPP(0), m_IsHDR(isHDR)
 	{
+		VP_PROFILE_EVENT(AssetLoad, filepath);
 		// stb_image loads with bottom-left origin, OpenGL expects bottom-left
 		stbi_set_flip_vertically_on_load(1);
 
@@ -141,6 +154,7 @@ namespace VizEngine
 					GL_FLOAT,           // Data type
 					hdrData
 				);
+				m_InternalFormat = GL_RGB16F;
 
 				// Set texture parameters
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -168,6 +182,7 @@ namespace VizEngine
 				glBindTexture(GL_TEXTURE_2D, m_texture);
 
 				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+				m_InternalFormat = GL_RGBA8;
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -191,6 +206,7 @@ namespace VizEngine
 		  m_Width(resolution), m_Height(resolution), m_BPP(3),
 		  m_IsCubemap(true), m_IsHDR(isHDR)
 	{
+		VP_PROFILE_EVENT(Upload, "Cubemap " + std::to_string(resolution));
 		glGenTextures(1, &m_texture);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture);
 
@@ -198,6 +214,7 @@ namespace VizEngine
 		GLenum internalFormat = isHDR ? GL_RGB16F : GL_RGB8;
 		GLenum format = GL_RGB;
 		GLenum type = isHDR ? GL_FLOAT : GL_UNSIGNED_BYTE;
+		m_InternalFormat = internalFormat;
 
 		for (unsigned int i = 0; i < 6; ++i)
 		{
@@ -227,11 +244,40 @@ namespace VizEngine
 			m_Width, m_Height, isHDR ? "HDR" : "LDR");
 	}
 
+	Texture::Texture(int resolution, unsigned int internalFormat, int mipLevels)
+		: m_texture(0), m_FilePath("cubemap"), m_LocalBuffer(nullptr),
+		  m_Width(resolution), m_Height(resolution), m_BPP(3),
+		  m_IsCubemap(true), m_IsHDR(true), m_InternalFormat(internalFormat)
+	{
+		VP_PROFILE_EVENT(Upload, "Cubemap " + std::to_string(resolution));
+		if (resolution <= 0)
+		{
+			VP_CORE_ERROR("Failed to create cubemap: invalid resolution {}", resolution);
+			m_InternalFormat = 0;
+			return;
+		}
+
+		int fullChain = CalculateMipLevels(resolution, resolution);
+		m_MipLevels = (mipLevels <= 0 || mipLevels > fullChain) ? fullChain : mipLevels;
+
+		glGenTextures(1, &m_texture);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, m_MipLevels, internalFormat, resolution, resolution);
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	}
+
 	Texture::~Texture()
 	{
 		if (m_texture != 0)
 		{
-			glDeleteTextures(1, &m_texture);
+			DeletionQueue::Enqueue(GLResourceType::Texture, m_texture);
 		}
 	}
 
@@ -244,7 +290,11 @@ namespace VizEngine
 		  m_Height(other.m_Height),
 		  m_BPP(other.m_BPP),
 		  m_IsCubemap(other.m_IsCubemap),
-		  m_IsHDR(other.m_IsHDR)
+		  m_IsHDR(other.m_IsHDR),
+		  m_InternalFormat(other.m_InternalFormat),
+		  m_Format(other.m_Format),
+		  m_DataType(other.m_DataType),
+		  m_MipLevels(other.m_MipLevels)
 	{
 		other.m_texture = 0;
 		other.m_LocalBuffer = nullptr;
@@ -259,7 +309,7 @@ namespace VizEngine
 		{
 			if (m_texture != 0)
 			{
-				glDeleteTextures(1, &m_texture);
+				DeletionQueue::Enqueue(GLResourceType::Texture, m_texture);
 			}
 			m_texture = other.m_texture;
 			m_FilePath = std::move(other.m_FilePath);
@@ -269,6 +319,10 @@ namespace VizEngine
 			m_BPP = other.m_BPP;
 			m_IsCubemap = other.m_IsCubemap;
 			m_IsHDR = other.m_IsHDR;
+			m_InternalFormat = other.m_InternalFormat;
+			m_Format = other.m_Format;
+			m_DataType = other.m_DataType;
+			m_MipLevels = other.m_MipLevels;
 			other.m_texture = 0;
 			other.m_LocalBuffer = nullptr;
 			other.m_IsCubemap = false;
@@ -394,11 +448,83 @@ namespace VizEngine
 		glBindTexture(GL_TEXTURE_3D, textureID);
 	}
 
-	void Texture::DeleteTexture3D(unsigned int textureID)
+	void Texture::AllocateMipLevels(int levels)
+	{
+		if (m_IsCubemap || m_Format == 0)
+		{
+			VP_CORE_ERROR("Texture::AllocateMipLevels: only empty 2D textures are supported ({})", m_FilePath);
+			return;
+		}
+
+		int fullChain = CalculateMipLevels(m_Width, m_Height);
+		levels = (levels <= 0 || levels > fullChain) ? fullChain : levels;
+
+		glBindTexture(GL_TEXTURE_2D, m_texture);
+		for (int level = 1; level < levels; level++)
+		{
+			int width = m_Width >> level;
+			int height = m_Height >> level;
+			glTexImage2D(GL_TEXTURE_2D, level, m_InternalFormat,
+				width > 0 ? width : 1, height > 0 ? height : 1, 0, m_Format, m_DataType, nullptr);
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		m_MipLevels = levels;
+	}
+
+	size_t Texture::GetMemoryEstimate() const
 	{
-		if (textureID != 0)
+		double bytesPerTexel;
+		switch (m_InternalFormat)
 		{
-			glDeleteTextures(1, &textureID);
+		case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+		case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+		case GL_R8:                  bytesPerTexel = 1.0; break;
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:   bytesPerTexel = 2.0; break;
+		case GL_RGB8:
+		case GL_SRGB8:
+		case GL_DEPTH_COMPONENT24:   bytesPerTexel = 3.0; break;
+		case GL_RGB16F:              bytesPerTexel = 6.0; break;
+		case GL_RGBA16F:
+		case GL_RG32F:               bytesPerTexel = 8.0; break;
+		case GL_RGB32F:              bytesPerTexel = 12.0; break;
+		case GL_RGBA32F:             bytesPerTexel = 16.0; break;
+		case 0:                      return 0;
+		default:                     bytesPerTexel = 4.0; break;   // RGBA8, R32F, RG16F, R11G11B10F, RGB9E5, depth 32/24+8
 		}
+
+		// Each mip level is a quarter of the previous one
+		double texels = 0.0;
+		int width = m_Width, height = m_Height;
+		for (int level = 0; level < m_MipLevels; level++)
+		{
+			texels += static_cast<double>(width) * height;
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+		}
+
+		int faces = m_IsCubemap ? 6 : 1;
+		return static_cast<size_t>(texels * bytesPerTexel * faces);
+	}
+
+	int Texture::CalculateMipLevels(int width, int height)
+	{
+		int levels = 1;
+		int size = width > height ? width : height;
+		while (size > 1)
+		{
+			size >>= 1;
+			levels++;
+		}
+		return levels;
+	}
+
+	void Texture::DeleteTexture3D(unsigned int textureID)
+	{
+		DeletionQueue::Enqueue(GLResourceType::Texture, textureID);
 	}
 }
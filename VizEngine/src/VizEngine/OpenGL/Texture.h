@@ -40,6 +40,15 @@ namespace VizEngine
 	 * @param isHDR Use HDR format (GL_RGB16F) or LDR (GL_RGB8)
 	 */
 	Texture(int resolution, bool isHDR);
+
+	/**
+	 * Create an empty HDR cubemap with immutable storage in any internal
+	 * format, compressed ones included (see CubemapUtils::ConvertStorage).
+	 * @param resolution Resolution per face
+	 * @param internalFormat e.g. GL_R11F_G11F_B10F, GL_RGB9_E5, GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT
+	 * @param mipLevels Levels to allocate (0 = full chain)
+	 */
+	Texture(int resolution, unsigned int internalFormat, int mipLevels);
 		
 		~Texture();
 
@@ -65,6 +74,26 @@ namespace VizEngine
 		inline bool IsCubemap() const { return m_IsCubemap; }
 	inline bool IsHDR() const { return m_IsHDR; }
 
+	/** @return OpenGL internal format (e.g., GL_RGBA8), 0 if never allocated */
+	inline unsigned int GetInternalFormat() const { return m_InternalFormat; }
+
+	/** @return Number of mip levels allocated by this texture */
+	inline int GetMipLevels() const { return m_MipLevels; }
+
+	/**
+	 * Approximate GPU memory of all levels and faces, from the internal
+	 * format (driver padding and alignment are not included).
+	 */
+	size_t GetMemoryEstimate() const;
+
+	/**
+	 * Allocate levels 1..levels-1 of an empty (framebuffer) texture so a
+	 * MipDownsampler can fill them. Level 0 keeps its contents. The filter
+	 * is left alone; set a mipmap min filter to sample the new levels.
+	 * @param levels Total level count (0 = full chain)
+	 */
+	void AllocateMipLevels(int levels = 0);
+
 	// =========================================================================
 	// Static Utility Methods
 	// =========================================================================
@@ -89,6 +118,11 @@ namespace VizEngine
 	 */
 	static void DeleteTexture3D(unsigned int textureID);
 
+	/**
+	 * Number of levels in a full mip chain (1 + floor(log2(max(w, h)))).
+	 */
+	static int CalculateMipLevels(int width, int height);
+
 	private:
 		unsigned int m_texture;
 		std::string m_FilePath;
@@ -96,5 +130,9 @@ namespace VizEngine
 		int m_Width, m_Height, m_BPP;
 		bool m_IsCubemap = false;
 		bool m_IsHDR = false;
+		unsigned int m_InternalFormat = 0;
+		unsigned int m_Format = 0;      // Pixel transfer format/type of empty textures (for AllocateMipLevels)
+		unsigned int m_DataType = 0;
+		int m_MipLevels = 1;
 	};
 }
\ No newline at end of file
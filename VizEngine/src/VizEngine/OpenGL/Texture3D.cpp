@@ -1,4 +1,5 @@
 #include "Texture3D.h"
+#include "DeletionQueue.h"
 #include "VizEngine/Log.h"
 #include <vector>
 
@@ -75,12 +76,35 @@ namespace VizEngine
 		glBindTexture(GL_TEXTURE_3D, 0);
 	}
 
+	Texture3D::Texture3D(int width, int height, int depth, unsigned int internalFormat,
+		unsigned int format, unsigned int dataType, const void* data)
+		: m_Width(width), m_Height(height), m_Depth(depth), m_InternalFormat(internalFormat)
+	{
+		glGenTextures(1, &m_Texture);
+		glBindTexture(GL_TEXTURE_3D, m_Texture);
+
+		// Volume rows are rarely 4-byte aligned (GL_R8, odd widths)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage3D(GL_TEXTURE_3D, 0, internalFormat,
+			width, height, depth, 0,
+			format, dataType, data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		glBindTexture(GL_TEXTURE_3D, 0);
+	}
+
 	Texture3D::~Texture3D()
 	{
 		if (m_Texture != 0)
 		{
 			VP_CORE_INFO("Texture3D destroyed: ID={}", m_Texture);
-			glDeleteTextures(1, &m_Texture);
+			DeletionQueue::Enqueue(GLResourceType::Texture, m_Texture);
 			m_Texture = 0;
 		}
 	}
@@ -90,6 +114,7 @@ namespace VizEngine
 		, m_Width(other.m_Width)
 		, m_Height(other.m_Height)
 		, m_Depth(other.m_Depth)
+		, m_InternalFormat(other.m_InternalFormat)
 	{
 		other.m_Texture = 0;
 		other.m_Width = 0;
@@ -103,13 +128,14 @@ namespace VizEngine
 		{
 			if (m_Texture != 0)
 			{
-				glDeleteTextures(1, &m_Texture);
+				DeletionQueue::Enqueue(GLResourceType::Texture, m_Texture);
 			}
 
 			m_Texture = other.m_Texture;
 			m_Width = other.m_Width;
 			m_Height = other.m_Height;
 			m_Depth = other.m_Depth;
+			m_InternalFormat = other.m_InternalFormat;
 
 			other.m_Texture = 0;
 			other.m_Width = 0;
@@ -129,4 +155,12 @@ namespace VizEngine
 	{
 		glBindTexture(GL_TEXTURE_3D, 0);
 	}
+
+	void Texture3D::SetFilter(unsigned int minFilter, unsigned int magFilter)
+	{
+		glBindTexture(GL_TEXTURE_3D, m_Texture);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, minFilter);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, magFilter);
+		glBindTexture(GL_TEXTURE_3D, 0);
+	}
 }
@@ -26,6 +26,17 @@ namespace VizEngine
 		 */
 		Texture3D(int width, int height, int depth, const float* data);
 
+		/**
+		 * Create with any format, e.g. scalar volumes (GL_R8, GL_R16,
+		 * GL_R32F) or images written by compute shaders.
+		 * @param internalFormat OpenGL internal format (e.g., GL_R16)
+		 * @param format OpenGL format of data (e.g., GL_RED)
+		 * @param dataType Data type of data (e.g., GL_UNSIGNED_SHORT)
+		 * @param data Tightly packed texels, or nullptr for uninitialized storage
+		 */
+		Texture3D(int width, int height, int depth, unsigned int internalFormat,
+			unsigned int format, unsigned int dataType, const void* data = nullptr);
+
 		~Texture3D();
 
 		// Non-copyable
@@ -39,7 +50,10 @@ namespace VizEngine
 		void Bind(unsigned int slot = 0) const;
 		void Unbind() const;
 
+		void SetFilter(unsigned int minFilter, unsigned int magFilter);
+
 		unsigned int GetID() const { return m_Texture; }
+		unsigned int GetInternalFormat() const { return m_InternalFormat; }
 		int GetWidth() const { return m_Width; }
 		int GetHeight() const { return m_Height; }
 		int GetDepth() const { return m_Depth; }
@@ -51,5 +65,6 @@ namespace VizEngine
 		int m_Width = 0;
 		int m_Height = 0;
 		int m_Depth = 0;
+		unsigned int m_InternalFormat = GL_RGB16F;
 	};
 }
@@ -0,0 +1,188 @@
+// VizEngine/src/VizEngine/OpenGL/TextureArray.cpp
+
+#include "TextureArray.h"
+#include "Texture.h"
+#include "DeletionQueue.h"
+#include "VizEngine/Log.h"
+
+namespace VizEngine
+{
+	TextureArray::TextureArray(int width, int height, int layers, unsigned int internalFormat, int mipLevels)
+		: m_Width(width), m_Height(height), m_Layers(layers), m_InternalFormat(internalFormat)
+	{
+		if (width <= 0 || height <= 0 || layers <= 0)
+		{
+			VP_CORE_ERROR("TextureArray: invalid size {}x{}x{}", width, height, layers);
+			return;
+		}
+
+		int fullChain = Texture::CalculateMipLevels(width, height);
+		m_MipLevels = (mipLevels <= 0 || mipLevels > fullChain) ? fullChain : mipLevels;
+
+		glGenTextures(1, &m_Texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_MipLevels, internalFormat, width, height, layers);
+
+		// Default state; shared Sampler objects normally override this
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		VP_CORE_INFO("TextureArray created: ID={}, {}x{} x {} layers, {} mips", m_Texture, width, height, layers, m_MipLevels);
+	}
+
+	TextureArray::~TextureArray()
+	{
+		if (m_Texture != 0)
+		{
+			DeletionQueue::Enqueue(GLResourceType::Texture, m_Texture);
+		}
+	}
+
+	TextureArray::TextureArray(TextureArray&& other) noexcept
+		: m_Texture(other.m_Texture)
+		, m_Width(other.m_Width)
+		, m_Height(other.m_Height)
+		, m_Layers(other.m_Layers)
+		, m_MipLevels(other.m_MipLevels)
+		, m_InternalFormat(other.m_InternalFormat)
+	{
+		other.m_Texture = 0;
+		other.m_Layers = 0;
+	}
+
+	TextureArray& TextureArray::operator=(TextureArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_Texture != 0)
+			{
+				DeletionQueue::Enqueue(GLResourceType::Texture, m_Texture);
+			}
+
+			m_Texture = other.m_Texture;
+			m_Width = other.m_Width;
+			m_Height = other.m_Height;
+			m_Layers = other.m_Layers;
+			m_MipLevels = other.m_MipLevels;
+			m_InternalFormat = other.m_InternalFormat;
+
+			other.m_Texture = 0;
+			other.m_Layers = 0;
+		}
+		return *this;
+	}
+
+	int TextureArray::CopyLayer(const Texture& source, int layer)
+	{
+		if (layer < 0 || layer >= m_Layers || source.IsCubemap()
+			|| source.GetWidth() != m_Width || source.GetHeight() != m_Height
+			|| source.GetInternalFormat() != m_InternalFormat)
+		{
+			VP_CORE_ERROR("TextureArray::CopyLayer: source {}x{} (0x{:X}) does not match array {}x{} (0x{:X})",
+				source.GetWidth(), source.GetHeight(), source.GetInternalFormat(),
+				m_Width, m_Height, m_InternalFormat);
+			return 0;
+		}
+
+		int levels = source.GetMipLevels() < m_MipLevels ? source.GetMipLevels() : m_MipLevels;
+		for (int level = 0; level < levels; ++level)
+		{
+			int w = m_Width >> level;
+			int h = m_Height >> level;
+			glCopyImageSubData(
+				source.GetID(), GL_TEXTURE_2D, level, 0, 0, 0,
+				m_Texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+				w > 0 ? w : 1, h > 0 ? h : 1, 1
+			);
+		}
+		return levels;
+	}
+
+	bool TextureArray::CopyRegion(const Texture& source, int layer, int x, int y)
+	{
+		if (layer < 0 || layer >= m_Layers || source.IsCubemap()
+			|| x < 0 || y < 0
+			|| x + source.GetWidth() > m_Width || y + source.GetHeight() > m_Height
+			|| source.GetInternalFormat() != m_InternalFormat)
+		{
+			VP_CORE_ERROR("TextureArray::CopyRegion: source does not fit layer {} at ({}, {})", layer, x, y);
+			return false;
+		}
+
+		glCopyImageSubData(
+			source.GetID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+			m_Texture, GL_TEXTURE_2D_ARRAY, 0, x, y, layer,
+			source.GetWidth(), source.GetHeight(), 1
+		);
+		return true;
+	}
+
+	bool TextureArray::BlitLayer(const Texture& source, int layer)
+	{
+		if (layer < 0 || layer >= m_Layers || source.IsCubemap() || source.GetID() == 0)
+		{
+			VP_CORE_ERROR("TextureArray::BlitLayer: invalid source or layer {}", layer);
+			return false;
+		}
+
+		GLint prevRead = 0, prevDraw = 0;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevRead);
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDraw);
+
+		unsigned int fbos[2] = { 0, 0 };
+		glGenFramebuffers(2, fbos);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, fbos[0]);
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.GetID(), 0);
+
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbos[1]);
+		glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_Texture, 0, layer);
+
+		bool complete = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE
+			&& glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+		if (complete)
+		{
+			glBlitFramebuffer(
+				0, 0, source.GetWidth(), source.GetHeight(),
+				0, 0, m_Width, m_Height,
+				GL_COLOR_BUFFER_BIT, GL_LINEAR
+			);
+		}
+		else
+		{
+			VP_CORE_ERROR("TextureArray::BlitLayer: format 0x{:X} is not blittable", source.GetInternalFormat());
+		}
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevRead));
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(prevDraw));
+		DeletionQueue::Enqueue(GLResourceType::Framebuffer, fbos[0]);
+		DeletionQueue::Enqueue(GLResourceType::Framebuffer, fbos[1]);
+
+		return complete;
+	}
+
+	void TextureArray::GenerateMipmaps()
+	{
+		if (m_MipLevels <= 1) return;
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	void TextureArray::Bind(unsigned int slot) const
+	{
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+	}
+
+	void TextureArray::Unbind() const
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+}
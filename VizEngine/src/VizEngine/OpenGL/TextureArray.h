@@ -0,0 +1,82 @@
+// VizEngine/src/VizEngine/OpenGL/TextureArray.h
+
+#pragma once
+
+#include <glad/glad.h>
+#include "VizEngine/Core.h"
+
+namespace VizEngine
+{
+	class Texture;
+
+	/**
+	 * RAII wrapper for GL_TEXTURE_2D_ARRAY with immutable storage.
+	 *
+	 * Every layer shares one size, format and mip count, so a single binding
+	 * gives a shader access to many textures selected by layer index.
+	 */
+	class VizEngine_API TextureArray
+	{
+	public:
+		/**
+		 * Allocate storage for all layers and mip levels.
+		 * @param width Layer width
+		 * @param height Layer height
+		 * @param layers Number of layers
+		 * @param internalFormat Sized internal format (e.g., GL_RGBA8)
+		 * @param mipLevels Mip levels to allocate (0 = full chain)
+		 */
+		TextureArray(int width, int height, int layers, unsigned int internalFormat, int mipLevels = 0);
+		~TextureArray();
+
+		// Non-copyable
+		TextureArray(const TextureArray&) = delete;
+		TextureArray& operator=(const TextureArray&) = delete;
+
+		// Movable
+		TextureArray(TextureArray&& other) noexcept;
+		TextureArray& operator=(TextureArray&& other) noexcept;
+
+		/**
+		 * Copy a same-size, same-format 2D texture into a layer (GPU-side copy).
+		 * Copies min(source, array) mip levels.
+		 * @return Number of mip levels copied (0 on mismatch)
+		 */
+		int CopyLayer(const Texture& source, int layer);
+
+		/**
+		 * Copy a 2D texture's base level into a sub-rectangle of a layer.
+		 * Used for atlas packing; formats must be copy-compatible.
+		 */
+		bool CopyRegion(const Texture& source, int layer, int x, int y);
+
+		/**
+		 * Scale a 2D texture's base level into a whole layer with a linear blit.
+		 * Both formats must be color-renderable.
+		 */
+		bool BlitLayer(const Texture& source, int layer);
+
+		/**
+		 * Rebuild all mip levels from level 0 (every layer).
+		 */
+		void GenerateMipmaps();
+
+		void Bind(unsigned int slot = 0) const;
+		void Unbind() const;
+
+		inline unsigned int GetID() const { return m_Texture; }
+		inline int GetWidth() const { return m_Width; }
+		inline int GetHeight() const { return m_Height; }
+		inline int GetLayers() const { return m_Layers; }
+		inline int GetMipLevels() const { return m_MipLevels; }
+		inline unsigned int GetInternalFormat() const { return m_InternalFormat; }
+
+	private:
+		unsigned int m_Texture = 0;
+		int m_Width = 0;
+		int m_Height = 0;
+		int m_Layers = 0;
+		int m_MipLevels = 1;
+		unsigned int m_InternalFormat = 0;
+	};
+}
@@ -1,4 +1,5 @@
 #include "VertexArray.h"
+#include "DeletionQueue.h"
 
 namespace VizEngine
 {
@@ -13,7 +14,7 @@ namespace VizEngine
 	{
 		if (m_vao != 0)
 		{
-			glDeleteVertexArrays(1, &m_vao);
+			DeletionQueue::Enqueue(GLResourceType::VertexArray, m_vao);
 		}
 	}
 
@@ -31,7 +32,7 @@ namespace VizEngine
 		{
 			if (m_vao != 0)
 			{
-				glDeleteVertexArrays(1, &m_vao);
+				DeletionQueue::Enqueue(GLResourceType::VertexArray, m_vao);
 			}
 			m_vao = other.m_vao;
 			other.m_vao = 0;
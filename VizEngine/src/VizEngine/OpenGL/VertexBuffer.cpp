@@ -1,4 +1,5 @@
 #include "VertexBuffer.h"
+#include "DeletionQueue.h"
 
 namespace VizEngine
 {
@@ -15,7 +16,7 @@ namespace VizEngine
 	{
 		if (m_vbo != 0)
 		{
-			glDeleteBuffers(1, &m_vbo);
+			DeletionQueue::Enqueue(GLResourceType::Buffer, m_vbo);
 		}
 	}
 
@@ -33,7 +34,7 @@ namespace VizEngine
 		{
 			if (m_vbo != 0)
 			{
-				glDeleteBuffers(1, &m_vbo);
+				DeletionQueue::Enqueue(GLResourceType::Buffer, m_vbo);
 			}
 			m_vbo = other.m_vbo;
 			other.m_vbo = 0;
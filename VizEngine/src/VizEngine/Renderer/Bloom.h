@@ -44,6 +44,8 @@ namespace VizEngine
 		float GetKnee() const { return m_Knee; }
 		float GetIntensity() const { return m_Intensity; }
 		int GetBlurPasses() const { return m_BlurPasses; }
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
 
 		// Validation
 		bool IsValid() const { return m_IsValid; }
@@ -0,0 +1,181 @@
+// VizEngine/src/VizEngine/Renderer/Downsampler.cpp
+
+#include "Downsampler.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// Limits of the shader: 6 levels per workgroup tile, 6 more in the last workgroup
+		constexpr int MaxMipsPerDispatch = 12;
+		constexpr int TileSize = 64;       // Source texels per workgroup side
+		constexpr int MaxGroupGrid = 64;   // Mip-6 grid the last workgroup can reduce (sources up to 4096)
+		constexpr size_t GlobalHeaderBytes = 16;
+
+		bool IsImageFormat(unsigned int internalFormat)
+		{
+			switch (internalFormat)
+			{
+			case GL_RGBA32F:
+			case GL_RGBA16F:
+			case GL_RG32F:
+			case GL_RG16F:
+			case GL_R32F:
+			case GL_R16F:
+			case GL_R11F_G11F_B10F:
+			case GL_RGBA8:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		int LevelSize(int size, int level)
+		{
+			return std::max(1, size >> level);
+		}
+	}
+
+	Downsampler::Downsampler()
+	{
+		int computeImages = 0;
+		int imageUnits = 0;
+		glGetIntegerv(GL_MAX_COMPUTE_IMAGE_UNIFORMS, &computeImages);
+		glGetIntegerv(GL_MAX_IMAGE_UNITS, &imageUnits);
+		m_MaxImages = std::min({ MaxMipsPerDispatch + 1, computeImages, imageUnits });
+
+		if (m_MaxImages < 2)
+		{
+			VP_CORE_ERROR("Downsampler: driver exposes {} image units, need at least 2", m_MaxImages);
+			return;
+		}
+
+		std::string defines = "#define SPD_MAX_IMAGES " + std::to_string(m_MaxImages) + "\n";
+		auto shader = std::make_unique<Shader>("resources/shaders/spd_downsample.shader", defines);
+		if (!shader->IsValid())
+		{
+			VP_CORE_ERROR("Downsampler: failed to load spd_downsample.shader");
+			return;
+		}
+		m_Shader = std::move(shader);
+
+		// Counter starts at zero; the last workgroup of every dispatch resets it
+		std::vector<uint8_t> zeros(GlobalHeaderBytes + sizeof(float) * 4 * MaxGroupGrid * MaxGroupGrid, 0);
+		m_Global = std::make_unique<ShaderStorageBuffer>(zeros.data(), zeros.size(), GL_DYNAMIC_COPY);
+
+		VP_CORE_INFO("Downsampler: up to {} levels per dispatch", std::min(MaxMipsPerDispatch, m_MaxImages));
+	}
+
+	Downsampler::~Downsampler() = default;
+
+	bool Downsampler::Generate(Texture& texture, DownsampleReduction reduction)
+	{
+		return Run(texture, texture, false, reduction);
+	}
+
+	bool Downsampler::GenerateFrom(const Texture& source, Texture& destination, DownsampleReduction reduction)
+	{
+		if (source.GetWidth() != destination.GetWidth() || source.GetHeight() != destination.GetHeight())
+		{
+			VP_CORE_ERROR("Downsampler: source {}x{} and destination {}x{} differ",
+				source.GetWidth(), source.GetHeight(), destination.GetWidth(), destination.GetHeight());
+			return false;
+		}
+		return Run(source, destination, true, reduction);
+	}
+
+	bool Downsampler::Run(const Texture& source, Texture& destination, bool copySource, DownsampleReduction reduction)
+	{
+		m_LastDispatchCount = 0;
+		if (!IsValid()) return false;
+
+		if (source.IsCubemap() || destination.IsCubemap())
+		{
+			VP_CORE_ERROR("Downsampler: cubemaps are not supported");
+			return false;
+		}
+		if (!IsImageFormat(destination.GetInternalFormat()))
+		{
+			VP_CORE_ERROR("Downsampler: internal format 0x{:X} cannot be written from compute",
+				destination.GetInternalFormat());
+			return false;
+		}
+
+		const int levels = destination.GetMipLevels();
+		if (levels <= 1 && !copySource) return true;
+
+		const int width = destination.GetWidth();
+		const int height = destination.GetHeight();
+
+		m_Shader->Bind();
+		m_Shader->SetInt("u_Source", TextureSlots::Custom0);
+		m_Shader->SetInt("u_Reduction", static_cast<int>(reduction));
+		m_Global->BindBase(0);
+
+		const Texture* input = &source;
+		int sourceLevel = 0;
+		bool copy = copySource;
+
+		for (;;)
+		{
+			int remaining = levels - 1 - sourceLevel;
+			if (remaining <= 0 && !copy) break;
+
+			int sourceWidth = LevelSize(width, sourceLevel);
+			int sourceHeight = LevelSize(height, sourceLevel);
+			int groupsX = (sourceWidth + TileSize - 1) / TileSize;
+			int groupsY = (sourceHeight + TileSize - 1) / TileSize;
+
+			// The second half (mips 7-12) needs the whole mip-6 grid in one workgroup
+			int perDispatch = (groupsX <= MaxGroupGrid && groupsY <= MaxGroupGrid) ? MaxMipsPerDispatch : 6;
+			perDispatch = std::min(perDispatch, m_MaxImages - (copy ? 1 : 0));
+			int mipCount = std::min(perDispatch, remaining);   // 0 = copy only
+
+			// Bind destination levels; unused slots of the array alias the last level
+			int firstOutput = copy ? sourceLevel : sourceLevel + 1;
+			for (int i = 0; i < m_MaxImages; i++)
+			{
+				int level = std::min(firstOutput + i, levels - 1);
+				glBindImageTexture(i, destination.GetID(), level, GL_FALSE, 0, GL_WRITE_ONLY, destination.GetInternalFormat());
+			}
+
+			input->Bind(TextureSlots::Custom0);
+			m_Shader->SetInt("u_SourceLevel", sourceLevel);
+			m_Shader->SetIVec2("u_SourceSize", sourceWidth, sourceHeight);
+			m_Shader->SetIVec2("u_GroupCount", groupsX, groupsY);
+			m_Shader->SetInt("u_MipCount", mipCount);
+			m_Shader->SetBool("u_CopySource", copy);
+
+			glDispatchCompute(static_cast<unsigned int>(groupsX), static_cast<unsigned int>(groupsY), 1);
+			m_LastDispatchCount++;
+
+			// The next dispatch samples what this one wrote
+			glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+			sourceLevel += mipCount;
+			input = &destination;
+			copy = false;
+		}
+
+		// Anything that renders to or samples the chain afterwards
+		glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		for (int i = 0; i < m_MaxImages; i++)
+		{
+			glBindImageTexture(i, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		m_Shader->Unbind();
+		return true;
+	}
+}
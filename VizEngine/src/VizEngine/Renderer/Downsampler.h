@@ -0,0 +1,83 @@
+// VizEngine/src/VizEngine/Renderer/Downsampler.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstdint>
+#include <memory>
+
+namespace VizEngine
+{
+	class Shader;
+	class ShaderStorageBuffer;
+	class Texture;
+
+	/**
+	 * How each 2x2 block is combined into the next mip level.
+	 */
+	enum class DownsampleReduction : uint8_t
+	{
+		Average,   // Color mip chains, bloom downsampling
+		Min,       // Hi-Z with reversed depth / nearest-occluder pyramids
+		Max        // Hi-Z with standard depth (farthest occluder per texel)
+	};
+
+	/**
+	 * Single-pass mip chain generation in compute.
+	 *
+	 * One dispatch produces up to 12 levels: each workgroup reduces a 64x64
+	 * tile to one texel in shared memory, and the last workgroup to finish
+	 * (found with an atomic counter) reduces the remaining grid. This replaces
+	 * glGenerateMipmap for render targets and builds hierarchical-Z pyramids
+	 * without a pass per level.
+	 *
+	 * Destinations must be 2D textures with an image-compatible internal
+	 * format (RGBA16F, RGBA32F, R32F, R16F, RG16F, RG32F, R11F_G11F_B10F,
+	 * RGBA8) and their mip levels allocated (Texture::AllocateMipLevels).
+	 * Chains longer than one dispatch can cover (source over 4096 texels, or
+	 * fewer than 12 image units on the driver) are split into more dispatches.
+	 *
+	 * Usage:
+	 *   Downsampler downsampler;
+	 *   target->AllocateMipLevels();
+	 *   downsampler.Generate(*target);                          // Color mips
+	 *   downsampler.GenerateFrom(*depth, *hiZ, DownsampleReduction::Max);   // Hi-Z
+	 */
+	class VizEngine_API Downsampler
+	{
+	public:
+		Downsampler();
+		~Downsampler();
+
+		Downsampler(const Downsampler&) = delete;
+		Downsampler& operator=(const Downsampler&) = delete;
+
+		/**
+		 * Fill levels 1..GetMipLevels()-1 of a texture from its level 0.
+		 * @return false if the texture cannot be written (logged)
+		 */
+		bool Generate(Texture& texture, DownsampleReduction reduction = DownsampleReduction::Average);
+
+		/**
+		 * Copy source level 0 into destination level 0, then fill the
+		 * destination's remaining levels. The source may be any sampleable
+		 * 2D texture of the same size (e.g. a depth attachment for Hi-Z).
+		 * @return false on size/format mismatch (logged)
+		 */
+		bool GenerateFrom(const Texture& source, Texture& destination,
+			DownsampleReduction reduction = DownsampleReduction::Max);
+
+		bool IsValid() const { return m_Shader != nullptr; }
+
+		/** @return Dispatches issued by the last Generate/GenerateFrom call */
+		int GetLastDispatchCount() const { return m_LastDispatchCount; }
+
+	private:
+		bool Run(const Texture& source, Texture& destination, bool copySource, DownsampleReduction reduction);
+
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<ShaderStorageBuffer> m_Global;   // Atomic counter + mip-6 texels
+		int m_MaxImages = 0;                             // Destination levels bindable per dispatch
+		int m_LastDispatchCount = 0;
+	};
+}
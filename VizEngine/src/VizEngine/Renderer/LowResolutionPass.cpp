@@ -0,0 +1,197 @@
+// VizEngine/src/VizEngine/Renderer/LowResolutionPass.cpp
+
+#include "LowResolutionPass.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/VertexArray.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+namespace VizEngine
+{
+	LowResolutionPass::LowResolutionPass(int width, int height, LowResolutionScale scale)
+		: m_FullWidth(width), m_FullHeight(height), m_Scale(scale)
+	{
+		m_DepthShader = std::make_unique<Shader>("resources/shaders/lowres_depth.shader");
+		m_CompositeShader = std::make_unique<Shader>("resources/shaders/lowres_composite.shader");
+		if (!m_DepthShader->IsValid() || !m_CompositeShader->IsValid())
+		{
+			VP_CORE_ERROR("LowResolutionPass: Failed to load shaders!");
+			return;
+		}
+
+		m_EmptyVAO = std::make_unique<VertexArray>();
+		CreateTargets();
+	}
+
+	LowResolutionPass::~LowResolutionPass() = default;
+
+	void LowResolutionPass::Resize(int width, int height)
+	{
+		if (width == m_FullWidth && height == m_FullHeight) return;
+		if (width <= 0 || height <= 0) return;
+
+		m_FullWidth = width;
+		m_FullHeight = height;
+		if (m_DepthShader && m_DepthShader->IsValid())
+		{
+			CreateTargets();
+		}
+	}
+
+	void LowResolutionPass::SetScale(LowResolutionScale scale)
+	{
+		if (scale == m_Scale) return;
+
+		m_Scale = scale;
+		if (m_DepthShader && m_DepthShader->IsValid())
+		{
+			CreateTargets();
+		}
+	}
+
+	void LowResolutionPass::CreateTargets()
+	{
+		m_IsValid = false;
+
+		// Round up so the last partial block still has a texel
+		const int divisor = static_cast<int>(m_Scale);
+		m_Width = (m_FullWidth + divisor - 1) / divisor;
+		m_Height = (m_FullHeight + divisor - 1) / divisor;
+
+		m_ColorTexture = std::make_shared<Texture>(
+			m_Width, m_Height, GL_RGBA16F, GL_RGBA, GL_FLOAT
+		);
+		m_ColorTexture->SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+
+		// Fetched per texel by the composite, never filtered
+		m_DepthTexture = std::make_shared<Texture>(
+			m_Width, m_Height, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT
+		);
+		m_DepthTexture->SetFilter(GL_NEAREST, GL_NEAREST);
+
+		m_Framebuffer = std::make_unique<Framebuffer>(m_Width, m_Height);
+		m_Framebuffer->AttachColorTexture(m_ColorTexture, 0);
+		m_Framebuffer->AttachDepthTexture(m_DepthTexture);
+
+		if (!m_Framebuffer->IsComplete())
+		{
+			VP_CORE_ERROR("LowResolutionPass: Framebuffer not complete!");
+			return;
+		}
+
+		m_IsValid = true;
+		VP_CORE_INFO("LowResolutionPass: {}x{} (1/{} of {}x{})", m_Width, m_Height, divisor, m_FullWidth, m_FullHeight);
+	}
+
+	bool LowResolutionPass::Begin(const Texture& fullDepth, const glm::mat4& projection)
+	{
+		if (!m_IsValid) return false;
+
+		if (m_Active)
+		{
+			VP_CORE_WARN("LowResolutionPass::Begin called while the pass is active");
+			return false;
+		}
+
+		if (fullDepth.GetWidth() != m_FullWidth || fullDepth.GetHeight() != m_FullHeight)
+		{
+			VP_CORE_ERROR("LowResolutionPass: depth is {}x{}, pass expects {}x{}",
+				fullDepth.GetWidth(), fullDepth.GetHeight(), m_FullWidth, m_FullHeight);
+			return false;
+		}
+
+		m_Active = true;
+		m_FullDepth = &fullDepth;
+		m_DepthParams = glm::vec2(projection[2][2], projection[3][2]);
+
+		glGetIntegerv(GL_VIEWPORT, m_SavedViewport);
+
+		m_Framebuffer->Bind();
+		glViewport(0, 0, m_Width, m_Height);
+
+		// Depth reduction: farthest depth of each block, depth only
+		glDisable(GL_BLEND);
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_ALWAYS);
+		glDepthMask(GL_TRUE);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+		m_DepthShader->Bind();
+		fullDepth.Bind(TextureSlots::Custom0);
+		m_DepthShader->SetInt("u_FullDepth", TextureSlots::Custom0);
+		m_DepthShader->SetInt("u_Scale", static_cast<int>(m_Scale));
+
+		m_EmptyVAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+		// Nothing drawn yet: no color, full transmittance
+		float clear[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		glClearBufferfv(GL_COLOR, 0, clear);
+
+		// Blended draws: rgb = src * a + dst * (1 - a), alpha = dst * (1 - a)
+		glDepthFunc(GL_LESS);
+		glDepthMask(GL_FALSE);
+		glEnable(GL_BLEND);
+		glBlendEquation(GL_FUNC_ADD);
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+
+		return true;
+	}
+
+	void LowResolutionPass::End()
+	{
+		if (!m_Active) return;
+		m_Active = false;
+
+		// Restore the state the renderer expects
+		m_Framebuffer->Unbind();
+		glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_BLEND);
+		glDepthMask(GL_TRUE);
+	}
+
+	void LowResolutionPass::Composite()
+	{
+		if (!m_IsValid || !m_FullDepth) return;
+
+		if (m_Active)
+		{
+			VP_CORE_WARN("LowResolutionPass::Composite called before End()");
+			return;
+		}
+
+		// Reads the full-resolution depth, which may be attached to the bound
+		// framebuffer: no depth test or writes, so there is no feedback loop
+		glDisable(GL_DEPTH_TEST);
+		glDepthMask(GL_FALSE);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_SRC_ALPHA);   // dst = color + dst * transmittance
+
+		m_CompositeShader->Bind();
+		m_ColorTexture->Bind(TextureSlots::Custom0);
+		m_DepthTexture->Bind(TextureSlots::Custom1);
+		m_FullDepth->Bind(TextureSlots::Custom2);
+		m_CompositeShader->SetInt("u_LowColor", TextureSlots::Custom0);
+		m_CompositeShader->SetInt("u_LowDepth", TextureSlots::Custom1);
+		m_CompositeShader->SetInt("u_FullDepth", TextureSlots::Custom2);
+		m_CompositeShader->SetInt("u_Scale", static_cast<int>(m_Scale));
+		m_CompositeShader->SetInt("u_Mode", static_cast<int>(m_Upsample));
+		m_CompositeShader->SetFloat("u_DepthThreshold", m_DepthThreshold);
+		m_CompositeShader->SetVec2("u_DepthParams", m_DepthParams);
+
+		m_EmptyVAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_BLEND);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_DEPTH_TEST);
+	}
+}
@@ -0,0 +1,135 @@
+// VizEngine/src/VizEngine/Renderer/LowResolutionPass.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace VizEngine
+{
+	class Framebuffer;
+	class Shader;
+	class Texture;
+	class VertexArray;
+
+	/**
+	 * Resolution divisor of the reduced-resolution target.
+	 */
+	enum class LowResolutionScale : uint8_t
+	{
+		Half = 2,
+		Quarter = 4
+	};
+
+	/**
+	 * How the reduced-resolution result is brought back to full resolution.
+	 */
+	enum class LowResolutionUpsample : uint8_t
+	{
+		Bilinear,       // Plain filtering; halos where foreground edges cut through
+		Bilateral,      // Bilinear weights scaled by depth similarity
+		NearestDepth    // Bilinear where depths agree, else the texel closest in depth
+	};
+
+	/**
+	 * Renders low-frequency blended content (transparents, particles,
+	 * volumetrics) at half or quarter resolution and composites it into a
+	 * full-resolution HDR target.
+	 *
+	 * Begin() reduces the full-resolution depth to the small target (the
+	 * farthest depth of each block, so nothing is wrongly occluded inside a
+	 * block) and sets up blending that accumulates premultiplied color in
+	 * rgb and transmittance in alpha. Draws between Begin() and End() are
+	 * depth tested against it without writing depth, back to front, with
+	 * the usual source-alpha shaders. Composite() then applies
+	 * dst = color + dst * transmittance, with depth-aware upsampling to keep
+	 * foreground edges sharp.
+	 *
+	 * Usage:
+	 *   lowRes.Begin(*hdrDepth, projection);
+	 *   for (each opted-in transparent, back to front) draw;
+	 *   lowRes.End();
+	 *   hdrFramebuffer->Bind();
+	 *   lowRes.Composite();
+	 */
+	class VizEngine_API LowResolutionPass
+	{
+	public:
+		/**
+		 * @param width Full-resolution width
+		 * @param height Full-resolution height
+		 */
+		LowResolutionPass(int width, int height, LowResolutionScale scale = LowResolutionScale::Half);
+		~LowResolutionPass();
+
+		LowResolutionPass(const LowResolutionPass&) = delete;
+		LowResolutionPass& operator=(const LowResolutionPass&) = delete;
+
+		bool IsValid() const { return m_IsValid; }
+
+		/**
+		 * Recreate the targets for a new full resolution or scale.
+		 */
+		void Resize(int width, int height);
+		void SetScale(LowResolutionScale scale);
+
+		/**
+		 * Reduce the depth, then bind and clear the small target.
+		 * @param fullDepth Full-resolution depth (depth or depth-stencil texture)
+		 * @param projection Perspective projection the depth was rendered with
+		 * @return false if the pass is invalid or the depth size does not match
+		 */
+		bool Begin(const Texture& fullDepth, const glm::mat4& projection);
+
+		/**
+		 * Restore the viewport and blend/depth state the renderer expects.
+		 */
+		void End();
+
+		/**
+		 * Blend the result into the bound full-resolution framebuffer.
+		 * Uses the depth texture and projection of the last Begin().
+		 */
+		void Composite();
+
+		// Settings
+		void SetUpsample(LowResolutionUpsample mode) { m_Upsample = mode; }
+		void SetDepthThreshold(float threshold) { m_DepthThreshold = threshold; }
+
+		LowResolutionScale GetScale() const { return m_Scale; }
+		LowResolutionUpsample GetUpsample() const { return m_Upsample; }
+		float GetDepthThreshold() const { return m_DepthThreshold; }
+
+		std::shared_ptr<Texture> GetColorTexture() const { return m_ColorTexture; }
+		std::shared_ptr<Texture> GetDepthTexture() const { return m_DepthTexture; }
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+
+	private:
+		void CreateTargets();
+
+		int m_FullWidth = 0;
+		int m_FullHeight = 0;
+		int m_Width = 0;
+		int m_Height = 0;
+		LowResolutionScale m_Scale = LowResolutionScale::Half;
+		LowResolutionUpsample m_Upsample = LowResolutionUpsample::NearestDepth;
+		float m_DepthThreshold = 0.1f;   // Relative view-depth difference treated as an edge
+		bool m_IsValid = false;
+
+		std::shared_ptr<Texture> m_ColorTexture;   // RGBA16F: premultiplied color, transmittance
+		std::shared_ptr<Texture> m_DepthTexture;
+		std::unique_ptr<Framebuffer> m_Framebuffer;
+
+		std::unique_ptr<Shader> m_DepthShader;
+		std::unique_ptr<Shader> m_CompositeShader;
+		std::unique_ptr<VertexArray> m_EmptyVAO;   // For attribute-less full-screen triangles
+
+		const Texture* m_FullDepth = nullptr;      // From the last Begin()
+		glm::vec2 m_DepthParams = glm::vec2(0.0f); // Projection terms that linearize depth
+		bool m_Active = false;
+		int m_SavedViewport[4] = { 0, 0, 0, 0 };
+	};
+}
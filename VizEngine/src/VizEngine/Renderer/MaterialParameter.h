@@ -34,12 +34,13 @@ namespace VizEngine
     struct VizEngine_API TextureSlot
     {
         std::string UniformName;            // e.g., "u_AlbedoTexture"
-        std::shared_ptr<Texture> TextureRef;
+        std::shared_ptr<Texture> TextureRef;     // Owning reference (null for borrowed textures)
+        const Texture* Bound = nullptr;     // Bound by BindTextures; TextureRef.get() unless borrowed
         int Slot = 0;                       // Texture unit (0-15)
         bool IsCubemap = false;             // True if texture is a cubemap
 
         TextureSlot() = default;
-        TextureSlot(const std::string& name, std::shared_ptr<Texture> tex, int slot, bool isCube = false)
-            : UniformName(name), TextureRef(tex), Slot(slot), IsCubemap(isCube) {}
+        TextureSlot(const std::string& name, const std::shared_ptr<Texture>& tex, int slot, bool isCube = false)
+            : UniformName(name), TextureRef(tex), Bound(tex.get()), Slot(slot), IsCubemap(isCube) {}
     };
 }
@@ -0,0 +1,467 @@
+// VizEngine/src/VizEngine/Renderer/MaterialTexturePacker.cpp
+
+#include "MaterialTexturePacker.h"
+#include "VizEngine/Core/Material.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/TextureArray.h"
+#include "VizEngine/OpenGL/Sampler.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace VizEngine
+{
+    namespace
+    {
+        constexpr size_t kKindCount = static_cast<size_t>(PackedTextureKind::Count);
+
+        // Texture unit and sampler uniform for each PackedTextureKind
+        constexpr int kKindSlots[kKindCount] = {
+            TextureSlots::Albedo,
+            TextureSlots::Normal,
+            TextureSlots::MetallicRoughness,
+            TextureSlots::AO,
+            TextureSlots::Emissive
+        };
+
+        const char* const kKindUniforms[kKindCount] = {
+            "u_BaseColorPool",
+            "u_NormalPool",
+            "u_MetallicRoughnessPool",
+            "u_OcclusionPool",
+            "u_EmissivePool"
+        };
+
+        const PackedTextureRef kNoTexture{};
+
+        bool IsRenderableColorFormat(unsigned int format)
+        {
+            switch (format)
+            {
+            case GL_R8: case GL_RG8: case GL_RGB8: case GL_RGBA8:
+            case GL_SRGB8_ALPHA8: case GL_RGB16F: case GL_RGBA16F:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        int MaxArrayLayers()
+        {
+            GLint maxLayers = 256;
+            glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+            return maxLayers > 0 ? maxLayers : 256;
+        }
+    }
+
+    MaterialTexturePacker::MaterialTexturePacker(const TexturePackerSettings& settings)
+        : m_Settings(settings)
+    {
+    }
+
+    MaterialTexturePacker::~MaterialTexturePacker() = default;
+
+    uint32_t MaterialTexturePacker::AddMaterial(const Material& material)
+    {
+        if (m_Built)
+        {
+            VP_CORE_WARN("MaterialTexturePacker: AddMaterial after Build(), call Build() again to repack");
+            m_Built = false;
+        }
+
+        MaterialEntry entry;
+        entry.BaseColor = material.BaseColor;
+        entry.Params = glm::vec4(material.Metallic, material.Roughness, material.AO,
+            material.Alpha == Material::AlphaMode::Mask ? material.AlphaCutoff : 0.0f);
+        entry.Emissive = material.EmissiveFactor;
+
+        entry.Sources[static_cast<size_t>(PackedTextureKind::BaseColor)] = material.BaseColorTexture;
+        entry.Sources[static_cast<size_t>(PackedTextureKind::Normal)] = material.NormalTexture;
+        entry.Sources[static_cast<size_t>(PackedTextureKind::MetallicRoughness)] = material.MetallicRoughnessTexture;
+        // ORM: occlusion is read from the metallic-roughness fetch, no separate layer
+        entry.PackedORM = material.HasPackedORM();
+        if (!entry.PackedORM)
+        {
+            entry.Sources[static_cast<size_t>(PackedTextureKind::Occlusion)] = material.OcclusionTexture;
+        }
+        entry.Sources[static_cast<size_t>(PackedTextureKind::Emissive)] = material.EmissiveTexture;
+
+        m_Materials.push_back(std::move(entry));
+        return static_cast<uint32_t>(m_Materials.size() - 1);
+    }
+
+    bool MaterialTexturePacker::Build()
+    {
+        if (m_SourcesReleased)
+        {
+            VP_CORE_ERROR("MaterialTexturePacker::Build: source textures were released, cannot repack");
+            return false;
+        }
+
+        m_Pools.clear();
+        m_TextureRefs.clear();
+
+        // Gather unique, packable textures and split by destination
+        std::vector<const Texture*> arrayTextures;
+        std::vector<const Texture*> atlasTextures;
+
+        for (const auto& material : m_Materials)
+        {
+            for (const auto& source : material.Sources)
+            {
+                if (!source || m_TextureRefs.count(source.get())) continue;
+
+                m_TextureRefs[source.get()] = PackedTextureRef{};
+
+                if (source->GetID() == 0 || source->IsCubemap() || source->GetInternalFormat() == 0)
+                {
+                    VP_CORE_WARN("MaterialTexturePacker: skipping unpackable texture (ID={})", source->GetID());
+                    continue;
+                }
+
+                int largest = std::max(source->GetWidth(), source->GetHeight());
+                if (largest <= m_Settings.AtlasMaxSize
+                    && largest + m_Settings.AtlasPadding * 2 <= m_Settings.AtlasPageSize)
+                {
+                    atlasTextures.push_back(source.get());
+                }
+                else
+                {
+                    arrayTextures.push_back(source.get());
+                }
+            }
+        }
+
+        bool ok = PackArrays(arrayTextures);
+        ok = PackAtlases(atlasTextures) && ok;
+
+        // Resolve each material's references
+        for (auto& material : m_Materials)
+        {
+            for (size_t k = 0; k < kKindCount; ++k)
+            {
+                const auto& source = material.Sources[k];
+                material.Refs[k] = source ? m_TextureRefs[source.get()] : PackedTextureRef{};
+            }
+        }
+
+        if (!m_ArraySampler)
+        {
+            SamplerDesc arrayDesc;
+            arrayDesc.MaxAnisotropy = m_Settings.MaxAnisotropy;
+            m_ArraySampler = std::make_unique<Sampler>(arrayDesc);
+
+            SamplerDesc atlasDesc = arrayDesc;
+            atlasDesc.WrapS = GL_CLAMP_TO_EDGE;
+            atlasDesc.WrapT = GL_CLAMP_TO_EDGE;
+            m_AtlasSampler = std::make_unique<Sampler>(atlasDesc);
+        }
+
+        UploadMaterialTable();
+
+        m_Built = true;
+        VP_CORE_INFO("MaterialTexturePacker: {} materials, {} textures -> {} pools",
+            m_Materials.size(), m_TextureRefs.size(), m_Pools.size());
+        return ok;
+    }
+
+    bool MaterialTexturePacker::PackArrays(const std::vector<const Texture*>& textures)
+    {
+        // Group by (width, height, format); with UniformLayerSize, by format only
+        using GroupKey = std::tuple<int, int, unsigned int>;
+        std::map<GroupKey, std::vector<const Texture*>> groups;
+
+        const int uniform = m_Settings.UniformLayerSize;
+        for (const Texture* texture : textures)
+        {
+            bool rescale = uniform > 0 && IsRenderableColorFormat(texture->GetInternalFormat());
+            GroupKey key = rescale
+                ? GroupKey(uniform, uniform, texture->GetInternalFormat())
+                : GroupKey(texture->GetWidth(), texture->GetHeight(), texture->GetInternalFormat());
+            groups[key].push_back(texture);
+        }
+
+        const int maxLayers = MaxArrayLayers();
+        bool ok = true;
+
+        for (const auto& [key, members] : groups)
+        {
+            const auto [width, height, format] = key;
+
+            for (size_t first = 0; first < members.size(); first += static_cast<size_t>(maxLayers))
+            {
+                size_t count = std::min(members.size() - first, static_cast<size_t>(maxLayers));
+
+                Pool pool;
+                pool.Array = std::make_unique<TextureArray>(width, height, static_cast<int>(count), format);
+                if (pool.Array->GetID() == 0)
+                {
+                    ok = false;
+                    continue;
+                }
+
+                int poolIndex = static_cast<int>(m_Pools.size());
+                bool needsMips = false;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const Texture* texture = members[first + i];
+                    int layer = static_cast<int>(i);
+                    bool copied = false;
+
+                    if (texture->GetWidth() == width && texture->GetHeight() == height)
+                    {
+                        int levels = pool.Array->CopyLayer(*texture, layer);
+                        copied = levels > 0;
+                        needsMips |= levels < pool.Array->GetMipLevels();
+                    }
+                    else
+                    {
+                        copied = pool.Array->BlitLayer(*texture, layer);
+                        needsMips = true;
+                    }
+
+                    if (copied)
+                    {
+                        m_TextureRefs[texture] = PackedTextureRef{ poolIndex, layer, glm::vec4(1, 1, 0, 0) };
+                    }
+                    else
+                    {
+                        ok = false;
+                    }
+                }
+
+                if (needsMips)
+                {
+                    pool.Array->GenerateMipmaps();
+                }
+
+                m_Pools.push_back(std::move(pool));
+            }
+        }
+
+        return ok;
+    }
+
+    bool MaterialTexturePacker::PackAtlases(const std::vector<const Texture*>& textures)
+    {
+        if (textures.empty()) return true;
+
+        const int page = m_Settings.AtlasPageSize;
+        const int padding = m_Settings.AtlasPadding;
+
+        // Group by format, tallest first for tighter shelves
+        std::map<unsigned int, std::vector<const Texture*>> groups;
+        for (const Texture* texture : textures)
+        {
+            groups[texture->GetInternalFormat()].push_back(texture);
+        }
+
+        // Mips past log2(padding) would blend neighbouring entries
+        int atlasMips = 1;
+        for (int p = padding; p > 1; p >>= 1)
+        {
+            atlasMips++;
+        }
+
+        bool ok = true;
+
+        for (auto& [format, members] : groups)
+        {
+            std::sort(members.begin(), members.end(), [](const Texture* a, const Texture* b) {
+                return a->GetHeight() > b->GetHeight();
+            });
+
+            // Shelf packing: rows of entries, new page when a page fills
+            struct Placement { const Texture* Source; int Layer; int X; int Y; };
+            std::vector<Placement> placements;
+            placements.reserve(members.size());
+
+            int layer = 0, cursorX = padding, cursorY = padding, shelfHeight = 0;
+            for (const Texture* texture : members)
+            {
+                int w = texture->GetWidth();
+                int h = texture->GetHeight();
+
+                if (cursorX + w + padding > page)
+                {
+                    cursorX = padding;
+                    cursorY += shelfHeight + padding;
+                    shelfHeight = 0;
+                }
+                if (cursorY + h + padding > page)
+                {
+                    layer++;
+                    cursorX = padding;
+                    cursorY = padding;
+                    shelfHeight = 0;
+                }
+
+                placements.push_back({ texture, layer, cursorX, cursorY });
+                cursorX += w + padding;
+                shelfHeight = std::max(shelfHeight, h);
+            }
+
+            Pool pool;
+            pool.IsAtlas = true;
+            pool.Array = std::make_unique<TextureArray>(page, page, layer + 1, format, atlasMips);
+            if (pool.Array->GetID() == 0)
+            {
+                ok = false;
+                continue;
+            }
+
+            int poolIndex = static_cast<int>(m_Pools.size());
+            const float invPage = 1.0f / static_cast<float>(page);
+
+            for (const auto& placement : placements)
+            {
+                if (!pool.Array->CopyRegion(*placement.Source, placement.Layer, placement.X, placement.Y))
+                {
+                    ok = false;
+                    continue;
+                }
+
+                glm::vec4 uvTransform(
+                    placement.Source->GetWidth() * invPage,
+                    placement.Source->GetHeight() * invPage,
+                    placement.X * invPage,
+                    placement.Y * invPage
+                );
+                m_TextureRefs[placement.Source] = PackedTextureRef{ poolIndex, placement.Layer, uvTransform };
+            }
+
+            pool.Array->GenerateMipmaps();
+            m_Pools.push_back(std::move(pool));
+        }
+
+        return ok;
+    }
+
+    void MaterialTexturePacker::ReleaseSources()
+    {
+        for (auto& material : m_Materials)
+        {
+            for (auto& source : material.Sources)
+            {
+                source.reset();
+            }
+        }
+        m_SourcesReleased = true;
+    }
+
+    void MaterialTexturePacker::UploadMaterialTable()
+    {
+        std::vector<PackedMaterialGPU> table;
+        table.reserve(m_Materials.size());
+
+        for (const auto& material : m_Materials)
+        {
+            PackedMaterialGPU gpu{};
+            gpu.BaseColor = material.BaseColor;
+            gpu.Params = material.Params;
+            gpu.Emissive = glm::vec4(material.Emissive, 0.0f);
+
+            int layers[kKindCount];
+            for (size_t k = 0; k < kKindCount; ++k)
+            {
+                const auto& ref = material.Refs[k];
+                layers[k] = ref.IsValid() ? ref.Layer : -1;
+                gpu.UVTransforms[k] = ref.UVTransform;
+            }
+            gpu.LayersA = glm::ivec4(layers[0], layers[1], layers[2], layers[3]);
+            gpu.LayersB = glm::ivec4(layers[4], material.PackedORM ? 1 : 0, -1, -1);
+
+            table.push_back(gpu);
+        }
+
+        size_t bytes = table.size() * sizeof(PackedMaterialGPU);
+        if (!m_MaterialTable)
+        {
+            m_MaterialTable = std::make_unique<ShaderStorageBuffer>(table.data(), bytes, GL_STATIC_DRAW);
+        }
+        else
+        {
+            m_MaterialTable->SetData(table.data(), bytes);
+        }
+    }
+
+    void MaterialTexturePacker::Bind(Shader& shader, uint32_t materialIndex) const
+    {
+        if (!m_Built || materialIndex >= m_Materials.size())
+        {
+            VP_CORE_ERROR("MaterialTexturePacker::Bind: invalid material {} (built: {})", materialIndex, m_Built);
+            return;
+        }
+
+        const MaterialEntry& material = m_Materials[materialIndex];
+
+        for (size_t k = 0; k < kKindCount; ++k)
+        {
+            const PackedTextureRef& ref = material.Refs[k];
+            if (!ref.IsValid()) continue;
+
+            const Pool& pool = m_Pools[static_cast<size_t>(ref.Pool)];
+            unsigned int slot = static_cast<unsigned int>(kKindSlots[k]);
+
+            pool.Array->Bind(slot);
+            (pool.IsAtlas ? m_AtlasSampler : m_ArraySampler)->Bind(slot);
+            shader.SetInt(kKindUniforms[k], kKindSlots[k]);
+        }
+
+        m_MaterialTable->BindBase(MaterialTableBinding);
+    }
+
+    void MaterialTexturePacker::Unbind() const
+    {
+        for (size_t k = 0; k < kKindCount; ++k)
+        {
+            Sampler::Unbind(static_cast<unsigned int>(kKindSlots[k]));
+        }
+    }
+
+    uint64_t MaterialTexturePacker::GetBatchKey(uint32_t materialIndex) const
+    {
+        if (materialIndex >= m_Materials.size()) return 0;
+
+        // 12 bits per kind: pool index + 1 (0 = unused)
+        uint64_t key = 0;
+        for (size_t k = 0; k < kKindCount; ++k)
+        {
+            uint64_t pool = static_cast<uint64_t>(m_Materials[materialIndex].Refs[k].Pool + 1) & 0xFFF;
+            key |= pool << (k * 12);
+        }
+        return key;
+    }
+
+    bool MaterialTexturePacker::IsBatchCompatible(uint32_t a, uint32_t b) const
+    {
+        if (a >= m_Materials.size() || b >= m_Materials.size()) return false;
+
+        for (size_t k = 0; k < kKindCount; ++k)
+        {
+            const PackedTextureRef& refA = m_Materials[a].Refs[k];
+            const PackedTextureRef& refB = m_Materials[b].Refs[k];
+            if (refA.IsValid() && refB.IsValid() && refA.Pool != refB.Pool)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const PackedTextureRef& MaterialTexturePacker::GetTextureRef(uint32_t materialIndex, PackedTextureKind kind) const
+    {
+        if (materialIndex >= m_Materials.size() || kind == PackedTextureKind::Count)
+        {
+            return kNoTexture;
+        }
+        return m_Materials[materialIndex].Refs[static_cast<size_t>(kind)];
+    }
+}
@@ -0,0 +1,185 @@
+// VizEngine/src/VizEngine/Renderer/MaterialTexturePacker.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+    class Texture;
+    class TextureArray;
+    class Sampler;
+    class Shader;
+    class ShaderStorageBuffer;
+    struct Material;
+
+    /**
+     * Texture roles a packed material can reference.
+     * Order matches the layer/UV arrays in PackedMaterialGPU.
+     */
+    enum class PackedTextureKind : uint8_t
+    {
+        BaseColor = 0,
+        Normal,
+        MetallicRoughness,
+        Occlusion,
+        Emissive,
+        Count
+    };
+
+    /**
+     * Where a source texture ended up after packing.
+     */
+    struct VizEngine_API PackedTextureRef
+    {
+        int Pool = -1;                                       // Pool index, -1 = no texture
+        int Layer = 0;                                       // Layer within the pool
+        glm::vec4 UVTransform = glm::vec4(1, 1, 0, 0);       // xy = scale, zw = offset (atlas remap)
+
+        bool IsValid() const { return Pool >= 0; }
+    };
+
+    /**
+     * One material as seen by shaders (std430, 160 bytes).
+     * Mirrored by the PackedMaterial struct in packed_instanced.shader.
+     */
+    struct PackedMaterialGPU
+    {
+        glm::vec4 BaseColor;
+        glm::vec4 Params;                 // x = metallic, y = roughness, z = AO, w = alpha cutoff
+        glm::vec4 Emissive;               // rgb = emissive factor
+        glm::ivec4 LayersA;               // base color, normal, metallic-roughness, occlusion (-1 = none)
+        glm::ivec4 LayersB;               // x = emissive (-1 = none), y = 1 if occlusion is metallic-roughness R (ORM)
+        glm::vec4 UVTransforms[5];        // Per PackedTextureKind
+    };
+
+    static_assert(sizeof(PackedMaterialGPU) == 160, "PackedMaterialGPU must match the std430 layout");
+
+    /**
+     * Packing options for MaterialTexturePacker.
+     */
+    struct TexturePackerSettings
+    {
+        int AtlasMaxSize = 256;       // Textures this size or smaller go to atlases (0 = no atlasing)
+        int AtlasPageSize = 2048;     // Atlas page (layer) size
+        int AtlasPadding = 8;         // Gutter between atlas entries, limits mip bleeding
+        int UniformLayerSize = 0;     // If > 0, large textures are rescaled to this size so they share one pool
+        float MaxAnisotropy = 8.0f;
+    };
+
+    /**
+     * Packs material textures into GL_TEXTURE_2D_ARRAY pools.
+     *
+     * Textures with the same size and format share an array and are addressed
+     * by layer. Small textures are packed into atlas pages (also array layers)
+     * with a per-texture UV scale/offset. Pools are sampled through shared
+     * sampler objects, so a material reduces to an index into a GPU material
+     * table plus layer numbers. Every material with the same batch key binds
+     * the same pools and can be drawn in one instanced or indirect draw.
+     *
+     * Usage:
+     *   MaterialTexturePacker packer;
+     *   uint32_t a = packer.AddMaterial(materialA);
+     *   uint32_t b = packer.AddMaterial(materialB);
+     *   packer.Build();
+     *   packer.Bind(shader, a);        // pools + samplers + material table
+     *   // draw instances whose material index has packer.GetBatchKey(a)
+     */
+    class VizEngine_API MaterialTexturePacker
+    {
+    public:
+        /** Binding point of the material table SSBO */
+        static constexpr unsigned int MaterialTableBinding = 0;
+
+        explicit MaterialTexturePacker(const TexturePackerSettings& settings = TexturePackerSettings());
+        ~MaterialTexturePacker();
+
+        MaterialTexturePacker(const MaterialTexturePacker&) = delete;
+        MaterialTexturePacker& operator=(const MaterialTexturePacker&) = delete;
+
+        /**
+         * Register a material. Textures are deduplicated by pointer.
+         * @return Material index (position in the GPU material table)
+         */
+        uint32_t AddMaterial(const Material& material);
+
+        /**
+         * Allocate pools, copy all textures on the GPU and upload the
+         * material table. Can be called again after adding materials.
+         * @return true if every material was packed
+         */
+        bool Build();
+
+        /**
+         * Drop the packer's references to the source textures once the pools
+         * hold the only copy needed. Build() cannot be called afterwards.
+         */
+        void ReleaseSources();
+
+        bool IsBuilt() const { return m_Built; }
+
+        /**
+         * Bind the pools used by a material's batch, the shared samplers and
+         * the material table. Sets the u_*Pool sampler uniforms on the shader.
+         */
+        void Bind(Shader& shader, uint32_t materialIndex) const;
+
+        /**
+         * Remove the shared samplers from the material texture units.
+         */
+        void Unbind() const;
+
+        /**
+         * Materials with equal keys bind identical pools and can share a draw.
+         */
+        uint64_t GetBatchKey(uint32_t materialIndex) const;
+
+        /**
+         * True if two materials can share a draw: for every texture role they
+         * use the same pool, or at least one of them has no texture there.
+         */
+        bool IsBatchCompatible(uint32_t a, uint32_t b) const;
+
+        const PackedTextureRef& GetTextureRef(uint32_t materialIndex, PackedTextureKind kind) const;
+
+        size_t GetMaterialCount() const { return m_Materials.size(); }
+        size_t GetPoolCount() const { return m_Pools.size(); }
+        size_t GetTextureCount() const { return m_TextureRefs.size(); }
+
+    private:
+        struct MaterialEntry
+        {
+            glm::vec4 BaseColor;
+            glm::vec4 Params;
+            glm::vec3 Emissive;
+            bool PackedORM = false;
+            std::shared_ptr<Texture> Sources[static_cast<size_t>(PackedTextureKind::Count)];
+            PackedTextureRef Refs[static_cast<size_t>(PackedTextureKind::Count)];
+        };
+
+        struct Pool
+        {
+            std::unique_ptr<TextureArray> Array;
+            bool IsAtlas = false;
+        };
+
+        bool PackArrays(const std::vector<const Texture*>& textures);
+        bool PackAtlases(const std::vector<const Texture*>& textures);
+        void UploadMaterialTable();
+
+        TexturePackerSettings m_Settings;
+        std::vector<MaterialEntry> m_Materials;
+        std::vector<Pool> m_Pools;
+        std::unordered_map<const Texture*, PackedTextureRef> m_TextureRefs;
+        std::unique_ptr<Sampler> m_ArraySampler;   // Trilinear + repeat
+        std::unique_ptr<Sampler> m_AtlasSampler;   // Trilinear + clamp (wrap is emulated in shader)
+        std::unique_ptr<ShaderStorageBuffer> m_MaterialTable;
+        bool m_Built = false;
+        bool m_SourcesReleased = false;
+    };
+}
@@ -0,0 +1,234 @@
+// VizEngine/src/VizEngine/Renderer/OverdrawAnalyzer.cpp
+
+#include "OverdrawAnalyzer.h"
+#include "VizEngine/Core/Mesh.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/VertexArray.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace VizEngine
+{
+	OverdrawAnalyzer::OverdrawAnalyzer(int width, int height)
+		: m_Width(width), m_Height(height)
+	{
+		m_CountShader = std::make_unique<Shader>("resources/shaders/overdraw_count.shader");
+		m_VisualizeShader = std::make_unique<Shader>("resources/shaders/overdraw_visualize.shader");
+		if (!m_CountShader->IsValid() || !m_VisualizeShader->IsValid())
+		{
+			VP_CORE_ERROR("OverdrawAnalyzer: Failed to load shaders!");
+			return;
+		}
+
+		m_EmptyVAO = std::make_unique<VertexArray>();
+		CreateTargets();
+	}
+
+	OverdrawAnalyzer::~OverdrawAnalyzer() = default;
+
+	void OverdrawAnalyzer::Resize(int width, int height)
+	{
+		if (width == m_Width && height == m_Height) return;
+		if (width <= 0 || height <= 0) return;
+
+		m_Width = width;
+		m_Height = height;
+		if (m_CountShader && m_CountShader->IsValid())
+		{
+			CreateTargets();
+		}
+	}
+
+	void OverdrawAnalyzer::CreateTargets()
+	{
+		m_IsValid = false;
+
+		m_DepthTexture = std::make_shared<Texture>(
+			m_Width, m_Height, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT
+		);
+
+		for (size_t i = 0; i < static_cast<size_t>(OverdrawPass::Count); i++)
+		{
+			// R32F: exact integer counts far beyond any realistic overdraw, and blendable
+			m_CountTextures[i] = std::make_shared<Texture>(
+				m_Width, m_Height, GL_R32F, GL_RED, GL_FLOAT
+			);
+
+			m_Framebuffers[i] = std::make_unique<Framebuffer>(m_Width, m_Height);
+			m_Framebuffers[i]->AttachColorTexture(m_CountTextures[i], 0);
+			m_Framebuffers[i]->AttachDepthTexture(m_DepthTexture);
+
+			if (!m_Framebuffers[i]->IsComplete())
+			{
+				VP_CORE_ERROR("OverdrawAnalyzer: Count framebuffer not complete!");
+				return;
+			}
+		}
+
+		m_Readback.resize(static_cast<size_t>(m_Width) * static_cast<size_t>(m_Height));
+		m_IsValid = true;
+	}
+
+	void OverdrawAnalyzer::BeginPass(OverdrawPass pass, const glm::mat4& viewProjection, OverdrawDepthMode depthMode)
+	{
+		if (!m_IsValid || pass == OverdrawPass::Count) return;
+
+		if (m_ActivePass != OverdrawPass::Count)
+		{
+			VP_CORE_WARN("OverdrawAnalyzer::BeginPass called while a pass is active");
+			return;
+		}
+		m_ActivePass = pass;
+		m_PassEstimated = false;
+
+		glGetIntegerv(GL_VIEWPORT, m_SavedViewport);
+		m_SavedBlend = glIsEnabled(GL_BLEND) == GL_TRUE;
+		m_SavedDepthTest = glIsEnabled(GL_DEPTH_TEST) == GL_TRUE;
+		GLboolean depthMask = GL_TRUE;
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+		m_SavedDepthMask = depthMask == GL_TRUE;
+		glGetIntegerv(GL_DEPTH_FUNC, &m_SavedDepthFunc);
+		glGetIntegerv(GL_BLEND_SRC_RGB, &m_SavedBlendFunc[0]);
+		glGetIntegerv(GL_BLEND_DST_RGB, &m_SavedBlendFunc[1]);
+		glGetIntegerv(GL_BLEND_SRC_ALPHA, &m_SavedBlendFunc[2]);
+		glGetIntegerv(GL_BLEND_DST_ALPHA, &m_SavedBlendFunc[3]);
+		glGetIntegerv(GL_BLEND_EQUATION_RGB, &m_SavedBlendEquation[0]);
+		glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &m_SavedBlendEquation[1]);
+
+		m_Framebuffers[static_cast<size_t>(pass)]->Bind();
+		glViewport(0, 0, m_Width, m_Height);
+
+		float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		glClearBufferfv(GL_COLOR, 0, zero);
+
+		switch (depthMode)
+		{
+		case OverdrawDepthMode::Disabled:
+			glDisable(GL_DEPTH_TEST);
+			break;
+		case OverdrawDepthMode::TestWrite:
+			glEnable(GL_DEPTH_TEST);
+			glDepthMask(GL_TRUE);
+			glClear(GL_DEPTH_BUFFER_BIT);
+			break;
+		case OverdrawDepthMode::TestOnly:
+			glEnable(GL_DEPTH_TEST);
+			glDepthMask(GL_FALSE);
+			break;
+		}
+		glDepthFunc(GL_LESS);
+
+		// Every fragment adds its weight to the pixel's count
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glBlendEquation(GL_FUNC_ADD);
+
+		m_CountShader->Bind();
+		m_CountShader->SetMatrix4fv("u_ViewProjection", viewProjection);
+	}
+
+	void OverdrawAnalyzer::Submit(const Mesh& mesh, const glm::mat4& model)
+	{
+		if (m_ActivePass == OverdrawPass::Count) return;
+
+		m_CountShader->SetBool("u_Fullscreen", false);
+		m_CountShader->SetFloat("u_Weight", 1.0f);
+		m_CountShader->SetMatrix4fv("u_Model", model);
+
+		mesh.Bind();
+		glDrawElements(GL_TRIANGLES, mesh.GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OverdrawAnalyzer::SubmitFullscreen(float weight)
+	{
+		if (m_ActivePass == OverdrawPass::Count) return;
+
+		m_PassEstimated = true;
+		m_CountShader->SetBool("u_Fullscreen", true);
+		m_CountShader->SetFloat("u_Weight", weight);
+
+		m_EmptyVAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	OverdrawMetrics OverdrawAnalyzer::EndPass(uint32_t threshold)
+	{
+		OverdrawMetrics metrics;
+		metrics.Threshold = threshold;
+		if (m_ActivePass == OverdrawPass::Count) return metrics;
+
+		size_t passIndex = static_cast<size_t>(m_ActivePass);
+		m_ActivePass = OverdrawPass::Count;
+
+		// Restore the state BeginPass() replaced
+		m_Framebuffers[passIndex]->Unbind();
+		glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]);
+		if (m_SavedBlend) glEnable(GL_BLEND);
+		else glDisable(GL_BLEND);
+		glBlendFuncSeparate(m_SavedBlendFunc[0], m_SavedBlendFunc[1], m_SavedBlendFunc[2], m_SavedBlendFunc[3]);
+		glBlendEquationSeparate(m_SavedBlendEquation[0], m_SavedBlendEquation[1]);
+		if (m_SavedDepthTest) glEnable(GL_DEPTH_TEST);
+		else glDisable(GL_DEPTH_TEST);
+		glDepthMask(m_SavedDepthMask ? GL_TRUE : GL_FALSE);
+		glDepthFunc(m_SavedDepthFunc);
+
+		// Synchronous readback (debug only)
+		glGetTextureImage(
+			m_CountTextures[passIndex]->GetID(), 0, GL_RED, GL_FLOAT,
+			static_cast<GLsizei>(m_Readback.size() * sizeof(float)), m_Readback.data()
+		);
+
+		double total = 0.0;
+		size_t covered = 0;
+		size_t above = 0;
+		float maxCount = 0.0f;
+		for (float count : m_Readback)
+		{
+			total += count;
+			if (count > 0.0f) covered++;
+			if (count > static_cast<float>(threshold)) above++;
+			maxCount = std::max(maxCount, count);
+		}
+
+		const double pixels = static_cast<double>(m_Readback.size());
+		metrics.Fragments = static_cast<uint64_t>(total + 0.5);
+		metrics.Average = pixels > 0.0 ? static_cast<float>(total / pixels) : 0.0f;
+		metrics.AverageCovered = covered > 0 ? static_cast<float>(total / static_cast<double>(covered)) : 0.0f;
+		metrics.Max = maxCount;
+		metrics.Coverage = pixels > 0.0 ? static_cast<float>(100.0 * static_cast<double>(covered) / pixels) : 0.0f;
+		metrics.PercentAboveThreshold = pixels > 0.0 ? static_cast<float>(100.0 * static_cast<double>(above) / pixels) : 0.0f;
+		metrics.Valid = true;
+		metrics.Estimated = m_PassEstimated;
+		return metrics;
+	}
+
+	void OverdrawAnalyzer::Visualize(OverdrawPass pass, float maxCount)
+	{
+		if (!m_IsValid || pass == OverdrawPass::Count) return;
+
+		GLboolean depthTestEnabled;
+		glGetBooleanv(GL_DEPTH_TEST, &depthTestEnabled);
+		glDisable(GL_DEPTH_TEST);
+
+		m_VisualizeShader->Bind();
+		m_CountTextures[static_cast<size_t>(pass)]->Bind(TextureSlots::Custom0);
+		m_VisualizeShader->SetInt("u_Counts", TextureSlots::Custom0);
+		m_VisualizeShader->SetFloat("u_MaxCount", std::max(maxCount, 1.0f));
+
+		m_EmptyVAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		if (depthTestEnabled) glEnable(GL_DEPTH_TEST);
+	}
+
+	std::shared_ptr<Texture> OverdrawAnalyzer::GetCountTexture(OverdrawPass pass) const
+	{
+		if (pass == OverdrawPass::Count) return nullptr;
+		return m_CountTextures[static_cast<size_t>(pass)];
+	}
+}
@@ -0,0 +1,126 @@
+// VizEngine/src/VizEngine/Renderer/OverdrawAnalyzer.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/OpenGL/RenderStats.h"
+#include "glm.hpp"
+#include <memory>
+#include <vector>
+
+namespace VizEngine
+{
+	class Framebuffer;
+	class Mesh;
+	class Shader;
+	class Texture;
+	class VertexArray;
+
+	/**
+	 * Depth handling while counting a pass.
+	 */
+	enum class OverdrawDepthMode : uint8_t
+	{
+		Disabled,    // Count every rasterized fragment (post passes, worst case)
+		TestWrite,   // Clear depth, then test and write like the opaque pass
+		TestOnly     // Test against depth left by the previous pass (transparent)
+	};
+
+	/**
+	 * Per-pixel fragment counting for overdraw debugging.
+	 *
+	 * Each pass is replayed into its own R32F count target with additive
+	 * blending: geometry passes submit their meshes in draw order, post passes
+	 * add one full-screen layer per draw weighted by its resolution. Post
+	 * counts are therefore an estimate from the number and size of the draws,
+	 * flagged as OverdrawMetrics::Estimated. EndPass()
+	 * reads the counts back and summarises them (average, max, coverage, share
+	 * of pixels above a threshold) for RenderStats. Visualize() draws a heat
+	 * map of any pass.
+	 *
+	 * The readback stalls the pipeline; this is a debug tool, run only while
+	 * a debug view or metrics capture is enabled.
+	 */
+	class VizEngine_API OverdrawAnalyzer
+	{
+	public:
+		OverdrawAnalyzer(int width, int height);
+		~OverdrawAnalyzer();
+
+		OverdrawAnalyzer(const OverdrawAnalyzer&) = delete;
+		OverdrawAnalyzer& operator=(const OverdrawAnalyzer&) = delete;
+
+		bool IsValid() const { return m_IsValid; }
+
+		/**
+		 * Recreate the count targets at a new size.
+		 */
+		void Resize(int width, int height);
+
+		/**
+		 * Start counting a pass. Binds the pass's count target and viewport.
+		 * @param pass Which pass is being counted
+		 * @param viewProjection Camera matrix used by Submit()
+		 * @param depthMode How depth is treated
+		 */
+		void BeginPass(OverdrawPass pass, const glm::mat4& viewProjection, OverdrawDepthMode depthMode);
+
+		/**
+		 * Count the fragments of one mesh draw.
+		 */
+		void Submit(const Mesh& mesh, const glm::mat4& model);
+
+		/**
+		 * Count one full-screen draw of a post pass. Marks the pass's metrics
+		 * as estimated.
+		 * @param weight Fraction of screen resolution the draw runs at (e.g. 0.25 for half size)
+		 */
+		void SubmitFullscreen(float weight = 1.0f);
+
+		/**
+		 * Finish the pass, restore state and compute its metrics.
+		 * @param threshold Pixels counted more than this many times are reported
+		 */
+		OverdrawMetrics EndPass(uint32_t threshold = 4);
+
+		/**
+		 * Draw a heat map of a pass's counts into the bound framebuffer.
+		 * @param pass Pass to show
+		 * @param maxCount Count mapped to the hottest color
+		 */
+		void Visualize(OverdrawPass pass, float maxCount);
+
+		std::shared_ptr<Texture> GetCountTexture(OverdrawPass pass) const;
+
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+
+	private:
+		void CreateTargets();
+
+		int m_Width = 0;
+		int m_Height = 0;
+		bool m_IsValid = false;
+
+		std::shared_ptr<Texture> m_CountTextures[static_cast<size_t>(OverdrawPass::Count)];
+		std::unique_ptr<Framebuffer> m_Framebuffers[static_cast<size_t>(OverdrawPass::Count)];
+		std::shared_ptr<Texture> m_DepthTexture;   // Shared by all passes
+
+		std::unique_ptr<Shader> m_CountShader;
+		std::unique_ptr<Shader> m_VisualizeShader;
+		std::unique_ptr<VertexArray> m_EmptyVAO;   // For attribute-less full-screen triangles
+
+		OverdrawPass m_ActivePass = OverdrawPass::Count;
+		bool m_PassEstimated = false;
+
+		// GL state replaced by BeginPass()
+		int m_SavedViewport[4] = { 0, 0, 0, 0 };
+		bool m_SavedBlend = false;
+		bool m_SavedDepthTest = true;
+		bool m_SavedDepthMask = true;
+		int m_SavedDepthFunc = 0;
+		int m_SavedBlendFunc[4] = { 0, 0, 0, 0 };    // Src RGB, dst RGB, src alpha, dst alpha
+		int m_SavedBlendEquation[2] = { 0, 0 };      // RGB, alpha
+		std::vector<float> m_Readback;
+	};
+}
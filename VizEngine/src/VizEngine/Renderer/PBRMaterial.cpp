@@ -4,6 +4,8 @@
 #include "VizEngine/OpenGL/Shader.h"
 #include "VizEngine/OpenGL/Texture.h"
 #include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Sampler.h"
+#include "VizEngine/Core/Material.h"
 
 namespace VizEngine
 {
@@ -17,15 +19,37 @@ namespace VizEngine
         SetVec3("u_Albedo", m_Albedo);
         SetBool("u_UseAlbedoTexture", false);
         SetBool("u_UseNormalMap", false);
+        SetBool("u_UseMetallicRoughnessTexture", false);
+        SetBool("u_UseORMTexture", false);
+        SetBool("u_UseAOTexture", false);
         SetFloat("u_Alpha", m_Alpha);
         SetBool("u_UseIBL", false);
         SetBool("u_UseShadows", false);
+        SetBool("u_UseVirtualShadows", false);
+        SetBool("u_Instanced", false);
 
         // Lower hemisphere defaults (prevents black reflections on flat surfaces)
         SetVec3("u_LowerHemisphereColor", m_LowerHemisphereColor);
         SetFloat("u_LowerHemisphereIntensity", m_LowerHemisphereIntensity);
+
+        // Give every sampler its own unit even when unused; left at unit 0
+        // they would alias u_AlbedoTexture (with a different type for some)
+        SetInt("u_MetallicRoughnessTexture", TextureSlots::MetallicRoughness);
+        SetInt("u_AOTexture", TextureSlots::AO);
+        SetInt("u_IrradianceMap", TextureSlots::Irradiance);
+        SetInt("u_PrefilteredMap", TextureSlots::Prefiltered);
+        SetInt("u_BRDF_LUT", TextureSlots::BRDF_LUT);
+
+        // Shadow filtering reads the map through two samplers. The comparison
+        // one is a sampler2DShadow, so it must never fall back to unit 0 next to
+        // the albedo sampler2D, or the program fails validation.
+        SetInt("u_ShadowMap", TextureSlots::ShadowMap);
+        SetInt("u_ShadowMapCompare", TextureSlots::ShadowMapCompare);
+        SetShadowFilter(m_ShadowFilter);
     }
 
+    PBRMaterial::~PBRMaterial() = default;
+
     // =========================================================================
     // PBR Properties
     // =========================================================================
@@ -99,11 +123,30 @@ namespace VizEngine
         }
         else
         {
+            ClearTexture("u_AlbedoTexture");
             m_HasAlbedoTexture = false;
             SetBool("u_UseAlbedoTexture", false);
         }
     }
 
+    void PBRMaterial::SetAlbedoTexture(const Texture* texture)
+    {
+        if (texture)
+        {
+            SetTexture("u_AlbedoTexture", texture, TextureSlots::Albedo);
+        }
+        else
+        {
+            // The pooled texture may be freed once its last handle is released
+            ClearTexture("u_AlbedoTexture");
+        }
+        if (m_HasAlbedoTexture != (texture != nullptr))
+        {
+            m_HasAlbedoTexture = texture != nullptr;
+            SetBool("u_UseAlbedoTexture", m_HasAlbedoTexture);
+        }
+    }
+
     void PBRMaterial::SetNormalTexture(std::shared_ptr<Texture> texture)
     {
         if (texture)
@@ -114,6 +157,7 @@ namespace VizEngine
         }
         else
         {
+            ClearTexture("u_NormalTexture");
             m_HasNormalTexture = false;
             SetBool("u_UseNormalMap", false);
         }
@@ -128,8 +172,10 @@ namespace VizEngine
         }
         else
         {
+            ClearTexture("u_MetallicRoughnessTexture");
             SetBool("u_UseMetallicRoughnessTexture", false);
         }
+        SetBool("u_UseORMTexture", false);
     }
 
     void PBRMaterial::SetAOTexture(std::shared_ptr<Texture> texture)
@@ -141,10 +187,29 @@ namespace VizEngine
         }
         else
         {
+            ClearTexture("u_AOTexture");
             SetBool("u_UseAOTexture", false);
         }
     }
 
+    void PBRMaterial::SetORMTexture(std::shared_ptr<Texture> texture)
+    {
+        SetMetallicRoughnessTexture(texture);
+        SetAOTexture(nullptr);
+        SetBool("u_UseORMTexture", texture != nullptr);
+    }
+
+    void PBRMaterial::SetSurfaceTextures(const Material& material)
+    {
+        if (material.HasPackedORM())
+        {
+            SetORMTexture(material.MetallicRoughnessTexture);
+            return;
+        }
+        SetMetallicRoughnessTexture(material.MetallicRoughnessTexture);
+        SetAOTexture(material.OcclusionTexture);
+    }
+
     void PBRMaterial::SetEmissiveTexture(std::shared_ptr<Texture> texture)
     {
         if (texture)
@@ -154,6 +219,7 @@ namespace VizEngine
         }
         else
         {
+            ClearTexture("u_EmissiveTexture");
             SetBool("u_UseEmissiveTexture", false);
         }
     }
@@ -223,6 +289,29 @@ namespace VizEngine
         if (shadowMap)
         {
             SetTexture("u_ShadowMap", shadowMap, TextureSlots::ShadowMap);
+            SetTexture("u_ShadowMapCompare", shadowMap, TextureSlots::ShadowMapCompare);
+            m_HasShadowMap = true;
+
+            if (!m_ShadowCompareSampler)
+            {
+                // Linear filtering makes each comparison fetch a bilinear 2x2 PCF.
+                // Outside the map reads as depth 1.0 (lit), like the texture's own border.
+                SamplerDesc desc;
+                desc.MinFilter = GL_LINEAR;
+                desc.MagFilter = GL_LINEAR;
+                desc.WrapS = desc.WrapT = desc.WrapR = GL_CLAMP_TO_BORDER;
+                desc.BorderColor[0] = desc.BorderColor[1] = desc.BorderColor[2] = desc.BorderColor[3] = 1.0f;
+                desc.CompareMode = GL_COMPARE_REF_TO_TEXTURE;
+                desc.CompareFunc = GL_LEQUAL;
+                m_ShadowCompareSampler = std::make_unique<Sampler>(desc);
+            }
+        }
+        else
+        {
+            // Unit assignments stay; only the textures are released
+            ClearTexture("u_ShadowMap");
+            ClearTexture("u_ShadowMapCompare");
+            m_HasShadowMap = false;
         }
     }
 
@@ -237,10 +326,36 @@ namespace VizEngine
         SetBool("u_UseShadows", useShadows);
     }
 
+    void PBRMaterial::SetShadowFilter(const ShadowFilterSettings& settings)
+    {
+        m_ShadowFilter = settings;
+        SetInt("u_ShadowFilterMode", static_cast<int>(settings.Mode));
+        SetInt("u_ShadowTaps", settings.Taps);
+        SetFloat("u_ShadowFilterRadius", settings.RadiusTexels);
+        SetFloat("u_ShadowLightSize", settings.LightSize);
+        SetInt("u_ShadowBlockerTaps", settings.BlockerSearchTaps);
+        SetFloat("u_ShadowMaxPenumbra", settings.MaxPenumbraTexels);
+    }
+
+    const ShadowFilterSettings& PBRMaterial::GetShadowFilter() const
+    {
+        return m_ShadowFilter;
+    }
+
+    void PBRMaterial::SetUseVirtualShadows(bool useVirtualShadows)
+    {
+        SetBool("u_UseVirtualShadows", useVirtualShadows);
+    }
+
     // =========================================================================
     // Transforms
     // =========================================================================
 
+    void PBRMaterial::SetInstanced(bool instanced)
+    {
+        SetBool("u_Instanced", instanced);
+    }
+
     void PBRMaterial::SetModelMatrix(const glm::mat4& model)
     {
         SetMat4("u_Model", model);
@@ -289,4 +404,15 @@ namespace VizEngine
         // Any PBR-specific upload logic can be added here
         // (currently all handled by base class via stored parameters)
     }
+
+    void PBRMaterial::BindTextures()
+    {
+        RenderMaterial::BindTextures();
+
+        // The comparison view of the shadow map needs its sampler on top of the texture
+        if (m_HasShadowMap && m_ShadowCompareSampler)
+        {
+            m_ShadowCompareSampler->Bind(TextureSlots::ShadowMapCompare);
+        }
+    }
 }
@@ -4,9 +4,53 @@
 
 #include "RenderMaterial.h"
 #include "glm.hpp"
+#include <cstdint>
+#include <memory>
 
 namespace VizEngine
 {
+    class Sampler;
+    struct Material;
+
+    /**
+     * Shadow filtering in defaultlit.shader, in rising cost.
+     * Values match u_ShadowFilterMode.
+     */
+    enum class ShadowFilterMode : uint8_t
+    {
+        PCF3x3 = 0,    // 9 manual depth comparisons (legacy)
+        Hardware,      // sampler2DShadow; 1 or 4 fetches, 4 comparisons each
+        PoissonDisk,   // Rotated Vogel disk of hardware-compared fetches
+        PCSS           // Bounded blocker search, then a disk sized by the penumbra
+    };
+
+    /**
+     * Shadow filter parameters. Taps is the filter fetch count; the PCSS
+     * blocker search adds BlockerSearchTaps raw depth fetches.
+     */
+    struct ShadowFilterSettings
+    {
+        ShadowFilterMode Mode = ShadowFilterMode::PCF3x3;
+        int Taps = 16;                      // Hardware: 1 or 4; Disk/PCSS: up to 32
+        float RadiusTexels = 1.5f;          // Disk filter radius
+        float LightSize = 0.05f;            // PCSS: penumbra (UV) per unit of light-space depth
+        int BlockerSearchTaps = 8;          // PCSS: up to 16
+        float MaxPenumbraTexels = 16.0f;    // PCSS: bounds search and filter radius
+    };
+
+    /**
+     * Matrices of one instance for PBRMaterial::SetInstanced (std430, 112 bytes).
+     * Mirrored by the InstanceTransform struct in defaultlit.shader and
+     * shadow_depth.shader.
+     */
+    struct InstanceTransformGPU
+    {
+        glm::mat4 Model;
+        glm::vec4 NormalMatrix[3];    // Columns of the mat3
+    };
+
+    static_assert(sizeof(InstanceTransformGPU) == 112, "InstanceTransformGPU must match the std430 layout");
+
     /**
      * Physically-Based Rendering material for use with defaultlit.shader.
      * Encapsulates metallic-roughness workflow parameters.
@@ -26,7 +70,7 @@ namespace VizEngine
          * @param name Material name for debugging
          */
         PBRMaterial(std::shared_ptr<Shader> shader, const std::string& name = "PBR Material");
-        ~PBRMaterial() override = default;
+        ~PBRMaterial() override;
 
         // =====================================================================
         // PBR Properties (Metallic-Roughness Workflow)
@@ -57,6 +101,25 @@ namespace VizEngine
         void SetAOTexture(std::shared_ptr<Texture> texture);
         void SetEmissiveTexture(std::shared_ptr<Texture> texture);
 
+        /**
+         * Packed occlusion/roughness/metallic map (R/G/B): one sampler and
+         * one fetch instead of separate metallic-roughness and AO maps.
+         * Null disables it.
+         */
+        void SetORMTexture(std::shared_ptr<Texture> texture);
+
+        /**
+         * Metallic-roughness and occlusion maps of a glTF material, using
+         * the ORM path when the importer packed them into one texture.
+         */
+        void SetSurfaceTextures(const Material& material);
+
+        /**
+         * Borrowed albedo texture for per-object rebinding in the render loop
+         * (resolved from a TextureHandle). Null disables the albedo map.
+         */
+        void SetAlbedoTexture(const Texture* texture);
+
         // =====================================================================
         // IBL (Environment) Maps
         // =====================================================================
@@ -76,14 +139,38 @@ namespace VizEngine
         // Shadow Mapping
         // =====================================================================
 
+        /**
+         * Binds the depth texture twice: as u_ShadowMap for raw depth reads
+         * and as u_ShadowMapCompare with a comparison sampler.
+         */
         void SetShadowMap(std::shared_ptr<Texture> shadowMap);
         void SetLightSpaceMatrix(const glm::mat4& lightSpaceMatrix);
         void SetUseShadows(bool useShadows);
 
+        void SetShadowFilter(const ShadowFilterSettings& settings);
+        const ShadowFilterSettings& GetShadowFilter() const;
+
+        /**
+         * Sample a VirtualShadowMap instead: pass its atlas to SetShadowMap()
+         * and bind its page table. Filtering uses the Hardware mode's taps.
+         */
+        void SetUseVirtualShadows(bool useVirtualShadows);
+
         // =====================================================================
         // Transform (per-object, set before each draw)
         // =====================================================================
 
+        /** SSBO binding point of the InstanceTransformGPU array */
+        static constexpr unsigned int InstanceTransformBinding = 8;
+
+        /**
+         * Take model and normal matrices from the InstanceTransformGPU array
+         * at InstanceTransformBinding, indexed by gl_BaseInstance +
+         * gl_InstanceID, instead of SetModelMatrix()/SetNormalMatrix().
+         * For Renderer::DrawInstanced; the caller binds the buffer.
+         */
+        void SetInstanced(bool instanced);
+
         void SetModelMatrix(const glm::mat4& model);
         void SetNormalMatrix(const glm::mat3& normalMatrix);
         void SetViewMatrix(const glm::mat4& view);
@@ -99,6 +186,7 @@ namespace VizEngine
 
     protected:
         void UploadParameters() override;
+        void BindTextures() override;
 
     private:
         // Cached values for convenience getters
@@ -113,6 +201,11 @@ namespace VizEngine
         bool m_HasAlbedoTexture = false;
         bool m_HasNormalTexture = false;
 
+        // Shadow filtering
+        ShadowFilterSettings m_ShadowFilter;
+        std::unique_ptr<Sampler> m_ShadowCompareSampler;   // Created with the first shadow map
+        bool m_HasShadowMap = false;
+
         // Lower hemisphere fallback
         glm::vec3 m_LowerHemisphereColor = glm::vec3(0.1f, 0.1f, 0.15f);  // Slightly blue-ish ground color
         float m_LowerHemisphereIntensity = 0.5f;  // Default to half intensity
@@ -0,0 +1,408 @@
+// VizEngine/src/VizEngine/Renderer/PointCloud.cpp
+
+#include "PointCloud.h"
+#include "VizEngine/Core/BatchMath.h"
+#include "VizEngine/Core/Profiler.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/VertexArray.h"
+#include "VizEngine/OpenGL/VertexBuffer.h"
+#include "VizEngine/OpenGL/VertexBufferLayout.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <queue>
+
+namespace VizEngine
+{
+	using namespace PointCloudFormat;
+
+	namespace
+	{
+		bool BoxOutside(const FrustumPlanes& frustum, const glm::vec3& center, const glm::vec3& extent)
+		{
+			for (const glm::vec4& plane : frustum.Planes)
+			{
+				float radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return true;
+			}
+			return false;
+		}
+	}
+
+	PointCloud::PointCloud(const PointCloudSettings& settings)
+		: m_Settings(settings)
+	{
+	}
+
+	PointCloud::~PointCloud()
+	{
+		Close();
+	}
+
+	bool PointCloud::Open(const std::string& path)
+	{
+		Close();
+		if (!m_File.Open(path)) return false;
+
+		const uint8_t* data = m_File.GetData();
+		const size_t size = m_File.GetSize();
+		auto fail = [&](const char* reason)
+		{
+			VP_CORE_ERROR("PointCloud: '{}' {}", path, reason);
+			m_Records.clear();
+			m_File.Close();
+			return false;
+		};
+
+		if (size < sizeof(Header)) return fail("is too small");
+		std::memcpy(&m_Header, data, sizeof(Header));
+		if (m_Header.Magic != Magic) return fail("is not a point cloud octree");
+		if (m_Header.Version != Version) return fail("has an unsupported version");
+		if (m_Header.NodeCount == 0 || m_Header.GridResolution == 0 || !(m_Header.Size > 0.0))
+			return fail("has no nodes");
+		if (m_Header.HierarchyOffset > size || (size - m_Header.HierarchyOffset) / sizeof(NodeRecord) < m_Header.NodeCount)
+			return fail("has a truncated node table");
+
+		m_Records.resize(m_Header.NodeCount);
+		std::memcpy(m_Records.data(), data + m_Header.HierarchyOffset, m_Records.size() * sizeof(NodeRecord));
+		for (const NodeRecord& record : m_Records)
+		{
+			if (record.Offset > size || (size - record.Offset) / sizeof(PointRecord) < record.PointCount)
+				return fail("has a node outside the file");
+			if (record.ChildMask != 0 &&
+				(record.FirstChild == NoChildren || record.FirstChild + std::popcount(record.ChildMask) > m_Header.NodeCount))
+				return fail("has a broken node table");
+		}
+
+		if (!m_Shader)
+		{
+			m_Shader = std::make_unique<Shader>("resources/shaders/point_cloud.shader");
+			if (!m_Shader->IsValid()) VP_CORE_ERROR("PointCloud: failed to load point_cloud.shader");
+		}
+
+		m_Nodes = std::vector<Node>(m_Records.size());
+		m_Stats = PointCloudStats();
+		m_Stats.TotalPoints = m_Header.PointCount;
+		m_Stats.TotalNodes = m_Header.NodeCount;
+
+		m_Stop = false;
+		m_Loader = std::thread(&PointCloud::LoaderMain, this);
+
+		VP_CORE_INFO("PointCloud: opened '{}' ({} points, {} nodes, {:.1f} units)", path,
+			m_Header.PointCount, m_Header.NodeCount, m_Header.Size);
+		return true;
+	}
+
+	void PointCloud::Close()
+	{
+		if (m_Loader.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Stop = true;
+			}
+			m_Wake.notify_all();
+			m_Loader.join();
+		}
+
+		m_LoadQueue.clear();
+		m_Loaded.clear();
+		m_Loading = 0;
+		m_Visible.clear();
+		m_Nodes.clear();
+		m_Records.clear();
+		m_File.Close();
+		m_Stats = PointCloudStats();
+	}
+
+	float PointCloud::NodeSize(uint32_t index) const
+	{
+		return static_cast<float>(m_Header.Size / static_cast<double>(1u << m_Records[index].Level));
+	}
+
+	void PointCloud::LoaderMain()
+	{
+		const uint8_t* data = m_File.GetData();
+		for (;;)
+		{
+			uint32_t index;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Wake.wait(lock, [&] { return m_Stop || !m_LoadQueue.empty(); });
+				if (m_Stop) return;
+				index = m_LoadQueue.front();
+				m_LoadQueue.pop_front();
+				m_Loading++;
+			}
+
+			// Touching the mapping here takes the page faults off the render thread
+			LoadedNode loaded;
+			loaded.Index = index;
+			loaded.Points.resize(m_Records[index].PointCount);
+			std::memcpy(loaded.Points.data(), data + m_Records[index].Offset, loaded.Points.size() * sizeof(PointRecord));
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Loaded.push_back(std::move(loaded));
+			m_Loading--;
+		}
+	}
+
+	void PointCloud::Update(const glm::mat4& view, const glm::mat4& projection, int viewportHeight)
+	{
+		if (!IsOpen()) return;
+
+		m_Frame++;
+		m_View = view;
+		m_Projection = projection;
+		m_ProjScale = projection[1][1] * static_cast<float>(viewportHeight) * 0.5f;
+		m_Stats.UploadedBytes = 0;
+		m_Stats.EvictedNodes = 0;
+
+		UploadLoaded();
+
+		// Traverse in local space: planes of P * V * M, camera through (V * M)^-1
+		const FrustumPlanes frustum = BatchMath::ExtractFrustumPlanes(projection * view * m_Model);
+		const glm::vec3 camera = glm::vec3(glm::inverse(view * m_Model)[3]);
+
+		// Per node: levels drawn in full below it, or one of these
+		constexpr int NotDrawn = -1;
+		constexpr int Culled = -2;
+		std::vector<int> refined(m_Records.size(), NotDrawn);
+
+		struct Candidate
+		{
+			float Priority;
+			uint32_t Index;
+			float Distance;
+			bool operator<(const Candidate& other) const { return Priority < other.Priority; }
+		};
+		std::priority_queue<Candidate> candidates;
+		std::vector<Candidate> requests;
+
+		auto consider = [&](uint32_t index)
+		{
+			const NodeRecord& record = m_Records[index];
+			const float size = NodeSize(index);
+			const glm::vec3 half(size * 0.5f);
+			const glm::vec3 center = glm::vec3(static_cast<float>(record.X), static_cast<float>(record.Y), static_cast<float>(record.Z)) * size + half;
+			if (BoxOutside(frustum, center, half))
+			{
+				refined[index] = Culled;
+				return;
+			}
+
+			// Projected size of the bounding sphere; nodes around the camera come first
+			const float radius = size * 0.8660254f;
+			const float distance = glm::length(camera - center);
+			const float pixels = distance > radius ? radius / distance * m_ProjScale : std::numeric_limits<float>::max();
+			candidates.push({ pixels, index, distance });
+		};
+
+		m_Visible.clear();
+		uint64_t points = 0;
+		consider(0);
+		while (!candidates.empty())
+		{
+			const Candidate candidate = candidates.top();
+			candidates.pop();
+			const NodeRecord& record = m_Records[candidate.Index];
+			Node& node = m_Nodes[candidate.Index];
+
+			if (points + record.PointCount > m_Settings.PointBudget) break;
+
+			// Children refine their parent's points, so only resident nodes are refined
+			if (node.State != NodeState::Resident)
+			{
+				if (node.State == NodeState::Unloaded) requests.push_back(candidate);
+				continue;
+			}
+
+			node.LastUsed = m_Frame;
+			refined[candidate.Index] = 0;
+			points += record.PointCount;
+			if (record.PointCount > 0) m_Visible.push_back({ candidate.Index, candidate.Distance, 0 });
+
+			if (record.FirstChild == NoChildren || candidate.Priority < m_Settings.MinNodePixels) continue;
+			for (uint32_t child = 0; child < static_cast<uint32_t>(std::popcount(record.ChildMask)); child++)
+				consider(record.FirstChild + child);
+		}
+
+		// A node's spacing halves for every level below it drawn in full
+		// (children outside the frustum do not count). Children come after
+		// their parent in the node table, so one reverse pass settles every
+		// subtree.
+		for (size_t i = m_Records.size(); i-- > 0;)
+		{
+			const NodeRecord& record = m_Records[i];
+			if (refined[i] < 0 || record.FirstChild == NoChildren) continue;
+			int levels = std::numeric_limits<int>::max();
+			for (uint32_t child = 0; child < static_cast<uint32_t>(std::popcount(record.ChildMask)); child++)
+			{
+				const int childLevels = refined[record.FirstChild + child];
+				if (childLevels != Culled) levels = std::min(levels, childLevels);
+			}
+			refined[i] = levels == std::numeric_limits<int>::max() ? 0 : levels + 1;
+		}
+		for (VisibleNode& visible : m_Visible) visible.RefinedLevels = refined[visible.Index];
+		std::sort(m_Visible.begin(), m_Visible.end(),
+			[](const VisibleNode& a, const VisibleNode& b) { return a.Distance < b.Distance; });
+
+		// Most important missing nodes replace whatever the loader has not started
+		std::sort(requests.begin(), requests.end(), [](const Candidate& a, const Candidate& b) { return b < a; });
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (uint32_t index : m_LoadQueue) m_Nodes[index].State = NodeState::Unloaded;
+			m_LoadQueue.clear();
+
+			const size_t slots = static_cast<size_t>(std::max(m_Settings.MaxPendingLoads, 1));
+			for (const Candidate& request : requests)
+			{
+				if (m_LoadQueue.size() + m_Loading + m_Loaded.size() >= slots) break;
+				Node& node = m_Nodes[request.Index];
+				if (m_Records[request.Index].PointCount == 0)
+				{
+					node.State = NodeState::Resident;   // Nothing to load
+					continue;
+				}
+				node.State = NodeState::Queued;
+				m_LoadQueue.push_back(request.Index);
+			}
+			m_Stats.PendingLoads = static_cast<uint32_t>(m_LoadQueue.size() + m_Loading + m_Loaded.size());
+		}
+		m_Wake.notify_one();
+
+		Evict();
+
+		m_Stats.VisibleNodes = static_cast<uint32_t>(m_Visible.size());
+
+		// Throughput of the newest frame whose GPU time has resolved
+		const FrameTimings& resolved = Profiler::GetLastFrame();
+		if (resolved.Valid)
+		{
+			const size_t slot = static_cast<size_t>(resolved.Frame % ThroughputHistory);
+			const PassTiming* pass = resolved.Find(PassName);
+			if (pass && pass->GpuMs > 0.0 && m_DrawnFrame[slot] == resolved.Frame)
+			{
+				m_Stats.GpuMs = pass->GpuMs;
+				m_Stats.PointsPerSecond = static_cast<double>(m_DrawnPoints[slot]) / (pass->GpuMs * 1e-3);
+			}
+		}
+	}
+
+	void PointCloud::UploadLoaded()
+	{
+		std::vector<LoadedNode> loaded;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			loaded.swap(m_Loaded);
+		}
+
+		size_t next = 0;
+		for (; next < loaded.size(); next++)
+		{
+			const size_t bytes = loaded[next].Points.size() * sizeof(PointRecord);
+			if (m_Stats.UploadedBytes > 0 && m_Stats.UploadedBytes + bytes > m_Settings.UploadBytesPerFrame) break;
+			Upload(loaded[next].Index, loaded[next].Points);
+			m_Stats.UploadedBytes += bytes;
+		}
+
+		// Over budget: the rest waits for the next frame
+		if (next < loaded.size())
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Loaded.insert(m_Loaded.begin(), std::make_move_iterator(loaded.begin() + next), std::make_move_iterator(loaded.end()));
+		}
+	}
+
+	void PointCloud::Upload(uint32_t index, const std::vector<PointRecord>& points)
+	{
+		Node& node = m_Nodes[index];
+		const size_t bytes = points.size() * sizeof(PointRecord);
+
+		node.VBO = std::make_unique<VertexBuffer>(points.data(), static_cast<unsigned int>(bytes));
+		node.VAO = std::make_unique<VertexArray>();
+		VertexBufferLayout layout;
+		layout.Push<float>(3);           // Position
+		layout.Push<unsigned char>(4);   // Color (normalized)
+		node.VAO->LinkVertexBuffer(*node.VBO, layout);
+
+		node.State = NodeState::Resident;
+		node.LastUsed = m_Frame;
+		m_Stats.GpuBytes += bytes;
+		m_Stats.ResidentNodes++;
+	}
+
+	void PointCloud::Evict()
+	{
+		if (m_Stats.GpuBytes <= m_Settings.GpuMemoryBudget) return;
+
+		// Least recently used first, deepest first among equals
+		std::vector<uint32_t> candidates;
+		for (uint32_t i = 0; i < m_Nodes.size(); i++)
+		{
+			if (m_Nodes[i].VBO && m_Nodes[i].LastUsed != m_Frame) candidates.push_back(i);
+		}
+		std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b)
+		{
+			if (m_Nodes[a].LastUsed != m_Nodes[b].LastUsed) return m_Nodes[a].LastUsed < m_Nodes[b].LastUsed;
+			return m_Records[a].Level > m_Records[b].Level;
+		});
+
+		for (uint32_t index : candidates)
+		{
+			if (m_Stats.GpuBytes <= m_Settings.GpuMemoryBudget) break;
+			Node& node = m_Nodes[index];
+			node.VAO.reset();
+			node.VBO.reset();
+			node.State = NodeState::Unloaded;
+			m_Stats.GpuBytes -= m_Records[index].PointCount * sizeof(PointRecord);
+			m_Stats.ResidentNodes--;
+			m_Stats.EvictedNodes++;
+		}
+	}
+
+	void PointCloud::Render()
+	{
+		m_Stats.RenderedPoints = 0;
+		if (!IsOpen() || !m_Shader || !m_Shader->IsValid() || m_Visible.empty()) return;
+
+		// World units per local unit along the largest axis
+		const float scale = std::max({ glm::length(glm::vec3(m_Model[0])), glm::length(glm::vec3(m_Model[1])),
+			glm::length(glm::vec3(m_Model[2])) });
+
+		glEnable(GL_PROGRAM_POINT_SIZE);
+		m_Shader->Bind();
+		m_Shader->SetMatrix4fv("u_Model", m_Model);
+		m_Shader->SetMatrix4fv("u_View", m_View);
+		m_Shader->SetMatrix4fv("u_Projection", m_Projection);
+		m_Shader->SetFloat("u_PointScale", m_Settings.PointScale);
+		m_Shader->SetFloat("u_ProjScale", m_ProjScale);
+		m_Shader->SetVec2("u_SizeRange", glm::vec2(m_Settings.MinPointSize, m_Settings.MaxPointSize));
+		m_Shader->SetFloat("u_Brightness", m_Settings.Brightness);
+		m_Shader->SetBool("u_RoundPoints", m_Settings.RoundPoints);
+
+		// Front to back for early depth rejection
+		for (const VisibleNode& visible : m_Visible)
+		{
+			const Node& node = m_Nodes[visible.Index];
+			const uint32_t count = m_Records[visible.Index].PointCount;
+			const float spacing = NodeSize(visible.Index) * scale
+				/ static_cast<float>(m_Header.GridResolution) / static_cast<float>(1 << visible.RefinedLevels);
+
+			m_Shader->SetFloat("u_Spacing", spacing);
+			node.VAO->Bind();
+			glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+			m_Stats.RenderedPoints += count;
+		}
+		glDisable(GL_PROGRAM_POINT_SIZE);
+
+		const uint64_t frame = Profiler::GetFrameIndex();
+		m_DrawnFrame[frame % ThroughputHistory] = frame;
+		m_DrawnPoints[frame % ThroughputHistory] = m_Stats.RenderedPoints;
+	}
+}
@@ -0,0 +1,182 @@
+// VizEngine/src/VizEngine/Renderer/PointCloud.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/PointCloudFile.h"
+#include "glm.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VizEngine
+{
+	class Shader;
+	class VertexArray;
+	class VertexBuffer;
+
+	struct PointCloudSettings
+	{
+		uint64_t PointBudget = 5000000;          // Points drawn per frame
+		float MinNodePixels = 150.0f;            // Nodes smaller than this on screen are not refined
+		size_t GpuMemoryBudget = 512ull << 20;   // Resident node bytes before LRU eviction
+		size_t UploadBytesPerFrame = 24ull << 20;
+		int MaxPendingLoads = 64;                // Requests queued for the loader thread
+
+		float PointScale = 1.0f;                 // Point size relative to the node spacing
+		float MinPointSize = 1.0f;               // Pixels
+		float MaxPointSize = 32.0f;
+		float Brightness = 1.0f;                 // HDR multiplier of the sRGB point colors
+		bool RoundPoints = true;
+	};
+
+	struct PointCloudStats
+	{
+		uint64_t TotalPoints = 0;
+		uint32_t TotalNodes = 0;
+		uint32_t VisibleNodes = 0;               // Selected and resident this frame
+		uint64_t RenderedPoints = 0;
+		uint32_t ResidentNodes = 0;
+		size_t GpuBytes = 0;
+		uint32_t PendingLoads = 0;               // Queued, loading or waiting for upload
+		size_t UploadedBytes = 0;                // This frame
+		uint32_t EvictedNodes = 0;               // This frame
+		double GpuMs = 0.0;                      // PassName GPU time of the last resolved frame
+		double PointsPerSecond = 0.0;            // Points of that frame / GpuMs
+	};
+
+	/**
+	 * Out-of-core renderer for .vpc point cloud octrees (PointCloudConverter).
+	 *
+	 * Update() walks the octree from the root in order of projected node
+	 * size, skipping nodes outside the frustum, until the point budget is
+	 * spent or nodes get smaller than MinNodePixels on screen. Only resident
+	 * nodes are drawn and refined; missing ones are queued for a loader
+	 * thread, most important first, which copies their points out of the
+	 * memory-mapped file so page faults never hit the render thread. Loaded
+	 * nodes are uploaded within a per-frame byte budget, and the least
+	 * recently used nodes are evicted when GPU memory exceeds its budget.
+	 *
+	 * Render() draws the selected nodes front to back as GL_POINTS into the
+	 * bound (HDR) framebuffer with depth. Point size follows the node's
+	 * sample spacing, halved for every level of children that is drawn in
+	 * full below it, so the surface stays closed while refining.
+	 *
+	 * Wrap Render() in VP_PROFILE_PASS(PointCloud::PassName) for the
+	 * points/second statistic.
+	 *
+	 * Usage:
+	 *   cloud.Open("scan.vpc");
+	 *   cloud.Update(view, projection, viewportHeight);   // per frame
+	 *   { VP_PROFILE_PASS(PointCloud::PassName); cloud.Render(); }
+	 */
+	class VizEngine_API PointCloud
+	{
+	public:
+		static constexpr const char* PassName = "Point Cloud";
+
+		explicit PointCloud(const PointCloudSettings& settings = PointCloudSettings());
+		~PointCloud();
+
+		PointCloud(const PointCloud&) = delete;
+		PointCloud& operator=(const PointCloud&) = delete;
+
+		/**
+		 * Map a .vpc file and start its loader thread.
+		 * @return false if the file is missing or malformed (logged)
+		 */
+		bool Open(const std::string& path);
+		void Close();
+		bool IsOpen() const { return m_File.IsOpen(); }
+
+		/** Local-to-world transform; local space is [0, GetSize()]^3. */
+		void SetTransform(const glm::mat4& model) { m_Model = model; }
+		const glm::mat4& GetTransform() const { return m_Model; }
+
+		/** Edge length of the octree cube in source units. */
+		float GetSize() const { return static_cast<float>(m_Header.Size); }
+		/** Source coordinates of local (0, 0, 0). */
+		glm::dvec3 GetOrigin() const { return glm::dvec3(m_Header.Min[0], m_Header.Min[1], m_Header.Min[2]); }
+
+		/**
+		 * Select nodes, queue loads, upload finished loads and evict.
+		 * @param viewportHeight Height in pixels of the target
+		 */
+		void Update(const glm::mat4& view, const glm::mat4& projection, int viewportHeight);
+
+		/**
+		 * Draw the nodes selected by the last Update() with its camera.
+		 */
+		void Render();
+
+		PointCloudSettings& GetSettings() { return m_Settings; }
+		const PointCloudStats& GetStats() const { return m_Stats; }
+
+	private:
+		enum class NodeState : uint8_t { Unloaded, Queued, Resident };
+
+		struct Node
+		{
+			NodeState State = NodeState::Unloaded;
+			uint64_t LastUsed = 0;
+			std::unique_ptr<VertexBuffer> VBO;
+			std::unique_ptr<VertexArray> VAO;
+		};
+
+		struct VisibleNode
+		{
+			uint32_t Index = 0;
+			float Distance = 0.0f;    // Camera to node center, local units
+			int RefinedLevels = 0;    // Levels below drawn in full
+		};
+
+		struct LoadedNode
+		{
+			uint32_t Index = 0;
+			std::vector<PointCloudFormat::PointRecord> Points;
+		};
+
+		void LoaderMain();
+		void UploadLoaded();
+		void Evict();
+		void Upload(uint32_t index, const std::vector<PointCloudFormat::PointRecord>& points);
+		float NodeSize(uint32_t index) const;
+
+		PointCloudSettings m_Settings;
+		PointCloudStats m_Stats;
+		glm::mat4 m_Model = glm::mat4(1.0f);
+
+		MappedFile m_File;
+		PointCloudFormat::Header m_Header{};
+		std::vector<PointCloudFormat::NodeRecord> m_Records;
+		std::vector<Node> m_Nodes;
+		std::vector<VisibleNode> m_Visible;
+		std::unique_ptr<Shader> m_Shader;
+
+		// Camera of the last Update()
+		glm::mat4 m_View = glm::mat4(1.0f);
+		glm::mat4 m_Projection = glm::mat4(1.0f);
+		float m_ProjScale = 0.0f;     // Pixels per unit at unit view depth
+		uint64_t m_Frame = 0;
+
+		// Loader thread
+		std::thread m_Loader;
+		std::mutex m_Mutex;
+		std::condition_variable m_Wake;
+		std::deque<uint32_t> m_LoadQueue;             // Highest priority first
+		std::vector<LoadedNode> m_Loaded;             // Waiting for upload
+		uint32_t m_Loading = 0;                       // Taken by the loader, not yet returned
+		bool m_Stop = false;
+
+		// Points drawn per Profiler frame, matched to resolved GPU times
+		static constexpr size_t ThroughputHistory = 16;
+		uint64_t m_DrawnFrame[ThroughputHistory] = {};
+		uint64_t m_DrawnPoints[ThroughputHistory] = {};
+	};
+}
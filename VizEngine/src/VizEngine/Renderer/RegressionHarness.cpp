@@ -0,0 +1,621 @@
+// VizEngine/src/VizEngine/Renderer/RegressionHarness.cpp
+
+#include "RegressionHarness.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// =====================================================================
+		// Color conversion (sRGB8 -> CIELAB, D65)
+		// =====================================================================
+
+		const std::array<float, 256>& SrgbToLinearTable()
+		{
+			static const std::array<float, 256> table = [] {
+				std::array<float, 256> t{};
+				for (int i = 0; i < 256; i++)
+				{
+					float c = static_cast<float>(i) / 255.0f;
+					t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+				}
+				return t;
+			}();
+			return table;
+		}
+
+		float LabF(float t)
+		{
+			return t > 0.008856f ? std::cbrt(t) : 7.787f * t + 16.0f / 116.0f;
+		}
+
+		std::vector<float> ToLab(const RegressionImage& image)
+		{
+			const auto& lut = SrgbToLinearTable();
+			const size_t count = static_cast<size_t>(image.Width) * static_cast<size_t>(image.Height);
+
+			std::vector<float> lab(count * 3);
+			for (size_t i = 0; i < count; i++)
+			{
+				float r = lut[image.Pixels[i * 3 + 0]];
+				float g = lut[image.Pixels[i * 3 + 1]];
+				float b = lut[image.Pixels[i * 3 + 2]];
+
+				float x = (0.4124f * r + 0.3576f * g + 0.1805f * b) / 0.95047f;
+				float y = (0.2126f * r + 0.7152f * g + 0.0722f * b);
+				float z = (0.0193f * r + 0.1192f * g + 0.9505f * b) / 1.08883f;
+
+				float fx = LabF(x);
+				float fy = LabF(y);
+				float fz = LabF(z);
+
+				lab[i * 3 + 0] = 116.0f * fy - 16.0f;
+				lab[i * 3 + 1] = 500.0f * (fx - fy);
+				lab[i * 3 + 2] = 200.0f * (fy - fz);
+			}
+			return lab;
+		}
+
+		// Smallest delta E between pixel (x, y) of `from` and any pixel of `to` near (x, y)
+		float NearestDeltaE(const std::vector<float>& from, const std::vector<float>& to,
+			int x, int y, int width, int height, int radius)
+		{
+			const float* p = &from[(static_cast<size_t>(y) * width + x) * 3];
+			float best = 1.0e30f;
+
+			for (int dy = -radius; dy <= radius; dy++)
+			{
+				int ny = y + dy;
+				if (ny < 0 || ny >= height) continue;
+				for (int dx = -radius; dx <= radius; dx++)
+				{
+					int nx = x + dx;
+					if (nx < 0 || nx >= width) continue;
+
+					const float* q = &to[(static_cast<size_t>(ny) * width + nx) * 3];
+					float dl = p[0] - q[0];
+					float da = p[1] - q[1];
+					float db = p[2] - q[2];
+					best = std::min(best, dl * dl + da * da + db * db);
+				}
+			}
+			return std::sqrt(best);
+		}
+
+		double Median(std::vector<double> values)
+		{
+			if (values.empty()) return 0.0;
+			std::sort(values.begin(), values.end());
+			size_t mid = values.size() / 2;
+			return values.size() % 2 == 1 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+		}
+
+		std::string SanitizeField(std::string value)
+		{
+			std::replace(value.begin(), value.end(), ',', ';');
+			std::replace(value.begin(), value.end(), '\n', ' ');
+			return value;
+		}
+
+		std::vector<std::string> SplitCsvLine(const std::string& line)
+		{
+			std::vector<std::string> fields;
+			std::stringstream stream(line);
+			std::string field;
+			while (std::getline(stream, field, ','))
+			{
+				fields.push_back(field);
+			}
+			return fields;
+		}
+
+		void EnsureParentDirectory(const std::string& path)
+		{
+			std::filesystem::path parent = std::filesystem::path(path).parent_path();
+			if (!parent.empty())
+			{
+				std::error_code ec;
+				std::filesystem::create_directories(parent, ec);
+			}
+		}
+
+		const char* kHistoryHeader = "run,renderer,case,pass,cpu_ms,gpu_ms";
+	}
+
+	RegressionHarness::RegressionHarness(const RegressionConfig& config)
+		: m_Config(config)
+	{
+		m_Config.MeasureFrames = std::max(1u, m_Config.MeasureFrames);
+	}
+
+	void RegressionHarness::AddCase(const std::string& name, std::function<void()> setup)
+	{
+		m_Cases.push_back({ name, std::move(setup) });
+	}
+
+	void RegressionHarness::Start()
+	{
+		m_Results.clear();
+		m_CaseIndex = 0;
+		m_Phase = Phase::Setup;
+		m_PhaseFrames = 0;
+		m_Finished = m_Cases.empty();
+		m_Running = !m_Cases.empty();
+
+		const GLubyte* renderer = glGetString(GL_RENDERER);
+		m_RendererName = SanitizeField(renderer ? reinterpret_cast<const char*>(renderer) : "unknown");
+
+		auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+		m_RunStamp = std::to_string(seconds);
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_Config.GoldenDir, ec);
+		std::filesystem::create_directories(m_Config.OutputDir, ec);
+
+		if (!Profiler::IsEnabled())
+		{
+			VP_CORE_WARN("RegressionHarness: Profiler disabled, no timings will be recorded");
+		}
+
+		VP_CORE_INFO("RegressionHarness: {} case(s) on '{}'{}", m_Cases.size(), m_RendererName,
+			m_Config.UpdateGoldens ? " (updating goldens)" : "");
+	}
+
+	void RegressionHarness::BeginFrame()
+	{
+		if (!m_Running) return;
+
+		AccumulateTimings();
+
+		if (m_Phase == Phase::Drain)
+		{
+			// Finish once every measured frame has resolved, or give up on timings
+			// if the profiler is not producing them
+			m_PhaseFrames++;
+			if (m_LastAccumulatedFrame >= m_LastMeasuredFrame ||
+				m_PhaseFrames > static_cast<uint32_t>(Profiler::MaxFramesInFlight) + 2)
+			{
+				FinishCase();
+				if (!m_Running) return;
+			}
+			else
+			{
+				return;
+			}
+		}
+
+		if (m_Phase == Phase::Setup)
+		{
+			const Case& current = m_Cases[m_CaseIndex];
+			VP_CORE_INFO("RegressionHarness: [{}/{}] {}", m_CaseIndex + 1, m_Cases.size(), current.Name);
+			if (current.Setup) current.Setup();
+
+			m_Phase = Phase::Warmup;
+			m_PhaseFrames = 0;
+		}
+	}
+
+	void RegressionHarness::EndFrame(int width, int height)
+	{
+		if (!m_Running) return;
+
+		switch (m_Phase)
+		{
+		case Phase::Warmup:
+			if (++m_PhaseFrames >= m_Config.WarmupFrames)
+			{
+				m_Phase = Phase::Measure;
+				m_PhaseFrames = 0;
+				m_FirstMeasuredFrame = Profiler::GetFrameIndex() + 1;
+				m_LastMeasuredFrame = m_FirstMeasuredFrame;
+				m_LastAccumulatedFrame = 0;
+				m_PassNames.clear();
+				m_CpuSamples.clear();
+				m_GpuSamples.clear();
+			}
+			break;
+
+		case Phase::Measure:
+			m_LastMeasuredFrame = Profiler::GetFrameIndex();
+			if (++m_PhaseFrames >= m_Config.MeasureFrames)
+			{
+				// The final measured frame is the one compared
+				m_Capture = Capture(width, height);
+				m_Phase = Phase::Drain;
+				m_PhaseFrames = 0;
+			}
+			break;
+
+		case Phase::Setup:
+		case Phase::Drain:
+			break;
+		}
+	}
+
+	int RegressionHarness::GetExitCode() const
+	{
+		if (!m_Finished) return 1;
+
+		// A checkout without goldens for this renderer has nothing to compare
+		// against; report that apart from real failures
+		bool goldenMissing = false;
+		for (const RegressionResult& result : m_Results)
+		{
+			if (result.Passed()) continue;
+			if (!result.GoldenMissing || !result.TimingPassed) return 1;
+			goldenMissing = true;
+		}
+		return goldenMissing ? SkippedExitCode : 0;
+	}
+
+	void RegressionHarness::AccumulateTimings()
+	{
+		const FrameTimings& frame = Profiler::GetLastFrame();
+		if (!frame.Valid || m_FirstMeasuredFrame == 0) return;
+		if (frame.Frame <= m_LastAccumulatedFrame) return;
+		if (frame.Frame < m_FirstMeasuredFrame || frame.Frame > m_LastMeasuredFrame) return;
+
+		m_LastAccumulatedFrame = frame.Frame;
+
+		auto addSample = [this](const std::string& name, double cpuMs, double gpuMs) {
+			auto it = std::find(m_PassNames.begin(), m_PassNames.end(), name);
+			size_t index = static_cast<size_t>(it - m_PassNames.begin());
+			if (it == m_PassNames.end())
+			{
+				m_PassNames.push_back(name);
+				m_CpuSamples.emplace_back();
+				m_GpuSamples.emplace_back();
+			}
+			m_CpuSamples[index].push_back(cpuMs);
+			m_GpuSamples[index].push_back(gpuMs);
+		};
+
+		addSample("Frame", frame.CpuFrameMs, frame.GpuFrameMs);
+		for (const PassTiming& pass : frame.Passes)
+		{
+			addSample(pass.Name, pass.CpuMs, pass.GpuMs);
+		}
+	}
+
+	void RegressionHarness::FinishCase()
+	{
+		const Case& current = m_Cases[m_CaseIndex];
+
+		RegressionResult result;
+		result.Name = current.Name;
+
+		// =====================================================================
+		// Image
+		// =====================================================================
+		const std::string goldenPath = m_Config.GoldenDir + "/" + current.Name + ".ppm";
+		const std::string actualPath = m_Config.OutputDir + "/" + current.Name + ".ppm";
+		SavePPM(actualPath, m_Capture);
+
+		if (m_Config.UpdateGoldens)
+		{
+			result.ImagePassed = SavePPM(goldenPath, m_Capture);
+			result.Image.Passed = result.ImagePassed;
+		}
+		else
+		{
+			RegressionImage golden;
+			if (!LoadPPM(goldenPath, golden))
+			{
+				result.GoldenMissing = true;
+				result.ImagePassed = false;
+				VP_CORE_ERROR("RegressionHarness: {} has no golden image ({}); record one with UpdateGoldens",
+					current.Name, goldenPath);
+			}
+			else
+			{
+				result.Image = Compare(m_Capture, golden, m_Config.Tolerance);
+				result.ImagePassed = result.Image.Passed;
+				if (!result.ImagePassed && !result.Image.Visualization.IsEmpty())
+				{
+					SavePPM(m_Config.OutputDir + "/" + current.Name + "_diff.ppm", result.Image.Visualization);
+				}
+			}
+		}
+
+		// =====================================================================
+		// Timings
+		// =====================================================================
+		for (size_t i = 0; i < m_PassNames.size(); i++)
+		{
+			PassTiming timing;
+			timing.Name = m_PassNames[i];
+			timing.CpuMs = Median(m_CpuSamples[i]);
+			timing.GpuMs = Median(m_GpuSamples[i]);
+			result.Timings.push_back(std::move(timing));
+		}
+		CheckTimings(result);
+
+		// =====================================================================
+		// Report
+		// =====================================================================
+		if (result.Image.SizeMismatch)
+		{
+			VP_CORE_ERROR("RegressionHarness: {} size differs from golden", result.Name);
+		}
+		else if (!result.GoldenMissing && !m_Config.UpdateGoldens)
+		{
+			if (result.ImagePassed)
+			{
+				VP_CORE_INFO("RegressionHarness: {} image ok (mean dE {:.3f}, max dE {:.2f}, {:.3f}% differ)",
+					result.Name, result.Image.MeanDeltaE, result.Image.MaxDeltaE, result.Image.DifferentPercent);
+			}
+			else
+			{
+				VP_CORE_ERROR("RegressionHarness: {} image DIVERGED (mean dE {:.3f}, max dE {:.2f}, {:.3f}% differ)",
+					result.Name, result.Image.MeanDeltaE, result.Image.MaxDeltaE, result.Image.DifferentPercent);
+			}
+		}
+		for (const std::string& regression : result.Regressions)
+		{
+			VP_CORE_ERROR("RegressionHarness: {} {}", result.Name, regression);
+		}
+
+		m_Results.push_back(std::move(result));
+
+		// =====================================================================
+		// Next case
+		// =====================================================================
+		m_CaseIndex++;
+		m_Phase = Phase::Setup;
+		m_PhaseFrames = 0;
+		m_FirstMeasuredFrame = 0;
+
+		if (m_CaseIndex >= m_Cases.size())
+		{
+			m_Running = false;
+			m_Finished = true;
+
+			size_t failed = 0;
+			for (const RegressionResult& r : m_Results)
+			{
+				if (!r.Passed()) failed++;
+			}
+			if (failed == 0)
+				VP_CORE_INFO("RegressionHarness: all {} case(s) passed", m_Results.size());
+			else
+				VP_CORE_ERROR("RegressionHarness: {} of {} case(s) failed", failed, m_Results.size());
+		}
+	}
+
+	void RegressionHarness::CheckTimings(RegressionResult& result)
+	{
+		// Baseline per pass: median of the last HistoryWindow runs on this renderer
+		std::vector<std::vector<double>> history(result.Timings.size());
+
+		std::ifstream in(m_Config.HistoryFile);
+		bool hasHeader = false;
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line == kHistoryHeader)
+			{
+				hasHeader = true;
+				continue;
+			}
+
+			std::vector<std::string> fields = SplitCsvLine(line);
+			if (fields.size() < 6) continue;
+			if (fields[1] != m_RendererName || fields[2] != result.Name) continue;
+
+			for (size_t i = 0; i < result.Timings.size(); i++)
+			{
+				if (fields[3] != result.Timings[i].Name) continue;
+
+				// Compare GPU time when the run measured it, CPU time otherwise
+				bool useGpu = result.Timings[i].GpuMs > 0.0;
+				history[i].push_back(std::atof(fields[useGpu ? 5 : 4].c_str()));
+			}
+		}
+		in.close();
+
+		for (size_t i = 0; i < result.Timings.size(); i++)
+		{
+			std::vector<double>& samples = history[i];
+			if (samples.empty()) continue;
+			if (samples.size() > m_Config.HistoryWindow)
+			{
+				samples.erase(samples.begin(), samples.end() - m_Config.HistoryWindow);
+			}
+
+			const PassTiming& timing = result.Timings[i];
+			bool useGpu = timing.GpuMs > 0.0;
+			double current = useGpu ? timing.GpuMs : timing.CpuMs;
+			double baseline = Median(samples);
+
+			if (current > baseline * (1.0 + m_Config.TimeRegressionThreshold) &&
+				current - baseline > m_Config.MinRegressionMs)
+			{
+				result.TimingPassed = false;
+				std::ostringstream message;
+				message << timing.Name << " " << (useGpu ? "GPU" : "CPU") << " time regressed: "
+					<< current << " ms vs baseline " << baseline << " ms";
+				result.Regressions.push_back(message.str());
+			}
+		}
+
+		// Append this run
+		EnsureParentDirectory(m_Config.HistoryFile);
+		std::ofstream out(m_Config.HistoryFile, std::ios::app);
+		if (!out)
+		{
+			VP_CORE_WARN("RegressionHarness: Cannot write history file {}", m_Config.HistoryFile);
+			return;
+		}
+		if (!hasHeader)
+		{
+			out << kHistoryHeader << "\n";
+		}
+		for (const PassTiming& timing : result.Timings)
+		{
+			out << m_RunStamp << "," << m_RendererName << "," << SanitizeField(result.Name) << ","
+				<< SanitizeField(timing.Name) << "," << timing.CpuMs << "," << timing.GpuMs << "\n";
+		}
+	}
+
+	// =========================================================================
+	// Image utilities
+	// =========================================================================
+
+	RegressionImage RegressionHarness::Capture(int width, int height)
+	{
+		RegressionImage image;
+		if (width <= 0 || height <= 0) return image;
+
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 3);
+
+		GLint previousReadFramebuffer = 0;
+		GLint previousAlignment = 4;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+		glGetIntegerv(GL_PACK_ALIGNMENT, &previousAlignment);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		glReadBuffer(GL_BACK);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, image.Pixels.data());
+
+		glPixelStorei(GL_PACK_ALIGNMENT, previousAlignment);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFramebuffer));
+
+		// GL rows are bottom-up
+		const size_t rowSize = static_cast<size_t>(width) * 3;
+		std::vector<uint8_t> row(rowSize);
+		for (int y = 0; y < height / 2; y++)
+		{
+			uint8_t* top = &image.Pixels[static_cast<size_t>(y) * rowSize];
+			uint8_t* bottom = &image.Pixels[static_cast<size_t>(height - 1 - y) * rowSize];
+			std::copy(top, top + rowSize, row.data());
+			std::copy(bottom, bottom + rowSize, top);
+			std::copy(row.begin(), row.end(), bottom);
+		}
+
+		return image;
+	}
+
+	ImageDiff RegressionHarness::Compare(const RegressionImage& actual, const RegressionImage& golden, const ImageTolerance& tolerance)
+	{
+		ImageDiff diff;
+		if (actual.Width != golden.Width || actual.Height != golden.Height || actual.IsEmpty())
+		{
+			diff.SizeMismatch = true;
+			diff.Passed = false;
+			return diff;
+		}
+
+		const int width = actual.Width;
+		const int height = actual.Height;
+		const int radius = std::max(0, tolerance.NeighborhoodRadius);
+
+		std::vector<float> labActual = ToLab(actual);
+		std::vector<float> labGolden = ToLab(golden);
+
+		diff.Visualization.Width = width;
+		diff.Visualization.Height = height;
+		diff.Visualization.Pixels.resize(golden.Pixels.size());
+
+		double total = 0.0;
+		size_t different = 0;
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				// Symmetric: a feature missing from either image counts
+				float d = std::max(
+					NearestDeltaE(labActual, labGolden, x, y, width, height, radius),
+					NearestDeltaE(labGolden, labActual, x, y, width, height, radius));
+
+				total += d;
+				diff.MaxDeltaE = std::max(diff.MaxDeltaE, d);
+
+				size_t i = (static_cast<size_t>(y) * width + x) * 3;
+				uint8_t* out = &diff.Visualization.Pixels[i];
+				if (d > tolerance.PixelDeltaE)
+				{
+					different++;
+					out[0] = static_cast<uint8_t>(std::min(255.0f, 128.0f + d * 8.0f));
+					out[1] = 0;
+					out[2] = 0;
+				}
+				else
+				{
+					uint8_t gray = static_cast<uint8_t>(labGolden[i] * 0.3f * 2.55f);
+					out[0] = out[1] = out[2] = gray;
+				}
+			}
+		}
+
+		const double pixels = static_cast<double>(width) * static_cast<double>(height);
+		diff.MeanDeltaE = static_cast<float>(total / pixels);
+		diff.DifferentPercent = static_cast<float>(100.0 * static_cast<double>(different) / pixels);
+		diff.Passed = diff.DifferentPercent <= tolerance.MaxDifferentPercent &&
+			diff.MeanDeltaE <= tolerance.MaxMeanDeltaE;
+		return diff;
+	}
+
+	bool RegressionHarness::SavePPM(const std::string& path, const RegressionImage& image)
+	{
+		if (image.IsEmpty()) return false;
+
+		EnsureParentDirectory(path);
+		std::ofstream out(path, std::ios::binary);
+		if (!out)
+		{
+			VP_CORE_ERROR("RegressionHarness: Cannot write {}", path);
+			return false;
+		}
+
+		out << "P6\n" << image.Width << " " << image.Height << "\n255\n";
+		out.write(reinterpret_cast<const char*>(image.Pixels.data()), static_cast<std::streamsize>(image.Pixels.size()));
+		return static_cast<bool>(out);
+	}
+
+	bool RegressionHarness::LoadPPM(const std::string& path, RegressionImage& image)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in) return false;
+
+		// Header tokens, skipping '#' comments
+		auto nextToken = [&in]() {
+			std::string token;
+			while (in >> token)
+			{
+				if (token[0] != '#') return token;
+				std::string rest;
+				std::getline(in, rest);
+			}
+			return std::string();
+		};
+
+		if (nextToken() != "P6") return false;
+		int width = std::atoi(nextToken().c_str());
+		int height = std::atoi(nextToken().c_str());
+		int maxValue = std::atoi(nextToken().c_str());
+		if (width <= 0 || height <= 0 || maxValue != 255) return false;
+		in.get();   // Single whitespace before the data
+
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 3);
+		in.read(reinterpret_cast<char*>(image.Pixels.data()), static_cast<std::streamsize>(image.Pixels.size()));
+		return static_cast<bool>(in);
+	}
+}
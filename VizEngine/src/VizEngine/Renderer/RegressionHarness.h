@@ -0,0 +1,203 @@
+// VizEngine/src/VizEngine/Renderer/RegressionHarness.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Profiler.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * 8-bit RGB image, rows top to bottom.
+	 */
+	struct RegressionImage
+	{
+		int Width = 0;
+		int Height = 0;
+		std::vector<uint8_t> Pixels;   // Width * Height * 3
+
+		bool IsEmpty() const { return Pixels.empty(); }
+	};
+
+	/**
+	 * When two images count as the same.
+	 *
+	 * Differences are measured as CIE76 delta E in CIELAB, so they track
+	 * perceived color difference rather than raw byte distance. A pixel may
+	 * match anywhere within NeighborhoodRadius of its position in the other
+	 * image, which forgives one-pixel edge shifts from rasterization or
+	 * anti-aliasing differences between drivers.
+	 */
+	struct ImageTolerance
+	{
+		float PixelDeltaE = 2.3f;           // Just-noticeable difference; pixels above differ
+		float MaxDifferentPercent = 0.1f;   // Share of differing pixels allowed
+		float MaxMeanDeltaE = 0.5f;         // Average over all pixels
+		int NeighborhoodRadius = 1;         // 0 = exact pixel positions
+	};
+
+	/**
+	 * Result of comparing a capture against its golden image.
+	 */
+	struct ImageDiff
+	{
+		float MeanDeltaE = 0.0f;
+		float MaxDeltaE = 0.0f;
+		float DifferentPercent = 0.0f;
+		bool SizeMismatch = false;
+		bool Passed = false;
+		RegressionImage Visualization;   // Differing pixels in red over the dimmed golden
+	};
+
+	/**
+	 * Settings for a regression run.
+	 */
+	struct RegressionConfig
+	{
+		std::string GoldenDir = "regression/golden";
+		std::string OutputDir = "regression/output";   // Captures and diff images
+		std::string HistoryFile = "regression/history.csv";
+
+		ImageTolerance Tolerance;
+
+		uint32_t WarmupFrames = 5;      // Rendered after setup, not measured
+		uint32_t MeasureFrames = 30;    // Timings are the median over these
+
+		float TimeRegressionThreshold = 0.25f;   // Fail if slower than baseline by this fraction...
+		double MinRegressionMs = 0.5;            // ...and by at least this many milliseconds
+		uint32_t HistoryWindow = 10;             // Baseline = median of the last N runs
+
+		bool UpdateGoldens = false;     // Overwrite goldens instead of comparing
+	};
+
+	/**
+	 * Outcome of one case.
+	 */
+	struct RegressionResult
+	{
+		std::string Name;
+		ImageDiff Image;
+		bool GoldenMissing = false;
+		bool ImagePassed = false;
+		bool TimingPassed = true;
+		std::vector<PassTiming> Timings;        // Median per pass; "Frame" is the whole frame
+		std::vector<std::string> Regressions;   // Human-readable timing failures
+
+		bool Passed() const { return ImagePassed && TimingPassed; }
+	};
+
+	/**
+	 * Golden-image and frame-time regression checks.
+	 *
+	 * The application registers canonical cases, each a setup callback that
+	 * puts the scene, camera and settings into a fixed state. The harness
+	 * then drives them one after another from the normal frame loop: setup,
+	 * warm-up frames, measured frames, then a capture of the final frame that
+	 * is compared against GoldenDir/<case>.ppm. Per-pass medians from the
+	 * Profiler are compared against the recent history for the same GL
+	 * renderer and appended to HistoryFile as CSV.
+	 *
+	 * Intended to run headless (e.g. Mesa llvmpipe with
+	 * LIBGL_ALWAYS_SOFTWARE=1 under xvfb-run) so captures are reproducible;
+	 * goldens recorded on one renderer should only be compared on the same.
+	 *
+	 * Usage (per frame):
+	 *   harness.BeginFrame();          // Before update/render; runs setups
+	 *   ... render into the default framebuffer ...
+	 *   harness.EndFrame(w, h);        // After render, before UI and swap
+	 *   if (harness.IsFinished()) Engine::Get().Quit();
+	 */
+	class VizEngine_API RegressionHarness
+	{
+	public:
+		explicit RegressionHarness(const RegressionConfig& config = {});
+
+		/**
+		 * Register a case. Names become file names.
+		 */
+		void AddCase(const std::string& name, std::function<void()> setup);
+
+		/**
+		 * Start running the registered cases.
+		 */
+		void Start();
+
+		void BeginFrame();
+		void EndFrame(int width, int height);
+
+		bool IsRunning() const { return m_Running; }
+		bool IsFinished() const { return m_Finished; }
+
+		/** Exit code when no golden exists yet and nothing else failed (CTest SKIP_RETURN_CODE). */
+		static constexpr int SkippedExitCode = 77;
+
+		/**
+		 * @return 0 if every case passed, SkippedExitCode if the only failures
+		 * are missing goldens, 1 otherwise
+		 */
+		int GetExitCode() const;
+
+		const std::vector<RegressionResult>& GetResults() const { return m_Results; }
+		const RegressionConfig& GetConfig() const { return m_Config; }
+
+		// =====================================================================
+		// Image utilities
+		// =====================================================================
+
+		/**
+		 * Read the default framebuffer's back buffer (before SwapBuffers).
+		 */
+		static RegressionImage Capture(int width, int height);
+
+		static ImageDiff Compare(const RegressionImage& actual, const RegressionImage& golden, const ImageTolerance& tolerance);
+
+		/** Binary PPM (P6), readable by most image tools. */
+		static bool SavePPM(const std::string& path, const RegressionImage& image);
+		static bool LoadPPM(const std::string& path, RegressionImage& image);
+
+	private:
+		enum class Phase : uint8_t
+		{
+			Setup,
+			Warmup,
+			Measure,
+			Drain    // Waiting for the last measured frames' GPU timings
+		};
+
+		struct Case
+		{
+			std::string Name;
+			std::function<void()> Setup;
+		};
+
+		void FinishCase();
+		void CheckTimings(RegressionResult& result);
+		void AccumulateTimings();
+
+		RegressionConfig m_Config;
+		std::vector<Case> m_Cases;
+		std::vector<RegressionResult> m_Results;
+
+		bool m_Running = false;
+		bool m_Finished = false;
+		size_t m_CaseIndex = 0;
+		Phase m_Phase = Phase::Setup;
+		uint32_t m_PhaseFrames = 0;
+
+		// Profiler frames belonging to the current case's measurement
+		uint64_t m_FirstMeasuredFrame = 0;
+		uint64_t m_LastMeasuredFrame = 0;
+		uint64_t m_LastAccumulatedFrame = 0;
+		std::vector<std::string> m_PassNames;
+		std::vector<std::vector<double>> m_CpuSamples;   // Parallel to m_PassNames
+		std::vector<std::vector<double>> m_GpuSamples;
+
+		RegressionImage m_Capture;
+		std::string m_RendererName;
+		std::string m_RunStamp;
+	};
+}
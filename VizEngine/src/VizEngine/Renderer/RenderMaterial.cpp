@@ -85,22 +85,57 @@ namespace VizEngine
     // Texture Binding
     // =========================================================================
 
-    void RenderMaterial::SetTexture(const std::string& name, std::shared_ptr<Texture> texture, int slot, bool isCubemap)
+    void RenderMaterial::SetTexture(const std::string& name, const std::shared_ptr<Texture>& texture, int slot, bool isCubemap)
+    {
+        TextureSlot& texSlot = FindOrAddTextureSlot(name);
+        texSlot.TextureRef = texture;
+        texSlot.Bound = texture.get();
+        texSlot.Slot = slot;
+        texSlot.IsCubemap = isCubemap;
+    }
+
+    void RenderMaterial::SetTexture(const std::string& name, const Texture* texture, int slot, bool isCubemap)
+    {
+        TextureSlot& texSlot = FindOrAddTextureSlot(name);
+
+        // Keep an existing owning reference when it already points at this texture
+        if (texSlot.TextureRef.get() != texture)
+        {
+            texSlot.TextureRef.reset();
+        }
+        texSlot.Bound = texture;
+        texSlot.Slot = slot;
+        texSlot.IsCubemap = isCubemap;
+    }
+
+    void RenderMaterial::ClearTexture(const std::string& name)
     {
-        // Check if slot already exists, update it
         for (auto& texSlot : m_TextureSlots)
         {
             if (texSlot.UniformName == name)
             {
-                texSlot.TextureRef = texture;
-                texSlot.Slot = slot;
-                texSlot.IsCubemap = isCubemap;
+                texSlot.TextureRef.reset();
+                texSlot.Bound = nullptr;
                 return;
             }
         }
+    }
+
+    TextureSlot& RenderMaterial::FindOrAddTextureSlot(const std::string& name)
+    {
+        // Check if slot already exists, update it
+        for (auto& texSlot : m_TextureSlots)
+        {
+            if (texSlot.UniformName == name)
+            {
+                return texSlot;
+            }
+        }
 
         // Add new slot
-        m_TextureSlots.emplace_back(name, texture, slot, isCubemap);
+        TextureSlot& texSlot = m_TextureSlots.emplace_back();
+        texSlot.UniformName = name;
+        return texSlot;
     }
 
     // =========================================================================
@@ -169,9 +204,9 @@ namespace VizEngine
 
         for (const auto& texSlot : m_TextureSlots)
         {
-            if (texSlot.TextureRef)
+            if (texSlot.Bound)
             {
-                texSlot.TextureRef->Bind(texSlot.Slot);
+                texSlot.Bound->Bind(texSlot.Slot);
                 m_Shader->SetInt(texSlot.UniformName, texSlot.Slot);
             }
         }
@@ -80,7 +80,20 @@ namespace VizEngine
          * @param slot Texture unit (0-15)
          * @param isCubemap True if texture is a cubemap
          */
-        void SetTexture(const std::string& name, std::shared_ptr<Texture> texture, int slot, bool isCubemap = false);
+        void SetTexture(const std::string& name, const std::shared_ptr<Texture>& texture, int slot, bool isCubemap = false);
+
+        /**
+         * Set a borrowed texture (no ownership, no refcount traffic).
+         * For per-draw rebinding from resolved resource handles; the caller
+         * keeps the texture alive until the next Bind().
+         */
+        void SetTexture(const std::string& name, const Texture* texture, int slot, bool isCubemap = false);
+
+        /**
+         * Unbind a sampler: drops the owning reference and the borrowed
+         * pointer, so BindTextures() no longer touches the texture.
+         */
+        void ClearTexture(const std::string& name);
 
         // =====================================================================
         // Parameter Query
@@ -109,7 +122,7 @@ namespace VizEngine
         const std::string& GetName() const { return m_Name; }
         void SetName(const std::string& name) { m_Name = name; }
 
-        std::shared_ptr<Shader> GetShader() const { return m_Shader; }
+        const std::shared_ptr<Shader>& GetShader() const { return m_Shader; }
         void SetShader(std::shared_ptr<Shader> shader) { m_Shader = shader; }
 
         bool IsValid() const { return m_Shader != nullptr; }
@@ -126,6 +139,8 @@ namespace VizEngine
          */
         virtual void BindTextures();
 
+        TextureSlot& FindOrAddTextureSlot(const std::string& name);
+
     protected:
         std::string m_Name;
         std::shared_ptr<Shader> m_Shader;
@@ -0,0 +1,806 @@
+// VizEngine/src/VizEngine/Renderer/RenderService.cpp
+
+#include "RenderService.h"
+#include "VizEngine/Renderer/PBRMaterial.h"
+#include "VizEngine/Renderer/RegressionHarness.h"
+#include "VizEngine/Renderer/Skybox.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/CubemapUtils.h"
+#include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/FullscreenQuad.h"
+#include "VizEngine/OpenGL/Renderer.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/Core/Camera.h"
+#include "VizEngine/Core/MetricsExporter.h"
+#include "VizEngine/Engine.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+	using SocketHandle = SOCKET;
+	constexpr SocketHandle kInvalidSocket = INVALID_SOCKET;
+	constexpr int kSendFlags = 0;
+#else
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <netinet/in.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+	#include <cerrno>
+	using SocketHandle = int;
+	constexpr SocketHandle kInvalidSocket = -1;
+	// A client that hangs up before its reply must not raise SIGPIPE in the host
+	#ifdef MSG_NOSIGNAL
+		constexpr int kSendFlags = MSG_NOSIGNAL;
+	#else
+		constexpr int kSendFlags = 0;   // Apple: SO_NOSIGPIPE is set per client instead
+	#endif
+#endif
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr size_t MaxUnsentBytes = 1 << 20;   // Clients that stop reading are dropped
+
+		double NowSeconds()
+		{
+			using Clock = std::chrono::steady_clock;
+			return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+		}
+
+		void CloseSocket(SocketHandle socket)
+		{
+#ifdef _WIN32
+			closesocket(socket);
+#else
+			::close(socket);
+#endif
+		}
+
+		bool SetNonBlocking(SocketHandle socket)
+		{
+#ifdef _WIN32
+			u_long mode = 1;
+			return ioctlsocket(socket, FIONBIO, &mode) == 0;
+#else
+			int flags = fcntl(socket, F_GETFL, 0);
+			return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+		}
+
+		bool WouldBlock()
+		{
+#ifdef _WIN32
+			return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+		}
+
+		std::string Trim(const std::string& text)
+		{
+			size_t begin = text.find_first_not_of(" \t\r\n");
+			if (begin == std::string::npos) return {};
+			size_t end = text.find_last_not_of(" \t\r\n");
+			return text.substr(begin, end - begin + 1);
+		}
+	}
+
+	// =========================================================================
+	// RenderJob
+	// =========================================================================
+
+	bool RenderJob::Parse(const std::string& line, RenderJob& job, std::string& error)
+	{
+		job = RenderJob{};
+		std::istringstream stream(line);
+		std::string token;
+
+		try
+		{
+			while (stream >> token)
+			{
+				size_t eq = token.find('=');
+				if (eq == std::string::npos)
+				{
+					error = "expected key=value, got '" + token + "'";
+					return false;
+				}
+				std::string key = token.substr(0, eq);
+				std::string value = token.substr(eq + 1);
+
+				if (key == "id") job.Id = value;
+				else if (key == "model") job.ModelPath = value;
+				else if (key == "out") job.OutputPath = value;
+				else if (key == "size")
+				{
+					if (std::sscanf(value.c_str(), "%dx%d", &job.Width, &job.Height) != 2)
+					{
+						error = "size must be WxH";
+						return false;
+					}
+				}
+				else if (key == "yaw") job.Yaw = std::stof(value);
+				else if (key == "pitch") job.Pitch = std::stof(value);
+				else if (key == "fov") job.FieldOfView = std::stof(value);
+				else if (key == "distance") job.Distance = std::stof(value);
+				else if (key == "frames") job.Frames = std::stoi(value);
+				else if (key == "env") job.Environment = value;
+				else if (key == "exposure") job.Exposure = std::stof(value);
+				else
+				{
+					error = "unknown key '" + key + "'";
+					return false;
+				}
+			}
+		}
+		catch (const std::exception&)
+		{
+			error = "bad number in '" + token + "'";
+			return false;
+		}
+
+		if (job.ModelPath.empty() || job.OutputPath.empty())
+		{
+			error = "model and out are required";
+			return false;
+		}
+		if (job.Width <= 0 || job.Height <= 0 || job.Width > 8192 || job.Height > 8192)
+		{
+			error = "size out of range";
+			return false;
+		}
+		job.Frames = std::clamp(job.Frames, 1, 3600);
+		job.FieldOfView = std::clamp(job.FieldOfView, 1.0f, 170.0f);
+		if (job.Id.empty()) job.Id = job.ModelPath;
+		return true;
+	}
+
+	// =========================================================================
+	// Listener: line-based TCP on 127.0.0.1
+	// =========================================================================
+
+	class RenderService::Listener
+	{
+	public:
+		~Listener()
+		{
+			for (auto& [id, client] : m_Clients)
+			{
+				Flush(client);   // Best effort, e.g. the reply to "quit"
+				CloseSocket(client.Socket);
+			}
+			if (m_Socket != kInvalidSocket) CloseSocket(m_Socket);
+#ifdef _WIN32
+			if (m_WinsockStarted) WSACleanup();
+#endif
+		}
+
+		bool Open(int port)
+		{
+#ifdef _WIN32
+			WSADATA data;
+			if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+			m_WinsockStarted = true;
+#endif
+			m_Socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+			if (m_Socket == kInvalidSocket) return false;
+
+			int reuse = 1;
+			setsockopt(m_Socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_port = htons(static_cast<uint16_t>(port));
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);   // Local clients only
+
+			return bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+				listen(m_Socket, 8) == 0 &&
+				SetNonBlocking(m_Socket);
+		}
+
+		/**
+		 * Accept clients and collect complete lines as (client, line) pairs.
+		 */
+		void Poll(std::vector<std::pair<int, std::string>>& lines)
+		{
+			for (;;)
+			{
+				SocketHandle client = accept(m_Socket, nullptr, nullptr);
+				if (client == kInvalidSocket) break;
+				SetNonBlocking(client);
+#ifdef SO_NOSIGPIPE
+				int noSigPipe = 1;
+				setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+				m_Clients[m_NextClient++] = Client{ client, {}, {} };
+			}
+
+			char buffer[4096];
+			for (auto it = m_Clients.begin(); it != m_Clients.end();)
+			{
+				Client& client = it->second;
+				bool closed = !Flush(client);
+				for (;;)
+				{
+					auto received = recv(client.Socket, buffer, sizeof(buffer), 0);
+					if (received > 0)
+					{
+						client.Pending.append(buffer, static_cast<size_t>(received));
+						continue;
+					}
+					closed = closed || received == 0 || !WouldBlock();
+					break;
+				}
+
+				size_t newline;
+				while ((newline = client.Pending.find('\n')) != std::string::npos)
+				{
+					lines.emplace_back(it->first, client.Pending.substr(0, newline));
+					client.Pending.erase(0, newline + 1);
+				}
+
+				if (closed)
+				{
+					// Replies for its queued jobs are dropped; the jobs still run
+					CloseSocket(client.Socket);
+					it = m_Clients.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		void Reply(int clientId, const std::string& message)
+		{
+			auto it = m_Clients.find(clientId);
+			if (it == m_Clients.end()) return;
+
+			// Queued behind any earlier reply the socket could not take yet
+			Client& client = it->second;
+			client.Unsent += message;
+			client.Unsent += '\n';
+			if (!Flush(client))
+			{
+				CloseSocket(client.Socket);
+				m_Clients.erase(it);
+			}
+		}
+
+	private:
+		struct Client
+		{
+			SocketHandle Socket;
+			std::string Pending;   // Received, not yet a complete line
+			std::string Unsent;    // Replies the non-blocking socket has not accepted yet
+		};
+
+		/**
+		 * Write as much of the client's queued output as the socket accepts.
+		 * Returns false if the client is gone or has stopped reading.
+		 */
+		static bool Flush(Client& client)
+		{
+			size_t sent = 0;
+			while (sent < client.Unsent.size())
+			{
+				auto result = send(client.Socket, client.Unsent.data() + sent,
+					static_cast<int>(client.Unsent.size() - sent), kSendFlags);
+				if (result > 0)
+				{
+					sent += static_cast<size_t>(result);
+					continue;
+				}
+				if (result < 0 && WouldBlock()) break;
+				return false;   // EPIPE / ECONNRESET: dropped client
+			}
+			client.Unsent.erase(0, sent);
+			return client.Unsent.size() <= MaxUnsentBytes;
+		}
+
+		SocketHandle m_Socket = kInvalidSocket;
+		std::unordered_map<int, Client> m_Clients;
+		int m_NextClient = 0;
+#ifdef _WIN32
+		bool m_WinsockStarted = false;
+#endif
+	};
+
+	// =========================================================================
+	// RenderService
+	// =========================================================================
+
+	RenderService::RenderService(const RenderServiceConfig& config)
+		: m_Config(config)
+	{
+	}
+
+	RenderService::~RenderService()
+	{
+		// Let outstanding parses finish before their futures are destroyed
+		for (PendingJob& pending : m_Queue)
+		{
+			if (pending.Source.valid()) pending.Source.wait();
+		}
+	}
+
+	bool RenderService::Init()
+	{
+		m_LitShader = std::make_shared<Shader>("resources/shaders/defaultlit.shader");
+		m_ToneMappingShader = std::make_shared<Shader>("resources/shaders/tonemapping.shader");
+		if (!m_LitShader->IsValid() || !m_ToneMappingShader->IsValid())
+		{
+			VP_CORE_ERROR("RenderService: failed to load shaders");
+			return false;
+		}
+
+		m_Material = std::make_shared<PBRMaterial>(m_LitShader, "RenderService Material");
+		m_BRDFLut = CubemapUtils::GenerateBRDFLUT(512);
+		m_Quad = std::make_unique<FullscreenQuad>();
+
+		if (!m_Config.JobFile.empty())
+		{
+			std::ifstream file(m_Config.JobFile);
+			if (!file)
+			{
+				VP_CORE_ERROR("RenderService: cannot open job file '{}'", m_Config.JobFile);
+				return false;
+			}
+
+			std::string line;
+			int lineNumber = 0;
+			while (std::getline(file, line))
+			{
+				lineNumber++;
+				line = Trim(line);
+				if (line.empty() || line[0] == '#') continue;
+
+				RenderJob job;
+				std::string error;
+				if (RenderJob::Parse(line, job, error))
+				{
+					Enqueue(job, -1);
+				}
+				else
+				{
+					VP_CORE_ERROR("RenderService: {}:{}: {}", m_Config.JobFile, lineNumber, error);
+					m_Stats.Failed++;
+				}
+			}
+			VP_CORE_INFO("RenderService: {} jobs from '{}'", m_Queue.size(), m_Config.JobFile);
+		}
+
+		if (m_Config.Port > 0)
+		{
+			m_Listener = std::make_unique<Listener>();
+			if (!m_Listener->Open(m_Config.Port))
+			{
+				VP_CORE_ERROR("RenderService: cannot listen on 127.0.0.1:{}", m_Config.Port);
+				m_Listener.reset();
+				return false;
+			}
+			VP_CORE_INFO("RenderService: listening on 127.0.0.1:{}", m_Config.Port);
+		}
+
+		StartPrefetches();
+		return true;
+	}
+
+	void RenderService::Submit(const RenderJob& job)
+	{
+		Enqueue(job, -1);
+	}
+
+	void RenderService::Enqueue(const RenderJob& job, int client)
+	{
+		PendingJob pending;
+		pending.Job = job;
+		pending.Client = client;
+		m_Queue.push_back(std::move(pending));
+	}
+
+	void RenderService::StartPrefetches()
+	{
+		// The job about to render plus PrefetchDepth behind it
+		size_t window = std::min(m_Queue.size(), static_cast<size_t>(m_Config.PrefetchDepth) + 1);
+		for (size_t i = 0; i < window; i++)
+		{
+			PendingJob& pending = m_Queue[i];
+			if (pending.Started) continue;
+
+			pending.Source = std::async(std::launch::async, &Model::ParseFile, pending.Job.ModelPath);
+			pending.Started = true;
+		}
+	}
+
+	void RenderService::PublishMetrics() const
+	{
+		MetricsExporter& metrics = Engine::Get().GetMetrics();
+		if (!metrics.IsRunning()) return;
+
+		// Loader pipeline: queued, parsing on a worker, parsed and waiting for the GL thread
+		size_t waiting = 0, parsing = 0, ready = 0;
+		for (const PendingJob& pending : m_Queue)
+		{
+			if (!pending.Started) waiting++;
+			else if (pending.Source.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ready++;
+			else parsing++;
+		}
+
+		const char* help = "Render service jobs by loader stage.";
+		metrics.SetGauge("render_service_queue_depth", help, static_cast<double>(waiting), "stage=\"waiting\"");
+		metrics.SetGauge("render_service_queue_depth", help, static_cast<double>(parsing), "stage=\"parsing\"");
+		metrics.SetGauge("render_service_queue_depth", help, static_cast<double>(ready), "stage=\"ready\"");
+
+		help = "Render service jobs finished since start.";
+		metrics.SetGauge("render_service_jobs", help, m_Stats.Completed, "result=\"completed\"");
+		metrics.SetGauge("render_service_jobs", help, m_Stats.Failed, "result=\"failed\"");
+		metrics.SetGauge("render_service_jobs_per_second", "Render service throughput.", m_Stats.JobsPerSecond);
+	}
+
+	void RenderService::Update()
+	{
+		if (m_Finished) return;
+
+		if (m_Listener)
+		{
+			std::vector<std::pair<int, std::string>> lines;
+			m_Listener->Poll(lines);
+			for (auto& [client, text] : lines)
+			{
+				std::string line = Trim(text);
+				if (line.empty() || line[0] == '#') continue;
+
+				if (line == "quit")
+				{
+					m_QuitRequested = true;
+					m_Listener->Reply(client, "bye");
+					continue;
+				}
+				if (line == "stats")
+				{
+					char reply[160];
+					std::snprintf(reply, sizeof(reply), "stats completed=%u failed=%u queued=%zu jobs_per_second=%.2f",
+						m_Stats.Completed, m_Stats.Failed, m_Queue.size(), m_Stats.JobsPerSecond);
+					m_Listener->Reply(client, reply);
+					continue;
+				}
+
+				RenderJob job;
+				std::string error;
+				if (RenderJob::Parse(line, job, error))
+				{
+					Enqueue(job, client);
+				}
+				else
+				{
+					m_Listener->Reply(client, "failed - " + error);
+				}
+			}
+		}
+
+		StartPrefetches();
+		PublishMetrics();
+
+		if (m_Queue.empty())
+		{
+			bool idleExit = m_Config.ExitWhenIdle && !m_Listener;
+			if (idleExit || m_QuitRequested)
+			{
+				m_Finished = true;
+				LogStats();
+			}
+			return;
+		}
+
+		// With a socket, keep accepting while the front job is still parsing;
+		// in batch mode there is nothing else to do, so wait for it
+		PendingJob& front = m_Queue.front();
+		if (m_Listener && front.Source.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return;
+		}
+
+		if (m_Stats.Completed + m_Stats.Failed == 0 || m_FirstJobTime == 0.0)
+		{
+			m_FirstJobTime = NowSeconds();
+		}
+
+		double start = NowSeconds();
+		std::string error;
+		bool ok = RunJob(front, error);
+		double jobMs = (NowSeconds() - start) * 1000.0;
+
+		if (ok)
+		{
+			m_Stats.Completed++;
+			if (m_Listener) m_Listener->Reply(front.Client, "done " + front.Job.Id + " " + std::to_string(static_cast<int>(jobMs)));
+		}
+		else
+		{
+			m_Stats.Failed++;
+			VP_CORE_ERROR("RenderService: job '{}' failed: {}", front.Job.Id, error);
+			if (m_Listener) m_Listener->Reply(front.Client, "failed " + front.Job.Id + " " + error);
+		}
+		m_Queue.pop_front();
+
+		// Start the next parse before anything else touches the GL thread
+		StartPrefetches();
+
+		uint32_t finished = m_Stats.Completed + m_Stats.Failed;
+		m_Stats.ElapsedSeconds = NowSeconds() - m_FirstJobTime;
+		m_Stats.JobsPerSecond = m_Stats.ElapsedSeconds > 0.0 ? finished / m_Stats.ElapsedSeconds : 0.0;
+		if (m_Config.StatsInterval > 0 && finished % m_Config.StatsInterval == 0)
+		{
+			LogStats();
+		}
+	}
+
+	bool RenderService::RunJob(PendingJob& pending, std::string& error)
+	{
+		const RenderJob& job = pending.Job;
+
+		// Parse (normally finished on the worker while the previous job rendered)
+		double waitStart = NowSeconds();
+		ModelSourcePtr source = pending.Source.valid() ? pending.Source.get() : Model::ParseFile(job.ModelPath);
+		double uploadStart = NowSeconds();
+		m_TotalWaitMs += (uploadStart - waitStart) * 1000.0;
+		if (!source)
+		{
+			error = "cannot parse " + job.ModelPath;
+			return false;
+		}
+
+		// Upload
+		std::unique_ptr<Model> model = Model::LoadFromSource(std::move(source));
+		double renderStart = NowSeconds();
+		m_TotalUploadMs += (renderStart - uploadStart) * 1000.0;
+		if (!model || !model->IsValid())
+		{
+			error = "model has no meshes";
+			return false;
+		}
+
+		const Environment* environment = GetEnvironment(job.Environment.empty() ? m_Config.DefaultEnvironment : job.Environment);
+		if (!EnsureTargets(job.Width, job.Height))
+		{
+			error = "cannot create render targets";
+			return false;
+		}
+
+		// Frame the model's bounding sphere
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		for (const auto& mesh : model->GetMeshes())
+		{
+			boundsMin = glm::min(boundsMin, mesh->GetBoundsMin());
+			boundsMax = glm::max(boundsMax, mesh->GetBoundsMax());
+		}
+		glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+		float radius = std::max(glm::length(boundsMax - boundsMin) * 0.5f, 0.001f);
+		float halfFov = glm::radians(job.FieldOfView) * 0.5f;
+		float distance = job.Distance > 0.0f ? job.Distance : radius / std::sin(halfFov) * 1.05f;
+
+		Camera camera(job.FieldOfView, static_cast<float>(job.Width) / static_cast<float>(job.Height),
+			std::max(distance - radius * 2.0f, distance * 0.01f), distance + radius * 2.0f);
+
+		Renderer& renderer = Engine::Get().GetRenderer();
+		renderer.PushViewport();
+
+		// Material state shared by every draw of this job
+		const auto& shader = m_Material->GetShader();
+		shader->Bind();
+		shader->SetInt("u_LightCount", 0);
+		shader->SetBool("u_UseDirLight", true);
+		shader->SetVec3("u_DirLightDirection", glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f)));
+		shader->SetVec3("u_DirLightColor", glm::vec3(2.0f));
+
+		const bool useIBL = environment && environment->Irradiance && environment->Prefiltered && m_BRDFLut;
+		m_Material->SetUseIBL(useIBL);
+		if (useIBL)
+		{
+			m_Material->SetIrradianceMap(environment->Irradiance);
+			m_Material->SetPrefilteredMap(environment->Prefiltered);
+			m_Material->SetBRDFLUT(m_BRDFLut);
+			shader->SetFloat("u_MaxReflectionLOD", 4.0f);
+			shader->SetFloat("u_IBLIntensity", 1.0f);
+		}
+
+		float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		RegressionImage image;
+		bool saved = true;
+
+		for (int frame = 0; frame < job.Frames && saved; frame++)
+		{
+			// Orbit around the center, looking at it
+			float yaw = glm::radians(job.Yaw + 360.0f * static_cast<float>(frame) / static_cast<float>(job.Frames));
+			float pitch = glm::radians(job.Pitch);
+			glm::vec3 toCamera(std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw));
+			camera.SetPosition(center + toCamera * distance);
+			camera.SetRotation(-pitch, yaw + glm::pi<float>());
+
+			// Scene into HDR
+			m_HDRTarget->Bind();
+			renderer.SetViewport(0, 0, job.Width, job.Height);
+			renderer.EnableDepthTest();
+			renderer.Clear(clearColor);
+
+			m_Material->SetViewMatrix(camera.GetViewMatrix());
+			m_Material->SetProjectionMatrix(camera.GetProjectionMatrix());
+			m_Material->SetViewPosition(camera.GetPosition());
+
+			for (size_t i = 0; i < model->GetMeshCount(); i++)
+			{
+				const auto& mesh = model->GetMeshes()[i];
+				const Material& material = model->GetMaterialForMesh(i);
+
+				m_Material->SetModelMatrix(glm::mat4(1.0f));
+				m_Material->SetNormalMatrix(glm::mat3(1.0f));
+				m_Material->SetAlbedo(glm::vec3(material.BaseColor));
+				m_Material->SetAlpha(material.BaseColor.a);
+				m_Material->SetMetallic(material.Metallic);
+				m_Material->SetRoughness(material.Roughness);
+				m_Material->SetAO(1.0f);
+				m_Material->SetAlbedoTexture(material.BaseColorTexture);
+				m_Material->SetSurfaceTextures(material);
+				m_Material->Bind();
+
+				mesh->Bind();
+				renderer.Draw(mesh->GetVertexArray(), mesh->GetIndexBuffer(), *shader);
+			}
+
+			if (environment && environment->Sky)
+			{
+				environment->Sky->Render(camera);
+			}
+			m_HDRTarget->Unbind();
+
+			// Tone map into the LDR target
+			m_LDRTarget->Bind();
+			renderer.DisableDepthTest();
+			m_ToneMappingShader->Bind();
+			m_HDRColor->Bind(TextureSlots::HDRBuffer);
+			m_ToneMappingShader->SetInt("u_HDRBuffer", TextureSlots::HDRBuffer);
+			m_ToneMappingShader->SetInt("u_ToneMappingMode", 3);   // ACES
+			m_ToneMappingShader->SetFloat("u_Exposure", job.Exposure);
+			m_ToneMappingShader->SetFloat("u_Gamma", 2.2f);
+			m_ToneMappingShader->SetFloat("u_WhitePoint", 4.0f);
+			m_ToneMappingShader->SetBool("u_EnableBloom", false);
+			m_ToneMappingShader->SetBool("u_EnableColorGrading", false);
+			m_ToneMappingShader->SetFloat("u_Saturation", 1.0f);
+			m_ToneMappingShader->SetFloat("u_Contrast", 1.0f);
+			m_ToneMappingShader->SetFloat("u_Brightness", 0.0f);
+			m_Quad->Render();
+			renderer.EnableDepthTest();
+
+			// Read back (GL rows are bottom-up)
+			image.Width = job.Width;
+			image.Height = job.Height;
+			image.Pixels.resize(static_cast<size_t>(job.Width) * static_cast<size_t>(job.Height) * 3);
+			glReadBuffer(GL_COLOR_ATTACHMENT0);
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(0, 0, job.Width, job.Height, GL_RGB, GL_UNSIGNED_BYTE, image.Pixels.data());
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+			m_LDRTarget->Unbind();
+
+			const size_t rowSize = static_cast<size_t>(job.Width) * 3;
+			for (int y = 0; y < job.Height / 2; y++)
+			{
+				std::swap_ranges(
+					image.Pixels.begin() + static_cast<std::ptrdiff_t>(y * rowSize),
+					image.Pixels.begin() + static_cast<std::ptrdiff_t>((y + 1) * rowSize),
+					image.Pixels.begin() + static_cast<std::ptrdiff_t>((job.Height - 1 - y) * rowSize));
+			}
+
+			std::string path = job.OutputPath;
+			if (job.Frames > 1)
+			{
+				char suffix[16];
+				std::snprintf(suffix, sizeof(suffix), "_%03d", frame);
+				path += suffix;
+			}
+			saved = RegressionHarness::SavePPM(path + ".ppm", image);
+		}
+
+		renderer.PopViewport();
+		m_TotalRenderMs += (NowSeconds() - renderStart) * 1000.0;
+
+		if (!saved)
+		{
+			error = "cannot write " + job.OutputPath;
+			return false;
+		}
+		return true;
+	}
+
+	const RenderService::Environment* RenderService::GetEnvironment(const std::string& path)
+	{
+		if (path.empty()) return nullptr;
+
+		auto it = m_Environments.find(path);
+		if (it != m_Environments.end())
+		{
+			m_EnvironmentLRU.remove(path);
+			m_EnvironmentLRU.push_front(path);
+			return &it->second;
+		}
+
+		auto hdri = std::make_shared<Texture>(path, true);
+		if (!hdri->GetID())
+		{
+			VP_CORE_WARN("RenderService: cannot load environment '{}', rendering without IBL", path);
+			return nullptr;
+		}
+
+		Environment environment;
+		environment.Cubemap = CubemapUtils::EquirectangularToCubemap(hdri, 512);
+		if (!environment.Cubemap) return nullptr;
+		environment.Irradiance = CubemapUtils::GenerateIrradianceMap(environment.Cubemap);
+		environment.Prefiltered = CubemapUtils::GeneratePrefilteredMap(environment.Cubemap);
+		environment.Sky = std::make_unique<Skybox>(environment.Cubemap);
+
+		// Evict the least recently used
+		while (m_EnvironmentLRU.size() >= std::max(1u, m_Config.MaxCachedEnvironments))
+		{
+			m_Environments.erase(m_EnvironmentLRU.back());
+			m_EnvironmentLRU.pop_back();
+		}
+
+		m_EnvironmentLRU.push_front(path);
+		return &m_Environments.emplace(path, std::move(environment)).first->second;
+	}
+
+	bool RenderService::EnsureTargets(int width, int height)
+	{
+		if (m_HDRTarget && m_HDRTarget->GetWidth() == width && m_HDRTarget->GetHeight() == height)
+		{
+			return true;
+		}
+
+		m_HDRColor = std::make_shared<Texture>(width, height, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+		m_HDRDepth = std::make_shared<Texture>(width, height, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8);
+		m_HDRTarget = std::make_shared<Framebuffer>(width, height);
+		m_HDRTarget->AttachColorTexture(m_HDRColor, 0);
+		m_HDRTarget->AttachDepthStencilTexture(m_HDRDepth);
+
+		m_LDRColor = std::make_shared<Texture>(width, height, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+		m_LDRTarget = std::make_shared<Framebuffer>(width, height);
+		m_LDRTarget->AttachColorTexture(m_LDRColor, 0);
+
+		if (!m_HDRTarget->IsComplete() || !m_LDRTarget->IsComplete())
+		{
+			m_HDRTarget.reset();
+			m_LDRTarget.reset();
+			return false;
+		}
+		return true;
+	}
+
+	void RenderService::LogStats() const
+	{
+		uint32_t finished = m_Stats.Completed + m_Stats.Failed;
+		uint32_t ran = std::max(finished, 1u);
+		VP_CORE_INFO("RenderService: {} done, {} failed in {:.1f} s ({:.2f} jobs/s); per job: wait {:.1f} ms, upload {:.1f} ms, render {:.1f} ms",
+			m_Stats.Completed, m_Stats.Failed, m_Stats.ElapsedSeconds, m_Stats.JobsPerSecond,
+			m_TotalWaitMs / ran, m_TotalUploadMs / ran, m_TotalRenderMs / ran);
+	}
+}
@@ -0,0 +1,185 @@
+// VizEngine/src/VizEngine/Renderer/RenderService.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Model.h"
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+	class Texture;
+	class Shader;
+	class Framebuffer;
+	class FullscreenQuad;
+	class PBRMaterial;
+	class Skybox;
+
+	/**
+	 * One thumbnail or turntable request.
+	 *
+	 * Text form (job files and the socket), one job per line:
+	 *   model=assets/Duck.glb out=thumbs/duck size=256x256 yaw=30 pitch=20 frames=1
+	 * Keys: id, model (required), out (required), size=WxH, yaw, pitch and fov
+	 * (degrees), distance (0 = fit the bounds), frames (> 1 = turntable),
+	 * env (HDR path, empty = service default), exposure.
+	 * Blank lines and lines starting with '#' are ignored.
+	 */
+	struct RenderJob
+	{
+		std::string Id;                // Defaults to the model path
+		std::string ModelPath;
+		std::string OutputPath;        // Without extension; turntables append _NNN
+		int Width = 256;
+		int Height = 256;
+		float Yaw = 30.0f;             // Camera orbit around the model, degrees
+		float Pitch = 20.0f;
+		float FieldOfView = 40.0f;
+		float Distance = 0.0f;         // 0 = fit the model's bounding sphere
+		int Frames = 1;                // Turntable frames, evenly spaced in yaw
+		std::string Environment;
+		float Exposure = 1.0f;
+
+		/**
+		 * Parse the text form.
+		 * @return false (with a reason in error) if the line is not a valid job
+		 */
+		static bool Parse(const std::string& line, RenderJob& job, std::string& error);
+	};
+
+	struct RenderServiceConfig
+	{
+		std::string JobFile;          // Jobs to run, one per line (optional)
+		int Port = 0;                 // Listen on 127.0.0.1:Port for jobs (0 = off)
+		bool ExitWhenIdle = true;     // Finish once the job file is done (ignored with a port)
+		uint32_t PrefetchDepth = 2;   // Jobs whose models are parsed ahead on worker threads
+		std::string DefaultEnvironment = "resources/textures/environments/qwantani_dusk_2_puresky_2k.hdr";
+		uint32_t MaxCachedEnvironments = 4;
+		uint32_t StatsInterval = 100;  // Log throughput every N jobs
+	};
+
+	struct RenderServiceStats
+	{
+		uint32_t Completed = 0;
+		uint32_t Failed = 0;
+		double ElapsedSeconds = 0.0;   // Since the first job started
+		double JobsPerSecond = 0.0;
+		double AverageWaitMs = 0.0;    // GL thread blocked on model parsing (0 when fully overlapped)
+		double AverageUploadMs = 0.0;  // Mesh/texture creation
+		double AverageRenderMs = 0.0;  // Drawing, readback and writing the images
+	};
+
+	/**
+	 * Headless batch renderer for asset thumbnails and turntables.
+	 *
+	 * Jobs come from a job file and/or a local TCP socket (text lines, see
+	 * RenderJob). Everything expensive stays warm across jobs: the shaders,
+	 * the BRDF LUT, render targets (recreated only when the size changes)
+	 * and an LRU cache of environments with their IBL maps.
+	 *
+	 * While job N renders on the GL thread, the models of the next
+	 * PrefetchDepth jobs are parsed and their images decoded on worker
+	 * threads (Model::ParseFile); only the GL upload stays on this thread.
+	 *
+	 * Images are written as binary PPM. Socket clients get one reply line
+	 * per job: "done <id> <ms>" or "failed <id> <reason>"; the commands
+	 * "stats" and "quit" are also understood.
+	 *
+	 * Usage (per frame, GL context current):
+	 *   service.Update();
+	 *   if (service.IsFinished()) Engine::Get().Quit();
+	 */
+	class VizEngine_API RenderService
+	{
+	public:
+		explicit RenderService(const RenderServiceConfig& config = {});
+		~RenderService();
+
+		RenderService(const RenderService&) = delete;
+		RenderService& operator=(const RenderService&) = delete;
+
+		/**
+		 * Load shaders, open the job file and socket.
+		 * @return false if nothing can be rendered (logged)
+		 */
+		bool Init();
+
+		/**
+		 * Accept new jobs, start prefetches and render at most one job.
+		 */
+		void Update();
+
+		/**
+		 * Queue a job directly.
+		 */
+		void Submit(const RenderJob& job);
+
+		bool IsFinished() const { return m_Finished; }
+		const RenderServiceStats& GetStats() const { return m_Stats; }
+		size_t GetQueuedCount() const { return m_Queue.size(); }
+
+	private:
+		struct PendingJob
+		{
+			RenderJob Job;
+			std::future<ModelSourcePtr> Source;
+			bool Started = false;
+			int Client = -1;     // Socket client to reply to (-1 = none)
+		};
+
+		struct Environment
+		{
+			std::shared_ptr<Texture> Cubemap;
+			std::shared_ptr<Texture> Irradiance;
+			std::shared_ptr<Texture> Prefiltered;
+			std::unique_ptr<Skybox> Sky;
+		};
+
+		class Listener;
+
+		void Enqueue(const RenderJob& job, int client);
+		void StartPrefetches();
+		void PublishMetrics() const;
+		bool RunJob(PendingJob& pending, std::string& error);
+		const Environment* GetEnvironment(const std::string& path);
+		bool EnsureTargets(int width, int height);
+		void LogStats() const;
+
+		RenderServiceConfig m_Config;
+		RenderServiceStats m_Stats;
+		bool m_Finished = false;
+		bool m_QuitRequested = false;
+
+		std::deque<PendingJob> m_Queue;
+		std::unique_ptr<Listener> m_Listener;
+
+		// Warm resources
+		std::shared_ptr<Shader> m_LitShader;
+		std::shared_ptr<Shader> m_ToneMappingShader;
+		std::shared_ptr<PBRMaterial> m_Material;
+		std::shared_ptr<Texture> m_BRDFLut;
+		std::unique_ptr<FullscreenQuad> m_Quad;
+
+		std::unordered_map<std::string, Environment> m_Environments;
+		std::list<std::string> m_EnvironmentLRU;   // Most recent first
+
+		std::shared_ptr<Framebuffer> m_HDRTarget;
+		std::shared_ptr<Texture> m_HDRColor;
+		std::shared_ptr<Texture> m_HDRDepth;
+		std::shared_ptr<Framebuffer> m_LDRTarget;
+		std::shared_ptr<Texture> m_LDRColor;
+
+		// Throughput
+		double m_FirstJobTime = 0.0;
+		double m_TotalWaitMs = 0.0;
+		double m_TotalUploadMs = 0.0;
+		double m_TotalRenderMs = 0.0;
+	};
+}
@@ -0,0 +1,138 @@
+// VizEngine/src/VizEngine/Renderer/RenderViewSet.cpp
+
+#include "RenderViewSet.h"
+#include "SceneRenderList.h"
+#include "VizEngine/Core/Camera.h"
+#include "VizEngine/Core/Scene.h"
+#include <algorithm>
+
+namespace VizEngine
+{
+	int RenderView::GetRenderWidth() const
+	{
+		return std::max(1, static_cast<int>(static_cast<float>(Desc.Width) * Desc.ResolutionScale));
+	}
+
+	int RenderView::GetRenderHeight() const
+	{
+		return std::max(1, static_cast<int>(static_cast<float>(Desc.Height) * Desc.ResolutionScale));
+	}
+
+	uint32_t RenderViewSet::AddView(const RenderViewDesc& desc)
+	{
+		RenderView view;
+		view.Desc = desc;
+		view.Desc.UpdateInterval = std::max(1u, desc.UpdateInterval);
+		m_Views.push_back(std::move(view));
+		return static_cast<uint32_t>(m_Views.size() - 1);
+	}
+
+	void RenderViewSet::SetCamera(uint32_t view, const Camera& camera)
+	{
+		RenderView& v = m_Views[view];
+		v.View = camera.GetViewMatrix();
+		v.Projection = camera.GetProjectionMatrix();
+		v.ViewProjection = v.Projection * v.View;
+		v.Position = camera.GetPosition();
+	}
+
+	void RenderViewSet::BeginFrame(const Scene& scene, const SceneRenderList& renderList)
+	{
+		m_FrameIndex++;
+
+		// Per-object data, once for all views
+		m_Objects.clear();
+		m_Positions.Clear();
+		m_Rotations.Clear();
+		m_Scales.Clear();
+		for (size_t index : renderList.GetOpaque())
+		{
+			GatherObject(scene, index);
+		}
+		m_TransparentStart = static_cast<uint32_t>(m_Objects.size());
+		for (size_t index : renderList.GetTransparent())
+		{
+			GatherObject(scene, index);
+		}
+
+		// Model matrices for every object in one batched call
+		BatchMath::ComposeTransforms(m_Positions, m_Rotations, m_Scales, m_Models);
+
+		m_BoundsCenters.Resize(m_Objects.size());
+		m_BoundsRadii.resize(m_Objects.size());
+		for (size_t i = 0; i < m_Objects.size(); i++)
+		{
+			ObjectFrameData& data = m_Objects[i];
+			data.Model = m_Models.Get(i);
+			data.Normal = glm::transpose(glm::inverse(glm::mat3(data.Model)));
+
+			const SceneObject& obj = scene[data.SceneIndex];
+			if (obj.MeshPtr)
+			{
+				// Sphere around the local bounds, scaled by the largest axis
+				glm::vec3 axisScale(
+					glm::length(glm::vec3(data.Model[0])),
+					glm::length(glm::vec3(data.Model[1])),
+					glm::length(glm::vec3(data.Model[2])));
+				float maxScale = std::max(axisScale.x, std::max(axisScale.y, axisScale.z));
+
+				data.BoundsCenter = glm::vec3(data.Model * glm::vec4(obj.MeshPtr->GetBoundsCenter(), 1.0f));
+				data.BoundsRadius = obj.MeshPtr->GetBoundsRadius() * maxScale;
+			}
+
+			m_BoundsCenters.Set(i, data.BoundsCenter);
+			m_BoundsRadii[i] = data.BoundsRadius;
+		}
+
+		// Visibility per due view
+		for (RenderView& view : m_Views)
+		{
+			view.Opaque.clear();
+			view.Transparent.clear();
+			view.CulledCount = 0;
+
+			view.Due = view.Desc.Enabled &&
+				(view.LastRenderedFrame == 0 ||
+				 m_FrameIndex - view.LastRenderedFrame >= view.Desc.UpdateInterval);
+
+			if (view.Due)
+			{
+				CullView(view);
+			}
+		}
+	}
+
+	void RenderViewSet::MarkRendered(uint32_t view)
+	{
+		m_Views[view].LastRenderedFrame = m_FrameIndex;
+	}
+
+	void RenderViewSet::GatherObject(const Scene& scene, size_t sceneIndex)
+	{
+		const Transform& transform = scene[sceneIndex].ObjectTransform;
+		m_Positions.Push(transform.Position);
+		m_Rotations.Push(transform.Rotation);
+		m_Scales.Push(transform.Scale);
+
+		ObjectFrameData data;
+		data.SceneIndex = sceneIndex;
+		m_Objects.push_back(data);
+	}
+
+	void RenderViewSet::CullView(RenderView& view)
+	{
+		FrustumPlanes frustum = BatchMath::ExtractFrustumPlanes(view.ViewProjection);
+		size_t visibleCount = BatchMath::CullSpheres(frustum, m_BoundsCenters, m_BoundsRadii, m_Visible);
+		view.CulledCount = m_Objects.size() - visibleCount;
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_Objects.size()); i++)
+		{
+			if (!m_Visible[i]) continue;
+
+			if (i < m_TransparentStart)
+				view.Opaque.push_back(i);
+			else
+				view.Transparent.push_back(i);
+		}
+	}
+}
@@ -0,0 +1,135 @@
+// VizEngine/src/VizEngine/Renderer/RenderViewSet.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/BatchMath.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	class Camera;
+	class Framebuffer;
+	class Scene;
+	class SceneRenderList;
+
+	/**
+	 * Per-object data computed once per frame and shared by every view.
+	 */
+	struct ObjectFrameData
+	{
+		glm::mat4 Model = glm::mat4(1.0f);
+		glm::mat3 Normal = glm::mat3(1.0f);   // transpose(inverse(mat3(Model)))
+		glm::vec3 BoundsCenter = glm::vec3(0.0f);   // World-space bounding sphere
+		float BoundsRadius = 0.0f;
+		size_t SceneIndex = 0;
+	};
+
+	/**
+	 * How a view is rendered.
+	 */
+	struct RenderViewDesc
+	{
+		std::string Name = "View";
+		Framebuffer* Target = nullptr;   // Null = default framebuffer
+		int Width = 800;                 // Full-resolution size
+		int Height = 800;
+		float ResolutionScale = 1.0f;    // Secondary views can render smaller
+		uint32_t UpdateInterval = 1;     // Render every N frames (1 = every frame)
+		bool Enabled = true;
+	};
+
+	/**
+	 * One registered view: its camera for this frame and what it can see.
+	 */
+	struct RenderView
+	{
+		RenderViewDesc Desc;
+
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		glm::vec3 Position = glm::vec3(0.0f);
+
+		// Indices into RenderViewSet::GetObjects(), filled by BeginFrame()
+		std::vector<uint32_t> Opaque;        // Scene order
+		std::vector<uint32_t> Transparent;   // Back-to-front (order of the render list)
+
+		bool Due = false;                    // Render this frame?
+		uint64_t LastRenderedFrame = 0;
+		size_t CulledCount = 0;
+
+		int GetRenderWidth() const;
+		int GetRenderHeight() const;
+	};
+
+	/**
+	 * Several cameras rendering the same scene in one frame.
+	 *
+	 * BeginFrame() computes model/normal matrices and world bounds once for
+	 * every object in the render list, then frustum-culls that shared bounds
+	 * array for each view that is due this frame. Views render from the
+	 * precomputed data instead of re-deriving it per pass. Secondary views can
+	 * use a lower resolution and skip frames: a view that is not due keeps
+	 * last frame's target contents.
+	 *
+	 * Usage:
+	 *   uint32_t main = views.AddView({ "Main", hdrFramebuffer, w, h });
+	 *   views.SetCamera(main, camera);
+	 *   views.BeginFrame(scene, renderList);
+	 *   for each due view: draw view.Opaque, then view.Transparent
+	 */
+	class VizEngine_API RenderViewSet
+	{
+	public:
+		RenderViewSet() = default;
+
+		/**
+		 * Register a view.
+		 * @return View ID (index)
+		 */
+		uint32_t AddView(const RenderViewDesc& desc);
+
+		/**
+		 * Set the camera a view renders from this frame (matrices are copied).
+		 */
+		void SetCamera(uint32_t view, const Camera& camera);
+
+		/**
+		 * Compute shared per-object data and per-view visibility.
+		 * Call after SceneRenderList::Update() and the SetCamera() calls.
+		 */
+		void BeginFrame(const Scene& scene, const SceneRenderList& renderList);
+
+		/**
+		 * Record that a view was rendered this frame (restarts its interval).
+		 */
+		void MarkRendered(uint32_t view);
+
+		RenderView& GetView(uint32_t view) { return m_Views[view]; }
+		const RenderView& GetView(uint32_t view) const { return m_Views[view]; }
+		size_t GetViewCount() const { return m_Views.size(); }
+
+		const std::vector<ObjectFrameData>& GetObjects() const { return m_Objects; }
+		uint64_t GetFrameIndex() const { return m_FrameIndex; }
+
+	private:
+		void GatherObject(const Scene& scene, size_t sceneIndex);
+		void CullView(RenderView& view);
+
+		std::vector<RenderView> m_Views;
+		std::vector<ObjectFrameData> m_Objects;
+
+		// SoA scratch for the batched transform and culling kernels
+		Vec3Stream m_Positions, m_Rotations, m_Scales;
+		Mat4Stream m_Models;
+		Vec3Stream m_BoundsCenters;
+		std::vector<float> m_BoundsRadii;
+		std::vector<uint8_t> m_Visible;
+		uint32_t m_TransparentStart = 0;   // Objects before this index are opaque
+		uint64_t m_FrameIndex = 0;
+	};
+}
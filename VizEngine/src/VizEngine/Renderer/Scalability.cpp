@@ -0,0 +1,202 @@
+// VizEngine/src/VizEngine/Renderer/Scalability.cpp
+
+#include "Scalability.h"
+#include "VizEngine/Core/Profiler.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// Low, Medium, High, Ultra. High matches the previous hard-coded defaults,
+		// except shadows, which trade the old 9-fetch PCF for a 16-tap disk.
+		constexpr ShadowFilterMode kHardware = ShadowFilterMode::Hardware;
+		constexpr ShadowFilterMode kDisk = ShadowFilterMode::PoissonDisk;
+		constexpr ShadowFilterMode kPCSS = ShadowFilterMode::PCSS;
+
+		const ScalabilitySettings kTierSettings[static_cast<size_t>(ScalabilityTier::Count)] = {
+			//  Shadow  Bloom  Scale  Passes  IrrRes  IrrDelta  PreRes  PreSamples  Lights  Filter     Taps
+			{   1024,   false, 0.25f, 2,      16,     0.1f,     128,    64,         1,      kHardware, 1  },
+			{   1024,   true,  0.25f, 3,      32,     0.05f,    256,    256,        2,      kHardware, 4  },
+			{   2048,   true,  0.5f,  5,      32,     0.025f,   512,    1024,       4,      kDisk,     16 },
+			{   4096,   true,  0.5f,  8,      64,     0.0125f,  512,    2048,       4,      kPCSS,     32 },
+		};
+
+		const char* kTierNames[static_cast<size_t>(ScalabilityTier::Count)] = {
+			"Low", "Medium", "High", "Ultra"
+		};
+
+		float Median(std::vector<float> values)
+		{
+			if (values.empty()) return 0.0f;
+			std::sort(values.begin(), values.end());
+			size_t mid = values.size() / 2;
+			return values.size() % 2 == 1 ? values[mid] : 0.5f * (values[mid - 1] + values[mid]);
+		}
+	}
+
+	ScalabilityManager::ScalabilityManager(const ScalabilityConfig& config)
+		: m_Config(config)
+	{
+		m_SinceDowngrade = m_Config.UpgradeCooldownSeconds;
+	}
+
+	const ScalabilitySettings& ScalabilityManager::GetTierSettings(ScalabilityTier tier)
+	{
+		size_t index = std::min(static_cast<size_t>(tier), static_cast<size_t>(ScalabilityTier::Ultra));
+		return kTierSettings[index];
+	}
+
+	const char* ScalabilityManager::GetTierName(ScalabilityTier tier)
+	{
+		size_t index = std::min(static_cast<size_t>(tier), static_cast<size_t>(ScalabilityTier::Ultra));
+		return kTierNames[index];
+	}
+
+	void ScalabilityManager::BeginCalibration()
+	{
+		m_Calibrating = true;
+		std::fill(std::begin(m_CalibrationMs), std::end(m_CalibrationMs), 0.0f);
+		ApplyTier(ScalabilityTier::Ultra);
+		VP_CORE_INFO("Scalability: calibrating against {:.1f} ms target", m_Config.TargetFrameMs);
+	}
+
+	void ScalabilityManager::SetTier(ScalabilityTier tier)
+	{
+		if (tier >= ScalabilityTier::Count) return;
+		m_Calibrating = false;
+		if (tier != m_Tier)
+		{
+			ApplyTier(tier);
+		}
+	}
+
+	bool ScalabilityManager::ConsumeChange()
+	{
+		bool changed = m_Changed;
+		m_Changed = false;
+		return changed;
+	}
+
+	void ScalabilityManager::Update(float deltaTime)
+	{
+		float costMs = 0.0f;
+		if (!SampleFrameCost(deltaTime, costMs)) return;
+
+		if (m_Calibrating)
+		{
+			UpdateCalibration(costMs);
+		}
+		else if (m_Config.AutoAdjust)
+		{
+			UpdateRuntime(costMs, deltaTime);
+		}
+	}
+
+	bool ScalabilityManager::SampleFrameCost(float deltaTime, float& costMs)
+	{
+		const FrameTimings& frame = Profiler::GetLastFrame();
+		if (!Profiler::IsEnabled() || !frame.Valid || frame.Passes.empty())
+		{
+			// No pass timings: fall back to wall-clock frame time
+			costMs = deltaTime * 1000.0f;
+			return true;
+		}
+
+		// Each resolved frame once, and only frames rendered with the current tier
+		if (frame.Frame <= m_LastSampledFrame) return false;
+		m_LastSampledFrame = frame.Frame;
+		if (frame.Frame <= m_TierAppliedFrame) return false;
+
+		double cpuMs = 0.0;
+		for (const PassTiming& pass : frame.Passes)
+		{
+			if (pass.Depth == 0) cpuMs += pass.CpuMs;
+		}
+		costMs = static_cast<float>(std::max(cpuMs, frame.GpuFrameMs));
+		return true;
+	}
+
+	void ScalabilityManager::ApplyTier(ScalabilityTier tier)
+	{
+		m_Tier = tier;
+		m_Changed = true;
+		m_TierAppliedFrame = Profiler::GetFrameIndex();
+
+		m_CalibrationFrames = 0;
+		m_CalibrationSamples.clear();
+		m_HasSmoothed = false;
+		m_OverBudgetTime = 0.0f;
+		m_UnderBudgetTime = 0.0f;
+	}
+
+	void ScalabilityManager::UpdateCalibration(float costMs)
+	{
+		if (++m_CalibrationFrames <= m_Config.CalibrationWarmupFrames) return;
+
+		m_CalibrationSamples.push_back(costMs);
+		if (m_CalibrationSamples.size() < std::max(1u, m_Config.CalibrationMeasureFrames)) return;
+
+		float median = Median(m_CalibrationSamples);
+		m_CalibrationMs[static_cast<size_t>(m_Tier)] = median;
+		VP_CORE_INFO("Scalability: {} tier {:.2f} ms", GetTierName(m_Tier), median);
+
+		if (median <= m_Config.TargetFrameMs || m_Tier == ScalabilityTier::Low)
+		{
+			m_Calibrating = false;
+			m_SinceDowngrade = 0.0f;   // Do not immediately retry a tier that just failed
+			m_HasSmoothed = false;
+			VP_CORE_INFO("Scalability: selected {} tier", GetTierName(m_Tier));
+			return;
+		}
+
+		ApplyTier(static_cast<ScalabilityTier>(static_cast<uint8_t>(m_Tier) - 1));
+	}
+
+	void ScalabilityManager::UpdateRuntime(float costMs, float deltaTime)
+	{
+		if (!m_HasSmoothed)
+		{
+			m_SmoothedMs = costMs;
+			m_HasSmoothed = true;
+		}
+		else
+		{
+			m_SmoothedMs += (costMs - m_SmoothedMs) * m_Config.SmoothingFactor;
+		}
+
+		m_SinceDowngrade += deltaTime;
+
+		// Over budget for long enough: step down
+		if (m_SmoothedMs > m_Config.TargetFrameMs * m_Config.DowngradeRatio)
+			m_OverBudgetTime += deltaTime;
+		else
+			m_OverBudgetTime = 0.0f;
+
+		if (m_OverBudgetTime >= m_Config.DowngradeSeconds && m_Tier > ScalabilityTier::Low)
+		{
+			VP_CORE_WARN("Scalability: {:.2f} ms sustained, dropping to {} tier", m_SmoothedMs,
+				GetTierName(static_cast<ScalabilityTier>(static_cast<uint8_t>(m_Tier) - 1)));
+			ApplyTier(static_cast<ScalabilityTier>(static_cast<uint8_t>(m_Tier) - 1));
+			m_SinceDowngrade = 0.0f;
+			return;
+		}
+
+		// Comfortably under budget for long enough: step up
+		if (m_SmoothedMs < m_Config.TargetFrameMs * m_Config.UpgradeRatio)
+			m_UnderBudgetTime += deltaTime;
+		else
+			m_UnderBudgetTime = 0.0f;
+
+		if (m_UnderBudgetTime >= m_Config.UpgradeSeconds &&
+			m_SinceDowngrade >= m_Config.UpgradeCooldownSeconds &&
+			m_Tier < ScalabilityTier::Ultra)
+		{
+			VP_CORE_INFO("Scalability: {:.2f} ms sustained, raising to {} tier", m_SmoothedMs,
+				GetTierName(static_cast<ScalabilityTier>(static_cast<uint8_t>(m_Tier) + 1)));
+			ApplyTier(static_cast<ScalabilityTier>(static_cast<uint8_t>(m_Tier) + 1));
+		}
+	}
+}
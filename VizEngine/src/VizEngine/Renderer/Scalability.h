@@ -0,0 +1,154 @@
+// VizEngine/src/VizEngine/Renderer/Scalability.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "PBRMaterial.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Quality tiers, cheapest first.
+	 */
+	enum class ScalabilityTier : uint8_t
+	{
+		Low = 0,
+		Medium,
+		High,
+		Ultra,
+		Count
+	};
+
+	/**
+	 * Settings one tier applies.
+	 */
+	struct ScalabilitySettings
+	{
+		// Shadows
+		int ShadowMapResolution = 2048;
+
+		// Bloom
+		bool BloomEnabled = true;
+		float BloomResolutionScale = 0.5f;   // Fraction of the window size
+		int BloomBlurPasses = 5;
+
+		// IBL (precomputed; applied when the environment is (re)generated)
+		int IrradianceResolution = 32;
+		float IrradianceSampleDelta = 0.025f;
+		int PrefilterResolution = 512;
+		int PrefilterSampleCount = 1024;
+
+		// Lighting
+		int MaxPointLights = 4;
+
+		// Shadow filtering (fetch count per shaded pixel)
+		ShadowFilterMode ShadowFilter = ShadowFilterMode::PoissonDisk;
+		int ShadowFilterTaps = 16;
+	};
+
+	/**
+	 * Tuning for calibration and runtime adjustment.
+	 */
+	struct ScalabilityConfig
+	{
+		float TargetFrameMs = 16.6f;       // Budget a tier must meet
+
+		// Calibration
+		uint32_t CalibrationWarmupFrames = 10;    // Per tier, discarded
+		uint32_t CalibrationMeasureFrames = 30;   // Per tier, median compared to the target
+
+		// Runtime adjustment
+		bool AutoAdjust = true;
+		float DowngradeRatio = 1.1f;       // Sustained cost above Target * this steps down
+		float UpgradeRatio = 0.6f;         // Sustained cost below Target * this steps up
+		float DowngradeSeconds = 2.0f;     // How long the cost must stay high
+		float UpgradeSeconds = 5.0f;       // How long the cost must stay low
+		float UpgradeCooldownSeconds = 10.0f;   // No upgrade this soon after a downgrade
+		float SmoothingFactor = 0.1f;      // EMA weight of the newest frame
+	};
+
+	/**
+	 * Groups the expensive quality settings into tiers and picks one.
+	 *
+	 * At startup BeginCalibration() renders a short benchmark: starting at
+	 * Ultra, each tier is applied, warmed up and measured for a fixed number
+	 * of frames, and the highest tier whose median frame cost meets the
+	 * target wins. Afterwards the manager watches a smoothed frame cost and
+	 * steps one tier down when it stays over budget, or back up when it stays
+	 * well under, with hysteresis and a cooldown to avoid oscillating.
+	 *
+	 * Frame cost is the larger of the Profiler's GPU frame time and CPU pass
+	 * time, so vsync waits do not count against a tier. When the profiler
+	 * reports no passes the frame delta time is used instead.
+	 *
+	 * The manager only decides; the application applies GetSettings() when
+	 * ConsumeChange() returns true.
+	 */
+	class VizEngine_API ScalabilityManager
+	{
+	public:
+		explicit ScalabilityManager(const ScalabilityConfig& config = {});
+
+		static const ScalabilitySettings& GetTierSettings(ScalabilityTier tier);
+		static const char* GetTierName(ScalabilityTier tier);
+
+		/**
+		 * Start the startup benchmark (sets the tier to Ultra).
+		 */
+		void BeginCalibration();
+		bool IsCalibrating() const { return m_Calibrating; }
+
+		/**
+		 * Feed one frame. Call once per frame, before rendering.
+		 * @param deltaTime Frame time in seconds (fallback cost)
+		 */
+		void Update(float deltaTime);
+
+		/**
+		 * Force a tier (e.g. from the UI).
+		 */
+		void SetTier(ScalabilityTier tier);
+		ScalabilityTier GetTier() const { return m_Tier; }
+		const ScalabilitySettings& GetSettings() const { return GetTierSettings(m_Tier); }
+
+		/**
+		 * @return true once after every tier change
+		 */
+		bool ConsumeChange();
+
+		void SetAutoAdjust(bool enabled) { m_Config.AutoAdjust = enabled; }
+		bool GetAutoAdjust() const { return m_Config.AutoAdjust; }
+
+		ScalabilityConfig& GetConfig() { return m_Config; }
+		float GetSmoothedFrameMs() const { return m_SmoothedMs; }
+		float GetLastCalibrationMs(ScalabilityTier tier) const { return m_CalibrationMs[static_cast<size_t>(tier)]; }
+
+	private:
+		bool SampleFrameCost(float deltaTime, float& costMs);
+		void ApplyTier(ScalabilityTier tier);
+		void UpdateCalibration(float costMs);
+		void UpdateRuntime(float costMs, float deltaTime);
+
+		ScalabilityConfig m_Config;
+		ScalabilityTier m_Tier = ScalabilityTier::High;
+		bool m_Changed = false;
+
+		// Calibration
+		bool m_Calibrating = false;
+		uint32_t m_CalibrationFrames = 0;
+		std::vector<float> m_CalibrationSamples;
+		float m_CalibrationMs[static_cast<size_t>(ScalabilityTier::Count)] = {};
+
+		// Runtime
+		uint64_t m_TierAppliedFrame = 0;   // Profiler frame; older samples are ignored
+		uint64_t m_LastSampledFrame = 0;
+		float m_SmoothedMs = 0.0f;
+		bool m_HasSmoothed = false;
+		float m_OverBudgetTime = 0.0f;
+		float m_UnderBudgetTime = 0.0f;
+		float m_SinceDowngrade = 0.0f;
+	};
+}
@@ -0,0 +1,225 @@
+// VizEngine/src/VizEngine/Renderer/SceneRenderList.cpp
+
+#include "SceneRenderList.h"
+#include <algorithm>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// Shift indices above a removed object down by one; drop the object itself
+		void EraseAndShift(std::vector<size_t>& indices, size_t removed)
+		{
+			size_t write = 0;
+			for (size_t index : indices)
+			{
+				if (index == removed) continue;
+				indices[write++] = index > removed ? index - 1 : index;
+			}
+			indices.resize(write);
+		}
+	}
+
+	SceneRenderList::SceneRenderList(Scene& scene)
+	{
+		Attach(scene);
+	}
+
+	SceneRenderList::~SceneRenderList()
+	{
+		Detach();
+	}
+
+	void SceneRenderList::Attach(Scene& scene)
+	{
+		Detach();
+
+		m_Scene = &scene;
+		m_ListenerID = scene.AddListener([this](SceneChange change, size_t index) {
+			OnSceneChange(change, index);
+		});
+		m_NeedsRebuild = true;
+	}
+
+	void SceneRenderList::Detach()
+	{
+		if (m_Scene)
+		{
+			m_Scene->RemoveListener(m_ListenerID);
+		}
+		m_Scene = nullptr;
+		m_ListenerID = 0;
+
+		m_Opaque.clear();
+		m_Transparent.clear();
+		m_TransparentOrder.clear();
+		m_Pending.clear();
+		m_NeedsRebuild = true;
+	}
+
+	void SceneRenderList::OnSceneChange(SceneChange change, size_t index)
+	{
+		switch (change)
+		{
+		case SceneChange::Added:
+		case SceneChange::Activation:
+		case SceneChange::Material:
+		case SceneChange::Mesh:
+			// Deferred to Update() so objects configured right after Add() classify correctly
+			m_Pending.push_back(index);
+			break;
+
+		case SceneChange::Removed:
+		{
+			// Indices shift immediately, so fix every list now
+			EraseAndShift(m_Opaque, index);
+			EraseAndShift(m_Pending, index);
+
+			size_t write = 0;
+			for (const TransparentEntry& entry : m_Transparent)
+			{
+				if (entry.Index == index) continue;
+				m_Transparent[write] = entry;
+				if (entry.Index > index) m_Transparent[write].Index--;
+				write++;
+			}
+			m_Transparent.resize(write);
+			m_TransparentDirty = true;
+			break;
+		}
+
+		case SceneChange::Cleared:
+			m_Opaque.clear();
+			m_Transparent.clear();
+			m_Pending.clear();
+			m_TransparentDirty = true;
+			break;
+
+		case SceneChange::Transform:
+			m_TransparentDirty = true;
+			break;
+		}
+	}
+
+	void SceneRenderList::Update(const glm::vec3& cameraPosition)
+	{
+		m_LastReclassified = 0;
+		m_LastResorted = false;
+		if (!m_Scene) return;
+
+		if (m_NeedsRebuild)
+		{
+			Rebuild();
+		}
+		else if (!m_Pending.empty())
+		{
+			std::sort(m_Pending.begin(), m_Pending.end());
+			m_Pending.erase(std::unique(m_Pending.begin(), m_Pending.end()), m_Pending.end());
+
+			for (size_t index : m_Pending)
+			{
+				Reclassify(index);
+			}
+			m_LastReclassified = m_Pending.size();
+			m_Pending.clear();
+		}
+
+		if (m_TransparentDirty || cameraPosition != m_LastCameraPosition)
+		{
+			SortTransparent(cameraPosition);
+		}
+	}
+
+	void SceneRenderList::Rebuild()
+	{
+		m_Opaque.clear();
+		m_Transparent.clear();
+		m_Pending.clear();
+
+		const Scene& scene = *m_Scene;
+		for (size_t i = 0; i < scene.Size(); i++)
+		{
+			const SceneObject& obj = scene[i];
+			if (!obj.Active || !obj.MeshPtr) continue;
+
+			if (obj.Color.a < 1.0f)
+				m_Transparent.push_back({ i, 0.0f });
+			else
+				m_Opaque.push_back(i);
+		}
+
+		m_LastReclassified = scene.Size();
+		m_NeedsRebuild = false;
+		m_TransparentDirty = true;
+	}
+
+	void SceneRenderList::Reclassify(size_t index)
+	{
+		// Drop the old entry, wherever it was
+		auto opaqueIt = std::lower_bound(m_Opaque.begin(), m_Opaque.end(), index);
+		bool wasOpaque = opaqueIt != m_Opaque.end() && *opaqueIt == index;
+		if (wasOpaque)
+		{
+			opaqueIt = m_Opaque.erase(opaqueIt);
+		}
+		else
+		{
+			auto transparentIt = std::find_if(m_Transparent.begin(), m_Transparent.end(),
+				[index](const TransparentEntry& entry) { return entry.Index == index; });
+			if (transparentIt != m_Transparent.end())
+			{
+				m_Transparent.erase(transparentIt);
+				m_TransparentDirty = true;
+			}
+		}
+
+		if (index >= m_Scene->Size()) return;
+
+		const SceneObject& obj = (*m_Scene)[index];
+		if (!obj.Active || !obj.MeshPtr) return;
+
+		if (obj.Color.a < 1.0f)
+		{
+			// Appended at the far end; the next sort moves it into place
+			m_Transparent.push_back({ index, 0.0f });
+			m_TransparentDirty = true;
+		}
+		else
+		{
+			m_Opaque.insert(opaqueIt, index);
+		}
+	}
+
+	void SceneRenderList::SortTransparent(const glm::vec3& cameraPosition)
+	{
+		const Scene& scene = *m_Scene;
+		for (TransparentEntry& entry : m_Transparent)
+		{
+			glm::vec3 toCamera = scene[entry.Index].ObjectTransform.Position - cameraPosition;
+			entry.DistanceSq = glm::dot(toCamera, toCamera);
+		}
+
+		// Insertion sort, far to near: last frame's order is nearly sorted
+		for (size_t i = 1; i < m_Transparent.size(); i++)
+		{
+			TransparentEntry entry = m_Transparent[i];
+			size_t j = i;
+			while (j > 0 && m_Transparent[j - 1].DistanceSq < entry.DistanceSq)
+			{
+				m_Transparent[j] = m_Transparent[j - 1];
+				j--;
+			}
+			m_Transparent[j] = entry;
+		}
+
+		m_TransparentOrder.resize(m_Transparent.size());
+		for (size_t i = 0; i < m_Transparent.size(); i++)
+		{
+			m_TransparentOrder[i] = m_Transparent[i].Index;
+		}
+
+		m_LastCameraPosition = cameraPosition;
+		m_TransparentDirty = false;
+		m_LastResorted = true;
+	}
+}
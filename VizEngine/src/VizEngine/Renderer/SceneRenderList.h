@@ -0,0 +1,95 @@
+// VizEngine/src/VizEngine/Renderer/SceneRenderList.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Scene.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Opaque and transparent draw lists for a Scene, kept across frames.
+	 *
+	 * The list subscribes to the scene's change notifications and only
+	 * reclassifies objects that were added, removed, toggled or had their
+	 * material or mesh changed, so steady-state frames do no per-object work.
+	 * Opaque entries stay in scene order. Transparent entries keep last
+	 * frame's back-to-front order and are fixed up with insertion sort, which
+	 * is linear when little has moved; nothing is re-sorted unless the camera
+	 * or an object moved.
+	 *
+	 * Classification matches the forward pass: an object is drawn if it is
+	 * Active and has a mesh, and is transparent if Color.a < 1.
+	 *
+	 * The list must not outlive the scene it is attached to.
+	 */
+	class VizEngine_API SceneRenderList
+	{
+	public:
+		SceneRenderList() = default;
+		explicit SceneRenderList(Scene& scene);
+		~SceneRenderList();
+
+		SceneRenderList(const SceneRenderList&) = delete;
+		SceneRenderList& operator=(const SceneRenderList&) = delete;
+
+		/**
+		 * Subscribe to a scene. The lists are built on the next Update().
+		 */
+		void Attach(Scene& scene);
+
+		/**
+		 * Unsubscribe and clear the lists.
+		 */
+		void Detach();
+
+		/**
+		 * Apply pending scene changes and restore back-to-front order.
+		 * Cheap to call more than once per frame.
+		 * @param cameraPosition Camera position for transparent sorting
+		 */
+		void Update(const glm::vec3& cameraPosition);
+
+		/** Object indices to draw first, in scene order. */
+		const std::vector<size_t>& GetOpaque() const { return m_Opaque; }
+
+		/** Object indices to draw after the opaques, far to near. */
+		const std::vector<size_t>& GetTransparent() const { return m_TransparentOrder; }
+
+		/** Objects reclassified by the last Update() (scene size after a rebuild). */
+		size_t GetLastReclassified() const { return m_LastReclassified; }
+
+		/** True if the last Update() re-sorted the transparent list. */
+		bool WasResorted() const { return m_LastResorted; }
+
+	private:
+		struct TransparentEntry
+		{
+			size_t Index;
+			float DistanceSq;
+		};
+
+		void OnSceneChange(SceneChange change, size_t index);
+		void Rebuild();
+		void Reclassify(size_t index);
+		void SortTransparent(const glm::vec3& cameraPosition);
+
+		Scene* m_Scene = nullptr;
+		uint32_t m_ListenerID = 0;
+
+		std::vector<size_t> m_Opaque;                  // Ascending scene index
+		std::vector<TransparentEntry> m_Transparent;   // Far to near (as of last sort)
+		std::vector<size_t> m_TransparentOrder;        // Indices of m_Transparent, for callers
+		std::vector<size_t> m_Pending;                 // Objects to reclassify
+
+		glm::vec3 m_LastCameraPosition = glm::vec3(0.0f);
+		bool m_NeedsRebuild = true;
+		bool m_TransparentDirty = true;                // Membership or positions changed
+
+		size_t m_LastReclassified = 0;
+		bool m_LastResorted = false;
+	};
+}
@@ -32,7 +32,7 @@ namespace VizEngine
         }
         else
         {
-            SetTexture("u_Texture", nullptr, 0);
+            ClearTexture("u_Texture");
             SetBool("u_UseTexture", false);
         }
     }
@@ -0,0 +1,645 @@
+// VizEngine/src/VizEngine/Renderer/VirtualShadowMap.cpp
+
+#include "VirtualShadowMap.h"
+#include "RenderViewSet.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include "gtc/matrix_transform.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VizEngine
+{
+	namespace
+	{
+		/**
+		 * Start of the page table buffer (std430, 352 bytes). Mirrored by
+		 * VirtualShadowPageTable in defaultlit.shader and vsm_mark.shader.
+		 */
+		struct PageTableHeader
+		{
+			glm::mat4 LightView;
+			glm::vec4 Params;       // x = level-0 page size (world), y = pixel scale, z = depth range, w = LOD bias
+			glm::ivec4 Layout;      // x = levels, y = pages per axis, z = page texels, w = physical pages per axis
+			glm::ivec4 Origins[VirtualShadowMap::MaxLevels];   // xy = first world page of the level's window
+		};
+
+		static_assert(sizeof(PageTableHeader) == 352, "PageTableHeader must match the std430 layout");
+
+		// Request buffer: count and 3 pad words, then frame stamps and the list
+		constexpr size_t RequestHeaderBytes = 16;
+
+		bool IsPowerOfTwo(int value)
+		{
+			return value > 0 && (value & (value - 1)) == 0;
+		}
+
+		glm::mat4 LightViewMatrix(const glm::vec3& direction)
+		{
+			glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+			if (glm::abs(glm::dot(direction, up)) > 0.999f)
+			{
+				up = glm::vec3(0.0f, 0.0f, 1.0f);
+			}
+			return glm::lookAt(glm::vec3(0.0f), direction, up);
+		}
+	}
+
+	VirtualShadowMap::VirtualShadowMap(const VirtualShadowMapConfig& config)
+		: m_Config(config)
+	{
+		if (config.PageSize <= 0 || !IsPowerOfTwo(config.PagesPerAxis)
+			|| config.Levels < 1 || config.Levels > MaxLevels
+			|| config.PhysicalPagesPerAxis <= 0 || config.Level0Extent <= 0.0f || config.DepthRange <= 0.0f)
+		{
+			VP_CORE_ERROR("VirtualShadowMap: invalid configuration (pages per axis must be a power of two, 1-{} levels)", MaxLevels);
+			return;
+		}
+
+		int maxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+		const int atlasSize = config.PhysicalPagesPerAxis * config.PageSize;
+		if (atlasSize > maxTextureSize)
+		{
+			VP_CORE_ERROR("VirtualShadowMap: atlas of {}^2 exceeds GL_MAX_TEXTURE_SIZE {}", atlasSize, maxTextureSize);
+			return;
+		}
+
+		m_MarkShader = std::make_unique<Shader>("resources/shaders/vsm_mark.shader");
+		if (!m_MarkShader->IsValid())
+		{
+			VP_CORE_ERROR("VirtualShadowMap: failed to load vsm_mark.shader");
+			return;
+		}
+
+		// Sampled through the shadow map slots: nearest for raw reads, the
+		// material's comparison sampler for filtered ones
+		m_Atlas = std::make_shared<Texture>(atlasSize, atlasSize, GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT);
+		m_Atlas->SetFilter(GL_NEAREST, GL_NEAREST);
+		m_Atlas->SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+
+		m_Framebuffer = std::make_unique<Framebuffer>(atlasSize, atlasSize);
+		m_Framebuffer->AttachDepthTexture(m_Atlas);
+		if (!m_Framebuffer->IsComplete())
+		{
+			VP_CORE_ERROR("VirtualShadowMap: atlas framebuffer not complete");
+			return;
+		}
+
+		const size_t pagesPerLevel = static_cast<size_t>(config.PagesPerAxis) * config.PagesPerAxis;
+		const size_t virtualPages = pagesPerLevel * config.Levels;
+		const size_t physicalPages = static_cast<size_t>(config.PhysicalPagesPerAxis) * config.PhysicalPagesPerAxis;
+
+		m_Entries.resize(virtualPages);
+		m_Table.assign(virtualPages, 0u);
+		m_Origins.assign(config.Levels, glm::ivec2(INT32_MIN / 2));
+		m_Physical.resize(physicalPages);
+		m_FreePages.reserve(physicalPages);
+		for (size_t i = physicalPages; i-- > 0;)
+		{
+			m_FreePages.push_back(static_cast<int32_t>(i));
+		}
+
+		const size_t tableBytes = sizeof(PageTableHeader) + virtualPages * sizeof(uint32_t);
+		std::vector<uint8_t> zeros(tableBytes, 0);
+		m_PageTable = std::make_unique<ShaderStorageBuffer>(zeros.data(), tableBytes, GL_DYNAMIC_DRAW);
+
+		// Frame stamps start at 0; the first frame is 1
+		const size_t requestBytes = RequestHeaderBytes + virtualPages * 2 * sizeof(uint32_t);
+		zeros.assign(requestBytes, 0);
+		m_Requests = std::make_unique<ShaderStorageBuffer>(zeros.data(), requestBytes, GL_DYNAMIC_COPY);
+		m_RequestList.reserve(virtualPages);
+
+		m_Stats.PhysicalPages = static_cast<uint32_t>(physicalPages);
+		m_Stats.AtlasBytes = static_cast<size_t>(atlasSize) * atlasSize * sizeof(float);
+		m_Stats.PageTableBytes = tableBytes;
+		m_Stats.RequestBytes = requestBytes;
+
+		m_IsValid = true;
+		VP_CORE_INFO("VirtualShadowMap: {} levels of {}^2 virtual texels, {} physical pages ({} MB)",
+			config.Levels, config.PagesPerAxis * config.PageSize, physicalPages, m_Stats.AtlasBytes / (1024 * 1024));
+	}
+
+	VirtualShadowMap::~VirtualShadowMap()
+	{
+		if (m_RequestFence)
+		{
+			glDeleteSync(m_RequestFence);
+		}
+	}
+
+	float VirtualShadowMap::PageWorldSize(int level) const
+	{
+		return m_Config.Level0Extent / static_cast<float>(m_Config.PagesPerAxis) * static_cast<float>(1 << level);
+	}
+
+	uint32_t VirtualShadowMap::EntryIndex(int level, int32_t x, int32_t y) const
+	{
+		// Two's complement masking wraps negative page coordinates too
+		const int32_t mask = m_Config.PagesPerAxis - 1;
+		const uint32_t pages = static_cast<uint32_t>(m_Config.PagesPerAxis);
+		return (static_cast<uint32_t>(level) * pages + static_cast<uint32_t>(y & mask)) * pages + static_cast<uint32_t>(x & mask);
+	}
+
+	glm::mat4 VirtualShadowMap::PageMatrix(const PhysicalPage& page) const
+	{
+		const PageEntry& entry = m_Entries[page.Entry];
+		const float size = PageWorldSize(page.Level);
+		const float x = static_cast<float>(entry.X) * size;
+		const float y = static_cast<float>(entry.Y) * size;
+
+		// Depth = 0.5 - z / (2 * DepthRange), as reconstructed by the samplers
+		glm::mat4 projection = glm::ortho(x, x + size, y, y + size, -m_Config.DepthRange, m_Config.DepthRange);
+		return projection * m_LightView;
+	}
+
+	// =========================================================================
+	// Per-frame update
+	// =========================================================================
+
+	void VirtualShadowMap::Update(const glm::mat4& view, const glm::mat4& projection, int viewportHeight,
+		const glm::vec3& lightDirection, const std::vector<ObjectFrameData>& casters)
+	{
+		if (!m_IsValid) return;
+
+		m_Frame++;
+		// Counters restart; the sizes are fixed
+		VirtualShadowMapStats stats;
+		stats.PhysicalPages = m_Stats.PhysicalPages;
+		stats.AtlasBytes = m_Stats.AtlasBytes;
+		stats.PageTableBytes = m_Stats.PageTableBytes;
+		stats.RequestBytes = m_Stats.RequestBytes;
+		m_Stats = stats;
+
+		// A turned light changes every page
+		const glm::vec3 direction = glm::normalize(lightDirection);
+		if (glm::dot(direction, m_LightDirection) < 0.99999f)
+		{
+			m_LightDirection = direction;
+			m_LightView = LightViewMatrix(direction);
+			InvalidateAll();
+		}
+
+		const glm::mat4 inverseView = glm::inverse(view);
+		m_CameraPosition = glm::vec3(inverseView[3]);
+		m_InvViewProjection = glm::inverse(projection * view);
+		m_PixelScale = 2.0f / (projection[1][1] * static_cast<float>(std::max(viewportHeight, 1)));
+
+		UpdateWindows(m_CameraPosition);
+		TrackCasters(casters);
+		m_HasRequests = ReadRequests();
+		AllocatePages();
+		UploadPageTable();
+
+		m_Stats.ResidentPages = m_Stats.PhysicalPages - static_cast<uint32_t>(m_FreePages.size());
+	}
+
+	void VirtualShadowMap::UpdateWindows(const glm::vec3& cameraPosition)
+	{
+		const glm::vec3 camera = glm::vec3(m_LightView * glm::vec4(cameraPosition, 1.0f));
+		const int32_t half = m_Config.PagesPerAxis / 2;
+		const uint32_t pagesPerLevel = static_cast<uint32_t>(m_Config.PagesPerAxis) * m_Config.PagesPerAxis;
+
+		for (int level = 0; level < m_Config.Levels; level++)
+		{
+			const float size = PageWorldSize(level);
+			const glm::ivec2 origin(
+				static_cast<int32_t>(std::floor(camera.x / size)) - half,
+				static_cast<int32_t>(std::floor(camera.y / size)) - half);
+			if (origin == m_Origins[level]) continue;
+			m_Origins[level] = origin;
+
+			// Pages that scrolled out of the window give their memory back
+			const glm::ivec2 end = origin + glm::ivec2(m_Config.PagesPerAxis);
+			const uint32_t first = static_cast<uint32_t>(level) * pagesPerLevel;
+			for (uint32_t i = first; i < first + pagesPerLevel; i++)
+			{
+				const PageEntry& entry = m_Entries[i];
+				if (entry.Physical < 0) continue;
+				if (entry.X < origin.x || entry.X >= end.x || entry.Y < origin.y || entry.Y >= end.y)
+				{
+					FreePage(entry.Physical);
+				}
+			}
+		}
+	}
+
+	void VirtualShadowMap::TrackCasters(const std::vector<ObjectFrameData>& casters)
+	{
+		m_Casters.resize(casters.size());
+
+		for (size_t i = 0; i < casters.size(); i++)
+		{
+			const ObjectFrameData& data = casters[i];
+			const glm::vec3 light = glm::vec3(m_LightView * glm::vec4(data.BoundsCenter, 1.0f));
+			m_Casters[i] = { glm::vec2(light), data.BoundsRadius };
+
+			if (data.SceneIndex >= m_CasterStates.size())
+			{
+				m_CasterStates.resize(data.SceneIndex + 1);
+			}
+
+			// New, moved or rotated casters dirty the pages they left and the ones they reach
+			CasterState& state = m_CasterStates[data.SceneIndex];
+			if (state.Radius != data.BoundsRadius || state.Center != data.BoundsCenter || state.Model != data.Model)
+			{
+				if (state.Radius >= 0.0f)
+				{
+					InvalidateSphere(state.Center, state.Radius);
+				}
+				InvalidateSphere(data.BoundsCenter, data.BoundsRadius);
+				state.Model = data.Model;
+				state.Center = data.BoundsCenter;
+				state.Radius = data.BoundsRadius;
+			}
+			state.Seen = m_Frame;
+		}
+
+		// Removed or hidden casters
+		for (CasterState& state : m_CasterStates)
+		{
+			if (state.Radius >= 0.0f && state.Seen != m_Frame)
+			{
+				InvalidateSphere(state.Center, state.Radius);
+				state.Radius = -1.0f;
+			}
+		}
+	}
+
+	void VirtualShadowMap::InvalidateAll()
+	{
+		for (size_t i = 0; i < m_Physical.size(); i++)
+		{
+			FreePage(static_cast<int32_t>(i));
+		}
+	}
+
+	void VirtualShadowMap::InvalidateSphere(const glm::vec3& center, float radius)
+	{
+		if (!m_IsValid) return;
+
+		// The light view is a rotation, so the radius carries over
+		const glm::vec2 light = glm::vec2(m_LightView * glm::vec4(center, 1.0f));
+
+		for (int level = 0; level < m_Config.Levels; level++)
+		{
+			const float size = PageWorldSize(level);
+			const glm::ivec2 origin = m_Origins[level];
+			const glm::ivec2 last = origin + glm::ivec2(m_Config.PagesPerAxis - 1);
+
+			const int32_t x0 = std::max(origin.x, static_cast<int32_t>(std::floor((light.x - radius) / size)));
+			const int32_t x1 = std::min(last.x, static_cast<int32_t>(std::floor((light.x + radius) / size)));
+			const int32_t y0 = std::max(origin.y, static_cast<int32_t>(std::floor((light.y - radius) / size)));
+			const int32_t y1 = std::min(last.y, static_cast<int32_t>(std::floor((light.y + radius) / size)));
+
+			for (int32_t y = y0; y <= y1; y++)
+			{
+				for (int32_t x = x0; x <= x1; x++)
+				{
+					const PageEntry& entry = m_Entries[EntryIndex(level, x, y)];
+					if (entry.Physical < 0 || entry.X != x || entry.Y != y) continue;
+
+					PhysicalPage& page = m_Physical[entry.Physical];
+					if (!page.Dirty)
+					{
+						page.Dirty = true;
+						m_Stats.InvalidatedPages++;
+					}
+				}
+			}
+		}
+	}
+
+	// =========================================================================
+	// Page requests and allocation
+	// =========================================================================
+
+	bool VirtualShadowMap::ReadRequests()
+	{
+		m_RequestList.clear();
+		if (!m_RequestFence) return false;
+
+		// Never stall: requests still in flight are read next frame
+		GLenum status = glClientWaitSync(m_RequestFence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED) return false;
+
+		glDeleteSync(m_RequestFence);
+		m_RequestFence = nullptr;
+		if (status == GL_WAIT_FAILED) return false;
+
+		const size_t virtualPages = m_Entries.size();
+		uint32_t count = 0;
+		glGetNamedBufferSubData(m_Requests->GetID(), 0, sizeof(uint32_t), &count);
+		count = std::min<uint32_t>(count, static_cast<uint32_t>(virtualPages));
+
+		m_RequestList.resize(count);
+		if (count > 0)
+		{
+			const size_t listOffset = RequestHeaderBytes + virtualPages * sizeof(uint32_t);
+			glGetNamedBufferSubData(m_Requests->GetID(), static_cast<GLintptr>(listOffset),
+				static_cast<GLsizeiptr>(count * sizeof(uint32_t)), m_RequestList.data());
+		}
+
+		m_Stats.RequestedPages = count;
+		return true;
+	}
+
+	void VirtualShadowMap::AllocatePages()
+	{
+		m_RenderQueue.clear();
+		m_EvictionOrder.clear();
+		m_EvictionCursor = 0;
+		m_EvictionSorted = false;
+		for (PhysicalPage& page : m_Physical)
+		{
+			page.Queued = false;
+		}
+
+		const size_t budget = static_cast<size_t>(std::max(m_Config.MaxPagesPerFrame, 0));
+		auto queue = [&](int32_t physical) {
+			if (m_RenderQueue.size() >= budget)
+			{
+				m_Stats.DeferredPages++;
+				return;
+			}
+			m_Physical[physical].Queued = true;
+			m_RenderQueue.push_back(physical);
+		};
+
+		if (m_HasRequests)
+		{
+			// Coarse levels first: they are the fallback for everything finer
+			std::sort(m_RequestList.begin(), m_RequestList.end(), std::greater<uint32_t>());
+
+			const uint32_t pagesPerLevel = static_cast<uint32_t>(m_Config.PagesPerAxis) * m_Config.PagesPerAxis;
+			const int32_t mask = m_Config.PagesPerAxis - 1;
+
+			// Keep every requested resident page before evicting anything
+			for (uint32_t index : m_RequestList)
+			{
+				const PageEntry& entry = m_Entries[index];
+				if (entry.Physical >= 0)
+				{
+					m_Physical[entry.Physical].LastUsed = m_Frame;
+				}
+			}
+
+			for (uint32_t index : m_RequestList)
+			{
+				PageEntry& entry = m_Entries[index];
+				if (entry.Physical >= 0)
+				{
+					PhysicalPage& page = m_Physical[entry.Physical];
+					if (!page.Dirty)
+						m_Stats.CachedPages++;
+					else if (!page.Queued)
+						queue(entry.Physical);
+					continue;
+				}
+
+				if (m_RenderQueue.size() >= budget)
+				{
+					m_Stats.DeferredPages++;
+					continue;
+				}
+
+				const int32_t physical = AcquirePage();
+				if (physical < 0)
+				{
+					m_Stats.DeferredPages++;
+					continue;
+				}
+
+				// The world page inside the current window that wraps to this entry
+				const int level = static_cast<int>(index / pagesPerLevel);
+				const uint32_t local = index % pagesPerLevel;
+				const int32_t wrappedX = static_cast<int32_t>(local % m_Config.PagesPerAxis);
+				const int32_t wrappedY = static_cast<int32_t>(local / m_Config.PagesPerAxis);
+				const glm::ivec2 origin = m_Origins[level];
+				entry.X = origin.x + ((wrappedX - origin.x) & mask);
+				entry.Y = origin.y + ((wrappedY - origin.y) & mask);
+
+				MapPage(physical, level, index);
+				queue(physical);
+			}
+		}
+		else
+		{
+			// No fresh requests: refresh what is already resident
+			for (size_t i = 0; i < m_Physical.size(); i++)
+			{
+				const PhysicalPage& page = m_Physical[i];
+				if (page.Level >= 0 && page.Dirty)
+				{
+					queue(static_cast<int32_t>(i));
+				}
+			}
+		}
+
+		// Stale pages that will not be rendered must not be sampled
+		for (size_t i = 0; i < m_Physical.size(); i++)
+		{
+			const PhysicalPage& page = m_Physical[i];
+			if (page.Level >= 0 && page.Dirty && !page.Queued)
+			{
+				FreePage(static_cast<int32_t>(i));
+			}
+		}
+	}
+
+	int32_t VirtualShadowMap::AcquirePage()
+	{
+		if (m_FreePages.empty())
+		{
+			// Least recently requested first; pages requested this frame stay
+			if (!m_EvictionSorted)
+			{
+				m_EvictionSorted = true;
+				for (size_t i = 0; i < m_Physical.size(); i++)
+				{
+					if (m_Physical[i].Level >= 0 && m_Physical[i].LastUsed < m_Frame)
+					{
+						m_EvictionOrder.push_back(static_cast<int32_t>(i));
+					}
+				}
+				std::sort(m_EvictionOrder.begin(), m_EvictionOrder.end(), [this](int32_t a, int32_t b) {
+					return m_Physical[a].LastUsed < m_Physical[b].LastUsed;
+				});
+			}
+
+			while (m_EvictionCursor < m_EvictionOrder.size())
+			{
+				const int32_t candidate = m_EvictionOrder[m_EvictionCursor++];
+				const PhysicalPage& page = m_Physical[candidate];
+				if (page.Level < 0 || page.LastUsed >= m_Frame) continue;
+
+				FreePage(candidate);
+				m_Stats.EvictedPages++;
+				break;
+			}
+
+			if (m_FreePages.empty()) return -1;
+		}
+
+		const int32_t physical = m_FreePages.back();
+		m_FreePages.pop_back();
+		return physical;
+	}
+
+	void VirtualShadowMap::MapPage(int32_t physical, int level, uint32_t entry)
+	{
+		PhysicalPage& page = m_Physical[physical];
+		page.Level = level;
+		page.Entry = entry;
+		page.LastUsed = m_Frame;
+		page.Dirty = true;
+
+		m_Entries[entry].Physical = physical;
+		m_Table[entry] = static_cast<uint32_t>(physical) + 1u;
+		m_TableDirty = true;
+	}
+
+	void VirtualShadowMap::FreePage(int32_t physical)
+	{
+		PhysicalPage& page = m_Physical[physical];
+		if (page.Level < 0) return;
+
+		m_Entries[page.Entry].Physical = -1;
+		m_Table[page.Entry] = 0u;
+		m_TableDirty = true;
+
+		page = PhysicalPage();
+		m_FreePages.push_back(physical);
+	}
+
+	void VirtualShadowMap::UploadPageTable()
+	{
+		PageTableHeader header = {};
+		header.LightView = m_LightView;
+		header.Params = glm::vec4(PageWorldSize(0), m_PixelScale, m_Config.DepthRange, m_LodBias);
+		header.Layout = glm::ivec4(m_Config.Levels, m_Config.PagesPerAxis, m_Config.PageSize, m_Config.PhysicalPagesPerAxis);
+		for (int level = 0; level < m_Config.Levels; level++)
+		{
+			header.Origins[level] = glm::ivec4(m_Origins[level], 0, 0);
+		}
+		m_PageTable->SetData(&header, sizeof(header), 0);
+
+		if (m_TableDirty)
+		{
+			m_PageTable->SetData(m_Table.data(), m_Table.size() * sizeof(uint32_t), sizeof(header));
+			m_TableDirty = false;
+		}
+	}
+
+	// =========================================================================
+	// GPU passes
+	// =========================================================================
+
+	void VirtualShadowMap::RenderPages(Shader& depthShader, const std::function<void(uint32_t object)>& drawCaster)
+	{
+		if (!m_IsValid || m_RenderQueue.empty()) return;
+
+		int savedViewport[4];
+		glGetIntegerv(GL_VIEWPORT, savedViewport);
+
+		m_Framebuffer->Bind();
+		glEnable(GL_SCISSOR_TEST);
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+		glDepthFunc(GL_LESS);
+
+		// Casters in front of the depth range are flattened onto its near plane
+		glEnable(GL_DEPTH_CLAMP);
+		glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(2.0f, 4.0f);
+
+		depthShader.Bind();
+
+		const int pageSize = m_Config.PageSize;
+		for (int32_t physical : m_RenderQueue)
+		{
+			PhysicalPage& page = m_Physical[physical];
+			const int x = (physical % m_Config.PhysicalPagesPerAxis) * pageSize;
+			const int y = (physical / m_Config.PhysicalPagesPerAxis) * pageSize;
+			glViewport(x, y, pageSize, pageSize);
+			glScissor(x, y, pageSize, pageSize);
+			glClear(GL_DEPTH_BUFFER_BIT);
+
+			depthShader.SetMatrix4fv("u_LightSpaceMatrix", PageMatrix(page));
+
+			// Only casters whose light-space bounds reach the page
+			const PageEntry& entry = m_Entries[page.Entry];
+			const float size = PageWorldSize(page.Level);
+			const glm::vec2 pageMin = glm::vec2(static_cast<float>(entry.X), static_cast<float>(entry.Y)) * size;
+			const glm::vec2 pageMax = pageMin + glm::vec2(size);
+
+			for (size_t i = 0; i < m_Casters.size(); i++)
+			{
+				const Caster& caster = m_Casters[i];
+				const glm::vec2 delta = caster.LightXY - glm::clamp(caster.LightXY, pageMin, pageMax);
+				if (glm::dot(delta, delta) > caster.Radius * caster.Radius)
+				{
+					m_Stats.CastersCulled++;
+					continue;
+				}
+
+				drawCaster(static_cast<uint32_t>(i));
+				m_Stats.CasterDraws++;
+			}
+
+			page.Dirty = false;
+		}
+		m_Stats.RenderedPages = static_cast<uint32_t>(m_RenderQueue.size());
+		m_RenderQueue.clear();
+
+		glDisable(GL_POLYGON_OFFSET_FILL);
+		glDisable(GL_DEPTH_CLAMP);
+		glDisable(GL_SCISSOR_TEST);
+		m_Framebuffer->Unbind();
+		glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+	}
+
+	void VirtualShadowMap::MarkPages(const Texture& sceneDepth)
+	{
+		if (!m_IsValid || m_Frame == 0) return;
+
+		// One scan in flight at a time; Update() has not consumed the last one
+		if (m_RequestFence) return;
+
+		const uint32_t zero = 0;
+		m_Requests->SetData(&zero, sizeof(zero), 0);
+
+		m_MarkShader->Bind();
+		sceneDepth.Bind(TextureSlots::Custom0);
+		m_MarkShader->SetInt("u_Depth", TextureSlots::Custom0);
+		m_MarkShader->SetMatrix4fv("u_InvViewProjection", m_InvViewProjection);
+		m_MarkShader->SetVec3("u_CameraPosition", m_CameraPosition);
+		m_MarkShader->SetInt("u_Frame", static_cast<int>(m_Frame));
+		m_PageTable->BindBase(PageTableBinding);
+		m_Requests->BindBase(RequestBinding);
+
+		const unsigned int groupsX = static_cast<unsigned int>((sceneDepth.GetWidth() + 7) / 8);
+		const unsigned int groupsY = static_cast<unsigned int>((sceneDepth.GetHeight() + 7) / 8);
+		glDispatchCompute(groupsX, groupsY, 1);
+
+		// Read back with glGetBufferSubData next frame
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		m_RequestFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_MarkShader->Unbind();
+	}
+
+	void VirtualShadowMap::BindPageTable() const
+	{
+		if (m_PageTable)
+		{
+			m_PageTable->BindBase(PageTableBinding);
+		}
+	}
+}
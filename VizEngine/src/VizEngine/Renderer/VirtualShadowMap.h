@@ -0,0 +1,227 @@
+// VizEngine/src/VizEngine/Renderer/VirtualShadowMap.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+typedef struct __GLsync* GLsync;
+
+namespace VizEngine
+{
+	class Framebuffer;
+	class Shader;
+	class ShaderStorageBuffer;
+	class Texture;
+	struct ObjectFrameData;
+
+	/**
+	 * Layout of the virtual and physical page space. Sizes are fixed for the
+	 * lifetime of a VirtualShadowMap.
+	 */
+	struct VirtualShadowMapConfig
+	{
+		int PageSize = 128;                // Texels per page side
+		int PagesPerAxis = 128;            // Per level (power of two): 16384^2 virtual texels
+		int Levels = 8;                    // Clipmap levels, each covering twice the previous (max 16)
+		float Level0Extent = 16.0f;        // World units across level 0
+		int PhysicalPagesPerAxis = 32;     // Atlas of 32x32 pages (4096^2 texels)
+		float DepthRange = 500.0f;         // Light-space depth covered on each side of the origin
+		int MaxPagesPerFrame = 128;        // Render budget; the rest waits for later frames
+	};
+
+	struct VirtualShadowMapStats
+	{
+		uint32_t RequestedPages = 0;       // Marked by the last depth scan that was read back
+		uint32_t CachedPages = 0;          // Requested and still valid
+		uint32_t RenderedPages = 0;        // Rendered this frame
+		uint32_t DeferredPages = 0;        // Requested but over the render budget
+		uint32_t InvalidatedPages = 0;     // Made dirty by moving casters this frame
+		uint32_t EvictedPages = 0;         // Reused for another virtual page this frame
+		uint32_t ResidentPages = 0;        // Physical pages holding a virtual page
+		uint32_t PhysicalPages = 0;
+		uint32_t CasterDraws = 0;          // Draws issued for all rendered pages
+		uint32_t CastersCulled = 0;        // Caster/page pairs skipped by the page bounds test
+		size_t AtlasBytes = 0;
+		size_t PageTableBytes = 0;
+		size_t RequestBytes = 0;
+	};
+
+	/**
+	 * Virtual shadow map for one directional light.
+	 *
+	 * The light sees the world through a clipmap of Levels square levels
+	 * centered on the camera, each PagesPerAxis pages across with twice the
+	 * world coverage of the one below; level 0 alone is 16384 texels wide
+	 * with the defaults. Only pages that receivers actually need are backed
+	 * by memory: a compute pass (MarkPages) reads the scene depth, picks for
+	 * every pixel the level whose texels match its screen footprint and
+	 * appends the page to a request list. Update() reads that list one frame
+	 * later, maps requested pages into a fixed physical atlas (least recently
+	 * used pages are evicted) and publishes the page table to shaders.
+	 *
+	 * Pages are addressed by world-anchored page coordinates, wrapped into
+	 * each level's table, so a page stays valid while the camera moves and
+	 * is only rendered again when a caster overlapping it moves, is added or
+	 * removed, or the light turns. Each rendered page draws only the casters
+	 * whose light-space bounds overlap it, with depth clamping so casters
+	 * outside the depth range still occlude.
+	 *
+	 * Shaders (defaultlit.shader with u_UseVirtualShadows) read the page
+	 * table from SSBO binding 5 and sample the atlas through the regular
+	 * shadow map slots; pages that are not resident fall back to coarser
+	 * levels, then to unshadowed.
+	 *
+	 * Usage (per frame):
+	 *   vsm.Update(view, projection, viewportHeight, lightDir, objects);
+	 *   vsm.RenderPages(depthShader, [&](uint32_t object) { draw object; });
+	 *   vsm.BindPageTable();  material.SetShadowMap(vsm.GetAtlas());
+	 *   ... render the scene ...
+	 *   vsm.MarkPages(*sceneDepth);
+	 */
+	class VizEngine_API VirtualShadowMap
+	{
+	public:
+		static constexpr unsigned int PageTableBinding = 5;
+		static constexpr unsigned int RequestBinding = 6;
+		static constexpr int MaxLevels = 16;
+
+		explicit VirtualShadowMap(const VirtualShadowMapConfig& config = VirtualShadowMapConfig());
+		~VirtualShadowMap();
+
+		VirtualShadowMap(const VirtualShadowMap&) = delete;
+		VirtualShadowMap& operator=(const VirtualShadowMap&) = delete;
+
+		bool IsValid() const { return m_IsValid; }
+
+		/**
+		 * Consume the last page requests, track caster changes and allocate
+		 * the pages to render this frame.
+		 * @param view Camera view matrix
+		 * @param projection Camera perspective projection
+		 * @param viewportHeight Height in pixels of the depth MarkPages() will scan
+		 * @param lightDirection Direction the light travels (normalized)
+		 * @param casters Per-object data of every shadow caster
+		 */
+		void Update(const glm::mat4& view, const glm::mat4& projection, int viewportHeight,
+			const glm::vec3& lightDirection, const std::vector<ObjectFrameData>& casters);
+
+		/**
+		 * Render the pages allocated by Update() into the atlas.
+		 * @param depthShader Depth-only shader with u_LightSpaceMatrix
+		 * @param drawCaster Sets the model matrix and draws casters[object]
+		 */
+		void RenderPages(Shader& depthShader, const std::function<void(uint32_t object)>& drawCaster);
+
+		/**
+		 * Record the pages the scene depth needs (compute). Uses the camera
+		 * of the last Update(); skipped while the previous requests are
+		 * still in flight.
+		 */
+		void MarkPages(const Texture& sceneDepth);
+
+		/** Bind the page table for sampling (binding PageTableBinding). */
+		void BindPageTable() const;
+
+		/** Drop every page (e.g. after a scene load). */
+		void InvalidateAll();
+
+		/** Re-render resident pages overlapping a world-space sphere. */
+		void InvalidateSphere(const glm::vec3& center, float radius);
+
+		void SetLodBias(float bias) { m_LodBias = bias; }
+		float GetLodBias() const { return m_LodBias; }
+
+		std::shared_ptr<Texture> GetAtlas() const { return m_Atlas; }
+		const VirtualShadowMapConfig& GetConfig() const { return m_Config; }
+		const VirtualShadowMapStats& GetStats() const { return m_Stats; }
+
+	private:
+		struct PageEntry
+		{
+			int32_t Physical = -1;         // Atlas page, -1 = not resident
+			int32_t X = 0;                 // World page coordinates
+			int32_t Y = 0;
+		};
+
+		struct PhysicalPage
+		{
+			int32_t Level = -1;            // -1 = free
+			uint32_t Entry = 0;            // Index into m_Entries
+			uint64_t LastUsed = 0;         // Frame it was last requested
+			bool Dirty = false;            // Contents out of date
+			bool Queued = false;           // Rendered this frame
+		};
+
+		struct CasterState
+		{
+			glm::mat4 Model = glm::mat4(1.0f);
+			glm::vec3 Center = glm::vec3(0.0f);
+			float Radius = -1.0f;          // < 0 = not seen
+			uint64_t Seen = 0;
+		};
+
+		struct Caster
+		{
+			glm::vec2 LightXY = glm::vec2(0.0f);
+			float Radius = 0.0f;
+		};
+
+		float PageWorldSize(int level) const;
+		uint32_t EntryIndex(int level, int32_t x, int32_t y) const;
+		glm::mat4 PageMatrix(const PhysicalPage& page) const;
+
+		void UpdateWindows(const glm::vec3& cameraPosition);
+		void TrackCasters(const std::vector<ObjectFrameData>& casters);
+		bool ReadRequests();
+		void AllocatePages();
+		int32_t AcquirePage();
+		void MapPage(int32_t physical, int level, uint32_t entry);
+		void FreePage(int32_t physical);
+		void UploadPageTable();
+
+		VirtualShadowMapConfig m_Config;
+		float m_LodBias = 0.0f;
+		bool m_IsValid = false;
+
+		// GPU resources
+		std::shared_ptr<Texture> m_Atlas;                 // DEPTH32F, PhysicalPagesPerAxis pages square
+		std::unique_ptr<Framebuffer> m_Framebuffer;
+		std::unique_ptr<ShaderStorageBuffer> m_PageTable; // Header + one uint per virtual page
+		std::unique_ptr<ShaderStorageBuffer> m_Requests;  // Count, frame stamps, request list
+		std::unique_ptr<Shader> m_MarkShader;
+		GLsync m_RequestFence = nullptr;
+
+		// Virtual page state
+		std::vector<PageEntry> m_Entries;                 // Level-major, wrapped coordinates
+		std::vector<uint32_t> m_Table;                    // GPU mirror: physical + 1, 0 = not resident
+		std::vector<glm::ivec2> m_Origins;                // First world page of each level's window
+		std::vector<PhysicalPage> m_Physical;
+		std::vector<int32_t> m_FreePages;
+		std::vector<int32_t> m_EvictionOrder;             // Built on first eviction of a frame
+		size_t m_EvictionCursor = 0;
+		bool m_EvictionSorted = false;
+		std::vector<uint32_t> m_RequestList;              // Entry indices read back this frame
+		std::vector<int32_t> m_RenderQueue;
+		bool m_TableDirty = true;
+		bool m_HasRequests = false;
+
+		// Casters
+		std::vector<CasterState> m_CasterStates;          // By scene index
+		std::vector<Caster> m_Casters;                    // By object index, this frame
+
+		// Light and camera of the last Update()
+		glm::mat4 m_LightView = glm::mat4(1.0f);
+		glm::vec3 m_LightDirection = glm::vec3(0.0f);
+		glm::mat4 m_InvViewProjection = glm::mat4(1.0f);
+		glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+		float m_PixelScale = 0.0f;                        // Pixel footprint per unit of distance
+
+		uint64_t m_Frame = 0;
+		VirtualShadowMapStats m_Stats;
+	};
+}
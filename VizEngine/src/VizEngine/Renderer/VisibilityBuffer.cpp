@@ -0,0 +1,411 @@
+// VizEngine/src/VizEngine/Renderer/VisibilityBuffer.cpp
+
+#include "VisibilityBuffer.h"
+#include "VizEngine/Core/Mesh.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/VertexArray.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <string>
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr size_t MinGeometryBytes = 1 << 20;
+
+		// Albedo textures share the material units; the resolve has no other maps
+		constexpr int AlbedoSlots[VisibilityBuffer::MaxAlbedoTextures] = {
+			TextureSlots::Albedo, TextureSlots::Normal, TextureSlots::MetallicRoughness, TextureSlots::AO
+		};
+	}
+
+	VisibilityBuffer::VisibilityBuffer(int width, int height)
+		: m_Width(width), m_Height(height)
+	{
+		m_GeometryShader = std::make_unique<Shader>("resources/shaders/visibility_pass.shader");
+		if (!m_GeometryShader->IsValid())
+		{
+			VP_CORE_ERROR("VisibilityBuffer: Failed to load visibility_pass.shader!");
+			return;
+		}
+
+		m_VAO = std::make_unique<VertexArray>();
+		m_Vertices = std::make_unique<ShaderStorageBuffer>(nullptr, MinGeometryBytes, GL_STATIC_DRAW);
+		m_Indices = std::make_unique<ShaderStorageBuffer>(nullptr, MinGeometryBytes, GL_STATIC_DRAW);
+		m_DrawTable = std::make_unique<ShaderStorageBuffer>(nullptr, sizeof(VisibilityDrawGPU) * 64);
+		m_CommandBuffer = std::make_unique<ShaderStorageBuffer>(nullptr, sizeof(IndirectCommand) * 64);
+
+		CreateTargets();
+	}
+
+	VisibilityBuffer::~VisibilityBuffer() = default;
+
+	void VisibilityBuffer::Resize(int width, int height)
+	{
+		if (width == m_Width && height == m_Height) return;
+		if (width <= 0 || height <= 0) return;
+
+		m_Width = width;
+		m_Height = height;
+		if (m_GeometryShader && m_GeometryShader->IsValid())
+		{
+			CreateTargets();
+		}
+	}
+
+	void VisibilityBuffer::CreateTargets()
+	{
+		m_IsValid = false;
+
+		// Integer ids are fetched, never filtered (linear filtering makes them incomplete)
+		m_IdTexture = std::make_shared<Texture>(
+			m_Width, m_Height, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT
+		);
+		m_IdTexture->SetFilter(GL_NEAREST, GL_NEAREST);
+
+		m_DepthTexture = std::make_shared<Texture>(
+			m_Width, m_Height, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT
+		);
+		m_DepthTexture->SetFilter(GL_NEAREST, GL_NEAREST);
+
+		m_Framebuffer = std::make_unique<Framebuffer>(m_Width, m_Height);
+		m_Framebuffer->AttachColorTexture(m_IdTexture, 0);
+		m_Framebuffer->AttachDepthTexture(m_DepthTexture);
+
+		if (!m_Framebuffer->IsComplete())
+		{
+			VP_CORE_ERROR("VisibilityBuffer: Framebuffer not complete!");
+			return;
+		}
+
+		m_IsValid = true;
+	}
+
+	void VisibilityBuffer::BeginFrame()
+	{
+		EvictStaleMeshes();
+
+		// Compact once most of the merged buffers belong to dropped ranges
+		size_t cachedBytes = m_VertexBytes + m_IndexBytes;
+		if (m_StaleBytes > MinGeometryBytes && m_StaleBytes * 2 > cachedBytes)
+		{
+			VP_CORE_INFO("VisibilityBuffer: Compacting geometry cache ({:.1f} MB, {:.1f} MB in use)",
+				cachedBytes / (1024.0 * 1024.0), (cachedBytes - m_StaleBytes) / (1024.0 * 1024.0));
+			Compact();
+		}
+
+		m_Frame++;
+		m_Draws.clear();
+		m_Commands.clear();
+		m_AlbedoTextures.clear();
+
+		m_Stats.Draws = 0;
+		m_Stats.Commands = 0;
+		m_Stats.Rejected = 0;
+		m_Stats.Triangles = 0;
+	}
+
+	bool VisibilityBuffer::Submit(MeshHandle meshId, const Mesh& mesh, const glm::mat4& model, const glm::mat3& normalMatrix,
+		const VisibilityMaterial& material)
+	{
+		uint32_t indexCount = mesh.GetIndexCount();
+		if (!m_IsValid || m_Draws.size() >= MaxDraws || indexCount / 3 > MaxTrianglesPerMesh)
+		{
+			m_Stats.Rejected++;
+			return false;
+		}
+
+		int textureIndex = -1;
+		if (material.AlbedoTexture)
+		{
+			auto it = std::find(m_AlbedoTextures.begin(), m_AlbedoTextures.end(), material.AlbedoTexture);
+			if (it != m_AlbedoTextures.end())
+			{
+				textureIndex = static_cast<int>(it - m_AlbedoTextures.begin());
+			}
+			else if (m_AlbedoTextures.size() < static_cast<size_t>(MaxAlbedoTextures))
+			{
+				textureIndex = static_cast<int>(m_AlbedoTextures.size());
+				m_AlbedoTextures.push_back(material.AlbedoTexture);
+			}
+			else
+			{
+				m_Stats.Rejected++;
+				return false;
+			}
+		}
+
+		const MeshRange* range = CacheMesh(meshId, mesh);
+		if (!range)
+		{
+			m_Stats.Rejected++;
+			return false;
+		}
+
+		// Same clamps as PBRMaterial, so both paths shade identically
+		VisibilityDrawGPU draw;
+		draw.Model = model;
+		draw.NormalMatrix[0] = glm::vec4(normalMatrix[0], 0.0f);
+		draw.NormalMatrix[1] = glm::vec4(normalMatrix[1], 0.0f);
+		draw.NormalMatrix[2] = glm::vec4(normalMatrix[2], 0.0f);
+		draw.BaseColor = glm::vec4(glm::vec3(material.BaseColor), glm::clamp(material.BaseColor.a, 0.0f, 1.0f));
+		draw.Params = glm::vec4(
+			glm::clamp(material.Metallic, 0.0f, 1.0f),
+			glm::clamp(material.Roughness, 0.05f, 1.0f),
+			glm::clamp(material.AO, 0.0f, 1.0f),
+			0.0f
+		);
+		draw.Geometry = glm::ivec4(
+			static_cast<int>(range->FirstIndex), static_cast<int>(range->BaseVertex), textureIndex, 0
+		);
+		m_Draws.push_back(draw);
+
+		// Consecutive draws of one mesh are instances of one command; the
+		// geometry pass finds the draw at gl_BaseInstance + gl_InstanceID
+		if (!m_Commands.empty() && m_Commands.back().FirstIndex == range->FirstIndex
+			&& m_Commands.back().Count == range->IndexCount)
+		{
+			m_Commands.back().InstanceCount++;
+		}
+		else
+		{
+			IndirectCommand command;
+			command.Count = range->IndexCount;
+			command.InstanceCount = 1;
+			command.FirstIndex = range->FirstIndex;
+			command.BaseVertex = static_cast<int32_t>(range->BaseVertex);
+			command.BaseInstance = static_cast<uint32_t>(m_Draws.size() - 1);
+			m_Commands.push_back(command);
+			m_Stats.Commands++;
+		}
+
+		m_Stats.Draws++;
+		m_Stats.Triangles += range->IndexCount / 3;
+		return true;
+	}
+
+	const VisibilityBuffer::MeshRange* VisibilityBuffer::CacheMesh(MeshHandle meshId, const Mesh& mesh)
+	{
+		if (!meshId) return nullptr;
+
+		unsigned int vertexBufferID = mesh.GetVertexBuffer().GetID();
+		unsigned int indexBufferID = mesh.GetIndexBuffer().GetID();
+		uint32_t vertexCount = static_cast<uint32_t>(mesh.GetVertexCount());
+		uint32_t indexCount = mesh.GetIndexCount();
+		if (vertexCount == 0 || indexCount < 3) return nullptr;
+
+		size_t vertexBytes = static_cast<size_t>(vertexCount) * sizeof(Vertex);
+		size_t indexBytes = static_cast<size_t>(indexCount) * sizeof(uint32_t);
+
+		auto it = m_Meshes.find(meshId);
+		if (it != m_Meshes.end())
+		{
+			MeshRange& range = it->second;
+			// Guards against a wrapped 12-bit generation and re-uploaded meshes
+			if (range.VertexBufferID == vertexBufferID && range.IndexBufferID == indexBufferID
+				&& range.VertexCount == vertexCount && range.IndexCount == indexCount)
+			{
+				range.LastFrame = m_Frame;
+				return &range;
+			}
+			m_StaleBytes += static_cast<size_t>(range.VertexCount) * sizeof(Vertex)
+				+ static_cast<size_t>(range.IndexCount) * sizeof(uint32_t);
+			m_Meshes.erase(it);
+		}
+
+		Reserve(m_Vertices, m_VertexBytes, m_VertexBytes + vertexBytes);
+		Reserve(m_Indices, m_IndexBytes, m_IndexBytes + indexBytes);
+
+		// GPU-side copies; the mesh's own buffers stay untouched
+		glCopyNamedBufferSubData(vertexBufferID, m_Vertices->GetID(), 0,
+			static_cast<GLintptr>(m_VertexBytes), static_cast<GLsizeiptr>(vertexBytes));
+		glCopyNamedBufferSubData(indexBufferID, m_Indices->GetID(), 0,
+			static_cast<GLintptr>(m_IndexBytes), static_cast<GLsizeiptr>(indexBytes));
+
+		MeshRange range;
+		range.VertexBufferID = vertexBufferID;
+		range.IndexBufferID = indexBufferID;
+		range.VertexCount = vertexCount;
+		range.IndexCount = indexCount;
+		range.BaseVertex = static_cast<uint32_t>(m_VertexBytes / sizeof(Vertex));
+		range.FirstIndex = static_cast<uint32_t>(m_IndexBytes / sizeof(uint32_t));
+		range.LastFrame = m_Frame;
+
+		m_VertexBytes += vertexBytes;
+		m_IndexBytes += indexBytes;
+		m_Stats.CachedMeshes = static_cast<uint32_t>(m_Meshes.size() + 1);
+		m_Stats.GeometryBytes = m_VertexBytes + m_IndexBytes;
+
+		return &(m_Meshes[meshId] = range);
+	}
+
+	void VisibilityBuffer::EvictStaleMeshes()
+	{
+		// Dropped ranges keep their space until Compact(); only the key goes now
+		for (auto it = m_Meshes.begin(); it != m_Meshes.end();)
+		{
+			const MeshRange& range = it->second;
+			if (m_Frame - range.LastFrame >= EvictAfterFrames)
+			{
+				m_StaleBytes += static_cast<size_t>(range.VertexCount) * sizeof(Vertex)
+					+ static_cast<size_t>(range.IndexCount) * sizeof(uint32_t);
+				it = m_Meshes.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		m_Stats.CachedMeshes = static_cast<uint32_t>(m_Meshes.size());
+	}
+
+	void VisibilityBuffer::Compact()
+	{
+		size_t liveVertexBytes = 0;
+		size_t liveIndexBytes = 0;
+		for (const auto& [id, range] : m_Meshes)
+		{
+			liveVertexBytes += static_cast<size_t>(range.VertexCount) * sizeof(Vertex);
+			liveIndexBytes += static_cast<size_t>(range.IndexCount) * sizeof(uint32_t);
+		}
+
+		auto vertices = std::make_unique<ShaderStorageBuffer>(nullptr, std::max(liveVertexBytes, MinGeometryBytes), GL_STATIC_DRAW);
+		auto indices = std::make_unique<ShaderStorageBuffer>(nullptr, std::max(liveIndexBytes, MinGeometryBytes), GL_STATIC_DRAW);
+
+		// Live ranges move GPU-side; indices are mesh-local, so only the offsets change
+		size_t vertexOffset = 0;
+		size_t indexOffset = 0;
+		for (auto& [id, range] : m_Meshes)
+		{
+			size_t vertexBytes = static_cast<size_t>(range.VertexCount) * sizeof(Vertex);
+			size_t indexBytes = static_cast<size_t>(range.IndexCount) * sizeof(uint32_t);
+
+			glCopyNamedBufferSubData(m_Vertices->GetID(), vertices->GetID(),
+				static_cast<GLintptr>(range.BaseVertex * sizeof(Vertex)), static_cast<GLintptr>(vertexOffset),
+				static_cast<GLsizeiptr>(vertexBytes));
+			glCopyNamedBufferSubData(m_Indices->GetID(), indices->GetID(),
+				static_cast<GLintptr>(range.FirstIndex * sizeof(uint32_t)), static_cast<GLintptr>(indexOffset),
+				static_cast<GLsizeiptr>(indexBytes));
+
+			range.BaseVertex = static_cast<uint32_t>(vertexOffset / sizeof(Vertex));
+			range.FirstIndex = static_cast<uint32_t>(indexOffset / sizeof(uint32_t));
+			vertexOffset += vertexBytes;
+			indexOffset += indexBytes;
+		}
+
+		m_Vertices = std::move(vertices);
+		m_Indices = std::move(indices);
+		m_VertexBytes = vertexOffset;
+		m_IndexBytes = indexOffset;
+		m_StaleBytes = 0;
+		m_Stats.GeometryBytes = m_VertexBytes + m_IndexBytes;
+	}
+
+	void VisibilityBuffer::Reserve(std::unique_ptr<ShaderStorageBuffer>& buffer, size_t usedBytes, size_t requiredBytes)
+	{
+		if (requiredBytes <= buffer->GetSize()) return;
+
+		size_t capacity = std::max(buffer->GetSize() * 2, requiredBytes);
+		auto grown = std::make_unique<ShaderStorageBuffer>(nullptr, capacity, GL_STATIC_DRAW);
+		if (usedBytes > 0)
+		{
+			glCopyNamedBufferSubData(buffer->GetID(), grown->GetID(), 0, 0, static_cast<GLsizeiptr>(usedBytes));
+		}
+		buffer = std::move(grown);
+	}
+
+	void VisibilityBuffer::ClearGeometry()
+	{
+		m_Meshes.clear();
+		m_VertexBytes = 0;
+		m_IndexBytes = 0;
+		m_StaleBytes = 0;
+		m_Stats.CachedMeshes = 0;
+		m_Stats.GeometryBytes = 0;
+	}
+
+	void VisibilityBuffer::RenderGeometry(const glm::mat4& viewProjection)
+	{
+		if (!m_IsValid) return;
+
+		int savedViewport[4];
+		glGetIntegerv(GL_VIEWPORT, savedViewport);
+
+		m_Framebuffer->Bind();
+		glViewport(0, 0, m_Width, m_Height);
+
+		// All ones = no triangle
+		GLuint empty[4] = { 0xFFFFFFFFu, 0, 0, 0 };
+		glClearBufferuiv(GL_COLOR, 0, empty);
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+		glDepthFunc(GL_LESS);
+		glClear(GL_DEPTH_BUFFER_BIT);
+
+		if (!m_Commands.empty())
+		{
+			m_DrawTable->SetData(m_Draws.data(), m_Draws.size() * sizeof(VisibilityDrawGPU));
+			m_CommandBuffer->SetData(m_Commands.data(), m_Commands.size() * sizeof(IndirectCommand));
+
+			m_GeometryShader->Bind();
+			m_GeometryShader->SetMatrix4fv("u_ViewProjection", viewProjection);
+
+			m_DrawTable->BindBase(DrawTableBinding);
+			m_Vertices->BindBase(VertexBinding);
+
+			// Indices feed the vertex puller through gl_VertexID (base vertex included)
+			m_VAO->Bind();
+			glVertexArrayElementBuffer(m_VAO->GetID(), m_Indices->GetID());
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer->GetID());
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+				static_cast<GLsizei>(m_Commands.size()), 0);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		}
+
+		m_Framebuffer->Unbind();
+		glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+	}
+
+	void VisibilityBuffer::Resolve(Shader& resolveShader)
+	{
+		if (!m_IsValid) return;
+
+		m_IdTexture->Bind(TextureSlots::Custom0);
+		m_DepthTexture->Bind(TextureSlots::Custom1);
+		resolveShader.SetInt("u_VisibilityIDs", TextureSlots::Custom0);
+		resolveShader.SetInt("u_VisibilityDepth", TextureSlots::Custom1);
+		resolveShader.SetVec2("u_VisibilitySize", glm::vec2(static_cast<float>(m_Width), static_cast<float>(m_Height)));
+
+		for (int i = 0; i < MaxAlbedoTextures; i++)
+		{
+			if (i < static_cast<int>(m_AlbedoTextures.size()))
+			{
+				m_AlbedoTextures[i]->Bind(AlbedoSlots[i]);
+			}
+			resolveShader.SetInt("u_VisibilityAlbedo[" + std::to_string(i) + "]", AlbedoSlots[i]);
+		}
+
+		m_DrawTable->BindBase(DrawTableBinding);
+		m_Vertices->BindBase(VertexBinding);
+		m_Indices->BindBase(IndexBinding);
+
+		// Every covered pixel writes its depth, whatever the target held before
+		GLint depthFunc;
+		glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+		glDepthFunc(GL_ALWAYS);
+
+		m_VAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		glDepthFunc(static_cast<GLenum>(depthFunc));
+	}
+}
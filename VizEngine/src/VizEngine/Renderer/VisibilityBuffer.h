@@ -0,0 +1,223 @@
+// VizEngine/src/VizEngine/Renderer/VisibilityBuffer.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Handle.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace VizEngine
+{
+	class Framebuffer;
+	class Mesh;
+	class Shader;
+	class ShaderStorageBuffer;
+	class Texture;
+	class VertexArray;
+
+	/**
+	 * Surface parameters of one visibility-buffer draw; the subset of
+	 * PBRMaterial that the resolve evaluates per pixel.
+	 */
+	struct VisibilityMaterial
+	{
+		glm::vec4 BaseColor = glm::vec4(1.0f);    // rgb = albedo, a = alpha
+		float Metallic = 0.0f;
+		float Roughness = 0.5f;
+		float AO = 1.0f;
+		const Texture* AlbedoTexture = nullptr;   // Borrowed; must outlive Resolve()
+	};
+
+	/**
+	 * One draw as seen by shaders (std430, 160 bytes).
+	 * Mirrored by the VisibilityDraw struct in visibility_pass.shader and
+	 * defaultlit.shader (VISIBILITY_RESOLVE).
+	 */
+	struct VisibilityDrawGPU
+	{
+		glm::mat4 Model;
+		glm::vec4 NormalMatrix[3];    // Columns of the mat3
+		glm::vec4 BaseColor;
+		glm::vec4 Params;             // x = metallic, y = roughness, z = AO
+		glm::ivec4 Geometry;          // x = first index, y = base vertex, z = albedo texture (-1 = none)
+	};
+
+	static_assert(sizeof(VisibilityDrawGPU) == 160, "VisibilityDrawGPU must match the std430 layout");
+
+	struct VisibilityBufferStats
+	{
+		uint32_t Draws = 0;            // Submitted this frame
+		uint32_t Commands = 0;         // Indirect commands; consecutive draws of one mesh share one
+		uint32_t Rejected = 0;         // Left to the caller's forward path
+		uint64_t Triangles = 0;
+		uint32_t CachedMeshes = 0;
+		size_t GeometryBytes = 0;      // Merged vertex + index buffers
+	};
+
+	/**
+	 * Visibility-buffer rendering of opaque geometry.
+	 *
+	 * The geometry pass rasterizes every submitted draw with one
+	 * glMultiDrawElementsIndirect and writes only a 32-bit id per pixel:
+	 * (draw << TriangleBits) | triangle, plus depth. Consecutive draws of
+	 * the same mesh (e.g. a prefab batch) share one instanced command.
+	 * Vertices are pulled from merged vertex and index buffers, so the pass
+	 * binds no vertex formats or materials and its cost is independent of
+	 * shading.
+	 *
+	 * The resolve is a full-screen pass of defaultlit.shader built with
+	 * VISIBILITY_RESOLVE: each pixel fetches its triangle, rebuilds
+	 * perspective-correct barycentrics (and their screen derivatives for
+	 * texture filtering) from the three projected vertices, interpolates
+	 * position, normal, tangent frame and UVs, and runs the same lighting as
+	 * the forward path exactly once. Depth is copied to the bound target, so
+	 * later forward passes (transparents, skybox, outlines) test against it.
+	 *
+	 * Meshes are copied into the merged buffers the first time they are
+	 * submitted and stay cached, keyed by their MeshHandle. Ranges not drawn
+	 * for EvictAfterFrames frames are dropped, and the merged buffers are
+	 * compacted once dropped ranges fill most of them.
+	 *
+	 * Limits: MaxDraws draws per frame, MaxTrianglesPerMesh triangles per
+	 * mesh and MaxAlbedoTextures distinct albedo textures per frame (the
+	 * resolve selects them with constant indices, no bindless). Submit()
+	 * returns false for draws past a limit; draw those forward.
+	 *
+	 * Usage:
+	 *   vis.BeginFrame();
+	 *   for (each opaque object) if (!vis.Submit(meshId, *mesh, model, normal, material)) forward.push_back(object);
+	 *   vis.RenderGeometry(viewProjection);
+	 *   hdrFramebuffer->Bind();
+	 *   resolveMaterial->Bind();                 // lighting uniforms, IBL, shadows
+	 *   vis.Resolve(*resolveMaterial->GetShader());
+	 */
+	class VizEngine_API VisibilityBuffer
+	{
+	public:
+		static constexpr uint32_t TriangleBits = 20;
+		static constexpr uint32_t MaxTrianglesPerMesh = 1u << TriangleBits;
+		static constexpr uint32_t MaxDraws = (1u << (32 - TriangleBits)) - 1;   // All ones marks empty pixels
+		static constexpr int MaxAlbedoTextures = 4;
+
+		/** SSBO binding points (shared by both passes) */
+		static constexpr unsigned int DrawTableBinding = 2;
+		static constexpr unsigned int VertexBinding = 3;
+		static constexpr unsigned int IndexBinding = 4;
+
+		VisibilityBuffer(int width, int height);
+		~VisibilityBuffer();
+
+		VisibilityBuffer(const VisibilityBuffer&) = delete;
+		VisibilityBuffer& operator=(const VisibilityBuffer&) = delete;
+
+		bool IsValid() const { return m_IsValid; }
+
+		/**
+		 * Recreate the id and depth targets at a new size.
+		 */
+		void Resize(int width, int height);
+
+		/**
+		 * Start a frame's draw list.
+		 */
+		void BeginFrame();
+
+		/**
+		 * Add an opaque draw. Submit draws of the same mesh back to back to
+		 * have them instanced.
+		 * @param meshId Handle of mesh; keys its cached geometry (a stale
+		 *               generation never matches a reused slot)
+		 * @return false if it exceeds a limit (not drawn, use the forward path)
+		 */
+		bool Submit(MeshHandle meshId, const Mesh& mesh, const glm::mat4& model, const glm::mat3& normalMatrix,
+			const VisibilityMaterial& material);
+
+		/**
+		 * Upload the draw list and run the geometry pass into the visibility
+		 * targets. Leaves the default framebuffer bound and the viewport restored.
+		 */
+		void RenderGeometry(const glm::mat4& viewProjection);
+
+		/**
+		 * Shade every covered pixel into the bound framebuffer and write its
+		 * depth. The shader must be defaultlit.shader built with
+		 * VISIBILITY_RESOLVE, already bound with its lighting uniforms.
+		 */
+		void Resolve(Shader& resolveShader);
+
+		/**
+		 * Drop all cached mesh geometry (e.g. after a scene reload).
+		 */
+		void ClearGeometry();
+
+		/** Frames a mesh may go undrawn before its cached range is dropped */
+		static constexpr uint64_t EvictAfterFrames = 8;
+
+		const VisibilityBufferStats& GetStats() const { return m_Stats; }
+		std::shared_ptr<Texture> GetIdTexture() const { return m_IdTexture; }
+		std::shared_ptr<Texture> GetDepthTexture() const { return m_DepthTexture; }
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+
+	private:
+		struct MeshRange
+		{
+			unsigned int VertexBufferID = 0;
+			unsigned int IndexBufferID = 0;
+			uint32_t VertexCount = 0;
+			uint32_t IndexCount = 0;
+			uint32_t BaseVertex = 0;
+			uint32_t FirstIndex = 0;
+			uint64_t LastFrame = 0;
+		};
+
+		// Mirrors DrawElementsIndirectCommand
+		struct IndirectCommand
+		{
+			uint32_t Count;
+			uint32_t InstanceCount;
+			uint32_t FirstIndex;
+			int32_t BaseVertex;
+			uint32_t BaseInstance;
+		};
+
+		void CreateTargets();
+		const MeshRange* CacheMesh(MeshHandle meshId, const Mesh& mesh);
+		void EvictStaleMeshes();
+		void Compact();
+		void Reserve(std::unique_ptr<ShaderStorageBuffer>& buffer, size_t usedBytes, size_t requiredBytes);
+
+		int m_Width = 0;
+		int m_Height = 0;
+		bool m_IsValid = false;
+
+		std::shared_ptr<Texture> m_IdTexture;       // R32UI
+		std::shared_ptr<Texture> m_DepthTexture;
+		std::unique_ptr<Framebuffer> m_Framebuffer;
+
+		std::unique_ptr<Shader> m_GeometryShader;
+		std::unique_ptr<VertexArray> m_VAO;         // No attributes; element buffer = merged indices
+
+		// Merged geometry (Vertex structs and mesh-local uint32 indices)
+		std::unique_ptr<ShaderStorageBuffer> m_Vertices;
+		std::unique_ptr<ShaderStorageBuffer> m_Indices;
+		size_t m_VertexBytes = 0;
+		size_t m_IndexBytes = 0;
+		size_t m_StaleBytes = 0;           // Of dropped ranges, reclaimed by Compact()
+		std::unordered_map<MeshHandle, MeshRange> m_Meshes;
+
+		// Per-frame draw list
+		std::vector<VisibilityDrawGPU> m_Draws;
+		std::vector<IndirectCommand> m_Commands;
+		std::vector<const Texture*> m_AlbedoTextures;
+		std::unique_ptr<ShaderStorageBuffer> m_DrawTable;
+		std::unique_ptr<ShaderStorageBuffer> m_CommandBuffer;
+
+		uint64_t m_Frame = 0;
+		VisibilityBufferStats m_Stats;
+	};
+}
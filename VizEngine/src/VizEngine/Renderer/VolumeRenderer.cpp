@@ -0,0 +1,377 @@
+// VizEngine/src/VizEngine/Renderer/VolumeRenderer.cpp
+
+#include "VolumeRenderer.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/Profiler.h"
+#include "VizEngine/OpenGL/Commons.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderStorageBuffer.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/OpenGL/Texture3D.h"
+#include "VizEngine/OpenGL/VertexArray.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// Mirrors VolumeOccupied in volume_occupancy.shader
+		constexpr unsigned int OccupiedBinding = 7;
+		constexpr size_t OccupiedHeaderBytes = 16;   // Count, padding
+
+		// Scene depth needs a fourth sampler; the HDR color slot is only
+		// sampled by post-processing, after the scene pass
+		constexpr unsigned int SceneDepthSlot = TextureSlots::HDRBuffer;
+
+		glm::vec4 Rgba(float r, float g, float b, float a) { return glm::vec4(r, g, b, a); }
+	}
+
+	// ========================================================================
+	// VolumeTransferFunction
+	// ========================================================================
+
+	std::vector<glm::vec4> VolumeTransferFunction::Bake(int size) const
+	{
+		std::vector<glm::vec4> table(static_cast<size_t>(size), glm::vec4(0.0f));
+		if (Points.empty() || size <= 0) return table;
+
+		std::vector<Point> points = Points;
+		std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) { return a.Value < b.Value; });
+
+		size_t next = 0;
+		for (int i = 0; i < size; i++)
+		{
+			const float x = size > 1 ? static_cast<float>(i) / static_cast<float>(size - 1) : 0.0f;
+			while (next < points.size() && points[next].Value <= x) next++;
+
+			if (next == 0) table[i] = points.front().Color;
+			else if (next == points.size()) table[i] = points.back().Color;
+			else
+			{
+				const Point& a = points[next - 1];
+				const Point& b = points[next];
+				const float t = (x - a.Value) / std::max(b.Value - a.Value, 1e-6f);
+				table[i] = glm::mix(a.Color, b.Color, t);
+			}
+		}
+		return table;
+	}
+
+	VolumeTransferFunction VolumeTransferFunction::Grayscale()
+	{
+		VolumeTransferFunction tf;
+		tf.Points = {
+			{ 0.00f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 0.10f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 1.00f, Rgba(1.0f, 1.0f, 1.0f, 0.08f) },
+		};
+		return tf;
+	}
+
+	VolumeTransferFunction VolumeTransferFunction::SoftTissue()
+	{
+		VolumeTransferFunction tf;
+		tf.Points = {
+			{ 0.00f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 0.18f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 0.25f, Rgba(0.55f, 0.12f, 0.08f, 0.02f) },
+			{ 0.40f, Rgba(0.85f, 0.45f, 0.35f, 0.05f) },
+			{ 0.55f, Rgba(0.85f, 0.45f, 0.35f, 0.0f) },
+			{ 0.70f, Rgba(0.95f, 0.92f, 0.85f, 0.4f) },
+			{ 1.00f, Rgba(1.0f, 1.0f, 0.95f, 0.9f) },
+		};
+		return tf;
+	}
+
+	VolumeTransferFunction VolumeTransferFunction::Bone()
+	{
+		VolumeTransferFunction tf;
+		tf.Points = {
+			{ 0.00f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 0.60f, Rgba(0.0f, 0.0f, 0.0f, 0.0f) },
+			{ 0.70f, Rgba(0.9f, 0.8f, 0.65f, 0.5f) },
+			{ 1.00f, Rgba(1.0f, 1.0f, 0.95f, 1.0f) },
+		};
+		return tf;
+	}
+
+	// ========================================================================
+	// VolumeRenderer
+	// ========================================================================
+
+	VolumeRenderer::VolumeRenderer()
+	{
+		m_MinMaxShader = std::make_unique<Shader>("resources/shaders/volume_minmax.shader");
+		m_OccupancyShader = std::make_unique<Shader>("resources/shaders/volume_occupancy.shader");
+		m_RayMarchShader = std::make_unique<Shader>("resources/shaders/volume_raymarch.shader");
+		if (!m_MinMaxShader->IsValid() || !m_OccupancyShader->IsValid() || !m_RayMarchShader->IsValid())
+		{
+			VP_CORE_ERROR("VolumeRenderer: Failed to load shaders!");
+			return;
+		}
+
+		m_EmptyVAO = std::make_unique<VertexArray>();
+
+		m_TransferTexture = std::make_shared<Texture>(
+			TransferFunctionSize, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT
+		);
+		m_TransferTexture->SetFilter(GL_LINEAR, GL_LINEAR);
+		m_TransferTexture->SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+
+		std::vector<uint8_t> zeros(OccupiedHeaderBytes + (TransferFunctionSize + 1) * sizeof(uint32_t), 0);
+		m_Occupied = std::make_unique<ShaderStorageBuffer>(zeros.data(), zeros.size(), GL_DYNAMIC_COPY);
+
+		SetTransferFunction(VolumeTransferFunction::Grayscale());
+		m_IsValid = true;
+	}
+
+	VolumeRenderer::~VolumeRenderer()
+	{
+		if (m_CountFence)
+		{
+			glDeleteSync(m_CountFence);
+		}
+	}
+
+	std::shared_ptr<Texture3D> VolumeRenderer::LoadRaw(const std::string& path,
+		int width, int height, int depth, VolumeFormat format)
+	{
+		if (width <= 0 || height <= 0 || depth <= 0)
+		{
+			VP_CORE_ERROR("VolumeRenderer: Invalid volume size {}x{}x{}", width, height, depth);
+			return nullptr;
+		}
+
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			VP_CORE_ERROR("VolumeRenderer: Failed to open {}", path);
+			return nullptr;
+		}
+
+		unsigned int internalFormat = GL_R8;
+		unsigned int dataType = GL_UNSIGNED_BYTE;
+		size_t voxelBytes = 1;
+		switch (format)
+		{
+		case VolumeFormat::UInt8:   break;
+		case VolumeFormat::UInt16:  internalFormat = GL_R16;  dataType = GL_UNSIGNED_SHORT; voxelBytes = 2; break;
+		case VolumeFormat::Float32: internalFormat = GL_R32F; dataType = GL_FLOAT;          voxelBytes = 4; break;
+		}
+
+		const size_t required = static_cast<size_t>(width) * height * depth * voxelBytes;
+		if (file.GetSize() < required)
+		{
+			VP_CORE_ERROR("VolumeRenderer: {} has {} bytes, {}x{}x{} needs {}", path, file.GetSize(),
+				width, height, depth, required);
+			return nullptr;
+		}
+
+		auto volume = std::make_shared<Texture3D>(width, height, depth, internalFormat, GL_RED, dataType, file.GetData());
+		VP_CORE_INFO("VolumeRenderer: Loaded {} ({}x{}x{})", path, width, height, depth);
+		return volume;
+	}
+
+	bool VolumeRenderer::SetVolume(std::shared_ptr<Texture3D> volume)
+	{
+		if (!m_IsValid) return false;
+
+		m_Volume.reset();
+		m_MinMax.reset();
+		m_Occupancy.reset();
+		m_Stats = VolumeRenderStats();
+		if (!volume) return false;
+
+		const unsigned int format = volume->GetInternalFormat();
+		if (format != GL_R8 && format != GL_R16 && format != GL_R16F && format != GL_R32F)
+		{
+			VP_CORE_ERROR("VolumeRenderer: Volume must be single-channel (GL_R8, GL_R16, GL_R16F or GL_R32F)");
+			return false;
+		}
+
+		m_Volume = std::move(volume);
+		m_BrickCount = glm::ivec3(
+			(m_Volume->GetWidth() + BrickSize - 1) / BrickSize,
+			(m_Volume->GetHeight() + BrickSize - 1) / BrickSize,
+			(m_Volume->GetDepth() + BrickSize - 1) / BrickSize
+		);
+		m_Stats.TotalBricks = static_cast<uint32_t>(m_BrickCount.x * m_BrickCount.y * m_BrickCount.z);
+
+		// Fetched per brick, never filtered
+		m_MinMax = std::make_unique<Texture3D>(m_BrickCount.x, m_BrickCount.y, m_BrickCount.z,
+			GL_RG32F, GL_RG, GL_FLOAT);
+		m_MinMax->SetFilter(GL_NEAREST, GL_NEAREST);
+		m_Occupancy = std::make_unique<Texture3D>(m_BrickCount.x, m_BrickCount.y, m_BrickCount.z,
+			GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+		m_Occupancy->SetFilter(GL_NEAREST, GL_NEAREST);
+
+		// Value range once per volume; one invocation per brick
+		m_MinMaxShader->Bind();
+		m_Volume->Bind(TextureSlots::Custom0);
+		m_MinMaxShader->SetInt("u_Volume", TextureSlots::Custom0);
+		m_MinMaxShader->SetInt("u_BrickSize", BrickSize);
+		glBindImageTexture(0, m_MinMax->GetID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RG32F);
+
+		glDispatchCompute(
+			static_cast<unsigned int>((m_BrickCount.x + 3) / 4),
+			static_cast<unsigned int>((m_BrickCount.y + 3) / 4),
+			static_cast<unsigned int>((m_BrickCount.z + 3) / 4));
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		glBindImageTexture(0, 0, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RG32F);
+		m_MinMaxShader->Unbind();
+
+		m_OccupancyDirty = true;
+		VP_CORE_INFO("VolumeRenderer: {}x{}x{} voxels, {}x{}x{} bricks", m_Volume->GetWidth(), m_Volume->GetHeight(),
+			m_Volume->GetDepth(), m_BrickCount.x, m_BrickCount.y, m_BrickCount.z);
+		return true;
+	}
+
+	void VolumeRenderer::SetTransferFunction(const VolumeTransferFunction& transferFunction)
+	{
+		if (!m_TransferTexture) return;
+
+		std::vector<glm::vec4> table = transferFunction.Bake(TransferFunctionSize);
+		glTextureSubImage2D(m_TransferTexture->GetID(), 0, 0, 0, TransferFunctionSize, 1,
+			GL_RGBA, GL_FLOAT, table.data());
+
+		// Prefix counts answer "any opacity in entries [lo, hi]" in O(1) per brick
+		m_OpaquePrefix.assign(TransferFunctionSize + 1, 0);
+		for (int i = 0; i < TransferFunctionSize; i++)
+		{
+			m_OpaquePrefix[i + 1] = m_OpaquePrefix[i] + (table[i].a > 0.0f ? 1u : 0u);
+		}
+		m_Occupied->SetData(m_OpaquePrefix.data(), m_OpaquePrefix.size() * sizeof(uint32_t), OccupiedHeaderBytes);
+
+		m_OccupancyDirty = true;
+	}
+
+	void VolumeRenderer::UpdateOccupancy()
+	{
+		const uint32_t zero = 0;
+		m_Occupied->SetData(&zero, sizeof(zero), 0);
+
+		m_OccupancyShader->Bind();
+		m_MinMax->Bind(TextureSlots::Custom0);
+		m_OccupancyShader->SetInt("u_MinMax", TextureSlots::Custom0);
+		m_OccupancyShader->SetVec2("u_Window", m_Settings.Window);
+		m_OccupancyShader->SetInt("u_TableSize", TransferFunctionSize);
+		m_Occupied->BindBase(OccupiedBinding);
+		glBindImageTexture(0, m_Occupancy->GetID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R8);
+
+		glDispatchCompute(
+			static_cast<unsigned int>((m_BrickCount.x + 3) / 4),
+			static_cast<unsigned int>((m_BrickCount.y + 3) / 4),
+			static_cast<unsigned int>((m_BrickCount.z + 3) / 4));
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+		glBindImageTexture(0, 0, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R8);
+		m_OccupancyShader->Unbind();
+
+		// The count is read once it arrives; a newer rebuild replaces the old fence
+		if (m_CountFence)
+		{
+			glDeleteSync(m_CountFence);
+		}
+		m_CountFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_OccupancyWindow = m_Settings.Window;
+		m_OccupancyDirty = false;
+	}
+
+	void VolumeRenderer::ReadOccupiedCount()
+	{
+		if (!m_CountFence) return;
+
+		// Never stall: read next frame if the rebuild is still in flight
+		GLenum status = glClientWaitSync(m_CountFence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED) return;
+
+		glDeleteSync(m_CountFence);
+		m_CountFence = nullptr;
+		if (status == GL_WAIT_FAILED) return;
+
+		glGetNamedBufferSubData(m_Occupied->GetID(), 0, sizeof(uint32_t), &m_Stats.OccupiedBricks);
+	}
+
+	void VolumeRenderer::Render(const Texture& sceneDepth, const glm::mat4& view, const glm::mat4& projection,
+		const glm::vec3& lightDirection)
+	{
+		if (!m_IsValid || !m_Volume) return;
+
+		ReadOccupiedCount();
+		if (m_OccupancyDirty || m_Settings.Window != m_OccupancyWindow)
+		{
+			UpdateOccupancy();
+		}
+
+		const glm::mat4 invViewProjection = glm::inverse(projection * view);
+		const glm::mat4 invModel = glm::inverse(m_Model);
+		const glm::vec3 volumeSize(m_Volume->GetWidth(), m_Volume->GetHeight(), m_Volume->GetDepth());
+
+		// Light into local space; normals come from local gradients
+		const glm::vec3 localLight = glm::normalize(glm::mat3(invModel) * lightDirection);
+
+		// Reads the scene depth, which may be attached to the bound
+		// framebuffer: no depth test or writes, so there is no feedback loop
+		glDisable(GL_DEPTH_TEST);
+		glDepthMask(GL_FALSE);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);   // Premultiplied color over the scene
+
+		m_RayMarchShader->Bind();
+		m_Volume->Bind(TextureSlots::Custom0);
+		m_Occupancy->Bind(TextureSlots::Custom1);
+		m_TransferTexture->Bind(TextureSlots::Custom2);
+		sceneDepth.Bind(SceneDepthSlot);
+		m_RayMarchShader->SetInt("u_Volume", TextureSlots::Custom0);
+		m_RayMarchShader->SetInt("u_Occupancy", TextureSlots::Custom1);
+		m_RayMarchShader->SetInt("u_TransferFunction", TextureSlots::Custom2);
+		m_RayMarchShader->SetInt("u_SceneDepth", static_cast<int>(SceneDepthSlot));
+
+		m_RayMarchShader->SetMatrix4fv("u_InvViewProjection", invViewProjection);
+		m_RayMarchShader->SetMatrix4fv("u_InvModel", invModel);
+		m_RayMarchShader->SetVec3("u_VolumeSize", volumeSize);
+		m_RayMarchShader->SetVec3("u_BrickCount", glm::vec3(m_BrickCount));
+		m_RayMarchShader->SetInt("u_BrickSize", BrickSize);
+		m_RayMarchShader->SetInt("u_TableSize", TransferFunctionSize);
+
+		m_RayMarchShader->SetVec2("u_Window", m_Settings.Window);
+		m_RayMarchShader->SetFloat("u_Density", m_Settings.Density);
+		m_RayMarchShader->SetFloat("u_Brightness", m_Settings.Brightness);
+		m_RayMarchShader->SetFloat("u_StepSize", std::max(m_Settings.StepSize, 0.05f));
+		m_RayMarchShader->SetBool("u_AdaptiveStep", m_Settings.AdaptiveStep);
+		m_RayMarchShader->SetFloat("u_DistanceStepScale", m_Settings.DistanceStepScale);
+		m_RayMarchShader->SetFloat("u_TransparentStepScale", std::max(m_Settings.TransparentStepScale, 1.0f));
+		m_RayMarchShader->SetBool("u_Jitter", m_Settings.Jitter);
+		m_RayMarchShader->SetBool("u_SkipEmptySpace", m_Settings.SkipEmptySpace);
+		m_RayMarchShader->SetFloat("u_TerminationAlpha", m_Settings.TerminationAlpha);
+		m_RayMarchShader->SetInt("u_MaxSteps", std::max(m_Settings.MaxSteps, 1));
+
+		m_RayMarchShader->SetBool("u_Shading", m_Settings.Shading);
+		m_RayMarchShader->SetFloat("u_Ambient", m_Settings.Ambient);
+		m_RayMarchShader->SetVec3("u_LightDirection", localLight);
+		m_RayMarchShader->SetInt("u_DebugView", static_cast<int>(m_Settings.Debug));
+
+		m_EmptyVAO->Bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_BLEND);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_DEPTH_TEST);
+
+		const FrameTimings& resolved = Profiler::GetLastFrame();
+		if (resolved.Valid)
+		{
+			const PassTiming* pass = resolved.Find(PassName);
+			if (pass)
+			{
+				m_Stats.GpuMs = pass->GpuMs;
+			}
+		}
+	}
+}
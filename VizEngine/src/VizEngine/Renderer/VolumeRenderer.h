@@ -0,0 +1,195 @@
+// VizEngine/src/VizEngine/Renderer/VolumeRenderer.h
+
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef struct __GLsync* GLsync;
+
+namespace VizEngine
+{
+	class Shader;
+	class ShaderStorageBuffer;
+	class Texture;
+	class Texture3D;
+	class VertexArray;
+
+	/**
+	 * Voxel type of a raw volume file.
+	 */
+	enum class VolumeFormat : uint8_t
+	{
+		UInt8,      // GL_R8, normalized to [0, 1]
+		UInt16,     // GL_R16, normalized to [0, 1]
+		Float32     // GL_R32F, values as stored
+	};
+
+	/**
+	 * Maps normalized scalar values to color and opacity. Control points are
+	 * linearly interpolated; values outside the first and last point take
+	 * their color. Color is linear RGB, alpha is the opacity of one voxel
+	 * of thickness.
+	 */
+	struct VizEngine_API VolumeTransferFunction
+	{
+		struct Point
+		{
+			float Value = 0.0f;      // [0, 1] within the renderer's value window
+			glm::vec4 Color = glm::vec4(0.0f);
+		};
+
+		std::vector<Point> Points;
+
+		/** Sample into a lookup table of the given size. */
+		std::vector<glm::vec4> Bake(int size) const;
+
+		// Presets for CT-like data (air low, bone high)
+		static VolumeTransferFunction Grayscale();
+		static VolumeTransferFunction SoftTissue();
+		static VolumeTransferFunction Bone();
+	};
+
+	/**
+	 * What the ray-marcher writes.
+	 */
+	enum class VolumeDebugView : uint8_t
+	{
+		None,
+		StepCount       // Samples taken per pixel, blue (none) to red (MaxSteps)
+	};
+
+	struct VolumeRenderSettings
+	{
+		glm::vec2 Window = glm::vec2(0.0f, 1.0f);  // Value range mapped onto the transfer function
+		float Density = 1.0f;                      // Opacity multiplier
+		float Brightness = 1.0f;                   // HDR multiplier of the transfer function color
+
+		float StepSize = 0.5f;                     // Voxels per step
+		bool AdaptiveStep = true;                  // Longer steps far away and in transparent regions
+		float DistanceStepScale = 0.25f;           // Extra step per world unit from the camera
+		float TransparentStepScale = 2.0f;         // Step multiplier after a fully transparent sample
+		bool Jitter = true;                        // Per-pixel start offset, trades wood-grain banding for noise
+		bool SkipEmptySpace = true;
+		float TerminationAlpha = 0.99f;            // Stop once opacity reaches this (1 = never)
+		int MaxSteps = 2048;
+
+		bool Shading = true;                       // Gradient-based diffuse lighting
+		float Ambient = 0.35f;
+		VolumeDebugView Debug = VolumeDebugView::None;
+	};
+
+	struct VolumeRenderStats
+	{
+		uint32_t TotalBricks = 0;
+		uint32_t OccupiedBricks = 0;               // Under the current transfer function and window
+		double GpuMs = 0.0;                        // PassName GPU time of the last resolved frame
+	};
+
+	/**
+	 * Ray-marches a scalar Texture3D through a transfer function.
+	 *
+	 * SetVolume() reduces the volume to a grid of BrickSize^3 bricks holding
+	 * the value range of each brick (including the neighbouring voxels that
+	 * trilinear filtering reaches). Whenever the transfer function or value
+	 * window changes, a second pass marks the bricks whose range maps to any
+	 * non-zero opacity. Rays jump over unmarked bricks to the brick's exit
+	 * instead of sampling them.
+	 *
+	 * Render() draws a full-screen triangle into the bound (HDR) framebuffer.
+	 * Each pixel's ray is clipped to the volume box and to the scene depth,
+	 * so meshes inside or in front of the volume occlude it correctly, and
+	 * the last segment ends exactly at the surface. Opacity is corrected for
+	 * the step length, which grows with distance and after transparent
+	 * samples, and the march ends at TerminationAlpha. The result is
+	 * premultiplied and blended over the scene.
+	 *
+	 * Call Render() after opaque geometry (and the skybox). The depth texture
+	 * may be attached to the bound framebuffer: depth test and writes are
+	 * off during the draw.
+	 *
+	 * Usage:
+	 *   volume.SetVolume(VolumeRenderer::LoadRaw("head.raw", 256, 256, 113, VolumeFormat::UInt16));
+	 *   volume.SetTransferFunction(VolumeTransferFunction::Bone());
+	 *   volume.SetTransform(model);    // Unit cube [0, 1]^3 to world
+	 *   { VP_PROFILE_PASS(VolumeRenderer::PassName); volume.Render(*hdrDepth, view, projection, lightDir); }
+	 */
+	class VizEngine_API VolumeRenderer
+	{
+	public:
+		static constexpr const char* PassName = "Volume";
+		static constexpr int BrickSize = 8;
+		static constexpr int TransferFunctionSize = 256;
+
+		VolumeRenderer();
+		~VolumeRenderer();
+
+		VolumeRenderer(const VolumeRenderer&) = delete;
+		VolumeRenderer& operator=(const VolumeRenderer&) = delete;
+
+		bool IsValid() const { return m_IsValid; }
+
+		/**
+		 * Load a headerless volume of tightly packed, x-fastest voxels.
+		 * @return nullptr if the file is missing or too small (logged)
+		 */
+		static std::shared_ptr<Texture3D> LoadRaw(const std::string& path,
+			int width, int height, int depth, VolumeFormat format);
+
+		/**
+		 * Use a single-channel volume and build its brick value ranges.
+		 * @return false if the renderer or texture is unusable (logged)
+		 */
+		bool SetVolume(std::shared_ptr<Texture3D> volume);
+		const std::shared_ptr<Texture3D>& GetVolume() const { return m_Volume; }
+
+		void SetTransferFunction(const VolumeTransferFunction& transferFunction);
+
+		/** Local-to-world transform of the unit cube [0, 1]^3. */
+		void SetTransform(const glm::mat4& model) { m_Model = model; }
+		const glm::mat4& GetTransform() const { return m_Model; }
+
+		/**
+		 * March the volume into the bound framebuffer.
+		 * @param sceneDepth Depth of the opaque scene, same size as the target
+		 * @param lightDirection World direction the light travels
+		 */
+		void Render(const Texture& sceneDepth, const glm::mat4& view, const glm::mat4& projection,
+			const glm::vec3& lightDirection);
+
+		VolumeRenderSettings& GetSettings() { return m_Settings; }
+		const VolumeRenderStats& GetStats() const { return m_Stats; }
+
+	private:
+		void UpdateOccupancy();
+		void ReadOccupiedCount();
+
+		bool m_IsValid = false;
+		VolumeRenderSettings m_Settings;
+		VolumeRenderStats m_Stats;
+		glm::mat4 m_Model = glm::mat4(1.0f);
+
+		std::unique_ptr<Shader> m_MinMaxShader;
+		std::unique_ptr<Shader> m_OccupancyShader;
+		std::unique_ptr<Shader> m_RayMarchShader;
+		std::unique_ptr<VertexArray> m_EmptyVAO;
+
+		std::shared_ptr<Texture3D> m_Volume;
+		std::unique_ptr<Texture3D> m_MinMax;       // GL_RG32F value range per brick
+		std::unique_ptr<Texture3D> m_Occupancy;    // GL_R8, 1 where the brick is visible
+		glm::ivec3 m_BrickCount = glm::ivec3(0);
+
+		std::shared_ptr<Texture> m_TransferTexture;
+		std::vector<uint32_t> m_OpaquePrefix;      // Entries with opacity in [0, i), one extra at the end
+		std::unique_ptr<ShaderStorageBuffer> m_Occupied;   // Prefix table, then the occupied-brick count
+
+		// Inputs of the current occupancy grid
+		bool m_OccupancyDirty = true;
+		glm::vec2 m_OccupancyWindow = glm::vec2(0.0f);
+		GLsync m_CountFence = nullptr;
+	};
+}
@@ -1,6 +1,15 @@
 #shader vertex
 #version 460 core
 
+#ifdef VISIBILITY_RESOLVE
+// Visibility buffer resolve (VisibilityBuffer): attribute-less full-screen
+// triangle; the fragment stage rebuilds the surface from the triangle ids.
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+#else
 // Match existing Mesh vertex layout (see Mesh.cpp SetupMesh)
 layout(location = 0) in vec4 aPos;       // Position (vec4)
 layout(location = 1) in vec3 aNormal;    // Normal (vec3)
@@ -21,14 +30,38 @@ uniform mat4 u_View;
 uniform mat4 u_Projection;
 uniform mat4 u_LightSpaceMatrix;  // Light's projection * view
 
+// Instanced draws (PBRMaterial::SetInstanced): matrices per instance instead
+// of u_Model/u_NormalMatrix. Mirrors InstanceTransformGPU (std430, 112 bytes)
+struct InstanceTransform
+{
+    mat4 Model;
+    vec4 NormalMatrix[3];
+};
+
+layout(std430, binding = 8) readonly buffer InstanceTransforms
+{
+    InstanceTransform u_Instances[];
+};
+
+uniform bool u_Instanced;
+
 void main()
 {
+    mat4 model = u_Model;
+    mat3 normalMatrix = u_NormalMatrix;
+    if (u_Instanced)
+    {
+        InstanceTransform instance = u_Instances[gl_BaseInstance + gl_InstanceID];
+        model = instance.Model;
+        normalMatrix = mat3(instance.NormalMatrix[0].xyz, instance.NormalMatrix[1].xyz, instance.NormalMatrix[2].xyz);
+    }
+
     // Transform position to world space
-    vec4 worldPos = u_Model * aPos;
+    vec4 worldPos = model * aPos;
     v_WorldPos = worldPos.xyz;
 
     // Transform normal to world space (use normal matrix for non-uniform scaling)
-    v_Normal = u_NormalMatrix * aNormal;
+    v_Normal = normalMatrix * aNormal;
 
     // Pass through texture coordinates
     v_TexCoords = aTexCoords;
@@ -37,13 +70,14 @@ void main()
     v_FragPosLightSpace = u_LightSpaceMatrix * worldPos;
 
     // Build TBN matrix for normal mapping (Chapter 34)
-    vec3 T = normalize(u_NormalMatrix * aTangent);
-    vec3 B = normalize(u_NormalMatrix * aBitangent);
-    vec3 N = normalize(u_NormalMatrix * aNormal);
+    vec3 T = normalize(normalMatrix * aTangent);
+    vec3 B = normalize(normalMatrix * aBitangent);
+    vec3 N = normalize(normalMatrix * aNormal);
     v_TBN = mat3(T, B, N);
 
     gl_Position = u_Projection * u_View * vec4(v_WorldPos, 1.0);
 }
+#endif
 
 
 #shader fragment
@@ -51,6 +85,21 @@ void main()
 
 out vec4 FragColor;
 
+#ifdef VISIBILITY_RESOLVE
+// Set per pixel by ResolveVisibility() from the visible triangle and its draw
+vec3 v_WorldPos;
+vec3 v_Normal;
+vec2 v_TexCoords;
+vec4 v_FragPosLightSpace;
+mat3 v_TBN;
+
+vec3 u_Albedo;
+float u_Metallic;
+float u_Roughness;
+float u_AO;
+float u_Alpha;
+bool u_UseAlbedoTexture;
+#else
 in vec3 v_WorldPos;
 in vec3 v_Normal;
 in vec2 v_TexCoords;
@@ -69,11 +118,20 @@ uniform float u_Alpha;           // Opacity (Chapter 33: Blending)
 // Albedo/Base color texture
 uniform sampler2D u_AlbedoTexture;
 uniform bool u_UseAlbedoTexture;
+#endif
 
 // Normal map (Chapter 34: Normal Mapping)
 uniform sampler2D u_NormalTexture;
 uniform bool u_UseNormalMap;
 
+// glTF metallic-roughness map: G = roughness, B = metallic (scales the factors).
+// When u_UseORMTexture is set, R holds occlusion too and u_AOTexture is unused.
+uniform sampler2D u_MetallicRoughnessTexture;
+uniform bool u_UseMetallicRoughnessTexture;
+uniform bool u_UseORMTexture;
+uniform sampler2D u_AOTexture;   // Separate occlusion map (R)
+uniform bool u_UseAOTexture;
+
 // ============================================================================
 // Camera
 // ============================================================================
@@ -96,7 +154,29 @@ uniform bool u_UseDirLight;         // Enable directional light
 // ============================================================================
 // Shadow Mapping
 // ============================================================================
-uniform sampler2D u_ShadowMap;
+uniform sampler2D u_ShadowMap;                // Raw depth (PCF 3x3, PCSS blocker search)
+uniform sampler2DShadow u_ShadowMapCompare;   // Same texture, hardware depth comparison
+
+// Filter mode: 0 = PCF 3x3, 1 = Hardware, 2 = Vogel disk, 3 = PCSS
+uniform int u_ShadowFilterMode;
+uniform int u_ShadowTaps;              // Hardware: 1 or 4 fetches; Disk/PCSS: filter taps
+uniform float u_ShadowFilterRadius;    // Disk radius in texels
+uniform float u_ShadowLightSize;       // PCSS: penumbra growth per unit of depth (shadow-map UV)
+uniform int u_ShadowBlockerTaps;       // PCSS: blocker search taps
+uniform float u_ShadowMaxPenumbra;     // PCSS: search and filter radius limit in texels
+
+// Virtual shadow map: the shadow map slots hold the page atlas instead
+uniform bool u_UseVirtualShadows;
+
+// Mirrors PageTableHeader in VirtualShadowMap.cpp
+layout(std430, binding = 5) readonly buffer VirtualShadowPageTable
+{
+    mat4 u_VSMLightView;
+    vec4 u_VSMParams;          // x = level-0 page size (world), y = pixel scale, z = depth range, w = LOD bias
+    ivec4 u_VSMLayout;         // x = levels, y = pages per axis, z = page texels, w = physical pages per axis
+    ivec4 u_VSMOrigins[16];    // xy = first world page of each level's window
+    uint u_VSMPages[];         // Physical page + 1, 0 = not resident
+};
 
 // ============================================================================
 // Image-Based Lighting (Chapter 38)
@@ -117,11 +197,278 @@ uniform float u_LowerHemisphereIntensity;  // Blend intensity (0 = off, 1 = full
 // ============================================================================
 const float PI = 3.14159265359;
 
+#ifdef VISIBILITY_RESOLVE
 // ============================================================================
-// Shadow Calculation (PCF)
+// Visibility Buffer Resolve
+// Rebuilds the inputs above from the triangle under the pixel, so the shading
+// below runs once per pixel exactly as in the forward path.
 // ============================================================================
 
-// Calculate shadow with PCF (Percentage Closer Filtering)
+// Matches VisibilityBuffer::TriangleBits; all ones = no triangle
+const uint VIS_TRIANGLE_BITS = 20u;
+const uint VIS_TRIANGLE_MASK = (1u << VIS_TRIANGLE_BITS) - 1u;
+const uint VIS_EMPTY = 0xFFFFFFFFu;
+const uint VERTEX_FLOATS = 19u;   // Interleaved Vertex struct (Mesh.h)
+
+// Mirrors VisibilityDrawGPU (std430, 160 bytes)
+struct VisibilityDraw
+{
+    mat4 Model;
+    vec4 NormalMatrix[3];   // Columns of the mat3
+    vec4 BaseColor;         // rgb = albedo, a = alpha
+    vec4 Params;            // x = metallic, y = roughness, z = AO
+    ivec4 Geometry;         // x = first index, y = base vertex, z = albedo texture (-1 = none)
+};
+
+layout(std430, binding = 2) readonly buffer VisibilityDraws
+{
+    VisibilityDraw u_Draws[];
+};
+
+layout(std430, binding = 3) readonly buffer VisibilityVertices
+{
+    float u_Vertices[];
+};
+
+layout(std430, binding = 4) readonly buffer VisibilityIndices
+{
+    uint u_Indices[];
+};
+
+uniform usampler2D u_VisibilityIDs;
+uniform sampler2D u_VisibilityDepth;
+uniform vec2 u_VisibilitySize;
+
+// Selected with constant indices: neighbouring pixels may use different ones
+uniform sampler2D u_VisibilityAlbedo[4];
+
+// Camera and light matrices (vertex-stage uniforms in the forward path)
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+uniform mat4 u_LightSpaceMatrix;
+
+int s_AlbedoTexture;
+vec2 s_TexCoordsDdx;
+vec2 s_TexCoordsDdy;
+
+vec3 FetchVertex3(uint vertex, uint offset)
+{
+    uint base = vertex * VERTEX_FLOATS + offset;
+    return vec3(u_Vertices[base], u_Vertices[base + 1u], u_Vertices[base + 2u]);
+}
+
+vec2 FetchVertex2(uint vertex, uint offset)
+{
+    uint base = vertex * VERTEX_FLOATS + offset;
+    return vec2(u_Vertices[base], u_Vertices[base + 1u]);
+}
+
+// Perspective-correct barycentrics of an NDC point: solve in screen space,
+// then weight by 1/w (the projective map preserves that relation)
+vec3 Barycentrics(vec4 c0, vec4 c1, vec4 c2, vec2 ndc)
+{
+    vec2 p0 = c0.xy / c0.w;
+    vec2 e1 = c1.xy / c1.w - p0;
+    vec2 e2 = c2.xy / c2.w - p0;
+    vec2 d = ndc - p0;
+
+    float invDet = 1.0 / (e1.x * e2.y - e1.y * e2.x);
+    float b1 = (d.x * e2.y - d.y * e2.x) * invDet;
+    float b2 = (e1.x * d.y - e1.y * d.x) * invDet;
+
+    vec3 weights = vec3(1.0 - b1 - b2, b1, b2) / vec3(c0.w, c1.w, c2.w);
+    return weights / (weights.x + weights.y + weights.z);
+}
+
+// Fills the surface inputs and material of this pixel; false if no triangle covers it
+bool ResolveVisibility()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    uint id = texelFetch(u_VisibilityIDs, pixel, 0).r;
+    if (id == VIS_EMPTY)
+        return false;
+
+    VisibilityDraw draw = u_Draws[id >> VIS_TRIANGLE_BITS];
+    uint first = uint(draw.Geometry.x) + (id & VIS_TRIANGLE_MASK) * 3u;
+    uint baseVertex = uint(draw.Geometry.y);
+    uint i0 = u_Indices[first] + baseVertex;
+    uint i1 = u_Indices[first + 1u] + baseVertex;
+    uint i2 = u_Indices[first + 2u] + baseVertex;
+
+    vec4 w0 = draw.Model * vec4(FetchVertex3(i0, 0u), 1.0);
+    vec4 w1 = draw.Model * vec4(FetchVertex3(i1, 0u), 1.0);
+    vec4 w2 = draw.Model * vec4(FetchVertex3(i2, 0u), 1.0);
+
+    mat4 viewProjection = u_Projection * u_View;
+    vec4 c0 = viewProjection * w0;
+    vec4 c1 = viewProjection * w1;
+    vec4 c2 = viewProjection * w2;
+
+    // Barycentrics at this pixel centre and one pixel right / up, for texture gradients
+    vec2 pixelSize = 2.0 / u_VisibilitySize;
+    vec2 ndc = gl_FragCoord.xy * pixelSize - 1.0;
+    vec3 b = Barycentrics(c0, c1, c2, ndc);
+    vec3 bx = Barycentrics(c0, c1, c2, ndc + vec2(pixelSize.x, 0.0)) - b;
+    vec3 by = Barycentrics(c0, c1, c2, ndc + vec2(0.0, pixelSize.y)) - b;
+
+    mat3 normalMatrix = mat3(draw.NormalMatrix[0].xyz, draw.NormalMatrix[1].xyz, draw.NormalMatrix[2].xyz);
+    vec3 normal = FetchVertex3(i0, 4u) * b.x + FetchVertex3(i1, 4u) * b.y + FetchVertex3(i2, 4u) * b.z;
+    vec3 tangent = FetchVertex3(i0, 13u) * b.x + FetchVertex3(i1, 13u) * b.y + FetchVertex3(i2, 13u) * b.z;
+    vec3 bitangent = FetchVertex3(i0, 16u) * b.x + FetchVertex3(i1, 16u) * b.y + FetchVertex3(i2, 16u) * b.z;
+    vec2 uv0 = FetchVertex2(i0, 11u);
+    vec2 uv1 = FetchVertex2(i1, 11u);
+    vec2 uv2 = FetchVertex2(i2, 11u);
+
+    v_WorldPos = (w0 * b.x + w1 * b.y + w2 * b.z).xyz;
+    v_Normal = normalMatrix * normal;
+    v_TexCoords = uv0 * b.x + uv1 * b.y + uv2 * b.z;
+    v_FragPosLightSpace = u_LightSpaceMatrix * vec4(v_WorldPos, 1.0);
+    v_TBN = mat3(normalize(normalMatrix * tangent), normalize(normalMatrix * bitangent), normalize(v_Normal));
+
+    s_TexCoordsDdx = uv0 * bx.x + uv1 * bx.y + uv2 * bx.z;
+    s_TexCoordsDdy = uv0 * by.x + uv1 * by.y + uv2 * by.z;
+
+    u_Albedo = draw.BaseColor.rgb;
+    u_Alpha = draw.BaseColor.a;
+    u_Metallic = draw.Params.x;
+    u_Roughness = draw.Params.y;
+    u_AO = draw.Params.z;
+    s_AlbedoTexture = draw.Geometry.z;
+    u_UseAlbedoTexture = s_AlbedoTexture >= 0;
+
+    gl_FragDepth = texelFetch(u_VisibilityDepth, pixel, 0).r;
+    return true;
+}
+
+vec4 SampleAlbedo(vec2 uv)
+{
+    switch (s_AlbedoTexture)
+    {
+    case 0: return textureGrad(u_VisibilityAlbedo[0], uv, s_TexCoordsDdx, s_TexCoordsDdy);
+    case 1: return textureGrad(u_VisibilityAlbedo[1], uv, s_TexCoordsDdx, s_TexCoordsDdy);
+    case 2: return textureGrad(u_VisibilityAlbedo[2], uv, s_TexCoordsDdx, s_TexCoordsDdy);
+    case 3: return textureGrad(u_VisibilityAlbedo[3], uv, s_TexCoordsDdx, s_TexCoordsDdy);
+    }
+    return vec4(1.0);
+}
+#else
+vec4 SampleAlbedo(vec2 uv)
+{
+    return texture(u_AlbedoTexture, uv);
+}
+#endif
+
+// ============================================================================
+// Shadow Calculation
+// ============================================================================
+
+const int MAX_SHADOW_TAPS = 32;
+const int MAX_BLOCKER_TAPS = 16;
+const float GOLDEN_ANGLE = 2.39996323;
+
+// Per-pixel noise in [0, 1) used to rotate the sample disk; turns banding into fine grain
+float InterleavedGradientNoise(vec2 pixel)
+{
+    return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+// Point i of a count-point Vogel (golden-angle spiral) disk, radius <= 1
+vec2 VogelDiskSample(int index, int count, float rotation)
+{
+    float r = sqrt((float(index) + 0.5) / float(count));
+    float theta = float(index) * GOLDEN_ANGLE + rotation;
+    return r * vec2(cos(theta), sin(theta));
+}
+
+// Legacy: 3x3 kernel, nine manual depth comparisons
+float ShadowPCF3x3(vec3 projCoords, float bias)
+{
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / textureSize(u_ShadowMap, 0);
+    
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            vec2 offset = vec2(x, y) * texelSize;
+            float closestDepth = texture(u_ShadowMap, projCoords.xy + offset).r;
+            shadow += projCoords.z - bias > closestDepth ? 1.0 : 0.0;
+        }
+    }
+    
+    return shadow / 9.0;
+}
+
+// Hardware comparison: each fetch compares and bilinearly weights 4 texels.
+// One fetch is a 2x2 PCF; four fetches on a 2x2 grid cover a 4x4 footprint.
+float ShadowHardware(vec3 projCoords, float bias)
+{
+    float ref = projCoords.z - bias;
+    if (u_ShadowTaps <= 1)
+        return 1.0 - texture(u_ShadowMapCompare, vec3(projCoords.xy, ref));
+    
+    vec2 texelSize = 1.0 / vec2(textureSize(u_ShadowMapCompare, 0));
+    float lit = 0.0;
+    lit += texture(u_ShadowMapCompare, vec3(projCoords.xy + vec2(-1.0, -1.0) * texelSize, ref));
+    lit += texture(u_ShadowMapCompare, vec3(projCoords.xy + vec2( 1.0, -1.0) * texelSize, ref));
+    lit += texture(u_ShadowMapCompare, vec3(projCoords.xy + vec2(-1.0,  1.0) * texelSize, ref));
+    lit += texture(u_ShadowMapCompare, vec3(projCoords.xy + vec2( 1.0,  1.0) * texelSize, ref));
+    return 1.0 - lit * 0.25;
+}
+
+// Rotated Vogel disk of hardware-compared fetches
+float ShadowDisk(vec3 projCoords, float bias, float radiusTexels, float rotation)
+{
+    int taps = clamp(u_ShadowTaps, 1, MAX_SHADOW_TAPS);
+    vec2 radius = radiusTexels / vec2(textureSize(u_ShadowMapCompare, 0));
+    float ref = projCoords.z - bias;
+    
+    float lit = 0.0;
+    for (int i = 0; i < taps; ++i)
+    {
+        vec2 offset = VogelDiskSample(i, taps, rotation) * radius;
+        lit += texture(u_ShadowMapCompare, vec3(projCoords.xy + offset, ref));
+    }
+    return 1.0 - lit / float(taps);
+}
+
+// Percentage-closer soft shadows: average the occluder depth in a bounded
+// search region, widen the filter with the receiver-occluder distance.
+// The light is orthographic, so depths are linear and the penumbra grows
+// linearly with the distance.
+float ShadowPCSS(vec3 projCoords, float bias, float rotation)
+{
+    vec2 texelSize = 1.0 / vec2(textureSize(u_ShadowMap, 0));
+    float receiver = projCoords.z - bias;
+    float maxRadius = max(u_ShadowMaxPenumbra, 1.0) * texelSize.x;
+    
+    // Blocker search (widest possible penumbra, clamped)
+    int blockerTaps = clamp(u_ShadowBlockerTaps, 1, MAX_BLOCKER_TAPS);
+    float searchRadius = clamp(receiver * u_ShadowLightSize, texelSize.x, maxRadius);
+    float blockerSum = 0.0;
+    int blockerCount = 0;
+    for (int i = 0; i < blockerTaps; ++i)
+    {
+        vec2 offset = VogelDiskSample(i, blockerTaps, rotation) * searchRadius;
+        float depth = texture(u_ShadowMap, projCoords.xy + offset).r;
+        if (depth < receiver)
+        {
+            blockerSum += depth;
+            blockerCount++;
+        }
+    }
+    
+    // Nothing occludes the search region: lit; everything does: umbra
+    if (blockerCount == 0)
+        return 0.0;
+    if (blockerCount == blockerTaps)
+        return 1.0;
+    
+    float avgBlocker = blockerSum / float(blockerCount);
+    float penumbra = clamp((receiver - avgBlocker) * u_ShadowLightSize, texelSize.x, maxRadius);
+    return ShadowDisk(projCoords, bias, penumbra / texelSize.x, rotation);
+}
+
 // Returns 0.0 = fully lit, 1.0 = fully in shadow
 float CalculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 {
@@ -137,27 +484,84 @@ float CalculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
     if (projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0)
         return 0.0;
     
-    float currentDepth = projCoords.z;
-    
     // Slope-scaled bias to prevent shadow acne
     float bias = max(0.005 * (1.0 - dot(normal, lightDir)), 0.001);
     
-    // PCF: Sample 3x3 kernel and average for soft shadows
-    float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(u_ShadowMap, 0);
+    if (u_ShadowFilterMode == 1)
+        return ShadowHardware(projCoords, bias);
     
-    for (int x = -1; x <= 1; ++x)
+    float rotation = InterleavedGradientNoise(gl_FragCoord.xy) * 2.0 * PI;
+    if (u_ShadowFilterMode == 2)
+        return ShadowDisk(projCoords, bias, u_ShadowFilterRadius, rotation);
+    if (u_ShadowFilterMode == 3)
+        return ShadowPCSS(projCoords, bias, rotation);
+    
+    return ShadowPCF3x3(projCoords, bias);
+}
+
+// Finest level whose texels are no larger than the pixel footprint
+// (same as vsm_mark.shader, so the marked page is the one read here)
+int VirtualShadowLevel(vec3 worldPos, vec3 cameraPos)
+{
+    float footprint = distance(worldPos, cameraPos) * u_VSMParams.y;
+    float texel0 = u_VSMParams.x / float(u_VSMLayout.z);
+    float level = ceil(log2(max(footprint / texel0, 1e-6)) + u_VSMParams.w);
+    return clamp(int(level), 0, u_VSMLayout.x - 1);
+}
+
+// Virtual shadow map lookup. Pages that are not resident (not requested
+// yet, over the render budget) fall back to coarser levels, then to lit.
+// Fetches stay inside the page: neighbours in the atlas are unrelated.
+// Returns 0.0 = fully lit, 1.0 = fully in shadow
+float VirtualShadow(vec3 worldPos, vec3 normal, vec3 lightDir)
+{
+    int pages = u_VSMLayout.y;
+    float pageTexels = float(u_VSMLayout.z);
+    float atlasTexels = float(u_VSMLayout.w) * pageTexels;
+    float NdotL = clamp(dot(normal, lightDir), 0.0, 1.0);
+
+    for (int level = VirtualShadowLevel(worldPos, u_ViewPos); level < u_VSMLayout.x; level++)
     {
-        for (int y = -1; y <= 1; ++y)
+        float pageWorld = u_VSMParams.x * exp2(float(level));
+        float texelWorld = pageWorld / pageTexels;
+
+        // Normal offset scaled to this level's texels replaces a slope bias
+        vec3 receiver = worldPos + normal * texelWorld * (0.5 + 1.5 * (1.0 - NdotL));
+        vec3 light = (u_VSMLightView * vec4(receiver, 1.0)).xyz;
+
+        vec2 pageCoord = light.xy / pageWorld;
+        ivec2 page = ivec2(floor(pageCoord));
+        ivec2 local = page - u_VSMOrigins[level].xy;
+        if (any(lessThan(local, ivec2(0))) || any(greaterThanEqual(local, ivec2(pages))))
+            continue;
+
+        ivec2 wrapped = page & (pages - 1);
+        uint entry = u_VSMPages[(level * pages + wrapped.y) * pages + wrapped.x];
+        if (entry == 0u)
+            continue;
+
+        int physical = int(entry - 1u);
+        vec2 pageOrigin = vec2(physical % u_VSMLayout.w, physical / u_VSMLayout.w) * pageTexels;
+        float ref = 0.5 - light.z / (2.0 * u_VSMParams.z);
+
+        if (u_ShadowTaps <= 1)
         {
-            vec2 offset = vec2(x, y) * texelSize;
-            float closestDepth = texture(u_ShadowMap, projCoords.xy + offset).r;
-            shadow += currentDepth - bias > closestDepth ? 1.0 : 0.0;
+            vec2 texel = clamp(fract(pageCoord) * pageTexels, vec2(0.5), vec2(pageTexels - 0.5));
+            return 1.0 - texture(u_ShadowMapCompare, vec3((pageOrigin + texel) / atlasTexels, ref));
         }
+
+        // Four bilinear comparisons on a 2x2 grid (4x4 footprint)
+        vec2 texel = clamp(fract(pageCoord) * pageTexels, vec2(1.5), vec2(pageTexels - 1.5));
+        vec2 uv = (pageOrigin + texel) / atlasTexels;
+        float texelUV = 1.0 / atlasTexels;
+        float lit = 0.0;
+        lit += texture(u_ShadowMapCompare, vec3(uv + vec2(-texelUV, -texelUV), ref));
+        lit += texture(u_ShadowMapCompare, vec3(uv + vec2( texelUV, -texelUV), ref));
+        lit += texture(u_ShadowMapCompare, vec3(uv + vec2(-texelUV,  texelUV), ref));
+        lit += texture(u_ShadowMapCompare, vec3(uv + vec2( texelUV,  texelUV), ref));
+        return 1.0 - lit * 0.25;
     }
-    
-    shadow /= 9.0;
-    return shadow;
+    return 0.0;
 }
 
 // ============================================================================
@@ -297,6 +701,11 @@ vec3 SampleIrradianceWithFallback(samplerCube irrMap, vec3 normal)
 // ============================================================================
 void main()
 {
+#ifdef VISIBILITY_RESOLVE
+    if (!ResolveVisibility())
+        discard;
+#endif
+
     // Normalize interpolated vectors
     vec3 N = normalize(v_Normal);
 
@@ -314,15 +723,34 @@ void main()
     vec3 albedo = u_Albedo;
     if (u_UseAlbedoTexture)
     {
-        vec4 texColor = texture(u_AlbedoTexture, v_TexCoords);
+        vec4 texColor = SampleAlbedo(v_TexCoords);
         albedo = texColor.rgb * u_Albedo;  // Multiply texture with tint color
     }
     
+    // Metallic, roughness and occlusion: one fetch when ORM-packed
+    float metallic = u_Metallic;
+    float roughness = u_Roughness;
+    float ao = u_AO;
+    if (u_UseMetallicRoughnessTexture)
+    {
+        vec3 orm = texture(u_MetallicRoughnessTexture, v_TexCoords).rgb;
+        roughness *= orm.g;
+        metallic *= orm.b;
+        if (u_UseORMTexture)
+        {
+            ao *= orm.r;
+        }
+    }
+    if (u_UseAOTexture && !u_UseORMTexture)
+    {
+        ao *= texture(u_AOTexture, v_TexCoords).r;
+    }
+
     // Calculate F0 (base reflectivity)
     // Dielectrics: 0.04 (approximately 4% reflectivity)
     // Metals: use albedo as F0 (tinted reflections)
     vec3 F0 = vec3(0.04);
-    F0 = mix(F0, albedo, u_Metallic);
+    F0 = mix(F0, albedo, metallic);
     
     // Accumulate radiance from all lights
     vec3 Lo = vec3(0.0);
@@ -347,14 +775,14 @@ void main()
         // ====================================================================
         
         // D: Normal Distribution Function (microfacet alignment)
-        float D = DistributionGGX(N, H, u_Roughness);
+        float D = DistributionGGX(N, H, roughness);
         
         // F: Fresnel (angle-dependent reflectivity)
         float cosTheta = max(dot(H, V), 0.0);
         vec3 F = FresnelSchlick(cosTheta, F0);
         
         // G: Geometry (self-shadowing/masking)
-        float G = GeometrySmith(N, V, L, u_Roughness);
+        float G = GeometrySmith(N, V, L, roughness);
         
         // Specular BRDF: (D * F * G) / (4 * NdotV * NdotL)
         vec3 numerator = D * F * G;
@@ -373,7 +801,7 @@ void main()
         vec3 kD = vec3(1.0) - kS;
         
         // Metals have no diffuse (all energy goes to specular)
-        kD *= (1.0 - u_Metallic);
+        kD *= (1.0 - metallic);
         
         // Lambertian diffuse: albedo / π
         vec3 diffuse = kD * albedo / PI;
@@ -397,10 +825,10 @@ void main()
         vec3 radiance = u_DirLightColor;
         
         // Cook-Torrance BRDF (same as point lights)
-        float D = DistributionGGX(N, H, u_Roughness);
+        float D = DistributionGGX(N, H, roughness);
         float cosTheta = max(dot(H, V), 0.0);
         vec3 F = FresnelSchlick(cosTheta, F0);
-        float G = GeometrySmith(N, V, L, u_Roughness);
+        float G = GeometrySmith(N, V, L, roughness);
         
         vec3 numerator = D * F * G;
         float NdotV = max(dot(N, V), 0.0);
@@ -409,11 +837,13 @@ void main()
         vec3 specular = numerator / denominator;
         
         vec3 kS = F;
-        vec3 kD = (vec3(1.0) - kS) * (1.0 - u_Metallic);
+        vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
         vec3 diffuse = kD * albedo / PI;
         
         // Calculate shadow for directional light
-        float shadow = CalculateShadow(v_FragPosLightSpace, N, L);
+        float shadow = u_UseVirtualShadows
+            ? VirtualShadow(v_WorldPos, N, L)
+            : CalculateShadow(v_FragPosLightSpace, N, L);
         
         // Apply shadow to directional light contribution
         Lo += (1.0 - shadow) * (diffuse + specular) * radiance * NdotL;
@@ -428,8 +858,8 @@ void main()
     {
         // ----- Diffuse IBL -----
         // Use Fresnel with roughness for IBL to account for surface roughness
-        vec3 kS_IBL = FresnelSchlickRoughness(max(dot(N, V), 0.0), F0, u_Roughness);
-        vec3 kD_IBL = (vec3(1.0) - kS_IBL) * (1.0 - u_Metallic);
+        vec3 kS_IBL = FresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+        vec3 kD_IBL = (vec3(1.0) - kS_IBL) * (1.0 - metallic);
 
         // Sample irradiance with lower hemisphere fallback
         vec3 irradiance = SampleIrradianceWithFallback(u_IrradianceMap, N);
@@ -439,11 +869,11 @@ void main()
         vec3 R = reflect(-V, N);
 
         // Sample pre-filtered environment
-        float mipLevel = u_Roughness * u_MaxReflectionLOD;
+        float mipLevel = roughness * u_MaxReflectionLOD;
         vec3 prefilteredColor = SampleEnvironmentWithFallback(u_PrefilteredMap, R, mipLevel);
 
         // Look up BRDF integration
-        vec2 envBRDF = texture(u_BRDF_LUT, vec2(max(dot(N, V), 0.0), u_Roughness)).rg;
+        vec2 envBRDF = texture(u_BRDF_LUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
 
         // Reconstruct specular: F0 * scale + bias
         vec3 specularIBL = prefilteredColor * (F0 * envBRDF.x + envBRDF.y);
@@ -451,17 +881,17 @@ void main()
         // ----- Minimum Metallic Reflection Floor -----
         // For highly metallic surfaces, ensure a minimum reflection based on the fallback color
         // This prevents pure black even when environment and BRDF combine to near-zero
-        float metallicFactor = u_Metallic * (1.0 - u_Roughness);  // Strongest for shiny metals
+        float metallicFactor = metallic * (1.0 - roughness);  // Strongest for shiny metals
         vec3 minReflection = u_LowerHemisphereColor * F0 * metallicFactor * u_LowerHemisphereIntensity;
         specularIBL = max(specularIBL, minReflection);
 
         // ----- Combine -----
-        ambient = (kD_IBL * diffuseIBL + specularIBL) * u_AO * u_IBLIntensity;
+        ambient = (kD_IBL * diffuseIBL + specularIBL) * ao * u_IBLIntensity;
     }
     else
     {
         // Fallback to simple ambient (Chapter 37 style)
-        ambient = vec3(0.03) * albedo * u_AO;
+        ambient = vec3(0.03) * albedo * ao;
     }
     
     vec3 color = ambient + Lo;
@@ -23,6 +23,7 @@ out vec4 FragColor;
 in vec3 v_WorldPos;
 
 uniform samplerCube u_EnvironmentMap;
+uniform float u_SampleDelta;  // Angular step in radians (quality setting)
 
 const float PI = 3.14159265359;
 
@@ -39,7 +40,7 @@ void main()
     up = normalize(cross(N, right));
     
     // Hemisphere sampling parameters
-    float sampleDelta = 0.025;  // Angular step size
+    float sampleDelta = max(u_SampleDelta, 0.005);  // Angular step size
     float nrSamples = 0.0;
     
     // Sample hemisphere aligned with N
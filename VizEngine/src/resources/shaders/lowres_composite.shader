@@ -0,0 +1,86 @@
+#shader vertex
+#version 460 core
+
+// Depth-aware upsampling of LowResolutionPass, full-screen triangle
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+
+#shader fragment
+#version 460 core
+
+// rgb = premultiplied color, a = transmittance (blended as ONE, SRC_ALPHA)
+out vec4 FragColor;
+
+uniform sampler2D u_LowColor;
+uniform sampler2D u_LowDepth;
+uniform sampler2D u_FullDepth;
+uniform int u_Scale;
+uniform int u_Mode;              // LowResolutionUpsample: 0 = bilinear, 1 = bilateral, 2 = nearest depth
+uniform float u_DepthThreshold;  // Relative view-depth difference treated as an edge
+uniform vec2 u_DepthParams;      // projection[2][2], projection[3][2]
+
+float LinearDepth(float depth)
+{
+    // View-space distance from a [0, 1] perspective depth
+    return u_DepthParams.y / (depth * 2.0 - 1.0 + u_DepthParams.x);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 lowSize = textureSize(u_LowColor, 0);
+    float depth = LinearDepth(texelFetch(u_FullDepth, pixel, 0).r);
+
+    // The 2x2 small texels around this pixel and their bilinear weights
+    vec2 lowPos = (vec2(pixel) + 0.5) / float(u_Scale) - 0.5;
+    ivec2 base = ivec2(floor(lowPos));
+    vec2 f = lowPos - vec2(base);
+
+    const ivec2 offsets[4] = ivec2[4](ivec2(0, 0), ivec2(1, 0), ivec2(0, 1), ivec2(1, 1));
+    float bilinear[4] = float[4]((1.0 - f.x) * (1.0 - f.y), f.x * (1.0 - f.y), (1.0 - f.x) * f.y, f.x * f.y);
+
+    vec4 samples[4];
+    float difference[4];
+    float maxDifference = 0.0;
+    int nearest = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        ivec2 texel = clamp(base + offsets[i], ivec2(0), lowSize - 1);
+        samples[i] = texelFetch(u_LowColor, texel, 0);
+        difference[i] = abs(LinearDepth(texelFetch(u_LowDepth, texel, 0).r) - depth) / depth;
+        maxDifference = max(maxDifference, difference[i]);
+        if (difference[i] < difference[nearest]) nearest = i;
+    }
+
+    vec4 result = vec4(0.0);
+    if (u_Mode == 2 && maxDifference > u_DepthThreshold)
+    {
+        // Edge: take the texel that saw the same surface
+        result = samples[nearest];
+    }
+    else if (u_Mode == 1)
+    {
+        float total = 0.0;
+        for (int i = 0; i < 4; i++)
+        {
+            float w = bilinear[i] / (difference[i] / u_DepthThreshold + 1e-3);
+            result += samples[i] * w;
+            total += w;
+        }
+        result /= total;
+    }
+    else
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            result += samples[i] * bilinear[i];
+        }
+    }
+
+    FragColor = result;
+}
@@ -0,0 +1,37 @@
+#shader vertex
+#version 460 core
+
+// Depth reduction for LowResolutionPass, full-screen triangle
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+
+#shader fragment
+#version 460 core
+
+uniform sampler2D u_FullDepth;
+uniform int u_Scale;   // Full-resolution texels per small texel, per axis
+
+void main()
+{
+    // Farthest depth of the block, so blended draws are only rejected
+    // where every full-resolution pixel they cover is in front of them
+    ivec2 fullSize = textureSize(u_FullDepth, 0);
+    ivec2 origin = ivec2(gl_FragCoord.xy) * u_Scale;
+
+    float farthest = 0.0;
+    for (int y = 0; y < u_Scale; y++)
+    {
+        for (int x = 0; x < u_Scale; x++)
+        {
+            ivec2 texel = min(origin + ivec2(x, y), fullSize - 1);
+            farthest = max(farthest, texelFetch(u_FullDepth, texel, 0).r);
+        }
+    }
+
+    gl_FragDepth = farthest;
+}
@@ -0,0 +1,37 @@
+#shader vertex
+#version 460 core
+
+// Overdraw counting (OverdrawAnalyzer): every fragment adds u_Weight to an
+// R32F target with additive blending.
+
+layout(location = 0) in vec4 aPos;
+
+uniform mat4 u_ViewProjection;
+uniform mat4 u_Model;
+uniform bool u_Fullscreen;   // Post passes: attribute-less full-screen triangle
+
+void main()
+{
+    if (u_Fullscreen)
+    {
+        vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+    }
+    else
+    {
+        gl_Position = u_ViewProjection * u_Model * aPos;
+    }
+}
+
+
+#shader fragment
+#version 460 core
+
+out float FragCount;
+
+uniform float u_Weight;   // 1 per fragment; post passes use their resolution fraction
+
+void main()
+{
+    FragCount = u_Weight;
+}
@@ -0,0 +1,51 @@
+#shader vertex
+#version 460 core
+
+// Overdraw heat map (OverdrawAnalyzer::Visualize), full-screen triangle
+
+out vec2 v_TexCoords;
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    v_TexCoords = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+
+#shader fragment
+#version 460 core
+
+out vec4 FragColor;
+
+in vec2 v_TexCoords;
+
+uniform sampler2D u_Counts;
+uniform float u_MaxCount;   // Count shown at the hot end of the ramp
+
+// black (0) -> blue -> cyan -> green -> yellow -> red -> white (>= max)
+vec3 HeatRamp(float t)
+{
+    const vec3 stops[7] = vec3[7](
+        vec3(0.0, 0.0, 0.0),
+        vec3(0.0, 0.0, 1.0),
+        vec3(0.0, 1.0, 1.0),
+        vec3(0.0, 1.0, 0.0),
+        vec3(1.0, 1.0, 0.0),
+        vec3(1.0, 0.0, 0.0),
+        vec3(1.0, 1.0, 1.0)
+    );
+
+    float x = clamp(t, 0.0, 1.0) * 6.0;
+    int i = min(int(x), 5);
+    return mix(stops[i], stops[i + 1], x - float(i));
+}
+
+void main()
+{
+    // Exact counts: no filtering between neighbouring pixels
+    ivec2 size = textureSize(u_Counts, 0);
+    ivec2 texel = clamp(ivec2(v_TexCoords * vec2(size)), ivec2(0), size - 1);
+    float count = texelFetch(u_Counts, texel, 0).r;
+    FragColor = vec4(HeatRamp(count / u_MaxCount), 1.0);
+}
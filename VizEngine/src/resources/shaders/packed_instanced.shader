@@ -0,0 +1,164 @@
+#shader vertex
+#version 460 core
+
+// Instanced rendering with packed materials (MaterialTexturePacker)
+// Each instance selects a row of the material table; textures come from
+// 2D array pools, so instances with different materials share one draw.
+
+// Per-vertex attributes (from mesh VBO)
+layout(location = 0) in vec4 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec2 aTexCoords;
+layout(location = 4) in vec3 aTangent;
+layout(location = 5) in vec3 aBitangent;
+
+// Per-instance attributes (from instance VBO, 4 vec4s = one mat4)
+layout(location = 6) in vec4 aInstanceModel0;
+layout(location = 7) in vec4 aInstanceModel1;
+layout(location = 8) in vec4 aInstanceModel2;
+layout(location = 9) in vec4 aInstanceModel3;
+
+// Material index per instance (gl_BaseInstance keeps indirect draws correct)
+layout(std430, binding = 1) readonly buffer InstanceMaterials
+{
+    uint u_InstanceMaterial[];
+};
+
+out vec3 v_WorldPos;
+out vec2 v_TexCoords;
+out mat3 v_TBN;
+flat out uint v_MaterialIndex;
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+
+void main()
+{
+    mat4 instanceModel = mat4(
+        aInstanceModel0,
+        aInstanceModel1,
+        aInstanceModel2,
+        aInstanceModel3
+    );
+
+    vec4 worldPos = instanceModel * aPos;
+    v_WorldPos = worldPos.xyz;
+
+    // Uniform scaling assumed, as in instanced.shader
+    mat3 normalMatrix = mat3(instanceModel);
+    vec3 N = normalize(normalMatrix * aNormal);
+    vec3 T = normalize(normalMatrix * aTangent);
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T);
+    v_TBN = mat3(T, B, N);
+
+    v_TexCoords = aTexCoords;
+    v_MaterialIndex = u_InstanceMaterial[gl_BaseInstance + gl_InstanceID];
+
+    gl_Position = u_Projection * u_View * worldPos;
+}
+
+
+#shader fragment
+#version 460 core
+
+out vec4 FragColor;
+
+in vec3 v_WorldPos;
+in vec2 v_TexCoords;
+in mat3 v_TBN;
+flat in uint v_MaterialIndex;
+
+// Mirrors PackedMaterialGPU (std430, 160 bytes)
+struct PackedMaterial
+{
+    vec4 BaseColor;
+    vec4 Params;        // x = metallic, y = roughness, z = AO, w = alpha cutoff
+    vec4 Emissive;      // rgb = emissive factor
+    ivec4 LayersA;      // base color, normal, metallic-roughness, occlusion (-1 = none)
+    ivec4 LayersB;      // x = emissive, y = 1 if occlusion is in metallic-roughness R (ORM)
+    vec4 UVTransforms[5];
+};
+
+layout(std430, binding = 0) readonly buffer MaterialTable
+{
+    PackedMaterial u_Materials[];
+};
+
+// One pool per texture role for the whole batch
+uniform sampler2DArray u_BaseColorPool;
+uniform sampler2DArray u_NormalPool;
+uniform sampler2DArray u_MetallicRoughnessPool;
+uniform sampler2DArray u_OcclusionPool;
+uniform sampler2DArray u_EmissivePool;
+
+// Simple directional lighting, matching instanced.shader
+uniform vec3 u_DirLightDirection;
+uniform vec3 u_DirLightColor;
+uniform vec3 u_ViewPos;
+
+// Atlas entries (scale < 1) wrap inside their rectangle; gradients come from
+// the unwrapped UV so fract() seams do not select the smallest mip
+vec4 SamplePool(sampler2DArray pool, int layer, vec4 uvTransform)
+{
+    vec2 dx = dFdx(v_TexCoords) * uvTransform.xy;
+    vec2 dy = dFdy(v_TexCoords) * uvTransform.xy;
+    bool isAtlas = uvTransform.x < 1.0 || uvTransform.y < 1.0;
+    vec2 uv = isAtlas ? fract(v_TexCoords) : v_TexCoords;
+    return textureGrad(pool, vec3(uv * uvTransform.xy + uvTransform.zw, float(layer)), dx, dy);
+}
+
+void main()
+{
+    PackedMaterial m = u_Materials[v_MaterialIndex];
+
+    vec4 baseColor = m.BaseColor;
+    if (m.LayersA.x >= 0)
+        baseColor *= SamplePool(u_BaseColorPool, m.LayersA.x, m.UVTransforms[0]);
+
+    // Alpha mask
+    if (m.Params.w > 0.0 && baseColor.a < m.Params.w)
+        discard;
+
+    vec3 N = normalize(v_TBN[2]);
+    if (m.LayersA.y >= 0)
+    {
+        vec3 tangentNormal = SamplePool(u_NormalPool, m.LayersA.y, m.UVTransforms[1]).xyz * 2.0 - 1.0;
+        N = normalize(v_TBN * tangentNormal);
+    }
+
+    float metallic = m.Params.x;
+    float roughness = m.Params.y;
+    float ao = m.Params.z;
+    if (m.LayersA.z >= 0)
+    {
+        vec4 mr = SamplePool(u_MetallicRoughnessPool, m.LayersA.z, m.UVTransforms[2]);
+        roughness *= mr.g;
+        metallic *= mr.b;
+        if (m.LayersB.y > 0)
+            ao *= mr.r;
+    }
+
+    if (m.LayersA.w >= 0)
+        ao *= SamplePool(u_OcclusionPool, m.LayersA.w, m.UVTransforms[3]).r;
+
+    vec3 emissive = m.Emissive.rgb;
+    if (m.LayersB.x >= 0)
+        emissive *= SamplePool(u_EmissivePool, m.LayersB.x, m.UVTransforms[4]).rgb;
+
+    vec3 L = normalize(-u_DirLightDirection);
+    vec3 V = normalize(u_ViewPos - v_WorldPos);
+    vec3 H = normalize(V + L);
+
+    // Blinn-Phong approximation of the metallic-roughness parameters
+    vec3 diffuseColor = baseColor.rgb * (1.0 - metallic);
+    vec3 specularColor = mix(vec3(0.04), baseColor.rgb, metallic);
+    float shininess = mix(256.0, 4.0, roughness);
+
+    vec3 ambient = 0.15 * baseColor.rgb * ao;
+    vec3 diffuse = max(dot(N, L), 0.0) * u_DirLightColor * diffuseColor;
+    vec3 specular = pow(max(dot(N, H), 0.0), shininess) * u_DirLightColor * specularColor;
+
+    FragColor = vec4(ambient + diffuse + specular + emissive, baseColor.a);
+}
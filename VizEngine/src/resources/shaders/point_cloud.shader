@@ -0,0 +1,55 @@
+#shader vertex
+#version 460 core
+
+// Point cloud octree nodes (PointCloud.cpp): positions in the cloud's local
+// space, 8-bit sRGB colors. Point size covers the node's sample spacing in
+// screen pixels.
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec4 aColor;
+
+out vec3 v_Color;
+
+uniform mat4 u_Model;
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+
+uniform float u_Spacing;      // World distance between the node's points
+uniform float u_PointScale;
+uniform float u_ProjScale;    // Pixels per world unit at unit view depth
+uniform vec2 u_SizeRange;     // Min, max point size in pixels
+
+void main()
+{
+    vec4 viewPos = u_View * u_Model * vec4(aPos, 1.0);
+    gl_Position = u_Projection * viewPos;
+
+    float size = u_PointScale * u_Spacing * u_ProjScale / max(-viewPos.z, 1e-4);
+    gl_PointSize = clamp(size, u_SizeRange.x, u_SizeRange.y);
+
+    // The HDR target expects linear color
+    v_Color = pow(aColor.rgb, vec3(2.2));
+}
+
+
+#shader fragment
+#version 460 core
+
+out vec4 FragColor;
+
+in vec3 v_Color;
+
+uniform float u_Brightness;
+uniform bool u_RoundPoints;
+
+void main()
+{
+    if (u_RoundPoints)
+    {
+        vec2 offset = gl_PointCoord * 2.0 - 1.0;
+        if (dot(offset, offset) > 1.0)
+            discard;
+    }
+
+    FragColor = vec4(v_Color * u_Brightness, 1.0);
+}
@@ -24,9 +24,9 @@ in vec3 v_WorldPos;
 
 uniform samplerCube u_EnvironmentMap;
 uniform float u_Roughness;
+uniform int u_SampleCount;  // GGX samples per texel (quality setting)
 
 const float PI = 3.14159265359;
-const uint SAMPLE_COUNT = 1024u;
 
 // ----------------------------------------------------------------------------
 // Van der Corput radical inverse (bit manipulation for low-discrepancy)
@@ -93,9 +93,10 @@ void main()
     vec3 prefilteredColor = vec3(0.0);
     float totalWeight = 0.0;
     
-    for (uint i = 0u; i < SAMPLE_COUNT; ++i)
+    uint sampleCount = uint(max(u_SampleCount, 1));
+    for (uint i = 0u; i < sampleCount; ++i)
     {
-        vec2 Xi = Hammersley(i, SAMPLE_COUNT);
+        vec2 Xi = Hammersley(i, sampleCount);
         vec3 H = ImportanceSampleGGX(Xi, N, u_Roughness);
         vec3 L = normalize(2.0 * dot(V, H) * H - V);
         
@@ -6,10 +6,26 @@ layout(location = 0) in vec4 aPos;
 uniform mat4 u_LightSpaceMatrix;  // Light's projection * view
 uniform mat4 u_Model;              // Model matrix
 
+// Instanced draws: the defaultlit.shader instance table, model matrices only
+struct InstanceTransform
+{
+    mat4 Model;
+    vec4 NormalMatrix[3];
+};
+
+layout(std430, binding = 8) readonly buffer InstanceTransforms
+{
+    InstanceTransform u_Instances[];
+};
+
+uniform bool u_Instanced;
+
 void main()
 {
+    mat4 model = u_Instanced ? u_Instances[gl_BaseInstance + gl_InstanceID].Model : u_Model;
+
     // Transform vertex to light's clip space
-    gl_Position = u_LightSpaceMatrix * u_Model * aPos;
+    gl_Position = u_LightSpaceMatrix * model * aPos;
 }
 
 
@@ -0,0 +1,174 @@
+#shader compute
+#version 460 core
+
+// Single-pass downsampler: one dispatch writes up to 12 mip levels.
+//
+// Each 256-thread workgroup reduces a 64x64 tile of the source level down to
+// one texel (mips 1-6) in shared memory. The workgroups publish their mip-6
+// texel to a buffer and bump an atomic counter; the last one to finish reads
+// the whole mip-6 grid (at most 64x64) and reduces it the same way (mips 7-12).
+//
+// Mip m texel p covers source texels [p * 2^m, (p + 1) * 2^m). Fetches past
+// the edge of a non-power-of-two source are clamped; the odd last row/column
+// of a level is not folded into the next one (same as a box-filter glGenerateMipmap).
+
+// Number of image units the host may bind (injected from the driver limit)
+#ifndef SPD_MAX_IMAGES
+#define SPD_MAX_IMAGES 12
+#endif
+
+#define SPD_AVERAGE 0
+#define SPD_MIN 1
+#define SPD_MAX 2
+
+layout(local_size_x = 256) in;
+
+uniform sampler2D u_Source;
+uniform int u_SourceLevel;
+uniform ivec2 u_SourceSize;     // Size of u_SourceLevel
+uniform ivec2 u_GroupCount;     // Workgroups dispatched (= mip-6 grid size)
+uniform int u_MipCount;         // Levels to produce below the source (0-12, 0 = copy only)
+uniform int u_Reduction;        // SPD_AVERAGE / SPD_MIN / SPD_MAX
+uniform bool u_CopySource;      // u_Mips[0] receives the source level unchanged
+
+// u_Mips[i] is bound to the i-th destination level of this dispatch
+layout(binding = 0) writeonly uniform image2D u_Mips[SPD_MAX_IMAGES];
+
+layout(std430, binding = 0) coherent buffer SpdGlobal
+{
+    uint u_Counter;             // Workgroups finished; reset by the last one
+    uint u_Pad0;
+    uint u_Pad1;
+    uint u_Pad2;
+    vec4 u_Mip6[];              // One texel per workgroup
+};
+
+shared vec4 s_Tile[32][32];
+shared uint s_Ticket;
+
+vec4 Reduce(vec4 a, vec4 b, vec4 c, vec4 d)
+{
+    if (u_Reduction == SPD_MIN) return min(min(a, b), min(c, d));
+    if (u_Reduction == SPD_MAX) return max(max(a, b), max(c, d));
+    return (a + b + c + d) * 0.25;
+}
+
+int OutputIndex(int mip)
+{
+    return mip - 1 + (u_CopySource ? 1 : 0);
+}
+
+vec4 FetchSource(ivec2 p)
+{
+    vec4 value = texelFetch(u_Source, min(p, u_SourceSize - 1), u_SourceLevel);
+    if (u_CopySource)
+    {
+        imageStore(u_Mips[0], p, value);   // Out-of-range stores are dropped
+    }
+    return value;
+}
+
+vec4 FetchMip6(ivec2 p)
+{
+    p = min(p, u_GroupCount - 1);
+    return u_Mip6[p.y * u_GroupCount.x + p.x];
+}
+
+// Reduce shared memory (32x32 holding mip firstMip) down to one texel,
+// writing mips firstMip+1 .. firstMip+5. Must be called by the whole group.
+void ReduceTile(int firstMip, ivec2 tile)
+{
+    uint thread = gl_LocalInvocationIndex;
+
+    for (int step = 1; step <= 5; step++)
+    {
+        int mip = firstMip + step;
+        int size = 32 >> step;
+        ivec2 p = ivec2(int(thread) % size, int(thread) / size);
+        bool active = int(thread) < size * size;
+
+        vec4 value = vec4(0.0);
+        if (active)
+        {
+            ivec2 s = p * 2;
+            value = Reduce(s_Tile[s.y][s.x], s_Tile[s.y][s.x + 1],
+                           s_Tile[s.y + 1][s.x], s_Tile[s.y + 1][s.x + 1]);
+        }
+        barrier();
+
+        if (active)
+        {
+            s_Tile[p.y][p.x] = value;
+            if (mip <= u_MipCount)
+            {
+                imageStore(u_Mips[OutputIndex(mip)], tile * size + p, value);
+            }
+        }
+        barrier();
+    }
+}
+
+void main()
+{
+    uint thread = gl_LocalInvocationIndex;
+    ivec2 group = ivec2(gl_WorkGroupID.xy);
+
+    // ---- Mips 1-6: this workgroup's 64x64 tile ----
+    for (int i = 0; i < 4; i++)
+    {
+        int index = int(thread) + i * 256;
+        ivec2 p = ivec2(index % 32, index / 32);
+        ivec2 s = group * 64 + p * 2;
+
+        vec4 value = Reduce(FetchSource(s), FetchSource(s + ivec2(1, 0)),
+                            FetchSource(s + ivec2(0, 1)), FetchSource(s + ivec2(1, 1)));
+        s_Tile[p.y][p.x] = value;
+        if (u_MipCount >= 1)
+        {
+            imageStore(u_Mips[OutputIndex(1)], group * 32 + p, value);
+        }
+    }
+    barrier();
+
+    ReduceTile(1, group);
+
+    if (u_MipCount <= 6)
+    {
+        return;
+    }
+
+    // ---- Publish mip 6, the last workgroup carries on ----
+    if (thread == 0)
+    {
+        u_Mip6[group.y * u_GroupCount.x + group.x] = s_Tile[0][0];
+        memoryBarrierBuffer();
+        s_Ticket = atomicAdd(u_Counter, 1u);
+    }
+    barrier();
+
+    if (s_Ticket != uint(u_GroupCount.x * u_GroupCount.y - 1))
+    {
+        return;
+    }
+    if (thread == 0)
+    {
+        u_Counter = 0u;   // Ready for the next dispatch
+    }
+    memoryBarrierBuffer();
+
+    // ---- Mips 7-12: the mip-6 grid as one tile ----
+    for (int i = 0; i < 4; i++)
+    {
+        int index = int(thread) + i * 256;
+        ivec2 p = ivec2(index % 32, index / 32);
+        ivec2 s = p * 2;
+
+        vec4 value = Reduce(FetchMip6(s), FetchMip6(s + ivec2(1, 0)),
+                            FetchMip6(s + ivec2(0, 1)), FetchMip6(s + ivec2(1, 1)));
+        s_Tile[p.y][p.x] = value;
+        imageStore(u_Mips[OutputIndex(7)], p, value);
+    }
+    barrier();
+
+    ReduceTile(7, ivec2(0));
+}
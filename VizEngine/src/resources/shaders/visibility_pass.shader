@@ -0,0 +1,60 @@
+#shader vertex
+#version 460 core
+
+// Visibility buffer geometry pass (VisibilityBuffer): every opaque draw in
+// one multi-draw, positions pulled from the merged vertex buffer.
+
+// Mirrors VisibilityDrawGPU (std430, 160 bytes)
+struct VisibilityDraw
+{
+    mat4 Model;
+    vec4 NormalMatrix[3];
+    vec4 BaseColor;
+    vec4 Params;
+    ivec4 Geometry;
+};
+
+layout(std430, binding = 2) readonly buffer VisibilityDraws
+{
+    VisibilityDraw u_Draws[];
+};
+
+// Interleaved Vertex structs (Mesh.h), 19 floats each
+layout(std430, binding = 3) readonly buffer VisibilityVertices
+{
+    float u_Vertices[];
+};
+
+const uint VERTEX_FLOATS = 19u;
+
+uniform mat4 u_ViewProjection;
+
+flat out uint v_DrawID;
+
+void main()
+{
+    // gl_VertexID already includes the draw's base vertex
+    uint base = uint(gl_VertexID) * VERTEX_FLOATS;
+    vec4 position = vec4(u_Vertices[base], u_Vertices[base + 1u], u_Vertices[base + 2u], u_Vertices[base + 3u]);
+
+    // Each command's base instance is its first draw; instances are consecutive draws
+    v_DrawID = uint(gl_BaseInstance + gl_InstanceID);
+    gl_Position = u_ViewProjection * u_Draws[v_DrawID].Model * position;
+}
+
+
+#shader fragment
+#version 460 core
+
+// Matches VisibilityBuffer::TriangleBits
+const uint TRIANGLE_BITS = 20u;
+
+layout(location = 0) out uint VisibilityID;
+
+flat in uint v_DrawID;
+
+void main()
+{
+    // gl_PrimitiveID restarts at 0 for every draw and instance of the multi-draw
+    VisibilityID = (v_DrawID << TRIANGLE_BITS) | uint(gl_PrimitiveID);
+}
@@ -0,0 +1,37 @@
+#shader compute
+#version 460 core
+
+// Volume brick value ranges (VolumeRenderer::SetVolume): min and max of the
+// voxels a trilinear sample inside each brick can reach, i.e. the brick
+// plus one voxel on every side.
+
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+
+layout(rg32f, binding = 0) uniform writeonly image3D u_MinMax;
+
+uniform sampler3D u_Volume;
+uniform int u_BrickSize;
+
+void main()
+{
+    ivec3 brick = ivec3(gl_GlobalInvocationID);
+    if (any(greaterThanEqual(brick, imageSize(u_MinMax))))
+        return;
+
+    ivec3 size = textureSize(u_Volume, 0);
+    ivec3 first = max(brick * u_BrickSize - 1, ivec3(0));
+    ivec3 last = min((brick + 1) * u_BrickSize, size - 1);
+
+    float lo = 3.402823e38;
+    float hi = -3.402823e38;
+    for (int z = first.z; z <= last.z; z++)
+    for (int y = first.y; y <= last.y; y++)
+    for (int x = first.x; x <= last.x; x++)
+    {
+        float value = texelFetch(u_Volume, ivec3(x, y, z), 0).r;
+        lo = min(lo, value);
+        hi = max(hi, value);
+    }
+
+    imageStore(u_MinMax, brick, vec4(lo, hi, 0.0, 0.0));
+}
@@ -0,0 +1,44 @@
+#shader compute
+#version 460 core
+
+// Volume occupancy (VolumeRenderer): a brick is occupied when any transfer
+// function entry its value range maps to has non-zero opacity. Rebuilt when
+// the transfer function or value window changes.
+
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+
+layout(r8, binding = 0) uniform writeonly image3D u_Occupancy;
+
+uniform sampler3D u_MinMax;
+uniform vec2 u_Window;        // Values mapped to the first and last entry
+uniform int u_TableSize;
+
+// Mirrors OccupiedHeaderBytes in VolumeRenderer.cpp
+layout(std430, binding = 7) buffer VolumeOccupied
+{
+    uint u_OccupiedCount;
+    uint u_OccupiedPad0;
+    uint u_OccupiedPad1;
+    uint u_OccupiedPad2;
+    uint u_OpaquePrefix[];    // Opaque entries in [0, i), u_TableSize + 1 values
+};
+
+void main()
+{
+    ivec3 brick = ivec3(gl_GlobalInvocationID);
+    if (any(greaterThanEqual(brick, imageSize(u_Occupancy))))
+        return;
+
+    vec2 range = texelFetch(u_MinMax, brick, 0).rg;
+    vec2 t = clamp((range - u_Window.x) / max(u_Window.y - u_Window.x, 1e-6), 0.0, 1.0);
+
+    // Linear filtering reaches the entries on both sides of each end
+    float last = float(u_TableSize - 1);
+    int lo = int(floor(t.x * last));
+    int hi = min(int(ceil(t.y * last)), u_TableSize - 1);
+    bool occupied = u_OpaquePrefix[hi + 1] > u_OpaquePrefix[lo];
+
+    imageStore(u_Occupancy, brick, vec4(occupied ? 1.0 : 0.0));
+    if (occupied)
+        atomicAdd(u_OccupiedCount, 1u);
+}
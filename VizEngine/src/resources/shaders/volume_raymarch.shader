@@ -0,0 +1,196 @@
+#shader vertex
+#version 460 core
+
+// Volume ray-marching (VolumeRenderer), full-screen triangle
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+
+#shader fragment
+#version 460 core
+
+// rgb = premultiplied color, a = opacity (blended as ONE, ONE_MINUS_SRC_ALPHA)
+out vec4 FragColor;
+
+uniform sampler3D u_Volume;
+uniform sampler3D u_Occupancy;          // Per brick, 0 = nothing visible inside
+uniform sampler2D u_TransferFunction;
+uniform sampler2D u_SceneDepth;
+
+uniform mat4 u_InvViewProjection;
+uniform mat4 u_InvModel;                // World to the unit cube
+uniform vec3 u_VolumeSize;              // Voxels
+uniform vec3 u_BrickCount;
+uniform int u_BrickSize;
+uniform int u_TableSize;
+
+uniform vec2 u_Window;
+uniform float u_Density;
+uniform float u_Brightness;
+uniform float u_StepSize;               // Voxels
+uniform bool u_AdaptiveStep;
+uniform float u_DistanceStepScale;      // Per world unit
+uniform float u_TransparentStepScale;
+uniform bool u_Jitter;
+uniform bool u_SkipEmptySpace;
+uniform float u_TerminationAlpha;
+uniform int u_MaxSteps;
+
+uniform bool u_Shading;
+uniform float u_Ambient;
+uniform vec3 u_LightDirection;          // Local space, direction the light travels
+uniform int u_DebugView;                // VolumeDebugView: 0 = none, 1 = step count
+
+float InterleavedGradientNoise(vec2 pixel)
+{
+    return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+vec3 Unproject(vec2 ndc, float z)
+{
+    vec4 world = u_InvViewProjection * vec4(ndc, z, 1.0);
+    return world.xyz / world.w;
+}
+
+vec4 TransferFunction(float value)
+{
+    // Entry centers, so the window ends map exactly to the first and last entry
+    float x = clamp((value - u_Window.x) / max(u_Window.y - u_Window.x, 1e-6), 0.0, 1.0);
+    float size = float(u_TableSize);
+    return texture(u_TransferFunction, vec2((x * (size - 1.0) + 0.5) / size, 0.5));
+}
+
+vec3 Gradient(vec3 p)
+{
+    vec3 h = 1.0 / u_VolumeSize;
+    return vec3(
+        texture(u_Volume, p + vec3(h.x, 0.0, 0.0)).r - texture(u_Volume, p - vec3(h.x, 0.0, 0.0)).r,
+        texture(u_Volume, p + vec3(0.0, h.y, 0.0)).r - texture(u_Volume, p - vec3(0.0, h.y, 0.0)).r,
+        texture(u_Volume, p + vec3(0.0, 0.0, h.z)).r - texture(u_Volume, p - vec3(0.0, 0.0, h.z)).r
+    );
+}
+
+vec3 Heat(float x)
+{
+    return x < 0.5 ? mix(vec3(0.0, 0.0, 1.0), vec3(0.0, 1.0, 0.0), x * 2.0)
+                   : mix(vec3(0.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0), x * 2.0 - 1.0);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec2 ndc = gl_FragCoord.xy / vec2(textureSize(u_SceneDepth, 0)) * 2.0 - 1.0;
+
+    // World ray from the near plane; t is world distance along it
+    vec3 nearWorld = Unproject(ndc, -1.0);
+    vec3 farWorld = Unproject(ndc, 1.0);
+    vec3 worldDir = normalize(farWorld - nearWorld);
+
+    // Opaque surfaces end the ray
+    float depth = texelFetch(u_SceneDepth, pixel, 0).r;
+    float tScene = depth < 1.0
+        ? dot(Unproject(ndc, depth * 2.0 - 1.0) - nearWorld, worldDir)
+        : distance(farWorld, nearWorld);
+
+    // Same t in the unit cube, since the direction is not renormalized
+    vec3 origin = (u_InvModel * vec4(nearWorld, 1.0)).xyz;
+    vec3 dir = mat3(u_InvModel) * worldDir;
+    dir = mix(dir, vec3(1e-8), equal(dir, vec3(0.0)));
+    vec3 invDir = 1.0 / dir;
+
+    vec3 t0 = -origin * invDir;
+    vec3 t1 = (1.0 - origin) * invDir;
+    vec3 tNear = min(t0, t1);
+    vec3 tFar = max(t0, t1);
+    float tEnter = max(max(tNear.x, max(tNear.y, tNear.z)), 0.0);
+    float tExit = min(min(tFar.x, min(tFar.y, tFar.z)), tScene);
+    if (tEnter >= tExit)
+        discard;
+
+    // World length of one voxel along the ray: the opacity reference
+    float voxelDt = 1.0 / length(dir * u_VolumeSize);
+    float baseDt = u_StepSize * voxelDt;
+    float jitter = u_Jitter ? InterleavedGradientNoise(gl_FragCoord.xy) : 0.0;
+
+    vec3 bricksPerUnit = u_VolumeSize / float(u_BrickSize);
+    ivec3 lastBrick = ivec3(u_BrickCount) - 1;
+    vec3 exitSide = step(0.0, dir);
+
+    vec3 color = vec3(0.0);
+    float alpha = 0.0;
+    int steps = 0;
+    float t = tEnter + jitter * baseDt;
+
+    // Skips are bounded by the bricks a ray can cross, samples by u_MaxSteps
+    int maxIterations = u_MaxSteps + int(u_BrickCount.x + u_BrickCount.y + u_BrickCount.z);
+    for (int i = 0; i < maxIterations && t < tExit && steps < u_MaxSteps; i++)
+    {
+        vec3 p = origin + dir * t;
+
+        if (u_SkipEmptySpace)
+        {
+            ivec3 brick = clamp(ivec3(p * bricksPerUnit), ivec3(0), lastBrick);
+            if (texelFetch(u_Occupancy, brick, 0).r == 0.0)
+            {
+                // Continue just past the face the ray leaves the brick through,
+                // keeping the pixel's jitter so skipping does not reintroduce banding
+                vec3 planes = min((vec3(brick) + exitSide) / bricksPerUnit, vec3(1.0));
+                vec3 tPlanes = (planes - origin) * invDir;
+                float leave = min(tPlanes.x, min(tPlanes.y, tPlanes.z));
+                t = max(leave, t) + max(jitter, 0.01) * baseDt;
+                continue;
+            }
+        }
+
+        vec4 tf = TransferFunction(texture(u_Volume, p).r);
+        steps++;
+
+        float dt = baseDt;
+        if (u_AdaptiveStep)
+        {
+            dt *= 1.0 + u_DistanceStepScale * t;
+            if (tf.a <= 0.0)
+                dt *= u_TransparentStepScale;
+        }
+        dt = min(dt, tExit - t);   // The last segment ends at the surface
+
+        float a = clamp(tf.a * u_Density, 0.0, 0.9999);
+        if (a > 0.0)
+        {
+            // Opacity is per voxel of thickness; correct for the segment length
+            a = 1.0 - pow(1.0 - a, dt / voxelDt);
+
+            vec3 c = tf.rgb;
+            if (u_Shading)
+            {
+                vec3 gradient = Gradient(p);
+                float len = length(gradient);
+                if (len > 1e-5)
+                {
+                    // Two-sided: the gradient sign flips between entering and leaving a structure
+                    float diffuse = abs(dot(gradient / len, u_LightDirection));
+                    c *= u_Ambient + (1.0 - u_Ambient) * diffuse;
+                }
+            }
+
+            color += (1.0 - alpha) * a * c;
+            alpha += (1.0 - alpha) * a;
+            if (alpha >= u_TerminationAlpha)
+                break;
+        }
+
+        t += dt;
+    }
+
+    if (u_DebugView == 1)
+    {
+        FragColor = vec4(Heat(float(steps) / float(u_MaxSteps)), 1.0);
+        return;
+    }
+
+    FragColor = vec4(color * u_Brightness, alpha);
+}
@@ -0,0 +1,86 @@
+#shader compute
+#version 460 core
+
+// Virtual shadow map page marking: every scene depth pixel requests the
+// page its shadow lookup will read. The first pixel to touch a page in a
+// frame (frame stamp exchange) appends it to the request list, which the
+// host reads back one frame later.
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+uniform sampler2D u_Depth;
+uniform mat4 u_InvViewProjection;
+uniform vec3 u_CameraPosition;
+uniform int u_Frame;
+
+// Mirrors PageTableHeader in VirtualShadowMap.cpp
+layout(std430, binding = 5) readonly buffer VirtualShadowPageTable
+{
+    mat4 u_VSMLightView;
+    vec4 u_VSMParams;          // x = level-0 page size (world), y = pixel scale, z = depth range, w = LOD bias
+    ivec4 u_VSMLayout;         // x = levels, y = pages per axis, z = page texels, w = physical pages per axis
+    ivec4 u_VSMOrigins[16];    // xy = first world page of each level's window
+    uint u_VSMPages[];         // Physical page + 1, 0 = not resident
+};
+
+layout(std430, binding = 6) buffer VirtualShadowRequests
+{
+    uint u_RequestCount;
+    uint u_RequestPad0;
+    uint u_RequestPad1;
+    uint u_RequestPad2;
+    uint u_RequestData[];      // Frame stamp per virtual page, then the request list
+};
+
+// Finest level whose texels are no larger than the pixel footprint
+// (same as VirtualShadow in defaultlit.shader)
+int VirtualShadowLevel(vec3 worldPos, vec3 cameraPos)
+{
+    float footprint = distance(worldPos, cameraPos) * u_VSMParams.y;
+    float texel0 = u_VSMParams.x / float(u_VSMLayout.z);
+    float level = ceil(log2(max(footprint / texel0, 1e-6)) + u_VSMParams.w);
+    return clamp(int(level), 0, u_VSMLayout.x - 1);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = textureSize(u_Depth, 0);
+    if (any(greaterThanEqual(pixel, size)))
+        return;
+
+    // Background receives nothing
+    float depth = texelFetch(u_Depth, pixel, 0).r;
+    if (depth >= 1.0)
+        return;
+
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(size);
+    vec4 world = u_InvViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    world.xyz /= world.w;
+
+    vec2 light = (u_VSMLightView * vec4(world.xyz, 1.0)).xy;
+    int pages = u_VSMLayout.y;
+    uint virtualPages = uint(u_VSMLayout.x * pages * pages);
+
+    for (int level = VirtualShadowLevel(world.xyz, u_CameraPosition); level < u_VSMLayout.x; level++)
+    {
+        float pageWorld = u_VSMParams.x * exp2(float(level));
+        ivec2 page = ivec2(floor(light / pageWorld));
+        ivec2 local = page - u_VSMOrigins[level].xy;
+        if (any(lessThan(local, ivec2(0))) || any(greaterThanEqual(local, ivec2(pages))))
+            continue;
+
+        ivec2 wrapped = page & (pages - 1);
+        uint index = uint((level * pages + wrapped.y) * pages + wrapped.x);
+
+        // Plain read first: most pixels of a tile hit an already marked page
+        uint frame = uint(u_Frame);
+        if (u_RequestData[index] != frame && atomicExchange(u_RequestData[index], frame) != frame)
+        {
+            uint slot = atomicAdd(u_RequestCount, 1u);
+            if (slot < virtualPages)
+                u_RequestData[virtualPages + slot] = index;
+        }
+        return;
+    }
+}